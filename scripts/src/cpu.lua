@@ -634,6 +634,7 @@ if (CPUS["SH4"]~=null) then
 	files {
 		MAME_DIR .. "src/emu/cpu/sh4/sh4.c",
 		MAME_DIR .. "src/emu/cpu/sh4/sh4.h",
+		MAME_DIR .. "src/emu/cpu/sh4/sh4fe.c",
 		MAME_DIR .. "src/emu/cpu/sh4/sh4comn.c",
 		MAME_DIR .. "src/emu/cpu/sh4/sh4comn.h",
 		MAME_DIR .. "src/emu/cpu/sh4/sh3comn.c",
@@ -881,6 +882,7 @@ if (CPUS["I386"]~=null) then
 	files {
 		MAME_DIR .. "src/emu/cpu/i386/i386.c",
 		MAME_DIR .. "src/emu/cpu/i386/i386.h",
+		MAME_DIR .. "src/emu/cpu/i386/i386fe.c",
 	}
 end
 
@@ -1526,6 +1528,9 @@ if (CPUS["RSP"]~=null) then
 		MAME_DIR .. "src/emu/cpu/rsp/rspcp2.h",
 		MAME_DIR .. "src/emu/cpu/rsp/rspcp2d.c",
 		MAME_DIR .. "src/emu/cpu/rsp/rspcp2d.h",
+		MAME_DIR .. "src/emu/cpu/rsp/rspvmac.c",
+		MAME_DIR .. "src/emu/cpu/rsp/rspvmac.h",
+		MAME_DIR .. "src/emu/cpu/rsp/rspvmac.inc",
 		MAME_DIR .. "src/emu/cpu/rsp/clamp.h",
 		MAME_DIR .. "src/emu/cpu/rsp/vabs.h",
 		MAME_DIR .. "src/emu/cpu/rsp/vadd.h",
@@ -1788,6 +1793,8 @@ if (CPUS["TMS340X0"]~=null) then
 	files {
 		MAME_DIR .. "src/emu/cpu/tms34010/tms34010.c",
 		MAME_DIR .. "src/emu/cpu/tms34010/tms34010.h",
+		MAME_DIR .. "src/emu/cpu/tms34010/34010blk.c",
+		MAME_DIR .. "src/emu/cpu/tms34010/34010blk.h",
 	}
 end
 
@@ -100,6 +100,8 @@ files {
 	MAME_DIR .. "src/emu/drawgfx.c",
 	MAME_DIR .. "src/emu/drawgfx.h",
 	MAME_DIR .. "src/emu/drawgfxm.h",
+	MAME_DIR .. "src/emu/drawgfxd.c",
+	MAME_DIR .. "src/emu/drawgfxd.h",
 	MAME_DIR .. "src/emu/driver.c",
 	MAME_DIR .. "src/emu/driver.h",
 	MAME_DIR .. "src/emu/drivenum.c",
@@ -114,12 +116,18 @@ files {
 	MAME_DIR .. "src/emu/emupal.h",
 	MAME_DIR .. "src/emu/fileio.c",
 	MAME_DIR .. "src/emu/fileio.h",
+	MAME_DIR .. "src/emu/filestamp.c",
+	MAME_DIR .. "src/emu/filestamp.h",
 	MAME_DIR .. "src/emu/hash.c",
 	MAME_DIR .. "src/emu/hash.h",
+	MAME_DIR .. "src/emu/hashidx.c",
+	MAME_DIR .. "src/emu/hashidx.h",
 	MAME_DIR .. "src/emu/image.c",
 	MAME_DIR .. "src/emu/image.h",
 	MAME_DIR .. "src/emu/info.c",
 	MAME_DIR .. "src/emu/info.h",
+	MAME_DIR .. "src/emu/infoidx.c",
+	MAME_DIR .. "src/emu/infoidx.h",
 	MAME_DIR .. "src/emu/input.c",
 	MAME_DIR .. "src/emu/input.h",
 	MAME_DIR .. "src/emu/ioport.c",
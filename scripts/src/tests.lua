@@ -32,18 +32,42 @@ links {
 	"gtest",
 	"utils",
 	"expat",
+	"7z",
 	"zlib",
 	"ocore_" .. _OPTIONS["osd"],
 }
 
+if _OPTIONS["with-bundled-flac"] then
+	links {
+		"flac",
+	}
+else
+	links {
+		"FLAC",
+	}
+end
+
 includedirs {
 	MAME_DIR .. "3rdparty/googletest/googletest/include",
 	MAME_DIR .. "src/osd",
 	MAME_DIR .. "src/lib/util",
+	MAME_DIR .. "src/emu",
 }
 
 files {
 	MAME_DIR .. "tests/main.c",
 	MAME_DIR .. "tests/lib/util/corestr.c",
+	MAME_DIR .. "tests/lib/util/aviio.c",
+	MAME_DIR .. "tests/lib/util/chd.c",
+	MAME_DIR .. "tests/lib/util/png.c",
+	MAME_DIR .. "tests/lib/util/unzip.c",
+	MAME_DIR .. "tests/emu/drawgfxd.c",
+	MAME_DIR .. "src/emu/drawgfxd.c",
+	MAME_DIR .. "tests/emu/filestamp.c",
+	MAME_DIR .. "src/emu/filestamp.c",
+	MAME_DIR .. "tests/emu/cpu/rsp/rspvmac.c",
+	MAME_DIR .. "src/emu/cpu/rsp/rspvmac.c",
+	MAME_DIR .. "tests/emu/cpu/tms34010/34010blk.c",
+	MAME_DIR .. "src/emu/cpu/tms34010/34010blk.c",
 }
 
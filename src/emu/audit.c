@@ -12,6 +12,7 @@
 #include "emuopts.h"
 #include "audit.h"
 #include "chd.h"
+#include "un7z.h"
 #include "sound/samples.h"
 
 // for now, make buggy GCC/Mingw STFU about I64FMT
@@ -33,7 +34,8 @@
 media_auditor::media_auditor(const driver_enumerator &enumerator)
 	: m_enumerator(enumerator),
 		m_validation(AUDIT_VALIDATE_FULL),
-		m_searchpath(NULL)
+		m_searchpath(NULL),
+		m_hash_cache(NULL)
 {
 }
 
@@ -336,6 +338,9 @@ media_auditor::summary media_auditor::audit_samples()
 
 media_auditor::summary media_auditor::summarize(const char *name, std::string *output)
 {
+	// every audit ends here; the solid blocks of 7z files were only of use within the set
+	_7z_file_cache_free_blocks();
+
 	if (m_record_list.count() == 0)
 	{
 		return NONE_NEEDED;
@@ -438,8 +443,28 @@ audit_record *media_auditor::audit_one_rom(const rom_entry *rom)
 	file.set_restrict_to_mediapath(true);
 	path_iterator path(m_searchpath);
 	std::string curpath;
+	std::string key;
 	while (path.next(curpath, record.name()))
 	{
+		// if another audit has already looked here, reuse what it found
+		if (m_hash_cache != NULL)
+		{
+			bool found;
+			hash_collection hashes;
+			UINT64 length;
+			if (has_crc)
+				strprintf(key, "%s|%08X|%s", curpath.c_str(), crc, m_validation);
+			else
+				strprintf(key, "%s||%s", curpath.c_str(), m_validation);
+			if (m_hash_cache->find(key.c_str(), found, hashes, length))
+			{
+				if (!found)
+					continue;
+				record.set_actual(hashes, length);
+				break;
+			}
+		}
+
 		// open the file if we can
 		file_error filerr;
 		if (has_crc)
@@ -451,8 +476,12 @@ audit_record *media_auditor::audit_one_rom(const rom_entry *rom)
 		if (filerr == FILERR_NONE)
 		{
 			record.set_actual(file.hashes(m_validation), file.size());
+			if (m_hash_cache != NULL)
+				m_hash_cache->add(key.c_str(), true, record.actual_hashes(), record.actual_length());
 			break;
 		}
+		if (m_hash_cache != NULL)
+			m_hash_cache->add(key.c_str(), false, hash_collection(), 0);
 	}
 
 	// compute the final status
@@ -586,6 +615,209 @@ device_t *media_auditor::find_shared_device(device_t &device, const char *name,
 }
 
 
+//-------------------------------------------------
+//  audit_hash_cache - constructor
+//-------------------------------------------------
+
+audit_hash_cache::audit_hash_cache()
+	: m_lock(osd_lock_alloc())
+{
+}
+
+
+//-------------------------------------------------
+//  ~audit_hash_cache - destructor
+//-------------------------------------------------
+
+audit_hash_cache::~audit_hash_cache()
+{
+	reset();
+	osd_lock_free(m_lock);
+}
+
+
+//-------------------------------------------------
+//  find - look up a previous search result;
+//  returns false if nobody has searched there yet
+//-------------------------------------------------
+
+bool audit_hash_cache::find(const char *key, bool &found, hash_collection &hashes, UINT64 &length)
+{
+	osd_lock_acquire(m_lock);
+	entry *result = m_map.find(key);
+	if (result != NULL)
+	{
+		found = result->m_found;
+		hashes = result->m_hashes;
+		length = result->m_length;
+	}
+	osd_lock_release(m_lock);
+	return (result != NULL);
+}
+
+
+//-------------------------------------------------
+//  add - record the result of a search; if two
+//  threads race to add the same key, the first
+//  result wins
+//-------------------------------------------------
+
+void audit_hash_cache::add(const char *key, bool found, const hash_collection &hashes, UINT64 length)
+{
+	osd_lock_acquire(m_lock);
+	if (m_map.find(key) == NULL)
+		m_map.add(key, &m_list.append(*global_alloc(entry(found, hashes, length))));
+	osd_lock_release(m_lock);
+}
+
+
+//-------------------------------------------------
+//  reset - forget all search results
+//-------------------------------------------------
+
+void audit_hash_cache::reset()
+{
+	osd_lock_acquire(m_lock);
+	m_map.reset();
+	m_list.reset();
+	osd_lock_release(m_lock);
+}
+
+
+//-------------------------------------------------
+//  media_audit_batch - constructor
+//-------------------------------------------------
+
+media_audit_batch::media_audit_batch(emu_options &options, const char *validation)
+	: m_options(options),
+		m_validation(validation),
+		m_queue(osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI))
+{
+	memset(m_thread, 0, sizeof(m_thread));
+}
+
+
+//-------------------------------------------------
+//  ~media_audit_batch - destructor
+//-------------------------------------------------
+
+media_audit_batch::~media_audit_batch()
+{
+	if (m_queue != NULL)
+		osd_work_queue_free(m_queue);
+
+	// free the per-thread auditors
+	for (int threadnum = 0; threadnum < ARRAY_LENGTH(m_thread); threadnum++)
+	{
+		global_free(m_thread[threadnum].auditor);
+		global_free(m_thread[threadnum].enumerator);
+	}
+}
+
+
+//-------------------------------------------------
+//  add_driver - queue an audit of the media for
+//  the given driver
+//-------------------------------------------------
+
+void media_audit_batch::add_driver(int driver)
+{
+	add_software(driver, NULL, NULL);
+}
+
+
+//-------------------------------------------------
+//  add_software - queue an audit of a software
+//  list item on behalf of the given driver
+//-------------------------------------------------
+
+void media_audit_batch::add_software(int driver, const char *list_name, software_info *swinfo)
+{
+	result item;
+	item.batch = this;
+	item.driver = driver;
+	item.list_name = list_name;
+	item.swinfo = swinfo;
+	item.summary = media_auditor::NOTFOUND;
+	item.errorcode = 0;
+	m_results.push_back(item);
+}
+
+
+//-------------------------------------------------
+//  run - perform all queued audits, spreading
+//  them across the work queue; results are
+//  available in order once this returns
+//-------------------------------------------------
+
+void media_audit_batch::run()
+{
+	if (m_results.empty())
+		return;
+
+	// without a queue, just do them in order
+	if (m_queue == NULL)
+	{
+		for (int index = 0; index < m_results.size(); index++)
+			audit(m_results[index], 0);
+		return;
+	}
+
+	// otherwise, queue them all and help out until they're done
+	osd_work_item_queue_multiple(m_queue, audit_static, m_results.size(), &m_results[0], sizeof(m_results[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+	while (!osd_work_queue_wait(m_queue, osd_ticks_per_second())) { }
+}
+
+
+//-------------------------------------------------
+//  audit_static - work queue callback
+//-------------------------------------------------
+
+void *media_audit_batch::audit_static(void *param, int threadid)
+{
+	result &item = *reinterpret_cast<result *>(param);
+	item.batch->audit(item, threadid);
+	return NULL;
+}
+
+
+//-------------------------------------------------
+//  audit - perform a single audit using the
+//  calling thread's enumerator and auditor
+//-------------------------------------------------
+
+void media_audit_batch::audit(result &item, int threadid)
+{
+	// each thread gets its own enumerator, since machine configs are cached per enumerator
+	thread_state &state = m_thread[threadid];
+	if (state.enumerator == NULL)
+	{
+		state.enumerator = global_alloc(driver_enumerator(m_options));
+		state.auditor = global_alloc(media_auditor(*state.enumerator));
+		state.auditor->set_hash_cache(&m_hash_cache);
+	}
+
+	// fatal errors can't cross threads, so capture them for the caller to report
+	try
+	{
+		state.enumerator->set_current(item.driver);
+		if (item.swinfo != NULL)
+			item.summary = state.auditor->audit_software(item.list_name, item.swinfo, m_validation);
+		else
+			item.summary = state.auditor->audit_media(m_validation);
+
+		// summarize anything we found
+		if (item.summary != media_auditor::NOTFOUND)
+			state.auditor->summarize((item.swinfo != NULL) ? item.swinfo->shortname() : state.enumerator->driver().name, &item.output);
+	}
+	catch (emu_fatalerror &err)
+	{
+		item.error.assign(err.string());
+		item.errorcode = err.exitcode();
+	}
+}
+
+
 //-------------------------------------------------
 //  audit_record - constructor
 //-------------------------------------------------
@@ -121,6 +121,48 @@ private:
 };
 
 
+// ======================> audit_hash_cache
+
+// thread-safe record of where files were searched for and what was found,
+// shared between auditors so that clones and BIOS children don't re-open
+// and re-hash their parents' files
+class audit_hash_cache
+{
+public:
+	// construction/destruction
+	audit_hash_cache();
+	~audit_hash_cache();
+
+	// operations
+	bool find(const char *key, bool &found, hash_collection &hashes, UINT64 &length);
+	void add(const char *key, bool found, const hash_collection &hashes, UINT64 length);
+	void reset();
+
+private:
+	// a single search result
+	class entry
+	{
+		friend class simple_list<entry>;
+
+	public:
+		entry(bool found, const hash_collection &hashes, UINT64 length)
+			: m_next(NULL), m_found(found), m_hashes(hashes), m_length(length) { }
+
+		entry *next() const { return m_next; }
+
+		entry *             m_next;
+		bool                m_found;
+		hash_collection     m_hashes;
+		UINT64              m_length;
+	};
+
+	// internal state
+	osd_lock *                  m_lock;
+	tagmap_t<entry *, 4099>     m_map;
+	simple_list<entry>          m_list;
+};
+
+
 // ======================> media_auditor
 
 // class which manages auditing of items
@@ -144,6 +186,9 @@ public:
 	audit_record *first() const { return m_record_list.first(); }
 	int count() const { return m_record_list.count(); }
 
+	// setters
+	void set_hash_cache(audit_hash_cache *cache) { m_hash_cache = cache; }
+
 	// audit operations
 	summary audit_media(const char *validation = AUDIT_VALIDATE_FULL);
 	summary audit_device(device_t *device, const char *validation = AUDIT_VALIDATE_FULL);
@@ -163,6 +208,63 @@ private:
 	const driver_enumerator &   m_enumerator;
 	const char *                m_validation;
 	const char *                m_searchpath;
+	audit_hash_cache *          m_hash_cache;
+};
+
+
+// ======================> media_audit_batch
+
+// audits many drivers or software items in parallel, keeping the results in
+// the order they were added so that reports are deterministic
+class media_audit_batch
+{
+public:
+	// the outcome of a single audit
+	struct result
+	{
+		media_audit_batch *     batch;              // owning batch
+		int                     driver;             // index of the driver being audited
+		const char *            list_name;          // software list name, or NULL for a driver audit
+		software_info *         swinfo;             // software item, or NULL for a driver audit
+		media_auditor::summary  summary;            // overall result
+		std::string             output;             // summarized text for anything not correct
+		std::string             error;              // text of a fatal error, if one occurred
+		int                     errorcode;          // exit code for the fatal error
+	};
+
+	// construction/destruction
+	media_audit_batch(emu_options &options, const char *validation = AUDIT_VALIDATE_FULL);
+	~media_audit_batch();
+
+	// getters
+	int count() const { return m_results.size(); }
+	const result &get(int index) const { return m_results[index]; }
+
+	// operations
+	void add_driver(int driver);
+	void add_software(int driver, const char *list_name, software_info *swinfo);
+	void run();
+	void reset() { m_results.clear(); }
+
+private:
+	// per-thread auditing state
+	struct thread_state
+	{
+		driver_enumerator *     enumerator;
+		media_auditor *         auditor;
+	};
+
+	// internal helpers
+	static void *audit_static(void *param, int threadid);
+	void audit(result &item, int threadid);
+
+	// internal state
+	emu_options &               m_options;
+	const char *                m_validation;
+	osd_work_queue *            m_queue;
+	audit_hash_cache            m_hash_cache;
+	std::vector<result>         m_results;
+	thread_state                m_thread[WORK_MAX_THREADS + 1];
 };
 
 
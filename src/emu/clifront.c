@@ -13,7 +13,9 @@
 #include "emuopts.h"
 #include "jedparse.h"
 #include "audit.h"
+#include "hashidx.h"
 #include "info.h"
+#include "infoidx.h"
 #include "unzip.h"
 #include "un7z.h"
 #include "validity.h"
@@ -194,6 +196,13 @@ int cli_frontend::execute(int argc, char **argv)
 		std::string exename;
 		core_filename_extract_base(exename, argv[0], true);
 
+		// size the archive caches
+		zip_file_cache_set_size(m_options.archive_cache());
+		_7z_file_cache_set_size(m_options.archive_cache());
+
+		// load the hashes remembered from previous runs
+		hash_index::open_global(m_options);
+
 		// if we have a command, execute that
 		if (*(m_options.command()) != 0)
 			execute_commands(exename.c_str());
@@ -270,6 +279,7 @@ int cli_frontend::execute(int argc, char **argv)
 	}
 
 	_7z_file_cache_clear();
+	hash_index::close_global();
 
 	return m_result;
 }
@@ -287,7 +297,16 @@ void cli_frontend::listxml(const char *gamename)
 	if (drivlist.count() == 0)
 		throw emu_fatalerror(MAMERR_NO_SUCH_GAME, "No matching games found for '%s'", gamename);
 
-	// create the XML and print it to stdout
+	// stream it from the index if we can
+	info_index index(m_options);
+	if (index.open())
+	{
+		if (!index.output_xml(stdout, drivlist))
+			throw emu_fatalerror(MAMERR_FATALERROR, "Error reading the info index; run again with -noinfoindex");
+		return;
+	}
+
+	// otherwise create the XML and print it to stdout
 	info_xml_creator creator(drivlist);
 	creator.output(stdout);
 }
@@ -466,8 +485,12 @@ void cli_frontend::listroms(const char *gamename)
 	if (drivlist.count() == 0)
 		throw emu_fatalerror(MAMERR_NO_SUCH_GAME, "No matching games found for '%s'", gamename);
 
+	// use the index if we can
+	info_index index(m_options);
+	bool indexed = index.open();
+
 	// iterate through matches
-	std::string tempstr;
+	std::string roms;
 	bool first = true;
 	while (drivlist.next())
 	{
@@ -478,41 +501,10 @@ void cli_frontend::listroms(const char *gamename)
 		osd_printf_info("ROMs required for driver \"%s\".\n"
 				"Name                    Size Checksum\n", drivlist.driver().name);
 
-		// iterate through roms
-		device_iterator deviter(drivlist.config().root_device());
-		for (device_t *device = deviter.first(); device != NULL; device = deviter.next())
-			for (const rom_entry *region = rom_first_region(*device); region; region = rom_next_region(region))
-				for (const rom_entry *rom = rom_first_file(region); rom; rom = rom_next_file(rom))
-				{
-					// accumulate the total length of all chunks
-					int length = -1;
-					if (ROMREGION_ISROMDATA(region))
-						length = rom_file_size(rom);
-
-					// start with the name
-					const char *name = ROM_GETNAME(rom);
-					osd_printf_info("%-20s ", name);
-
-					// output the length next
-					if (length >= 0)
-						osd_printf_info("%7d", length);
-					else
-						osd_printf_info("       ");
-
-					// output the hash data
-					hash_collection hashes(ROM_GETHASHDATA(rom));
-					if (!hashes.flag(hash_collection::FLAG_NO_DUMP))
-					{
-						if (hashes.flag(hash_collection::FLAG_BAD_DUMP))
-							osd_printf_info(" BAD");
-						osd_printf_info(" %s", hashes.macro_string(tempstr));
-					}
-					else
-						osd_printf_info(" NO GOOD DUMP KNOWN");
-
-					// end with a CR
-					osd_printf_info("\n");
-				}
+		// then the roms themselves
+		if (!indexed || !index.text(info_index::SECTION_ROMS, drivlist.current(), roms))
+			info_index::format_roms(roms, drivlist.config());
+		osd_printf_info("%s", roms.c_str());
 	}
 }
 
@@ -560,13 +552,6 @@ void cli_frontend::listsamples(const char *gamename)
 //  referenced by a given game or set of games
 //-------------------------------------------------
 
-int cli_frontend::compare_devices(const void *i1, const void *i2)
-{
-	device_t *dev1 = *(device_t **)i1;
-	device_t *dev2 = *(device_t **)i2;
-	return strcmp(dev1->tag(), dev2->tag());
-}
-
 void cli_frontend::listdevices(const char *gamename)
 {
 	// determine which drivers to output; return an error if none found
@@ -574,7 +559,12 @@ void cli_frontend::listdevices(const char *gamename)
 	if (drivlist.count() == 0)
 		throw emu_fatalerror(MAMERR_NO_SUCH_GAME, "No matching games found for '%s'", gamename);
 
+	// use the index if we can
+	info_index index(m_options);
+	bool indexed = index.open();
+
 	// iterate over drivers, looking for SAMPLES devices
+	std::string devices;
 	bool first = true;
 	while (drivlist.next())
 	{
@@ -584,56 +574,10 @@ void cli_frontend::listdevices(const char *gamename)
 		first = false;
 		printf("Driver %s (%s):\n", drivlist.driver().name, drivlist.driver().description);
 
-		// build a list of devices
-		device_iterator iter(drivlist.config().root_device());
-		std::vector<device_t *> device_list;
-		for (device_t *device = iter.first(); device != NULL; device = iter.next())
-			device_list.push_back(device);
-
-		// sort them by tag
-		qsort(&device_list[0], device_list.size(), sizeof(device_list[0]), compare_devices);
-
-		// dump the results
-		for (unsigned int index = 0; index < device_list.size(); index++)
-		{
-			device_t *device = device_list[index];
-
-			// extract the tag, stripping the leading colon
-			const char *tag = device->tag();
-			if (*tag == ':')
-				tag++;
-
-			// determine the depth
-			int depth = 1;
-			if (*tag == 0)
-			{
-				tag = "<root>";
-				depth = 0;
-			}
-			else
-			{
-				for (const char *c = tag; *c != 0; c++)
-					if (*c == ':')
-					{
-						tag = c + 1;
-						depth++;
-					}
-			}
-			printf("   %*s%-*s %s", depth * 2, "", 30 - depth * 2, tag, device->name());
-
-			// add more information
-			UINT32 clock = device->clock();
-			if (clock >= 1000000000)
-				printf(" @ %d.%02d GHz\n", clock / 1000000000, (clock / 10000000) % 100);
-			else if (clock >= 1000000)
-				printf(" @ %d.%02d MHz\n", clock / 1000000, (clock / 10000) % 100);
-			else if (clock >= 1000)
-				printf(" @ %d.%02d kHz\n", clock / 1000, (clock / 10) % 100);
-			else if (clock > 0)
-				printf(" @ %d Hz\n", clock);
-			else
-				printf("\n");
-		}
+		// then the devices themselves
+		if (!indexed || !index.text(info_index::SECTION_DEVICES, drivlist.current(), devices))
+			info_index::format_devices(devices, drivlist.config());
+		fputs(devices.c_str(), stdout);
 	}
 }
 
@@ -765,16 +709,23 @@ void cli_frontend::verifyroms(const char *gamename)
 	int notfound = 0;
 	int matched = 0;
 
-	// iterate over drivers
-	media_auditor auditor(drivlist);
+	// audit all the drivers in parallel
+	media_audit_batch batch(m_options, AUDIT_VALIDATE_FAST);
 	while (drivlist.next())
+		batch.add_driver(drivlist.current());
+	batch.run();
+
+	// then report on them in order
+	media_auditor auditor(drivlist);
+	for (int index = 0; index < batch.count(); index++)
 	{
+		const media_audit_batch::result &result = batch.get(index);
+		if (!result.error.empty())
+			throw emu_fatalerror(result.errorcode, "%s", result.error.c_str());
 		matched++;
 
-		// audit the ROMs in this set
-		media_auditor::summary summary = auditor.audit_media(AUDIT_VALIDATE_FAST);
-
 		// if not found, count that and leave it at that
+		media_auditor::summary summary = result.summary;
 		if (summary == media_auditor::NOTFOUND)
 			notfound++;
 
@@ -782,13 +733,11 @@ void cli_frontend::verifyroms(const char *gamename)
 		else
 		{
 			// output the summary of the audit
-			std::string summary_string;
-			auditor.summarize(drivlist.driver().name,&summary_string);
-			osd_printf_info("%s", summary_string.c_str());
+			osd_printf_info("%s", result.output.c_str());
 
 			// output the name of the driver and its clone
-			osd_printf_info("romset %s ", drivlist.driver().name);
-			int clone_of = drivlist.clone();
+			osd_printf_info("romset %s ", drivlist.driver(result.driver).name);
+			int clone_of = drivlist.clone(result.driver);
 			if (clone_of != -1)
 				osd_printf_info("[%s] ", drivlist.driver(clone_of).name);
 
@@ -1297,7 +1246,7 @@ void cli_frontend::verifysoftware(const char *gamename)
 		throw emu_fatalerror(MAMERR_NO_SUCH_GAME, "No matching games found for '%s'", gamename);
 	}
 
-	media_auditor auditor(drivlist);
+	media_audit_batch batch(m_options, AUDIT_VALIDATE_FAST);
 	while (drivlist.next())
 	{
 		matched++;
@@ -1310,8 +1259,16 @@ void cli_frontend::verifysoftware(const char *gamename)
 					{
 						nrlists++;
 						for (software_info *swinfo = swlistdev->first_software_info(); swinfo != NULL; swinfo = swinfo->next())
+							batch.add_software(drivlist.current(), swlistdev->list_name(), swinfo);
+						batch.run();
+
+						// then report on them in order
+						for (int index = 0; index < batch.count(); index++)
 						{
-							media_auditor::summary summary = auditor.audit_software(swlistdev->list_name(), swinfo, AUDIT_VALIDATE_FAST);
+							const media_audit_batch::result &result = batch.get(index);
+							if (!result.error.empty())
+								throw emu_fatalerror(result.errorcode, "%s", result.error.c_str());
+							media_auditor::summary summary = result.summary;
 
 							// if not found, count that and leave it at that
 							if (summary == media_auditor::NOTFOUND)
@@ -1322,12 +1279,10 @@ void cli_frontend::verifysoftware(const char *gamename)
 							else if(summary != media_auditor::NONE_NEEDED)
 							{
 								// output the summary of the audit
-								std::string summary_string;
-								auditor.summarize(swinfo->shortname(), &summary_string);
-								osd_printf_info("%s", summary_string.c_str());
+								osd_printf_info("%s", result.output.c_str());
 
 								// display information about what we discovered
-								osd_printf_info("romset %s:%s ", swlistdev->list_name(), swinfo->shortname());
+								osd_printf_info("romset %s:%s ", result.list_name, result.swinfo->shortname());
 
 								// switch off of the result
 								switch (summary)
@@ -1352,6 +1307,7 @@ void cli_frontend::verifysoftware(const char *gamename)
 								}
 							}
 						}
+						batch.reset();
 					}
 	}
 
@@ -1419,7 +1375,7 @@ void cli_frontend::verifysoftlist(const char *gamename)
 	int matched = 0;
 
 	driver_enumerator drivlist(m_options);
-	media_auditor auditor(drivlist);
+	media_audit_batch batch(m_options, AUDIT_VALIDATE_FAST);
 
 	while (drivlist.next())
 	{
@@ -1432,8 +1388,16 @@ void cli_frontend::verifysoftlist(const char *gamename)
 
 					// Get the actual software list contents
 					for (software_info *swinfo = swlistdev->first_software_info(); swinfo != NULL; swinfo = swinfo->next())
+						batch.add_software(drivlist.current(), swlistdev->list_name(), swinfo);
+					batch.run();
+
+					// then report on them in order
+					for (int index = 0; index < batch.count(); index++)
 					{
-						media_auditor::summary summary = auditor.audit_software(swlistdev->list_name(), swinfo, AUDIT_VALIDATE_FAST);
+						const media_audit_batch::result &result = batch.get(index);
+						if (!result.error.empty())
+							throw emu_fatalerror(result.errorcode, "%s", result.error.c_str());
+						media_auditor::summary summary = result.summary;
 
 						// if not found, count that and leave it at that
 						if (summary == media_auditor::NOTFOUND)
@@ -1444,12 +1408,10 @@ void cli_frontend::verifysoftlist(const char *gamename)
 						else if (summary != media_auditor::NONE_NEEDED)
 						{
 							// output the summary of the audit
-							std::string summary_string;
-							auditor.summarize(swinfo->shortname(), &summary_string);
-							osd_printf_info("%s", summary_string.c_str());
+							osd_printf_info("%s", result.output.c_str());
 
 							// display information about what we discovered
-							osd_printf_info("romset %s:%s ", swlistdev->list_name(), swinfo->shortname());
+							osd_printf_info("romset %s:%s ", result.list_name, result.swinfo->shortname());
 
 							// switch off of the result
 							switch (summary)
@@ -1474,6 +1436,7 @@ void cli_frontend::verifysoftlist(const char *gamename)
 							}
 						}
 					}
+					batch.reset();
 				}
 	}
 
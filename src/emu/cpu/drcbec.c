@@ -473,6 +473,17 @@ bool drcbe_c::hash_exists(UINT32 mode, UINT32 pc)
 }
 
 
+//-------------------------------------------------
+//  hash_invalidate - remove any code for the
+//  given mode/pc from the hash table
+//-------------------------------------------------
+
+void drcbe_c::hash_invalidate(UINT32 mode, UINT32 pc)
+{
+	m_hash.invalidate(mode, pc);
+}
+
+
 //-------------------------------------------------
 //  get_info - return information about the
 //  back-end implementation
@@ -482,6 +493,8 @@ void drcbe_c::get_info(drcbe_info &info)
 {
 	info.direct_iregs = 0;
 	info.direct_fregs = 0;
+	info.hash_recompiles = m_hash.recompiles();
+	info.hash_flushes = m_hash.flushes();
 }
 
 
@@ -36,6 +36,7 @@ public:
 	virtual int execute(uml::code_handle &entry);
 	virtual void generate(drcuml_block &block, const uml::instruction *instlist, UINT32 numinst);
 	virtual bool hash_exists(UINT32 mode, UINT32 pc);
+	virtual void hash_invalidate(UINT32 mode, UINT32 pc);
 	virtual void get_info(drcbe_info &info);
 
 private:
@@ -42,7 +42,9 @@ drc_hash_table::drc_hash_table(drc_cache &cache, UINT32 modes, UINT8 addrbits, U
 		m_l2mask((1 << m_l2bits) - 1),
 		m_base(reinterpret_cast<drccodeptr ***>(cache.alloc(modes * sizeof(**m_base)))),
 		m_emptyl1(NULL),
-		m_emptyl2(NULL)
+		m_emptyl2(NULL),
+		m_recompiles(0),
+		m_flushes(0)
 {
 	reset();
 }
@@ -77,6 +79,7 @@ bool drc_hash_table::reset()
 	for (int modenum = 0; modenum < m_modes; modenum++)
 		m_base[modenum] = m_emptyl1;
 
+	m_flushes++;
 	return true;
 }
 
@@ -97,6 +100,10 @@ void drc_hash_table::block_begin(drcuml_block &block, const uml::instruction *in
 		{
 			assert(inst.numparams() == 2);
 
+			// an entry that already has code is being recompiled
+			if (code_exists(inst.param(0).immediate(), inst.param(1).immediate()))
+				m_recompiles++;
+
 			// if we fail to allocate, we must abort the block
 			if (!set_codeptr(inst.param(0).immediate(), inst.param(1).immediate(), NULL))
 				block.abort();
@@ -38,6 +38,8 @@ public:
 	offs_t l1mask() const { return m_l1mask; }
 	offs_t l2mask() const { return m_l2mask; }
 	bool is_mode_populated(UINT32 mode) const { return m_base[mode] != m_emptyl1; }
+	UINT32 recompiles() const { return m_recompiles; }
+	UINT32 flushes() const { return m_flushes; }
 
 	// set up and configuration
 	bool reset();
@@ -51,6 +53,7 @@ public:
 	bool set_codeptr(UINT32 mode, UINT32 pc, drccodeptr code);
 	drccodeptr get_codeptr(UINT32 mode, UINT32 pc) { assert(mode < m_modes); return m_base[mode][(pc >> m_l1shift) & m_l1mask][(pc >> m_l2shift) & m_l2mask]; }
 	bool code_exists(UINT32 mode, UINT32 pc) { return get_codeptr(mode, pc) != m_nocodeptr; }
+	void invalidate(UINT32 mode, UINT32 pc) { if (code_exists(mode, pc)) set_codeptr(mode, pc, m_nocodeptr); }
 
 private:
 	// internal state
@@ -69,6 +72,9 @@ private:
 	drccodeptr ***  m_base;                 // pointer to the l1 table for each mode
 	drccodeptr **   m_emptyl1;              // pointer to empty l1 hash table
 	drccodeptr *    m_emptyl2;              // pointer to empty l2 hash table
+
+	UINT32          m_recompiles;           // number of entries replaced by a later block
+	UINT32          m_flushes;              // number of times the tables have been reset
 };
 
 
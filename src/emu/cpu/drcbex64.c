@@ -183,6 +183,8 @@ using namespace x64emit;
 
 #define LOG_HASHJMPS            (0)
 
+#define USE_BLOCK_LINKING       (1)
+
 #define USE_RCPSS_FOR_SINGLES   (0)
 #define USE_RSQRTSS_FOR_SINGLES (0)
 #define USE_RCPSS_FOR_DOUBLES   (0)
@@ -748,9 +750,10 @@ void drcbe_x64::reset()
 	*cachetop = (drccodeptr)dst;
 	m_cache.end_codegen();
 
-	// reset our hash tables
+	// reset our hash tables; all linked code is gone
 	m_hash.reset();
 	m_hash.set_default_codeptr(m_nocode);
+	m_links.clear();
 }
 
 
@@ -841,6 +844,20 @@ bool drcbe_x64::hash_exists(UINT32 mode, UINT32 pc)
 }
 
 
+//-------------------------------------------------
+//  hash_invalidate - remove any code for the
+//  given mode/pc from the hash table, unlinking
+//  direct calls to it
+//-------------------------------------------------
+
+void drcbe_x64::hash_invalidate(UINT32 mode, UINT32 pc)
+{
+	m_hash.invalidate(mode, pc);
+	if (USE_BLOCK_LINKING)
+		link_update(mode, pc, NULL);
+}
+
+
 //-------------------------------------------------
 //  get_info - return information about the
 //  back-end implementation
@@ -854,6 +871,8 @@ void drcbe_x64::get_info(drcbe_info &info)
 	for (info.direct_fregs = 0; info.direct_fregs < REG_F_COUNT; info.direct_fregs++)
 		if (float_register_map[info.direct_fregs] == 0)
 			break;
+	info.hash_recompiles = m_hash.recompiles();
+	info.hash_flushes = m_hash.flushes();
 }
 
 
@@ -2612,6 +2631,64 @@ void drcbe_x64::fixup_exception(drccodeptr *codeptr, void *param1, void *param2)
 }
 
 
+//-------------------------------------------------
+//  link_add - remember a HASHJMP call site to a
+//  fixed mode/pc, linking it immediately if the
+//  target already exists
+//-------------------------------------------------
+
+void drcbe_x64::link_add(UINT32 mode, UINT32 pc, x86code *start, x86code *end)
+{
+	// we need room to patch in a direct call
+	link_site site;
+	if (end - start < 5 || end - start > sizeof(site.original))
+		return;
+
+	site.end = end;
+	site.length = end - start;
+	memcpy(site.original, start, site.length);
+	m_links[(UINT64(mode) << 32) | pc].push_back(site);
+
+	// link now if we can
+	x86code *target = m_hash.get_codeptr(mode, pc);
+	if (target != NULL && target != m_nocode)
+		link_update(mode, pc, target);
+}
+
+
+//-------------------------------------------------
+//  link_update - point all call sites for the
+//  given mode/pc directly at new code, or back
+//  at the hash table if there is none
+//-------------------------------------------------
+
+void drcbe_x64::link_update(UINT32 mode, UINT32 pc, x86code *target)
+{
+	link_map::iterator sites = m_links.find((UINT64(mode) << 32) | pc);
+	if (sites == m_links.end())
+		return;
+
+	for (int sitenum = 0; sitenum < sites->second.size(); sitenum++)
+	{
+		const link_site &site = sites->second[sitenum];
+		x86code *start = site.end - site.length;
+
+		// restore the hash table lookup if there's nothing to call
+		if (target == NULL || target == m_nocode)
+			memcpy(start, site.original, site.length);
+
+		// otherwise pad with NOPs so the direct call returns to the same place
+		else
+		{
+			x86code *dst = start;
+			while (dst < site.end - 5)
+				emit_nop(dst);                                                          // nop
+			emit_call(dst, target);                                                     // call  target
+		}
+	}
+}
+
+
 
 //**************************************************************************
 //  DEBUG HELPERS
@@ -2682,6 +2759,10 @@ void drcbe_x64::op_hash(x86code *&dst, const instruction &inst)
 
 	// register the current pointer for the mode/PC
 	m_hash.set_codeptr(inst.param(0).immediate(), inst.param(1).immediate(), dst);
+
+	// relink anyone calling a previous version of this code
+	if (USE_BLOCK_LINKING)
+		link_update(inst.param(0).immediate(), inst.param(1).immediate(), dst);
 }
 
 
@@ -2838,8 +2919,13 @@ void drcbe_x64::op_hashjmp(x86code *&dst, const instruction &inst)
 		{
 			UINT32 l1val = (pcp.immediate() >> m_hash.l1shift()) & m_hash.l1mask();
 			UINT32 l2val = (pcp.immediate() >> m_hash.l2shift()) & m_hash.l2mask();
+			x86code *start = dst;
 			emit_call_m64(dst, MABS(&m_hash.base()[modep.immediate()][l1val][l2val]));
 																						// call  hash[modep][l1val][l2val]
+
+			// the call can later be patched to go straight to the target
+			if (USE_BLOCK_LINKING)
+				link_add(modep.immediate(), pcp.immediate(), start, dst);
 		}
 
 		// a fixed mode but variable PC
@@ -40,6 +40,7 @@ public:
 	virtual int execute(uml::code_handle &entry);
 	virtual void generate(drcuml_block &block, const uml::instruction *instlist, UINT32 numinst);
 	virtual bool hash_exists(UINT32 mode, UINT32 pc);
+	virtual void hash_invalidate(UINT32 mode, UINT32 pc);
 	virtual void get_info(drcbe_info &info);
 	virtual bool logging() const { return m_log != NULL; }
 
@@ -124,6 +125,9 @@ private:
 	void fixup_label(void *parameter, drccodeptr labelcodeptr);
 	void fixup_exception(drccodeptr *codeptr, void *param1, void *param2);
 
+	void link_add(UINT32 mode, UINT32 pc, x86code *start, x86code *end);
+	void link_update(UINT32 mode, UINT32 pc, x86code *target);
+
 	static void debug_log_hashjmp(offs_t pc, int mode);
 	static void debug_log_hashjmp_fail();
 
@@ -308,6 +312,16 @@ private:
 	drc_label_fixup_delegate m_fixup_label;         // precomputed delegate for fixups
 	drc_oob_delegate        m_fixup_exception;      // precomputed delegate for exception fixups
 
+	// a HASHJMP call site that can be patched to call its target directly
+	struct link_site
+	{
+		x86code *           end;                    // return address of the call
+		UINT8               length;                 // length of the original call
+		x86code             original[8];            // original indirect call through the hash table
+	};
+	typedef std::map<UINT64, std::vector<link_site> > link_map;
+	link_map                m_links;                // call sites, by target mode/pc
+
 	// state to live in the near cache
 	struct near_state
 	{
@@ -824,6 +824,17 @@ bool drcbe_x86::hash_exists(UINT32 mode, UINT32 pc)
 }
 
 
+//-------------------------------------------------
+//  drcbex86_hash_invalidate - remove any code for
+//  the given mode/pc from the hash table
+//-------------------------------------------------
+
+void drcbe_x86::hash_invalidate(UINT32 mode, UINT32 pc)
+{
+	m_hash.invalidate(mode, pc);
+}
+
+
 //-------------------------------------------------
 //  drcbex86_get_info - return information about
 //  the back-end implementation
@@ -835,6 +846,8 @@ void drcbe_x86::get_info(drcbe_info &info)
 		if (int_register_map[info.direct_iregs] == 0)
 			break;
 	info.direct_fregs = 0;
+	info.hash_recompiles = m_hash.recompiles();
+	info.hash_flushes = m_hash.flushes();
 }
 
 
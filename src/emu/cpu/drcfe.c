@@ -17,6 +17,7 @@
 
 #include "emu.h"
 #include "drcfe.h"
+#include "drcuml.h"
 
 
 //**************************************************************************
@@ -376,3 +377,169 @@ void drc_frontend::release_descriptions()
 	// reclaim all the descriptors
 	m_desc_allocator.reclaim_all(m_desc_live_list);
 }
+
+
+
+//**************************************************************************
+//  DRC CODE TRACKER
+//**************************************************************************
+
+//-------------------------------------------------
+//  drc_code_tracker - constructor
+//-------------------------------------------------
+
+drc_code_tracker::drc_code_tracker(drcuml_state &drcuml, int addrbits, int pageshift)
+	: m_drcuml(drcuml),
+		m_addrmask((addrbits >= 32) ? 0xffffffff : ((1 << addrbits) - 1)),
+		m_pageshift(pageshift),
+		m_pages(((m_addrmask >> pageshift) + 1), 0)
+{
+}
+
+
+//-------------------------------------------------
+//  reset - forget all tracked code; called when
+//  the code cache is flushed
+//-------------------------------------------------
+
+void drc_code_tracker::reset()
+{
+	for (page_map::iterator iter = m_ranges.begin(); iter != m_ranges.end(); ++iter)
+		m_pages[iter->first] = 0;
+	m_ranges.clear();
+	m_blocks.clear();
+}
+
+
+//-------------------------------------------------
+//  add_block - note the code covered by a newly
+//  compiled block and its sequence entry points
+//-------------------------------------------------
+
+void drc_code_tracker::add_block(UINT32 mode, const opcode_desc *desclist)
+{
+	UINT32 blocknum = m_blocks.size();
+	m_blocks.resize(blocknum + 1);
+	block &blk = m_blocks[blocknum];
+	blk.valid = true;
+
+	// every sequence is a potential entry point
+	std::map<UINT32, range> ranges;
+	bool seqstart = true;
+	for (const opcode_desc *curdesc = desclist; curdesc != NULL; curdesc = curdesc->next())
+	{
+		if (seqstart)
+		{
+			entry ent;
+			ent.mode = mode;
+			ent.pc = curdesc->pc;
+			blk.entries.push_back(ent);
+		}
+		seqstart = ((curdesc->flags & OPFLAG_END_SEQUENCE) != 0);
+
+		add_desc(*curdesc, ranges);
+		for (const opcode_desc *delaydesc = curdesc->delay.first(); delaydesc != NULL; delaydesc = delaydesc->next())
+			add_desc(*delaydesc, ranges);
+	}
+
+	// register the ranges with their pages
+	for (std::map<UINT32, range>::iterator iter = ranges.begin(); iter != ranges.end(); ++iter)
+	{
+		iter->second.blocknum = blocknum;
+		m_ranges[iter->first].push_back(iter->second);
+		m_pages[iter->first] = 1;
+	}
+}
+
+
+//-------------------------------------------------
+//  write - invalidate any blocks whose code
+//  overlaps a write; returns true if any were
+//-------------------------------------------------
+
+bool drc_code_tracker::write(offs_t physaddr, int size)
+{
+	physaddr &= m_addrmask;
+	UINT32 page = physaddr >> m_pageshift;
+	if (m_pages[page] == 0)
+		return false;
+
+	page_map::iterator iter = m_ranges.find(page);
+	assert(iter != m_ranges.end());
+	std::vector<range> &ranges = iter->second;
+
+	// invalidate overlapping blocks and drop ranges for blocks that are gone
+	bool result = false;
+	for (int rangenum = 0; rangenum < ranges.size(); )
+	{
+		block &blk = m_blocks[ranges[rangenum].blocknum];
+		if (blk.valid && physaddr <= ranges[rangenum].last && physaddr + size - 1 >= ranges[rangenum].start)
+		{
+			invalidate_block(blk);
+			result = true;
+		}
+		if (!blk.valid)
+		{
+			ranges[rangenum] = ranges.back();
+			ranges.pop_back();
+		}
+		else
+			rangenum++;
+	}
+
+	// if nothing is left, we can stop watching the page
+	if (ranges.empty())
+	{
+		m_ranges.erase(iter);
+		m_pages[page] = 0;
+	}
+	return result;
+}
+
+
+//-------------------------------------------------
+//  add_desc - extend the per-page ranges to cover
+//  a single opcode
+//-------------------------------------------------
+
+void drc_code_tracker::add_desc(const opcode_desc &desc, std::map<UINT32, range> &ranges)
+{
+	offs_t start = desc.physpc & m_addrmask;
+	offs_t last = (start + MAX(desc.length, 1) - 1) & m_addrmask;
+
+	// an opcode may straddle two pages
+	for (UINT32 page = start >> m_pageshift; ; page = last >> m_pageshift)
+	{
+		offs_t pagestart = MAX(start, page << m_pageshift);
+		offs_t pagelast = MIN(last, (page << m_pageshift) | ((1 << m_pageshift) - 1));
+
+		std::map<UINT32, range>::iterator iter = ranges.find(page);
+		if (iter == ranges.end())
+		{
+			range &newrange = ranges[page];
+			newrange.start = pagestart;
+			newrange.last = pagelast;
+		}
+		else
+		{
+			iter->second.start = MIN(iter->second.start, pagestart);
+			iter->second.last = MAX(iter->second.last, pagelast);
+		}
+
+		if (page == (last >> m_pageshift))
+			break;
+	}
+}
+
+
+//-------------------------------------------------
+//  invalidate_block - remove all of a block's
+//  entry points from the hash table
+//-------------------------------------------------
+
+void drc_code_tracker::invalidate_block(block &blk)
+{
+	for (int entrynum = 0; entrynum < blk.entries.size(); entrynum++)
+		m_drcuml.hash_invalidate(blk.entries[entrynum].mode, blk.entries[entrynum].pc);
+	blk.valid = false;
+}
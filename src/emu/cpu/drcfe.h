@@ -34,6 +34,8 @@
 #ifndef __DRCFE_H__
 #define __DRCFE_H__
 
+#include <map>
+
 
 //**************************************************************************
 //  CONSTANTS
@@ -84,6 +86,10 @@ const UINT32 OPFLAG_WRITES_MEMORY           = 0x00200000;       // instruction w
 //  TYPE DEFINITIONS
 //**************************************************************************
 
+// forward references
+class drcuml_state;
+
+
 // description of a given opcode
 struct opcode_desc
 {
@@ -161,4 +167,59 @@ private:
 };
 
 
+// DRC translated code tracker, used to invalidate blocks whose code is written
+class drc_code_tracker
+{
+public:
+	// construction/destruction
+	drc_code_tracker(drcuml_state &drcuml, int addrbits, int pageshift = 12);
+
+	// getters
+	const UINT8 *pages() const { return &m_pages[0]; }
+	int page_shift() const { return m_pageshift; }
+	bool page_has_code(offs_t physaddr) const { return m_pages[(physaddr & m_addrmask) >> m_pageshift] != 0; }
+
+	// tracking
+	void reset();
+	void add_block(UINT32 mode, const opcode_desc *desclist);
+	bool write(offs_t physaddr, int size);
+
+private:
+	// a mode/pc entry point within a block
+	struct entry
+	{
+		UINT32          mode;                   // mode of the entry
+		offs_t          pc;                     // PC of the entry
+	};
+
+	// a compiled block and its entry points
+	struct block
+	{
+		std::vector<entry> entries;             // entry points of the block
+		bool            valid;                  // false once invalidated
+	};
+
+	// range of physical memory holding a block's code within one page
+	struct range
+	{
+		offs_t          start;                  // first byte
+		offs_t          last;                   // last byte
+		UINT32          blocknum;               // index of the owning block
+	};
+	typedef std::map<UINT32, std::vector<range> > page_map;
+
+	// internal helpers
+	void add_desc(const opcode_desc &desc, std::map<UINT32, range> &ranges);
+	void invalidate_block(block &blk);
+
+	// internal state
+	drcuml_state &      m_drcuml;               // UML state whose hash entries we invalidate
+	offs_t              m_addrmask;             // mask of valid physical address bits
+	int                 m_pageshift;            // shift to convert address to a page index
+	std::vector<UINT8>  m_pages;                // nonzero for each page holding code
+	page_map            m_ranges;               // code ranges for each page holding code
+	std::vector<block>  m_blocks;               // blocks tracked since the last reset
+};
+
+
 #endif /* __DRCFE_H__ */
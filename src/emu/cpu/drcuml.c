@@ -34,6 +34,7 @@
 
 ***************************************************************************/
 
+#include <algorithm>
 #include "emu.h"
 #include "drcuml.h"
 #include "drcbec.h"
@@ -51,6 +52,9 @@ using namespace uml;
 #define VALIDATE_BACKEND        (0)
 #define LOG_SIMPLIFICATIONS     (0)
 
+// number of entry points listed in the profile report
+#define PROFILE_HOT_ENTRIES     (100)
+
 
 
 //**************************************************************************
@@ -124,7 +128,10 @@ drcuml_state::drcuml_state(device_t &device, drc_cache &cache, UINT32 flags, int
 		m_beintf(device.machine().options().drc_use_c() ?
 			*static_cast<drcbe_interface *>(auto_alloc(device.machine(), drcbe_c(*this, device, cache, flags, modes, addrbits, ignorebits))) :
 			*static_cast<drcbe_interface *>(auto_alloc(device.machine(), drcbe_native(*this, device, cache, flags, modes, addrbits, ignorebits)))),
-		m_umllog(NULL)
+		m_umllog(NULL),
+		m_profiling(device.machine().options().drc_profile()),
+		m_profile_blocks(0),
+		m_profile_peak(0)
 {
 	// if we're to log, create the logfile
 	if (device.machine().options().drc_log_uml())
@@ -141,6 +148,18 @@ drcuml_state::drcuml_state(device_t &device, drc_cache &cache, UINT32 flags, int
 
 drcuml_state::~drcuml_state()
 {
+	// write out the profile before the back-end goes away
+	if (m_profiling)
+	{
+		std::string filename = std::string("drcprof_").append(m_device.shortname()).append(".txt");
+		FILE *file = fopen(filename.c_str(), "w");
+		if (file != NULL)
+		{
+			profile_report(file);
+			fclose(file);
+		}
+	}
+
 	// free the back-end
 	auto_free(m_device.machine(), &m_beintf);
 
@@ -160,6 +179,10 @@ void drcuml_state::reset()
 	// if we error here, we are screwed
 	try
 	{
+		// collect the counters before their code goes away
+		if (m_profiling)
+			profile_fold();
+
 		// flush the cache
 		m_cache.flush();
 
@@ -261,6 +284,119 @@ const char *drcuml_state::symbol_find(void *base, UINT32 *offset)
 }
 
 
+//-------------------------------------------------
+//  profile_counter - return a counter to be
+//  incremented each time the given entry point
+//  executes, or NULL if none could be allocated
+//-------------------------------------------------
+
+UINT64 *drcuml_state::profile_counter(UINT32 mode, UINT32 pc)
+{
+	profile_entry &entry = m_profile[(UINT64(mode) << 32) | pc];
+
+	// code replacing an existing entry shares its counter
+	if (entry.counter == NULL)
+	{
+		entry.counter = reinterpret_cast<UINT64 *>(m_cache.alloc(sizeof(*entry.counter)));
+		if (entry.counter == NULL)
+			return NULL;
+		*entry.counter = 0;
+	}
+	m_profile_pending.push_back(&entry);
+	return entry.counter;
+}
+
+
+//-------------------------------------------------
+//  profile_commit - record the sizes of a block
+//  once it has been generated
+//-------------------------------------------------
+
+void drcuml_state::profile_commit(UINT32 numinst, UINT32 native_bytes)
+{
+	for (int entrynum = 0; entrynum < m_profile_pending.size(); entrynum++)
+	{
+		profile_entry &entry = *m_profile_pending[entrynum];
+		entry.compiles++;
+		entry.uml_insts = numinst;
+		entry.native_bytes = native_bytes;
+	}
+	m_profile_pending.clear();
+
+	m_profile_blocks++;
+	m_profile_peak = MAX(m_profile_peak, m_cache.top() - m_cache.base());
+}
+
+
+//-------------------------------------------------
+//  profile_fold - accumulate and release the live
+//  counters ahead of a cache flush
+//-------------------------------------------------
+
+void drcuml_state::profile_fold()
+{
+	for (profile_map::iterator iter = m_profile.begin(); iter != m_profile.end(); ++iter)
+	{
+		profile_entry &entry = iter->second;
+		if (entry.counter != NULL)
+		{
+			entry.count += *entry.counter;
+			m_cache.dealloc(entry.counter, sizeof(*entry.counter));
+			entry.counter = NULL;
+		}
+	}
+	m_profile_pending.clear();
+}
+
+
+//-------------------------------------------------
+//  profile_report - print cache statistics and
+//  the most frequently executed entry points
+//-------------------------------------------------
+
+static bool profile_compare(const std::pair<UINT64, UINT64> &a, const std::pair<UINT64, UINT64> &b)
+{
+	return (a.first != b.first) ? (a.first > b.first) : (a.second < b.second);
+}
+
+void drcuml_state::profile_report(FILE *file)
+{
+	profile_fold();
+
+	// gather the totals and sort entries by execution count
+	std::vector<std::pair<UINT64, UINT64> > sorted;
+	UINT64 total = 0;
+	for (profile_map::const_iterator iter = m_profile.begin(); iter != m_profile.end(); ++iter)
+	{
+		sorted.push_back(std::make_pair(iter->second.count, iter->first));
+		total += iter->second.count;
+	}
+	std::sort(sorted.begin(), sorted.end(), profile_compare);
+
+	drcbe_info info;
+	m_beintf.get_info(info);
+
+	fprintf(file, "DRC profile for '%s'\n\n", m_device.tag());
+	fprintf(file, "Cache size:        %d bytes\n", (int)m_cache.size());
+	fprintf(file, "Peak code size:    %d bytes\n", (int)m_profile_peak);
+	fprintf(file, "Hash resets:       %d\n", info.hash_flushes);
+	fprintf(file, "Hash recompiles:   %d\n", info.hash_recompiles);
+	fprintf(file, "Blocks generated:  %d\n", m_profile_blocks);
+	fprintf(file, "Entry points:      %d\n", (int)sorted.size());
+	fprintf(file, "Total executions:  %s\n\n", core_i64_format(total, 0, false));
+
+	fprintf(file, "Mode PC        Executions            %%  Compiles   UML  Native\n");
+	for (int entrynum = 0; entrynum < sorted.size() && entrynum < PROFILE_HOT_ENTRIES; entrynum++)
+	{
+		const profile_entry &entry = m_profile[sorted[entrynum].second];
+		UINT32 mode = sorted[entrynum].second >> 32;
+		UINT32 pc = sorted[entrynum].second;
+		fprintf(file, "%4d %08X %20s %6.2f  %8d %5d %7d\n", mode, pc, core_i64_format(entry.count, 0, false),
+				(total != 0) ? 100.0 * (double)entry.count / (double)total : 0.0, entry.compiles, entry.uml_insts, entry.native_bytes);
+	}
+}
+
+
 //-------------------------------------------------
 //  log_printf - directly printf to the UML log
 //  if generated
@@ -335,12 +471,19 @@ void drcuml_block::end()
 	// optimize the resulting code first
 	optimize();
 
+	// if we're profiling, count executions at each entry point
+	if (m_drcuml.profiling())
+		instrument();
+
 	// if we have a logfile, generate a disassembly of the block
 	if (m_drcuml.logging())
 		disassemble();
 
 	// generate the code via the back-end
+	drccodeptr codestart = m_drcuml.cache().top();
 	m_drcuml.generate(*this, &m_inst[0], m_nextinst);
+	if (m_drcuml.profiling())
+		m_drcuml.profile_commit(m_nextinst, m_drcuml.cache().top() - codestart);
 
 	// block is no longer in use
 	m_inuse = false;
@@ -450,6 +593,31 @@ void drcuml_block::optimize()
 }
 
 
+//-------------------------------------------------
+//  instrument - insert an execution counter
+//  increment after each hash entry point
+//-------------------------------------------------
+
+void drcuml_block::instrument()
+{
+	m_drcuml.profile_begin();
+	for (int instnum = 0; instnum < m_nextinst; instnum++)
+		if (m_inst[instnum].opcode() == OP_HASH)
+		{
+			UINT64 *counter = m_drcuml.profile_counter(m_inst[instnum].param(0).immediate(), m_inst[instnum].param(1).immediate());
+			if (counter == NULL)
+				continue;
+
+			// make room directly after the entry point
+			if (m_nextinst == m_inst.size())
+				m_inst.push_back(instruction());
+			std::copy_backward(m_inst.begin() + instnum + 1, m_inst.begin() + m_nextinst, m_inst.begin() + m_nextinst + 1);
+			m_nextinst++;
+			m_inst[++instnum].dadd(mem(counter), mem(counter), 1);
+		}
+}
+
+
 //-------------------------------------------------
 //  disassemble - disassemble a block of
 //  instructions to the log
@@ -13,6 +13,7 @@
 #ifndef __DRCUML_H__
 #define __DRCUML_H__
 
+#include <map>
 #include "drccache.h"
 #include "uml.h"
 
@@ -83,6 +84,8 @@ struct drcbe_info
 {
 	UINT8               direct_iregs;       // number of direct-mapped integer registers
 	UINT8               direct_fregs;       // number of direct-mapped floating point registers
+	UINT32              hash_recompiles;    // number of hash entries replaced by recompiled code
+	UINT32              hash_flushes;       // number of times the hash tables have been reset
 };
 
 
@@ -120,6 +123,7 @@ public:
 private:
 	// internal helpers
 	void optimize();
+	void instrument();
 	void disassemble();
 	const char *get_comment_text(const uml::instruction &inst, std::string &comment);
 
@@ -146,6 +150,7 @@ public:
 	virtual int execute(uml::code_handle &entry) = 0;
 	virtual void generate(drcuml_block &block, const uml::instruction *instlist, UINT32 numinst) = 0;
 	virtual bool hash_exists(UINT32 mode, UINT32 pc) = 0;
+	virtual void hash_invalidate(UINT32 mode, UINT32 pc) = 0;
 	virtual void get_info(drcbe_info &info) = 0;
 	virtual bool logging() const { return false; }
 
@@ -182,6 +187,7 @@ public:
 	// back-end interface
 	void get_backend_info(drcbe_info &info) { m_beintf.get_info(info); }
 	bool hash_exists(UINT32 mode, UINT32 pc) { return m_beintf.hash_exists(mode, pc); }
+	void hash_invalidate(UINT32 mode, UINT32 pc) { m_beintf.hash_invalidate(mode, pc); }
 	void generate(drcuml_block &block, uml::instruction *instructions, UINT32 count) { m_beintf.generate(block, instructions, count); }
 
 	// handle management
@@ -197,7 +203,31 @@ public:
 	void log_flush() { if (logging()) fflush(m_umllog); }
 	bool logging_native() const { return m_beintf.logging(); }
 
+	// profiling
+	bool profiling() const { return m_profiling; }
+	void profile_begin() { m_profile_pending.clear(); }
+	UINT64 *profile_counter(UINT32 mode, UINT32 pc);
+	void profile_commit(UINT32 numinst, UINT32 native_bytes);
+	void profile_report(FILE *file);
+
 private:
+	// execution profile of a single mode/pc entry point
+	struct profile_entry
+	{
+		profile_entry() : count(0), counter(NULL), compiles(0), uml_insts(0), native_bytes(0) { }
+
+		UINT64                  count;              // executions folded in from flushed code
+		UINT64 *                counter;            // live counter in the cache, or NULL
+		UINT32                  compiles;           // number of times the entry was compiled
+		UINT32                  uml_insts;          // UML instructions in the most recent enclosing block
+		UINT32                  native_bytes;       // native bytes of the most recent enclosing block
+	};
+	typedef std::map<UINT64, profile_entry> profile_map;
+
+	// profiling helpers
+	void profile_fold();
+
+
 	// symbol class
 	class symbol
 	{
@@ -231,6 +261,13 @@ private:
 	simple_list<drcuml_block>   m_blocklist;        // list of active blocks
 	simple_list<uml::code_handle> m_handlelist;     // list of active handles
 	simple_list<symbol>         m_symlist;          // list of symbols
+
+	// profiling state
+	bool                        m_profiling;        // true if counting block executions
+	profile_map                 m_profile;          // per entry point statistics
+	std::vector<profile_entry *> m_profile_pending; // entries in the block being generated
+	UINT32                      m_profile_blocks;   // number of blocks generated
+	size_t                      m_profile_peak;     // peak number of code bytes in the cache
 };
 
 
@@ -27,6 +27,20 @@
 /* seems to be defined on mingw-gcc */
 #undef i386
 
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* size of the execution code cache */
+#define CACHE_SIZE                      (32 * 1024 * 1024)
+
+/* compilation boundaries -- how far back/forward does the analysis extend? */
+#define COMPILE_BACKWARDS_BYTES         128
+#define COMPILE_FORWARDS_BYTES          512
+#define COMPILE_MAX_SEQUENCE            64
+
+
 const device_type I386 = &device_creator<i386_device>;
 const device_type I386SX = &device_creator<i386SX_device>;
 const device_type I486 = &device_creator<i486_device>;
@@ -44,9 +58,16 @@ i386_device::i386_device(const machine_config &mconfig, const char *tag, device_
 	, m_program_config("program", ENDIANNESS_LITTLE, 32, 32, 0)
 	, m_io_config("io", ENDIANNESS_LITTLE, 32, 16, 0)
 	, m_smiact(*this)
+	, m_core(NULL)
+	, m_cache(CACHE_SIZE + sizeof(internal_i386_state))
+	, m_drcuml(NULL)
+	, m_drcfe(NULL)
 {
 	m_program_config.m_logaddr_width = 32;
 	m_program_config.m_page_shift = 12;
+
+	// the recompiler hasn't been validated against the interpreter yet, so it is opt-in
+	m_isdrc = (mconfig.options().drc() && mconfig.options().drc_experimental() && !mconfig.m_force_no_drc) ? true : false;
 }
 
 
@@ -55,9 +76,16 @@ i386_device::i386_device(const machine_config &mconfig, device_type type, const
 	, m_program_config("program", ENDIANNESS_LITTLE, program_data_width, program_addr_width, 0)
 	, m_io_config("io", ENDIANNESS_LITTLE, io_data_width, 16, 0)
 	, m_smiact(*this)
+	, m_core(NULL)
+	, m_cache(CACHE_SIZE + sizeof(internal_i386_state))
+	, m_drcuml(NULL)
+	, m_drcfe(NULL)
 {
 	m_program_config.m_logaddr_width = 32;
 	m_program_config.m_page_shift = 12;
+
+	// the recompiler hasn't been validated against the interpreter yet, so it is opt-in
+	m_isdrc = (mconfig.options().drc() && mconfig.options().drc_experimental() && !mconfig.m_force_no_drc) ? true : false;
 }
 
 i386SX_device::i386SX_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock)
@@ -3219,6 +3247,10 @@ void i386_device::i386_common_init(int tlbsize)
 	m_debugger_temp = 0;
 	m_lock = false;
 
+	/* allocate the state the generated code works on close to the code */
+	m_core = (internal_i386_state *)m_cache.alloc_near(sizeof(internal_i386_state));
+	memset(m_core, 0, sizeof(internal_i386_state));
+
 	zero_state();
 
 	save_item(NAME(m_reg.d));
@@ -3293,6 +3325,37 @@ void i386_device::i386_common_init(int tlbsize)
 	m_smiact.resolve_safe();
 
 	m_icountptr = &m_cycles;
+
+	/* initialize the UML generator; one mode per privilege level/paging combination */
+	UINT32 flags = 0;
+	m_drcuml = auto_alloc(machine(), drcuml_state(*this, m_cache, flags, 4, 32, 0));
+
+	/* add symbols for our stuff */
+	m_drcuml->symbol_add(&m_core->eip, sizeof(m_core->eip), "eip");
+	for (int regnum = 0; regnum < 8; regnum++)
+	{
+		static const char *const regnames[] = { "eax", "ecx", "edx", "ebx", "esp", "ebp", "esi", "edi" };
+		m_drcuml->symbol_add(&m_core->reg.d[regnum], sizeof(m_core->reg.d[regnum]), regnames[regnum]);
+	}
+	m_drcuml->symbol_add(&m_core->cf, sizeof(m_core->cf), "cf");
+	m_drcuml->symbol_add(&m_core->pf, sizeof(m_core->pf), "pf");
+	m_drcuml->symbol_add(&m_core->af, sizeof(m_core->af), "af");
+	m_drcuml->symbol_add(&m_core->zf, sizeof(m_core->zf), "zf");
+	m_drcuml->symbol_add(&m_core->sf, sizeof(m_core->sf), "sf");
+	m_drcuml->symbol_add(&m_core->of, sizeof(m_core->of), "of");
+	m_drcuml->symbol_add(&m_core->mode, sizeof(m_core->mode), "mode");
+
+	/* initialize the front-end helper */
+	m_drcfe = auto_alloc(machine(), i386_frontend(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, COMPILE_MAX_SEQUENCE));
+
+	/* strict verification is needed for code that patches itself */
+	m_drcoptions = I386DRC_COMPATIBLE_OPTIONS;
+	m_cache_dirty = TRUE;
+
+	/* -drc_compare reruns every natively compiled instruction on the interpreter */
+	m_drc_compare = m_isdrc && machine().options().drc_compare();
+	m_compare_mode = COMPARE_ACCESS_NONE;
+	m_compare_count = 0;
 }
 
 void i386_device::device_start()
@@ -3696,6 +3759,21 @@ void i386_device::zero_state()
 	memset( m_opcode_bytes, 0, sizeof(m_opcode_bytes) );
 	m_opcode_pc = 0;
 	m_opcode_bytes_length = 0;
+
+	/* mark the cache dirty so it is updated on next execute */
+	m_cache_dirty = TRUE;
+}
+
+void i386_device::device_stop()
+{
+	if (m_drc_compare)
+		osd_printf_info("%s: %" I64FMT "u instructions matched the interpreter\n", tag(), m_compare_count);
+
+	/* clean up the DRC */
+	if (m_drcfe != NULL)
+		auto_free(machine(), m_drcfe);
+	if (m_drcuml != NULL)
+		auto_free(machine(), m_drcuml);
 }
 
 void i386_device::device_reset()
@@ -3909,51 +3987,66 @@ void i386_device::execute_run()
 		return;
 	}
 
-	while( m_cycles > 0 )
+	if (m_isdrc)
+		execute_run_drc();
+	else
 	{
-		i386_check_irq_line();
-		m_operand_size = m_sreg[CS].d;
-		m_xmm_operand_size = 0;
-		m_address_size = m_sreg[CS].d;
-		m_operand_prefix = 0;
-		m_address_prefix = 0;
+		while( m_cycles > 0 )
+		{
+			i386_check_irq_line();
+			i386_execute_one();
+		}
+	}
+	m_tsc += (cycles - m_cycles);
+}
 
-		m_ext = 1;
-		int old_tf = m_TF;
+/*-------------------------------------------------
+    i386_execute_one - run a single instruction
+    through the interpreter
+-------------------------------------------------*/
 
-		m_segment_prefix = 0;
-		m_prev_eip = m_eip;
+void i386_device::i386_execute_one()
+{
+	m_operand_size = m_sreg[CS].d;
+	m_xmm_operand_size = 0;
+	m_address_size = m_sreg[CS].d;
+	m_operand_prefix = 0;
+	m_address_prefix = 0;
 
-		debugger_instruction_hook(this, m_pc);
+	m_ext = 1;
+	int old_tf = m_TF;
 
-		if(m_delayed_interrupt_enable != 0)
-		{
-			m_IF = 1;
-			m_delayed_interrupt_enable = 0;
-		}
+	m_segment_prefix = 0;
+	m_prev_eip = m_eip;
+
+	debugger_instruction_hook(this, m_pc);
+
+	if(m_delayed_interrupt_enable != 0)
+	{
+		m_IF = 1;
+		m_delayed_interrupt_enable = 0;
+	}
 #ifdef DEBUG_MISSING_OPCODE
-		m_opcode_bytes_length = 0;
-		m_opcode_pc = m_pc;
+	m_opcode_bytes_length = 0;
+	m_opcode_pc = m_pc;
 #endif
-		try
-		{
-			i386_decode_opcode();
-			if(m_TF && old_tf)
-			{
-				m_prev_eip = m_eip;
-				m_ext = 1;
-				i386_trap(1,0,0);
-			}
-			if(m_lock && (m_opcode != 0xf0))
-				m_lock = false;
-		}
-		catch(UINT64 e)
+	try
+	{
+		i386_decode_opcode();
+		if(m_TF && old_tf)
 		{
+			m_prev_eip = m_eip;
 			m_ext = 1;
-			i386_trap_with_error(e&0xffffffff,0,0,e>>32);
+			i386_trap(1,0,0);
 		}
+		if(m_lock && (m_opcode != 0xf0))
+			m_lock = false;
+	}
+	catch(UINT64 e)
+	{
+		m_ext = 1;
+		i386_trap_with_error(e&0xffffffff,0,0,e>>32);
 	}
-	m_tsc += (cycles - m_cycles);
 }
 
 /*************************************************************************/
@@ -4523,3 +4616,5 @@ void pentium4_device::device_reset()
 
 	CHANGE_PC(m_eip);
 }
+
+#include "i386drc.c"
@@ -9,6 +9,8 @@
 #include "softfloat/softfloat.h"
 #include "debug/debugcpu.h"
 #include "cpu/vtlb.h"
+#include "cpu/drcfe.h"
+#include "cpu/drcuml.h"
 
 
 #define INPUT_LINE_A20      1
@@ -23,8 +25,13 @@
 	i386_device::set_smiact(*device, DEVCB_##_devcb);
 
 
+class i386_frontend;
+
+
 class i386_device : public cpu_device
 {
+	friend class i386_frontend;
+
 public:
 	// construction/destruction
 	i386_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock);
@@ -38,10 +45,13 @@ public:
 	UINT64 debug_segofftovirt(symbol_table &table, int params, const UINT64 *param);
 	UINT64 debug_virttophys(symbol_table &table, int params, const UINT64 *param);
 
+	void i386drc_set_options(UINT32 options);
+
 protected:
 	// device-level overrides
 	virtual void device_start();
 	virtual void device_reset();
+	virtual void device_stop();
 	virtual void device_debug_setup();
 
 	// device_execute_interface overrides
@@ -307,6 +317,8 @@ struct I386_CALL_GATE
 	inline void WRITE16(UINT32 ea, UINT16 value);
 	inline void WRITE32(UINT32 ea, UINT32 value);
 	inline void WRITE64(UINT32 ea, UINT64 value);
+	UINT32 compare_read(UINT32 ea, int size);
+	void compare_write(UINT32 ea, int size, UINT32 value);
 	inline UINT8 OR8(UINT8 dst, UINT8 src);
 	inline UINT16 OR16(UINT16 dst, UINT16 src);
 	inline UINT32 OR32(UINT32 dst, UINT32 src);
@@ -1411,7 +1423,118 @@ struct I386_CALL_GATE
 	void pentium_smi();
 	void zero_state();
 	void i386_set_a20_line(int state);
+	void i386_execute_one();
+
+	// Data that needs to be stored close to the generated DRC code; a copy of the
+	// interpreter state that the recompiler uses, synced on every switch between the two
+	struct internal_i386_state
+	{
+		I386_GPR    reg;
+		UINT32      eip;
+		UINT32      cf;                 // flags are one word each so they can be set directly
+		UINT32      pf;
+		UINT32      af;
+		UINT32      zf;
+		UINT32      sf;
+		UINT32      of;
+		UINT32      mode;               // block mode to dispatch with
+		UINT32      arg0;               // address for the slow memory paths
+		UINT32      arg1;               // data for the slow memory paths
+		UINT32      arg2;               // access size for the slow memory paths
+		UINT32      faulted;            // set when a slow memory access raised an exception
+		UINT32      fault;              // exception number
+		UINT32      fault_error;        // exception error code
+		UINT32      flagmask;           // flags compared by the interpreter check
+		UINT32      nextpc;             // where the natively compared instruction continues
+	};
+
+	/* internal compiler state */
+	struct compiler_state
+	{
+		UINT32          cycles;                     /* accumulated cycles */
+		UINT8           mode;                       /* mode the block was compiled for */
+		UINT8           checkints;                  /* need to check interrupts before next instruction */
+		uml::code_label labelnum;                   /* index for local labels */
+		UINT8           compare;                    /* an interpreter comparison is open for this instruction */
+	};
 
+	bool                m_isdrc;
+	internal_i386_state *m_core;                    /* pointer to the near state */
+	drc_cache           m_cache;                    /* pointer to the DRC code cache */
+	drcuml_state *      m_drcuml;                   /* DRC UML generator state */
+	i386_frontend *     m_drcfe;                    /* pointer to the DRC front-end state */
+	UINT32              m_drcoptions;               /* configurable DRC options */
+	UINT8               m_cache_dirty;              /* true if we need to flush the cache */
+
+	/* lock-step comparison against the interpreter (-drc_compare) */
+	struct compare_access
+	{
+		UINT32          address;                    /* linear address as the instruction computed it */
+		UINT32          data;                       /* data read or written */
+		UINT8           size;                       /* access size in bytes */
+		UINT8           write;                      /* true for writes */
+		UINT8           faulted;                    /* true if the access raised an exception */
+		UINT64          fault;                      /* the exception, as thrown */
+	};
+
+	bool                m_drc_compare;              /* check every native instruction against the interpreter */
+	int                 m_compare_mode;             /* COMPARE_ACCESS_* for the memory functions */
+	internal_i386_state m_compare_state;            /* state before the instruction being compared */
+	std::vector<compare_access> m_compare_log;      /* accesses made by the native code */
+	UINT32              m_compare_replayed;         /* accesses the interpreter has matched so far */
+	std::string         m_compare_error;            /* description of the first access mismatch */
+	UINT64              m_compare_count;            /* instructions checked so far */
+
+	uml::code_handle *  m_entry;                    /* entry point */
+	uml::code_handle *  m_nocode;                   /* nocode handler */
+	uml::code_handle *  m_out_of_cycles;            /* out of cycles exception handler */
+	uml::code_handle *  m_tlb_mismatch;             /* TLB mismatch handler */
+	uml::code_handle *  m_fault;                    /* memory fault handler */
+	uml::code_handle *  m_read[4][3];               /* read byte/word/dword, per mode */
+	uml::code_handle *  m_write[4][3];              /* write byte/word/dword, per mode */
+
+	inline void alloc_handle(drcuml_state *drcuml, uml::code_handle **handleptr, const char *name);
+	inline UINT8 drc_mode();
+	bool drc_can_execute();
+	void drc_state_load();
+	void drc_state_store();
+	bool drc_translate_fetch(UINT32 &address);
+
+	void code_flush_cache();
+	void execute_run_drc();
+	void code_compile_block(UINT8 mode, offs_t pc);
+	void static_generate_entry_point();
+	void static_generate_nocode_handler();
+	void static_generate_out_of_cycles();
+	void static_generate_tlb_mismatch();
+	void static_generate_fault_handler();
+	void static_generate_memory_accessor(int mode, int size, int iswrite, const char *name, uml::code_handle **handleptr);
+	const char *log_desc_flags_to_string(UINT32 flags);
+	void log_opcode_desc(drcuml_state *drcuml, const opcode_desc *desclist, int indent);
+	void log_add_disasm_comment(drcuml_block *block, const opcode_desc *desc);
+	void generate_update_cycles(drcuml_block *block, compiler_state *compiler, uml::parameter param, int allow_exception);
+	void generate_checksum_block(drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast);
+	void generate_sequence_instruction(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	void generate_interpreter_call(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	void generate_branch(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, uml::parameter target, int extra_cycles);
+	void generate_condition(drcuml_block *block, int cc);
+	int generate_modrm_ea(drcuml_block *block, const UINT8 *modrm);
+	void generate_read_reg8(drcuml_block *block, uml::parameter dst, int reg);
+	void generate_write_reg8(drcuml_block *block, int reg, uml::parameter src);
+	void generate_flags(drcuml_block *block, const opcode_desc *desc, int aluop);
+	void generate_push(drcuml_block *block, compiler_state *compiler, uml::parameter value);
+	int generate_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	int generate_alu(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, int aluop, int form, const UINT8 *modrm);
+	void generate_compare_end(drcuml_block *block, compiler_state *compiler, uml::parameter param);
+	void compare_instruction(bool native_faulted);
+
+public:
+	void func_execute_one();
+	void func_read_slow();
+	void func_write_slow();
+	void func_compare_begin();
+	void func_compare_end();
+	void func_compare_fault();
 };
 
 
@@ -1521,6 +1644,25 @@ protected:
 };
 
 
+class i386_frontend : public drc_frontend
+{
+public:
+	i386_frontend(i386_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence);
+
+protected:
+	virtual bool describe(opcode_desc &desc, const opcode_desc *prev);
+
+private:
+	bool translate_fetch(offs_t &address);
+	int fetch_bytes(opcode_desc &desc);
+	bool describe_one_byte(opcode_desc &desc, const UINT8 *op, bool paging);
+	bool describe_two_byte(opcode_desc &desc, const UINT8 *op, bool paging);
+	void describe_interpreted(opcode_desc &desc, UINT32 flags);
+
+	i386_device *m_i386;
+};
+
+
 extern const device_type I386;
 extern const device_type I386SX;
 extern const device_type I486;
@@ -1533,4 +1675,25 @@ extern const device_type PENTIUM3;
 extern const device_type PENTIUM4;
 
 
+/***************************************************************************
+    COMPILER-SPECIFIC OPTIONS
+***************************************************************************/
+
+#define I386DRC_STRICT_VERIFY   0x0001          /* verify all instructions */
+
+#define I386DRC_COMPATIBLE_OPTIONS  (I386DRC_STRICT_VERIFY)
+#define I386DRC_FASTEST_OPTIONS     (0)
+
+/* flag liveness bits in regin[1]/regout[1] of the front-end descriptions */
+#define I386_FLAG_CF            0x0001
+#define I386_FLAG_PF            0x0002
+#define I386_FLAG_AF            0x0004
+#define I386_FLAG_ZF            0x0008
+#define I386_FLAG_SF            0x0010
+#define I386_FLAG_OF            0x0020
+#define I386_FLAG_ALL           0x003f
+
+/* front-end decision that an instruction is handed to the interpreter */
+#define I386_OPFLAG_INTERPRET   0x80000000
+
 #endif /* __I386INTF_H__ */
@@ -0,0 +1,1912 @@
+// license:BSD-3-Clause
+// copyright-holders:Ville Linde, Barry Rodewald, Carl, Philip Bennett
+/***************************************************************************
+
+    i386drc.c
+    Universal machine language-based i386 recompiler.
+
+    Included from i386.c so that the interpreter can be reused for every
+    instruction that is not generated natively.
+
+    Only flat 32-bit protected-mode code is recompiled: CS, SS, DS and ES
+    must have a zero base and a 4GB limit, and SS/DS/ES must be plain
+    writable data segments, so an effective address is a linear address.
+    Anything else, including virtual 8086 mode, single stepping and the
+    debugger, runs through the interpreter one instruction at a time.
+
+    Memory accesses go through small per-mode subroutines that look the
+    linear address up in the VTLB and fall back to the interpreter's
+    READ/WRITE functions for misses, misaligned accesses and faults.
+
+***************************************************************************/
+
+#include "debugger.h"
+#include "mconfig.h"
+#include "cpu/drcumlsh.h"
+
+using namespace uml;
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* map variables */
+#define MAPVAR_PC                   M0
+#define MAPVAR_CYCLES               M1
+
+/* exit codes */
+#define EXECUTE_OUT_OF_CYCLES       0
+#define EXECUTE_MISSING_CODE        1
+#define EXECUTE_TLB_MISMATCH        2
+#define EXECUTE_RETURN              3
+#define EXECUTE_FAULT               4
+
+/* blocks are compiled per privilege level/paging combination */
+#define MODE_USER                   0x01
+#define MODE_PAGING                 0x02
+
+/* ALU operations; the first eight match the ModRM reg field of 80-83 */
+enum
+{
+	ALU_ADD = 0,
+	ALU_OR,
+	ALU_ADC,
+	ALU_SBB,
+	ALU_AND,
+	ALU_SUB,
+	ALU_XOR,
+	ALU_CMP,
+	ALU_TEST,
+	ALU_INC,
+	ALU_DEC
+};
+
+/* ALU operand forms */
+enum
+{
+	ALU_FORM_RM_REG = 0,        /* op rm32,r32 */
+	ALU_FORM_REG_RM,            /* op r32,rm32 */
+	ALU_FORM_ACC_IMM,           /* op eax,imm32 */
+	ALU_FORM_RM_IMM32,          /* op rm32,imm32 */
+	ALU_FORM_RM_IMM8,           /* op rm32,simm8 */
+	ALU_FORM_RM_ONE             /* inc/dec rm32 */
+};
+
+
+/***************************************************************************
+    MACROS
+***************************************************************************/
+
+#define GPR32(r)        mem(&m_core->reg.d[r])
+
+#define IMM16(p)        ((p)[0] | ((p)[1] << 8))
+#define IMM32(p)        ((p)[0] | ((p)[1] << 8) | ((p)[2] << 16) | ((UINT32)(p)[3] << 24))
+
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    alloc_handle - allocate a handle if not
+    already allocated
+-------------------------------------------------*/
+
+inline void i386_device::alloc_handle(drcuml_state *drcuml, code_handle **handleptr, const char *name)
+{
+	if (*handleptr == NULL)
+		*handleptr = drcuml->handle_alloc(name);
+}
+
+
+/*-------------------------------------------------
+    drc_mode - return the block mode for the
+    current privilege level and paging state
+-------------------------------------------------*/
+
+inline UINT8 i386_device::drc_mode()
+{
+	return ((m_CPL == 3) ? MODE_USER : 0) | ((m_cr[0] & 0x80000000) ? MODE_PAGING : 0);
+}
+
+
+/*-------------------------------------------------
+    drc_can_execute - return true if the current
+    state can be run from recompiled code
+-------------------------------------------------*/
+
+bool i386_device::drc_can_execute()
+{
+	if (!PROTECTED_MODE || V8086_MODE || m_TF || m_lock || m_delayed_interrupt_enable)
+		return false;
+	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
+		return false;
+	if (m_a20_mask != 0xffffffff || (m_smi && !m_smm))
+		return false;
+
+	/* 32-bit flat code, stack and data segments only */
+	if (!m_sreg[CS].d || !m_sreg[SS].d)
+		return false;
+	if (!m_sreg[CS].valid || m_sreg[CS].base != 0 || m_sreg[CS].limit != 0xffffffff)
+		return false;
+	static const int datasegs[] = { SS, DS, ES };
+	for (int segnum = 0; segnum < ARRAY_LENGTH(datasegs); segnum++)
+	{
+		const I386_SREG &seg = m_sreg[datasegs[segnum]];
+		if (!seg.valid || seg.base != 0 || seg.limit != 0xffffffff || (seg.flags & 0x0e) != 0x02)
+			return false;
+	}
+	return true;
+}
+
+
+/*-------------------------------------------------
+    drc_state_load/store - copy the state the
+    generated code works on to and from the
+    interpreter's
+-------------------------------------------------*/
+
+void i386_device::drc_state_load()
+{
+	m_core->reg = m_reg;
+	m_core->eip = m_eip;
+	m_core->cf = m_CF;
+	m_core->pf = m_PF;
+	m_core->af = m_AF;
+	m_core->zf = m_ZF;
+	m_core->sf = m_SF;
+	m_core->of = m_OF;
+}
+
+void i386_device::drc_state_store()
+{
+	m_reg = m_core->reg;
+	m_eip = m_core->eip;
+	m_CF = m_core->cf;
+	m_PF = m_core->pf;
+	m_AF = m_core->af;
+	m_ZF = m_core->zf;
+	m_SF = m_core->sf;
+	m_OF = m_core->of;
+	CHANGE_PC(m_eip);
+}
+
+
+/*-------------------------------------------------
+    drc_translate_fetch - make sure the TLB holds
+    an entry for fetching at the given address
+-------------------------------------------------*/
+
+bool i386_device::drc_translate_fetch(UINT32 &address)
+{
+	UINT32 error;
+	return translate_address(m_CPL, TRANSLATE_FETCH, &address, &error) ? true : false;
+}
+
+
+/***************************************************************************
+    C FUNCTION CALLBACKS
+***************************************************************************/
+
+/*-------------------------------------------------
+    cfunc_execute_one - run a single instruction
+    through the interpreter
+-------------------------------------------------*/
+
+static void cfunc_execute_one(void *param)
+{
+	((i386_device *)param)->func_execute_one();
+}
+
+void i386_device::func_execute_one()
+{
+	drc_state_store();
+	i386_execute_one();
+	drc_state_load();
+}
+
+
+/*-------------------------------------------------
+    cfunc_read_slow/cfunc_write_slow - perform a
+    memory access through the interpreter's
+    functions, noting any exception raised
+-------------------------------------------------*/
+
+static void cfunc_read_slow(void *param)
+{
+	((i386_device *)param)->func_read_slow();
+}
+
+void i386_device::func_read_slow()
+{
+	m_core->faulted = 0;
+	try
+	{
+		switch (m_core->arg2)
+		{
+			case 1: m_core->arg1 = READ8(m_core->arg0);     break;
+			case 2: m_core->arg1 = READ16(m_core->arg0);    break;
+			case 4: m_core->arg1 = READ32(m_core->arg0);    break;
+		}
+	}
+	catch (UINT64 e)
+	{
+		m_core->faulted = 1;
+		m_core->fault = e & 0xffffffff;
+		m_core->fault_error = e >> 32;
+	}
+}
+
+static void cfunc_write_slow(void *param)
+{
+	((i386_device *)param)->func_write_slow();
+}
+
+void i386_device::func_write_slow()
+{
+	m_core->faulted = 0;
+	try
+	{
+		switch (m_core->arg2)
+		{
+			case 1: WRITE8(m_core->arg0, m_core->arg1);     break;
+			case 2: WRITE16(m_core->arg0, m_core->arg1);    break;
+			case 4: WRITE32(m_core->arg0, m_core->arg1);    break;
+		}
+	}
+	catch (UINT64 e)
+	{
+		m_core->faulted = 1;
+		m_core->fault = e & 0xffffffff;
+		m_core->fault_error = e >> 32;
+	}
+}
+
+
+/*-------------------------------------------------
+    cfunc_compare_begin - snapshot the state
+    before a natively generated instruction and
+    start logging its memory accesses
+-------------------------------------------------*/
+
+static void cfunc_compare_begin(void *param)
+{
+	((i386_device *)param)->func_compare_begin();
+}
+
+void i386_device::func_compare_begin()
+{
+	m_compare_state = *m_core;
+	m_compare_log.clear();
+	m_compare_mode = COMPARE_ACCESS_RECORD;
+}
+
+
+/*-------------------------------------------------
+    compare_read/compare_write - log the native
+    code's accesses and any exception they raise,
+    then hand the interpreter the same reads and
+    exceptions and check its writes
+-------------------------------------------------*/
+
+UINT32 i386_device::compare_read(UINT32 ea, int size)
+{
+	int mode = m_compare_mode;
+
+	/* the native side really reads, and remembers what it got */
+	if (mode == COMPARE_ACCESS_RECORD)
+	{
+		compare_access access = { ea, 0, (UINT8)size, FALSE, FALSE, 0 };
+
+		m_compare_mode = COMPARE_ACCESS_NONE;
+		try
+		{
+			access.data = (size == 1) ? READ8(ea) : (size == 2) ? READ16(ea) : READ32(ea);
+		}
+		catch (UINT64 e)
+		{
+			access.faulted = TRUE;
+			access.fault = e;
+		}
+		m_compare_mode = mode;
+
+		m_compare_log.push_back(access);
+		if (access.faulted)
+			throw access.fault;
+		return access.data;
+	}
+
+	/* the interpreter gets the next logged read, which must be the same access */
+	if (m_compare_replayed < m_compare_log.size())
+	{
+		const compare_access &access = m_compare_log[m_compare_replayed];
+		if (!access.write && access.address == ea && access.size == size)
+		{
+			m_compare_replayed++;
+			if (access.faulted)
+				throw access.fault;
+			return access.data;
+		}
+	}
+
+	if (m_compare_error.empty())
+		strprintf(m_compare_error, "interpreter read%d %08X as access %d, which the native code did not make\n", size * 8, ea, m_compare_replayed);
+	return 0;
+}
+
+void i386_device::compare_write(UINT32 ea, int size, UINT32 value)
+{
+	int mode = m_compare_mode;
+
+	if (mode == COMPARE_ACCESS_RECORD)
+	{
+		compare_access access = { ea, value, (UINT8)size, TRUE, FALSE, 0 };
+
+		m_compare_mode = COMPARE_ACCESS_NONE;
+		try
+		{
+			if (size == 1)
+				WRITE8(ea, value);
+			else if (size == 2)
+				WRITE16(ea, value);
+			else
+				WRITE32(ea, value);
+		}
+		catch (UINT64 e)
+		{
+			access.faulted = TRUE;
+			access.fault = e;
+		}
+		m_compare_mode = mode;
+
+		m_compare_log.push_back(access);
+		if (access.faulted)
+			throw access.fault;
+		return;
+	}
+
+	/* the interpreter's writes are only checked, the native code has already made them */
+	if (m_compare_replayed < m_compare_log.size())
+	{
+		const compare_access &access = m_compare_log[m_compare_replayed];
+		if (access.write && access.address == ea && access.size == size && access.data == value)
+		{
+			m_compare_replayed++;
+			if (access.faulted)
+				throw access.fault;
+			return;
+		}
+	}
+
+	if (m_compare_error.empty())
+		strprintf(m_compare_error, "interpreter wrote%d %08X=%0*X as access %d, which the native code did not make\n", size * 8, ea, size * 2, value, m_compare_replayed);
+}
+
+
+/*-------------------------------------------------
+    cfunc_compare_end/cfunc_compare_fault - rerun
+    the instruction on the interpreter once the
+    native code has finished it or taken an
+    exception in it, and stop on any difference
+-------------------------------------------------*/
+
+static void cfunc_compare_end(void *param)
+{
+	((i386_device *)param)->func_compare_end();
+}
+
+void i386_device::func_compare_end()
+{
+	compare_instruction(false);
+}
+
+static void cfunc_compare_fault(void *param)
+{
+	((i386_device *)param)->func_compare_fault();
+}
+
+void i386_device::func_compare_fault()
+{
+	compare_instruction(true);
+}
+
+void i386_device::compare_instruction(bool native_faulted)
+{
+	internal_i386_state native = *m_core;
+	UINT64 native_fault = native.fault | ((UINT64)native.fault_error << 32);
+	UINT32 flagmask = m_compare_state.flagmask;
+	UINT32 nextpc = native.nextpc;
+	int cycles = m_cycles;
+	bool faulted = false;
+	UINT64 fault = 0;
+
+	/* rerun from the saved state with the native code's reads; as i386_execute_one, but an exception is noted rather than taken */
+	*m_core = m_compare_state;
+	drc_state_store();
+	m_compare_mode = COMPARE_ACCESS_REPLAY;
+	m_compare_replayed = 0;
+	m_compare_error.clear();
+
+	m_operand_size = m_sreg[CS].d;
+	m_xmm_operand_size = 0;
+	m_address_size = m_sreg[CS].d;
+	m_operand_prefix = 0;
+	m_address_prefix = 0;
+	m_segment_prefix = 0;
+	m_ext = 1;
+	m_prev_eip = m_eip;
+	try
+	{
+		i386_decode_opcode();
+	}
+	catch (UINT64 e)
+	{
+		faulted = true;
+		fault = e;
+	}
+	m_compare_mode = COMPARE_ACCESS_NONE;
+	m_cycles = cycles;
+
+	std::string diffs = m_compare_error;
+	if (diffs.empty() && m_compare_replayed != m_compare_log.size())
+	{
+		const compare_access &access = m_compare_log[m_compare_replayed];
+		strprintf(diffs, "native code %s%d %08X=%0*X as access %d, which the interpreter did not make\n",
+			access.write ? "wrote" : "read", access.size * 8, access.address, access.size * 2, access.data, m_compare_replayed);
+	}
+	if (native_faulted != faulted || (faulted && native_fault != fault))
+		strcatprintf(diffs, "exception: %s %d, error %08X (interpreter %s %d, error %08X)\n",
+			native_faulted ? "vector" : "none", (int)(native_fault & 0xffffffff), (UINT32)(native_fault >> 32),
+			faulted ? "vector" : "none", (int)(fault & 0xffffffff), (UINT32)(fault >> 32));
+
+	/* after an exception the interpreter's EIP is wherever decoding got to */
+	if (!native_faulted && !faulted && m_eip != nextpc)
+		strcatprintf(diffs, "next eip: %08X (interpreter %08X)\n", nextpc, m_eip);
+	for (int regnum = 0; regnum < 8; regnum++)
+	{
+		static const char *const regnames[] = { "eax", "ecx", "edx", "ebx", "esp", "ebp", "esi", "edi" };
+		if (native.reg.d[regnum] != m_reg.d[regnum])
+			strcatprintf(diffs, "%s: %08X (interpreter %08X)\n", regnames[regnum], native.reg.d[regnum], m_reg.d[regnum]);
+	}
+
+	/* flags the instruction sets for nobody to read are not computed natively */
+	if (((flagmask & I386_FLAG_CF) && native.cf != m_CF) || ((flagmask & I386_FLAG_PF) && native.pf != m_PF) ||
+		((flagmask & I386_FLAG_AF) && native.af != m_AF) || ((flagmask & I386_FLAG_ZF) && native.zf != m_ZF) ||
+		((flagmask & I386_FLAG_SF) && native.sf != m_SF) || ((flagmask & I386_FLAG_OF) && native.of != m_OF))
+		strcatprintf(diffs, "flags: C%d P%d A%d Z%d S%d O%d (interpreter C%d P%d A%d Z%d S%d O%d, compared %02X)\n",
+			native.cf, native.pf, native.af, native.zf, native.sf, native.of, m_CF, m_PF, m_AF, m_ZF, m_SF, m_OF, flagmask);
+
+	if (!diffs.empty())
+	{
+		UINT8 oprom[16];
+		char buffer[100];
+
+		for (int byte = 0; byte < 16; byte++)
+		{
+			offs_t address = m_compare_state.eip + byte;
+			oprom[byte] = memory_translate(AS_PROGRAM, TRANSLATE_FETCH_DEBUG, address) ? m_direct->read_byte(address) : 0;
+		}
+		i386_dasm_one(buffer, m_compare_state.eip, oprom, 32);
+
+		/* report before stopping, since the exception may not unwind through the generated code */
+		osd_printf_error("I386DRC: %08X: %s differs from the interpreter after %" I64FMT "u matching instructions\n%s",
+			m_compare_state.eip, buffer, m_compare_count, diffs.c_str());
+		fatalerror("I386DRC: native code differs from the interpreter at %08X\n", m_compare_state.eip);
+	}
+
+	/* carry on from the native state, whose timing the interpreter doesn't share */
+	*m_core = native;
+	m_compare_count++;
+}
+
+
+/***************************************************************************
+    CORE EXECUTION
+***************************************************************************/
+
+/*-------------------------------------------------
+    code_flush_cache - flush the cache and
+    regenerate static code
+-------------------------------------------------*/
+
+void i386_device::code_flush_cache()
+{
+	static const char *const sizenames[] = { "8", "16", "32" };
+	static const char *const modenames[] = { "s", "u", "s_p", "u_p" };
+	drcuml_state *drcuml = m_drcuml;
+
+	/* empty the transient cache contents */
+	drcuml->reset();
+
+	try
+	{
+		/* generate the entry point and exception handlers */
+		static_generate_nocode_handler();
+		static_generate_out_of_cycles();
+		static_generate_tlb_mismatch();
+		static_generate_fault_handler();
+		static_generate_entry_point();
+
+		/* add subroutines for memory accesses, one set per mode */
+		for (int mode = 0; mode < 4; mode++)
+			for (int size = 0; size < 3; size++)
+			{
+				char name[20];
+				sprintf(name, "read%s_%s", sizenames[size], modenames[mode]);
+				static_generate_memory_accessor(mode, size, FALSE, name, &m_read[mode][size]);
+				sprintf(name, "write%s_%s", sizenames[size], modenames[mode]);
+				static_generate_memory_accessor(mode, size, TRUE, name, &m_write[mode][size]);
+			}
+	}
+	catch (drcuml_block::abort_compilation &)
+	{
+		fatalerror("Unable to generate i386 static code\n");
+	}
+
+	m_cache_dirty = FALSE;
+}
+
+
+/*-------------------------------------------------
+    execute_run_drc - run the recompiler while the
+    CPU is in a state it can handle, and the
+    interpreter otherwise
+-------------------------------------------------*/
+
+void i386_device::execute_run_drc()
+{
+	drcuml_state *drcuml = m_drcuml;
+	int execute_result;
+
+	/* reset the cache if dirty */
+	if (m_cache_dirty)
+		code_flush_cache();
+
+	while (m_cycles > 0)
+	{
+		i386_check_irq_line();
+
+		if (!drc_can_execute())
+		{
+			i386_execute_one();
+			continue;
+		}
+
+		/* run as much as we can */
+		m_core->mode = drc_mode();
+		drc_state_load();
+		execute_result = drcuml->execute(*m_entry);
+		drc_state_store();
+
+		switch (execute_result)
+		{
+			/* if we need to recompile, do it */
+			case EXECUTE_MISSING_CODE:
+				code_compile_block(drc_mode(), m_eip);
+				break;
+
+			/* refill the TLB and recompile; if the code page is not mapped, let the interpreter fault */
+			case EXECUTE_TLB_MISMATCH:
+			{
+				UINT32 address = m_eip;
+				if (drc_translate_fetch(address))
+					code_compile_block(drc_mode(), m_eip);
+				else
+					i386_execute_one();
+				break;
+			}
+
+			/* a memory access in the generated code faulted */
+			case EXECUTE_FAULT:
+				m_prev_eip = m_eip;
+				m_ext = 1;
+				i386_trap_with_error(m_core->fault, 0, 0, m_core->fault_error);
+				break;
+		}
+	}
+}
+
+
+/*-------------------------------------------------
+    code_compile_block - compile a block of the
+    given mode at the specified pc
+-------------------------------------------------*/
+
+void i386_device::code_compile_block(UINT8 mode, offs_t pc)
+{
+	drcuml_state *drcuml = m_drcuml;
+	compiler_state compiler = { 0 };
+	const opcode_desc *seqhead, *seqlast;
+	const opcode_desc *desclist;
+	int override = FALSE;
+	drcuml_block *block;
+
+	g_profiler.start(PROFILER_DRC_COMPILE);
+
+	/* get a description of this sequence */
+	desclist = m_drcfe->describe_code(pc);
+	if (drcuml->logging() || drcuml->logging_native())
+		log_opcode_desc(drcuml, desclist, 0);
+
+	bool succeeded = false;
+	while (!succeeded)
+	{
+		try
+		{
+			/* start the block; x86 instructions are short, so leave room for a lot of them */
+			block = drcuml->begin_block(16384);
+
+			/* every instruction in the block is generated for this mode */
+			compiler.mode = mode;
+			compiler.labelnum = 1;
+
+			/* loop until we get through all instruction sequences */
+			for (seqhead = desclist; seqhead != NULL; seqhead = seqlast->next())
+			{
+				const opcode_desc *curdesc;
+				UINT32 nextpc;
+
+				/* add a code log entry */
+				if (drcuml->logging())
+					block->append_comment("-------------------------");                 // comment
+
+				/* determine the last instruction in this sequence */
+				for (seqlast = seqhead; seqlast != NULL; seqlast = seqlast->next())
+					if (seqlast->flags & OPFLAG_END_SEQUENCE)
+						break;
+				assert(seqlast != NULL);
+
+				/* if we don't have a hash for this mode/pc, or if we are overriding all, add one */
+				if (override || !drcuml->hash_exists(mode, seqhead->pc))
+					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
+
+				/* if we already have a hash, and this is the first sequence, assume that we */
+				/* are recompiling due to being out of sync and allow future overrides */
+				else if (seqhead == desclist)
+				{
+					override = TRUE;
+					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
+				}
+
+				/* otherwise, redispatch to that fixed PC and skip the rest of the processing */
+				else
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+					UML_HASHJMP(block, mode, seqhead->pc, *m_nocode);                       // hashjmp <mode>,seqhead->pc,nocode
+					continue;
+				}
+
+				/* validate this code block if we're not pointing into ROM */
+				if (m_program->get_write_ptr(seqhead->physpc) != NULL)
+					generate_checksum_block(block, &compiler, seqhead, seqlast);
+
+				/* label this instruction, if it may be jumped to locally */
+				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+
+				/* iterate over instructions in the sequence and compile them */
+				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+					generate_sequence_instruction(block, &compiler, curdesc);
+
+				/* if we need to return to the start, do it */
+				if (seqlast->flags & OPFLAG_RETURN_TO_START)
+					nextpc = pc;
+
+				/* otherwise we just go to the next instruction */
+				else
+					nextpc = seqlast->pc + seqlast->length;
+
+				/* count off cycles and go there */
+				generate_update_cycles(block, &compiler, nextpc, TRUE);                    // <subtract cycles>
+
+				/* if the last instruction can change modes, use the live mode */
+				if (seqlast->flags & OPFLAG_CAN_CHANGE_MODES)
+					UML_EXIT(block, EXECUTE_RETURN);                                        // exit    EXECUTE_RETURN
+				else if (seqlast->next() == NULL || seqlast->next()->pc != nextpc)
+					UML_HASHJMP(block, mode, nextpc, *m_nocode);                            // hashjmp <mode>,nextpc,nocode
+			}
+
+			/* end the sequence */
+			block->end();
+			g_profiler.stop();
+			succeeded = true;
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			code_flush_cache();
+		}
+	}
+}
+
+
+/***************************************************************************
+    STATIC CODEGEN
+***************************************************************************/
+
+/*-------------------------------------------------
+    static_generate_entry_point - generate a
+    static entry point
+-------------------------------------------------*/
+
+void i386_device::static_generate_entry_point()
+{
+	drcuml_state *drcuml = m_drcuml;
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(20);
+
+	/* forward references */
+	alloc_handle(drcuml, &m_nocode, "nocode");
+	alloc_handle(drcuml, &m_entry, "entry");
+	UML_HANDLE(block, *m_entry);                                                    // handle  entry
+
+	/* generate a hash jump via the current mode and PC */
+	UML_HASHJMP(block, mem(&m_core->mode), mem(&m_core->eip), *m_nocode);          // hashjmp <mode>,<eip>,nocode
+
+	block->end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_nocode_handler - generate an
+    exception handler for "out of code"
+-------------------------------------------------*/
+
+void i386_device::static_generate_nocode_handler()
+{
+	drcuml_state *drcuml = m_drcuml;
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(10);
+
+	/* generate a hash jump via the current mode and PC */
+	alloc_handle(drcuml, &m_nocode, "nocode");
+	UML_HANDLE(block, *m_nocode);                                                   // handle  nocode
+	UML_GETEXP(block, I0);                                                          // getexp  i0
+	UML_MOV(block, mem(&m_core->eip), I0);                                          // mov     [eip],i0
+	UML_EXIT(block, EXECUTE_MISSING_CODE);                                          // exit    EXECUTE_MISSING_CODE
+
+	block->end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_out_of_cycles - generate an
+    out of cycles exception handler
+-------------------------------------------------*/
+
+void i386_device::static_generate_out_of_cycles()
+{
+	drcuml_state *drcuml = m_drcuml;
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(10);
+
+	/* generate a hash jump via the current mode and PC */
+	alloc_handle(drcuml, &m_out_of_cycles, "out_of_cycles");
+	UML_HANDLE(block, *m_out_of_cycles);                                            // handle  out_of_cycles
+	UML_GETEXP(block, I0);                                                          // getexp  i0
+	UML_MOV(block, mem(&m_core->eip), I0);                                          // mov     [eip],i0
+	UML_EXIT(block, EXECUTE_OUT_OF_CYCLES);                                         // exit    EXECUTE_OUT_OF_CYCLES
+
+	block->end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_tlb_mismatch - generate a
+    handler for a code page whose TLB entry is
+    missing or has changed
+-------------------------------------------------*/
+
+void i386_device::static_generate_tlb_mismatch()
+{
+	drcuml_state *drcuml = m_drcuml;
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(20);
+
+	/* the instructions before this one in the block have run; count their cycles */
+	alloc_handle(drcuml, &m_tlb_mismatch, "tlb_mismatch");
+	UML_HANDLE(block, *m_tlb_mismatch);                                             // handle  tlb_mismatch
+	UML_RECOVER(block, mem(&m_core->eip), MAPVAR_PC);                               // recover [eip],PC
+	UML_RECOVER(block, I1, MAPVAR_CYCLES);                                          // recover i1,CYCLES
+	UML_LOAD(block, I0, &m_cycles, 0, SIZE_DWORD, SCALE_x4);                        // load    i0,[cycles]
+	UML_SUB(block, I0, I0, I1);                                                     // sub     i0,i0,i1
+	UML_STORE(block, &m_cycles, 0, I0, SIZE_DWORD, SCALE_x4);                       // store   [cycles],i0
+	UML_EXIT(block, EXECUTE_TLB_MISMATCH);                                          // exit    EXECUTE_TLB_MISMATCH
+
+	block->end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_fault_handler - generate a
+    handler for a memory access that raised an
+    exception; the instruction is restarted
+    through the interpreter's trap code
+-------------------------------------------------*/
+
+void i386_device::static_generate_fault_handler()
+{
+	drcuml_state *drcuml = m_drcuml;
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(20);
+
+	alloc_handle(drcuml, &m_fault, "fault");
+	UML_HANDLE(block, *m_fault);                                                    // handle  fault
+	UML_RECOVER(block, mem(&m_core->eip), MAPVAR_PC);                               // recover [eip],PC
+	if (m_drc_compare)
+		UML_CALLC(block, cfunc_compare_fault, this);                                // callc   cfunc_compare_fault
+	UML_RECOVER(block, I1, MAPVAR_CYCLES);                                          // recover i1,CYCLES
+	UML_LOAD(block, I0, &m_cycles, 0, SIZE_DWORD, SCALE_x4);                        // load    i0,[cycles]
+	UML_SUB(block, I0, I0, I1);                                                     // sub     i0,i0,i1
+	UML_STORE(block, &m_cycles, 0, I0, SIZE_DWORD, SCALE_x4);                       // store   [cycles],i0
+	UML_EXIT(block, EXECUTE_FAULT);                                                 // exit    EXECUTE_FAULT
+
+	block->end();
+}
+
+
+/*------------------------------------------------------------------
+    static_generate_memory_accessor
+------------------------------------------------------------------*/
+
+void i386_device::static_generate_memory_accessor(int mode, int size, int iswrite, const char *name, code_handle **handleptr)
+{
+	/* on entry, linear address is in I0; data for writes is in I1 */
+	/* on exit, read result is in I0 */
+	/* routine trashes I0-I3 */
+	static const operand_size opsize[] = { SIZE_BYTE, SIZE_WORD, SIZE_DWORD };
+	drcuml_state *drcuml = m_drcuml;
+	drcuml_block *block;
+	int bytes = 1 << size;
+	code_label slow = 1;
+
+	/* begin generating */
+	block = drcuml->begin_block(64);
+
+	/* add a global entry for this */
+	alloc_handle(drcuml, handleptr, name);
+	UML_HANDLE(block, **handleptr);                                                 // handle  *handleptr
+
+	/* when comparing with the interpreter, every access goes through its functions so it can be logged */
+	if (m_drc_compare)
+		UML_JMP(block, slow);                                                       // jmp     slow
+
+	/* misaligned accesses are split up by the interpreter */
+	else if (bytes > 1)
+	{
+		UML_TEST(block, I0, bytes - 1);                                             // test    i0,bytes-1
+		UML_JMPc(block, COND_NZ, slow);                                             // jmp     slow,nz
+	}
+
+	/* look the page up in the TLB; a missing entry or permission goes the slow way */
+	if (mode & MODE_PAGING)
+	{
+		int type = (iswrite ? TRANSLATE_WRITE : TRANSLATE_READ) | ((mode & MODE_USER) ? TRANSLATE_USER_MASK : 0);
+
+		UML_SHR(block, I3, I0, 12);                                                 // shr     i3,i0,12
+		UML_LOAD(block, I3, (void *)vtlb_table(m_vtlb), I3, SIZE_DWORD, SCALE_x4);  // load    i3,[vtlb],i3,dword
+		if (!iswrite)
+		{
+			UML_TEST(block, I3, 1 << type);                                         // test    i3,1 << type
+			UML_JMPc(block, COND_Z, slow);                                          // jmp     slow,z
+		}
+		else
+		{
+			/* the first write to a page has to set its dirty bit */
+			UML_AND(block, I2, I3, (1 << type) | VTLB_FLAG_DIRTY);                  // and     i2,i3,(1 << type) | DIRTY
+			UML_CMP(block, I2, (1 << type) | VTLB_FLAG_DIRTY);                      // cmp     i2,(1 << type) | DIRTY
+			UML_JMPc(block, COND_NE, slow);                                         // jmp     slow,ne
+		}
+		UML_ROLINS(block, I0, I3, 0, 0xfffff000);                                   // rolins  i0,i3,0,0xfffff000
+	}
+
+	if (iswrite)
+		UML_WRITE(block, I0, I1, opsize[size], SPACE_PROGRAM);                      // write   i0,i1,size,program
+	else
+		UML_READ(block, I0, I0, opsize[size], SPACE_PROGRAM);                       // read    i0,i0,size,program
+	UML_RET(block);                                                                 // ret
+
+	if (bytes > 1 || (mode & MODE_PAGING) || m_drc_compare)
+	{
+		UML_LABEL(block, slow);                                                     // slow:
+		UML_MOV(block, mem(&m_core->arg0), I0);                                     // mov     [arg0],i0
+		if (iswrite)
+			UML_MOV(block, mem(&m_core->arg1), I1);                                 // mov     [arg1],i1
+		UML_MOV(block, mem(&m_core->arg2), bytes);                                  // mov     [arg2],bytes
+		UML_CALLC(block, iswrite ? cfunc_write_slow : cfunc_read_slow, this);       // callc   read_slow/write_slow
+		UML_CMP(block, mem(&m_core->faulted), 0);                                   // cmp     [faulted],0
+		UML_EXHc(block, COND_NE, *m_fault, 0);                                      // exh     fault,0,ne
+		if (!iswrite)
+			UML_MOV(block, I0, mem(&m_core->arg1));                                 // mov     i0,[arg1]
+		UML_RET(block);                                                             // ret
+	}
+
+	block->end();
+}
+
+
+
+/***************************************************************************
+    CODE LOGGING HELPERS
+***************************************************************************/
+
+/*-------------------------------------------------
+    log_desc_flags_to_string - generate a string
+    representing the instruction description
+    flags
+-------------------------------------------------*/
+
+const char *i386_device::log_desc_flags_to_string(UINT32 flags)
+{
+	static char tempbuf[30];
+	char *dest = tempbuf;
+
+	/* branches */
+	if (flags & OPFLAG_IS_UNCONDITIONAL_BRANCH)
+		*dest++ = 'U';
+	else if (flags & OPFLAG_IS_CONDITIONAL_BRANCH)
+		*dest++ = 'C';
+	else
+		*dest++ = '.';
+
+	/* intrablock branches */
+	*dest++ = (flags & OPFLAG_INTRABLOCK_BRANCH) ? 'i' : '.';
+
+	/* branch targets */
+	*dest++ = (flags & OPFLAG_IS_BRANCH_TARGET) ? 'B' : '.';
+
+	/* exceptions */
+	if (flags & OPFLAG_WILL_CAUSE_EXCEPTION)
+		*dest++ = 'E';
+	else if (flags & OPFLAG_CAN_CAUSE_EXCEPTION)
+		*dest++ = 'e';
+	else
+		*dest++ = '.';
+
+	/* read/write */
+	if (flags & OPFLAG_READS_MEMORY)
+		*dest++ = 'R';
+	else if (flags & OPFLAG_WRITES_MEMORY)
+		*dest++ = 'W';
+	else
+		*dest++ = '.';
+
+	/* mode changes */
+	*dest++ = (flags & OPFLAG_CAN_CHANGE_MODES) ? 'M' : '.';
+
+	/* TLB validation */
+	*dest++ = (flags & OPFLAG_VALIDATE_TLB) ? 'V' : '.';
+
+	/* interpreted */
+	*dest++ = (flags & I386_OPFLAG_INTERPRET) ? 'I' : '.';
+	*dest = 0;
+	return tempbuf;
+}
+
+
+/*-------------------------------------------------
+    log_opcode_desc - log a list of descriptions
+-------------------------------------------------*/
+
+void i386_device::log_opcode_desc(drcuml_state *drcuml, const opcode_desc *desclist, int indent)
+{
+	/* open the file, creating it if necessary */
+	if (indent == 0)
+		drcuml->log_printf("\nDescriptor list @ %08X\n", desclist->pc);
+
+	/* output each descriptor */
+	for ( ; desclist != NULL; desclist = desclist->next())
+	{
+		char buffer[100];
+
+		/* disassemle the current instruction and output it to the log */
+		if (drcuml->logging() || drcuml->logging_native())
+		{
+			if (desclist->flags & OPFLAG_VIRTUAL_NOOP)
+				strcpy(buffer, "<virtual nop>");
+			else
+				i386_dasm_one(buffer, desclist->pc, desclist->opptr.b, 32);
+		}
+		else
+			strcpy(buffer, "???");
+		drcuml->log_printf("%08X [%08X] t:%08X f:%s: %-30s", desclist->pc, desclist->physpc, desclist->targetpc, log_desc_flags_to_string(desclist->flags), buffer);
+
+		/* output flag liveness */
+		drcuml->log_printf("[use:%02X mod:%02X req:%02X]\n", desclist->regin[1], desclist->regout[1], desclist->regreq[1]);
+
+		/* at the end of a sequence add a dividing line */
+		if (desclist->flags & OPFLAG_END_SEQUENCE)
+			drcuml->log_printf("-----\n");
+	}
+}
+
+
+/*-------------------------------------------------
+    log_add_disasm_comment - add a comment
+    including disassembly of an i386 instruction
+-------------------------------------------------*/
+
+void i386_device::log_add_disasm_comment(drcuml_block *block, const opcode_desc *desc)
+{
+	if (m_drcuml->logging())
+	{
+		char buffer[100];
+		i386_dasm_one(buffer, desc->pc, desc->opptr.b, 32);
+		block->append_comment("%08X: %s", desc->pc, buffer);                        // comment
+	}
+}
+
+
+/***************************************************************************
+    CODE GENERATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    generate_update_cycles - generate code to
+    subtract cycles from the icount and generate
+    an exception if out
+-------------------------------------------------*/
+
+void i386_device::generate_update_cycles(drcuml_block *block, compiler_state *compiler, uml::parameter param, int allow_exception)
+{
+	/* the instruction being compared is complete once it gets here */
+	if (compiler->compare)
+		generate_compare_end(block, compiler, param);
+
+	/* a memory access may have raised an interrupt; leave for the execution loop to take it */
+	if (compiler->checkints)
+	{
+		code_label skip = compiler->labelnum++;
+
+		compiler->checkints = FALSE;
+
+		UML_LOAD(block, I0, &m_irq_state, 0, SIZE_BYTE, SCALE_x1);                  // load    i0,[irq_state]
+		UML_LOAD(block, I1, &m_IF, 0, SIZE_BYTE, SCALE_x1);                         // load    i1,[IF]
+		UML_CMP(block, I0, 0);                                                      // cmp     i0,0
+		UML_SETc(block, COND_NE, I0);                                               // set     i0,ne
+		UML_AND(block, I0, I0, I1);                                                 // and     i0,i0,i1
+		UML_JMPc(block, COND_Z, skip);                                              // jmp     skip,z
+
+		UML_MOV(block, mem(&m_core->eip), param);                                   // mov     [eip],param
+		if (compiler->cycles > 0)
+		{
+			UML_LOAD(block, I0, &m_cycles, 0, SIZE_DWORD, SCALE_x4);                // load    i0,[cycles]
+			UML_SUB(block, I0, I0, compiler->cycles);                               // sub     i0,i0,cycles
+			UML_STORE(block, &m_cycles, 0, I0, SIZE_DWORD, SCALE_x4);               // store   [cycles],i0
+		}
+		UML_EXIT(block, EXECUTE_RETURN);                                            // exit    EXECUTE_RETURN
+
+		UML_LABEL(block, skip);                                                     // skip:
+	}
+
+	/* account for cycles */
+	if (compiler->cycles > 0)
+	{
+		UML_LOAD(block, I0, &m_cycles, 0, SIZE_DWORD, SCALE_x4);                    // load    i0,[cycles]
+		UML_SUB(block, I0, I0, compiler->cycles);                                   // sub     i0,i0,cycles
+		UML_STORE(block, &m_cycles, 0, I0, SIZE_DWORD, SCALE_x4);                   // store   [cycles],i0
+		UML_MAPVAR(block, MAPVAR_CYCLES, 0);                                        // mapvar  cycles,0
+		if (allow_exception)
+		{
+			UML_CMP(block, I0, 0);                                                  // cmp     i0,0
+			UML_EXHc(block, COND_LE, *m_out_of_cycles, param);                      // exh     out_of_cycles,param,le
+		}
+	}
+
+	/* the interpreter may have used up the timeslice on its own */
+	else if (allow_exception)
+	{
+		UML_LOAD(block, I0, &m_cycles, 0, SIZE_DWORD, SCALE_x4);                    // load    i0,[cycles]
+		UML_CMP(block, I0, 0);                                                      // cmp     i0,0
+		UML_EXHc(block, COND_LE, *m_out_of_cycles, param);                          // exh     out_of_cycles,param,le
+	}
+	compiler->cycles = 0;
+}
+
+
+/*-------------------------------------------------
+    generate_checksum_block - generate code to
+    validate a sequence of opcodes
+-------------------------------------------------*/
+
+void i386_device::generate_checksum_block(drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast)
+{
+	const opcode_desc *curdesc;
+	const opcode_desc *lastdesc;
+	bool loaded = false;
+	UINT32 sum = 0;
+
+	if (m_drcuml->logging())
+		block->append_comment("[Validation for %08X]", seqhead->pc);                // comment
+
+	/* loose verify only looks at the first instruction */
+	lastdesc = (m_drcoptions & I386DRC_STRICT_VERIFY) ? seqlast : seqhead;
+
+	/* sum up the instruction bytes as the host sees them, a dword at a time where aligned */
+	for (curdesc = seqhead; curdesc != lastdesc->next(); curdesc = curdesc->next())
+	{
+		if (curdesc->flags & OPFLAG_VIRTUAL_NOOP)
+			continue;
+
+		const UINT8 *base = (const UINT8 *)m_direct->read_ptr(curdesc->physpc);
+		if (base == NULL)
+			continue;
+
+		/* an instruction crossing a page is run by the interpreter; check the part on this page */
+		int length = MIN(curdesc->length, 0x1000 - (curdesc->physpc & 0xfff));
+		for (int offset = 0; offset < length; )
+		{
+			const UINT8 *ptr = base + offset;
+			int remaining = length - offset;
+			operand_size size;
+			UINT32 value;
+
+			if (((FPTR)ptr & 3) == 0 && remaining >= 4)
+				size = SIZE_DWORD, value = *(const UINT32 *)ptr, offset += 4;
+			else if (((FPTR)ptr & 1) == 0 && remaining >= 2)
+				size = SIZE_WORD, value = *(const UINT16 *)ptr, offset += 2;
+			else
+				size = SIZE_BYTE, value = *ptr, offset += 1;
+
+			if (!loaded)
+				UML_LOAD(block, I0, ptr, 0, size, SCALE_x1);                        // load    i0,ptr,size
+			else
+			{
+				UML_LOAD(block, I1, ptr, 0, size, SCALE_x1);                        // load    i1,ptr,size
+				UML_ADD(block, I0, I0, I1);                                         // add     i0,i0,i1
+			}
+			sum += value;
+			loaded = true;
+		}
+	}
+
+	if (loaded)
+	{
+		UML_CMP(block, I0, sum);                                                    // cmp     i0,sum
+		UML_EXHc(block, COND_NE, *m_nocode, seqhead->pc);                           // exne    nocode,seqhead->pc
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_sequence_instruction - generate code
+    for a single instruction in a sequence
+-------------------------------------------------*/
+
+void i386_device::generate_sequence_instruction(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	/* add an entry for the log */
+	if (m_drcuml->logging() && !(desc->flags & OPFLAG_VIRTUAL_NOOP))
+		log_add_disasm_comment(block, desc);
+
+	/* set the PC and cycle map variables */
+	UML_MAPVAR(block, MAPVAR_PC, desc->pc);                                         // mapvar  PC,desc->pc
+	UML_MAPVAR(block, MAPVAR_CYCLES, compiler->cycles);                             // mapvar  CYCLES,compiler->cycles
+
+	/* make sure the TLB still maps the code page the way it did when we compiled */
+	if ((desc->flags & OPFLAG_VALIDATE_TLB) && (compiler->mode & MODE_PAGING) && !(desc->flags & OPFLAG_COMPILER_PAGE_FAULT))
+	{
+		const vtlb_entry *tlbtable = vtlb_table(m_vtlb);
+		UINT32 fetchbit = (compiler->mode & MODE_USER) ? VTLB_USER_READ_ALLOWED : VTLB_READ_ALLOWED;
+		UINT32 mask = 0xfffff000 | VTLB_FLAG_VALID | fetchbit;
+		vtlb_entry tlbentry = tlbtable[desc->pc >> 12];
+
+		if ((tlbentry & (VTLB_FLAG_VALID | fetchbit)) == (VTLB_FLAG_VALID | fetchbit))
+		{
+			UML_LOAD(block, I0, (void *)&tlbtable[desc->pc >> 12], 0, SIZE_DWORD, SCALE_x4);  // load    i0,tlbentry
+			UML_AND(block, I0, I0, mask);                                           // and     i0,i0,mask
+			UML_CMP(block, I0, tlbentry & mask);                                    // cmp     i0,tlbentry & mask
+			UML_EXHc(block, COND_NE, *m_tlb_mismatch, 0);                           // exh     tlb_mismatch,0,ne
+		}
+		else
+			UML_EXH(block, *m_tlb_mismatch, 0);                                     // exh     tlb_mismatch,0
+	}
+
+	/* accumulate total cycles; a fault in this instruction counts them too */
+	compiler->cycles += desc->cycles;
+	UML_MAPVAR(block, MAPVAR_CYCLES, compiler->cycles);                             // mapvar  CYCLES,compiler->cycles
+
+	/* if the front-end couldn't fetch this instruction, let the execution loop sort it out */
+	if (desc->flags & OPFLAG_COMPILER_PAGE_FAULT)
+		UML_EXH(block, *m_tlb_mismatch, 0);                                         // exh     tlb_mismatch,0
+
+	/* system and rarely used instructions go to the interpreter */
+	else if (desc->flags & I386_OPFLAG_INTERPRET)
+		generate_interpreter_call(block, compiler, desc);
+
+	/* with -drc_compare, every native instruction is checked against the interpreter */
+	else if (m_drc_compare)
+	{
+		UML_MOV(block, mem(&m_core->eip), desc->pc);                                // mov     [eip],desc->pc
+		UML_MOV(block, mem(&m_core->flagmask), I386_FLAG_ALL & ~(desc->regout[1] & ~desc->regreq[1]));
+																					// mov     [flagmask],live flags
+		UML_CALLC(block, cfunc_compare_begin, this);                                // callc   cfunc_compare_begin
+
+		compiler->compare = TRUE;
+		if (!generate_opcode(block, compiler, desc))
+			fatalerror("I386DRC: front-end and code generator disagree about %08X\n", desc->pc);
+
+		/* anything that didn't leave through generate_update_cycles falls through to the next instruction */
+		if (compiler->compare)
+			generate_compare_end(block, compiler, desc->pc + desc->length);
+	}
+
+	/* compile the instruction */
+	else if (!generate_opcode(block, compiler, desc))
+		fatalerror("I386DRC: front-end and code generator disagree about %08X\n", desc->pc);
+
+	/* a memory access may have changed the interrupt state */
+	if (desc->flags & (OPFLAG_READS_MEMORY | OPFLAG_WRITES_MEMORY | I386_OPFLAG_INTERPRET))
+		compiler->checkints = TRUE;
+}
+
+
+/*------------------------------------------------------------------
+    generate_compare_end - check the instruction
+    being compared, given where the native code
+    goes next
+------------------------------------------------------------------*/
+
+void i386_device::generate_compare_end(drcuml_block *block, compiler_state *compiler, uml::parameter param)
+{
+	compiler->compare = FALSE;
+	UML_MOV(block, mem(&m_core->nextpc), param);                                    // mov     [nextpc],param
+	UML_CALLC(block, cfunc_compare_end, this);                                      // callc   cfunc_compare_end
+}
+
+
+/*------------------------------------------------------------------
+    generate_interpreter_call - run one
+    instruction through the interpreter
+------------------------------------------------------------------*/
+
+void i386_device::generate_interpreter_call(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	code_label skip = compiler->labelnum++;
+
+	/* the interpreter counts its own cycles, so settle ours first */
+	generate_update_cycles(block, compiler, desc->pc, FALSE);                      // <subtract cycles>
+	UML_MOV(block, mem(&m_core->eip), desc->pc);                                    // mov     [eip],desc->pc
+	UML_CALLC(block, cfunc_execute_one, this);                                      // callc   cfunc_execute_one
+
+	/* leave if the instruction may have changed modes, or jumped or faulted somewhere else */
+	if (desc->flags & OPFLAG_CAN_CHANGE_MODES)
+		UML_EXIT(block, EXECUTE_RETURN);                                            // exit    EXECUTE_RETURN
+	else
+	{
+		UML_CMP(block, mem(&m_core->eip), desc->pc + desc->length);                 // cmp     [eip],desc->pc+length
+		UML_JMPc(block, COND_E, skip);                                              // jmp     skip,e
+		UML_EXIT(block, EXECUTE_RETURN);                                            // exit    EXECUTE_RETURN
+		UML_LABEL(block, skip);                                                     // skip:
+	}
+}
+
+
+/*------------------------------------------------------------------
+    generate_branch - count off cycles and jump
+    to an immediate or computed target
+------------------------------------------------------------------*/
+
+void i386_device::generate_branch(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, uml::parameter target, int extra_cycles)
+{
+	compiler_state compiler_temp = *compiler;
+
+	/* the taken path may cost more than the fall-through */
+	compiler_temp.cycles += extra_cycles;
+	if (extra_cycles != 0)
+		UML_MAPVAR(block, MAPVAR_CYCLES, compiler_temp.cycles);                     // mapvar  CYCLES,compiler_temp.cycles
+
+	generate_update_cycles(block, &compiler_temp, target, TRUE);                    // <subtract cycles>
+
+	/* jump within the block if we can, or dispatch through the hash table */
+	if (target.is_immediate() && (desc->flags & OPFLAG_INTRABLOCK_BRANCH))
+		UML_JMP(block, desc->targetpc | 0x80000000);                                // jmp     desc->targetpc | 0x80000000
+	else
+		UML_HASHJMP(block, compiler->mode, target, *m_nocode);                      // hashjmp <mode>,target,nocode
+
+	/* update the label, and put back the cycle count of the fall-through path */
+	compiler->labelnum = compiler_temp.labelnum;
+	UML_MAPVAR(block, MAPVAR_CYCLES, compiler->cycles);                             // mapvar  CYCLES,compiler->cycles
+}
+
+
+/*------------------------------------------------------------------
+    generate_condition - compute a Jcc condition
+    pair into I0; the even condition is true
+    when I0 is non-zero
+------------------------------------------------------------------*/
+
+void i386_device::generate_condition(drcuml_block *block, int cc)
+{
+	switch (cc)
+	{
+		case 0: UML_MOV(block, I0, mem(&m_core->of));                               break;  // O
+		case 1: UML_MOV(block, I0, mem(&m_core->cf));                               break;  // B
+		case 2: UML_MOV(block, I0, mem(&m_core->zf));                               break;  // Z
+		case 3: UML_OR(block, I0, mem(&m_core->cf), mem(&m_core->zf));              break;  // BE
+		case 4: UML_MOV(block, I0, mem(&m_core->sf));                               break;  // S
+		case 5: UML_MOV(block, I0, mem(&m_core->pf));                               break;  // P
+		case 6: UML_XOR(block, I0, mem(&m_core->sf), mem(&m_core->of));             break;  // L
+		case 7: UML_XOR(block, I0, mem(&m_core->sf), mem(&m_core->of));                     // LE
+				UML_OR(block, I0, I0, mem(&m_core->zf));                            break;
+	}
+}
+
+
+/*------------------------------------------------------------------
+    generate_modrm_ea - compute the effective
+    address of a 32-bit ModRM operand into I4;
+    returns the length of the ModRM, SIB and
+    displacement
+------------------------------------------------------------------*/
+
+int i386_device::generate_modrm_ea(drcuml_block *block, const UINT8 *modrm)
+{
+	int mod = modrm[0] >> 6;
+	int rm = modrm[0] & 7;
+	int base = rm, index = 4, scale = 0;
+	bool havebase = true;
+	int length = 1;
+	UINT32 disp = 0;
+
+	/* decode the SIB byte */
+	if (rm == 4)
+	{
+		UINT8 sib = modrm[length++];
+		scale = sib >> 6;
+		index = (sib >> 3) & 7;
+		base = sib & 7;
+		if (base == 5 && mod == 0)
+			havebase = false;
+	}
+	else if (rm == 5 && mod == 0)
+		havebase = false;
+
+	/* fetch the displacement */
+	if (mod == 1)
+		disp = (INT8)modrm[length++];
+	else if (mod == 2 || !havebase)
+	{
+		disp = IMM32(&modrm[length]);
+		length += 4;
+	}
+
+	if (havebase)
+		UML_MOV(block, I4, GPR32(base));                                            // mov     i4,base
+	else
+		UML_MOV(block, I4, disp);                                                   // mov     i4,disp
+	if (index != 4)
+	{
+		if (scale == 0)
+			UML_ADD(block, I4, I4, GPR32(index));                                   // add     i4,i4,index
+		else
+		{
+			UML_SHL(block, I3, GPR32(index), scale);                                // shl     i3,index,scale
+			UML_ADD(block, I4, I4, I3);                                             // add     i4,i4,i3
+		}
+	}
+	if (havebase && disp != 0)
+		UML_ADD(block, I4, I4, disp);                                               // add     i4,i4,disp
+	return length;
+}
+
+
+/*------------------------------------------------------------------
+    generate_read_reg8/generate_write_reg8 -
+    access AL-BH within the 32-bit registers
+------------------------------------------------------------------*/
+
+void i386_device::generate_read_reg8(drcuml_block *block, uml::parameter dst, int reg)
+{
+	UML_ROLAND(block, dst, GPR32(reg & 3), (reg & 4) ? 24 : 0, 0xff);               // roland  dst,reg,shift,0xff
+}
+
+void i386_device::generate_write_reg8(drcuml_block *block, int reg, uml::parameter src)
+{
+	UML_ROLINS(block, GPR32(reg & 3), src, (reg & 4) ? 8 : 0, (reg & 4) ? 0xff00 : 0xff);
+																					// rolins  reg,src,shift,mask
+}
+
+
+/*------------------------------------------------------------------
+    generate_flags - store the flags of an ALU
+    operation of I0 and I1 with the result in I2;
+    only flags a later instruction reads are kept
+------------------------------------------------------------------*/
+
+void i386_device::generate_flags(drcuml_block *block, const opcode_desc *desc, int aluop)
+{
+	UINT32 live = desc->regout[1] & desc->regreq[1];
+	bool logical = (aluop == ALU_OR || aluop == ALU_AND || aluop == ALU_XOR || aluop == ALU_TEST);
+
+	/* grab the host flags before anything else changes them */
+	if (live & (I386_FLAG_CF | I386_FLAG_OF | I386_FLAG_ZF | I386_FLAG_SF))
+		UML_GETFLGS(block, I3, FLAG_C | FLAG_V | FLAG_Z | FLAG_S);                 // getflgs i3,CVZS
+
+	if (logical)
+	{
+		if (live & I386_FLAG_CF)
+			UML_MOV(block, mem(&m_core->cf), 0);                                    // mov     [cf],0
+		if (live & I386_FLAG_OF)
+			UML_MOV(block, mem(&m_core->of), 0);                                    // mov     [of],0
+	}
+	else
+	{
+		if (live & I386_FLAG_CF)
+			UML_ROLAND(block, mem(&m_core->cf), I3, 0, 1);                          // roland  [cf],i3,0,1
+		if (live & I386_FLAG_OF)
+			UML_ROLAND(block, mem(&m_core->of), I3, 31, 1);                         // roland  [of],i3,31,1
+	}
+	if (live & I386_FLAG_ZF)
+		UML_ROLAND(block, mem(&m_core->zf), I3, 30, 1);                             // roland  [zf],i3,30,1
+	if (live & I386_FLAG_SF)
+		UML_ROLAND(block, mem(&m_core->sf), I3, 29, 1);                             // roland  [sf],i3,29,1
+
+	if (live & I386_FLAG_PF)
+	{
+		UML_AND(block, I3, I2, 0xff);                                               // and     i3,i2,0xff
+		UML_LOAD(block, I3, i386_parity_table, I3, SIZE_DWORD, SCALE_x4);           // load    i3,parity_table,i3,dword
+		UML_MOV(block, mem(&m_core->pf), I3);                                       // mov     [pf],i3
+	}
+	if (!logical && (live & I386_FLAG_AF))
+	{
+		UML_XOR(block, I3, I0, I1);                                                 // xor     i3,i0,i1
+		UML_XOR(block, I3, I3, I2);                                                 // xor     i3,i3,i2
+		UML_ROLAND(block, mem(&m_core->af), I3, 28, 1);                             // roland  [af],i3,28,1
+	}
+}
+
+
+/*------------------------------------------------------------------
+    generate_push - push a dword; the value
+    is taken before ESP changes
+------------------------------------------------------------------*/
+
+void i386_device::generate_push(drcuml_block *block, compiler_state *compiler, uml::parameter value)
+{
+	UML_MOV(block, I1, value);                                                      // mov     i1,value
+	UML_SUB(block, I0, GPR32(ESP), 4);                                              // sub     i0,esp,4
+	UML_CALLH(block, *m_write[compiler->mode][2]);                                  // callh   write32
+	UML_SUB(block, GPR32(ESP), GPR32(ESP), 4);                                      // sub     esp,esp,4
+}
+
+
+/*------------------------------------------------------------------
+    generate_alu - generate one of the two
+    operand ALU operations
+------------------------------------------------------------------*/
+
+int i386_device::generate_alu(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, int aluop, int form, const UINT8 *modrm)
+{
+	bool memform = (form != ALU_FORM_ACC_IMM && modrm[0] < 0xc0);
+	int reg = (modrm[0] >> 3) & 7;
+	int rm = modrm[0] & 7;
+	int length = 1;
+
+	/* fetch the destination into I0 and the source into I1 */
+	if (memform)
+	{
+		length = generate_modrm_ea(block, modrm);
+		UML_MOV(block, I0, I4);                                                     // mov     i0,i4
+		UML_CALLH(block, *m_read[compiler->mode][2]);                               // callh   read32
+	}
+
+	switch (form)
+	{
+		case ALU_FORM_RM_REG:
+			if (!memform)
+				UML_MOV(block, I0, GPR32(rm));                                      // mov     i0,rm
+			UML_MOV(block, I1, GPR32(reg));                                         // mov     i1,reg
+			break;
+
+		case ALU_FORM_REG_RM:
+			UML_MOV(block, I1, memform ? I0 : GPR32(rm));                           // mov     i1,rm
+			UML_MOV(block, I0, GPR32(reg));                                         // mov     i0,reg
+			break;
+
+		case ALU_FORM_ACC_IMM:
+			UML_MOV(block, I0, GPR32(EAX));                                         // mov     i0,eax
+			UML_MOV(block, I1, IMM32(modrm));                                       // mov     i1,imm32
+			break;
+
+		case ALU_FORM_RM_IMM32:
+			if (!memform)
+				UML_MOV(block, I0, GPR32(rm));                                      // mov     i0,rm
+			UML_MOV(block, I1, IMM32(&modrm[length]));                              // mov     i1,imm32
+			break;
+
+		case ALU_FORM_RM_IMM8:
+			if (!memform)
+				UML_MOV(block, I0, GPR32(rm));                                      // mov     i0,rm
+			UML_MOV(block, I1, (UINT32)(INT8)modrm[length]);                        // mov     i1,simm8
+			break;
+
+		case ALU_FORM_RM_ONE:
+			if (!memform)
+				UML_MOV(block, I0, GPR32(rm));                                      // mov     i0,rm
+			UML_MOV(block, I1, 1);                                                  // mov     i1,1
+			break;
+	}
+
+	/* perform the operation into I2 */
+	switch (aluop)
+	{
+		case ALU_ADD:
+		case ALU_INC:
+			UML_ADD(block, I2, I0, I1);                                             // add     i2,i0,i1
+			break;
+
+		case ALU_OR:
+			UML_OR(block, I2, I0, I1);                                              // or      i2,i0,i1
+			break;
+
+		case ALU_ADC:
+			UML_CARRY(block, mem(&m_core->cf), 0);                                  // carry   [cf],0
+			UML_ADDC(block, I2, I0, I1);                                            // addc    i2,i0,i1
+			break;
+
+		case ALU_SBB:
+			UML_CARRY(block, mem(&m_core->cf), 0);                                  // carry   [cf],0
+			UML_SUBB(block, I2, I0, I1);                                            // subb    i2,i0,i1
+			break;
+
+		case ALU_AND:
+		case ALU_TEST:
+			UML_AND(block, I2, I0, I1);                                             // and     i2,i0,i1
+			break;
+
+		case ALU_SUB:
+		case ALU_CMP:
+		case ALU_DEC:
+			UML_SUB(block, I2, I0, I1);                                             // sub     i2,i0,i1
+			break;
+
+		case ALU_XOR:
+			UML_XOR(block, I2, I0, I1);                                             // xor     i2,i0,i1
+			break;
+	}
+	generate_flags(block, desc, aluop);
+
+	/* write back the result */
+	if (aluop == ALU_CMP || aluop == ALU_TEST)
+		return TRUE;
+	if (form == ALU_FORM_REG_RM)
+		UML_MOV(block, GPR32(reg), I2);                                             // mov     reg,i2
+	else if (form == ALU_FORM_ACC_IMM)
+		UML_MOV(block, GPR32(EAX), I2);                                             // mov     eax,i2
+	else if (!memform)
+		UML_MOV(block, GPR32(rm), I2);                                              // mov     rm,i2
+	else
+	{
+		UML_MOV(block, I0, I4);                                                     // mov     i0,i4
+		UML_MOV(block, I1, I2);                                                     // mov     i1,i2
+		UML_CALLH(block, *m_write[compiler->mode][2]);                              // callh   write32
+	}
+	return TRUE;
+}
+
+
+/*-------------------------------------------------
+    generate_opcode - generate code for a
+    natively handled instruction
+-------------------------------------------------*/
+
+int i386_device::generate_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	const UINT8 *op = desc->opptr.b;
+	const UINT8 *cycles = m_cycle_table_pm;
+	code_label skip;
+	UINT8 modrm;
+	int length;
+
+	/* two-byte opcodes */
+	if (op[0] == 0x0f)
+	{
+		int reg = (op[2] >> 3) & 7;
+		int rm = op[2] & 7;
+
+		switch (op[1])
+		{
+			case 0x80:  case 0x81:  case 0x82:  case 0x83:  case 0x84:  case 0x85:  case 0x86:  case 0x87:  /* Jcc rel32 */
+			case 0x88:  case 0x89:  case 0x8a:  case 0x8b:  case 0x8c:  case 0x8d:  case 0x8e:  case 0x8f:
+				skip = compiler->labelnum++;
+				generate_condition(block, (op[1] >> 1) & 7);
+				UML_CMP(block, I0, 0);                                              // cmp     i0,0
+				UML_JMPc(block, (op[1] & 1) ? COND_NE : COND_E, skip);              // jmp     skip,<not cc>
+				generate_branch(block, compiler, desc, desc->targetpc, cycles[CYCLES_JCC_FULL_DISP] - cycles[CYCLES_JCC_FULL_DISP_NOBRANCH]);
+				UML_LABEL(block, skip);                                             // skip:
+				return TRUE;
+
+			case 0xb6:  case 0xbe:  /* MOVZX/MOVSX r32,rm8 */
+				if (op[2] >= 0xc0)
+					generate_read_reg8(block, I0, rm);
+				else
+				{
+					generate_modrm_ea(block, &op[2]);
+					UML_MOV(block, I0, I4);                                         // mov     i0,i4
+					UML_CALLH(block, *m_read[compiler->mode][0]);                   // callh   read8
+				}
+				if (op[1] == 0xbe)
+					UML_SEXT(block, GPR32(reg), I0, SIZE_BYTE);                     // sext    reg,i0,byte
+				else
+					UML_MOV(block, GPR32(reg), I0);                                 // mov     reg,i0
+				return TRUE;
+
+			case 0xb7:  case 0xbf:  /* MOVZX/MOVSX r32,rm16 */
+				if (op[2] >= 0xc0)
+					UML_AND(block, I0, GPR32(rm), 0xffff);                          // and     i0,rm,0xffff
+				else
+				{
+					generate_modrm_ea(block, &op[2]);
+					UML_MOV(block, I0, I4);                                         // mov     i0,i4
+					UML_CALLH(block, *m_read[compiler->mode][1]);                   // callh   read16
+				}
+				if (op[1] == 0xbf)
+					UML_SEXT(block, GPR32(reg), I0, SIZE_WORD);                     // sext    reg,i0,word
+				else
+					UML_MOV(block, GPR32(reg), I0);                                 // mov     reg,i0
+				return TRUE;
+		}
+		return FALSE;
+	}
+
+	int reg = (op[1] >> 3) & 7;
+	int rm = op[1] & 7;
+
+	switch (op[0])
+	{
+		case 0x01:  case 0x09:  case 0x11:  case 0x19:  case 0x21:  case 0x29:  case 0x31:  case 0x39:  /* ALU rm32,r32 */
+			return generate_alu(block, compiler, desc, op[0] >> 3, ALU_FORM_RM_REG, &op[1]);
+
+		case 0x03:  case 0x0b:  case 0x13:  case 0x1b:  case 0x23:  case 0x2b:  case 0x33:  case 0x3b:  /* ALU r32,rm32 */
+			return generate_alu(block, compiler, desc, op[0] >> 3, ALU_FORM_REG_RM, &op[1]);
+
+		case 0x05:  case 0x0d:  case 0x15:  case 0x1d:  case 0x25:  case 0x2d:  case 0x35:  case 0x3d:  /* ALU eax,imm32 */
+			return generate_alu(block, compiler, desc, op[0] >> 3, ALU_FORM_ACC_IMM, &op[1]);
+
+		case 0x81:  /* ALU rm32,imm32 */
+			return generate_alu(block, compiler, desc, reg, ALU_FORM_RM_IMM32, &op[1]);
+
+		case 0x83:  /* ALU rm32,simm8 */
+			return generate_alu(block, compiler, desc, reg, ALU_FORM_RM_IMM8, &op[1]);
+
+		case 0x85:  /* TEST rm32,r32 */
+			return generate_alu(block, compiler, desc, ALU_TEST, ALU_FORM_RM_REG, &op[1]);
+
+		case 0xa9:  /* TEST eax,imm32 */
+			return generate_alu(block, compiler, desc, ALU_TEST, ALU_FORM_ACC_IMM, &op[1]);
+
+		case 0x40:  case 0x41:  case 0x42:  case 0x43:  case 0x44:  case 0x45:  case 0x46:  case 0x47:  /* INC r32 */
+		case 0x48:  case 0x49:  case 0x4a:  case 0x4b:  case 0x4c:  case 0x4d:  case 0x4e:  case 0x4f:  /* DEC r32 */
+			modrm = 0xc0 | (op[0] & 7);
+			return generate_alu(block, compiler, desc, (op[0] & 8) ? ALU_DEC : ALU_INC, ALU_FORM_RM_ONE, &modrm);
+
+		case 0x50:  case 0x51:  case 0x52:  case 0x53:  case 0x54:  case 0x55:  case 0x56:  case 0x57:  /* PUSH r32 */
+			generate_push(block, compiler, GPR32(op[0] & 7));
+			return TRUE;
+
+		case 0x58:  case 0x59:  case 0x5a:  case 0x5b:  case 0x5c:  case 0x5d:  case 0x5e:  case 0x5f:  /* POP r32 */
+			UML_MOV(block, I0, GPR32(ESP));                                         // mov     i0,esp
+			UML_CALLH(block, *m_read[compiler->mode][2]);                           // callh   read32
+			UML_ADD(block, GPR32(ESP), GPR32(ESP), 4);                              // add     esp,esp,4
+			UML_MOV(block, GPR32(op[0] & 7), I0);                                   // mov     reg,i0
+			return TRUE;
+
+		case 0x68:  /* PUSH imm32 */
+			generate_push(block, compiler, IMM32(&op[1]));
+			return TRUE;
+
+		case 0x6a:  /* PUSH simm8 */
+			generate_push(block, compiler, (UINT32)(INT8)op[1]);
+			return TRUE;
+
+		case 0x70:  case 0x71:  case 0x72:  case 0x73:  case 0x74:  case 0x75:  case 0x76:  case 0x77:  /* Jcc rel8 */
+		case 0x78:  case 0x79:  case 0x7a:  case 0x7b:  case 0x7c:  case 0x7d:  case 0x7e:  case 0x7f:
+			skip = compiler->labelnum++;
+			generate_condition(block, (op[0] >> 1) & 7);
+			UML_CMP(block, I0, 0);                                                  // cmp     i0,0
+			UML_JMPc(block, (op[0] & 1) ? COND_NE : COND_E, skip);                  // jmp     skip,<not cc>
+			generate_branch(block, compiler, desc, desc->targetpc, cycles[CYCLES_JCC_DISP8] - cycles[CYCLES_JCC_DISP8_NOBRANCH]);
+			UML_LABEL(block, skip);                                                 // skip:
+			return TRUE;
+
+		case 0x88:  /* MOV rm8,r8 */
+			generate_read_reg8(block, I1, reg);
+			if (op[1] >= 0xc0)
+				generate_write_reg8(block, rm, I1);
+			else
+			{
+				generate_modrm_ea(block, &op[1]);
+				UML_MOV(block, I0, I4);                                             // mov     i0,i4
+				UML_CALLH(block, *m_write[compiler->mode][0]);                      // callh   write8
+			}
+			return TRUE;
+
+		case 0x89:  /* MOV rm32,r32 */
+			if (op[1] >= 0xc0)
+				UML_MOV(block, GPR32(rm), GPR32(reg));                              // mov     rm,reg
+			else
+			{
+				generate_modrm_ea(block, &op[1]);
+				UML_MOV(block, I0, I4);                                             // mov     i0,i4
+				UML_MOV(block, I1, GPR32(reg));                                     // mov     i1,reg
+				UML_CALLH(block, *m_write[compiler->mode][2]);                      // callh   write32
+			}
+			return TRUE;
+
+		case 0x8a:  /* MOV r8,rm8 */
+			if (op[1] >= 0xc0)
+				generate_read_reg8(block, I0, rm);
+			else
+			{
+				generate_modrm_ea(block, &op[1]);
+				UML_MOV(block, I0, I4);                                             // mov     i0,i4
+				UML_CALLH(block, *m_read[compiler->mode][0]);                       // callh   read8
+			}
+			generate_write_reg8(block, reg, I0);
+			return TRUE;
+
+		case 0x8b:  /* MOV r32,rm32 */
+			if (op[1] >= 0xc0)
+				UML_MOV(block, GPR32(reg), GPR32(rm));                              // mov     reg,rm
+			else
+			{
+				generate_modrm_ea(block, &op[1]);
+				UML_MOV(block, I0, I4);                                             // mov     i0,i4
+				UML_CALLH(block, *m_read[compiler->mode][2]);                       // callh   read32
+				UML_MOV(block, GPR32(reg), I0);                                     // mov     reg,i0
+			}
+			return TRUE;
+
+		case 0x8d:  /* LEA r32,m */
+			generate_modrm_ea(block, &op[1]);
+			UML_MOV(block, GPR32(reg), I4);                                         // mov     reg,i4
+			return TRUE;
+
+		case 0x90:  /* NOP */
+			return TRUE;
+
+		case 0xa0:  /* MOV al,moffs */
+			UML_MOV(block, I0, IMM32(&op[1]));                                      // mov     i0,moffs
+			UML_CALLH(block, *m_read[compiler->mode][0]);                           // callh   read8
+			generate_write_reg8(block, 0, I0);
+			return TRUE;
+
+		case 0xa1:  /* MOV eax,moffs */
+			UML_MOV(block, I0, IMM32(&op[1]));                                      // mov     i0,moffs
+			UML_CALLH(block, *m_read[compiler->mode][2]);                           // callh   read32
+			UML_MOV(block, GPR32(EAX), I0);                                         // mov     eax,i0
+			return TRUE;
+
+		case 0xa2:  /* MOV moffs,al */
+			generate_read_reg8(block, I1, 0);
+			UML_MOV(block, I0, IMM32(&op[1]));                                      // mov     i0,moffs
+			UML_CALLH(block, *m_write[compiler->mode][0]);                          // callh   write8
+			return TRUE;
+
+		case 0xa3:  /* MOV moffs,eax */
+			UML_MOV(block, I1, GPR32(EAX));                                         // mov     i1,eax
+			UML_MOV(block, I0, IMM32(&op[1]));                                      // mov     i0,moffs
+			UML_CALLH(block, *m_write[compiler->mode][2]);                          // callh   write32
+			return TRUE;
+
+		case 0xb0:  case 0xb1:  case 0xb2:  case 0xb3:  case 0xb4:  case 0xb5:  case 0xb6:  case 0xb7:  /* MOV r8,imm8 */
+			generate_write_reg8(block, op[0] & 7, op[1]);
+			return TRUE;
+
+		case 0xb8:  case 0xb9:  case 0xba:  case 0xbb:  case 0xbc:  case 0xbd:  case 0xbe:  case 0xbf:  /* MOV r32,imm32 */
+			UML_MOV(block, GPR32(op[0] & 7), IMM32(&op[1]));                        // mov     reg,imm32
+			return TRUE;
+
+		case 0xc2:  /* RET imm16 */
+		case 0xc3:  /* RET */
+			UML_MOV(block, I0, GPR32(ESP));                                         // mov     i0,esp
+			UML_CALLH(block, *m_read[compiler->mode][2]);                           // callh   read32
+			UML_ADD(block, GPR32(ESP), GPR32(ESP), (UINT32)(4 + ((op[0] == 0xc2) ? (INT16)IMM16(&op[1]) : 0)));
+																					// add     esp,esp,4+imm16
+			UML_MOV(block, mem(&m_core->eip), I0);                                  // mov     [eip],i0
+			generate_branch(block, compiler, desc, mem(&m_core->eip), 0);
+			return TRUE;
+
+		case 0xc6:  /* MOV rm8,imm8 */
+			if (op[1] >= 0xc0)
+				generate_write_reg8(block, rm, op[2]);
+			else
+			{
+				length = generate_modrm_ea(block, &op[1]);
+				UML_MOV(block, I0, I4);                                             // mov     i0,i4
+				UML_MOV(block, I1, op[1 + length]);                                 // mov     i1,imm8
+				UML_CALLH(block, *m_write[compiler->mode][0]);                      // callh   write8
+			}
+			return TRUE;
+
+		case 0xc7:  /* MOV rm32,imm32 */
+			if (op[1] >= 0xc0)
+				UML_MOV(block, GPR32(rm), IMM32(&op[2]));                           // mov     rm,imm32
+			else
+			{
+				length = generate_modrm_ea(block, &op[1]);
+				UML_MOV(block, I0, I4);                                             // mov     i0,i4
+				UML_MOV(block, I1, IMM32(&op[1 + length]));                         // mov     i1,imm32
+				UML_CALLH(block, *m_write[compiler->mode][2]);                      // callh   write32
+			}
+			return TRUE;
+
+		case 0xe8:  /* CALL rel32 */
+			generate_push(block, compiler, desc->pc + desc->length);
+			generate_branch(block, compiler, desc, desc->targetpc, 0);
+			return TRUE;
+
+		case 0xe9:  /* JMP rel32 */
+		case 0xeb:  /* JMP rel8 */
+			generate_branch(block, compiler, desc, desc->targetpc, 0);
+			return TRUE;
+
+		case 0xff:
+			switch (reg)
+			{
+				case 0:     /* INC rm32 */
+					return generate_alu(block, compiler, desc, ALU_INC, ALU_FORM_RM_ONE, &op[1]);
+
+				case 1:     /* DEC rm32 */
+					return generate_alu(block, compiler, desc, ALU_DEC, ALU_FORM_RM_ONE, &op[1]);
+
+				case 2:     /* CALL rm32 */
+				case 4:     /* JMP rm32 */
+					/* the target is read before anything is pushed */
+					if (op[1] >= 0xc0)
+						UML_MOV(block, mem(&m_core->eip), GPR32(rm));               // mov     [eip],rm
+					else
+					{
+						generate_modrm_ea(block, &op[1]);
+						UML_MOV(block, I0, I4);                                     // mov     i0,i4
+						UML_CALLH(block, *m_read[compiler->mode][2]);               // callh   read32
+						UML_MOV(block, mem(&m_core->eip), I0);                      // mov     [eip],i0
+					}
+					if (reg == 2)
+						generate_push(block, compiler, desc->pc + desc->length);
+					generate_branch(block, compiler, desc, mem(&m_core->eip), 0);
+					return TRUE;
+
+				case 6:     /* PUSH rm32 */
+					if (op[1] >= 0xc0)
+						generate_push(block, compiler, GPR32(rm));
+					else
+					{
+						generate_modrm_ea(block, &op[1]);
+						UML_MOV(block, I0, I4);                                     // mov     i0,i4
+						UML_CALLH(block, *m_read[compiler->mode][2]);               // callh   read32
+						generate_push(block, compiler, I0);
+					}
+					return TRUE;
+			}
+			return FALSE;
+	}
+	return FALSE;
+}
+
+
+/***************************************************************************
+    CORE CALLBACKS
+***************************************************************************/
+
+/*-------------------------------------------------
+    i386drc_set_options - configure DRC options
+-------------------------------------------------*/
+
+void i386_device::i386drc_set_options(UINT32 options)
+{
+	if (!m_isdrc)
+		return;
+	m_drcoptions = options;
+}
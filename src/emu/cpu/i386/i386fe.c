@@ -0,0 +1,651 @@
+// license:BSD-3-Clause
+// copyright-holders:Ville Linde, Barry Rodewald, Carl, Philip Bennett
+/***************************************************************************
+
+    i386fe.c
+
+    Front end for the i386 recompiler
+
+    Only the instructions that the code generator handles natively get a
+    precise description; everything else is marked to be run through the
+    interpreter, and the instructions that can change segments, the
+    privilege level, paging or the interrupt flag also end the sequence
+    so that the execution loop can look at the new state.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "i386.h"
+#include "cycles.h"
+#include "cpu/drcfe.h"
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* opcode properties */
+#define OP_MODRM        0x01        /* followed by a ModRM byte */
+#define OP_IMM8         0x02        /* 8-bit immediate */
+#define OP_IMM16        0x04        /* 16-bit immediate */
+#define OP_IMMZ         0x08        /* 16 or 32-bit immediate, by operand size */
+#define OP_MOFFS        0x10        /* 16 or 32-bit offset, by address size */
+#define OP_GROUP3       0x20        /* immediate only with a TEST reg field */
+#define OP_PREFIX       0x40        /* instruction prefix */
+#define OP_SYSTEM       0x80        /* interpreted, and ends the sequence */
+
+#define M   OP_MODRM
+#define B   OP_IMM8
+#define W   OP_IMM16
+#define Z   OP_IMMZ
+#define O   OP_MOFFS
+#define G   OP_GROUP3
+#define P   OP_PREFIX
+#define S   OP_SYSTEM
+
+static const UINT8 one_byte_props[256] =
+{
+	/*        0     1     2     3     4     5     6     7     8     9     a     b     c     d     e     f */
+	/* 0 */   M,    M,    M,    M,    B,    Z,    0,    S,    M,    M,    M,    M,    B,    Z,    0,    0,
+	/* 1 */   M,    M,    M,    M,    B,    Z,    0,    S,    M,    M,    M,    M,    B,    Z,    0,    S,
+	/* 2 */   M,    M,    M,    M,    B,    Z,    P,    0,    M,    M,    M,    M,    B,    Z,    P,    0,
+	/* 3 */   M,    M,    M,    M,    B,    Z,    P,    0,    M,    M,    M,    M,    B,    Z,    P,    0,
+	/* 4 */   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+	/* 5 */   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+	/* 6 */   0,    0,    M,    M,    P,    P,    P,    P,    Z,    M|Z,  B,    M|B,  S,    S,    S,    S,
+	/* 7 */   B,    B,    B,    B,    B,    B,    B,    B,    B,    B,    B,    B,    B,    B,    B,    B,
+	/* 8 */   M|B,  M|Z,  M|B,  M|B,  M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M|S,  M,
+	/* 9 */   0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    W|Z|S,0,    0,    S,    0,    0,
+	/* a */   O,    O,    O,    O,    0,    0,    0,    0,    B,    Z,    0,    0,    0,    0,    0,    0,
+	/* b */   B,    B,    B,    B,    B,    B,    B,    B,    Z,    Z,    Z,    Z,    Z,    Z,    Z,    Z,
+	/* c */   M|B,  M|B,  W,    0,    M|S,  M|S,  M|B,  M|Z,  W|B,  0,    W|S,  S,    S,    B|S,  S,    S,
+	/* d */   M,    M,    M,    M,    B,    B,    0,    0,    M,    M,    M,    M,    M,    M,    M,    M,
+	/* e */   B,    B,    B,    B,    B|S,  B|S,  B|S,  B|S,  Z,    Z,    W|Z|S,B,    S,    S,    S,    S,
+	/* f */   P,    S,    P,    P,    S,    0,    M|G|B,M|G|Z,0,    0,    S,    S,    0,    0,    M,    M
+};
+
+static const UINT8 two_byte_props[256] =
+{
+	/*        0     1     2     3     4     5     6     7     8     9     a     b     c     d     e     f */
+	/* 0 */   M|S,  M|S,  M,    M,    S,    S,    S,    S,    S,    S,    S,    S,    S,    S,    S,    S,
+	/* 1 */   M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,
+	/* 2 */   M|S,  M|S,  M|S,  M|S,  M|S,  S,    M|S,  S,    M,    M,    M,    M,    M,    M,    M,    M,
+	/* 3 */   S,    0,    S,    0,    S,    S,    S,    S,    S,    S,    S,    S,    S,    S,    S,    S,
+	/* 4 */   M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,
+	/* 5 */   M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,
+	/* 6 */   M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,
+	/* 7 */   M|B,  M|B,  M|B,  M|B,  M,    M,    M,    0,    M,    M,    M,    M,    M,    M,    M,    M,
+	/* 8 */   Z,    Z,    Z,    Z,    Z,    Z,    Z,    Z,    Z,    Z,    Z,    Z,    Z,    Z,    Z,    Z,
+	/* 9 */   M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,
+	/* a */   0,    0,    0,    M,    M|B,  M,    S,    S,    0,    0,    S,    M,    M|B,  M,    M,    M,
+	/* b */   M,    M,    M|S,  M,    M|S,  M|S,  M,    M,    M,    M,    M|B,  M,    M,    M,    M,    M,
+	/* c */   M,    M,    M|B,  M,    M|B,  M|B,  M|B,  M,    0,    0,    0,    0,    0,    0,    0,    0,
+	/* d */   M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,
+	/* e */   M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,
+	/* f */   M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M,    M
+};
+
+#undef M
+#undef B
+#undef W
+#undef Z
+#undef O
+#undef G
+#undef P
+#undef S
+
+/* flags read by each Jcc condition pair */
+static const UINT32 condition_flags[8] =
+{
+	I386_FLAG_OF,                                   /* O/NO */
+	I386_FLAG_CF,                                   /* B/AE */
+	I386_FLAG_ZF,                                   /* Z/NZ */
+	I386_FLAG_CF | I386_FLAG_ZF,                    /* BE/A */
+	I386_FLAG_SF,                                   /* S/NS */
+	I386_FLAG_PF,                                   /* P/NP */
+	I386_FLAG_SF | I386_FLAG_OF,                    /* L/GE */
+	I386_FLAG_SF | I386_FLAG_OF | I386_FLAG_ZF      /* LE/G */
+};
+
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    modrm_length - return the length of a ModRM
+    byte along with its SIB and displacement
+-------------------------------------------------*/
+
+static inline int modrm_length(const UINT8 *modrm, bool addr16)
+{
+	int mod = modrm[0] >> 6;
+	int rm = modrm[0] & 7;
+
+	if (mod == 3)
+		return 1;
+	if (addr16)
+		return (mod == 1) ? 2 : (mod == 2 || (mod == 0 && rm == 6)) ? 3 : 1;
+
+	int length = 1;
+	if (rm == 4)
+	{
+		length++;
+		if (mod == 0 && (modrm[1] & 7) == 5)
+			return length + 4;
+	}
+	if (mod == 1)
+		return length + 1;
+	if (mod == 2 || (mod == 0 && rm == 5))
+		return length + 4;
+	return length;
+}
+
+
+/*-------------------------------------------------
+    describe_memory - note a memory access; with
+    paging on any access can fault, and the fault
+    needs exact flags to be taken
+-------------------------------------------------*/
+
+static inline void describe_memory(opcode_desc &desc, UINT32 flags, bool paging)
+{
+	desc.flags |= flags;
+	if (paging)
+	{
+		desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION;
+		desc.regin[1] |= I386_FLAG_ALL;
+	}
+}
+
+
+/*-------------------------------------------------
+    describe_alu_flags - note the flags used and
+    set by an ALU operation
+-------------------------------------------------*/
+
+static inline void describe_alu_flags(opcode_desc &desc, int aluop)
+{
+	switch (aluop)
+	{
+		case 2:     /* ADC */
+		case 3:     /* SBB */
+			desc.regin[1] |= I386_FLAG_CF;
+			desc.regout[1] |= I386_FLAG_ALL;
+			break;
+
+		case 1:     /* OR */
+		case 4:     /* AND */
+		case 6:     /* XOR */
+			desc.regout[1] |= I386_FLAG_ALL & ~I386_FLAG_AF;
+			break;
+
+		default:    /* ADD, SUB, CMP */
+			desc.regout[1] |= I386_FLAG_ALL;
+			break;
+	}
+}
+
+
+/***************************************************************************
+    INSTRUCTION PARSERS
+***************************************************************************/
+
+i386_frontend::i386_frontend(i386_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence)
+	: drc_frontend(*device, window_start, window_end, max_sequence)
+	, m_i386(device)
+{
+}
+
+
+/*-------------------------------------------------
+    describe - build a description of a single
+    instruction
+-------------------------------------------------*/
+
+bool i386_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
+{
+	bool paging = (m_i386->m_cr[0] & 0x80000000) != 0;
+	bool addr16 = false, opsize16 = false, prefixed = false, system = false;
+	int available, length = 0;
+
+	/* fetch the instruction bytes; if the first page isn't mapped, let the interpreter fault */
+	available = fetch_bytes(desc);
+	if (available == 0)
+	{
+		desc.flags |= OPFLAG_COMPILER_PAGE_FAULT | OPFLAG_VIRTUAL_NOOP | OPFLAG_END_SEQUENCE;
+		return true;
+	}
+	const UINT8 *op = desc.opptr.b;
+
+	/* skip over prefixes */
+	while (length < 14 && (one_byte_props[op[length]] & OP_PREFIX))
+	{
+		switch (op[length])
+		{
+			case 0x66:  opsize16 = true;    break;
+			case 0x67:  addr16 = true;      break;
+			case 0xf0:  system = true;      break;
+		}
+		prefixed = true;
+		length++;
+	}
+
+	/* piles of prefixes are left for the interpreter to sort out */
+	if (length > 10)
+	{
+		desc.length = length + 1;
+		describe_interpreted(desc, OPFLAG_END_SEQUENCE | OPFLAG_CAN_CHANGE_MODES);
+		return true;
+	}
+
+	/* look up the opcode */
+	UINT8 opcode = op[length++];
+	UINT8 props;
+	bool twobyte = (opcode == 0x0f);
+	if (!twobyte)
+		props = one_byte_props[opcode];
+	else
+	{
+		opcode = op[length++];
+		props = two_byte_props[opcode];
+
+		/* the three-byte maps are never recompiled */
+		if (opcode == 0x38 || opcode == 0x3a)
+		{
+			props = OP_MODRM | OP_SYSTEM | ((opcode == 0x3a) ? OP_IMM8 : 0);
+			length++;
+		}
+	}
+	if (props & OP_SYSTEM)
+		system = true;
+
+	/* add the ModRM and immediates */
+	if (props & OP_MODRM)
+	{
+		int reg = (op[length] >> 3) & 7;
+		if ((props & OP_GROUP3) && reg >= 2)
+			props &= ~(OP_IMM8 | OP_IMMZ);
+		if (!twobyte && opcode == 0xff && (reg == 3 || reg == 5))
+			system = true;
+		length += modrm_length(&op[length], addr16);
+	}
+	if (props & OP_IMM8)
+		length += 1;
+	if (props & OP_IMM16)
+		length += 2;
+	if (props & OP_IMMZ)
+		length += opsize16 ? 2 : 4;
+	if (props & OP_MOFFS)
+		length += addr16 ? 2 : 4;
+	desc.length = length;
+
+	/* an instruction running into a page we couldn't fetch is left for the interpreter to fault on */
+	if (length > available)
+		system = true;
+
+	if (system)
+	{
+		describe_interpreted(desc, OPFLAG_END_SEQUENCE | OPFLAG_CAN_CHANGE_MODES);
+		return true;
+	}
+
+	/* only unprefixed instructions that stay within one page are recompiled */
+	if (!prefixed && ((desc.pc ^ (desc.pc + length - 1)) & ~0xfff) == 0)
+	{
+		if (twobyte ? describe_two_byte(desc, &op[1], paging) : describe_one_byte(desc, op, paging))
+			return true;
+	}
+
+	describe_interpreted(desc, 0);
+	return true;
+}
+
+
+/*-------------------------------------------------
+    translate_fetch - translate a code address the
+    way the interpreter would see it, without
+    touching the page tables or the TLB
+-------------------------------------------------*/
+
+bool i386_frontend::translate_fetch(offs_t &address)
+{
+	if (!(m_i386->m_cr[0] & 0x80000000))
+		return true;
+
+	/* a live TLB entry wins over the page tables, as it does on the real chip */
+	vtlb_entry entry = vtlb_table(m_i386->m_vtlb)[address >> 12];
+	if (entry & VTLB_FLAG_VALID)
+	{
+		address = (entry & 0xfffff000) | (address & 0xfff);
+		return true;
+	}
+	return m_i386->i386_translate_address(TRANSLATE_FETCH_DEBUG, &address, NULL);
+}
+
+
+/*-------------------------------------------------
+    fetch_bytes - copy up to 15 bytes of an
+    instruction, translating each page as it is
+    entered; returns how many bytes were fetched
+-------------------------------------------------*/
+
+int i386_frontend::fetch_bytes(opcode_desc &desc)
+{
+	offs_t physpc = desc.pc;
+	int count;
+
+	if (!translate_fetch(physpc))
+		return 0;
+	desc.physpc = physpc;
+
+	for (count = 0; count < 15; count++)
+	{
+		offs_t pc = desc.pc + count;
+		if (count != 0 && (pc & 0xfff) == 0)
+		{
+			physpc = pc;
+			if (!translate_fetch(physpc))
+				break;
+		}
+		desc.opptr.b[count] = m_i386->m_direct->read_byte(physpc & m_i386->m_a20_mask);
+		physpc++;
+	}
+	return count;
+}
+
+
+/*-------------------------------------------------
+    describe_interpreted - describe an instruction
+    that is run through the interpreter
+-------------------------------------------------*/
+
+void i386_frontend::describe_interpreted(opcode_desc &desc, UINT32 flags)
+{
+	/* the interpreter counts its own cycles, and sees and may set every flag */
+	desc.flags |= I386_OPFLAG_INTERPRET | OPFLAG_CAN_CAUSE_EXCEPTION | flags;
+	desc.cycles = 0;
+	desc.regin[1] |= I386_FLAG_ALL;
+	desc.regout[1] |= I386_FLAG_ALL;
+}
+
+
+/*-------------------------------------------------
+    describe_one_byte - describe an instruction
+    from the one-byte map that the recompiler
+    generates natively
+-------------------------------------------------*/
+
+bool i386_frontend::describe_one_byte(opcode_desc &desc, const UINT8 *op, bool paging)
+{
+	const UINT8 *cycles = m_i386->m_cycle_table_pm;
+	UINT8 opcode = op[0];
+	bool regform = (op[1] >= 0xc0);
+	int reg = (op[1] >> 3) & 7;
+
+	switch (opcode)
+	{
+		case 0x01:  case 0x09:  case 0x11:  case 0x19:  case 0x21:  case 0x29:  case 0x31:  case 0x39:  /* ALU rm32,r32 */
+		{
+			int aluop = opcode >> 3;
+			if (regform)
+				desc.cycles = cycles[(aluop == 7) ? CYCLES_CMP_REG_REG : CYCLES_ALU_REG_REG];
+			else
+			{
+				desc.cycles = cycles[(aluop == 7) ? CYCLES_CMP_REG_MEM : CYCLES_ALU_REG_MEM];
+				describe_memory(desc, OPFLAG_READS_MEMORY | ((aluop == 7) ? 0 : OPFLAG_WRITES_MEMORY), paging);
+			}
+			describe_alu_flags(desc, aluop);
+			return true;
+		}
+
+		case 0x03:  case 0x0b:  case 0x13:  case 0x1b:  case 0x23:  case 0x2b:  case 0x33:  case 0x3b:  /* ALU r32,rm32 */
+		{
+			int aluop = opcode >> 3;
+			if (regform)
+				desc.cycles = cycles[(aluop == 7) ? CYCLES_CMP_REG_REG : CYCLES_ALU_REG_REG];
+			else
+			{
+				desc.cycles = cycles[(aluop == 7) ? CYCLES_CMP_MEM_REG : CYCLES_ALU_MEM_REG];
+				describe_memory(desc, OPFLAG_READS_MEMORY, paging);
+			}
+			describe_alu_flags(desc, aluop);
+			return true;
+		}
+
+		case 0x05:  case 0x0d:  case 0x15:  case 0x1d:  case 0x25:  case 0x2d:  case 0x35:  case 0x3d:  /* ALU eax,imm32 */
+		{
+			int aluop = opcode >> 3;
+			desc.cycles = cycles[(aluop == 7) ? CYCLES_CMP_IMM_ACC : CYCLES_ALU_IMM_ACC];
+			describe_alu_flags(desc, aluop);
+			return true;
+		}
+
+		case 0x81:  case 0x83:  /* ALU rm32,imm */
+			if (regform)
+				desc.cycles = cycles[(reg == 7) ? CYCLES_CMP_REG_REG : CYCLES_ALU_REG_REG];
+			else
+			{
+				desc.cycles = cycles[(reg == 7) ? CYCLES_CMP_REG_MEM : CYCLES_ALU_REG_MEM];
+				describe_memory(desc, OPFLAG_READS_MEMORY | ((reg == 7) ? 0 : OPFLAG_WRITES_MEMORY), paging);
+			}
+			describe_alu_flags(desc, reg);
+			return true;
+
+		case 0x85:  /* TEST rm32,r32 */
+			if (regform)
+				desc.cycles = cycles[CYCLES_TEST_REG_REG];
+			else
+			{
+				desc.cycles = cycles[CYCLES_TEST_REG_MEM];
+				describe_memory(desc, OPFLAG_READS_MEMORY, paging);
+			}
+			describe_alu_flags(desc, 4);
+			return true;
+
+		case 0xa9:  /* TEST eax,imm32 */
+			desc.cycles = cycles[CYCLES_TEST_IMM_ACC];
+			describe_alu_flags(desc, 4);
+			return true;
+
+		case 0x40:  case 0x41:  case 0x42:  case 0x43:  case 0x44:  case 0x45:  case 0x46:  case 0x47:  /* INC r32 */
+			desc.cycles = cycles[CYCLES_INC_REG];
+			desc.regout[1] |= I386_FLAG_ALL & ~I386_FLAG_CF;
+			return true;
+
+		case 0x48:  case 0x49:  case 0x4a:  case 0x4b:  case 0x4c:  case 0x4d:  case 0x4e:  case 0x4f:  /* DEC r32 */
+			desc.cycles = cycles[CYCLES_DEC_REG];
+			desc.regout[1] |= I386_FLAG_ALL & ~I386_FLAG_CF;
+			return true;
+
+		case 0x50:  case 0x51:  case 0x52:  case 0x53:  case 0x54:  case 0x55:  case 0x56:  case 0x57:  /* PUSH r32 */
+			desc.cycles = cycles[CYCLES_PUSH_REG_SHORT];
+			describe_memory(desc, OPFLAG_WRITES_MEMORY, paging);
+			return true;
+
+		case 0x58:  case 0x59:  case 0x5a:  case 0x5b:  case 0x5c:  case 0x5d:  case 0x5e:  case 0x5f:  /* POP r32 */
+			desc.cycles = cycles[CYCLES_POP_REG_SHORT];
+			describe_memory(desc, OPFLAG_READS_MEMORY, paging);
+			return true;
+
+		case 0x68:  case 0x6a:  /* PUSH imm */
+			desc.cycles = cycles[CYCLES_PUSH_IMM];
+			describe_memory(desc, OPFLAG_WRITES_MEMORY, paging);
+			return true;
+
+		case 0x70:  case 0x71:  case 0x72:  case 0x73:  case 0x74:  case 0x75:  case 0x76:  case 0x77:  /* Jcc rel8 */
+		case 0x78:  case 0x79:  case 0x7a:  case 0x7b:  case 0x7c:  case 0x7d:  case 0x7e:  case 0x7f:
+			desc.cycles = cycles[CYCLES_JCC_DISP8_NOBRANCH];
+			desc.regin[1] |= condition_flags[(opcode >> 1) & 7];
+			desc.targetpc = desc.pc + 2 + (INT8)op[1];
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+			return true;
+
+		case 0x88:  case 0x89:  /* MOV rm,r */
+			if (regform)
+				desc.cycles = cycles[CYCLES_MOV_REG_REG];
+			else
+			{
+				desc.cycles = cycles[CYCLES_MOV_REG_MEM];
+				describe_memory(desc, OPFLAG_WRITES_MEMORY, paging);
+			}
+			return true;
+
+		case 0x8a:  case 0x8b:  /* MOV r,rm */
+			if (regform)
+				desc.cycles = cycles[CYCLES_MOV_REG_REG];
+			else
+			{
+				desc.cycles = cycles[CYCLES_MOV_MEM_REG];
+				describe_memory(desc, OPFLAG_READS_MEMORY, paging);
+			}
+			return true;
+
+		case 0x8d:  /* LEA r32,m */
+			if (regform)
+				return false;
+			desc.cycles = cycles[CYCLES_LEA];
+			return true;
+
+		case 0x90:  /* NOP */
+			desc.cycles = cycles[CYCLES_NOP];
+			return true;
+
+		case 0xa0:  /* MOV al,moffs */
+			desc.cycles = cycles[CYCLES_MOV_IMM_MEM];
+			describe_memory(desc, OPFLAG_READS_MEMORY, paging);
+			return true;
+
+		case 0xa1:  /* MOV eax,moffs */
+			desc.cycles = cycles[CYCLES_MOV_MEM_ACC];
+			describe_memory(desc, OPFLAG_READS_MEMORY, paging);
+			return true;
+
+		case 0xa2:  /* MOV moffs,al */
+			desc.cycles = cycles[CYCLES_MOV_MEM_ACC];
+			describe_memory(desc, OPFLAG_WRITES_MEMORY, paging);
+			return true;
+
+		case 0xa3:  /* MOV moffs,eax */
+			desc.cycles = cycles[CYCLES_MOV_ACC_MEM];
+			describe_memory(desc, OPFLAG_WRITES_MEMORY, paging);
+			return true;
+
+		case 0xb0:  case 0xb1:  case 0xb2:  case 0xb3:  case 0xb4:  case 0xb5:  case 0xb6:  case 0xb7:  /* MOV r8,imm8 */
+		case 0xb8:  case 0xb9:  case 0xba:  case 0xbb:  case 0xbc:  case 0xbd:  case 0xbe:  case 0xbf:  /* MOV r32,imm32 */
+			desc.cycles = cycles[CYCLES_MOV_IMM_REG];
+			return true;
+
+		case 0xc2:  /* RET imm16 */
+		case 0xc3:  /* RET */
+			desc.cycles = cycles[(opcode == 0xc2) ? CYCLES_RET_IMM : CYCLES_RET];
+			describe_memory(desc, OPFLAG_READS_MEMORY, paging);
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			return true;
+
+		case 0xc6:  case 0xc7:  /* MOV rm,imm */
+			if (reg != 0)
+				return false;
+			if (regform)
+				desc.cycles = cycles[CYCLES_MOV_IMM_REG];
+			else
+			{
+				desc.cycles = cycles[CYCLES_MOV_IMM_MEM];
+				describe_memory(desc, OPFLAG_WRITES_MEMORY, paging);
+			}
+			return true;
+
+		case 0xe8:  /* CALL rel32 */
+			desc.cycles = cycles[CYCLES_CALL];
+			describe_memory(desc, OPFLAG_WRITES_MEMORY, paging);
+			desc.targetpc = desc.pc + 5 + (op[1] | (op[2] << 8) | (op[3] << 16) | ((UINT32)op[4] << 24));
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			return true;
+
+		case 0xe9:  /* JMP rel32 */
+			desc.cycles = cycles[CYCLES_JMP];
+			desc.targetpc = desc.pc + 5 + (op[1] | (op[2] << 8) | (op[3] << 16) | ((UINT32)op[4] << 24));
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			return true;
+
+		case 0xeb:  /* JMP rel8 */
+			desc.cycles = cycles[CYCLES_JMP_SHORT];
+			desc.targetpc = desc.pc + 2 + (INT8)op[1];
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			return true;
+
+		case 0xff:
+			switch (reg)
+			{
+				case 0:     /* INC rm32 */
+				case 1:     /* DEC rm32 */
+					if (regform)
+						desc.cycles = cycles[(reg == 0) ? CYCLES_INC_REG : CYCLES_DEC_REG];
+					else
+					{
+						desc.cycles = cycles[(reg == 0) ? CYCLES_INC_MEM : CYCLES_DEC_MEM];
+						describe_memory(desc, OPFLAG_READS_MEMORY | OPFLAG_WRITES_MEMORY, paging);
+					}
+					desc.regout[1] |= I386_FLAG_ALL & ~I386_FLAG_CF;
+					return true;
+
+				case 2:     /* CALL rm32 */
+					desc.cycles = cycles[regform ? CYCLES_CALL_REG : CYCLES_CALL_MEM];
+					describe_memory(desc, OPFLAG_WRITES_MEMORY | (regform ? 0 : OPFLAG_READS_MEMORY), paging);
+					desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+					return true;
+
+				case 4:     /* JMP rm32 */
+					desc.cycles = cycles[regform ? CYCLES_JMP_REG : CYCLES_JMP_MEM];
+					if (!regform)
+						describe_memory(desc, OPFLAG_READS_MEMORY, paging);
+					desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+					return true;
+
+				case 6:     /* PUSH rm32 */
+					desc.cycles = cycles[CYCLES_PUSH_RM];
+					describe_memory(desc, OPFLAG_WRITES_MEMORY | (regform ? 0 : OPFLAG_READS_MEMORY), paging);
+					return true;
+			}
+			return false;
+	}
+	return false;
+}
+
+
+/*-------------------------------------------------
+    describe_two_byte - describe an instruction
+    from the 0F map that the recompiler generates
+    natively
+-------------------------------------------------*/
+
+bool i386_frontend::describe_two_byte(opcode_desc &desc, const UINT8 *op, bool paging)
+{
+	const UINT8 *cycles = m_i386->m_cycle_table_pm;
+	UINT8 opcode = op[0];
+	bool regform = (op[1] >= 0xc0);
+
+	switch (opcode)
+	{
+		case 0x80:  case 0x81:  case 0x82:  case 0x83:  case 0x84:  case 0x85:  case 0x86:  case 0x87:  /* Jcc rel32 */
+		case 0x88:  case 0x89:  case 0x8a:  case 0x8b:  case 0x8c:  case 0x8d:  case 0x8e:  case 0x8f:
+			desc.cycles = cycles[CYCLES_JCC_FULL_DISP_NOBRANCH];
+			desc.regin[1] |= condition_flags[(opcode >> 1) & 7];
+			desc.targetpc = desc.pc + 6 + (op[1] | (op[2] << 8) | (op[3] << 16) | ((UINT32)op[4] << 24));
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+			return true;
+
+		case 0xb6:  case 0xb7:  /* MOVZX r32,rm */
+			desc.cycles = cycles[regform ? CYCLES_MOVZX_REG_REG : CYCLES_MOVZX_MEM_REG];
+			if (!regform)
+				describe_memory(desc, OPFLAG_READS_MEMORY, paging);
+			return true;
+
+		case 0xbe:  case 0xbf:  /* MOVSX r32,rm */
+			desc.cycles = cycles[regform ? CYCLES_MOVSX_REG_REG : CYCLES_MOVSX_MEM_REG];
+			if (!regform)
+				describe_memory(desc, OPFLAG_READS_MEMORY, paging);
+			return true;
+	}
+	return false;
+}
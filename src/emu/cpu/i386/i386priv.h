@@ -293,6 +293,11 @@ extern int i386_parity_table[256];
 #define FAULT_THROW(fault,error) { throw (UINT64)(fault | (UINT64)error << 32); }
 #define PF_THROW(error) { m_cr[2] = address; FAULT_THROW(FAULT_PF,error); }
 
+/* what the memory functions do while the recompiler is compared with the interpreter */
+#define COMPARE_ACCESS_NONE     (0)     /* access memory */
+#define COMPARE_ACCESS_RECORD   (1)     /* access memory and log it for the interpreter */
+#define COMPARE_ACCESS_REPLAY   (2)     /* hand out the logged reads and check the writes */
+
 #define PROTECTED_MODE      (m_cr[0] & 0x1)
 #define STACK_32BIT         (m_sreg[SS].d)
 #define V8086_MODE          (m_VM)
@@ -594,6 +599,9 @@ UINT32 i386_device::FETCH32()
 
 UINT8 i386_device::READ8(UINT32 ea)
 {
+	if (m_compare_mode != COMPARE_ACCESS_NONE)
+		return compare_read(ea, 1);
+
 	UINT32 address = ea, error;
 
 	if(!translate_address(m_CPL,TRANSLATE_READ,&address, &error))
@@ -604,6 +612,9 @@ UINT8 i386_device::READ8(UINT32 ea)
 }
 UINT16 i386_device::READ16(UINT32 ea)
 {
+	if (m_compare_mode != COMPARE_ACCESS_NONE)
+		return compare_read(ea, 2);
+
 	UINT16 value;
 	UINT32 address = ea, error;
 
@@ -621,6 +632,9 @@ UINT16 i386_device::READ16(UINT32 ea)
 }
 UINT32 i386_device::READ32(UINT32 ea)
 {
+	if (m_compare_mode != COMPARE_ACCESS_NONE)
+		return compare_read(ea, 4);
+
 	UINT32 value;
 	UINT32 address = ea, error;
 
@@ -720,6 +734,12 @@ void i386_device::WRITE_TEST(UINT32 ea)
 
 void i386_device::WRITE8(UINT32 ea, UINT8 value)
 {
+	if (m_compare_mode != COMPARE_ACCESS_NONE)
+	{
+		compare_write(ea, 1, value);
+		return;
+	}
+
 	UINT32 address = ea, error;
 
 	if(!translate_address(m_CPL,TRANSLATE_WRITE,&address,&error))
@@ -730,6 +750,12 @@ void i386_device::WRITE8(UINT32 ea, UINT8 value)
 }
 void i386_device::WRITE16(UINT32 ea, UINT16 value)
 {
+	if (m_compare_mode != COMPARE_ACCESS_NONE)
+	{
+		compare_write(ea, 2, value);
+		return;
+	}
+
 	UINT32 address = ea, error;
 
 	if( ea & 0x1 ) {        /* Unaligned write */
@@ -745,6 +771,12 @@ void i386_device::WRITE16(UINT32 ea, UINT16 value)
 }
 void i386_device::WRITE32(UINT32 ea, UINT32 value)
 {
+	if (m_compare_mode != COMPARE_ACCESS_NONE)
+	{
+		compare_write(ea, 4, value);
+		return;
+	}
+
 	UINT32 address = ea, error;
 
 	if( ea & 0x3 ) {        /* Unaligned write */
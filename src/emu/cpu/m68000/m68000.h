@@ -18,6 +18,11 @@
 /* instruction cache constants */
 #define M68K_IC_SIZE 128
 
+/* threaded code cache constants */
+#define M68K_TCACHE_SIZE 16384      /* entries, indexed by instruction address */
+#define M68K_TCACHE_WORDS 5         /* most words a 68000 or 68010 instruction can fetch */
+#define M68K_TCACHE_PAGE_SHIFT 10   /* granularity of the map of RAM pages holding cached code */
+
 
 
 
@@ -357,6 +362,30 @@ public:
 	UINT32 ic_data[M68K_IC_SIZE];      /* instruction cache content data */
 	bool   ic_valid[M68K_IC_SIZE];     /* instruction cache valid flags */
 
+	/* threaded code cache (68000 and 68010): the handler of the instruction at an address and
+	   the words it fetched, replayed instead of being read through the memory system again */
+	struct tcache_entry
+	{
+		UINT32 pc;                                  /* address of the instruction, odd if free */
+		const UINT16 *code;                         /* where its words were read from */
+		bool ram;                                   /* true if that memory is writable */
+		void (*handler)(m68000_base_device *m68k);  /* handler for its opcode */
+		UINT32 count;                               /* number of words recorded */
+		UINT16 words[M68K_TCACHE_WORDS + 1];        /* the words, then the one prefetched after them */
+	};
+
+	std::vector<tcache_entry> tcache;  /* the entries; empty when the cache is off */
+	std::vector<UINT8> tcache_pages;   /* nonzero for each RAM page holding cached code */
+	tcache_entry *tcache_active;       /* entry of the instruction being executed, if any */
+	bool   tcache_compare;             /* check each replayed word against a regular fetch */
+
+	void tcache_init(void);
+	inline tcache_entry *tcache_lookup(UINT32 pc);
+	inline void dispatch_instruction(void);
+	void tcache_record(UINT32 word);
+	void tcache_written(UINT32 address, int size);
+	void tcache_check(UINT32 address, UINT32 cached);
+
 
 
 	/* 68307 / 68340 internal address map */
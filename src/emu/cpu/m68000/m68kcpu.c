@@ -780,6 +780,143 @@ bool m68000_base_device::memory_translate(address_spacenum space, int intention,
 
 
 
+/****************************************************************************
+ * Threaded code cache
+ *
+ * The 68000 and 68010 can keep, for each instruction address, the handler
+ * for the opcode there and the words the instruction fetched, including the
+ * one prefetched after it.  When the instruction runs again the handler is
+ * called directly and the words are replayed through m68ki_read_imm_16
+ * instead of being read through the memory system, so prefetch and cycle
+ * counts are exactly those of table dispatch.  Words are recorded as the
+ * instruction fetches them, so an entry only grows when a later execution
+ * fetches further (a branch taken after first not being taken).
+ *
+ * An entry is only used while the memory it was recorded from is still
+ * mapped at the same place, so bank switching is picked up.  Stores by the
+ * CPU into a RAM page holding cached code discard the entries they hit.
+ * Other devices can write RAM too, so, as the recompilers checksum code
+ * outside ROM, an entry recorded from RAM is also compared with memory
+ * before it is used and recorded afresh if it differs.
+ ****************************************************************************/
+
+void m68000_base_device::tcache_init(void)
+{
+	if (!mconfig().options().m68k_threaded())
+		return;
+
+	tcache.resize(M68K_TCACHE_SIZE);
+	for (int i = 0; i < M68K_TCACHE_SIZE; i++)
+		tcache[i].pc = 1;
+	tcache_pages.resize(1 << (24 - M68K_TCACHE_PAGE_SHIFT), 0);
+	tcache_compare = mconfig().options().m68k_threaded_compare();
+}
+
+inline m68000_base_device::tcache_entry *m68000_base_device::tcache_lookup(UINT32 pc)
+{
+	/* only code in directly readable memory is cached */
+	if (pc & 1)
+		return NULL;
+	const UINT16 *code = reinterpret_cast<const UINT16 *>(m_odirect->read_ptr(pc));
+	if (code == NULL)
+		return NULL;
+
+	tcache_entry *tc = &tcache[(pc >> 1) & (M68K_TCACHE_SIZE - 1)];
+	if (tc->pc == pc && tc->code == code && m_odirect->read_ptr(pc + 2 * tc->count) == code + tc->count)
+	{
+		UINT32 i = 0;
+		if (tc->ram)
+			while (i <= tc->count && code[i] == tc->words[i])
+				i++;
+		if ((!tc->ram || i > tc->count) && (pref_addr != pc || pref_data == tc->words[0]))
+			return tc;
+	}
+
+	/* a prefetched word that no longer matches memory is fetched as is */
+	if (pref_addr == pc && pref_data != code[0])
+		return NULL;
+	tc->pc = pc;
+	tc->code = code;
+	tc->ram = (program->get_write_ptr(pc) != NULL);
+	tc->count = 0;
+	return tc;
+}
+
+inline void m68000_base_device::dispatch_instruction(void)
+{
+	if (tcache.empty())
+	{
+		ir = m68ki_read_imm_16(this);
+		jump_table[ir](this);
+		return;
+	}
+
+	/* fetch through the cache entry, which records or replays the words, and call its handler */
+	tcache_active = tcache_lookup(REG_PC(this));
+	ir = m68ki_read_imm_16(this);
+	if (tcache_active != NULL)
+	{
+		if (tcache_compare && tcache_active->handler != jump_table[ir])
+			fatalerror("%s: threaded code cache handler mismatch for %04x at %08x\n", tag(), ir, REG_PPC(this));
+		tcache_active->handler(this);
+		tcache_active = NULL;
+	}
+	else
+		jump_table[ir](this);
+}
+
+void m68000_base_device::tcache_record(UINT32 word)
+{
+	tcache_entry *tc = tcache_active;
+
+	/* stop when the instruction runs past the longest one or off the memory it was read from */
+	if (tc->count == M68K_TCACHE_WORDS || m_odirect->read_ptr(tc->pc + 2 * (tc->count + 1)) != tc->code + tc->count + 1)
+	{
+		if (tc->count == 0)
+			tc->pc = 1;
+		tcache_active = NULL;
+		return;
+	}
+
+	if (tc->count == 0)
+		tc->handler = jump_table[word];
+	tc->words[tc->count++] = word;
+	tc->words[tc->count] = pref_data;
+
+	/* note the pages of the word and the prefetched one so that stores to them are seen */
+	if (tc->ram)
+	{
+		UINT32 address = (tc->pc + 2 * tc->count) & 0xffffff;
+		tcache_pages[(address - 2) >> M68K_TCACHE_PAGE_SHIFT] = 1;
+		tcache_pages[address >> M68K_TCACHE_PAGE_SHIFT] = 1;
+	}
+}
+
+void m68000_base_device::tcache_written(UINT32 address, int size)
+{
+	/* discard every entry whose words, including the prefetched one, overlap the store */
+	address &= 0xffffff;
+	for (UINT32 pc = (address - 2 * (M68K_TCACHE_WORDS + 1)) & ~1; pc != ((address + size + 1) & ~1); pc += 2)
+	{
+		tcache_entry *tc = &tcache[(pc >> 1) & (M68K_TCACHE_SIZE - 1)];
+		if ((tc->pc & 0xffffff) == (pc & 0xffffff) && address < (pc & 0xffffff) + 2 * (tc->count + 1))
+		{
+			tc->pc = 1;
+			if (tc == tcache_active)
+				tcache_active = NULL;
+		}
+	}
+}
+
+void m68000_base_device::tcache_check(UINT32 address, UINT32 cached)
+{
+	UINT32 actual = m68ki_ic_readimm16(this, address);
+	if (actual != cached)
+		fatalerror("%s: threaded code cache replayed %04x at %08x where table dispatch reads %04x (instruction at %08x)\n", tag(), cached, address, actual, REG_PPC(this));
+}
+
+
+
 inline void m68000_base_device::cpu_execute(void)
 {
 	initial_cycles = remaining_cycles;
@@ -827,6 +964,9 @@ inline void m68000_base_device::cpu_execute(void)
 		}
 
 
+		/* without the debugger, the per-instruction hooks can be skipped */
+		const bool nohooks = (machine().debug_flags & DEBUG_FLAG_ENABLED) == 0;
+
 		/* Main loop.  Keep going until we run out of clock cycles */
 		while (remaining_cycles > 0)
 		{
@@ -845,12 +985,26 @@ inline void m68000_base_device::cpu_execute(void)
 
 			try
 			{
-			if (!pmmu_enabled)
+			if (!pmmu_enabled && nohooks && instruction_hook.isnull())
+			{
+				/* nothing needs to see individual instructions, so stay in a tight loop */
+				const UINT8 *const cycles = cyc_instruction;
+				do
+				{
+					m68ki_trace_t1(this); /* auto-disable (see m68kcpu.h) */
+					REG_PPC(this) = REG_PC(this);
+					run_mode = RUN_MODE_NORMAL;
+					dispatch_instruction();
+					remaining_cycles -= cycles[ir];
+					m68ki_exception_if_trace(this); /* auto-disable (see m68kcpu.h) */
+				} while (remaining_cycles > 0 && !pmmu_enabled && instruction_hook.isnull());
+				continue;
+			}
+			else if (!pmmu_enabled)
 			{
 				run_mode = RUN_MODE_NORMAL;
 				/* Read an instruction and call its handler */
-				ir = m68ki_read_imm_16(this);
-				jump_table[ir](this);
+				dispatch_instruction();
 				remaining_cycles -= cyc_instruction[ir];
 			}
 			else
@@ -927,6 +1081,7 @@ inline void m68000_base_device::cpu_execute(void)
 			}
 			catch (int error)
 			{
+				tcache_active = NULL;
 				if (error==10)
 				{
 					m_address_error = 1;
@@ -2488,6 +2643,11 @@ void m68000_base_device::clear_all()
 		ic_valid[i] = false;
 	}
 
+	tcache.clear();
+	tcache_pages.clear();
+	tcache_active = NULL;
+	tcache_compare = false;
+
 	internal = 0;
 }
 
@@ -2584,6 +2744,7 @@ m68000_device::m68000_device(const machine_config &mconfig, const char *tag, dev
 void m68000_device::device_start()
 {
 	init_cpu_m68000();
+	tcache_init();
 }
 
 m68000_device::m68000_device(const machine_config &mconfig, const char *name, const char *tag, device_t *owner, UINT32 clock,
@@ -2645,6 +2806,7 @@ m68010_device::m68010_device(const machine_config &mconfig, const char *tag, dev
 void m68010_device::device_start()
 {
 	init_cpu_m68010();
+	tcache_init();
 }
 
 
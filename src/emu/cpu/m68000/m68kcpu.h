@@ -734,6 +734,29 @@ INLINE UINT32 m68ki_read_imm_16(m68000_base_device *m68k)
 
 	m68ki_check_address_error(m68k, REG_PC(m68k), MODE_READ, m68k->s_flag | FUNCTION_CODE_USER_PROGRAM); /* auto-disable (see m68kcpu.h) */
 
+	/* replay a word the threaded code cache recorded for this instruction */
+	m68000_base_device::tcache_entry *tc = m68k->tcache_active;
+	if (tc != NULL)
+	{
+		UINT32 index = (REG_PC(m68k) - tc->pc) >> 1;
+		if (REG_PC(m68k) == tc->pc + 2 * index && index < tc->count)
+		{
+			if (REG_PC(m68k) != m68k->pref_addr)
+			{
+				if (m68k->tcache_compare)
+					m68k->tcache_check(REG_PC(m68k), tc->words[index]);
+				m68k->pref_data = tc->words[index];
+			}
+			result = MASK_OUT_ABOVE_16(m68k->pref_data);
+			REG_PC(m68k) += 2;
+			if (m68k->tcache_compare)
+				m68k->tcache_check(REG_PC(m68k), tc->words[index + 1]);
+			m68k->pref_data = tc->words[index + 1];
+			m68k->pref_addr = REG_PC(m68k);
+			return result;
+		}
+	}
+
 	if(REG_PC(m68k) != m68k->pref_addr)
 	{
 		m68k->pref_data = m68ki_ic_readimm16(m68k, REG_PC(m68k));
@@ -749,6 +772,10 @@ INLINE UINT32 m68ki_read_imm_16(m68000_base_device *m68k)
 		m68k->mmu_tmp_buserror_occurred = 0;
 	}
 
+	/* extend the recording if this word follows the ones already cached */
+	if (tc != NULL && REG_PC(m68k) - 2 == tc->pc + 2 * tc->count)
+		m68k->tcache_record(result);
+
 	return result;
 }
 
@@ -756,6 +783,13 @@ INLINE UINT32 m68ki_read_imm_32(m68000_base_device *m68k)
 {
 	UINT32 temp_val;
 
+	/* the cache records and replays single words */
+	if (m68k->tcache_active != NULL)
+	{
+		temp_val = m68ki_read_imm_16(m68k) << 16;
+		return temp_val | m68ki_read_imm_16(m68k);
+	}
+
 	m68k->mmu_tmp_fc = m68k->s_flag | FUNCTION_CODE_USER_PROGRAM;
 	m68k->mmu_tmp_rw = 1;
 
@@ -816,8 +850,17 @@ INLINE UINT32 m68ki_read_32_fc(m68000_base_device *m68k, UINT32 address, UINT32
 	return m68k->/*memory.*/read32(address);
 }
 
+/* Let the threaded code cache discard the instructions a store overwrites */
+INLINE void m68ki_tcache_write(m68000_base_device *m68k, UINT32 address, int size)
+{
+	if (!m68k->tcache_pages.empty() &&
+		(m68k->tcache_pages[(address & 0xffffff) >> M68K_TCACHE_PAGE_SHIFT] || m68k->tcache_pages[((address + size - 1) & 0xffffff) >> M68K_TCACHE_PAGE_SHIFT]))
+		m68k->tcache_written(address, size);
+}
+
 INLINE void m68ki_write_8_fc(m68000_base_device *m68k, UINT32 address, UINT32 fc, UINT32 value)
 {
+	m68ki_tcache_write(m68k, address, 1);
 	m68k->mmu_tmp_fc = fc;
 	m68k->mmu_tmp_rw = 0;
 	m68k->/*memory.*/write8(address, value);
@@ -828,6 +871,7 @@ INLINE void m68ki_write_16_fc(m68000_base_device *m68k, UINT32 address, UINT32 f
 	{
 		m68ki_check_address_error(m68k, address, MODE_WRITE, fc);
 	}
+	m68ki_tcache_write(m68k, address, 2);
 	m68k->mmu_tmp_fc = fc;
 	m68k->mmu_tmp_rw = 0;
 	m68k->/*memory.*/write16(address, value);
@@ -838,6 +882,7 @@ INLINE void m68ki_write_32_fc(m68000_base_device *m68k, UINT32 address, UINT32 f
 	{
 		m68ki_check_address_error(m68k, address, MODE_WRITE, fc);
 	}
+	m68ki_tcache_write(m68k, address, 4);
 	m68k->mmu_tmp_fc = fc;
 	m68k->mmu_tmp_rw = 0;
 	m68k->/*memory.*/write32(address, value);
@@ -854,6 +899,7 @@ INLINE void m68ki_write_32_pd_fc(m68000_base_device *m68k, UINT32 address, UINT3
 	{
 		m68ki_check_address_error(m68k, address, MODE_WRITE, fc);
 	}
+	m68ki_tcache_write(m68k, address, 4);
 	m68k->mmu_tmp_fc = fc;
 	m68k->mmu_tmp_rw = 0;
 	m68k->/*memory.*/write16(address+2, value>>16);
@@ -158,8 +158,16 @@ mips3_device::mips3_device(const machine_config &mconfig, device_type type, cons
 	, m_cache(CACHE_SIZE + sizeof(internal_mips3_state))
 	, m_drcuml(NULL)
 	, m_drcfe(NULL)
+	, m_codetrack(NULL)
 	, m_drcoptions(0)
 	, m_cache_dirty(0)
+	, m_compile_queue(NULL)
+	, m_compile_item(NULL)
+	, m_compile_block(NULL)
+	, m_compile_mode(0)
+	, m_compile_desclist(NULL)
+	, m_compile_failed(false)
+	, m_interp_tracking(false)
 	, m_entry(NULL)
 	, m_nocode(NULL)
 	, m_out_of_cycles(NULL)
@@ -196,6 +204,13 @@ mips3_device::mips3_device(const machine_config &mconfig, device_type type, cons
 
 void mips3_device::device_stop()
 {
+	if (m_compile_queue != NULL)
+	{
+		code_compile_wait();
+		osd_work_queue_free(m_compile_queue);
+		m_compile_queue = NULL;
+	}
+
 	if (m_vtlb != NULL)
 	{
 		vtlb_free(m_vtlb);
@@ -207,6 +222,11 @@ void mips3_device::device_stop()
 		auto_free(machine(), m_drcfe);
 		m_drcfe = NULL;
 	}
+	if (m_codetrack != NULL)
+	{
+		auto_free(machine(), m_codetrack);
+		m_codetrack = NULL;
+	}
 	if (m_drcuml != NULL)
 	{
 		auto_free(machine(), m_drcuml);
@@ -405,6 +425,16 @@ void mips3_device::device_start()
 	/* initialize the front-end helper */
 	m_drcfe = auto_alloc(machine(), mips3_frontend(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE));
 
+	/* track which physical pages hold translated code */
+	m_codetrack = auto_alloc(machine(), drc_code_tracker(*m_drcuml, 32));
+
+	/* optionally compile hot code on another thread and interpret cold code meanwhile */
+	if (m_isdrc && mconfig().options().drc_background())
+	{
+		m_compile_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+		m_hotness.resize(COMPILE_HOTNESS_SIZE, 0);
+	}
+
 	/* allocate memory for cache-local state and initialize it */
 	memcpy(m_fpmode, fpmode_source, sizeof(fpmode_source));
 
@@ -1172,6 +1202,8 @@ inline void mips3_device::WBYTE(offs_t address, UINT8 data)
 	if (tlbval & VTLB_WRITE_ALLOWED)
 	{
 		const UINT32 tlbaddress = (tlbval & ~0xfff) | (address & 0xfff);
+		if (m_interp_tracking)
+			code_written_interpreted(tlbaddress, 1);
 		for (int ramnum = 0; ramnum < m_fastram_select; ramnum++)
 		{
 			if (m_fastram[ramnum].readonly == TRUE || tlbaddress < m_fastram[ramnum].start || tlbaddress > m_fastram[ramnum].end)
@@ -1206,6 +1238,8 @@ inline void mips3_device::WHALF(offs_t address, UINT16 data)
 	if (tlbval & VTLB_WRITE_ALLOWED)
 	{
 		const UINT32 tlbaddress = (tlbval & ~0xfff) | (address & 0xfff);
+		if (m_interp_tracking)
+			code_written_interpreted(tlbaddress, 2);
 		for (int ramnum = 0; ramnum < m_fastram_select; ramnum++)
 		{
 			if (m_fastram[ramnum].readonly == TRUE || tlbaddress < m_fastram[ramnum].start || tlbaddress > m_fastram[ramnum].end)
@@ -1240,6 +1274,8 @@ inline void mips3_device::WWORD(offs_t address, UINT32 data)
 	if (tlbval & VTLB_WRITE_ALLOWED)
 	{
 		const UINT32 tlbaddress = (tlbval & ~0xfff) | (address & 0xfff);
+		if (m_interp_tracking)
+			code_written_interpreted(tlbaddress, 4);
 		for (int ramnum = 0; ramnum < m_fastram_select; ramnum++)
 		{
 			if (m_fastram[ramnum].readonly == TRUE || tlbaddress < m_fastram[ramnum].start || tlbaddress > m_fastram[ramnum].end)
@@ -1273,6 +1309,8 @@ inline void mips3_device::WWORD_MASKED(offs_t address, UINT32 data, UINT32 mem_m
 	const UINT32 tlbval = m_tlb_table[address >> 12];
 	if (tlbval & VTLB_WRITE_ALLOWED)
 	{
+		if (m_interp_tracking)
+			code_written_interpreted((tlbval & ~0xfff) | (address & 0xfff), 4);
 		(*m_memory.write_dword_masked)(*m_program, (tlbval & ~0xfff) | (address & 0xfff), data, mem_mask);
 	}
 	else
@@ -1297,6 +1335,8 @@ inline void mips3_device::WDOUBLE(offs_t address, UINT64 data)
 	const UINT32 tlbval = m_tlb_table[address >> 12];
 	if (tlbval & VTLB_WRITE_ALLOWED)
 	{
+		if (m_interp_tracking)
+			code_written_interpreted((tlbval & ~0xfff) | (address & 0xfff), 8);
 		(*m_memory.write_qword)(*m_program, (tlbval & ~0xfff) | (address & 0xfff), data);
 	}
 	else
@@ -1321,6 +1361,8 @@ inline void mips3_device::WDOUBLE_MASKED(offs_t address, UINT64 data, UINT64 mem
 	const UINT32 tlbval = m_tlb_table[address >> 12];
 	if (tlbval & VTLB_WRITE_ALLOWED)
 	{
+		if (m_interp_tracking)
+			code_written_interpreted((tlbval & ~0xfff) | (address & 0xfff), 8);
 		(*m_memory.write_qword_masked)(*m_program, (tlbval & ~0xfff)  | (address & 0xfff), data, mem_mask);
 	}
 	else
@@ -1517,7 +1559,7 @@ void mips3_device::handle_cop0(UINT32 op)
 					break;
 
 				case 0x10:  /* RFE */   invalid_instruction(op);                            break;
-				case 0x18:  /* ERET */  logerror("ERET\n"); m_core->pc = m_core->cpr[0][COP0_EPC]; SR &= ~SR_EXL; check_irqs(); m_lld_value ^= 0xffffffff; m_ll_value ^= 0xffffffff;  break;
+				case 0x18:  /* ERET */  logerror("ERET\n"); m_core->pc = m_core->cpr[0][COP0_EPC]; SR &= ~SR_EXL; check_irqs(); m_lld_value ^= 0xffffffff; m_ll_value ^= 0xffffffff; m_core->llbit = 0;  break;
 				case 0x20:  /* WAIT */                                                      break;
 				default:    invalid_instruction(op);                                        break;
 			}
@@ -2707,6 +2749,10 @@ void mips3_device::execute_run()
 	{
 		int execute_result;
 
+		/* take the cache back from a compile started in the last timeslice */
+		if (m_compile_queue != NULL)
+			code_compile_wait();
+
 		/* reset the cache if dirty */
 		if (m_cache_dirty)
 			code_flush_cache();
@@ -2718,8 +2764,18 @@ void mips3_device::execute_run()
 			/* run as much as we can */
 			execute_result = m_drcuml->execute(*m_entry);
 
+			/* with background compilation, interpret cold code and start compiling hot code */
+			if (execute_result == EXECUTE_MISSING_CODE && m_compile_queue != NULL)
+			{
+				if (code_is_hot(m_core->mode, m_core->pc))
+					code_compile_background(m_core->mode, m_core->pc);
+				code_interpret();
+				if (m_core->icount <= 0)
+					return;
+			}
+
 			/* if we need to recompile, do it */
-			if (execute_result == EXECUTE_MISSING_CODE)
+			else if (execute_result == EXECUTE_MISSING_CODE)
 			{
 				code_compile_block(m_core->mode, m_core->pc);
 			}
@@ -2737,6 +2793,18 @@ void mips3_device::execute_run()
 		return;
 	}
 
+	interpret(0);
+}
+
+
+/*-------------------------------------------------
+    interpret - run the interpreter until the
+    icount drops to the given floor, finishing
+    any delay slot
+-------------------------------------------------*/
+
+void mips3_device::interpret(int floor)
+{
 	/* count cycles and interrupt cycles */
 	m_core->icount -= m_interrupt_cycles;
 	m_interrupt_cycles = 0;
@@ -2844,17 +2912,18 @@ void mips3_device::execute_run()
 			case 0x2d:  /* SDR */       (this->*m_sdr)(op);                                                       break;
 			case 0x2e:  /* SWR */       (this->*m_swr)(op);                                                       break;
 			case 0x2f:  /* CACHE */     /* effective no-op */                                                   break;
-			case 0x30:  /* LL */        if (RWORD(SIMMVAL+RSVAL32, &temp) && RTREG) RTVAL64 = (UINT32)temp; m_ll_value = RTVAL32;       break;
+			case 0x30:  /* LL */        if (RWORD(SIMMVAL+RSVAL32, &temp) && RTREG) RTVAL64 = (UINT32)temp; m_ll_value = RTVAL32; m_core->llbit = 1;  break;
 			case 0x31:  /* LWC1 */      if (RWORD(SIMMVAL+RSVAL32, &temp)) set_cop1_reg32(RTREG, temp);         break;
 			case 0x32:  /* LWC2 */      if (RWORD(SIMMVAL+RSVAL32, &temp)) set_cop2_reg(RTREG, temp);           break;
 			case 0x33:  /* PREF */      /* effective no-op */                                                   break;
-			case 0x34:  /* LLD */       if (RDOUBLE(SIMMVAL+RSVAL32, &temp64) && RTREG) RTVAL64 = temp64; m_lld_value = temp64;     break;
+			case 0x34:  /* LLD */       if (RDOUBLE(SIMMVAL+RSVAL32, &temp64) && RTREG) RTVAL64 = temp64; m_lld_value = temp64; m_core->llbit = 1;  break;
 			case 0x35:  /* LDC1 */      if (RDOUBLE(SIMMVAL+RSVAL32, &temp64)) set_cop1_reg64(RTREG, temp64);       break;
 			case 0x36:  /* LDC2 */      if (RDOUBLE(SIMMVAL+RSVAL32, &temp64)) set_cop2_reg(RTREG, temp64);     break;
 			case 0x37:  /* LD */        if (RDOUBLE(SIMMVAL+RSVAL32, &temp64) && RTREG) RTVAL64 = temp64;       break;
 			case 0x38:  /* SC */        if (RWORD(SIMMVAL+RSVAL32, &temp) && RTREG)
 			{
-				if (temp == m_ll_value)
+				/* as the DRC's cold tier, follow its link bit so that LL and SC can be split between the two */
+				if (m_interp_tracking ? (m_core->llbit != 0) : (temp == m_ll_value))
 				{
 					WWORD(SIMMVAL+RSVAL32, RTVAL32);
 					RTVAL64 = (UINT32)1;
@@ -2870,7 +2939,7 @@ void mips3_device::execute_run()
 			case 0x3b:  /* SWC3 */      invalid_instruction(op);                                                break;
 			case 0x3c:  /* SCD */       if (RDOUBLE(SIMMVAL+RSVAL32, &temp64) && RTREG)
 			{
-				if (temp64 == m_lld_value)
+				if (m_interp_tracking ? (m_core->llbit != 0) : (temp64 == m_lld_value))
 				{
 					WDOUBLE(SIMMVAL+RSVAL32, RTVAL64);
 					RTVAL64 = 1;
@@ -2888,7 +2957,7 @@ void mips3_device::execute_run()
 		}
 		m_core->icount--;
 
-	} while (m_core->icount > 0 || m_nextpc != ~0);
+	} while (m_core->icount > floor || m_nextpc != ~0);
 
 	m_core->icount -= m_interrupt_cycles;
 	m_interrupt_cycles = 0;
@@ -427,11 +427,23 @@ private:
 	drc_cache           m_cache;                      /* pointer to the DRC code cache */
 	drcuml_state *      m_drcuml;                     /* DRC UML generator state */
 	mips3_frontend *    m_drcfe;                      /* pointer to the DRC front-end state */
+	drc_code_tracker *  m_codetrack;                  /* tracker for pages holding translated code */
 	UINT32              m_drcoptions;                 /* configurable DRC options */
 
 	/* internal stuff */
 	UINT8               m_cache_dirty;                /* true if we need to flush the cache */
 
+	/* background compilation */
+	osd_work_queue *    m_compile_queue;              /* queue for the compile thread, or NULL if off */
+	osd_work_item *     m_compile_item;               /* block being compiled in the background */
+	drcuml_block *      m_compile_block;              /* its UML, generated on the emulation thread */
+	UINT8               m_compile_mode;               /* mode it was compiled for */
+	const opcode_desc * m_compile_desclist;           /* its description */
+	bool                m_compile_failed;             /* true if the cache filled up while compiling it */
+	bool                m_interp_tracking;            /* true while interpreting as the DRC's cold tier */
+	std::vector<UINT32> m_interp_written;             /* code pages written while a compile was pending */
+	std::vector<UINT8>  m_hotness;                    /* misses seen by mode/PC, hashed */
+
 	/* tables */
 	UINT8               m_fpmode[4];                  /* FPU mode table */
 
@@ -547,8 +559,17 @@ private:
 	void save_fast_iregs(drcuml_block *block);
 	void code_flush_cache();
 	void code_compile_block(UINT8 mode, offs_t pc);
+	drcuml_block *code_generate_block(UINT8 mode, offs_t pc, const opcode_desc *desclist);
+	bool code_is_hot(UINT8 mode, offs_t pc);
+	void code_compile_background(UINT8 mode, offs_t pc);
+	void code_compile_wait();
+	void code_interpret();
+	void interpret(int floor);
+	void code_written_interpreted(offs_t physaddr, int size);
+	static void *compile_block_callback(void *param, int threadid);
 public:
 	void func_get_cycles();
+	void func_code_written();
 	void func_printf_exception();
 	void func_printf_debug();
 	void func_printf_probe();
@@ -52,6 +52,12 @@
 #define COMPILE_MAX_INSTRUCTIONS        ((COMPILE_BACKWARDS_BYTES/4) + (COMPILE_FORWARDS_BYTES/4))
 #define COMPILE_MAX_SEQUENCE            64
 
+/* background compilation: misses at a PC before it is compiled, and cycles interpreted per cold miss */
+#define COMPILE_HOT_THRESHOLD           8
+#define COMPILE_HOTNESS_SIZE            4096
+#define COMPILE_COLD_CYCLES             64
+#define COMPILE_MAX_PENDING_WRITES      256
+
 /* exit codes */
 #define EXECUTE_OUT_OF_CYCLES           0
 #define EXECUTE_MISSING_CODE            1
@@ -223,6 +223,7 @@ void mips3_device::code_flush_cache()
 
 	/* empty the transient cache contents */
 	m_drcuml->reset();
+	m_codetrack->reset();
 
 	try
 	{
@@ -281,11 +282,7 @@ void mips3_device::code_flush_cache()
 void mips3_device::code_compile_block(UINT8 mode, offs_t pc)
 {
 	drcuml_state *drcuml = m_drcuml;
-	compiler_state compiler = { 0 };
-	const opcode_desc *seqhead, *seqlast;
 	const opcode_desc *desclist;
-	int override = FALSE;
-	drcuml_block *block;
 
 	g_profiler.start(PROFILER_DRC_COMPILE);
 
@@ -300,80 +297,10 @@ void mips3_device::code_compile_block(UINT8 mode, offs_t pc)
 	{
 		try
 		{
-			/* start the block */
-			block = drcuml->begin_block(4096);
-
-			/* loop until we get through all instruction sequences */
-			for (seqhead = desclist; seqhead != NULL; seqhead = seqlast->next())
-			{
-				const opcode_desc *curdesc;
-				UINT32 nextpc;
-
-				/* add a code log entry */
-				if (drcuml->logging())
-					block->append_comment("-------------------------");                     // comment
-
-				/* determine the last instruction in this sequence */
-				for (seqlast = seqhead; seqlast != NULL; seqlast = seqlast->next())
-					if (seqlast->flags & OPFLAG_END_SEQUENCE)
-						break;
-				assert(seqlast != NULL);
-
-				/* if we don't have a hash for this mode/pc, or if we are overriding all, add one */
-				if (override || !drcuml->hash_exists(mode, seqhead->pc))
-					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
-
-				/* if we already have a hash, and this is the first sequence, assume that we */
-				/* are recompiling due to being out of sync and allow future overrides */
-				else if (seqhead == desclist)
-				{
-					override = TRUE;
-					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
-				}
-
-				/* otherwise, redispatch to that fixed PC and skip the rest of the processing */
-				else
-				{
-					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
-					UML_HASHJMP(block, m_core->mode, seqhead->pc, *m_nocode);
-																							// hashjmp <mode>,seqhead->pc,nocode
-					continue;
-				}
-
-				/* validate this code block if we're not pointing into ROM */
-				if (m_program->get_write_ptr(seqhead->physpc) != NULL)
-					generate_checksum_block(block, &compiler, seqhead, seqlast);
-
-				/* label this instruction, if it may be jumped to locally */
-				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
-					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
-
-				/* iterate over instructions in the sequence and compile them */
-				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
-					generate_sequence_instruction(block, &compiler, curdesc);
-
-				/* if we need to return to the start, do it */
-				if (seqlast->flags & OPFLAG_RETURN_TO_START)
-					nextpc = pc;
-
-				/* otherwise we just go to the next instruction */
-				else
-					nextpc = seqlast->pc + (seqlast->skipslots + 1) * 4;
-
-				/* count off cycles and go there */
-				generate_update_cycles(block, &compiler, nextpc, TRUE);          // <subtract cycles>
-
-				/* if the last instruction can change modes, use a variable mode; otherwise, assume the same mode */
-				if (seqlast->flags & OPFLAG_CAN_CHANGE_MODES)
-					UML_HASHJMP(block, mem(&m_core->mode), nextpc, *m_nocode);
-																							// hashjmp <mode>,nextpc,nocode
-				else if (seqlast->next() == NULL || seqlast->next()->pc != nextpc)
-					UML_HASHJMP(block, m_core->mode, nextpc, *m_nocode);
-																							// hashjmp <mode>,nextpc,nocode
-			}
-
-			/* end the sequence */
+			/* generate the block and end it */
+			drcuml_block *block = code_generate_block(mode, pc, desclist);
 			block->end();
+			m_codetrack->add_block(mode, desclist);
 			g_profiler.stop();
 			succeeded = true;
 		}
@@ -385,6 +312,242 @@ void mips3_device::code_compile_block(UINT8 mode, offs_t pc)
 }
 
 
+/*-------------------------------------------------
+    code_generate_block - generate the UML for a
+    described block, leaving it to be ended
+-------------------------------------------------*/
+
+drcuml_block *mips3_device::code_generate_block(UINT8 mode, offs_t pc, const opcode_desc *desclist)
+{
+	drcuml_state *drcuml = m_drcuml;
+	compiler_state compiler = { 0 };
+	const opcode_desc *seqhead, *seqlast;
+	int override = FALSE;
+	drcuml_block *block;
+
+	/* start the block */
+	block = drcuml->begin_block(4096);
+
+	/* loop until we get through all instruction sequences */
+	for (seqhead = desclist; seqhead != NULL; seqhead = seqlast->next())
+	{
+		const opcode_desc *curdesc;
+		UINT32 nextpc;
+
+		/* add a code log entry */
+		if (drcuml->logging())
+			block->append_comment("-------------------------");                     // comment
+
+		/* determine the last instruction in this sequence */
+		for (seqlast = seqhead; seqlast != NULL; seqlast = seqlast->next())
+			if (seqlast->flags & OPFLAG_END_SEQUENCE)
+				break;
+		assert(seqlast != NULL);
+
+		/* if we don't have a hash for this mode/pc, or if we are overriding all, add one */
+		if (override || !drcuml->hash_exists(mode, seqhead->pc))
+			UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
+
+		/* if we already have a hash, and this is the first sequence, assume that we */
+		/* are recompiling due to being out of sync and allow future overrides */
+		else if (seqhead == desclist)
+		{
+			override = TRUE;
+			UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
+		}
+
+		/* otherwise, redispatch to that fixed PC and skip the rest of the processing */
+		else
+		{
+			UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+			UML_HASHJMP(block, m_core->mode, seqhead->pc, *m_nocode);
+																					// hashjmp <mode>,seqhead->pc,nocode
+			continue;
+		}
+
+		/* validate this code block if we're not pointing into ROM */
+		if (m_program->get_write_ptr(seqhead->physpc) != NULL)
+			generate_checksum_block(block, &compiler, seqhead, seqlast);
+
+		/* label this instruction, if it may be jumped to locally */
+		if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
+			UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+
+		/* iterate over instructions in the sequence and compile them */
+		for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+			generate_sequence_instruction(block, &compiler, curdesc);
+
+		/* if we need to return to the start, do it */
+		if (seqlast->flags & OPFLAG_RETURN_TO_START)
+			nextpc = pc;
+
+		/* otherwise we just go to the next instruction */
+		else
+			nextpc = seqlast->pc + (seqlast->skipslots + 1) * 4;
+
+		/* count off cycles and go there */
+		generate_update_cycles(block, &compiler, nextpc, TRUE);          // <subtract cycles>
+
+		/* if the last instruction can change modes, use a variable mode; otherwise, assume the same mode */
+		if (seqlast->flags & OPFLAG_CAN_CHANGE_MODES)
+			UML_HASHJMP(block, mem(&m_core->mode), nextpc, *m_nocode);
+																					// hashjmp <mode>,nextpc,nocode
+		else if (seqlast->next() == NULL || seqlast->next()->pc != nextpc)
+			UML_HASHJMP(block, m_core->mode, nextpc, *m_nocode);
+																					// hashjmp <mode>,nextpc,nocode
+	}
+	return block;
+}
+
+
+/*-------------------------------------------------
+    code_is_hot - count a miss at the given mode
+    and pc, and return true once it has missed
+    often enough to be worth compiling
+-------------------------------------------------*/
+
+bool mips3_device::code_is_hot(UINT8 mode, offs_t pc)
+{
+	UINT8 &count = m_hotness[((pc >> 2) ^ (mode << 9)) & (COMPILE_HOTNESS_SIZE - 1)];
+	if (++count < COMPILE_HOT_THRESHOLD)
+		return false;
+	count = 0;
+	return true;
+}
+
+
+/*-------------------------------------------------
+    code_compile_background - describe a block and
+    generate its UML here, then hand the backend
+    work to the compile thread
+-------------------------------------------------*/
+
+void mips3_device::code_compile_background(UINT8 mode, offs_t pc)
+{
+	drcuml_state *drcuml = m_drcuml;
+
+	/* describing reads guest memory and the TLB, and generating the UML reads */
+	/* the TLB and mode, so both happen here while nothing else is running */
+	g_profiler.start(PROFILER_DRC_COMPILE);
+	const opcode_desc *desclist = m_drcfe->describe_code(pc);
+	if (drcuml->logging() || drcuml->logging_native())
+		log_opcode_desc(drcuml, desclist, 0);
+
+	try
+	{
+		m_compile_block = code_generate_block(mode, pc, desclist);
+	}
+	catch (drcuml_block::abort_compilation &)
+	{
+		g_profiler.stop();
+		code_flush_cache();
+		code_compile_block(mode, pc);
+		return;
+	}
+	g_profiler.stop();
+
+	/* the compile thread owns the cache, hash tables and code tracker until */
+	/* code_compile_wait; generated code must not run before then */
+	m_compile_mode = mode;
+	m_compile_desclist = desclist;
+	m_compile_failed = false;
+	m_compile_item = osd_work_item_queue(m_compile_queue, compile_block_callback, this, 0);
+	if (m_compile_item == NULL)
+	{
+		compile_block_callback(this, 0);
+		code_compile_wait();
+	}
+}
+
+
+/*-------------------------------------------------
+    compile_block_callback - optimize the pending
+    block and generate its native code; runs on
+    the compile thread
+-------------------------------------------------*/
+
+void *mips3_device::compile_block_callback(void *param, int threadid)
+{
+	mips3_device *mips3 = (mips3_device *)param;
+	try
+	{
+		mips3->m_compile_block->end();
+		mips3->m_codetrack->add_block(mips3->m_compile_mode, mips3->m_compile_desclist);
+	}
+	catch (drcuml_block::abort_compilation &)
+	{
+		mips3->m_compile_failed = true;
+	}
+	return NULL;
+}
+
+
+/*-------------------------------------------------
+    code_compile_wait - wait for any background
+    compile and take back the cache, applying
+    code writes made while it was pending
+-------------------------------------------------*/
+
+void mips3_device::code_compile_wait()
+{
+	if (m_compile_item != NULL)
+	{
+		osd_work_item_wait(m_compile_item, 100 * osd_ticks_per_second());
+		osd_work_item_release(m_compile_item);
+		m_compile_item = NULL;
+	}
+
+	/* a full cache or too many writes to track start everything afresh */
+	if (m_compile_failed || m_interp_written.size() > COMPILE_MAX_PENDING_WRITES)
+		code_flush_cache();
+	else
+		for (int pagenum = 0; pagenum < m_interp_written.size(); pagenum++)
+			m_codetrack->write(m_interp_written[pagenum] << m_codetrack->page_shift(), 1 << m_codetrack->page_shift());
+	m_compile_failed = false;
+	m_interp_written.clear();
+}
+
+
+/*-------------------------------------------------
+    code_interpret - run the interpreter as the
+    cold tier, until the timeslice ends if a
+    compile is pending and briefly otherwise
+-------------------------------------------------*/
+
+void mips3_device::code_interpret()
+{
+	m_interp_tracking = true;
+	interpret((m_compile_item != NULL) ? 0 : MAX(m_core->icount - COMPILE_COLD_CYCLES, 0));
+	m_interp_tracking = false;
+
+	/* the interpreter does not keep the mode up to date; see generate_update_mode */
+	UINT32 sr = m_core->cpr[0][COP0_Status];
+	UINT8 mode = (sr & (SR_EXL | SR_ERL)) ? 0 : ((sr >> 2) & 0x06);
+	m_core->mode = mode | ((sr >> 26) & 0x01);
+}
+
+
+/*-------------------------------------------------
+    code_written_interpreted - note a store by the
+    cold tier, which must invalidate translated
+    code the same way the DRC's own stores do
+-------------------------------------------------*/
+
+void mips3_device::code_written_interpreted(offs_t physaddr, int size)
+{
+	/* while a compile is pending the tracker belongs to it, so just remember the page */
+	if (m_compile_item != NULL)
+	{
+		UINT32 page = physaddr >> m_codetrack->page_shift();
+		if (m_interp_written.empty() || m_interp_written.back() != page)
+			if (m_interp_written.size() <= COMPILE_MAX_PENDING_WRITES)
+				m_interp_written.push_back(page);
+	}
+	else if (m_codetrack->page_has_code(physaddr))
+		m_codetrack->write(physaddr, size);
+}
+
+
 
 /***************************************************************************
     C FUNCTION CALLBACKS
@@ -436,6 +599,22 @@ static void cfunc_get_cycles(void *param)
 }
 
 
+/*-------------------------------------------------
+    cfunc_code_written - invalidate any blocks
+    translated from the memory just written
+-------------------------------------------------*/
+
+void mips3_device::func_code_written()
+{
+	m_codetrack->write(m_core->arg0, m_core->arg1);
+}
+
+static void cfunc_code_written(void *param)
+{
+	((mips3_device *)param)->func_code_written();
+}
+
+
 /*-------------------------------------------------
     cfunc_printf_exception - log any exceptions that
     aren't interrupts
@@ -844,6 +1023,20 @@ void mips3_device::static_generate_memory_accessor(int mode, int size, int iswri
 	UML_JMPc(block, COND_Z, tlbmiss = label++);                                     // jmp     tlbmiss,z
 	UML_ROLINS(block, I0, I3, 0, 0xfffff000);                   // rolins  i0,i3,0,0xfffff000
 
+	/* writes to pages holding translated code invalidate the blocks they touch */
+	if (iswrite)
+	{
+		UINT32 nocode = label++;
+		UML_SHR(block, I3, I0, m_codetrack->page_shift());                          // shr     i3,i0,pageshift
+		UML_LOAD(block, I3, (void *)m_codetrack->pages(), I3, SIZE_BYTE, SCALE_x1);  // load    i3,[pages],i3,byte
+		UML_TEST(block, I3, I3);                                                    // test    i3,i3
+		UML_JMPc(block, COND_Z, nocode);                                            // jz      nocode
+		UML_MOV(block, mem(&m_core->arg0), I0);                                     // mov     [arg0],i0
+		UML_MOV(block, mem(&m_core->arg1), size);                                   // mov     [arg1],size
+		UML_CALLC(block, cfunc_code_written, this);                                 // callc   cfunc_code_written
+		UML_LABEL(block, nocode);                                                   // nocode:
+	}
+
 	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) == 0)
 		for (ramnum = 0; ramnum < MIPS3_MAX_FASTRAM; ramnum++)
 			if (m_fastram[ramnum].base != NULL && (!iswrite || !m_fastram[ramnum].readonly))
@@ -234,6 +234,7 @@ public:
 	void ppc_cfunc_printf_debug();
 	void ppc_cfunc_printf_probe();
 	void ppc_cfunc_unimplemented();
+	void ppc_cfunc_code_written();
 	void ppccom_tlb_fill();
 	void ppccom_update_fprf();
 	void ppccom_dcstore_callback();
@@ -328,6 +329,7 @@ protected:
 		UINT32       swcount;                    /* counter for sw instructions */
 		const char * format;                     /* format string for printing */
 		UINT32       arg0;                       /* print_debug argument 1 */
+		UINT32       writesize;                  /* size of a write to a page holding code */
 		double       fp0;                        /* floating point 0 */
 	};
 
@@ -542,6 +544,7 @@ protected:
 	drc_cache           m_cache;                      /* pointer to the DRC code cache */
 	drcuml_state *      m_drcuml;                     /* DRC UML generator state */
 	ppc_frontend *      m_drcfe;                      /* pointer to the DRC front-end state */
+	drc_code_tracker *  m_codetrack;                  /* tracker for pages holding translated code */
 	UINT32              m_drcoptions;                 /* configurable DRC options */
 
 	/* parameters for subroutines */
@@ -220,6 +220,7 @@ ppc_device::ppc_device(const machine_config &mconfig, device_type type, const ch
 	, m_cache(CACHE_SIZE + sizeof(internal_ppc_state))
 	, m_drcuml(NULL)
 	, m_drcfe(NULL)
+	, m_codetrack(NULL)
 	, m_drcoptions(0)
 {
 	m_program_config.m_logaddr_width = 32;
@@ -930,6 +931,9 @@ void ppc_device::device_start()
 	/* initialize the front-end helper */
 	m_drcfe = auto_alloc(machine(), ppc_frontend(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE));
 
+	/* track which physical pages hold translated code */
+	m_codetrack = auto_alloc(machine(), drc_code_tracker(*m_drcuml, 32));
+
 	/* compute the register parameters */
 	for (int regnum = 0; regnum < 32; regnum++)
 	{
@@ -1154,6 +1158,7 @@ void ppc_device::device_stop()
 
 	/* clean up the DRC */
 	auto_free(machine(), m_drcfe);
+	auto_free(machine(), m_codetrack);
 	auto_free(machine(), m_drcuml);
 }
 
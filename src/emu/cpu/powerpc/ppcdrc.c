@@ -289,6 +289,7 @@ void ppc_device::code_flush_cache()
 {
 	/* empty the transient cache contents */
 	m_drcuml->reset();
+	m_codetrack->reset();
 
 	try
 	{
@@ -448,6 +449,7 @@ void ppc_device::code_compile_block(UINT8 mode, offs_t pc)
 
 			/* end the sequence */
 			block->end();
+			m_codetrack->add_block(mode, desclist);
 			g_profiler.stop();
 			succeeded = true;
 		}
@@ -550,6 +552,22 @@ void ppc_device::ppc_cfunc_unimplemented()
 	fatalerror("PC=%08X: Unimplemented op %08X\n", m_core->pc, opcode);
 }
 
+/*-------------------------------------------------
+    cfunc_code_written - invalidate any blocks
+    translated from the memory just written
+-------------------------------------------------*/
+
+static void cfunc_code_written(void *param)
+{
+	ppc_device *ppc = (ppc_device *)param;
+	ppc->ppc_cfunc_code_written();
+}
+
+void ppc_device::ppc_cfunc_code_written()
+{
+	m_codetrack->write(m_core->arg0, m_core->writesize);
+}
+
 static void cfunc_ppccom_tlb_fill(void *param)
 {
 	ppc_device *ppc = (ppc_device *)param;
@@ -1029,6 +1047,21 @@ void ppc_device::static_generate_memory_accessor(int mode, int size, int iswrite
 	}
 	else if (m_cap & PPCCAP_4XX)
 		UML_AND(block, I0, I0, 0x7fffffff);                                 // and     i0,i0,0x7fffffff
+
+	/* writes to pages holding translated code invalidate the blocks they touch */
+	if (iswrite)
+	{
+		UINT32 nocode = label++;
+		UML_SHR(block, I3, I0, m_codetrack->page_shift());                          // shr     i3,i0,pageshift
+		UML_LOAD(block, I3, (void *)m_codetrack->pages(), I3, SIZE_BYTE, SCALE_x1);  // load    i3,[pages],i3,byte
+		UML_TEST(block, I3, I3);                                                    // test    i3,i3
+		UML_JMPc(block, COND_Z, nocode);                                            // jz      nocode
+		UML_MOV(block, mem(&m_core->arg0), I0);                                     // mov     [arg0],i0
+		UML_MOV(block, mem(&m_core->writesize), size);                              // mov     [writesize],size
+		UML_CALLC(block, cfunc_code_written, this);                                 // callc   cfunc_code_written
+		UML_LABEL(block, nocode);                                                   // nocode:
+	}
+
 	UML_XOR(block, I0, I0, (mode & MODE_LITTLE_ENDIAN) ? (8 - size) : 0);   // xor     i0,i0,8-size
 
 	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
@@ -696,6 +696,7 @@ rsp_cop2::rsp_cop2(rsp_device &rsp, running_machine &machine)
 	, m_reciprocal_res(0)
 	, m_reciprocal_high(0)
 	, m_dp_allowed(0)
+	, m_vmac(&rsp_vmac_select())
 {
 	memset(m_vres, 0, sizeof(m_vres));
 	memset(m_v, 0, sizeof(m_v));
@@ -1631,6 +1632,18 @@ UINT16 rsp_cop2::SATURATE_ACCUM(int accum, int slice, UINT16 negative, UINT16 po
     Vector Opcodes
 ***************************************************************************/
 
+#if !USE_SIMD
+// runs one of the multiply/accumulate kernels picked for this host on the
+// operands of a vector opcode
+void rsp_cop2::vmac_op(UINT32 op, rsp_vmac_func func)
+{
+	UINT16 vt[8];
+	for (int i = 0; i < 8; i++)
+		vt[i] = VREG_S(VS2REG, VEC_EL_2(EL, i));
+	(*func)(m_v[VDREG].s, m_v[VS1REG].s, vt, &m_accum[0].q);
+}
+#endif
+
 void rsp_cop2::handle_vector_ops(UINT32 op)
 {
 #if !USE_SIMD
@@ -1668,30 +1681,7 @@ void rsp_cop2::handle_vector_ops(UINT32 op)
 			write_acc_mid(acc, acc_mid);
 			write_acc_hi(acc, acc_hi);
 #else
-			for (i=0; i < 8; i++)
-			{
-				INT32 s1 = (INT32)(INT16)VREG_S(VS1REG, i);
-				INT32 s2 = (INT32)(INT16)VREG_S(VS2REG, VEC_EL_2(EL, i));
-
-				if (s1 == -32768 && s2 == -32768)
-				{
-					// overflow
-					SET_ACCUM_H(0, i);
-					SET_ACCUM_M(-32768, i);
-					SET_ACCUM_L(-32768, i);
-					m_vres[i] = 0x7fff;
-				}
-				else
-				{
-					INT64 r =  s1 * s2 * 2;
-					r += 0x8000;    // rounding ?
-					SET_ACCUM_H((r < 0) ? 0xffff : 0, i);      // sign-extend to 48-bit
-					SET_ACCUM_M((INT16)(r >> 16), i);
-					SET_ACCUM_L((UINT16)(r), i);
-					m_vres[i] = ACCUM_M(i);
-				}
-			}
-			WRITEBACK_RESULT();
+			vmac_op(op, m_vmac->vmulf);
 #endif
 			//
 			break;
@@ -1720,32 +1710,7 @@ void rsp_cop2::handle_vector_ops(UINT32 op)
 			write_acc_mid(acc, acc_mid);
 			write_acc_hi(acc, acc_hi);
 #else
-			for (i=0; i < 8; i++)
-			{
-				INT32 s1 = (INT32)(INT16)VREG_S(VS1REG, i);
-				INT32 s2 = (INT32)(INT16)VREG_S(VS2REG, VEC_EL_2(EL, i));
-
-				INT64 r = s1 * s2 * 2;
-				r += 0x8000;    // rounding ?
-
-				SET_ACCUM_H((UINT16)(r >> 32), i);
-				SET_ACCUM_M((UINT16)(r >> 16), i);
-				SET_ACCUM_L((UINT16)(r), i);
-
-				if (r < 0)
-				{
-					m_vres[i] = 0;
-				}
-				else if (((INT16)(ACCUM_H(i)) ^ (INT16)(ACCUM_M(i))) < 0)
-				{
-					m_vres[i] = -1;
-				}
-				else
-				{
-					m_vres[i] = ACCUM_M(i);
-				}
-			}
-			WRITEBACK_RESULT();
+			vmac_op(op, m_vmac->vmulu);
 #endif
 			//
 			break;
@@ -1780,19 +1745,7 @@ void rsp_cop2::handle_vector_ops(UINT32 op)
 			write_acc_mid(acc, acc_mid);
 			write_acc_hi(acc, acc_hi);
 #else
-			for (i=0; i < 8; i++)
-			{
-				UINT32 s1 = (UINT32)(UINT16)VREG_S(VS1REG, i);
-				UINT32 s2 = (UINT32)(UINT16)VREG_S(VS2REG, VEC_EL_2(EL, i));
-				UINT32 r = s1 * s2;
-
-				SET_ACCUM_H(0, i);
-				SET_ACCUM_M(0, i);
-				SET_ACCUM_L((UINT16)(r >> 16), i);
-
-				m_vres[i] = ACCUM_L(i);
-			}
-			WRITEBACK_RESULT();
+			vmac_op(op, m_vmac->vmudl);
 #endif
 			//
 			break;
@@ -1827,19 +1780,7 @@ void rsp_cop2::handle_vector_ops(UINT32 op)
 			write_acc_mid(acc, acc_mid);
 			write_acc_hi(acc, acc_hi);
 #else
-			for (i=0; i < 8; i++)
-			{
-				INT32 s1 = (INT32)(INT16)VREG_S(VS1REG, i);
-				INT32 s2 = (UINT16)VREG_S(VS2REG, VEC_EL_2(EL, i));   // not sign-extended
-				INT32 r =  s1 * s2;
-
-				SET_ACCUM_H((r < 0) ? 0xffff : 0, i);      // sign-extend to 48-bit
-				SET_ACCUM_M((INT16)(r >> 16), i);
-				SET_ACCUM_L((UINT16)(r), i);
-
-				m_vres[i] = ACCUM_M(i);
-			}
-			WRITEBACK_RESULT();
+			vmac_op(op, m_vmac->vmudm);
 #endif
 			//
 			break;
@@ -1873,19 +1814,7 @@ void rsp_cop2::handle_vector_ops(UINT32 op)
 			write_acc_mid(acc, acc_mid);
 			write_acc_hi(acc, acc_hi);
 #else
-			for (i=0; i < 8; i++)
-			{
-				INT32 s1 = (UINT16)VREG_S(VS1REG, i);     // not sign-extended
-				INT32 s2 = (INT32)(INT16)VREG_S(VS2REG, VEC_EL_2(EL, i));
-				INT32 r = s1 * s2;
-
-				SET_ACCUM_H((r < 0) ? 0xffff : 0, i);      // sign-extend to 48-bit
-				SET_ACCUM_M((INT16)(r >> 16), i);
-				SET_ACCUM_L((UINT16)(r), i);
-
-				m_vres[i] = ACCUM_L(i);
-			}
-			WRITEBACK_RESULT();
+			vmac_op(op, m_vmac->vmudn);
 #endif
 			//
 			break;
@@ -1920,21 +1849,7 @@ void rsp_cop2::handle_vector_ops(UINT32 op)
 			write_acc_mid(acc, acc_mid);
 			write_acc_hi(acc, acc_hi);
 #else
-			for (i=0; i < 8; i++)
-			{
-				INT32 s1 = (INT32)(INT16)VREG_S(VS1REG, i);
-				INT32 s2 = (INT32)(INT16)VREG_S(VS2REG, VEC_EL_2(EL, i));
-				INT32 r = s1 * s2;
-
-				SET_ACCUM_H((INT16)(r >> 16), i);
-				SET_ACCUM_M((UINT16)(r), i);
-				SET_ACCUM_L(0, i);
-
-				if (r < -32768) r = -32768;
-				if (r >  32767) r = 32767;
-				m_vres[i] = (INT16)(r);
-			}
-			WRITEBACK_RESULT();
+			vmac_op(op, m_vmac->vmudh);
 #endif
 			//
 			break;
@@ -1968,27 +1883,7 @@ void rsp_cop2::handle_vector_ops(UINT32 op)
 			write_acc_mid(acc, acc_mid);
 			write_acc_hi(acc, acc_hi);
 #else
-			for (i=0; i < 8; i++)
-			{
-				INT32 s1 = (INT32)(INT16)VREG_S(VS1REG, i);
-				INT32 s2 = (INT32)(INT16)VREG_S(VS2REG, VEC_EL_2(EL, i));
-				INT32 r = s1 * s2;
-
-				UINT64 q = (UINT64)(UINT16)ACCUM_LL(i);
-				q |= (((UINT64)(UINT16)ACCUM_L(i)) << 16);
-				q |= (((UINT64)(UINT16)ACCUM_M(i)) << 32);
-				q |= (((UINT64)(UINT16)ACCUM_H(i)) << 48);
-
-				q += (INT64)(r) << 17;
-
-				SET_ACCUM_LL((UINT16)q, i);
-				SET_ACCUM_L((UINT16)(q >> 16), i);
-				SET_ACCUM_M((UINT16)(q >> 32), i);
-				SET_ACCUM_H((UINT16)(q >> 48), i);
-
-				m_vres[i] = SATURATE_ACCUM(i, 1, 0x8000, 0x7fff);
-			}
-			WRITEBACK_RESULT();
+			vmac_op(op, m_vmac->vmacf);
 #endif
 			//
 			break;
@@ -2019,42 +1914,7 @@ void rsp_cop2::handle_vector_ops(UINT32 op)
 			write_acc_mid(acc, acc_mid);
 			write_acc_hi(acc, acc_hi);
 #else
-			for (i = 0; i < 8; i++)
-			{
-				INT32 s1 = (INT32)(INT16)VREG_S(VS1REG, i);
-				INT32 s2 = (INT32)(INT16)VREG_S(VS2REG, VEC_EL_2(EL, i));
-				INT32 r1 = s1 * s2;
-				UINT32 r2 = (UINT16)ACCUM_L(i) + ((UINT16)(r1) * 2);
-				UINT32 r3 = (UINT16)ACCUM_M(i) + (UINT16)((r1 >> 16) * 2) + (UINT16)(r2 >> 16);
-
-				SET_ACCUM_L((UINT16)(r2), i);
-				SET_ACCUM_M((UINT16)(r3), i);
-				SET_ACCUM_H(ACCUM_H(i) + (UINT16)(r3 >> 16) + (UINT16)(r1 >> 31), i);
-
-				if ((INT16)ACCUM_H(i) < 0)
-				{
-					m_vres[i] = 0;
-				}
-				else
-				{
-					if (ACCUM_H(i) != 0)
-					{
-						m_vres[i] = 0xffff;
-					}
-					else
-					{
-						if ((INT16)ACCUM_M(i) < 0)
-						{
-							m_vres[i] = 0xffff;
-						}
-						else
-						{
-							m_vres[i] = ACCUM_M(i);
-						}
-					}
-				}
-			}
-			WRITEBACK_RESULT();
+			vmac_op(op, m_vmac->vmacu);
 #endif
 			//
 			break;
@@ -2089,21 +1949,7 @@ void rsp_cop2::handle_vector_ops(UINT32 op)
 			write_acc_mid(acc, acc_mid);
 			write_acc_hi(acc, acc_hi);
 #else
-			for (i = 0; i < 8; i++)
-			{
-				UINT32 s1 = (UINT32)(UINT16)VREG_S(VS1REG, i);
-				UINT32 s2 = (UINT32)(UINT16)VREG_S(VS2REG, VEC_EL_2(EL, i));
-				UINT32 r1 = s1 * s2;
-				UINT32 r2 = (UINT16)ACCUM_L(i) + (r1 >> 16);
-				UINT32 r3 = (UINT16)ACCUM_M(i) + (r2 >> 16);
-
-				SET_ACCUM_L((UINT16)(r2), i);
-				SET_ACCUM_M((UINT16)(r3), i);
-				SET_ACCUM_H(ACCUM_H(i) + (INT16)(r3 >> 16), i);
-
-				m_vres[i] = SATURATE_ACCUM(i, 0, 0x0000, 0xffff);
-			}
-			WRITEBACK_RESULT();
+			vmac_op(op, m_vmac->vmadl);
 #endif
 			//
 			break;
@@ -2138,23 +1984,7 @@ void rsp_cop2::handle_vector_ops(UINT32 op)
 			write_acc_mid(acc, acc_mid);
 			write_acc_hi(acc, acc_hi);
 #else
-			for (i=0; i < 8; i++)
-			{
-				UINT32 s1 = (INT32)(INT16)VREG_S(VS1REG, i);
-				UINT32 s2 = (UINT16)VREG_S(VS2REG, VEC_EL_2(EL, i));   // not sign-extended
-				UINT32 r1 = s1 * s2;
-				UINT32 r2 = (UINT16)ACCUM_L(i) + (UINT16)(r1);
-				UINT32 r3 = (UINT16)ACCUM_M(i) + (r1 >> 16) + (r2 >> 16);
-
-				SET_ACCUM_L((UINT16)(r2), i);
-				SET_ACCUM_M((UINT16)(r3), i);
-				SET_ACCUM_H(ACCUM_H(i) + (UINT16)(r3 >> 16), i);
-				if ((INT32)(r1) < 0)
-					SET_ACCUM_H(ACCUM_H(i) - 1, i);
-
-				m_vres[i] = SATURATE_ACCUM(i, 1, 0x8000, 0x7fff);
-			}
-			WRITEBACK_RESULT();
+			vmac_op(op, m_vmac->vmadm);
 #endif
 			//
 			break;
@@ -2189,26 +2019,7 @@ void rsp_cop2::handle_vector_ops(UINT32 op)
 			write_acc_mid(acc, acc_mid);
 			write_acc_hi(acc, acc_hi);
 #else
-			for (i=0; i < 8; i++)
-			{
-				INT32 s1 = (UINT16)VREG_S(VS1REG, i);     // not sign-extended
-				INT32 s2 = (INT32)(INT16)VREG_S(VS2REG, VEC_EL_2(EL, i));
-
-				UINT64 q = (UINT64)ACCUM_LL(i);
-				q |= (((UINT64)ACCUM_L(i)) << 16);
-				q |= (((UINT64)ACCUM_M(i)) << 32);
-				q |= (((UINT64)ACCUM_H(i)) << 48);
-				q += (INT64)(s1*s2) << 16;
-
-				SET_ACCUM_LL((UINT16)q, i);
-				SET_ACCUM_L((UINT16)(q >> 16), i);
-				SET_ACCUM_M((UINT16)(q >> 32), i);
-				SET_ACCUM_H((UINT16)(q >> 48), i);
-
-				m_vres[i] = SATURATE_ACCUM(i, 0, 0x0000, 0xffff);
-			}
-			WRITEBACK_RESULT();
-
+			vmac_op(op, m_vmac->vmadn);
 #endif
 			//
 			break;
@@ -2243,22 +2054,7 @@ void rsp_cop2::handle_vector_ops(UINT32 op)
 			write_acc_mid(acc, acc_mid);
 			write_acc_hi(acc, acc_hi);
 #else
-			for (i = 0; i < 8; i++)
-			{
-				INT32 s1 = (INT32)(INT16)VREG_S(VS1REG, i);
-				INT32 s2 = (INT32)(INT16)VREG_S(VS2REG, VEC_EL_2(EL, i));
-
-				INT32 accum = (UINT32)(UINT16)ACCUM_M(i);
-				accum |= ((UINT32)((UINT16)ACCUM_H(i))) << 16;
-				accum += s1 * s2;
-
-				SET_ACCUM_H((UINT16)(accum >> 16), i);
-				SET_ACCUM_M((UINT16)accum, i);
-
-				m_vres[i] = SATURATE_ACCUM(i, 1, 0x8000, 0x7fff);
-			}
-			WRITEBACK_RESULT();
-
+			vmac_op(op, m_vmac->vmadh);
 #endif
 			//
 			break;
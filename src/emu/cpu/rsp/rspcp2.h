@@ -16,6 +16,7 @@
 #include "cpu/drcuml.h"
 #include "rsp.h"
 #include "rspdiv.h"
+#include "rspvmac.h"
 
 #define SIMD_OFF        (1)
 
@@ -199,6 +200,8 @@ protected:
 	UINT32          m_reciprocal_high;
 	INT32           m_dp_allowed;
 
+	const rsp_vmac_ops *m_vmac;         /* multiply/accumulate kernels chosen for this host */
+
 #if USE_SIMD
 	enum rsp_flags_t {
 		RSP_VCO = 0,
@@ -388,6 +391,7 @@ private:
 	void            handle_lwc2(UINT32 op);
 	void            handle_swc2(UINT32 op);
 	void            handle_vector_ops(UINT32 op);
+	void            vmac_op(UINT32 op, rsp_vmac_func func);
 
 	UINT32          m_div_in;
 	UINT32          m_div_out;
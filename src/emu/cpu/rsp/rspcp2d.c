@@ -67,6 +67,7 @@ static void cfunc_ctc2(void *param);
 
 #define GET_VS1(out, i)         out = VREG_S(vs1reg, i)
 #define GET_VS2(out, i)         out = VREG_S(vs2reg, VEC_EL_2(el, i))
+#define SHUFFLE_VS2(out)        for (int i = 0; i < 8; i++) out[i] = m_v[vs2reg].s[VEC_EL_2(el, i)]
 
 #define CARRY_FLAG(x)          (m_vflag[CARRY][x & 7] != 0 ? 0xffff : 0)
 #define COMPARE_FLAG(x)        (m_vflag[COMPARE][x & 7] != 0 ? 0xffff : 0)
@@ -1354,27 +1355,9 @@ void rsp_cop2_drc::vmulf()
 {
 	CACHE_VALUES();
 
-	for (int i = 0; i < 8; i++)
-	{
-		UINT16 w1, w2;
-		GET_VS1(w1, i);
-		GET_VS2(w2, i);
-		INT32 s1 = (INT32)(INT16)w1;
-		INT32 s2 = (INT32)(INT16)w2;
-
-		if (s1 == -32768 && s2 == -32768)
-		{
-			// overflow
-			ACCUM(i) = S64(0x0000800080000000);
-			m_vres[i] = 0x7fff;
-		}
-		else
-		{
-			ACCUM(i) = (INT64)(s1 * s2 * 2 + 0x8000) << 16; // rounding?
-			m_vres[i] = ACCUM_M(i);
-		}
-	}
-	WRITEBACK_RESULT();
+	UINT16 vt[8];
+	SHUFFLE_VS2(vt);
+	m_vmac->vmulf(m_v[vdreg].s, m_v[vs1reg].s, vt, &m_accum[0].q);
 }
 
 static void cfunc_vmulf(void *param)
@@ -1395,32 +1378,9 @@ void rsp_cop2_drc::vmulu()
 {
 	CACHE_VALUES();
 
-	for (int i = 0; i < 8; i++)
-	{
-		UINT16 w1, w2;
-		GET_VS1(w1, i);
-		GET_VS2(w2, i);
-		INT32 s1 = (INT32)(INT16)w1;
-		INT32 s2 = (INT32)(INT16)w2;
-
-		INT64 r = s1 * s2 * 2 + 0x8000; // rounding?
-
-		ACCUM(i) = r << 16;
-
-		if (r < 0)
-		{
-			m_vres[i] = 0;
-		}
-		else if (((INT16)(ACCUM_H(i)) ^ (INT16)(ACCUM_M(i))) < 0)
-		{
-			m_vres[i] = -1;
-		}
-		else
-		{
-			m_vres[i] = ACCUM_M(i);
-		}
-	}
-	WRITEBACK_RESULT();
+	UINT16 vt[8];
+	SHUFFLE_VS2(vt);
+	m_vmac->vmulu(m_v[vdreg].s, m_v[vs1reg].s, vt, &m_accum[0].q);
 }
 
 static void cfunc_vmulu(void *param)
@@ -1444,19 +1404,9 @@ void rsp_cop2_drc::vmudl()
 {
 	CACHE_VALUES();
 
-	for (int i = 0; i < 8; i++)
-	{
-		UINT16 w1, w2;
-		GET_VS1(w1, i);
-		GET_VS2(w2, i);
-		UINT32 s1 = (UINT32)(UINT16)w1;
-		UINT32 s2 = (UINT32)(UINT16)w2;
-
-		ACCUM(i) = s1 * s2;
-
-		m_vres[i] = ACCUM_L(i);
-	}
-	WRITEBACK_RESULT();
+	UINT16 vt[8];
+	SHUFFLE_VS2(vt);
+	m_vmac->vmudl(m_v[vdreg].s, m_v[vs1reg].s, vt, &m_accum[0].q);
 }
 
 static void cfunc_vmudl(void *param)
@@ -1480,19 +1430,9 @@ void rsp_cop2_drc::vmudm()
 {
 	CACHE_VALUES();
 
-	for (int i = 0; i < 8; i++)
-	{
-		UINT16 w1, w2;
-		GET_VS1(w1, i);
-		GET_VS2(w2, i);
-		INT32 s1 = (INT32)(INT16)w1;
-		INT32 s2 = (UINT16)w2;
-
-		ACCUM(i) = (INT64)(s1 * s2) << 16;
-
-		m_vres[i] = ACCUM_M(i);
-	}
-	WRITEBACK_RESULT();
+	UINT16 vt[8];
+	SHUFFLE_VS2(vt);
+	m_vmac->vmudm(m_v[vdreg].s, m_v[vs1reg].s, vt, &m_accum[0].q);
 }
 
 static void cfunc_vmudm(void *param)
@@ -1516,21 +1456,9 @@ void rsp_cop2_drc::vmudn()
 {
 	CACHE_VALUES();
 
-	for (int i = 0; i < 8; i++)
-	{
-		UINT16 w1, w2;
-		GET_VS1(w1, i);
-		GET_VS2(w2, i);
-		INT32 s1 = (UINT16)w1;
-		INT32 s2 = (INT32)(INT16)w2;
-
-		INT32 r = s1 * s2;
-
-		ACCUM(i) = (INT64)(s1 * s2) << 16;
-
-		m_vres[i] = (UINT16)(r);
-	}
-	WRITEBACK_RESULT();
+	UINT16 vt[8];
+	SHUFFLE_VS2(vt);
+	m_vmac->vmudn(m_v[vdreg].s, m_v[vs1reg].s, vt, &m_accum[0].q);
 }
 
 static void cfunc_vmudn(void *param)
@@ -1554,23 +1482,9 @@ void rsp_cop2_drc::vmudh()
 {
 	CACHE_VALUES();
 
-	for (int i = 0; i < 8; i++)
-	{
-		UINT16 w1, w2;
-		GET_VS1(w1, i);
-		GET_VS2(w2, i);
-		INT32 s1 = (INT32)(INT16)w1;
-		INT32 s2 = (INT32)(INT16)w2;
-
-		INT32 r = s1 * s2;
-
-		ACCUM(i) = (INT64)r << 32;
-
-		if (r < -32768) r = -32768;
-		if (r >  32767) r = 32767;
-		m_vres[i] = (INT16)(r);
-	}
-	WRITEBACK_RESULT();
+	UINT16 vt[8];
+	SHUFFLE_VS2(vt);
+	m_vmac->vmudh(m_v[vdreg].s, m_v[vs1reg].s, vt, &m_accum[0].q);
 }
 
 static void cfunc_vmudh(void *param)
@@ -1591,19 +1505,9 @@ void rsp_cop2_drc::vmacf()
 {
 	CACHE_VALUES();
 
-	for (int i = 0; i < 8; i++)
-	{
-		UINT16 w1, w2;
-		GET_VS1(w1, i);
-		GET_VS2(w2, i);
-		INT32 s1 = (INT32)(INT16)w1;
-		INT32 s2 = (INT32)(INT16)w2;
-
-		ACCUM(i) += (INT64)(s1 * s2 * 2) << 16;
-
-		m_vres[i] = SATURATE_ACCUM(i, 1, 0x8000, 0x7fff);
-	}
-	WRITEBACK_RESULT();
+	UINT16 vt[8];
+	SHUFFLE_VS2(vt);
+	m_vmac->vmacf(m_v[vdreg].s, m_v[vs1reg].s, vt, &m_accum[0].q);
 }
 
 static void cfunc_vmacf(void *param)
@@ -1624,40 +1528,9 @@ void rsp_cop2_drc::vmacu()
 {
 	CACHE_VALUES();
 
-	for (int i = 0; i < 8; i++)
-	{
-		UINT16 w1, w2;
-		GET_VS1(w1, i);
-		GET_VS2(w2, i);
-		INT32 s1 = (INT32)(INT16)w1;
-		INT32 s2 = (INT32)(INT16)w2;
-
-		ACCUM(i) += (INT64)(s1 * s2 * 2) << 16;
-
-		if ((INT16)ACCUM_H(i) < 0)
-		{
-			m_vres[i] = 0;
-		}
-		else
-		{
-			if (ACCUM_H(i) != 0)
-			{
-				m_vres[i] = (INT16)0xffff;
-			}
-			else
-			{
-				if ((INT16)ACCUM_M(i) < 0)
-				{
-					m_vres[i] = (INT16)0xffff;
-				}
-				else
-				{
-					m_vres[i] = ACCUM_M(i);
-				}
-			}
-		}
-	}
-	WRITEBACK_RESULT();
+	UINT16 vt[8];
+	SHUFFLE_VS2(vt);
+	m_vmac->vmacu(m_v[vdreg].s, m_v[vs1reg].s, vt, &m_accum[0].q);
 }
 
 static void cfunc_vmacu(void *param)
@@ -1681,19 +1554,9 @@ void rsp_cop2_drc::vmadl()
 {
 	CACHE_VALUES();
 
-	for (int i = 0; i < 8; i++)
-	{
-		UINT16 w1, w2;
-		GET_VS1(w1, i);
-		GET_VS2(w2, i);
-		UINT32 s1 = w1;
-		UINT32 s2 = w2;
-
-		ACCUM(i) += (s1 * s2) & 0xffff0000;
-
-		m_vres[i] = SATURATE_ACCUM(i, 0, 0x0000, 0xffff);
-	}
-	WRITEBACK_RESULT();
+	UINT16 vt[8];
+	SHUFFLE_VS2(vt);
+	m_vmac->vmadl(m_v[vdreg].s, m_v[vs1reg].s, vt, &m_accum[0].q);
 }
 
 static void cfunc_vmadl(void *param)
@@ -1709,19 +1572,9 @@ void rsp_cop2_drc::vmadm()
 {
 	CACHE_VALUES();
 
-	for (int i = 0; i < 8; i++)
-	{
-		UINT16 w1, w2;
-		GET_VS1(w1, i);
-		GET_VS2(w2, i);
-		UINT32 s1 = (INT32)(INT16)w1;
-		UINT32 s2 = (UINT16)w2;
-
-		ACCUM(i) += (INT64)(INT32)(s1 * s2) << 16;
-
-		m_vres[i] = SATURATE_ACCUM(i, 1, 0x8000, 0x7fff);
-	}
-	WRITEBACK_RESULT();
+	UINT16 vt[8];
+	SHUFFLE_VS2(vt);
+	m_vmac->vmadm(m_v[vdreg].s, m_v[vs1reg].s, vt, &m_accum[0].q);
 }
 
 static void cfunc_vmadm(void *param)
@@ -1737,19 +1590,9 @@ void rsp_cop2_drc::vmadn()
 {
 	CACHE_VALUES();
 
-	for (int i = 0; i < 8; i++)
-	{
-		UINT16 w1, w2;
-		GET_VS1(w1, i);
-		GET_VS2(w2, i);
-		INT32 s1 = (UINT16)w1;
-		INT32 s2 = (INT32)(INT16)w2;
-
-		ACCUM(i) += (INT64)(s1 * s2) << 16;
-
-		m_vres[i] = SATURATE_ACCUM(i, 0, 0x0000, 0xffff);
-	}
-	WRITEBACK_RESULT();
+	UINT16 vt[8];
+	SHUFFLE_VS2(vt);
+	m_vmac->vmadn(m_v[vdreg].s, m_v[vs1reg].s, vt, &m_accum[0].q);
 }
 
 static void cfunc_vmadn(void *param)
@@ -1773,19 +1616,9 @@ void rsp_cop2_drc::vmadh()
 {
 	CACHE_VALUES();
 
-	for (int i = 0; i < 8; i++)
-	{
-		INT16 w1, w2;
-		GET_VS1(w1, i);
-		GET_VS2(w2, i);
-		INT32 s1 = (INT32)(INT16)w1;
-		INT32 s2 = (INT32)(INT16)w2;
-
-		ACCUM(i) += (INT64)(s1 * s2) << 32;
-
-		m_vres[i] = SATURATE_ACCUM(i, 1, 0x8000, 0x7fff);
-	}
-	WRITEBACK_RESULT();
+	UINT16 vt[8];
+	SHUFFLE_VS2(vt);
+	m_vmac->vmadh(m_v[vdreg].s, m_v[vs1reg].s, vt, &m_accum[0].q);
 }
 
 static void cfunc_vmadh(void *param)
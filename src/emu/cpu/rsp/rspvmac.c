@@ -0,0 +1,357 @@
+// license:BSD-3-Clause
+// copyright-holders:Ryan Holtz,Tyler J. Stachecki
+/***************************************************************************
+
+    rspvmac.c
+
+    Reality Signal Processor (RSP) vector multiply and multiply-accumulate
+    kernels.
+
+    The scalar kernels are the reference implementation; the SSE2 and
+    SSE4.1 kernels (rspvmac.inc) keep the accumulator split into
+    low/middle/high 16-bit planes while they work and must produce
+    bit-identical results. They are always built on x86 and only run
+    once CPUID says the host supports them.
+
+***************************************************************************/
+
+#include "rspvmac.h"
+
+#if RSP_VMAC_X86
+#include <emmintrin.h>
+#include <smmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define RSP_VMAC_TARGET(isa)
+#else
+#include <cpuid.h>
+#define RSP_VMAC_TARGET(isa)    __attribute__((target(isa)))
+#endif
+#endif
+
+
+//**************************************************************************
+//  SCALAR KERNELS
+//**************************************************************************
+
+// accumulator lane as laid out by rsp_cop2
+union rsp_vmac_accum
+{
+	UINT64 q;
+	UINT16 w[4];
+};
+
+#define ACCUM(x)        ((rsp_vmac_accum *)acc)[x].q
+#define ACCUM_H(x)      (UINT16)((rsp_vmac_accum *)acc)[x].w[3]
+#define ACCUM_M(x)      (UINT16)((rsp_vmac_accum *)acc)[x].w[2]
+#define ACCUM_L(x)      (UINT16)((rsp_vmac_accum *)acc)[x].w[1]
+
+
+//-------------------------------------------------
+//  saturate_accum - clamp the accumulator to 16
+//  bits, returning the low (slice 0) or middle
+//  (slice 1) part when it fits
+//-------------------------------------------------
+
+static inline UINT16 saturate_accum(const UINT64 *acc, int i, int slice, UINT16 negative, UINT16 positive)
+{
+	if ((INT16)ACCUM_H(i) < 0)
+	{
+		if (ACCUM_H(i) != 0xffff || (INT16)ACCUM_M(i) >= 0)
+			return negative;
+	}
+	else
+	{
+		if (ACCUM_H(i) != 0 || (INT16)ACCUM_M(i) < 0)
+			return positive;
+	}
+	return (slice == 0) ? ACCUM_L(i) : ACCUM_M(i);
+}
+
+static void scalar_vmulf(UINT16 *vd, const UINT16 *vs, const UINT16 *vt, UINT64 *acc)
+{
+	for (int i = 0; i < 8; i++)
+	{
+		INT32 s1 = (INT16)vs[i];
+		INT32 s2 = (INT16)vt[i];
+
+		if (s1 == -32768 && s2 == -32768)
+		{
+			// overflow
+			ACCUM(i) = S64(0x0000800080000000);
+			vd[i] = 0x7fff;
+		}
+		else
+		{
+			ACCUM(i) = (INT64)(s1 * s2 * 2 + 0x8000) << 16;
+			vd[i] = ACCUM_M(i);
+		}
+	}
+}
+
+static void scalar_vmulu(UINT16 *vd, const UINT16 *vs, const UINT16 *vt, UINT64 *acc)
+{
+	for (int i = 0; i < 8; i++)
+	{
+		INT32 s1 = (INT16)vs[i];
+		INT32 s2 = (INT16)vt[i];
+		INT64 r = (INT64)s1 * s2 * 2 + 0x8000;
+
+		ACCUM(i) = r << 16;
+
+		if (r < 0)
+			vd[i] = 0;
+		else if (((INT16)ACCUM_H(i) ^ (INT16)ACCUM_M(i)) < 0)
+			vd[i] = 0xffff;
+		else
+			vd[i] = ACCUM_M(i);
+	}
+}
+
+static void scalar_vmudl(UINT16 *vd, const UINT16 *vs, const UINT16 *vt, UINT64 *acc)
+{
+	for (int i = 0; i < 8; i++)
+	{
+		UINT32 s1 = vs[i];
+		UINT32 s2 = vt[i];
+
+		ACCUM(i) = s1 * s2;
+		vd[i] = ACCUM_L(i);
+	}
+}
+
+static void scalar_vmudm(UINT16 *vd, const UINT16 *vs, const UINT16 *vt, UINT64 *acc)
+{
+	for (int i = 0; i < 8; i++)
+	{
+		INT32 s1 = (INT16)vs[i];
+		INT32 s2 = vt[i];
+
+		ACCUM(i) = (INT64)(s1 * s2) << 16;
+		vd[i] = ACCUM_M(i);
+	}
+}
+
+static void scalar_vmudn(UINT16 *vd, const UINT16 *vs, const UINT16 *vt, UINT64 *acc)
+{
+	for (int i = 0; i < 8; i++)
+	{
+		INT32 s1 = vs[i];
+		INT32 s2 = (INT16)vt[i];
+		INT32 r = s1 * s2;
+
+		ACCUM(i) = (INT64)r << 16;
+		vd[i] = (UINT16)r;
+	}
+}
+
+static void scalar_vmudh(UINT16 *vd, const UINT16 *vs, const UINT16 *vt, UINT64 *acc)
+{
+	for (int i = 0; i < 8; i++)
+	{
+		INT32 s1 = (INT16)vs[i];
+		INT32 s2 = (INT16)vt[i];
+		INT32 r = s1 * s2;
+
+		ACCUM(i) = (INT64)r << 32;
+		if (r < -32768) r = -32768;
+		if (r >  32767) r = 32767;
+		vd[i] = (UINT16)r;
+	}
+}
+
+static void scalar_vmacf(UINT16 *vd, const UINT16 *vs, const UINT16 *vt, UINT64 *acc)
+{
+	for (int i = 0; i < 8; i++)
+	{
+		INT32 s1 = (INT16)vs[i];
+		INT32 s2 = (INT16)vt[i];
+
+		ACCUM(i) += ((INT64)s1 * s2 * 2) << 16;
+		vd[i] = saturate_accum(acc, i, 1, 0x8000, 0x7fff);
+	}
+}
+
+static void scalar_vmacu(UINT16 *vd, const UINT16 *vs, const UINT16 *vt, UINT64 *acc)
+{
+	for (int i = 0; i < 8; i++)
+	{
+		INT32 s1 = (INT16)vs[i];
+		INT32 s2 = (INT16)vt[i];
+
+		ACCUM(i) += ((INT64)s1 * s2 * 2) << 16;
+
+		if ((INT16)ACCUM_H(i) < 0)
+			vd[i] = 0;
+		else if (ACCUM_H(i) != 0 || (INT16)ACCUM_M(i) < 0)
+			vd[i] = 0xffff;
+		else
+			vd[i] = ACCUM_M(i);
+	}
+}
+
+static void scalar_vmadl(UINT16 *vd, const UINT16 *vs, const UINT16 *vt, UINT64 *acc)
+{
+	for (int i = 0; i < 8; i++)
+	{
+		UINT32 s1 = vs[i];
+		UINT32 s2 = vt[i];
+
+		ACCUM(i) += (s1 * s2) & 0xffff0000;
+		vd[i] = saturate_accum(acc, i, 0, 0x0000, 0xffff);
+	}
+}
+
+static void scalar_vmadm(UINT16 *vd, const UINT16 *vs, const UINT16 *vt, UINT64 *acc)
+{
+	for (int i = 0; i < 8; i++)
+	{
+		UINT32 s1 = (INT32)(INT16)vs[i];
+		UINT32 s2 = vt[i];
+
+		ACCUM(i) += (INT64)(INT32)(s1 * s2) << 16;
+		vd[i] = saturate_accum(acc, i, 1, 0x8000, 0x7fff);
+	}
+}
+
+static void scalar_vmadn(UINT16 *vd, const UINT16 *vs, const UINT16 *vt, UINT64 *acc)
+{
+	for (int i = 0; i < 8; i++)
+	{
+		INT32 s1 = vs[i];
+		INT32 s2 = (INT16)vt[i];
+
+		ACCUM(i) += (INT64)(s1 * s2) << 16;
+		vd[i] = saturate_accum(acc, i, 0, 0x0000, 0xffff);
+	}
+}
+
+static void scalar_vmadh(UINT16 *vd, const UINT16 *vs, const UINT16 *vt, UINT64 *acc)
+{
+	for (int i = 0; i < 8; i++)
+	{
+		INT32 s1 = (INT16)vs[i];
+		INT32 s2 = (INT16)vt[i];
+
+		ACCUM(i) += (INT64)(s1 * s2) << 32;
+		vd[i] = saturate_accum(acc, i, 1, 0x8000, 0x7fff);
+	}
+}
+
+const rsp_vmac_ops rsp_vmac_scalar =
+{
+	"scalar",
+	scalar_vmulf, scalar_vmulu, scalar_vmudl, scalar_vmudm, scalar_vmudn, scalar_vmudh,
+	scalar_vmacf, scalar_vmacu, scalar_vmadl, scalar_vmadm, scalar_vmadn, scalar_vmadh
+};
+
+
+
+//**************************************************************************
+//  SSE KERNELS
+//**************************************************************************
+
+#if RSP_VMAC_X86
+
+namespace rsp_vmac_sse2_kernels
+{
+#define RSP_VMAC_ATTR       RSP_VMAC_TARGET("sse2")
+#define RSP_VMAC_SSE41      (0)
+#include "rspvmac.inc"
+#undef RSP_VMAC_ATTR
+#undef RSP_VMAC_SSE41
+}
+
+namespace rsp_vmac_sse41_kernels
+{
+#define RSP_VMAC_ATTR       RSP_VMAC_TARGET("sse4.1")
+#define RSP_VMAC_SSE41      (1)
+#include "rspvmac.inc"
+#undef RSP_VMAC_ATTR
+#undef RSP_VMAC_SSE41
+}
+
+#define RSP_VMAC_OPS(name, ns) \
+	{ \
+		name, \
+		ns::vmulf, ns::vmulu, ns::vmudl, ns::vmudm, ns::vmudn, ns::vmudh, \
+		ns::vmacf, ns::vmacu, ns::vmadl, ns::vmadm, ns::vmadn, ns::vmadh \
+	}
+
+const rsp_vmac_ops rsp_vmac_sse2 = RSP_VMAC_OPS("SSE2", rsp_vmac_sse2_kernels);
+const rsp_vmac_ops rsp_vmac_sse41 = RSP_VMAC_OPS("SSE4.1", rsp_vmac_sse41_kernels);
+
+#endif
+
+
+
+//**************************************************************************
+//  DISPATCH
+//**************************************************************************
+
+//-------------------------------------------------
+//  cpuid_features - return the ECX and EDX
+//  feature flags from CPUID leaf 1, or zero if
+//  the host isn't x86
+//-------------------------------------------------
+
+static void cpuid_features(UINT32 &ecx, UINT32 &edx)
+{
+	ecx = edx = 0;
+#if RSP_VMAC_X86 && defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 1);
+	ecx = info[2];
+	edx = info[3];
+#elif RSP_VMAC_X86
+	unsigned int eax, ebx, c, d;
+	if (__get_cpuid(1, &eax, &ebx, &c, &d))
+	{
+		ecx = c;
+		edx = d;
+	}
+#endif
+}
+
+
+//-------------------------------------------------
+//  rsp_vmac_sse2_supported - ask the CPU whether
+//  it implements SSE2
+//-------------------------------------------------
+
+bool rsp_vmac_sse2_supported()
+{
+	UINT32 ecx, edx;
+	cpuid_features(ecx, edx);
+	return (edx & (1 << 26)) != 0;
+}
+
+
+//-------------------------------------------------
+//  rsp_vmac_sse41_supported - ask the CPU whether
+//  it implements SSE4.1
+//-------------------------------------------------
+
+bool rsp_vmac_sse41_supported()
+{
+	UINT32 ecx, edx;
+	cpuid_features(ecx, edx);
+	return (ecx & (1 << 19)) != 0 && (edx & (1 << 26)) != 0;
+}
+
+
+//-------------------------------------------------
+//  rsp_vmac_select - pick the fastest kernels the
+//  host can run
+//-------------------------------------------------
+
+const rsp_vmac_ops &rsp_vmac_select()
+{
+#if RSP_VMAC_X86
+	if (rsp_vmac_sse41_supported())
+		return rsp_vmac_sse41;
+	if (rsp_vmac_sse2_supported())
+		return rsp_vmac_sse2;
+#endif
+	return rsp_vmac_scalar;
+}
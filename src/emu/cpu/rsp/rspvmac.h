@@ -0,0 +1,82 @@
+// license:BSD-3-Clause
+// copyright-holders:Ryan Holtz,Tyler J. Stachecki
+/***************************************************************************
+
+    rspvmac.h
+
+    Reality Signal Processor (RSP) vector multiply and multiply-accumulate
+    kernels, with a scalar reference implementation and SSE2 and SSE4.1
+    implementations selected at runtime.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __RSPVMAC_H__
+#define __RSPVMAC_H__
+
+#include "osdcomm.h"
+
+// the SSE kernels are built on any x86 host whose compiler can target an
+// instruction set per function, whatever the flags of the build itself
+#if (defined(__i386__) || defined(__x86_64__)) && (defined(__clang__) || __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define RSP_VMAC_X86    (1)
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#define RSP_VMAC_X86    (1)
+#else
+#define RSP_VMAC_X86    (0)
+#endif
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// a kernel takes the destination and first source registers, the second
+// source register already shuffled by element, and the eight accumulator
+// lanes; each lane holds the 48-bit accumulator in bits 16-63
+typedef void (*rsp_vmac_func)(UINT16 *vd, const UINT16 *vs, const UINT16 *vt, UINT64 *acc);
+
+struct rsp_vmac_ops
+{
+	const char *    name;
+
+	rsp_vmac_func   vmulf;
+	rsp_vmac_func   vmulu;
+	rsp_vmac_func   vmudl;
+	rsp_vmac_func   vmudm;
+	rsp_vmac_func   vmudn;
+	rsp_vmac_func   vmudh;
+	rsp_vmac_func   vmacf;
+	rsp_vmac_func   vmacu;
+	rsp_vmac_func   vmadl;
+	rsp_vmac_func   vmadm;
+	rsp_vmac_func   vmadn;
+	rsp_vmac_func   vmadh;
+};
+
+
+//**************************************************************************
+//  GLOBAL VARIABLES
+//**************************************************************************
+
+extern const rsp_vmac_ops rsp_vmac_scalar;
+#if RSP_VMAC_X86
+extern const rsp_vmac_ops rsp_vmac_sse2;
+extern const rsp_vmac_ops rsp_vmac_sse41;
+#endif
+
+
+//**************************************************************************
+//  FUNCTION PROTOTYPES
+//**************************************************************************
+
+// true if the host CPU can run the SSE2 or SSE4.1 kernels
+bool rsp_vmac_sse2_supported();
+bool rsp_vmac_sse41_supported();
+
+// the fastest kernel set the host supports
+const rsp_vmac_ops &rsp_vmac_select();
+
+
+#endif /* __RSPVMAC_H__ */
@@ -32,6 +32,27 @@
 #include "sh3comn.h"
 #include "sh4tmu.h"
 
+
+/***************************************************************************
+    DEBUGGING
+***************************************************************************/
+
+#define DISABLE_FAST_REGISTERS              (0) // set to 1 to turn off usage of register caching
+#define SINGLE_INSTRUCTION_MODE             (0)
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* size of the execution code cache */
+#define CACHE_SIZE                  (32 * 1024 * 1024)
+
+/* compilation boundaries -- how far back/forward does the analysis extend? */
+#define COMPILE_BACKWARDS_BYTES         64
+#define COMPILE_FORWARDS_BYTES          256
+#define COMPILE_MAX_INSTRUCTIONS        ((COMPILE_BACKWARDS_BYTES/2) + (COMPILE_FORWARDS_BYTES/2))
+#define COMPILE_MAX_SEQUENCE            64
+
 #if SH4_USE_FASTRAM_OPTIMIZATION
 void sh34_base_device::add_fastram(offs_t start, offs_t end, UINT8 readonly, void *base)
 {
@@ -99,6 +120,20 @@ sh34_base_device::sh34_base_device(const machine_config &mconfig, device_type ty
 	, c_md7(0)
 	, c_md8(0)
 	, c_clock(0)
+	, m_cache(CACHE_SIZE + sizeof(internal_sh4_state))
+	, m_drcuml(NULL)
+	, m_drcfe(NULL)
+	, m_drcoptions(0)
+	, m_entry(NULL)
+	, m_read8(NULL)
+	, m_write8(NULL)
+	, m_read16(NULL)
+	, m_write16(NULL)
+	, m_read32(NULL)
+	, m_write32(NULL)
+	, m_interrupt(NULL)
+	, m_nocode(NULL)
+	, m_out_of_cycles(NULL)
 #if SH4_USE_FASTRAM_OPTIMIZATION
 	, m_bigendian(endianness == ENDIANNESS_BIG)
 	, m_byte_xor(m_bigendian ? BYTE8_XOR_BE(0) : BYTE8_XOR_LE(0))
@@ -110,6 +145,21 @@ sh34_base_device::sh34_base_device(const machine_config &mconfig, device_type ty
 #if SH4_USE_FASTRAM_OPTIMIZATION
 	memset(m_fastram, 0, sizeof(m_fastram));
 #endif
+	// the recompiler hasn't been validated against the interpreter yet, so it is opt-in
+	m_isdrc = (mconfig.options().drc() && mconfig.options().drc_experimental() && !mconfig.m_force_no_drc) ? true : false;
+}
+
+
+void sh34_base_device::device_stop()
+{
+	if (m_drc_compare)
+		osd_printf_info("%s: %" I64FMT "u instructions matched the interpreter\n", tag(), m_compare_count);
+
+	/* clean up the DRC */
+	if (m_drcuml)
+	{
+		auto_free(machine(), m_drcuml);
+	}
 }
 
 
@@ -117,6 +167,9 @@ sh3_base_device::sh3_base_device(const machine_config &mconfig, device_type type
 	: sh34_base_device(mconfig, type, name, tag, owner, clock, shortname, endianness, ADDRESS_MAP_NAME(sh3_internal_map))
 {
 	m_cpu_type = CPU_TYPE_SH3;
+
+	// the recompiler is only checked against the SH-4 interpreter, so the SH-3 stays interpreted
+	m_isdrc = false;
 }
 
 
@@ -183,27 +236,27 @@ void sh34_base_device::TODO(const UINT16 opcode)
 #if 0
 int sign_of(int n)
 {
-	return(m_fr[n]>>31);
+	return(m_sh4_state->fr[n]>>31);
 }
 
 void zero(int n,int sign)
 {
 if (sign == 0)
-	m_fr[n] = 0x00000000;
+	m_sh4_state->fr[n] = 0x00000000;
 else
-	m_fr[n] = 0x80000000;
-if ((m_fpscr & PR) == 1)
-	m_fr[n+1] = 0x00000000;
+	m_sh4_state->fr[n] = 0x80000000;
+if ((m_sh4_state->fpscr & PR) == 1)
+	m_sh4_state->fr[n+1] = 0x00000000;
 }
 
 int data_type_of(int n)
 {
 UINT32 abs;
 
-	abs = m_fr[n] & 0x7fffffff;
-	if ((m_fpscr & PR) == 0) { /* Single-precision */
+	abs = m_sh4_state->fr[n] & 0x7fffffff;
+	if ((m_sh4_state->fpscr & PR) == 0) { /* Single-precision */
 		if (abs < 0x00800000) {
-			if (((m_fpscr & DN) == 1) || (abs == 0x00000000)) {
+			if (((m_sh4_state->fpscr & DN) == 1) || (abs == 0x00000000)) {
 				if (sign_of(n) == 0) {
 					zero(n, 0);
 					return(SH4_FPU_PZERO);
@@ -229,7 +282,7 @@ UINT32 abs;
 						return(SH4_FPU_sNaN);
 	} else { /* Double-precision */
 		if (abs < 0x00100000) {
-			if (((m_fpscr & DN) == 1) || ((abs == 0x00000000) && (m_fr[n+1] == 0x00000000))) {
+			if (((m_sh4_state->fpscr & DN) == 1) || ((abs == 0x00000000) && (m_sh4_state->fr[n+1] == 0x00000000))) {
 				if(sign_of(n) == 0) {
 					zero(n, 0);
 					return(SH4_FPU_PZERO);
@@ -243,7 +296,7 @@ UINT32 abs;
 			if (abs < 0x7ff00000)
 				return(SH4_FPU_NORM);
 			else
-				if ((abs == 0x7ff00000) && (m_fr[n+1] == 0x00000000)) {
+				if ((abs == 0x7ff00000) && (m_sh4_state->fr[n+1] == 0x00000000)) {
 					if (sign_of(n) == 0)
 						return(SH4_FPU_PINF);
 					else
@@ -260,6 +313,9 @@ UINT32 abs;
 
 inline UINT8 sh34_base_device::RB(offs_t A)
 {
+	if (m_compare_mode != COMPARE_ACCESS_NONE)
+		return compare_read(A, 1);
+
 	if (A >= 0xe0000000)
 		return m_program->read_byte(A);
 
@@ -283,6 +339,9 @@ inline UINT8 sh34_base_device::RB(offs_t A)
 
 inline UINT16 sh34_base_device::RW(offs_t A)
 {
+	if (m_compare_mode != COMPARE_ACCESS_NONE)
+		return compare_read(A, 2);
+
 	if (A >= 0xe0000000)
 		return m_program->read_word(A);
 
@@ -306,6 +365,9 @@ inline UINT16 sh34_base_device::RW(offs_t A)
 
 inline UINT32 sh34_base_device::RL(offs_t A)
 {
+	if (m_compare_mode != COMPARE_ACCESS_NONE)
+		return compare_read(A, 4);
+
 	if (A >= 0xe0000000)
 		return m_program->read_dword(A);
 
@@ -329,6 +391,12 @@ inline UINT32 sh34_base_device::RL(offs_t A)
 
 inline void sh34_base_device::WB(offs_t A, UINT8 V)
 {
+	if (m_compare_mode != COMPARE_ACCESS_NONE)
+	{
+		compare_write(A, 1, V);
+		return;
+	}
+
 	if (A >= 0xe0000000)
 	{
 		m_program->write_byte(A,V);
@@ -355,6 +423,12 @@ inline void sh34_base_device::WB(offs_t A, UINT8 V)
 
 inline void sh34_base_device::WW(offs_t A, UINT16 V)
 {
+	if (m_compare_mode != COMPARE_ACCESS_NONE)
+	{
+		compare_write(A, 2, V);
+		return;
+	}
+
 	if (A >= 0xe0000000)
 	{
 		m_program->write_word(A,V);
@@ -381,6 +455,12 @@ inline void sh34_base_device::WW(offs_t A, UINT16 V)
 
 inline void sh34_base_device::WL(offs_t A, UINT32 V)
 {
+	if (m_compare_mode != COMPARE_ACCESS_NONE)
+	{
+		compare_write(A, 4, V);
+		return;
+	}
+
 	if (A >= 0xe0000000)
 	{
 		m_program->write_dword(A,V);
@@ -410,7 +490,7 @@ inline void sh34_base_device::WL(offs_t A, UINT32 V)
  */
 inline void sh34_base_device::ADD(const UINT16 opcode)
 {
-	m_r[Rn] += m_r[Rm];
+	m_sh4_state->r[Rn] += m_sh4_state->r[Rm];
 }
 
 /*  code                 cycles  t-bit
@@ -419,7 +499,7 @@ inline void sh34_base_device::ADD(const UINT16 opcode)
  */
 inline void sh34_base_device::ADDI(const UINT16 opcode)
 {
-	m_r[Rn] += (INT32)(INT16)(INT8)(opcode&0xff);
+	m_sh4_state->r[Rn] += (INT32)(INT16)(INT8)(opcode&0xff);
 }
 
 /*  code                 cycles  t-bit
@@ -431,15 +511,15 @@ inline void sh34_base_device::ADDC(const UINT16 opcode)
 	UINT32 m = Rm; UINT32 n = Rn;
 	UINT32 tmp0, tmp1;
 
-	tmp1 = m_r[n] + m_r[m];
-	tmp0 = m_r[n];
-	m_r[n] = tmp1 + (m_sr & T);
+	tmp1 = m_sh4_state->r[n] + m_sh4_state->r[m];
+	tmp0 = m_sh4_state->r[n];
+	m_sh4_state->r[n] = tmp1 + (m_sh4_state->sr & T);
 	if (tmp0 > tmp1)
-		m_sr |= T;
+		m_sh4_state->sr |= T;
 	else
-		m_sr &= ~T;
-	if (tmp1 > m_r[n])
-		m_sr |= T;
+		m_sh4_state->sr &= ~T;
+	if (tmp1 > m_sh4_state->r[n])
+		m_sh4_state->sr |= T;
 }
 
 /*  code                 cycles  t-bit
@@ -451,17 +531,17 @@ inline void sh34_base_device::ADDV(const UINT16 opcode)
 	UINT32 m = Rm; UINT32 n = Rn;
 	INT32 dest, src, ans;
 
-	if ((INT32) m_r[n] >= 0)
+	if ((INT32) m_sh4_state->r[n] >= 0)
 		dest = 0;
 	else
 		dest = 1;
-	if ((INT32) m_r[m] >= 0)
+	if ((INT32) m_sh4_state->r[m] >= 0)
 		src = 0;
 	else
 		src = 1;
 	src += dest;
-	m_r[n] += m_r[m];
-	if ((INT32) m_r[n] >= 0)
+	m_sh4_state->r[n] += m_sh4_state->r[m];
+	if ((INT32) m_sh4_state->r[n] >= 0)
 		ans = 0;
 	else
 		ans = 1;
@@ -469,12 +549,12 @@ inline void sh34_base_device::ADDV(const UINT16 opcode)
 	if (src == 0 || src == 2)
 	{
 		if (ans == 1)
-			m_sr |= T;
+			m_sh4_state->sr |= T;
 		else
-			m_sr &= ~T;
+			m_sh4_state->sr &= ~T;
 	}
 	else
-		m_sr &= ~T;
+		m_sh4_state->sr &= ~T;
 }
 
 /*  code                 cycles  t-bit
@@ -483,7 +563,7 @@ inline void sh34_base_device::ADDV(const UINT16 opcode)
  */
 inline void sh34_base_device::AND(const UINT16 opcode)
 {
-	m_r[Rn] &= m_r[Rm];
+	m_sh4_state->r[Rn] &= m_sh4_state->r[Rm];
 }
 
 
@@ -493,7 +573,7 @@ inline void sh34_base_device::AND(const UINT16 opcode)
  */
 inline void sh34_base_device::ANDI(const UINT16 opcode)
 {
-	m_r[0] &= (opcode&0xff);
+	m_sh4_state->r[0] &= (opcode&0xff);
 }
 
 /*  code                 cycles  t-bit
@@ -504,10 +584,10 @@ inline void sh34_base_device::ANDM(const UINT16 opcode)
 {
 	UINT32 temp;
 
-	m_ea = m_gbr + m_r[0];
-	temp = (opcode&0xff) & RB( m_ea );
-	WB(m_ea, temp );
-	m_sh4_icount -= 2;
+	m_sh4_state->ea = m_sh4_state->gbr + m_sh4_state->r[0];
+	temp = (opcode&0xff) & RB( m_sh4_state->ea );
+	WB(m_sh4_state->ea, temp );
+	m_sh4_state->icount -= 2;
 }
 
 /*  code                 cycles  t-bit
@@ -516,11 +596,11 @@ inline void sh34_base_device::ANDM(const UINT16 opcode)
  */
 inline void sh34_base_device::BF(const UINT16 opcode)
 {
-	if ((m_sr & T) == 0)
+	if ((m_sh4_state->sr & T) == 0)
 	{
 		INT32 disp = ((INT32)(opcode&0xff) << 24) >> 24;
-		m_pc = m_ea = m_pc + disp * 2 + 2;
-		m_sh4_icount -= 2;
+		m_sh4_state->pc = m_sh4_state->ea = m_sh4_state->pc + disp * 2 + 2;
+		m_sh4_state->icount -= 2;
 	}
 }
 
@@ -530,12 +610,12 @@ inline void sh34_base_device::BF(const UINT16 opcode)
  */
 inline void sh34_base_device::BFS(const UINT16 opcode)
 {
-	if ((m_sr & T) == 0)
+	if ((m_sh4_state->sr & T) == 0)
 	{
 		INT32 disp = ((INT32)(opcode&0xff) << 24) >> 24;
-		m_delay = m_pc;
-		m_pc = m_ea = m_pc + disp * 2 + 2;
-		m_sh4_icount--;
+		m_sh4_state->delay = m_sh4_state->pc;
+		m_sh4_state->pc = m_sh4_state->ea = m_sh4_state->pc + disp * 2 + 2;
+		m_sh4_state->icount--;
 	}
 }
 
@@ -550,17 +630,17 @@ inline void sh34_base_device::BRA(const UINT16 opcode)
 #if BUSY_LOOP_HACKS
 	if (disp == -2)
 	{
-		UINT32 next_opcode = RW(m_ppc & AM);
+		UINT32 next_opcode = RW(m_sh4_state->ppc & AM);
 		/* BRA  $
 		 * NOP
 		 */
 		if (next_opcode == 0x0009)
-			m_sh4_icount %= 3;   /* cycles for BRA $ and NOP taken (3) */
+			m_sh4_state->icount %= 3;   /* cycles for BRA $ and NOP taken (3) */
 	}
 #endif
-	m_delay = m_pc;
-	m_pc = m_ea = m_pc + disp * 2 + 2;
-	m_sh4_icount--;
+	m_sh4_state->delay = m_sh4_state->pc;
+	m_sh4_state->pc = m_sh4_state->ea = m_sh4_state->pc + disp * 2 + 2;
+	m_sh4_state->icount--;
 }
 
 /*  code                 cycles  t-bit
@@ -569,9 +649,9 @@ inline void sh34_base_device::BRA(const UINT16 opcode)
  */
 inline void sh34_base_device::BRAF(const UINT16 opcode)
 {
-	m_delay = m_pc;
-	m_pc += m_r[Rn] + 2;
-	m_sh4_icount--;
+	m_sh4_state->delay = m_sh4_state->pc;
+	m_sh4_state->pc += m_sh4_state->r[Rn] + 2;
+	m_sh4_state->icount--;
 }
 
 /*  code                 cycles  t-bit
@@ -582,10 +662,10 @@ inline void sh34_base_device::BSR(const UINT16 opcode)
 {
 	INT32 disp = ((INT32)(opcode&0xfff) << 20) >> 20;
 
-	m_pr = m_pc + 2;
-	m_delay = m_pc;
-	m_pc = m_ea = m_pc + disp * 2 + 2;
-	m_sh4_icount--;
+	m_sh4_state->pr = m_sh4_state->pc + 2;
+	m_sh4_state->delay = m_sh4_state->pc;
+	m_sh4_state->pc = m_sh4_state->ea = m_sh4_state->pc + disp * 2 + 2;
+	m_sh4_state->icount--;
 }
 
 /*  code                 cycles  t-bit
@@ -594,10 +674,10 @@ inline void sh34_base_device::BSR(const UINT16 opcode)
  */
 inline void sh34_base_device::BSRF(const UINT16 opcode)
 {
-	m_pr = m_pc + 2;
-	m_delay = m_pc;
-	m_pc += m_r[Rn] + 2;
-	m_sh4_icount--;
+	m_sh4_state->pr = m_sh4_state->pc + 2;
+	m_sh4_state->delay = m_sh4_state->pc;
+	m_sh4_state->pc += m_sh4_state->r[Rn] + 2;
+	m_sh4_state->icount--;
 }
 
 /*  code                 cycles  t-bit
@@ -606,11 +686,11 @@ inline void sh34_base_device::BSRF(const UINT16 opcode)
  */
 inline void sh34_base_device::BT(const UINT16 opcode)
 {
-	if ((m_sr & T) != 0)
+	if ((m_sh4_state->sr & T) != 0)
 	{
 		INT32 disp = ((INT32)(opcode&0xff) << 24) >> 24;
-		m_pc = m_ea = m_pc + disp * 2 + 2;
-		m_sh4_icount -= 2;
+		m_sh4_state->pc = m_sh4_state->ea = m_sh4_state->pc + disp * 2 + 2;
+		m_sh4_state->icount -= 2;
 	}
 }
 
@@ -620,12 +700,12 @@ inline void sh34_base_device::BT(const UINT16 opcode)
  */
 inline void sh34_base_device::BTS(const UINT16 opcode)
 {
-	if ((m_sr & T) != 0)
+	if ((m_sh4_state->sr & T) != 0)
 	{
 		INT32 disp = ((INT32)(opcode&0xff) << 24) >> 24;
-		m_delay = m_pc;
-		m_pc = m_ea = m_pc + disp * 2 + 2;
-		m_sh4_icount--;
+		m_sh4_state->delay = m_sh4_state->pc;
+		m_sh4_state->pc = m_sh4_state->ea = m_sh4_state->pc + disp * 2 + 2;
+		m_sh4_state->icount--;
 	}
 }
 
@@ -635,8 +715,8 @@ inline void sh34_base_device::BTS(const UINT16 opcode)
  */
 inline void sh34_base_device::CLRMAC(const UINT16 opcode)
 {
-	m_mach = 0;
-	m_macl = 0;
+	m_sh4_state->mach = 0;
+	m_sh4_state->macl = 0;
 }
 
 /*  code                 cycles  t-bit
@@ -645,7 +725,7 @@ inline void sh34_base_device::CLRMAC(const UINT16 opcode)
  */
 inline void sh34_base_device::CLRT(const UINT16 opcode)
 {
-	m_sr &= ~T;
+	m_sh4_state->sr &= ~T;
 }
 
 /*  code                 cycles  t-bit
@@ -654,10 +734,10 @@ inline void sh34_base_device::CLRT(const UINT16 opcode)
  */
 inline void sh34_base_device::CMPEQ(const UINT16 opcode)
 {
-	if (m_r[Rn] == m_r[Rm])
-		m_sr |= T;
+	if (m_sh4_state->r[Rn] == m_sh4_state->r[Rm])
+		m_sh4_state->sr |= T;
 	else
-		m_sr &= ~T;
+		m_sh4_state->sr &= ~T;
 }
 
 /*  code                 cycles  t-bit
@@ -666,10 +746,10 @@ inline void sh34_base_device::CMPEQ(const UINT16 opcode)
  */
 inline void sh34_base_device::CMPGE(const UINT16 opcode)
 {
-	if ((INT32) m_r[Rn] >= (INT32) m_r[Rm])
-		m_sr |= T;
+	if ((INT32) m_sh4_state->r[Rn] >= (INT32) m_sh4_state->r[Rm])
+		m_sh4_state->sr |= T;
 	else
-		m_sr &= ~T;
+		m_sh4_state->sr &= ~T;
 }
 
 /*  code                 cycles  t-bit
@@ -678,10 +758,10 @@ inline void sh34_base_device::CMPGE(const UINT16 opcode)
  */
 inline void sh34_base_device::CMPGT(const UINT16 opcode)
 {
-	if ((INT32) m_r[Rn] > (INT32) m_r[Rm])
-		m_sr |= T;
+	if ((INT32) m_sh4_state->r[Rn] > (INT32) m_sh4_state->r[Rm])
+		m_sh4_state->sr |= T;
 	else
-		m_sr &= ~T;
+		m_sh4_state->sr &= ~T;
 }
 
 /*  code                 cycles  t-bit
@@ -690,10 +770,10 @@ inline void sh34_base_device::CMPGT(const UINT16 opcode)
  */
 inline void sh34_base_device::CMPHI(const UINT16 opcode)
 {
-	if ((UINT32) m_r[Rn] > (UINT32) m_r[Rm])
-		m_sr |= T;
+	if ((UINT32) m_sh4_state->r[Rn] > (UINT32) m_sh4_state->r[Rm])
+		m_sh4_state->sr |= T;
 	else
-		m_sr &= ~T;
+		m_sh4_state->sr &= ~T;
 }
 
 /*  code                 cycles  t-bit
@@ -702,10 +782,10 @@ inline void sh34_base_device::CMPHI(const UINT16 opcode)
  */
 inline void sh34_base_device::CMPHS(const UINT16 opcode)
 {
-	if ((UINT32) m_r[Rn] >= (UINT32) m_r[Rm])
-		m_sr |= T;
+	if ((UINT32) m_sh4_state->r[Rn] >= (UINT32) m_sh4_state->r[Rm])
+		m_sh4_state->sr |= T;
 	else
-		m_sr &= ~T;
+		m_sh4_state->sr &= ~T;
 }
 
 
@@ -715,10 +795,10 @@ inline void sh34_base_device::CMPHS(const UINT16 opcode)
  */
 inline void sh34_base_device::CMPPL(const UINT16 opcode)
 {
-	if ((INT32) m_r[Rn] > 0)
-		m_sr |= T;
+	if ((INT32) m_sh4_state->r[Rn] > 0)
+		m_sh4_state->sr |= T;
 	else
-		m_sr &= ~T;
+		m_sh4_state->sr &= ~T;
 }
 
 /*  code                 cycles  t-bit
@@ -727,10 +807,10 @@ inline void sh34_base_device::CMPPL(const UINT16 opcode)
  */
 inline void sh34_base_device::CMPPZ(const UINT16 opcode)
 {
-	if ((INT32) m_r[Rn] >= 0)
-		m_sr |= T;
+	if ((INT32) m_sh4_state->r[Rn] >= 0)
+		m_sh4_state->sr |= T;
 	else
-		m_sr &= ~T;
+		m_sh4_state->sr &= ~T;
 }
 
 /*  code                 cycles  t-bit
@@ -741,15 +821,15 @@ inline void sh34_base_device::CMPSTR(const UINT16 opcode)
 {
 	UINT32 temp;
 	INT32 HH, HL, LH, LL;
-	temp = m_r[Rn] ^ m_r[Rm];
+	temp = m_sh4_state->r[Rn] ^ m_sh4_state->r[Rm];
 	HH = (temp >> 24) & 0xff;
 	HL = (temp >> 16) & 0xff;
 	LH = (temp >> 8) & 0xff;
 	LL = temp & 0xff;
 	if (HH && HL && LH && LL)
-	m_sr &= ~T;
+	m_sh4_state->sr &= ~T;
 	else
-	m_sr |= T;
+	m_sh4_state->sr |= T;
 	}
 
 
@@ -761,10 +841,10 @@ inline void sh34_base_device::CMPIM(const UINT16 opcode)
 {
 	UINT32 imm = (UINT32)(INT32)(INT16)(INT8)(opcode&0xff);
 
-	if (m_r[0] == imm)
-		m_sr |= T;
+	if (m_sh4_state->r[0] == imm)
+		m_sh4_state->sr |= T;
 	else
-		m_sr &= ~T;
+		m_sh4_state->sr &= ~T;
 }
 
 /*  code                 cycles  t-bit
@@ -775,18 +855,18 @@ inline void sh34_base_device::DIV0S(const UINT16 opcode)
 {
 	UINT32 m = Rm; UINT32 n = Rn;
 
-	if ((m_r[n] & 0x80000000) == 0)
-		m_sr &= ~Q;
+	if ((m_sh4_state->r[n] & 0x80000000) == 0)
+		m_sh4_state->sr &= ~Q;
 	else
-		m_sr |= Q;
-	if ((m_r[m] & 0x80000000) == 0)
-		m_sr &= ~M;
+		m_sh4_state->sr |= Q;
+	if ((m_sh4_state->r[m] & 0x80000000) == 0)
+		m_sh4_state->sr &= ~M;
 	else
-		m_sr |= M;
-	if ((m_r[m] ^ m_r[n]) & 0x80000000)
-		m_sr |= T;
+		m_sh4_state->sr |= M;
+	if ((m_sh4_state->r[m] ^ m_sh4_state->r[n]) & 0x80000000)
+		m_sh4_state->sr |= T;
 	else
-		m_sr &= ~T;
+		m_sh4_state->sr &= ~T;
 }
 
 /*  code                 cycles  t-bit
@@ -795,7 +875,7 @@ inline void sh34_base_device::DIV0S(const UINT16 opcode)
  */
 inline void sh34_base_device::DIV0U(const UINT16 opcode)
 {
-	m_sr &= ~(M | Q | T);
+	m_sh4_state->sr &= ~(M | Q | T);
 }
 
 /*  code                 cycles  t-bit
@@ -809,90 +889,90 @@ inline void sh34_base_device::DIV1(const UINT16 opcode)
 	UINT32 tmp0;
 	UINT32 old_q;
 
-	old_q = m_sr & Q;
-	if (0x80000000 & m_r[n])
-		m_sr |= Q;
+	old_q = m_sh4_state->sr & Q;
+	if (0x80000000 & m_sh4_state->r[n])
+		m_sh4_state->sr |= Q;
 	else
-		m_sr &= ~Q;
+		m_sh4_state->sr &= ~Q;
 
-	m_r[n] = (m_r[n] << 1) | (m_sr & T);
+	m_sh4_state->r[n] = (m_sh4_state->r[n] << 1) | (m_sh4_state->sr & T);
 
 	if (!old_q)
 	{
-		if (!(m_sr & M))
+		if (!(m_sh4_state->sr & M))
 		{
-			tmp0 = m_r[n];
-			m_r[n] -= m_r[m];
-			if(!(m_sr & Q))
-				if(m_r[n] > tmp0)
-					m_sr |= Q;
+			tmp0 = m_sh4_state->r[n];
+			m_sh4_state->r[n] -= m_sh4_state->r[m];
+			if(!(m_sh4_state->sr & Q))
+				if(m_sh4_state->r[n] > tmp0)
+					m_sh4_state->sr |= Q;
 				else
-					m_sr &= ~Q;
+					m_sh4_state->sr &= ~Q;
 			else
-				if(m_r[n] > tmp0)
-					m_sr &= ~Q;
+				if(m_sh4_state->r[n] > tmp0)
+					m_sh4_state->sr &= ~Q;
 				else
-					m_sr |= Q;
+					m_sh4_state->sr |= Q;
 		}
 		else
 		{
-			tmp0 = m_r[n];
-			m_r[n] += m_r[m];
-			if(!(m_sr & Q))
+			tmp0 = m_sh4_state->r[n];
+			m_sh4_state->r[n] += m_sh4_state->r[m];
+			if(!(m_sh4_state->sr & Q))
 			{
-				if(m_r[n] < tmp0)
-					m_sr &= ~Q;
+				if(m_sh4_state->r[n] < tmp0)
+					m_sh4_state->sr &= ~Q;
 				else
-					m_sr |= Q;
+					m_sh4_state->sr |= Q;
 			}
 			else
 			{
-				if(m_r[n] < tmp0)
-					m_sr |= Q;
+				if(m_sh4_state->r[n] < tmp0)
+					m_sh4_state->sr |= Q;
 				else
-					m_sr &= ~Q;
+					m_sh4_state->sr &= ~Q;
 			}
 		}
 	}
 	else
 	{
-		if (!(m_sr & M))
+		if (!(m_sh4_state->sr & M))
 		{
-			tmp0 = m_r[n];
-			m_r[n] += m_r[m];
-			if(!(m_sr & Q))
-				if(m_r[n] < tmp0)
-					m_sr |= Q;
+			tmp0 = m_sh4_state->r[n];
+			m_sh4_state->r[n] += m_sh4_state->r[m];
+			if(!(m_sh4_state->sr & Q))
+				if(m_sh4_state->r[n] < tmp0)
+					m_sh4_state->sr |= Q;
 				else
-					m_sr &= ~Q;
+					m_sh4_state->sr &= ~Q;
 			else
-				if(m_r[n] < tmp0)
-					m_sr &= ~Q;
+				if(m_sh4_state->r[n] < tmp0)
+					m_sh4_state->sr &= ~Q;
 				else
-					m_sr |= Q;
+					m_sh4_state->sr |= Q;
 		}
 		else
 		{
-			tmp0 = m_r[n];
-			m_r[n] -= m_r[m];
-			if(!(m_sr & Q))
-				if(m_r[n] > tmp0)
-					m_sr &= ~Q;
+			tmp0 = m_sh4_state->r[n];
+			m_sh4_state->r[n] -= m_sh4_state->r[m];
+			if(!(m_sh4_state->sr & Q))
+				if(m_sh4_state->r[n] > tmp0)
+					m_sh4_state->sr &= ~Q;
 				else
-					m_sr |= Q;
+					m_sh4_state->sr |= Q;
 			else
-				if(m_r[n] > tmp0)
-					m_sr |= Q;
+				if(m_sh4_state->r[n] > tmp0)
+					m_sh4_state->sr |= Q;
 				else
-					m_sr &= ~Q;
+					m_sh4_state->sr &= ~Q;
 		}
 	}
 
-	tmp0 = (m_sr & (Q | M));
+	tmp0 = (m_sh4_state->sr & (Q | M));
 	if((!tmp0) || (tmp0 == 0x300)) /* if Q == M set T else clear T */
-		m_sr |= T;
+		m_sh4_state->sr |= T;
 	else
-		m_sr &= ~T;
+		m_sh4_state->sr &= ~T;
 }
 
 /*  DMULS.L Rm,Rn */
@@ -904,13 +984,13 @@ inline void sh34_base_device::DMULS(const UINT16 opcode)
 	UINT32 temp0, temp1, temp2, temp3;
 	INT32 tempm, tempn, fnLmL;
 
-	tempn = (INT32) m_r[n];
-	tempm = (INT32) m_r[m];
+	tempn = (INT32) m_sh4_state->r[n];
+	tempm = (INT32) m_sh4_state->r[m];
 	if (tempn < 0)
 		tempn = 0 - tempn;
 	if (tempm < 0)
 		tempm = 0 - tempm;
-	if ((INT32) (m_r[n] ^ m_r[m]) < 0)
+	if ((INT32) (m_sh4_state->r[n] ^ m_sh4_state->r[m]) < 0)
 		fnLmL = -1;
 	else
 		fnLmL = 0;
@@ -941,9 +1021,9 @@ inline void sh34_base_device::DMULS(const UINT16 opcode)
 		else
 			Res0 = (~Res0) + 1;
 	}
-	m_mach = Res2;
-	m_macl = Res0;
-	m_sh4_icount--;
+	m_sh4_state->mach = Res2;
+	m_sh4_state->macl = Res0;
+	m_sh4_state->icount--;
 }
 
 /*  DMULU.L Rm,Rn */
@@ -954,10 +1034,10 @@ inline void sh34_base_device::DMULU(const UINT16 opcode)
 	UINT32 RnL, RnH, RmL, RmH, Res0, Res1, Res2;
 	UINT32 temp0, temp1, temp2, temp3;
 
-	RnL = m_r[n] & 0x0000ffff;
-	RnH = (m_r[n] >> 16) & 0x0000ffff;
-	RmL = m_r[m] & 0x0000ffff;
-	RmH = (m_r[m] >> 16) & 0x0000ffff;
+	RnL = m_sh4_state->r[n] & 0x0000ffff;
+	RnH = (m_sh4_state->r[n] >> 16) & 0x0000ffff;
+	RmL = m_sh4_state->r[m] & 0x0000ffff;
+	RmH = (m_sh4_state->r[m] >> 16) & 0x0000ffff;
 	temp0 = RmL * RnL;
 	temp1 = RmH * RnL;
 	temp2 = RmL * RnH;
@@ -971,9 +1051,9 @@ inline void sh34_base_device::DMULU(const UINT16 opcode)
 	if (Res0 < temp0)
 		Res2++;
 	Res2 = Res2 + ((Res1 >> 16) & 0x0000ffff) + temp3;
-	m_mach = Res2;
-	m_macl = Res0;
-	m_sh4_icount--;
+	m_sh4_state->mach = Res2;
+	m_sh4_state->macl = Res0;
+	m_sh4_state->icount--;
 }
 
 /*  DT      Rn */
@@ -981,23 +1061,23 @@ inline void sh34_base_device::DT(const UINT16 opcode)
 {
 	UINT32 n = Rn;
 
-	m_r[n]--;
-	if (m_r[n] == 0)
-		m_sr |= T;
+	m_sh4_state->r[n]--;
+	if (m_sh4_state->r[n] == 0)
+		m_sh4_state->sr |= T;
 	else
-		m_sr &= ~T;
+		m_sh4_state->sr &= ~T;
 #if BUSY_LOOP_HACKS
 	{
-		UINT32 next_opcode = RW(m_ppc & AM);
+		UINT32 next_opcode = RW(m_sh4_state->ppc & AM);
 		/* DT   Rn
 		 * BF   $-2
 		 */
 		if (next_opcode == 0x8bfd)
 		{
-			while (m_r[n] > 1 && m_sh4_icount > 4)
+			while (m_sh4_state->r[n] > 1 && m_sh4_state->icount > 4)
 			{
-				m_r[n]--;
-				m_sh4_icount -= 4;   /* cycles for DT (1) and BF taken (3) */
+				m_sh4_state->r[n]--;
+				m_sh4_state->icount -= 4;   /* cycles for DT (1) and BF taken (3) */
 			}
 		}
 	}
@@ -1007,41 +1087,41 @@ inline void sh34_base_device::DT(const UINT16 opcode)
 /*  EXTS.B  Rm,Rn */
 inline void sh34_base_device::EXTSB(const UINT16 opcode)
 {
-	m_r[Rn] = ((INT32)m_r[Rm] << 24) >> 24;
+	m_sh4_state->r[Rn] = ((INT32)m_sh4_state->r[Rm] << 24) >> 24;
 }
 
 /*  EXTS.W  Rm,Rn */
 inline void sh34_base_device::EXTSW(const UINT16 opcode)
 {
-	m_r[Rn] = ((INT32)m_r[Rm] << 16) >> 16;
+	m_sh4_state->r[Rn] = ((INT32)m_sh4_state->r[Rm] << 16) >> 16;
 }
 
 /*  EXTU.B  Rm,Rn */
 inline void sh34_base_device::EXTUB(const UINT16 opcode)
 {
-	m_r[Rn] = m_r[Rm] & 0x000000ff;
+	m_sh4_state->r[Rn] = m_sh4_state->r[Rm] & 0x000000ff;
 }
 
 /*  EXTU.W  Rm,Rn */
 inline void sh34_base_device::EXTUW(const UINT16 opcode)
 {
-	m_r[Rn] = m_r[Rm] & 0x0000ffff;
+	m_sh4_state->r[Rn] = m_sh4_state->r[Rm] & 0x0000ffff;
 }
 
 /*  JMP     @Rm */
 inline void sh34_base_device::JMP(const UINT16 opcode)
 {
-	m_delay = m_pc;
-	m_pc = m_ea = m_r[Rn];
+	m_sh4_state->delay = m_sh4_state->pc;
+	m_sh4_state->pc = m_sh4_state->ea = m_sh4_state->r[Rn];
 }
 
 /*  JSR     @Rm */
 inline void sh34_base_device::JSR(const UINT16 opcode)
 {
-	m_delay = m_pc;
-	m_pr = m_pc + 2;
-	m_pc = m_ea = m_r[Rn];
-	m_sh4_icount--;
+	m_sh4_state->delay = m_sh4_state->pc;
+	m_sh4_state->pr = m_sh4_state->pc + 2;
+	m_sh4_state->pc = m_sh4_state->ea = m_sh4_state->r[Rn];
+	m_sh4_state->icount--;
 }
 
 
@@ -1050,25 +1130,25 @@ inline void sh34_base_device::LDCSR(const UINT16 opcode)
 {
 	UINT32 reg;
 
-	reg = m_r[Rn];
+	reg = m_sh4_state->r[Rn];
 	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
-		sh4_syncronize_register_bank((m_sr & sRB) >> 29);
-	if ((m_r[Rn] & sRB) != (m_sr & sRB))
-		sh4_change_register_bank(m_r[Rn] & sRB ? 1 : 0);
-	m_sr = reg & FLAGS;
+		sh4_syncronize_register_bank((m_sh4_state->sr & sRB) >> 29);
+	if ((m_sh4_state->r[Rn] & sRB) != (m_sh4_state->sr & sRB))
+		sh4_change_register_bank(m_sh4_state->r[Rn] & sRB ? 1 : 0);
+	m_sh4_state->sr = reg & FLAGS;
 	sh4_exception_recompute();
 }
 
 /*  LDC     Rm,GBR */
 inline void sh34_base_device::LDCGBR(const UINT16 opcode)
 {
-	m_gbr = m_r[Rn];
+	m_sh4_state->gbr = m_sh4_state->r[Rn];
 }
 
 /*  LDC     Rm,VBR */
 inline void sh34_base_device::LDCVBR(const UINT16 opcode)
 {
-	m_vbr = m_r[Rn];
+	m_sh4_state->vbr = m_sh4_state->r[Rn];
 }
 
 /*  LDC.L   @Rm+,SR */
@@ -1076,76 +1156,76 @@ inline void sh34_base_device::LDCMSR(const UINT16 opcode)
 {
 	UINT32 old;
 
-	old = m_sr;
-	m_ea = m_r[Rn];
-	m_sr = RL(m_ea ) & FLAGS;
+	old = m_sh4_state->sr;
+	m_sh4_state->ea = m_sh4_state->r[Rn];
+	m_sh4_state->sr = RL(m_sh4_state->ea ) & FLAGS;
 	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
 		sh4_syncronize_register_bank((old & sRB) >> 29);
-	if ((old & sRB) != (m_sr & sRB))
-		sh4_change_register_bank(m_sr & sRB ? 1 : 0);
-	m_r[Rn] += 4;
-	m_sh4_icount -= 2;
+	if ((old & sRB) != (m_sh4_state->sr & sRB))
+		sh4_change_register_bank(m_sh4_state->sr & sRB ? 1 : 0);
+	m_sh4_state->r[Rn] += 4;
+	m_sh4_state->icount -= 2;
 	sh4_exception_recompute();
 }
 
 /*  LDC.L   @Rm+,GBR */
 inline void sh34_base_device::LDCMGBR(const UINT16 opcode)
 {
-	m_ea = m_r[Rn];
-	m_gbr = RL(m_ea );
-	m_r[Rn] += 4;
-	m_sh4_icount -= 2;
+	m_sh4_state->ea = m_sh4_state->r[Rn];
+	m_sh4_state->gbr = RL(m_sh4_state->ea );
+	m_sh4_state->r[Rn] += 4;
+	m_sh4_state->icount -= 2;
 }
 
 /*  LDC.L   @Rm+,VBR */
 inline void sh34_base_device::LDCMVBR(const UINT16 opcode)
 {
-	m_ea = m_r[Rn];
-	m_vbr = RL(m_ea );
-	m_r[Rn] += 4;
-	m_sh4_icount -= 2;
+	m_sh4_state->ea = m_sh4_state->r[Rn];
+	m_sh4_state->vbr = RL(m_sh4_state->ea );
+	m_sh4_state->r[Rn] += 4;
+	m_sh4_state->icount -= 2;
 }
 
 /*  LDS     Rm,MACH */
 inline void sh34_base_device::LDSMACH(const UINT16 opcode)
 {
-	m_mach = m_r[Rn];
+	m_sh4_state->mach = m_sh4_state->r[Rn];
 }
 
 /*  LDS     Rm,MACL */
 inline void sh34_base_device::LDSMACL(const UINT16 opcode)
 {
-	m_macl = m_r[Rn];
+	m_sh4_state->macl = m_sh4_state->r[Rn];
 }
 
 /*  LDS     Rm,PR */
 inline void sh34_base_device::LDSPR(const UINT16 opcode)
 {
-	m_pr = m_r[Rn];
+	m_sh4_state->pr = m_sh4_state->r[Rn];
 }
 
 /*  LDS.L   @Rm+,MACH */
 inline void sh34_base_device::LDSMMACH(const UINT16 opcode)
 {
-	m_ea = m_r[Rn];
-	m_mach = RL(m_ea );
-	m_r[Rn] += 4;
+	m_sh4_state->ea = m_sh4_state->r[Rn];
+	m_sh4_state->mach = RL(m_sh4_state->ea );
+	m_sh4_state->r[Rn] += 4;
 }
 
 /*  LDS.L   @Rm+,MACL */
 inline void sh34_base_device::LDSMMACL(const UINT16 opcode)
 {
-	m_ea = m_r[Rn];
-	m_macl = RL(m_ea );
-	m_r[Rn] += 4;
+	m_sh4_state->ea = m_sh4_state->r[Rn];
+	m_sh4_state->macl = RL(m_sh4_state->ea );
+	m_sh4_state->r[Rn] += 4;
 }
 
 /*  LDS.L   @Rm+,PR */
 inline void sh34_base_device::LDSMPR(const UINT16 opcode)
 {
-	m_ea = m_r[Rn];
-	m_pr = RL(m_ea );
-	m_r[Rn] += 4;
+	m_sh4_state->ea = m_sh4_state->r[Rn];
+	m_sh4_state->pr = RL(m_sh4_state->ea );
+	m_sh4_state->r[Rn] += 4;
 }
 
 /*  MAC.L   @Rm+,@Rn+ */
@@ -1157,10 +1237,10 @@ inline void sh34_base_device::MAC_L(const UINT16 opcode)
 	UINT32 temp0, temp1, temp2, temp3;
 	INT32 tempm, tempn, fnLmL;
 
-	tempn = (INT32) RL(m_r[n] );
-	m_r[n] += 4;
-	tempm = (INT32) RL(m_r[m] );
-	m_r[m] += 4;
+	tempn = (INT32) RL(m_sh4_state->r[n] );
+	m_sh4_state->r[n] += 4;
+	tempm = (INT32) RL(m_sh4_state->r[m] );
+	m_sh4_state->r[m] += 4;
 	if ((INT32) (tempn ^ tempm) < 0)
 		fnLmL = -1;
 	else
@@ -1196,12 +1276,12 @@ inline void sh34_base_device::MAC_L(const UINT16 opcode)
 		else
 			Res0 = (~Res0) + 1;
 	}
-	if (m_sr & S)
+	if (m_sh4_state->sr & S)
 	{
-		Res0 = m_macl + Res0;
-		if (m_macl > Res0)
+		Res0 = m_sh4_state->macl + Res0;
+		if (m_sh4_state->macl > Res0)
 			Res2++;
-		Res2 += (m_mach & 0x0000ffff);
+		Res2 += (m_sh4_state->mach & 0x0000ffff);
 		if (((INT32) Res2 < 0) && (Res2 < 0xffff8000))
 		{
 			Res2 = 0x00008000;
@@ -1212,19 +1292,19 @@ inline void sh34_base_device::MAC_L(const UINT16 opcode)
 			Res2 = 0x00007fff;
 			Res0 = 0xffffffff;
 		}
-		m_mach = Res2;
-		m_macl = Res0;
+		m_sh4_state->mach = Res2;
+		m_sh4_state->macl = Res0;
 	}
 	else
 	{
-		Res0 = m_macl + Res0;
-		if (m_macl > Res0)
+		Res0 = m_sh4_state->macl + Res0;
+		if (m_sh4_state->macl > Res0)
 			Res2++;
-		Res2 += m_mach;
-		m_mach = Res2;
-		m_macl = Res0;
+		Res2 += m_sh4_state->mach;
+		m_sh4_state->mach = Res2;
+		m_sh4_state->macl = Res0;
 	}
-	m_sh4_icount -= 2;
+	m_sh4_state->icount -= 2;
 }
 
 /*  MAC.W   @Rm+,@Rn+ */
@@ -1235,13 +1315,13 @@ inline void sh34_base_device::MAC_W(const UINT16 opcode)
 	INT32 tempm, tempn, dest, src, ans;
 	UINT32 templ;
 
-	tempn = (INT32) RW(m_r[n] );
-	m_r[n] += 2;
-	tempm = (INT32) RW(m_r[m] );
-	m_r[m] += 2;
-	templ = m_macl;
+	tempn = (INT32) RW(m_sh4_state->r[n] );
+	m_sh4_state->r[n] += 2;
+	tempm = (INT32) RW(m_sh4_state->r[m] );
+	m_sh4_state->r[m] += 2;
+	templ = m_sh4_state->macl;
 	tempm = ((INT32) (short) tempn * (INT32) (short) tempm);
-	if ((INT32) m_macl >= 0)
+	if ((INT32) m_sh4_state->macl >= 0)
 		dest = 0;
 	else
 		dest = 1;
@@ -1256,104 +1336,104 @@ inline void sh34_base_device::MAC_W(const UINT16 opcode)
 		tempn = 0xffffffff;
 	}
 	src += dest;
-	m_macl += tempm;
-	if ((INT32) m_macl >= 0)
+	m_sh4_state->macl += tempm;
+	if ((INT32) m_sh4_state->macl >= 0)
 		ans = 0;
 	else
 		ans = 1;
 	ans += dest;
-	if (m_sr & S)
+	if (m_sh4_state->sr & S)
 	{
 		if (ans == 1)
 			{
 				if (src == 0)
-					m_macl = 0x7fffffff;
+					m_sh4_state->macl = 0x7fffffff;
 				if (src == 2)
-					m_macl = 0x80000000;
+					m_sh4_state->macl = 0x80000000;
 			}
 	}
 	else
 	{
-		m_mach += tempn;
-		if (templ > m_macl)
-			m_mach += 1;
+		m_sh4_state->mach += tempn;
+		if (templ > m_sh4_state->macl)
+			m_sh4_state->mach += 1;
 	}
-	m_sh4_icount -= 2;
+	m_sh4_state->icount -= 2;
 }
 
 /*  MOV     Rm,Rn */
 inline void sh34_base_device::MOV(const UINT16 opcode)
 {
-	m_r[Rn] = m_r[Rm];
+	m_sh4_state->r[Rn] = m_sh4_state->r[Rm];
 }
 
 /*  MOV.B   Rm,@Rn */
 inline void sh34_base_device::MOVBS(const UINT16 opcode)
 {
-	m_ea = m_r[Rn];
-	WB(m_ea, m_r[Rm] & 0x000000ff);
+	m_sh4_state->ea = m_sh4_state->r[Rn];
+	WB(m_sh4_state->ea, m_sh4_state->r[Rm] & 0x000000ff);
 }
 
 /*  MOV.W   Rm,@Rn */
 inline void sh34_base_device::MOVWS(const UINT16 opcode)
 {
-	m_ea = m_r[Rn];
-	WW(m_ea, m_r[Rm] & 0x0000ffff);
+	m_sh4_state->ea = m_sh4_state->r[Rn];
+	WW(m_sh4_state->ea, m_sh4_state->r[Rm] & 0x0000ffff);
 }
 
 /*  MOV.L   Rm,@Rn */
 inline void sh34_base_device::MOVLS(const UINT16 opcode)
 {
-	m_ea = m_r[Rn];
-	WL(m_ea, m_r[Rm] );
+	m_sh4_state->ea = m_sh4_state->r[Rn];
+	WL(m_sh4_state->ea, m_sh4_state->r[Rm] );
 }
 
 /*  MOV.B   @Rm,Rn */
 inline void sh34_base_device::MOVBL(const UINT16 opcode)
 {
-	m_ea = m_r[Rm];
-	m_r[Rn] = (UINT32)(INT32)(INT16)(INT8) RB( m_ea );
+	m_sh4_state->ea = m_sh4_state->r[Rm];
+	m_sh4_state->r[Rn] = (UINT32)(INT32)(INT16)(INT8) RB( m_sh4_state->ea );
 }
 
 /*  MOV.W   @Rm,Rn */
 inline void sh34_base_device::MOVWL(const UINT16 opcode)
 {
-	m_ea = m_r[Rm];
-	m_r[Rn] = (UINT32)(INT32)(INT16) RW(m_ea );
+	m_sh4_state->ea = m_sh4_state->r[Rm];
+	m_sh4_state->r[Rn] = (UINT32)(INT32)(INT16) RW(m_sh4_state->ea );
 }
 
 /*  MOV.L   @Rm,Rn */
 inline void sh34_base_device::MOVLL(const UINT16 opcode)
 {
-	m_ea = m_r[Rm];
-	m_r[Rn] = RL(m_ea );
+	m_sh4_state->ea = m_sh4_state->r[Rm];
+	m_sh4_state->r[Rn] = RL(m_sh4_state->ea );
 }
 
 /*  MOV.B   Rm,@-Rn */
 inline void sh34_base_device::MOVBM(const UINT16 opcode)
 {
-	UINT32 data = m_r[Rm] & 0x000000ff;
+	UINT32 data = m_sh4_state->r[Rm] & 0x000000ff;
 
-	m_r[Rn] -= 1;
-	WB(m_r[Rn], data );
+	m_sh4_state->r[Rn] -= 1;
+	WB(m_sh4_state->r[Rn], data );
 }
 
 /*  MOV.W   Rm,@-Rn */
 inline void sh34_base_device::MOVWM(const UINT16 opcode)
 {
-	UINT32 data = m_r[Rm] & 0x0000ffff;
+	UINT32 data = m_sh4_state->r[Rm] & 0x0000ffff;
 
-	m_r[Rn] -= 2;
-	WW(m_r[Rn], data );
+	m_sh4_state->r[Rn] -= 2;
+	WW(m_sh4_state->r[Rn], data );
 }
 
 /*  MOV.L   Rm,@-Rn */
 inline void sh34_base_device::MOVLM(const UINT16 opcode)
 {
-	UINT32 data = m_r[Rm];
+	UINT32 data = m_sh4_state->r[Rm];
 
-	m_r[Rn] -= 4;
-	WL(m_r[Rn], data );
+	m_sh4_state->r[Rn] -= 4;
+	WL(m_sh4_state->r[Rn], data );
 }
 
 /*  MOV.B   @Rm+,Rn */
@@ -1361,9 +1441,9 @@ inline void sh34_base_device::MOVBP(const UINT16 opcode)
 {
 	UINT32 m = Rm; UINT32 n = Rn;
 
-	m_r[n] = (UINT32)(INT32)(INT16)(INT8) RB( m_r[m] );
+	m_sh4_state->r[n] = (UINT32)(INT32)(INT16)(INT8) RB( m_sh4_state->r[m] );
 	if (n != m)
-		m_r[m] += 1;
+		m_sh4_state->r[m] += 1;
 }
 
 /*  MOV.W   @Rm+,Rn */
@@ -1371,9 +1451,9 @@ inline void sh34_base_device::MOVWP(const UINT16 opcode)
 {
 	UINT32 m = Rm; UINT32 n = Rn;
 
-	m_r[n] = (UINT32)(INT32)(INT16) RW(m_r[m] );
+	m_sh4_state->r[n] = (UINT32)(INT32)(INT16) RW(m_sh4_state->r[m] );
 	if (n != m)
-		m_r[m] += 2;
+		m_sh4_state->r[m] += 2;
 }
 
 /*  MOV.L   @Rm+,Rn */
@@ -1381,208 +1461,208 @@ inline void sh34_base_device::MOVLP(const UINT16 opcode)
 {
 	UINT32 m = Rm; UINT32 n = Rn;
 
-	m_r[n] = RL(m_r[m] );
+	m_sh4_state->r[n] = RL(m_sh4_state->r[m] );
 	if (n != m)
-		m_r[m] += 4;
+		m_sh4_state->r[m] += 4;
 }
 
 /*  MOV.B   Rm,@(R0,Rn) */
 inline void sh34_base_device::MOVBS0(const UINT16 opcode)
 {
-	m_ea = m_r[Rn] + m_r[0];
-	WB(m_ea, m_r[Rm] & 0x000000ff );
+	m_sh4_state->ea = m_sh4_state->r[Rn] + m_sh4_state->r[0];
+	WB(m_sh4_state->ea, m_sh4_state->r[Rm] & 0x000000ff );
 }
 
 /*  MOV.W   Rm,@(R0,Rn) */
 inline void sh34_base_device::MOVWS0(const UINT16 opcode)
 {
-	m_ea = m_r[Rn] + m_r[0];
-	WW(m_ea, m_r[Rm] & 0x0000ffff );
+	m_sh4_state->ea = m_sh4_state->r[Rn] + m_sh4_state->r[0];
+	WW(m_sh4_state->ea, m_sh4_state->r[Rm] & 0x0000ffff );
 }
 
 /*  MOV.L   Rm,@(R0,Rn) */
 inline void sh34_base_device::MOVLS0(const UINT16 opcode)
 {
-	m_ea = m_r[Rn] + m_r[0];
-	WL(m_ea, m_r[Rm] );
+	m_sh4_state->ea = m_sh4_state->r[Rn] + m_sh4_state->r[0];
+	WL(m_sh4_state->ea, m_sh4_state->r[Rm] );
 }
 
 /*  MOV.B   @(R0,Rm),Rn */
 inline void sh34_base_device::MOVBL0(const UINT16 opcode)
 {
-	m_ea = m_r[Rm] + m_r[0];
-	m_r[Rn] = (UINT32)(INT32)(INT16)(INT8) RB( m_ea );
+	m_sh4_state->ea = m_sh4_state->r[Rm] + m_sh4_state->r[0];
+	m_sh4_state->r[Rn] = (UINT32)(INT32)(INT16)(INT8) RB( m_sh4_state->ea );
 }
 
 /*  MOV.W   @(R0,Rm),Rn */
 inline void sh34_base_device::MOVWL0(const UINT16 opcode)
 {
-	m_ea = m_r[Rm] + m_r[0];
-	m_r[Rn] = (UINT32)(INT32)(INT16) RW(m_ea );
+	m_sh4_state->ea = m_sh4_state->r[Rm] + m_sh4_state->r[0];
+	m_sh4_state->r[Rn] = (UINT32)(INT32)(INT16) RW(m_sh4_state->ea );
 }
 
 /*  MOV.L   @(R0,Rm),Rn */
 inline void sh34_base_device::MOVLL0(const UINT16 opcode)
 {
-	m_ea = m_r[Rm] + m_r[0];
-	m_r[Rn] = RL(m_ea );
+	m_sh4_state->ea = m_sh4_state->r[Rm] + m_sh4_state->r[0];
+	m_sh4_state->r[Rn] = RL(m_sh4_state->ea );
 }
 
 /*  MOV     #imm,Rn */
 inline void sh34_base_device::MOVI(const UINT16 opcode)
 {
-	m_r[Rn] = (UINT32)(INT32)(INT16)(INT8)(opcode&0xff);
+	m_sh4_state->r[Rn] = (UINT32)(INT32)(INT16)(INT8)(opcode&0xff);
 }
 
 /*  MOV.W   @(disp8,PC),Rn */
 inline void sh34_base_device::MOVWI(const UINT16 opcode)
 {
 	UINT32 disp = opcode & 0xff;
-	m_ea = m_pc + disp * 2 + 2;
-	m_r[Rn] = (UINT32)(INT32)(INT16) RW(m_ea );
+	m_sh4_state->ea = m_sh4_state->pc + disp * 2 + 2;
+	m_sh4_state->r[Rn] = (UINT32)(INT32)(INT16) RW(m_sh4_state->ea );
 }
 
 /*  MOV.L   @(disp8,PC),Rn */
 inline void sh34_base_device::MOVLI(const UINT16 opcode)
 {
 	UINT32 disp = opcode & 0xff;
-	m_ea = ((m_pc + 2) & ~3) + disp * 4;
-	m_r[Rn] = RL(m_ea );
+	m_sh4_state->ea = ((m_sh4_state->pc + 2) & ~3) + disp * 4;
+	m_sh4_state->r[Rn] = RL(m_sh4_state->ea );
 }
 
 /*  MOV.B   @(disp8,GBR),R0 */
 inline void sh34_base_device::MOVBLG(const UINT16 opcode)
 {
 	UINT32 disp = opcode & 0xff;
-	m_ea = m_gbr + disp;
-	m_r[0] = (UINT32)(INT32)(INT16)(INT8) RB( m_ea );
+	m_sh4_state->ea = m_sh4_state->gbr + disp;
+	m_sh4_state->r[0] = (UINT32)(INT32)(INT16)(INT8) RB( m_sh4_state->ea );
 }
 
 /*  MOV.W   @(disp8,GBR),R0 */
 inline void sh34_base_device::MOVWLG(const UINT16 opcode)
 {
 	UINT32 disp = opcode & 0xff;
-	m_ea = m_gbr + disp * 2;
-	m_r[0] = (INT32)(INT16) RW(m_ea );
+	m_sh4_state->ea = m_sh4_state->gbr + disp * 2;
+	m_sh4_state->r[0] = (INT32)(INT16) RW(m_sh4_state->ea );
 }
 
 /*  MOV.L   @(disp8,GBR),R0 */
 inline void sh34_base_device::MOVLLG(const UINT16 opcode)
 {
 	UINT32 disp = opcode & 0xff;
-	m_ea = m_gbr + disp * 4;
-	m_r[0] = RL(m_ea );
+	m_sh4_state->ea = m_sh4_state->gbr + disp * 4;
+	m_sh4_state->r[0] = RL(m_sh4_state->ea );
 }
 
 /*  MOV.B   R0,@(disp8,GBR) */
 inline void sh34_base_device::MOVBSG(const UINT16 opcode)
 {
 	UINT32 disp = opcode & 0xff;
-	m_ea = m_gbr + disp;
-	WB(m_ea, m_r[0] & 0x000000ff );
+	m_sh4_state->ea = m_sh4_state->gbr + disp;
+	WB(m_sh4_state->ea, m_sh4_state->r[0] & 0x000000ff );
 }
 
 /*  MOV.W   R0,@(disp8,GBR) */
 inline void sh34_base_device::MOVWSG(const UINT16 opcode)
 {
 	UINT32 disp = opcode & 0xff;
-	m_ea = m_gbr + disp * 2;
-	WW(m_ea, m_r[0] & 0x0000ffff );
+	m_sh4_state->ea = m_sh4_state->gbr + disp * 2;
+	WW(m_sh4_state->ea, m_sh4_state->r[0] & 0x0000ffff );
 }
 
 /*  MOV.L   R0,@(disp8,GBR) */
 inline void sh34_base_device::MOVLSG(const UINT16 opcode)
 {
 	UINT32 disp = opcode & 0xff;
-	m_ea = m_gbr + disp * 4;
-	WL(m_ea, m_r[0] );
+	m_sh4_state->ea = m_sh4_state->gbr + disp * 4;
+	WL(m_sh4_state->ea, m_sh4_state->r[0] );
 }
 
 /*  MOV.B   R0,@(disp4,Rm) */
 inline void sh34_base_device::MOVBS4(const UINT16 opcode)
 {
 	UINT32 disp = opcode & 0x0f;
-	m_ea = m_r[Rm] + disp;
-	WB(m_ea, m_r[0] & 0x000000ff );
+	m_sh4_state->ea = m_sh4_state->r[Rm] + disp;
+	WB(m_sh4_state->ea, m_sh4_state->r[0] & 0x000000ff );
 }
 
 /*  MOV.W   R0,@(disp4,Rm) */
 inline void sh34_base_device::MOVWS4(const UINT16 opcode)
 {
 	UINT32 disp = opcode & 0x0f;
-	m_ea = m_r[Rm] + disp * 2;
-	WW(m_ea, m_r[0] & 0x0000ffff );
+	m_sh4_state->ea = m_sh4_state->r[Rm] + disp * 2;
+	WW(m_sh4_state->ea, m_sh4_state->r[0] & 0x0000ffff );
 }
 
 /* MOV.L Rm,@(disp4,Rn) */
 inline void sh34_base_device::MOVLS4(const UINT16 opcode)
 {
 	UINT32 disp = opcode & 0x0f;
-	m_ea = m_r[Rn] + disp * 4;
-	WL(m_ea, m_r[Rm] );
+	m_sh4_state->ea = m_sh4_state->r[Rn] + disp * 4;
+	WL(m_sh4_state->ea, m_sh4_state->r[Rm] );
 }
 
 /*  MOV.B   @(disp4,Rm),R0 */
 inline void sh34_base_device::MOVBL4(const UINT16 opcode)
 {
 	UINT32 disp = opcode & 0x0f;
-	m_ea = m_r[Rm] + disp;
-	m_r[0] = (UINT32)(INT32)(INT16)(INT8) RB( m_ea );
+	m_sh4_state->ea = m_sh4_state->r[Rm] + disp;
+	m_sh4_state->r[0] = (UINT32)(INT32)(INT16)(INT8) RB( m_sh4_state->ea );
 }
 
 /*  MOV.W   @(disp4,Rm),R0 */
 inline void sh34_base_device::MOVWL4(const UINT16 opcode)
 {
 	UINT32 disp = opcode & 0x0f;
-	m_ea = m_r[Rm] + disp * 2;
-	m_r[0] = (UINT32)(INT32)(INT16) RW(m_ea );
+	m_sh4_state->ea = m_sh4_state->r[Rm] + disp * 2;
+	m_sh4_state->r[0] = (UINT32)(INT32)(INT16) RW(m_sh4_state->ea );
 }
 
 /*  MOV.L   @(disp4,Rm),Rn */
 inline void sh34_base_device::MOVLL4(const UINT16 opcode)
 {
 	UINT32 disp = opcode & 0x0f;
-	m_ea = m_r[Rm] + disp * 4;
-	m_r[Rn] = RL(m_ea );
+	m_sh4_state->ea = m_sh4_state->r[Rm] + disp * 4;
+	m_sh4_state->r[Rn] = RL(m_sh4_state->ea );
 }
 
 /*  MOVA    @(disp8,PC),R0 */
 inline void sh34_base_device::MOVA(const UINT16 opcode)
 {
 	UINT32 disp = opcode & 0xff;
-	m_ea = ((m_pc + 2) & ~3) + disp * 4;
-	m_r[0] = m_ea;
+	m_sh4_state->ea = ((m_sh4_state->pc + 2) & ~3) + disp * 4;
+	m_sh4_state->r[0] = m_sh4_state->ea;
 }
 
 /*  MOVT    Rn */
 void sh34_base_device::MOVT(const UINT16 opcode)
 {
-	m_r[Rn] = m_sr & T;
+	m_sh4_state->r[Rn] = m_sh4_state->sr & T;
 }
 
 /*  MUL.L   Rm,Rn */
 inline void sh34_base_device::MULL(const UINT16 opcode)
 {
-	m_macl = m_r[Rn] * m_r[Rm];
-	m_sh4_icount--;
+	m_sh4_state->macl = m_sh4_state->r[Rn] * m_sh4_state->r[Rm];
+	m_sh4_state->icount--;
 }
 
 /*  MULS    Rm,Rn */
 inline void sh34_base_device::MULS(const UINT16 opcode)
 {
-	m_macl = (INT16) m_r[Rn] * (INT16) m_r[Rm];
+	m_sh4_state->macl = (INT16) m_sh4_state->r[Rn] * (INT16) m_sh4_state->r[Rm];
 }
 
 /*  MULU    Rm,Rn */
 inline void sh34_base_device::MULU(const UINT16 opcode)
 {
-	m_macl = (UINT16) m_r[Rn] * (UINT16) m_r[Rm];
+	m_sh4_state->macl = (UINT16) m_sh4_state->r[Rn] * (UINT16) m_sh4_state->r[Rm];
 }
 
 /*  NEG     Rm,Rn */
 inline void sh34_base_device::NEG(const UINT16 opcode)
 {
-	m_r[Rn] = 0 - m_r[Rm];
+	m_sh4_state->r[Rn] = 0 - m_sh4_state->r[Rm];
 }
 
 /*  NEGC    Rm,Rn */
@@ -1590,12 +1670,12 @@ inline void sh34_base_device::NEGC(const UINT16 opcode)
 {
 	UINT32 temp;
 
-	temp = m_r[Rm];
-	m_r[Rn] = -temp - (m_sr & T);
-	if (temp || (m_sr & T))
-		m_sr |= T;
+	temp = m_sh4_state->r[Rm];
+	m_sh4_state->r[Rn] = -temp - (m_sh4_state->sr & T);
+	if (temp || (m_sh4_state->sr & T))
+		m_sh4_state->sr |= T;
 	else
-		m_sr &= ~T;
+		m_sh4_state->sr &= ~T;
 }
 
 /*  NOP */
@@ -1606,20 +1686,20 @@ inline void sh34_base_device::NOP(const UINT16 opcode)
 /*  NOT     Rm,Rn */
 inline void sh34_base_device::NOT(const UINT16 opcode)
 {
-	m_r[Rn] = ~m_r[Rm];
+	m_sh4_state->r[Rn] = ~m_sh4_state->r[Rm];
 }
 
 /*  OR      Rm,Rn */
 inline void sh34_base_device::OR(const UINT16 opcode)
 {
-	m_r[Rn] |= m_r[Rm];
+	m_sh4_state->r[Rn] |= m_sh4_state->r[Rm];
 }
 
 /*  OR      #imm,R0 */
 inline void sh34_base_device::ORI(const UINT16 opcode)
 {
-	m_r[0] |= (opcode&0xff);
-	m_sh4_icount -= 2;
+	m_sh4_state->r[0] |= (opcode&0xff);
+	m_sh4_state->icount -= 2;
 }
 
 /*  OR.B    #imm,@(R0,GBR) */
@@ -1627,10 +1707,10 @@ inline void sh34_base_device::ORM(const UINT16 opcode)
 {
 	UINT32 temp;
 
-	m_ea = m_gbr + m_r[0];
-	temp = RB( m_ea );
+	m_sh4_state->ea = m_sh4_state->gbr + m_sh4_state->r[0];
+	temp = RB( m_sh4_state->ea );
 	temp |= (opcode&0xff);
-	WB(m_ea, temp );
+	WB(m_sh4_state->ea, temp );
 }
 
 /*  ROTCL   Rn */
@@ -1640,9 +1720,9 @@ inline void sh34_base_device::ROTCL(const UINT16 opcode)
 
 	UINT32 temp;
 
-	temp = (m_r[n] >> 31) & T;
-	m_r[n] = (m_r[n] << 1) | (m_sr & T);
-	m_sr = (m_sr & ~T) | temp;
+	temp = (m_sh4_state->r[n] >> 31) & T;
+	m_sh4_state->r[n] = (m_sh4_state->r[n] << 1) | (m_sh4_state->sr & T);
+	m_sh4_state->sr = (m_sh4_state->sr & ~T) | temp;
 }
 
 /*  ROTCR   Rn */
@@ -1651,12 +1731,12 @@ inline void sh34_base_device::ROTCR(const UINT16 opcode)
 	UINT32 n = Rn;
 
 	UINT32 temp;
-	temp = (m_sr & T) << 31;
-	if (m_r[n] & T)
-		m_sr |= T;
+	temp = (m_sh4_state->sr & T) << 31;
+	if (m_sh4_state->r[n] & T)
+		m_sh4_state->sr |= T;
 	else
-		m_sr &= ~T;
-	m_r[n] = (m_r[n] >> 1) | temp;
+		m_sh4_state->sr &= ~T;
+	m_sh4_state->r[n] = (m_sh4_state->r[n] >> 1) | temp;
 }
 
 /*  ROTL    Rn */
@@ -1664,8 +1744,8 @@ inline void sh34_base_device::ROTL(const UINT16 opcode)
 {
 	UINT32 n = Rn;
 
-	m_sr = (m_sr & ~T) | ((m_r[n] >> 31) & T);
-	m_r[n] = (m_r[n] << 1) | (m_r[n] >> 31);
+	m_sh4_state->sr = (m_sh4_state->sr & ~T) | ((m_sh4_state->r[n] >> 31) & T);
+	m_sh4_state->r[n] = (m_sh4_state->r[n] << 1) | (m_sh4_state->r[n] >> 31);
 }
 
 /*  ROTR    Rn */
@@ -1673,36 +1753,36 @@ inline void sh34_base_device::ROTR(const UINT16 opcode)
 {
 	UINT32 n = Rn;
 
-	m_sr = (m_sr & ~T) | (m_r[n] & T);
-	m_r[n] = (m_r[n] >> 1) | (m_r[n] << 31);
+	m_sh4_state->sr = (m_sh4_state->sr & ~T) | (m_sh4_state->r[n] & T);
+	m_sh4_state->r[n] = (m_sh4_state->r[n] >> 1) | (m_sh4_state->r[n] << 31);
 }
 
 /*  RTE */
 inline void sh34_base_device::RTE(const UINT16 opcode)
 {
-	m_delay = m_pc;
-	m_pc = m_ea = m_spc;
+	m_sh4_state->delay = m_sh4_state->pc;
+	m_sh4_state->pc = m_sh4_state->ea = m_sh4_state->spc;
 	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
-		sh4_syncronize_register_bank((m_sr & sRB) >> 29);
-	if ((m_ssr & sRB) != (m_sr & sRB))
-		sh4_change_register_bank(m_ssr & sRB ? 1 : 0);
-	m_sr = m_ssr;
-	m_sh4_icount--;
+		sh4_syncronize_register_bank((m_sh4_state->sr & sRB) >> 29);
+	if ((m_sh4_state->ssr & sRB) != (m_sh4_state->sr & sRB))
+		sh4_change_register_bank(m_sh4_state->ssr & sRB ? 1 : 0);
+	m_sh4_state->sr = m_sh4_state->ssr;
+	m_sh4_state->icount--;
 	sh4_exception_recompute();
 }
 
 /*  RTS */
 inline void sh34_base_device::RTS(const UINT16 opcode)
 {
-	m_delay = m_pc;
-	m_pc = m_ea = m_pr;
-	m_sh4_icount--;
+	m_sh4_state->delay = m_sh4_state->pc;
+	m_sh4_state->pc = m_sh4_state->ea = m_sh4_state->pr;
+	m_sh4_state->icount--;
 }
 
 /*  SETT */
 inline void sh34_base_device::SETT(const UINT16 opcode)
 {
-	m_sr |= T;
+	m_sh4_state->sr |= T;
 }
 
 /*  SHAL    Rn      (same as SHLL) */
@@ -1710,8 +1790,8 @@ inline void sh34_base_device::SHAL(const UINT16 opcode)
 {
 	UINT32 n = Rn;
 
-	m_sr = (m_sr & ~T) | ((m_r[n] >> 31) & T);
-	m_r[n] <<= 1;
+	m_sh4_state->sr = (m_sh4_state->sr & ~T) | ((m_sh4_state->r[n] >> 31) & T);
+	m_sh4_state->r[n] <<= 1;
 }
 
 /*  SHAR    Rn */
@@ -1719,8 +1799,8 @@ inline void sh34_base_device::SHAR(const UINT16 opcode)
 {
 	UINT32 n = Rn;
 
-	m_sr = (m_sr & ~T) | (m_r[n] & T);
-	m_r[n] = (UINT32)((INT32)m_r[n] >> 1);
+	m_sh4_state->sr = (m_sh4_state->sr & ~T) | (m_sh4_state->r[n] & T);
+	m_sh4_state->r[n] = (UINT32)((INT32)m_sh4_state->r[n] >> 1);
 }
 
 /*  SHLL    Rn      (same as SHAL) */
@@ -1728,26 +1808,26 @@ inline void sh34_base_device::SHLL(const UINT16 opcode)
 {
 	UINT32 n = Rn;
 
-	m_sr = (m_sr & ~T) | ((m_r[n] >> 31) & T);
-	m_r[n] <<= 1;
+	m_sh4_state->sr = (m_sh4_state->sr & ~T) | ((m_sh4_state->r[n] >> 31) & T);
+	m_sh4_state->r[n] <<= 1;
 }
 
 /*  SHLL2   Rn */
 inline void sh34_base_device::SHLL2(const UINT16 opcode)
 {
-	m_r[Rn] <<= 2;
+	m_sh4_state->r[Rn] <<= 2;
 }
 
 /*  SHLL8   Rn */
 inline void sh34_base_device::SHLL8(const UINT16 opcode)
 {
-	m_r[Rn] <<= 8;
+	m_sh4_state->r[Rn] <<= 8;
 }
 
 /*  SHLL16  Rn */
 inline void sh34_base_device::SHLL16(const UINT16 opcode)
 {
-	m_r[Rn] <<= 16;
+	m_sh4_state->r[Rn] <<= 16;
 }
 
 /*  SHLR    Rn */
@@ -1755,26 +1835,26 @@ inline void sh34_base_device::SHLR(const UINT16 opcode)
 {
 	UINT32 n = Rn;
 
-	m_sr = (m_sr & ~T) | (m_r[n] & T);
-	m_r[n] >>= 1;
+	m_sh4_state->sr = (m_sh4_state->sr & ~T) | (m_sh4_state->r[n] & T);
+	m_sh4_state->r[n] >>= 1;
 }
 
 /*  SHLR2   Rn */
 inline void sh34_base_device::SHLR2(const UINT16 opcode)
 {
-	m_r[Rn] >>= 2;
+	m_sh4_state->r[Rn] >>= 2;
 }
 
 /*  SHLR8   Rn */
 inline void sh34_base_device::SHLR8(const UINT16 opcode)
 {
-	m_r[Rn] >>= 8;
+	m_sh4_state->r[Rn] >>= 8;
 }
 
 /*  SHLR16  Rn */
 inline void sh34_base_device::SHLR16(const UINT16 opcode)
 {
-	m_r[Rn] >>= 16;
+	m_sh4_state->r[Rn] >>= 16;
 }
 
 /*  SLEEP */
@@ -1784,8 +1864,8 @@ inline void sh34_base_device::SLEEP(const UINT16 opcode)
 	/* 1 = enters into power-down mode */
 	/* 2 = go out the power-down mode after an exception */
 	if(m_sleep_mode != 2)
-		m_pc -= 2;
-	m_sh4_icount -= 2;
+		m_sh4_state->pc -= 2;
+	m_sh4_state->icount -= 2;
 	/* Wait_for_exception; */
 	if(m_sleep_mode == 0)
 		m_sleep_mode = 1;
@@ -1796,19 +1876,19 @@ inline void sh34_base_device::SLEEP(const UINT16 opcode)
 /*  STC     SR,Rn */
 inline void sh34_base_device::STCSR(const UINT16 opcode)
 {
-	m_r[Rn] = m_sr;
+	m_sh4_state->r[Rn] = m_sh4_state->sr;
 }
 
 /*  STC     GBR,Rn */
 inline void sh34_base_device::STCGBR(const UINT16 opcode)
 {
-	m_r[Rn] = m_gbr;
+	m_sh4_state->r[Rn] = m_sh4_state->gbr;
 }
 
 /*  STC     VBR,Rn */
 inline void sh34_base_device::STCVBR(const UINT16 opcode)
 {
-	m_r[Rn] = m_vbr;
+	m_sh4_state->r[Rn] = m_sh4_state->vbr;
 }
 
 /*  STC.L   SR,@-Rn */
@@ -1816,10 +1896,10 @@ inline void sh34_base_device::STCMSR(const UINT16 opcode)
 {
 	UINT32 n = Rn;
 
-	m_r[n] -= 4;
-	m_ea = m_r[n];
-	WL(m_ea, m_sr );
-	m_sh4_icount--;
+	m_sh4_state->r[n] -= 4;
+	m_sh4_state->ea = m_sh4_state->r[n];
+	WL(m_sh4_state->ea, m_sh4_state->sr );
+	m_sh4_state->icount--;
 }
 
 /*  STC.L   GBR,@-Rn */
@@ -1827,10 +1907,10 @@ inline void sh34_base_device::STCMGBR(const UINT16 opcode)
 {
 	UINT32 n = Rn;
 
-	m_r[n] -= 4;
-	m_ea = m_r[n];
-	WL(m_ea, m_gbr );
-	m_sh4_icount--;
+	m_sh4_state->r[n] -= 4;
+	m_sh4_state->ea = m_sh4_state->r[n];
+	WL(m_sh4_state->ea, m_sh4_state->gbr );
+	m_sh4_state->icount--;
 }
 
 /*  STC.L   VBR,@-Rn */
@@ -1838,28 +1918,28 @@ inline void sh34_base_device::STCMVBR(const UINT16 opcode)
 {
 	UINT32 n = Rn;
 
-	m_r[n] -= 4;
-	m_ea = m_r[n];
-	WL(m_ea, m_vbr );
-	m_sh4_icount--;
+	m_sh4_state->r[n] -= 4;
+	m_sh4_state->ea = m_sh4_state->r[n];
+	WL(m_sh4_state->ea, m_sh4_state->vbr );
+	m_sh4_state->icount--;
 }
 
 /*  STS     MACH,Rn */
 inline void sh34_base_device::STSMACH(const UINT16 opcode)
 {
-	m_r[Rn] = m_mach;
+	m_sh4_state->r[Rn] = m_sh4_state->mach;
 }
 
 /*  STS     MACL,Rn */
 inline void sh34_base_device::STSMACL(const UINT16 opcode)
 {
-	m_r[Rn] = m_macl;
+	m_sh4_state->r[Rn] = m_sh4_state->macl;
 }
 
 /*  STS     PR,Rn */
 inline void sh34_base_device::STSPR(const UINT16 opcode)
 {
-	m_r[Rn] = m_pr;
+	m_sh4_state->r[Rn] = m_sh4_state->pr;
 }
 
 /*  STS.L   MACH,@-Rn */
@@ -1867,9 +1947,9 @@ inline void sh34_base_device::STSMMACH(const UINT16 opcode)
 {
 	UINT32 n = Rn;
 
-	m_r[n] -= 4;
-	m_ea = m_r[n];
-	WL(m_ea, m_mach );
+	m_sh4_state->r[n] -= 4;
+	m_sh4_state->ea = m_sh4_state->r[n];
+	WL(m_sh4_state->ea, m_sh4_state->mach );
 }
 
 /*  STS.L   MACL,@-Rn */
@@ -1877,9 +1957,9 @@ inline void sh34_base_device::STSMMACL(const UINT16 opcode)
 {
 	UINT32 n = Rn;
 
-	m_r[n] -= 4;
-	m_ea = m_r[n];
-	WL(m_ea, m_macl );
+	m_sh4_state->r[n] -= 4;
+	m_sh4_state->ea = m_sh4_state->r[n];
+	WL(m_sh4_state->ea, m_sh4_state->macl );
 }
 
 /*  STS.L   PR,@-Rn */
@@ -1887,15 +1967,15 @@ inline void sh34_base_device::STSMPR(const UINT16 opcode)
 {
 	UINT32 n = Rn;
 
-	m_r[n] -= 4;
-	m_ea = m_r[n];
-	WL(m_ea, m_pr );
+	m_sh4_state->r[n] -= 4;
+	m_sh4_state->ea = m_sh4_state->r[n];
+	WL(m_sh4_state->ea, m_sh4_state->pr );
 }
 
 /*  SUB     Rm,Rn */
 inline void sh34_base_device::SUB(const UINT16 opcode)
 {
-	m_r[Rn] -= m_r[Rm];
+	m_sh4_state->r[Rn] -= m_sh4_state->r[Rm];
 }
 
 /*  SUBC    Rm,Rn */
@@ -1905,15 +1985,15 @@ inline void sh34_base_device::SUBC(const UINT16 opcode)
 
 	UINT32 tmp0, tmp1;
 
-	tmp1 = m_r[n] - m_r[m];
-	tmp0 = m_r[n];
-	m_r[n] = tmp1 - (m_sr & T);
+	tmp1 = m_sh4_state->r[n] - m_sh4_state->r[m];
+	tmp0 = m_sh4_state->r[n];
+	m_sh4_state->r[n] = tmp1 - (m_sh4_state->sr & T);
 	if (tmp0 < tmp1)
-		m_sr |= T;
+		m_sh4_state->sr |= T;
 	else
-		m_sr &= ~T;
-	if (tmp1 < m_r[n])
-		m_sr |= T;
+		m_sh4_state->sr &= ~T;
+	if (tmp1 < m_sh4_state->r[n])
+		m_sh4_state->sr |= T;
 }
 
 /*  SUBV    Rm,Rn */
@@ -1923,17 +2003,17 @@ inline void sh34_base_device::SUBV(const UINT16 opcode)
 
 	INT32 dest, src, ans;
 
-	if ((INT32) m_r[n] >= 0)
+	if ((INT32) m_sh4_state->r[n] >= 0)
 		dest = 0;
 	else
 		dest = 1;
-	if ((INT32) m_r[m] >= 0)
+	if ((INT32) m_sh4_state->r[m] >= 0)
 		src = 0;
 	else
 		src = 1;
 	src += dest;
-	m_r[n] -= m_r[m];
-	if ((INT32) m_r[n] >= 0)
+	m_sh4_state->r[n] -= m_sh4_state->r[m];
+	if ((INT32) m_sh4_state->r[n] >= 0)
 		ans = 0;
 	else
 		ans = 1;
@@ -1941,12 +2021,12 @@ inline void sh34_base_device::SUBV(const UINT16 opcode)
 	if (src == 1)
 	{
 		if (ans == 1)
-			m_sr |= T;
+			m_sh4_state->sr |= T;
 		else
-			m_sr &= ~T;
+			m_sh4_state->sr &= ~T;
 	}
 	else
-		m_sr &= ~T;
+		m_sh4_state->sr &= ~T;
 }
 
 /*  SWAP.B  Rm,Rn */
@@ -1956,10 +2036,10 @@ inline void sh34_base_device::SWAPB(const UINT16 opcode)
 
 	UINT32 temp0, temp1;
 
-	temp0 = m_r[m] & 0xffff0000;
-	temp1 = (m_r[m] & 0x000000ff) << 8;
-	m_r[n] = (m_r[m] >> 8) & 0x000000ff;
-	m_r[n] = m_r[n] | temp1 | temp0;
+	temp0 = m_sh4_state->r[m] & 0xffff0000;
+	temp1 = (m_sh4_state->r[m] & 0x000000ff) << 8;
+	m_sh4_state->r[n] = (m_sh4_state->r[m] >> 8) & 0x000000ff;
+	m_sh4_state->r[n] = m_sh4_state->r[n] | temp1 | temp0;
 }
 
 /*  SWAP.W  Rm,Rn */
@@ -1969,8 +2049,8 @@ inline void sh34_base_device::SWAPW(const UINT16 opcode)
 
 	UINT32 temp;
 
-	temp = (m_r[m] >> 16) & 0x0000ffff;
-	m_r[n] = (m_r[m] << 16) | temp;
+	temp = (m_sh4_state->r[m] >> 16) & 0x0000ffff;
+	m_sh4_state->r[n] = (m_sh4_state->r[m] << 16) | temp;
 }
 
 /*  TAS.B   @Rn */
@@ -1979,17 +2059,17 @@ inline void sh34_base_device::TAS(const UINT16 opcode)
 	UINT32 n = Rn;
 
 	UINT32 temp;
-	m_ea = m_r[n];
+	m_sh4_state->ea = m_sh4_state->r[n];
 	/* Bus Lock enable */
-	temp = RB( m_ea );
+	temp = RB( m_sh4_state->ea );
 	if (temp == 0)
-		m_sr |= T;
+		m_sh4_state->sr |= T;
 	else
-		m_sr &= ~T;
+		m_sh4_state->sr &= ~T;
 	temp |= 0x80;
 	/* Bus Lock disable */
-	WB(m_ea, temp );
-	m_sh4_icount -= 3;
+	WB(m_sh4_state->ea, temp );
+	m_sh4_state->icount -= 3;
 }
 
 /*  TRAPA   #imm */
@@ -2007,17 +2087,17 @@ inline void sh34_base_device::TRAPA(const UINT16 opcode)
 	}
 
 
-	m_ssr = m_sr;
-	m_spc = m_pc;
-	m_sgr = m_r[15];
+	m_sh4_state->ssr = m_sh4_state->sr;
+	m_sh4_state->spc = m_sh4_state->pc;
+	m_sh4_state->sgr = m_sh4_state->r[15];
 
-	m_sr |= MD;
+	m_sh4_state->sr |= MD;
 	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
-		sh4_syncronize_register_bank((m_sr & sRB) >> 29);
-	if (!(m_sr & sRB))
+		sh4_syncronize_register_bank((m_sh4_state->sr & sRB) >> 29);
+	if (!(m_sh4_state->sr & sRB))
 		sh4_change_register_bank(1);
-	m_sr |= sRB;
-	m_sr |= BL;
+	m_sh4_state->sr |= sRB;
+	m_sh4_state->sr |= BL;
 	sh4_exception_recompute();
 
 	if (m_cpu_type == CPU_TYPE_SH4)
@@ -2029,18 +2109,18 @@ inline void sh34_base_device::TRAPA(const UINT16 opcode)
 		m_sh3internal_upper[SH3_EXPEVT_ADDR] = 0x00000160;
 	}
 
-	m_pc = m_vbr + 0x00000100;
+	m_sh4_state->pc = m_sh4_state->vbr + 0x00000100;
 
-	m_sh4_icount -= 7;
+	m_sh4_state->icount -= 7;
 }
 
 /*  TST     Rm,Rn */
 inline void sh34_base_device::TST(const UINT16 opcode)
 {
-	if ((m_r[Rn] & m_r[Rm]) == 0)
-		m_sr |= T;
+	if ((m_sh4_state->r[Rn] & m_sh4_state->r[Rm]) == 0)
+		m_sh4_state->sr |= T;
 	else
-		m_sr &= ~T;
+		m_sh4_state->sr &= ~T;
 }
 
 /*  TST     #imm,R0 */
@@ -2048,10 +2128,10 @@ inline void sh34_base_device::TSTI(const UINT16 opcode)
 {
 	UINT32 imm = opcode & 0xff;
 
-	if ((imm & m_r[0]) == 0)
-		m_sr |= T;
+	if ((imm & m_sh4_state->r[0]) == 0)
+		m_sh4_state->sr |= T;
 	else
-		m_sr &= ~T;
+		m_sh4_state->sr &= ~T;
 }
 
 /*  TST.B   #imm,@(R0,GBR) */
@@ -2059,25 +2139,25 @@ inline void sh34_base_device::TSTM(const UINT16 opcode)
 {
 	UINT32 imm = opcode & 0xff;
 
-	m_ea = m_gbr + m_r[0];
-	if ((imm & RB( m_ea )) == 0)
-		m_sr |= T;
+	m_sh4_state->ea = m_sh4_state->gbr + m_sh4_state->r[0];
+	if ((imm & RB( m_sh4_state->ea )) == 0)
+		m_sh4_state->sr |= T;
 	else
-		m_sr &= ~T;
-	m_sh4_icount -= 2;
+		m_sh4_state->sr &= ~T;
+	m_sh4_state->icount -= 2;
 }
 
 /*  XOR     Rm,Rn */
 inline void sh34_base_device::XOR(const UINT16 opcode)
 {
-	m_r[Rn] ^= m_r[Rm];
+	m_sh4_state->r[Rn] ^= m_sh4_state->r[Rm];
 }
 
 /*  XOR     #imm,R0 */
 inline void sh34_base_device::XORI(const UINT16 opcode)
 {
 	UINT32 imm = opcode & 0xff;
-	m_r[0] ^= imm;
+	m_sh4_state->r[0] ^= imm;
 }
 
 /*  XOR.B   #imm,@(R0,GBR) */
@@ -2086,11 +2166,11 @@ inline void sh34_base_device::XORM(const UINT16 opcode)
 	UINT32 imm = opcode & 0xff;
 	UINT32 temp;
 
-	m_ea = m_gbr + m_r[0];
-	temp = RB( m_ea );
+	m_sh4_state->ea = m_sh4_state->gbr + m_sh4_state->r[0];
+	temp = RB( m_sh4_state->ea );
 	temp ^= imm;
-	WB(m_ea, temp );
-	m_sh4_icount -= 2;
+	WB(m_sh4_state->ea, temp );
+	m_sh4_state->icount -= 2;
 }
 
 /*  XTRCT   Rm,Rn */
@@ -2100,45 +2180,45 @@ inline void sh34_base_device::XTRCT(const UINT16 opcode)
 
 	UINT32 temp;
 
-	temp = (m_r[m] << 16) & 0xffff0000;
-	m_r[n] = (m_r[n] >> 16) & 0x0000ffff;
-	m_r[n] |= temp;
+	temp = (m_sh4_state->r[m] << 16) & 0xffff0000;
+	m_sh4_state->r[n] = (m_sh4_state->r[n] >> 16) & 0x0000ffff;
+	m_sh4_state->r[n] |= temp;
 }
 
 /*  STC     SSR,Rn */
 inline void sh34_base_device::STCSSR(const UINT16 opcode)
 {
-	m_r[Rn] = m_ssr;
+	m_sh4_state->r[Rn] = m_sh4_state->ssr;
 }
 
 /*  STC     SPC,Rn */
 inline void sh34_base_device::STCSPC(const UINT16 opcode)
 {
-	m_r[Rn] = m_spc;
+	m_sh4_state->r[Rn] = m_sh4_state->spc;
 }
 
 /*  STC     SGR,Rn */
 inline void sh34_base_device::STCSGR(const UINT16 opcode)
 {
-	m_r[Rn] = m_sgr;
+	m_sh4_state->r[Rn] = m_sh4_state->sgr;
 }
 
 /*  STS     FPUL,Rn */
 inline void sh34_base_device::STSFPUL(const UINT16 opcode)
 {
-	m_r[Rn] = m_fpul;
+	m_sh4_state->r[Rn] = m_sh4_state->fpul;
 }
 
 /*  STS     FPSCR,Rn */
 inline void sh34_base_device::STSFPSCR(const UINT16 opcode)
 {
-	m_r[Rn] = m_fpscr & 0x003FFFFF;
+	m_sh4_state->r[Rn] = m_sh4_state->fpscr & 0x003FFFFF;
 }
 
 /*  STC     DBR,Rn */
 inline void sh34_base_device::STCDBR(const UINT16 opcode)
 {
-	m_r[Rn] = m_dbr;
+	m_sh4_state->r[Rn] = m_sh4_state->dbr;
 }
 
 /*  STCRBANK   Rm_BANK,Rn */
@@ -2146,7 +2226,7 @@ inline void sh34_base_device::STCRBANK(const UINT16 opcode)
 {
 	UINT32 m = Rm;
 
-	m_r[Rn] = m_rbnk[m_sr&sRB ? 0 : 1][m & 7];
+	m_sh4_state->r[Rn] = m_sh4_state->rbnk[m_sh4_state->sr&sRB ? 0 : 1][m & 7];
 }
 
 /*  STCMRBANK   Rm_BANK,@-Rn */
@@ -2154,27 +2234,27 @@ inline void sh34_base_device::STCMRBANK(const UINT16 opcode)
 {
 	UINT32 m = Rm; UINT32 n = Rn;
 
-	m_r[n] -= 4;
-	m_ea = m_r[n];
-	WL(m_ea, m_rbnk[m_sr&sRB ? 0 : 1][m & 7]);
-	m_sh4_icount--;
+	m_sh4_state->r[n] -= 4;
+	m_sh4_state->ea = m_sh4_state->r[n];
+	WL(m_sh4_state->ea, m_sh4_state->rbnk[m_sh4_state->sr&sRB ? 0 : 1][m & 7]);
+	m_sh4_state->icount--;
 }
 
 /*  MOVCA.L     R0,@Rn */
 inline void sh34_base_device::MOVCAL(const UINT16 opcode)
 {
-	m_ea = m_r[Rn];
-	WL(m_ea, m_r[0] );
+	m_sh4_state->ea = m_sh4_state->r[Rn];
+	WL(m_sh4_state->ea, m_sh4_state->r[0] );
 }
 
 inline void sh34_base_device::CLRS(const UINT16 opcode)
 {
-	m_sr &= ~S;
+	m_sh4_state->sr &= ~S;
 }
 
 inline void sh34_base_device::SETS(const UINT16 opcode)
 {
-	m_sr |= S;
+	m_sh4_state->sr |= S;
 }
 
 /*  STS.L   SGR,@-Rn */
@@ -2182,9 +2262,9 @@ inline void sh34_base_device::STCMSGR(const UINT16 opcode)
 {
 	UINT32 n = Rn;
 
-	m_r[n] -= 4;
-	m_ea = m_r[n];
-	WL(m_ea, m_sgr );
+	m_sh4_state->r[n] -= 4;
+	m_sh4_state->ea = m_sh4_state->r[n];
+	WL(m_sh4_state->ea, m_sh4_state->sgr );
 }
 
 /*  STS.L   FPUL,@-Rn */
@@ -2192,9 +2272,9 @@ inline void sh34_base_device::STSMFPUL(const UINT16 opcode)
 {
 	UINT32 n = Rn;
 
-	m_r[n] -= 4;
-	m_ea = m_r[n];
-	WL(m_ea, m_fpul );
+	m_sh4_state->r[n] -= 4;
+	m_sh4_state->ea = m_sh4_state->r[n];
+	WL(m_sh4_state->ea, m_sh4_state->fpul );
 }
 
 /*  STS.L   FPSCR,@-Rn */
@@ -2202,9 +2282,9 @@ inline void sh34_base_device::STSMFPSCR(const UINT16 opcode)
 {
 	UINT32 n = Rn;
 
-	m_r[n] -= 4;
-	m_ea = m_r[n];
-	WL(m_ea, m_fpscr & 0x003FFFFF);
+	m_sh4_state->r[n] -= 4;
+	m_sh4_state->ea = m_sh4_state->r[n];
+	WL(m_sh4_state->ea, m_sh4_state->fpscr & 0x003FFFFF);
 }
 
 /*  STC.L   DBR,@-Rn */
@@ -2212,9 +2292,9 @@ inline void sh34_base_device::STCMDBR(const UINT16 opcode)
 {
 	UINT32 n = Rn;
 
-	m_r[n] -= 4;
-	m_ea = m_r[n];
-	WL(m_ea, m_dbr );
+	m_sh4_state->r[n] -= 4;
+	m_sh4_state->ea = m_sh4_state->r[n];
+	WL(m_sh4_state->ea, m_sh4_state->dbr );
 }
 
 /*  STC.L   SSR,@-Rn */
@@ -2222,9 +2302,9 @@ inline void sh34_base_device::STCMSSR(const UINT16 opcode)
 {
 	UINT32 n = Rn;
 
-	m_r[n] -= 4;
-	m_ea = m_r[n];
-	WL(m_ea, m_ssr );
+	m_sh4_state->r[n] -= 4;
+	m_sh4_state->ea = m_sh4_state->r[n];
+	WL(m_sh4_state->ea, m_sh4_state->ssr );
 }
 
 /*  STC.L   SPC,@-Rn */
@@ -2232,17 +2312,17 @@ inline void sh34_base_device::STCMSPC(const UINT16 opcode)
 {
 	UINT32 n = Rn;
 
-	m_r[n] -= 4;
-	m_ea = m_r[n];
-	WL(m_ea, m_spc );
+	m_sh4_state->r[n] -= 4;
+	m_sh4_state->ea = m_sh4_state->r[n];
+	WL(m_sh4_state->ea, m_sh4_state->spc );
 }
 
 /*  LDS.L   @Rm+,FPUL */
 inline void sh34_base_device::LDSMFPUL(const UINT16 opcode)
 {
-	m_ea = m_r[Rn];
-	m_fpul = RL(m_ea );
-	m_r[Rn] += 4;
+	m_sh4_state->ea = m_sh4_state->r[Rn];
+	m_sh4_state->fpul = RL(m_sh4_state->ea );
+	m_sh4_state->r[Rn] += 4;
 }
 
 /*  LDS.L   @Rm+,FPSCR */
@@ -2250,27 +2330,27 @@ inline void sh34_base_device::LDSMFPSCR(const UINT16 opcode)
 {
 	UINT32 s;
 
-	s = m_fpscr;
-	m_ea = m_r[Rn];
-	m_fpscr = RL(m_ea );
-	m_fpscr &= 0x003FFFFF;
-	m_r[Rn] += 4;
-	if ((s & FR) != (m_fpscr & FR))
+	s = m_sh4_state->fpscr;
+	m_sh4_state->ea = m_sh4_state->r[Rn];
+	m_sh4_state->fpscr = RL(m_sh4_state->ea );
+	m_sh4_state->fpscr &= 0x003FFFFF;
+	m_sh4_state->r[Rn] += 4;
+	if ((s & FR) != (m_sh4_state->fpscr & FR))
 		sh4_swap_fp_registers();
 #ifdef LSB_FIRST
-	if ((s & PR) != (m_fpscr & PR))
+	if ((s & PR) != (m_sh4_state->fpscr & PR))
 		sh4_swap_fp_couples();
 #endif
-	m_fpu_sz = (m_fpscr & SZ) ? 1 : 0;
-	m_fpu_pr = (m_fpscr & PR) ? 1 : 0;
+	m_fpu_sz = (m_sh4_state->fpscr & SZ) ? 1 : 0;
+	m_fpu_pr = (m_sh4_state->fpscr & PR) ? 1 : 0;
 }
 
 /*  LDC.L   @Rm+,DBR */
 inline void sh34_base_device::LDCMDBR(const UINT16 opcode)
 {
-	m_ea = m_r[Rn];
-	m_dbr = RL(m_ea );
-	m_r[Rn] += 4;
+	m_sh4_state->ea = m_sh4_state->r[Rn];
+	m_sh4_state->dbr = RL(m_sh4_state->ea );
+	m_sh4_state->r[Rn] += 4;
 }
 
 /*  LDC.L   @Rn+,Rm_BANK */
@@ -2278,31 +2358,31 @@ inline void sh34_base_device::LDCMRBANK(const UINT16 opcode)
 {
 	UINT32 m = Rm; UINT32 n = Rn;
 
-	m_ea = m_r[n];
-	m_rbnk[m_sr&sRB ? 0 : 1][m & 7] = RL(m_ea );
-	m_r[n] += 4;
+	m_sh4_state->ea = m_sh4_state->r[n];
+	m_sh4_state->rbnk[m_sh4_state->sr&sRB ? 0 : 1][m & 7] = RL(m_sh4_state->ea );
+	m_sh4_state->r[n] += 4;
 }
 
 /*  LDC.L   @Rm+,SSR */
 inline void sh34_base_device::LDCMSSR(const UINT16 opcode)
 {
-	m_ea = m_r[Rn];
-	m_ssr = RL(m_ea );
-	m_r[Rn] += 4;
+	m_sh4_state->ea = m_sh4_state->r[Rn];
+	m_sh4_state->ssr = RL(m_sh4_state->ea );
+	m_sh4_state->r[Rn] += 4;
 }
 
 /*  LDC.L   @Rm+,SPC */
 inline void sh34_base_device::LDCMSPC(const UINT16 opcode)
 {
-	m_ea = m_r[Rn];
-	m_spc = RL(m_ea );
-	m_r[Rn] += 4;
+	m_sh4_state->ea = m_sh4_state->r[Rn];
+	m_sh4_state->spc = RL(m_sh4_state->ea );
+	m_sh4_state->r[Rn] += 4;
 }
 
 /*  LDS     Rm,FPUL */
 inline void sh34_base_device::LDSFPUL(const UINT16 opcode)
 {
-	m_fpul = m_r[Rn];
+	m_sh4_state->fpul = m_sh4_state->r[Rn];
 }
 
 /*  LDS     Rm,FPSCR */
@@ -2310,22 +2390,22 @@ inline void sh34_base_device::LDSFPSCR(const UINT16 opcode)
 {
 	UINT32 s;
 
-	s = m_fpscr;
-	m_fpscr = m_r[Rn] & 0x003FFFFF;
-	if ((s & FR) != (m_fpscr & FR))
+	s = m_sh4_state->fpscr;
+	m_sh4_state->fpscr = m_sh4_state->r[Rn] & 0x003FFFFF;
+	if ((s & FR) != (m_sh4_state->fpscr & FR))
 		sh4_swap_fp_registers();
 #ifdef LSB_FIRST
-	if ((s & PR) != (m_fpscr & PR))
+	if ((s & PR) != (m_sh4_state->fpscr & PR))
 		sh4_swap_fp_couples();
 #endif
-	m_fpu_sz = (m_fpscr & SZ) ? 1 : 0;
-	m_fpu_pr = (m_fpscr & PR) ? 1 : 0;
+	m_fpu_sz = (m_sh4_state->fpscr & SZ) ? 1 : 0;
+	m_fpu_pr = (m_sh4_state->fpscr & PR) ? 1 : 0;
 }
 
 /*  LDC     Rm,DBR */
 inline void sh34_base_device::LDCDBR(const UINT16 opcode)
 {
-	m_dbr = m_r[Rn];
+	m_sh4_state->dbr = m_sh4_state->r[Rn];
 }
 
 /*  SHAD    Rm,Rn */
@@ -2333,15 +2413,15 @@ inline void sh34_base_device::SHAD(const UINT16 opcode)
 {
 	UINT32 m = Rm; UINT32 n = Rn;
 
-	if ((m_r[m] & 0x80000000) == 0)
-		m_r[n] = m_r[n] << (m_r[m] & 0x1F);
-	else if ((m_r[m] & 0x1F) == 0) {
-		if ((m_r[n] & 0x80000000) == 0)
-			m_r[n] = 0;
+	if ((m_sh4_state->r[m] & 0x80000000) == 0)
+		m_sh4_state->r[n] = m_sh4_state->r[n] << (m_sh4_state->r[m] & 0x1F);
+	else if ((m_sh4_state->r[m] & 0x1F) == 0) {
+		if ((m_sh4_state->r[n] & 0x80000000) == 0)
+			m_sh4_state->r[n] = 0;
 		else
-			m_r[n] = 0xFFFFFFFF;
+			m_sh4_state->r[n] = 0xFFFFFFFF;
 	} else
-		m_r[n]=(INT32)m_r[n] >> ((~m_r[m] & 0x1F)+1);
+		m_sh4_state->r[n]=(INT32)m_sh4_state->r[n] >> ((~m_sh4_state->r[m] & 0x1F)+1);
 }
 
 /*  SHLD    Rm,Rn */
@@ -2349,12 +2429,12 @@ inline void sh34_base_device::SHLD(const UINT16 opcode)
 {
 	UINT32 m = Rm; UINT32 n = Rn;
 
-	if ((m_r[m] & 0x80000000) == 0)
-		m_r[n] = m_r[n] << (m_r[m] & 0x1F);
-	else if ((m_r[m] & 0x1F) == 0)
-		m_r[n] = 0;
+	if ((m_sh4_state->r[m] & 0x80000000) == 0)
+		m_sh4_state->r[n] = m_sh4_state->r[n] << (m_sh4_state->r[m] & 0x1F);
+	else if ((m_sh4_state->r[m] & 0x1F) == 0)
+		m_sh4_state->r[n] = 0;
 	else
-		m_r[n] = m_r[n] >> ((~m_r[m] & 0x1F)+1);
+		m_sh4_state->r[n] = m_sh4_state->r[n] >> ((~m_sh4_state->r[m] & 0x1F)+1);
 }
 
 /*  LDCRBANK   Rn,Rm_BANK */
@@ -2362,19 +2442,19 @@ inline void sh34_base_device::LDCRBANK(const UINT16 opcode)
 {
 	UINT32 m = Rm;
 
-	m_rbnk[m_sr&sRB ? 0 : 1][m & 7] = m_r[Rn];
+	m_sh4_state->rbnk[m_sh4_state->sr&sRB ? 0 : 1][m & 7] = m_sh4_state->r[Rn];
 }
 
 /*  LDC     Rm,SSR */
 inline void sh34_base_device::LDCSSR(const UINT16 opcode)
 {
-	m_ssr = m_r[Rn];
+	m_sh4_state->ssr = m_sh4_state->r[Rn];
 }
 
 /*  LDC     Rm,SPC */
 inline void sh34_base_device::LDCSPC(const UINT16 opcode)
 {
-	m_spc = m_r[Rn];
+	m_sh4_state->spc = m_sh4_state->r[Rn];
 }
 
 /*  PREF     @Rn */
@@ -2383,7 +2463,7 @@ inline void sh34_base_device::PREFM(const UINT16 opcode)
 	int a;
 	UINT32 addr,dest,sq;
 
-	addr = m_r[Rn]; // address
+	addr = m_sh4_state->r[Rn]; // address
 	if ((addr >= 0xE0000000) && (addr <= 0xE3FFFFFF))
 	{
 		if (m_sh4_mmu_enabled)
@@ -2462,30 +2542,30 @@ inline void sh34_base_device::FMOVMRIFR(const UINT16 opcode)
 
 	if (m_fpu_pr) { /* PR = 1 */
 		n = n & 14;
-		m_ea = m_r[m];
-		m_r[m] += 8;
-		m_xf[n+NATIVE_ENDIAN_VALUE_LE_BE(1,0)] = RL(m_ea );
-		m_xf[n+NATIVE_ENDIAN_VALUE_LE_BE(0,1)] = RL(m_ea+4 );
+		m_sh4_state->ea = m_sh4_state->r[m];
+		m_sh4_state->r[m] += 8;
+		m_sh4_state->xf[n+NATIVE_ENDIAN_VALUE_LE_BE(1,0)] = RL(m_sh4_state->ea );
+		m_sh4_state->xf[n+NATIVE_ENDIAN_VALUE_LE_BE(0,1)] = RL(m_sh4_state->ea+4 );
 	} else {              /* PR = 0 */
 		if (m_fpu_sz) { /* SZ = 1 */
 			if (n & 1) {
 				n = n & 14;
-				m_ea = m_r[m];
-				m_xf[n] = RL(m_ea );
-				m_r[m] += 4;
-				m_xf[n+1] = RL(m_ea+4 );
-				m_r[m] += 4;
+				m_sh4_state->ea = m_sh4_state->r[m];
+				m_sh4_state->xf[n] = RL(m_sh4_state->ea );
+				m_sh4_state->r[m] += 4;
+				m_sh4_state->xf[n+1] = RL(m_sh4_state->ea+4 );
+				m_sh4_state->r[m] += 4;
 			} else {
-				m_ea = m_r[m];
-				m_fr[n] = RL(m_ea );
-				m_r[m] += 4;
-				m_fr[n+1] = RL(m_ea+4 );
-				m_r[m] += 4;
+				m_sh4_state->ea = m_sh4_state->r[m];
+				m_sh4_state->fr[n] = RL(m_sh4_state->ea );
+				m_sh4_state->r[m] += 4;
+				m_sh4_state->fr[n+1] = RL(m_sh4_state->ea+4 );
+				m_sh4_state->r[m] += 4;
 			}
 		} else {              /* SZ = 0 */
-			m_ea = m_r[m];
-			m_fr[n] = RL(m_ea );
-			m_r[m] += 4;
+			m_sh4_state->ea = m_sh4_state->r[m];
+			m_sh4_state->fr[n] = RL(m_sh4_state->ea );
+			m_sh4_state->r[m] += 4;
 		}
 	}
 }
@@ -2500,24 +2580,24 @@ inline void sh34_base_device::FMOVFRMR(const UINT16 opcode)
 
 	if (m_fpu_pr) { /* PR = 1 */
 		m= m & 14;
-		m_ea = m_r[n];
-		WL(m_ea,m_xf[m+NATIVE_ENDIAN_VALUE_LE_BE(1,0)] );
-		WL(m_ea+4,m_xf[m+NATIVE_ENDIAN_VALUE_LE_BE(0,1)] );
+		m_sh4_state->ea = m_sh4_state->r[n];
+		WL(m_sh4_state->ea,m_sh4_state->xf[m+NATIVE_ENDIAN_VALUE_LE_BE(1,0)] );
+		WL(m_sh4_state->ea+4,m_sh4_state->xf[m+NATIVE_ENDIAN_VALUE_LE_BE(0,1)] );
 	} else {              /* PR = 0 */
 		if (m_fpu_sz) { /* SZ = 1 */
 			if (m & 1) {
 				m= m & 14;
-				m_ea = m_r[n];
-				WL(m_ea,m_xf[m] );
-				WL(m_ea+4,m_xf[m+1] );
+				m_sh4_state->ea = m_sh4_state->r[n];
+				WL(m_sh4_state->ea,m_sh4_state->xf[m] );
+				WL(m_sh4_state->ea+4,m_sh4_state->xf[m+1] );
 			} else {
-				m_ea = m_r[n];
-				WL(m_ea,m_fr[m] );
-				WL(m_ea+4,m_fr[m+1] );
+				m_sh4_state->ea = m_sh4_state->r[n];
+				WL(m_sh4_state->ea,m_sh4_state->fr[m] );
+				WL(m_sh4_state->ea+4,m_sh4_state->fr[m+1] );
 			}
 		} else {              /* SZ = 0 */
-			m_ea = m_r[n];
-			WL(m_ea,m_fr[m] );
+			m_sh4_state->ea = m_sh4_state->r[n];
+			WL(m_sh4_state->ea,m_sh4_state->fr[m] );
 		}
 	}
 }
@@ -2532,28 +2612,28 @@ inline void sh34_base_device::FMOVFRMDR(const UINT16 opcode)
 
 	if (m_fpu_pr) { /* PR = 1 */
 		m= m & 14;
-		m_r[n] -= 8;
-		m_ea = m_r[n];
-		WL(m_ea,m_xf[m+NATIVE_ENDIAN_VALUE_LE_BE(1,0)] );
-		WL(m_ea+4,m_xf[m+NATIVE_ENDIAN_VALUE_LE_BE(0,1)] );
+		m_sh4_state->r[n] -= 8;
+		m_sh4_state->ea = m_sh4_state->r[n];
+		WL(m_sh4_state->ea,m_sh4_state->xf[m+NATIVE_ENDIAN_VALUE_LE_BE(1,0)] );
+		WL(m_sh4_state->ea+4,m_sh4_state->xf[m+NATIVE_ENDIAN_VALUE_LE_BE(0,1)] );
 	} else {              /* PR = 0 */
 		if (m_fpu_sz) { /* SZ = 1 */
 			if (m & 1) {
 				m= m & 14;
-				m_r[n] -= 8;
-				m_ea = m_r[n];
-				WL(m_ea,m_xf[m] );
-				WL(m_ea+4,m_xf[m+1] );
+				m_sh4_state->r[n] -= 8;
+				m_sh4_state->ea = m_sh4_state->r[n];
+				WL(m_sh4_state->ea,m_sh4_state->xf[m] );
+				WL(m_sh4_state->ea+4,m_sh4_state->xf[m+1] );
 			} else {
-				m_r[n] -= 8;
-				m_ea = m_r[n];
-				WL(m_ea,m_fr[m] );
-				WL(m_ea+4,m_fr[m+1] );
+				m_sh4_state->r[n] -= 8;
+				m_sh4_state->ea = m_sh4_state->r[n];
+				WL(m_sh4_state->ea,m_sh4_state->fr[m] );
+				WL(m_sh4_state->ea+4,m_sh4_state->fr[m+1] );
 			}
 		} else {              /* SZ = 0 */
-			m_r[n] -= 4;
-			m_ea = m_r[n];
-			WL(m_ea,m_fr[m] );
+			m_sh4_state->r[n] -= 4;
+			m_sh4_state->ea = m_sh4_state->r[n];
+			WL(m_sh4_state->ea,m_sh4_state->fr[m] );
 		}
 	}
 }
@@ -2568,24 +2648,24 @@ inline void sh34_base_device::FMOVFRS0(const UINT16 opcode)
 
 	if (m_fpu_pr) { /* PR = 1 */
 		m= m & 14;
-		m_ea = m_r[0] + m_r[n];
-		WL(m_ea,m_xf[m+NATIVE_ENDIAN_VALUE_LE_BE(1,0)] );
-		WL(m_ea+4,m_xf[m+NATIVE_ENDIAN_VALUE_LE_BE(0,1)] );
+		m_sh4_state->ea = m_sh4_state->r[0] + m_sh4_state->r[n];
+		WL(m_sh4_state->ea,m_sh4_state->xf[m+NATIVE_ENDIAN_VALUE_LE_BE(1,0)] );
+		WL(m_sh4_state->ea+4,m_sh4_state->xf[m+NATIVE_ENDIAN_VALUE_LE_BE(0,1)] );
 	} else {              /* PR = 0 */
 		if (m_fpu_sz) { /* SZ = 1 */
 			if (m & 1) {
 				m= m & 14;
-				m_ea = m_r[0] + m_r[n];
-				WL(m_ea,m_xf[m] );
-				WL(m_ea+4,m_xf[m+1] );
+				m_sh4_state->ea = m_sh4_state->r[0] + m_sh4_state->r[n];
+				WL(m_sh4_state->ea,m_sh4_state->xf[m] );
+				WL(m_sh4_state->ea+4,m_sh4_state->xf[m+1] );
 			} else {
-				m_ea = m_r[0] + m_r[n];
-				WL(m_ea,m_fr[m] );
-				WL(m_ea+4,m_fr[m+1] );
+				m_sh4_state->ea = m_sh4_state->r[0] + m_sh4_state->r[n];
+				WL(m_sh4_state->ea,m_sh4_state->fr[m] );
+				WL(m_sh4_state->ea+4,m_sh4_state->fr[m+1] );
 			}
 		} else {              /* SZ = 0 */
-			m_ea = m_r[0] + m_r[n];
-			WL(m_ea,m_fr[m] );
+			m_sh4_state->ea = m_sh4_state->r[0] + m_sh4_state->r[n];
+			WL(m_sh4_state->ea,m_sh4_state->fr[m] );
 		}
 	}
 }
@@ -2600,24 +2680,24 @@ inline void sh34_base_device::FMOVS0FR(const UINT16 opcode)
 
 	if (m_fpu_pr) { /* PR = 1 */
 		n= n & 14;
-		m_ea = m_r[0] + m_r[m];
-		m_xf[n+NATIVE_ENDIAN_VALUE_LE_BE(1,0)] = RL(m_ea );
-		m_xf[n+NATIVE_ENDIAN_VALUE_LE_BE(0,1)] = RL(m_ea+4 );
+		m_sh4_state->ea = m_sh4_state->r[0] + m_sh4_state->r[m];
+		m_sh4_state->xf[n+NATIVE_ENDIAN_VALUE_LE_BE(1,0)] = RL(m_sh4_state->ea );
+		m_sh4_state->xf[n+NATIVE_ENDIAN_VALUE_LE_BE(0,1)] = RL(m_sh4_state->ea+4 );
 	} else {              /* PR = 0 */
 		if (m_fpu_sz) { /* SZ = 1 */
 			if (n & 1) {
 				n= n & 14;
-				m_ea = m_r[0] + m_r[m];
-				m_xf[n] = RL(m_ea );
-				m_xf[n+1] = RL(m_ea+4 );
+				m_sh4_state->ea = m_sh4_state->r[0] + m_sh4_state->r[m];
+				m_sh4_state->xf[n] = RL(m_sh4_state->ea );
+				m_sh4_state->xf[n+1] = RL(m_sh4_state->ea+4 );
 			} else {
-				m_ea = m_r[0] + m_r[m];
-				m_fr[n] = RL(m_ea );
-				m_fr[n+1] = RL(m_ea+4 );
+				m_sh4_state->ea = m_sh4_state->r[0] + m_sh4_state->r[m];
+				m_sh4_state->fr[n] = RL(m_sh4_state->ea );
+				m_sh4_state->fr[n+1] = RL(m_sh4_state->ea+4 );
 			}
 		} else {              /* SZ = 0 */
-			m_ea = m_r[0] + m_r[m];
-			m_fr[n] = RL(m_ea );
+			m_sh4_state->ea = m_sh4_state->r[0] + m_sh4_state->r[m];
+			m_sh4_state->fr[n] = RL(m_sh4_state->ea );
 		}
 	}
 }
@@ -2634,31 +2714,31 @@ inline void sh34_base_device::FMOVMRFR(const UINT16 opcode)
 	if (m_fpu_pr) { /* PR = 1 */
 		if (n & 1) {
 			n= n & 14;
-			m_ea = m_r[m];
-			m_xf[n+NATIVE_ENDIAN_VALUE_LE_BE(1,0)] = RL(m_ea );
-			m_xf[n+NATIVE_ENDIAN_VALUE_LE_BE(0,1)] = RL(m_ea+4 );
+			m_sh4_state->ea = m_sh4_state->r[m];
+			m_sh4_state->xf[n+NATIVE_ENDIAN_VALUE_LE_BE(1,0)] = RL(m_sh4_state->ea );
+			m_sh4_state->xf[n+NATIVE_ENDIAN_VALUE_LE_BE(0,1)] = RL(m_sh4_state->ea+4 );
 		} else {
 			n= n & 14;
-			m_ea = m_r[m];
-			m_fr[n+NATIVE_ENDIAN_VALUE_LE_BE(1,0)] = RL(m_ea );
-			m_fr[n+NATIVE_ENDIAN_VALUE_LE_BE(0,1)] = RL(m_ea+4 );
+			m_sh4_state->ea = m_sh4_state->r[m];
+			m_sh4_state->fr[n+NATIVE_ENDIAN_VALUE_LE_BE(1,0)] = RL(m_sh4_state->ea );
+			m_sh4_state->fr[n+NATIVE_ENDIAN_VALUE_LE_BE(0,1)] = RL(m_sh4_state->ea+4 );
 		}
 	} else {              /* PR = 0 */
 		if (m_fpu_sz) { /* SZ = 1 */
 			if (n & 1) {
 				n= n & 14;
-				m_ea = m_r[m];
-				m_xf[n] = RL(m_ea );
-				m_xf[n+1] = RL(m_ea+4 );
+				m_sh4_state->ea = m_sh4_state->r[m];
+				m_sh4_state->xf[n] = RL(m_sh4_state->ea );
+				m_sh4_state->xf[n+1] = RL(m_sh4_state->ea+4 );
 			} else {
 				n= n & 14;
-				m_ea = m_r[m];
-				m_fr[n] = RL(m_ea );
-				m_fr[n+1] = RL(m_ea+4 );
+				m_sh4_state->ea = m_sh4_state->r[m];
+				m_sh4_state->fr[n] = RL(m_sh4_state->ea );
+				m_sh4_state->fr[n+1] = RL(m_sh4_state->ea+4 );
 			}
 		} else {              /* SZ = 0 */
-			m_ea = m_r[m];
-			m_fr[n] = RL(m_ea );
+			m_sh4_state->ea = m_sh4_state->r[m];
+			m_sh4_state->fr[n] = RL(m_sh4_state->ea );
 		}
 	}
 }
@@ -2673,23 +2753,23 @@ inline void sh34_base_device::FMOVFR(const UINT16 opcode)
 	UINT32 m = Rm; UINT32 n = Rn;
 
 	if ((m_fpu_sz == 0) && (m_fpu_pr == 0)) /* SZ = 0 */
-		m_fr[n] = m_fr[m];
+		m_sh4_state->fr[n] = m_sh4_state->fr[m];
 	else { /* SZ = 1 or PR = 1 */
 		if (m & 1) {
 			if (n & 1) {
-				m_xf[n & 14] = m_xf[m & 14];
-				m_xf[n | 1] = m_xf[m | 1];
+				m_sh4_state->xf[n & 14] = m_sh4_state->xf[m & 14];
+				m_sh4_state->xf[n | 1] = m_sh4_state->xf[m | 1];
 			} else {
-				m_fr[n] = m_xf[m & 14];
-				m_fr[n | 1] = m_xf[m | 1];
+				m_sh4_state->fr[n] = m_sh4_state->xf[m & 14];
+				m_sh4_state->fr[n | 1] = m_sh4_state->xf[m | 1];
 			}
 		} else {
 			if (n & 1) {
-				m_xf[n & 14] = m_fr[m];
-				m_xf[n | 1] = m_fr[m | 1]; // (a&14)+1 -> a|1
+				m_sh4_state->xf[n & 14] = m_sh4_state->fr[m];
+				m_sh4_state->xf[n | 1] = m_sh4_state->fr[m | 1]; // (a&14)+1 -> a|1
 			} else {
-				m_fr[n] = m_fr[m];
-				m_fr[n | 1] = m_fr[m | 1];
+				m_sh4_state->fr[n] = m_sh4_state->fr[m];
+				m_sh4_state->fr[n | 1] = m_sh4_state->fr[m | 1];
 			}
 		}
 	}
@@ -2698,39 +2778,39 @@ inline void sh34_base_device::FMOVFR(const UINT16 opcode)
 /*  FLDI1  FRn 1111nnnn10011101 */
 inline void sh34_base_device::FLDI1(const UINT16 opcode)
 {
-	m_fr[Rn] = 0x3F800000;
+	m_sh4_state->fr[Rn] = 0x3F800000;
 }
 
 /*  FLDI0  FRn 1111nnnn10001101 */
 inline void sh34_base_device::FLDI0(const UINT16 opcode)
 {
-	m_fr[Rn] = 0;
+	m_sh4_state->fr[Rn] = 0;
 }
 
 /*  FLDS FRm,FPUL 1111mmmm00011101 */
 inline void sh34_base_device:: FLDS(const UINT16 opcode)
 {
-	m_fpul = m_fr[Rn];
+	m_sh4_state->fpul = m_sh4_state->fr[Rn];
 }
 
 /*  FSTS FPUL,FRn 1111nnnn00001101 */
 inline void sh34_base_device:: FSTS(const UINT16 opcode)
 {
-	m_fr[Rn] = m_fpul;
+	m_sh4_state->fr[Rn] = m_sh4_state->fpul;
 }
 
 /* FRCHG 1111101111111101 */
 void sh34_base_device::FRCHG()
 {
-	m_fpscr ^= FR;
+	m_sh4_state->fpscr ^= FR;
 	sh4_swap_fp_registers();
 }
 
 /* FSCHG 1111001111111101 */
 void sh34_base_device::FSCHG()
 {
-	m_fpscr ^= SZ;
-	m_fpu_sz = (m_fpscr & SZ) ? 1 : 0;
+	m_sh4_state->fpscr ^= SZ;
+	m_fpu_sz = (m_sh4_state->fpscr & SZ) ? 1 : 0;
 }
 
 /* FTRC FRm,FPUL PR=0 1111mmmm00111101 */
@@ -2744,10 +2824,10 @@ inline void sh34_base_device::FTRC(const UINT16 opcode)
 			fatalerror("SH-4: FTRC opcode used with n %d",n);
 
 		n = n & 14;
-		*((INT32 *)&m_fpul) = (INT32)FP_RFD(n);
+		*((INT32 *)&m_sh4_state->fpul) = (INT32)FP_RFD(n);
 	} else {              /* PR = 0 */
-		/* read m_fr[n] as float -> truncate -> fpul(32) */
-		*((INT32 *)&m_fpul) = (INT32)FP_RFS(n);
+		/* read m_sh4_state->fr[n] as float -> truncate -> fpul(32) */
+		*((INT32 *)&m_sh4_state->fpul) = (INT32)FP_RFS(n);
 	}
 }
 
@@ -2762,9 +2842,9 @@ inline void sh34_base_device::FLOAT(const UINT16 opcode)
 			fatalerror("SH-4: FLOAT opcode used with n %d",n);
 
 		n = n & 14;
-		FP_RFD(n) = (double)*((INT32 *)&m_fpul);
+		FP_RFD(n) = (double)*((INT32 *)&m_sh4_state->fpul);
 	} else {              /* PR = 0 */
-		FP_RFS(n) = (float)*((INT32 *)&m_fpul);
+		FP_RFS(n) = (float)*((INT32 *)&m_sh4_state->fpul);
 	}
 }
 
@@ -2790,13 +2870,13 @@ inline void sh34_base_device::FABS(const UINT16 opcode)
 	if (m_fpu_pr) { /* PR = 1 */
 #ifdef LSB_FIRST
 		n = n | 1; // n & 14 + 1
-		m_fr[n] = m_fr[n] & 0x7fffffff;
+		m_sh4_state->fr[n] = m_sh4_state->fr[n] & 0x7fffffff;
 #else
 		n = n & 14;
-		m_fr[n] = m_fr[n] & 0x7fffffff;
+		m_sh4_state->fr[n] = m_sh4_state->fr[n] & 0x7fffffff;
 #endif
 	} else {              /* PR = 0 */
-		m_fr[n] = m_fr[n] & 0x7fffffff;
+		m_sh4_state->fr[n] = m_sh4_state->fr[n] & 0x7fffffff;
 	}
 }
 
@@ -2810,14 +2890,14 @@ inline void sh34_base_device::FCMP_EQ(const UINT16 opcode)
 		n = n & 14;
 		m = m & 14;
 		if (FP_RFD(n) == FP_RFD(m))
-			m_sr |= T;
+			m_sh4_state->sr |= T;
 		else
-			m_sr &= ~T;
+			m_sh4_state->sr &= ~T;
 	} else {              /* PR = 0 */
 		if (FP_RFS(n) == FP_RFS(m))
-			m_sr |= T;
+			m_sh4_state->sr |= T;
 		else
-			m_sr &= ~T;
+			m_sh4_state->sr &= ~T;
 	}
 }
 
@@ -2831,14 +2911,14 @@ inline void sh34_base_device::FCMP_GT(const UINT16 opcode)
 		n = n & 14;
 		m = m & 14;
 		if (FP_RFD(n) > FP_RFD(m))
-			m_sr |= T;
+			m_sh4_state->sr |= T;
 		else
-			m_sr &= ~T;
+			m_sh4_state->sr &= ~T;
 	} else {              /* PR = 0 */
 		if (FP_RFS(n) > FP_RFS(m))
-			m_sr |= T;
+			m_sh4_state->sr |= T;
 		else
-			m_sr &= ~T;
+			m_sh4_state->sr &= ~T;
 	}
 }
 
@@ -2849,9 +2929,9 @@ inline void sh34_base_device::FCNVDS(const UINT16 opcode)
 
 	if (m_fpu_pr) { /* PR = 1 */
 		n = n & 14;
-		if (m_fpscr & RM)
-			m_fr[n | NATIVE_ENDIAN_VALUE_LE_BE(0,1)] &= 0xe0000000; /* round toward zero*/
-		*((float *)&m_fpul) = (float)FP_RFD(n);
+		if (m_sh4_state->fpscr & RM)
+			m_sh4_state->fr[n | NATIVE_ENDIAN_VALUE_LE_BE(0,1)] &= 0xe0000000; /* round toward zero*/
+		*((float *)&m_sh4_state->fpul) = (float)FP_RFD(n);
 	}
 }
 
@@ -2862,7 +2942,7 @@ inline void sh34_base_device::FCNVSD(const UINT16 opcode)
 
 	if (m_fpu_pr) { /* PR = 1 */
 		n = n & 14;
-		FP_RFD(n) = (double)*((float *)&m_fpul);
+		FP_RFD(n) = (double)*((float *)&m_sh4_state->fpul);
 	}
 }
 
@@ -2976,7 +3056,7 @@ void sh34_base_device::FSSCA(const UINT16 opcode)
 
 	float angle;
 
-	angle = (((float)(m_fpul & 0xFFFF)) / 65536.0f) * 2.0f * (float) M_PI;
+	angle = (((float)(m_sh4_state->fpul & 0xFFFF)) / 65536.0f) * 2.0f * (float) M_PI;
 	FP_RFS(n) = sinf(angle);
 	FP_RFS(n+1) = cosf(angle);
 }
@@ -3075,25 +3155,25 @@ inline void sh34_base_device::op1111_0x13(UINT16 opcode)
 
 void sh34_base_device::device_reset()
 {
-	m_ppc = 0;
-	m_spc = 0;
-	m_pr = 0;
-	m_sr = 0;
-	m_ssr = 0;
-	m_gbr = 0;
-	m_vbr = 0;
-	m_mach = 0;
-	m_macl = 0;
-	memset(m_r, 0, sizeof(m_r));
-	memset(m_rbnk, 0, sizeof(m_rbnk));
-	m_sgr = 0;
-	memset(m_fr, 0, sizeof(m_fr));
-	memset(m_xf, 0, sizeof(m_xf));
-	m_ea = 0;
-	m_delay = 0;
+	m_sh4_state->ppc = 0;
+	m_sh4_state->spc = 0;
+	m_sh4_state->pr = 0;
+	m_sh4_state->sr = 0;
+	m_sh4_state->ssr = 0;
+	m_sh4_state->gbr = 0;
+	m_sh4_state->vbr = 0;
+	m_sh4_state->mach = 0;
+	m_sh4_state->macl = 0;
+	memset(m_sh4_state->r, 0, sizeof(m_sh4_state->r));
+	memset(m_sh4_state->rbnk, 0, sizeof(m_sh4_state->rbnk));
+	m_sh4_state->sgr = 0;
+	memset(m_sh4_state->fr, 0, sizeof(m_sh4_state->fr));
+	memset(m_sh4_state->xf, 0, sizeof(m_sh4_state->xf));
+	m_sh4_state->ea = 0;
+	m_sh4_state->delay = 0;
 	m_cpu_off = 0;
 	m_pending_irq = 0;
-	m_test_irq = 0;
+	m_sh4_state->test_irq = 0;
 	memset(m_exception_priority, 0, sizeof(m_exception_priority));
 	memset(m_exception_requesting, 0, sizeof(m_exception_requesting));
 	memset(m_m, 0, sizeof(m_m));
@@ -3152,20 +3232,22 @@ void sh34_base_device::device_reset()
 
 	m_rtc_timer->adjust(attotime::from_hz(128));
 
-	m_pc = 0xa0000000;
-	m_r[15] = RL(4);
-	m_sr = 0x700000f0;
-	m_fpscr = 0x00040001;
-	m_fpu_sz = (m_fpscr & SZ) ? 1 : 0;
-	m_fpu_pr = (m_fpscr & PR) ? 1 : 0;
-	m_fpul = 0;
-	m_dbr = 0;
+	m_sh4_state->pc = 0xa0000000;
+	m_sh4_state->r[15] = RL(4);
+	m_sh4_state->sr = 0x700000f0;
+	m_sh4_state->fpscr = 0x00040001;
+	m_fpu_sz = (m_sh4_state->fpscr & SZ) ? 1 : 0;
+	m_fpu_pr = (m_sh4_state->fpscr & PR) ? 1 : 0;
+	m_sh4_state->fpul = 0;
+	m_sh4_state->dbr = 0;
 
 	m_internal_irq_level = -1;
 	m_irln = 15;
 	m_sleep_mode = 0;
 
 	m_sh4_mmu_enabled = 0;
+
+	m_cache_dirty = TRUE;
 }
 
 /*-------------------------------------------------
@@ -3940,72 +4022,84 @@ void sh34_base_device::execute_run()
 {
 	if (m_cpu_off)
 	{
-		m_sh4_icount = 0;
+		m_sh4_state->icount = 0;
+		return;
+	}
+
+	if (m_isdrc)
+	{
+		execute_run_drc();
 		return;
 	}
 
 	do
 	{
-		if (m_delay)
+		if (m_sh4_state->delay)
 		{
-			const UINT16 opcode = m_direct->read_word((UINT32)(m_delay & AM), WORD2_XOR_LE(0));
+			const UINT16 opcode = m_direct->read_word((UINT32)(m_sh4_state->delay & AM), WORD2_XOR_LE(0));
 
-			debugger_instruction_hook(this, (m_pc-2) & AM);
+			debugger_instruction_hook(this, (m_sh4_state->pc-2) & AM);
 
-			m_delay = 0;
-			m_ppc = m_pc;
+			m_sh4_state->delay = 0;
+			m_sh4_state->ppc = m_sh4_state->pc;
 
 			execute_one(opcode);
 
-			if (m_test_irq && !m_delay)
+			if (m_sh4_state->test_irq && !m_sh4_state->delay)
 			{
 				sh4_check_pending_irq("mame_sh4_execute");
 			}
 		}
 		else
 		{
-			const UINT16 opcode = m_direct->read_word((UINT32)(m_pc & AM), WORD2_XOR_LE(0));
+			const UINT16 opcode = m_direct->read_word((UINT32)(m_sh4_state->pc & AM), WORD2_XOR_LE(0));
 
-			debugger_instruction_hook(this, m_pc & AM);
+			debugger_instruction_hook(this, m_sh4_state->pc & AM);
 
-			m_pc += 2;
-			m_ppc = m_pc;
+			m_sh4_state->pc += 2;
+			m_sh4_state->ppc = m_sh4_state->pc;
 
 			execute_one(opcode);
 
-			if (m_test_irq && !m_delay)
+			if (m_sh4_state->test_irq && !m_sh4_state->delay)
 			{
 				sh4_check_pending_irq("mame_sh4_execute");
 			}
 		}
 
-		m_sh4_icount--;
-	} while( m_sh4_icount > 0 );
+		m_sh4_state->icount--;
+	} while( m_sh4_state->icount > 0 );
 }
 
 void sh3be_device::execute_run()
 {
 	if (m_cpu_off)
 	{
-		m_sh4_icount = 0;
+		m_sh4_state->icount = 0;
+		return;
+	}
+
+	if (m_isdrc)
+	{
+		execute_run_drc();
 		return;
 	}
 
 	do
 	{
-		if (m_delay)
+		if (m_sh4_state->delay)
 		{
-			const UINT16 opcode = m_direct->read_word((UINT32)(m_delay & AM), WORD_XOR_LE(6));
+			const UINT16 opcode = m_direct->read_word((UINT32)(m_sh4_state->delay & AM), WORD_XOR_LE(6));
 
-			debugger_instruction_hook(this, m_delay & AM);
+			debugger_instruction_hook(this, m_sh4_state->delay & AM);
 
-			m_delay = 0;
-			m_ppc = m_pc;
+			m_sh4_state->delay = 0;
+			m_sh4_state->ppc = m_sh4_state->pc;
 
 			execute_one(opcode);
 
 
-			if (m_test_irq && !m_delay)
+			if (m_sh4_state->test_irq && !m_sh4_state->delay)
 			{
 				sh4_check_pending_irq("mame_sh4_execute");
 			}
@@ -4014,48 +4108,54 @@ void sh3be_device::execute_run()
 		}
 		else
 		{
-			const UINT16 opcode = m_direct->read_word((UINT32)(m_pc & AM), WORD_XOR_LE(6));
+			const UINT16 opcode = m_direct->read_word((UINT32)(m_sh4_state->pc & AM), WORD_XOR_LE(6));
 
-			debugger_instruction_hook(this, m_pc & AM);
+			debugger_instruction_hook(this, m_sh4_state->pc & AM);
 
-			m_pc += 2;
-			m_ppc = m_pc;
+			m_sh4_state->pc += 2;
+			m_sh4_state->ppc = m_sh4_state->pc;
 
 			execute_one(opcode);
 
-			if (m_test_irq && !m_delay)
+			if (m_sh4_state->test_irq && !m_sh4_state->delay)
 			{
 				sh4_check_pending_irq("mame_sh4_execute");
 			}
 		}
 
-		m_sh4_icount--;
-	} while( m_sh4_icount > 0 );
+		m_sh4_state->icount--;
+	} while( m_sh4_state->icount > 0 );
 }
 
 void sh4be_device::execute_run()
 {
 	if (m_cpu_off)
 	{
-		m_sh4_icount = 0;
+		m_sh4_state->icount = 0;
+		return;
+	}
+
+	if (m_isdrc)
+	{
+		execute_run_drc();
 		return;
 	}
 
 	do
 	{
-		if (m_delay)
+		if (m_sh4_state->delay)
 		{
-			const UINT16 opcode = m_direct->read_word((UINT32)(m_delay & AM), WORD_XOR_LE(6));
+			const UINT16 opcode = m_direct->read_word((UINT32)(m_sh4_state->delay & AM), WORD_XOR_LE(6));
 
-			debugger_instruction_hook(this, m_delay & AM);
+			debugger_instruction_hook(this, m_sh4_state->delay & AM);
 
-			m_delay = 0;
-			m_ppc = m_pc;
+			m_sh4_state->delay = 0;
+			m_sh4_state->ppc = m_sh4_state->pc;
 
 			execute_one(opcode);
 
 
-			if (m_test_irq && !m_delay)
+			if (m_sh4_state->test_irq && !m_sh4_state->delay)
 			{
 				sh4_check_pending_irq("mame_sh4_execute");
 			}
@@ -4064,27 +4164,31 @@ void sh4be_device::execute_run()
 		}
 		else
 		{
-			const UINT16 opcode = m_direct->read_word((UINT32)(m_pc & AM), WORD_XOR_LE(6));
+			const UINT16 opcode = m_direct->read_word((UINT32)(m_sh4_state->pc & AM), WORD_XOR_LE(6));
 
-			debugger_instruction_hook(this, m_pc & AM);
+			debugger_instruction_hook(this, m_sh4_state->pc & AM);
 
-			m_pc += 2;
-			m_ppc = m_pc;
+			m_sh4_state->pc += 2;
+			m_sh4_state->ppc = m_sh4_state->pc;
 
 			execute_one(opcode);
 
-			if (m_test_irq && !m_delay)
+			if (m_sh4_state->test_irq && !m_sh4_state->delay)
 			{
 				sh4_check_pending_irq("mame_sh4_execute");
 			}
 		}
 
-		m_sh4_icount--;
-	} while( m_sh4_icount > 0 );
+		m_sh4_state->icount--;
+	} while( m_sh4_state->icount > 0 );
 }
 
 void sh34_base_device::device_start()
 {
+	/* allocate the implementation-specific state from the full cache */
+	m_sh4_state = (internal_sh4_state *)m_cache.alloc_near(sizeof(internal_sh4_state));
+	memset(m_sh4_state, 0, sizeof(internal_sh4_state));
+
 	for (int i=0; i<3; i++)
 	{
 		m_timer[i] = machine().scheduler().timer_alloc(timer_expired_delegate(FUNC(sh34_base_device::sh4_timer_callback), this));
@@ -4110,72 +4214,73 @@ void sh34_base_device::device_start()
 	m_program = &space(AS_PROGRAM);
 	m_io = &space(AS_IO);
 	m_direct = &m_program->direct();
+	m_code_xor = (m_program->endianness() == ENDIANNESS_BIG) ? WORD_XOR_LE(6) : WORD2_XOR_LE(0);
 	sh4_default_exception_priorities();
 	m_irln = 15;
-	m_test_irq = 0;
-
-	save_item(NAME(m_pc));
-	save_item(NAME(m_r[15]));
-	save_item(NAME(m_sr));
-	save_item(NAME(m_pr));
-	save_item(NAME(m_gbr));
-	save_item(NAME(m_vbr));
-	save_item(NAME(m_mach));
-	save_item(NAME(m_macl));
-	save_item(NAME(m_spc));
-	save_item(NAME(m_ssr));
-	save_item(NAME(m_sgr));
-	save_item(NAME(m_fpscr));
-	save_item(NAME(m_r[ 0]));
-	save_item(NAME(m_r[ 1]));
-	save_item(NAME(m_r[ 2]));
-	save_item(NAME(m_r[ 3]));
-	save_item(NAME(m_r[ 4]));
-	save_item(NAME(m_r[ 5]));
-	save_item(NAME(m_r[ 6]));
-	save_item(NAME(m_r[ 7]));
-	save_item(NAME(m_r[ 8]));
-	save_item(NAME(m_r[ 9]));
-	save_item(NAME(m_r[10]));
-	save_item(NAME(m_r[11]));
-	save_item(NAME(m_r[12]));
-	save_item(NAME(m_r[13]));
-	save_item(NAME(m_r[14]));
-	save_item(NAME(m_fr[ 0]));
-	save_item(NAME(m_fr[ 1]));
-	save_item(NAME(m_fr[ 2]));
-	save_item(NAME(m_fr[ 3]));
-	save_item(NAME(m_fr[ 4]));
-	save_item(NAME(m_fr[ 5]));
-	save_item(NAME(m_fr[ 6]));
-	save_item(NAME(m_fr[ 7]));
-	save_item(NAME(m_fr[ 8]));
-	save_item(NAME(m_fr[ 9]));
-	save_item(NAME(m_fr[10]));
-	save_item(NAME(m_fr[11]));
-	save_item(NAME(m_fr[12]));
-	save_item(NAME(m_fr[13]));
-	save_item(NAME(m_fr[14]));
-	save_item(NAME(m_fr[15]));
-	save_item(NAME(m_xf[ 0]));
-	save_item(NAME(m_xf[ 1]));
-	save_item(NAME(m_xf[ 2]));
-	save_item(NAME(m_xf[ 3]));
-	save_item(NAME(m_xf[ 4]));
-	save_item(NAME(m_xf[ 5]));
-	save_item(NAME(m_xf[ 6]));
-	save_item(NAME(m_xf[ 7]));
-	save_item(NAME(m_xf[ 8]));
-	save_item(NAME(m_xf[ 9]));
-	save_item(NAME(m_xf[10]));
-	save_item(NAME(m_xf[11]));
-	save_item(NAME(m_xf[12]));
-	save_item(NAME(m_xf[13]));
-	save_item(NAME(m_xf[14]));
-	save_item(NAME(m_xf[15]));
-	save_item(NAME(m_ea));
-	save_item(NAME(m_fpul));
-	save_item(NAME(m_dbr));
+	m_sh4_state->test_irq = 0;
+
+	save_item(m_sh4_state->pc, "m_pc");
+	save_item(m_sh4_state->r[15], "m_r[15]");
+	save_item(m_sh4_state->sr, "m_sr");
+	save_item(m_sh4_state->pr, "m_pr");
+	save_item(m_sh4_state->gbr, "m_gbr");
+	save_item(m_sh4_state->vbr, "m_vbr");
+	save_item(m_sh4_state->mach, "m_mach");
+	save_item(m_sh4_state->macl, "m_macl");
+	save_item(m_sh4_state->spc, "m_spc");
+	save_item(m_sh4_state->ssr, "m_ssr");
+	save_item(m_sh4_state->sgr, "m_sgr");
+	save_item(m_sh4_state->fpscr, "m_fpscr");
+	save_item(m_sh4_state->r[ 0], "m_r[ 0]");
+	save_item(m_sh4_state->r[ 1], "m_r[ 1]");
+	save_item(m_sh4_state->r[ 2], "m_r[ 2]");
+	save_item(m_sh4_state->r[ 3], "m_r[ 3]");
+	save_item(m_sh4_state->r[ 4], "m_r[ 4]");
+	save_item(m_sh4_state->r[ 5], "m_r[ 5]");
+	save_item(m_sh4_state->r[ 6], "m_r[ 6]");
+	save_item(m_sh4_state->r[ 7], "m_r[ 7]");
+	save_item(m_sh4_state->r[ 8], "m_r[ 8]");
+	save_item(m_sh4_state->r[ 9], "m_r[ 9]");
+	save_item(m_sh4_state->r[10], "m_r[10]");
+	save_item(m_sh4_state->r[11], "m_r[11]");
+	save_item(m_sh4_state->r[12], "m_r[12]");
+	save_item(m_sh4_state->r[13], "m_r[13]");
+	save_item(m_sh4_state->r[14], "m_r[14]");
+	save_item(m_sh4_state->fr[ 0], "m_fr[ 0]");
+	save_item(m_sh4_state->fr[ 1], "m_fr[ 1]");
+	save_item(m_sh4_state->fr[ 2], "m_fr[ 2]");
+	save_item(m_sh4_state->fr[ 3], "m_fr[ 3]");
+	save_item(m_sh4_state->fr[ 4], "m_fr[ 4]");
+	save_item(m_sh4_state->fr[ 5], "m_fr[ 5]");
+	save_item(m_sh4_state->fr[ 6], "m_fr[ 6]");
+	save_item(m_sh4_state->fr[ 7], "m_fr[ 7]");
+	save_item(m_sh4_state->fr[ 8], "m_fr[ 8]");
+	save_item(m_sh4_state->fr[ 9], "m_fr[ 9]");
+	save_item(m_sh4_state->fr[10], "m_fr[10]");
+	save_item(m_sh4_state->fr[11], "m_fr[11]");
+	save_item(m_sh4_state->fr[12], "m_fr[12]");
+	save_item(m_sh4_state->fr[13], "m_fr[13]");
+	save_item(m_sh4_state->fr[14], "m_fr[14]");
+	save_item(m_sh4_state->fr[15], "m_fr[15]");
+	save_item(m_sh4_state->xf[ 0], "m_xf[ 0]");
+	save_item(m_sh4_state->xf[ 1], "m_xf[ 1]");
+	save_item(m_sh4_state->xf[ 2], "m_xf[ 2]");
+	save_item(m_sh4_state->xf[ 3], "m_xf[ 3]");
+	save_item(m_sh4_state->xf[ 4], "m_xf[ 4]");
+	save_item(m_sh4_state->xf[ 5], "m_xf[ 5]");
+	save_item(m_sh4_state->xf[ 6], "m_xf[ 6]");
+	save_item(m_sh4_state->xf[ 7], "m_xf[ 7]");
+	save_item(m_sh4_state->xf[ 8], "m_xf[ 8]");
+	save_item(m_sh4_state->xf[ 9], "m_xf[ 9]");
+	save_item(m_sh4_state->xf[10], "m_xf[10]");
+	save_item(m_sh4_state->xf[11], "m_xf[11]");
+	save_item(m_sh4_state->xf[12], "m_xf[12]");
+	save_item(m_sh4_state->xf[13], "m_xf[13]");
+	save_item(m_sh4_state->xf[14], "m_xf[14]");
+	save_item(m_sh4_state->xf[15], "m_xf[15]");
+	save_item(m_sh4_state->ea, "m_ea");
+	save_item(m_sh4_state->fpul, "m_fpul");
+	save_item(m_sh4_state->dbr, "m_dbr");
 	save_item(NAME(m_exception_priority));
 	save_item(NAME(m_exception_requesting));
 
@@ -4198,52 +4303,52 @@ void sh34_base_device::device_start()
 
 	// Debugger state
 
-	state_add(SH4_PC,             "PC", m_pc).formatstr("%08X").callimport();
-	state_add(SH4_SR,             "SR", m_sr).formatstr("%08X").callimport();
-	state_add(SH4_PR,             "PR", m_pr).formatstr("%08X");
-	state_add(SH4_GBR,            "GBR", m_gbr).formatstr("%08X");
-	state_add(SH4_VBR,            "VBR", m_vbr).formatstr("%08X");
-	state_add(SH4_DBR,            "DBR", m_dbr).formatstr("%08X");
-	state_add(SH4_MACH,           "MACH", m_mach).formatstr("%08X");
-	state_add(SH4_MACL,           "MACL", m_macl).formatstr("%08X");
-	state_add(SH4_R0,             "R0", m_r[ 0]).formatstr("%08X");
-	state_add(SH4_R1,             "R1", m_r[ 1]).formatstr("%08X");
-	state_add(SH4_R2,             "R2", m_r[ 2]).formatstr("%08X");
-	state_add(SH4_R3,             "R3", m_r[ 3]).formatstr("%08X");
-	state_add(SH4_R4,             "R4", m_r[ 4]).formatstr("%08X");
-	state_add(SH4_R5,             "R5", m_r[ 5]).formatstr("%08X");
-	state_add(SH4_R6,             "R6", m_r[ 6]).formatstr("%08X");
-	state_add(SH4_R7,             "R7", m_r[ 7]).formatstr("%08X");
-	state_add(SH4_R8,             "R8", m_r[ 8]).formatstr("%08X");
-	state_add(SH4_R9,             "R9", m_r[ 9]).formatstr("%08X");
-	state_add(SH4_R10,            "R10", m_r[10]).formatstr("%08X");
-	state_add(SH4_R11,            "R11", m_r[11]).formatstr("%08X");
-	state_add(SH4_R12,            "R12", m_r[12]).formatstr("%08X");
-	state_add(SH4_R13,            "R13", m_r[13]).formatstr("%08X");
-	state_add(SH4_R14,            "R14", m_r[14]).formatstr("%08X");
-	state_add(SH4_R15,            "R15", m_r[15]).formatstr("%08X");
-	state_add(SH4_EA,             "EA", m_ea).formatstr("%08X");
-	state_add(SH4_R0_BK0,         "R0 BK 0", m_rbnk[0][0]).formatstr("%08X");
-	state_add(SH4_R1_BK0,         "R1 BK 0", m_rbnk[0][1]).formatstr("%08X");
-	state_add(SH4_R2_BK0,         "R2 BK 0", m_rbnk[0][2]).formatstr("%08X");
-	state_add(SH4_R3_BK0,         "R3 BK 0", m_rbnk[0][3]).formatstr("%08X");
-	state_add(SH4_R4_BK0,         "R4 BK 0", m_rbnk[0][4]).formatstr("%08X");
-	state_add(SH4_R5_BK0,         "R5 BK 0", m_rbnk[0][5]).formatstr("%08X");
-	state_add(SH4_R6_BK0,         "R6 BK 0", m_rbnk[0][6]).formatstr("%08X");
-	state_add(SH4_R7_BK0,         "R7 BK 0", m_rbnk[0][7]).formatstr("%08X");
-	state_add(SH4_R0_BK1,         "R0 BK 1", m_rbnk[1][0]).formatstr("%08X");
-	state_add(SH4_R1_BK1,         "R1 BK 1", m_rbnk[1][1]).formatstr("%08X");
-	state_add(SH4_R2_BK1,         "R2 BK 1", m_rbnk[1][2]).formatstr("%08X");
-	state_add(SH4_R3_BK1,         "R3 BK 1", m_rbnk[1][3]).formatstr("%08X");
-	state_add(SH4_R4_BK1,         "R4 BK 1", m_rbnk[1][4]).formatstr("%08X");
-	state_add(SH4_R5_BK1,         "R5 BK 1", m_rbnk[1][5]).formatstr("%08X");
-	state_add(SH4_R6_BK1,         "R6 BK 1", m_rbnk[1][6]).formatstr("%08X");
-	state_add(SH4_R7_BK1,         "R7 BK 1", m_rbnk[1][7]).formatstr("%08X");
-	state_add(SH4_SPC,            "SPC", m_spc).formatstr("%08X");
-	state_add(SH4_SSR,            "SSR", m_ssr).formatstr("%08X");
-	state_add(SH4_SGR,            "SGR", m_sgr).formatstr("%08X");
-	state_add(SH4_FPSCR,          "FPSCR", m_fpscr).formatstr("%08X");
-	state_add(SH4_FPUL,           "FPUL", m_fpul).formatstr("%08X");
+	state_add(SH4_PC,             "PC", m_sh4_state->pc).formatstr("%08X").callimport();
+	state_add(SH4_SR,             "SR", m_sh4_state->sr).formatstr("%08X").callimport();
+	state_add(SH4_PR,             "PR", m_sh4_state->pr).formatstr("%08X");
+	state_add(SH4_GBR,            "GBR", m_sh4_state->gbr).formatstr("%08X");
+	state_add(SH4_VBR,            "VBR", m_sh4_state->vbr).formatstr("%08X");
+	state_add(SH4_DBR,            "DBR", m_sh4_state->dbr).formatstr("%08X");
+	state_add(SH4_MACH,           "MACH", m_sh4_state->mach).formatstr("%08X");
+	state_add(SH4_MACL,           "MACL", m_sh4_state->macl).formatstr("%08X");
+	state_add(SH4_R0,             "R0", m_sh4_state->r[ 0]).formatstr("%08X");
+	state_add(SH4_R1,             "R1", m_sh4_state->r[ 1]).formatstr("%08X");
+	state_add(SH4_R2,             "R2", m_sh4_state->r[ 2]).formatstr("%08X");
+	state_add(SH4_R3,             "R3", m_sh4_state->r[ 3]).formatstr("%08X");
+	state_add(SH4_R4,             "R4", m_sh4_state->r[ 4]).formatstr("%08X");
+	state_add(SH4_R5,             "R5", m_sh4_state->r[ 5]).formatstr("%08X");
+	state_add(SH4_R6,             "R6", m_sh4_state->r[ 6]).formatstr("%08X");
+	state_add(SH4_R7,             "R7", m_sh4_state->r[ 7]).formatstr("%08X");
+	state_add(SH4_R8,             "R8", m_sh4_state->r[ 8]).formatstr("%08X");
+	state_add(SH4_R9,             "R9", m_sh4_state->r[ 9]).formatstr("%08X");
+	state_add(SH4_R10,            "R10", m_sh4_state->r[10]).formatstr("%08X");
+	state_add(SH4_R11,            "R11", m_sh4_state->r[11]).formatstr("%08X");
+	state_add(SH4_R12,            "R12", m_sh4_state->r[12]).formatstr("%08X");
+	state_add(SH4_R13,            "R13", m_sh4_state->r[13]).formatstr("%08X");
+	state_add(SH4_R14,            "R14", m_sh4_state->r[14]).formatstr("%08X");
+	state_add(SH4_R15,            "R15", m_sh4_state->r[15]).formatstr("%08X");
+	state_add(SH4_EA,             "EA", m_sh4_state->ea).formatstr("%08X");
+	state_add(SH4_R0_BK0,         "R0 BK 0", m_sh4_state->rbnk[0][0]).formatstr("%08X");
+	state_add(SH4_R1_BK0,         "R1 BK 0", m_sh4_state->rbnk[0][1]).formatstr("%08X");
+	state_add(SH4_R2_BK0,         "R2 BK 0", m_sh4_state->rbnk[0][2]).formatstr("%08X");
+	state_add(SH4_R3_BK0,         "R3 BK 0", m_sh4_state->rbnk[0][3]).formatstr("%08X");
+	state_add(SH4_R4_BK0,         "R4 BK 0", m_sh4_state->rbnk[0][4]).formatstr("%08X");
+	state_add(SH4_R5_BK0,         "R5 BK 0", m_sh4_state->rbnk[0][5]).formatstr("%08X");
+	state_add(SH4_R6_BK0,         "R6 BK 0", m_sh4_state->rbnk[0][6]).formatstr("%08X");
+	state_add(SH4_R7_BK0,         "R7 BK 0", m_sh4_state->rbnk[0][7]).formatstr("%08X");
+	state_add(SH4_R0_BK1,         "R0 BK 1", m_sh4_state->rbnk[1][0]).formatstr("%08X");
+	state_add(SH4_R1_BK1,         "R1 BK 1", m_sh4_state->rbnk[1][1]).formatstr("%08X");
+	state_add(SH4_R2_BK1,         "R2 BK 1", m_sh4_state->rbnk[1][2]).formatstr("%08X");
+	state_add(SH4_R3_BK1,         "R3 BK 1", m_sh4_state->rbnk[1][3]).formatstr("%08X");
+	state_add(SH4_R4_BK1,         "R4 BK 1", m_sh4_state->rbnk[1][4]).formatstr("%08X");
+	state_add(SH4_R5_BK1,         "R5 BK 1", m_sh4_state->rbnk[1][5]).formatstr("%08X");
+	state_add(SH4_R6_BK1,         "R6 BK 1", m_sh4_state->rbnk[1][6]).formatstr("%08X");
+	state_add(SH4_R7_BK1,         "R7 BK 1", m_sh4_state->rbnk[1][7]).formatstr("%08X");
+	state_add(SH4_SPC,            "SPC", m_sh4_state->spc).formatstr("%08X");
+	state_add(SH4_SSR,            "SSR", m_sh4_state->ssr).formatstr("%08X");
+	state_add(SH4_SGR,            "SGR", m_sh4_state->sgr).formatstr("%08X");
+	state_add(SH4_FPSCR,          "FPSCR", m_sh4_state->fpscr).formatstr("%08X");
+	state_add(SH4_FPUL,           "FPUL", m_sh4_state->fpul).formatstr("%08X");
 
 	state_add(SH4_FR0,            "FR0", m_debugger_temp).callimport().formatstr("%25s");
 	state_add(SH4_FR1,            "FR1", m_debugger_temp).callimport().formatstr("%25s");
@@ -4279,11 +4384,75 @@ void sh34_base_device::device_start()
 	state_add(SH4_XF15,           "XF15", m_debugger_temp).callimport().formatstr("%25s");
 
 	state_add(STATE_GENPC, "GENPC", m_debugger_temp).callimport().callexport().noshow();
-	state_add(STATE_GENSP, "GENSP", m_r[15]).noshow();
-	state_add(STATE_GENPCBASE, "GENPCBASE", m_ppc).noshow();
-	state_add(STATE_GENFLAGS, "GENFLAGS", m_sr).formatstr("%20s").noshow();
+	state_add(STATE_GENSP, "GENSP", m_sh4_state->r[15]).noshow();
+	state_add(STATE_GENPCBASE, "GENPCBASE", m_sh4_state->ppc).noshow();
+	state_add(STATE_GENFLAGS, "GENFLAGS", m_sh4_state->sr).formatstr("%20s").noshow();
+
+	m_icountptr = &m_sh4_state->icount;
+
+	/* reset per-driver pcflushes */
+	m_pcfsel = 0;
+
+	/* -drc_compare reruns every natively compiled instruction on the interpreter */
+	m_drc_compare = m_isdrc && machine().options().drc_compare();
+	m_compare_mode = COMPARE_ACCESS_NONE;
+	m_compare_count = 0;
+
+	/* initialize the UML generator; one mode per FPSCR.PR/FPSCR.SZ combination */
+	UINT32 flags = 0;
+	m_drcuml = auto_alloc(machine(), drcuml_state(*this, m_cache, flags, 4, 32, 1));
 
-	m_icountptr = &m_sh4_icount;
+	/* add symbols for our stuff */
+	m_drcuml->symbol_add(&m_sh4_state->pc, sizeof(m_sh4_state->pc), "pc");
+	m_drcuml->symbol_add(&m_sh4_state->icount, sizeof(m_sh4_state->icount), "icount");
+	for (int regnum = 0; regnum < 16; regnum++)
+	{
+		char buf[10];
+		sprintf(buf, "r%d", regnum);
+		m_drcuml->symbol_add(&m_sh4_state->r[regnum], sizeof(m_sh4_state->r[regnum]), buf);
+		sprintf(buf, "fr%d", regnum);
+		m_drcuml->symbol_add(&m_sh4_state->fr[regnum], sizeof(m_sh4_state->fr[regnum]), buf);
+	}
+	m_drcuml->symbol_add(&m_sh4_state->pr, sizeof(m_sh4_state->pr), "pr");
+	m_drcuml->symbol_add(&m_sh4_state->sr, sizeof(m_sh4_state->sr), "sr");
+	m_drcuml->symbol_add(&m_sh4_state->gbr, sizeof(m_sh4_state->gbr), "gbr");
+	m_drcuml->symbol_add(&m_sh4_state->vbr, sizeof(m_sh4_state->vbr), "vbr");
+	m_drcuml->symbol_add(&m_sh4_state->macl, sizeof(m_sh4_state->macl), "macl");
+	m_drcuml->symbol_add(&m_sh4_state->mach, sizeof(m_sh4_state->mach), "mach");
+	m_drcuml->symbol_add(&m_sh4_state->fpul, sizeof(m_sh4_state->fpul), "fpul");
+	m_drcuml->symbol_add(&m_sh4_state->fpscr, sizeof(m_sh4_state->fpscr), "fpscr");
+
+	/* initialize the front-end helper */
+	m_drcfe = auto_alloc(machine(), sh4_frontend(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE));
+
+	/* compute the register parameters */
+	for (int regnum = 0; regnum < 16; regnum++)
+	{
+		m_regmap[regnum] = uml::mem(&m_sh4_state->r[regnum]);
+	}
+
+	/* if we have registers to spare, assign r0, r1, r2 to leftovers */
+	/* WARNING: do not use synthetic registers that are mapped here! */
+	if (!DISABLE_FAST_REGISTERS)
+	{
+		drcbe_info beinfo;
+		m_drcuml->get_backend_info(beinfo);
+		if (beinfo.direct_iregs > 4)
+		{
+			m_regmap[0] = uml::I4;
+		}
+		if (beinfo.direct_iregs > 5)
+		{
+			m_regmap[1] = uml::I5;
+		}
+		if (beinfo.direct_iregs > 6)
+		{
+			m_regmap[2] = uml::I6;
+		}
+	}
+
+	/* mark the cache dirty so it is updated on next execute */
+	m_cache_dirty = TRUE;
 }
 
 void sh34_base_device::state_import(const device_state_entry &entry)
@@ -4297,9 +4466,9 @@ void sh34_base_device::state_import(const device_state_entry &entry)
 	switch (entry.index())
 	{
 		case STATE_GENPC:
-			m_pc = m_debugger_temp;
+			m_sh4_state->pc = m_debugger_temp;
 		case SH4_PC:
-			m_delay = 0;
+			m_sh4_state->delay = 0;
 			break;
 
 		case SH4_SR:
@@ -4308,131 +4477,131 @@ void sh34_base_device::state_import(const device_state_entry &entry)
 			break;
 
 		case SH4_FR0:
-			m_fr[0 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->fr[0 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_FR1:
-			m_fr[1 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->fr[1 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_FR2:
-			m_fr[2 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->fr[2 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_FR3:
-			m_fr[3 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->fr[3 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_FR4:
-			m_fr[4 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->fr[4 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_FR5:
-			m_fr[5 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->fr[5 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_FR6:
-			m_fr[6 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->fr[6 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_FR7:
-			m_fr[7 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->fr[7 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_FR8:
-			m_fr[8 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->fr[8 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_FR9:
-			m_fr[9 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->fr[9 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_FR10:
-			m_fr[10 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->fr[10 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_FR11:
-			m_fr[11 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->fr[11 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_FR12:
-			m_fr[12 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->fr[12 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_FR13:
-			m_fr[13 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->fr[13 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_FR14:
-			m_fr[14 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->fr[14 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_FR15:
-			m_fr[15 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->fr[15 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_XF0:
-			m_xf[0 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->xf[0 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_XF1:
-			m_xf[1 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->xf[1 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_XF2:
-			m_xf[2 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->xf[2 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_XF3:
-			m_xf[3 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->xf[3 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_XF4:
-			m_xf[4 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->xf[4 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_XF5:
-			m_xf[5 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->xf[5 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_XF6:
-			m_xf[6 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->xf[6 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_XF7:
-			m_xf[7 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->xf[7 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_XF8:
-			m_xf[8 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->xf[8 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_XF9:
-			m_xf[9 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->xf[9 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_XF10:
-			m_xf[10 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->xf[10 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_XF11:
-			m_xf[11 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->xf[11 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_XF12:
-			m_xf[12 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->xf[12 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_XF13:
-			m_xf[13 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->xf[13 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_XF14:
-			m_xf[14 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->xf[14 ^ fpu_xor] = m_debugger_temp;
 			break;
 
 		case SH4_XF15:
-			m_xf[15 ^ fpu_xor] = m_debugger_temp;
+			m_sh4_state->xf[15 ^ fpu_xor] = m_debugger_temp;
 			break;
 	}
 }
@@ -4442,7 +4611,7 @@ void sh34_base_device::state_export(const device_state_entry &entry)
 	switch (entry.index())
 	{
 		case STATE_GENPC:
-			m_debugger_temp = (m_delay) ? (m_delay & AM) : (m_pc & AM);
+			m_debugger_temp = (m_sh4_state->delay) ? (m_sh4_state->delay & AM) : (m_sh4_state->pc & AM);
 			break;
 	}
 }
@@ -4459,143 +4628,143 @@ void sh34_base_device::state_string_export(const device_state_entry &entry, std:
 	{
 		case STATE_GENFLAGS:
 			strprintf(str, "%s%s%s%s%c%c%d%c%c",
-					m_sr & MD ? "MD ":"   ",
-					m_sr & sRB ? "RB ":"   ",
-					m_sr & BL ? "BL ":"   ",
-					m_sr & FD ? "FD ":"   ",
-					m_sr & M ? 'M':'.',
-					m_sr & Q ? 'Q':'.',
-					(m_sr & I) >> 4,
-					m_sr & S ? 'S':'.',
-					m_sr & T ? 'T':'.');
+					m_sh4_state->sr & MD ? "MD ":"   ",
+					m_sh4_state->sr & sRB ? "RB ":"   ",
+					m_sh4_state->sr & BL ? "BL ":"   ",
+					m_sh4_state->sr & FD ? "FD ":"   ",
+					m_sh4_state->sr & M ? 'M':'.',
+					m_sh4_state->sr & Q ? 'Q':'.',
+					(m_sh4_state->sr & I) >> 4,
+					m_sh4_state->sr & S ? 'S':'.',
+					m_sh4_state->sr & T ? 'T':'.');
 			break;
 
 		case SH4_FR0:
-			strprintf(str, "%08X %f", m_fr[0 ^ fpu_xor], (double)FP_RFS(0 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->fr[0 ^ fpu_xor], (double)FP_RFS(0 ^ fpu_xor));
 			break;
 
 		case SH4_FR1:
-			strprintf(str, "%08X %f", m_fr[1 ^ fpu_xor], (double)FP_RFS(1 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->fr[1 ^ fpu_xor], (double)FP_RFS(1 ^ fpu_xor));
 			break;
 
 		case SH4_FR2:
-			strprintf(str, "%08X %f", m_fr[2 ^ fpu_xor], (double)FP_RFS(2 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->fr[2 ^ fpu_xor], (double)FP_RFS(2 ^ fpu_xor));
 			break;
 
 		case SH4_FR3:
-			strprintf(str, "%08X %f", m_fr[3 ^ fpu_xor], (double)FP_RFS(3 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->fr[3 ^ fpu_xor], (double)FP_RFS(3 ^ fpu_xor));
 			break;
 
 		case SH4_FR4:
-			strprintf(str, "%08X %f", m_fr[4 ^ fpu_xor], (double)FP_RFS(4 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->fr[4 ^ fpu_xor], (double)FP_RFS(4 ^ fpu_xor));
 			break;
 
 		case SH4_FR5:
-			strprintf(str, "%08X %f", m_fr[5 ^ fpu_xor], (double)FP_RFS(5 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->fr[5 ^ fpu_xor], (double)FP_RFS(5 ^ fpu_xor));
 			break;
 
 		case SH4_FR6:
-			strprintf(str, "%08X %f", m_fr[6 ^ fpu_xor], (double)FP_RFS(6 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->fr[6 ^ fpu_xor], (double)FP_RFS(6 ^ fpu_xor));
 			break;
 
 		case SH4_FR7:
-			strprintf(str, "%08X %f", m_fr[7 ^ fpu_xor], (double)FP_RFS(7 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->fr[7 ^ fpu_xor], (double)FP_RFS(7 ^ fpu_xor));
 			break;
 
 		case SH4_FR8:
-			strprintf(str, "%08X %f", m_fr[8 ^ fpu_xor], (double)FP_RFS(8 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->fr[8 ^ fpu_xor], (double)FP_RFS(8 ^ fpu_xor));
 			break;
 
 		case SH4_FR9:
-			strprintf(str, "%08X %f", m_fr[9 ^ fpu_xor], (double)FP_RFS(9 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->fr[9 ^ fpu_xor], (double)FP_RFS(9 ^ fpu_xor));
 			break;
 
 		case SH4_FR10:
-			strprintf(str, "%08X %f", m_fr[10 ^ fpu_xor], (double)FP_RFS(10 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->fr[10 ^ fpu_xor], (double)FP_RFS(10 ^ fpu_xor));
 			break;
 
 		case SH4_FR11:
-			strprintf(str, "%08X %f", m_fr[11 ^ fpu_xor], (double)FP_RFS(11 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->fr[11 ^ fpu_xor], (double)FP_RFS(11 ^ fpu_xor));
 			break;
 
 		case SH4_FR12:
-			strprintf(str, "%08X %f", m_fr[12 ^ fpu_xor], (double)FP_RFS(12 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->fr[12 ^ fpu_xor], (double)FP_RFS(12 ^ fpu_xor));
 			break;
 
 		case SH4_FR13:
-			strprintf(str, "%08X %f", m_fr[13 ^ fpu_xor], (double)FP_RFS(13 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->fr[13 ^ fpu_xor], (double)FP_RFS(13 ^ fpu_xor));
 			break;
 
 		case SH4_FR14:
-			strprintf(str, "%08X %f", m_fr[14 ^ fpu_xor], (double)FP_RFS(14 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->fr[14 ^ fpu_xor], (double)FP_RFS(14 ^ fpu_xor));
 			break;
 
 		case SH4_FR15:
-			strprintf(str, "%08X %f", m_fr[15 ^ fpu_xor], (double)FP_RFS(15 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->fr[15 ^ fpu_xor], (double)FP_RFS(15 ^ fpu_xor));
 			break;
 
 		case SH4_XF0:
-			strprintf(str, "%08X %f", m_xf[0 ^ fpu_xor], (double)FP_XFS(0 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->xf[0 ^ fpu_xor], (double)FP_XFS(0 ^ fpu_xor));
 			break;
 
 		case SH4_XF1:
-			strprintf(str, "%08X %f", m_xf[1 ^ fpu_xor], (double)FP_XFS(1 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->xf[1 ^ fpu_xor], (double)FP_XFS(1 ^ fpu_xor));
 			break;
 
 		case SH4_XF2:
-			strprintf(str, "%08X %f", m_xf[2 ^ fpu_xor], (double)FP_XFS(2 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->xf[2 ^ fpu_xor], (double)FP_XFS(2 ^ fpu_xor));
 			break;
 
 		case SH4_XF3:
-			strprintf(str, "%08X %f", m_xf[3 ^ fpu_xor], (double)FP_XFS(3 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->xf[3 ^ fpu_xor], (double)FP_XFS(3 ^ fpu_xor));
 			break;
 
 		case SH4_XF4:
-			strprintf(str, "%08X %f", m_xf[4 ^ fpu_xor], (double)FP_XFS(4 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->xf[4 ^ fpu_xor], (double)FP_XFS(4 ^ fpu_xor));
 			break;
 
 		case SH4_XF5:
-			strprintf(str, "%08X %f", m_xf[5 ^ fpu_xor], (double)FP_XFS(5 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->xf[5 ^ fpu_xor], (double)FP_XFS(5 ^ fpu_xor));
 			break;
 
 		case SH4_XF6:
-			strprintf(str, "%08X %f", m_xf[6 ^ fpu_xor], (double)FP_XFS(6 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->xf[6 ^ fpu_xor], (double)FP_XFS(6 ^ fpu_xor));
 			break;
 
 		case SH4_XF7:
-			strprintf(str, "%08X %f", m_xf[7 ^ fpu_xor], (double)FP_XFS(7 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->xf[7 ^ fpu_xor], (double)FP_XFS(7 ^ fpu_xor));
 			break;
 
 		case SH4_XF8:
-			strprintf(str, "%08X %f", m_xf[8 ^ fpu_xor], (double)FP_XFS(8 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->xf[8 ^ fpu_xor], (double)FP_XFS(8 ^ fpu_xor));
 			break;
 
 		case SH4_XF9:
-			strprintf(str, "%08X %f", m_xf[9 ^ fpu_xor], (double)FP_XFS(9 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->xf[9 ^ fpu_xor], (double)FP_XFS(9 ^ fpu_xor));
 			break;
 
 		case SH4_XF10:
-			strprintf(str, "%08X %f", m_xf[10 ^ fpu_xor], (double)FP_XFS(10 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->xf[10 ^ fpu_xor], (double)FP_XFS(10 ^ fpu_xor));
 			break;
 
 		case SH4_XF11:
-			strprintf(str, "%08X %f", m_xf[11 ^ fpu_xor], (double)FP_XFS(11 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->xf[11 ^ fpu_xor], (double)FP_XFS(11 ^ fpu_xor));
 			break;
 
 		case SH4_XF12:
-			strprintf(str, "%08X %f", m_xf[12 ^ fpu_xor], (double)FP_XFS(12 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->xf[12 ^ fpu_xor], (double)FP_XFS(12 ^ fpu_xor));
 			break;
 
 		case SH4_XF13:
-			strprintf(str, "%08X %f", m_xf[13 ^ fpu_xor], (double)FP_XFS(13 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->xf[13 ^ fpu_xor], (double)FP_XFS(13 ^ fpu_xor));
 			break;
 
 		case SH4_XF14:
-			strprintf(str, "%08X %f", m_xf[14 ^ fpu_xor], (double)FP_XFS(14 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->xf[14 ^ fpu_xor], (double)FP_XFS(14 ^ fpu_xor));
 			break;
 
 		case SH4_XF15:
-			strprintf(str, "%08X %f", m_xf[15 ^ fpu_xor], (double)FP_XFS(15 ^ fpu_xor));
+			strprintf(str, "%08X %f", m_sh4_state->xf[15 ^ fpu_xor], (double)FP_XFS(15 ^ fpu_xor));
 			break;
 
 	}
@@ -4606,3 +4775,5 @@ void sh34_base_device::sh4_set_ftcsr_callback(sh4_ftcsr_callback callback)
 {
 	m_ftcsr_read_callback = callback;
 }
+
+#include "sh4drc.c"
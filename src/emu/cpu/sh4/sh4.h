@@ -13,6 +13,9 @@
 #ifndef __SH4_H__
 #define __SH4_H__
 
+#include "cpu/drcfe.h"
+#include "cpu/drcuml.h"
+
 // doesn't actually seem to improve performance at all
 #define SH4_USE_FASTRAM_OPTIMIZATION 0
 #define SH4_MAX_FASTRAM       3
@@ -138,6 +141,8 @@ struct sh4_ddt_dma
 
 typedef void (*sh4_ftcsr_callback)(UINT32);
 
+class sh4_frontend;
+
 
 #define MCFG_SH4_MD0(_md0) \
 	sh34_base_device::set_md0(*device, _md0);
@@ -172,6 +177,8 @@ typedef void (*sh4_ftcsr_callback)(UINT32);
 
 class sh34_base_device : public cpu_device
 {
+	friend class sh4_frontend;
+
 public:
 	// construction/destruction
 	sh34_base_device(const machine_config &mconfig, device_type type, const char *name, const char *tag, device_t *owner, UINT32 clock, const char *shortname, endianness_t endianness, address_map_constructor internal);
@@ -202,10 +209,14 @@ public:
 	int sh4_dma_data(struct sh4_device_dma *s);
 	void sh4_dma_ddt(struct sh4_ddt_dma *s);
 
+	void sh4drc_set_options(UINT32 options);
+	void sh4drc_add_pcflush(offs_t address);
+
 protected:
 	// device-level overrides
 	virtual void device_start();
 	virtual void device_reset();
+	virtual void device_stop();
 
 	// device_execute_interface overrides
 	virtual UINT32 execute_min_cycles() const { return 1; }
@@ -242,29 +253,45 @@ protected:
 	int c_md8;
 	int c_clock;
 
-	UINT32  m_ppc;
-	UINT32  m_pc;
-	UINT32  m_spc;
-	UINT32  m_pr;
-	UINT32  m_sr;
-	UINT32  m_ssr;
-	UINT32  m_gbr;
-	UINT32  m_vbr;
-	UINT32  m_mach;
-	UINT32  m_macl;
-	UINT32  m_r[16];
-	UINT32  m_rbnk[2][8];
-	UINT32  m_sgr;
-	UINT32  m_fr[16];
-	UINT32  m_xf[16];
-	UINT32  m_ea;
-	UINT32  m_delay;
+	// Data that needs to be stored close to the generated DRC code
+	struct internal_sh4_state
+	{
+		UINT32  fr[16];             // first, so that the register pairs are 64-bit aligned
+		UINT32  xf[16];
+		UINT32  ppc;
+		UINT32  pc;
+		UINT32  spc;
+		UINT32  pr;
+		UINT32  sr;
+		UINT32  ssr;
+		UINT32  gbr;
+		UINT32  vbr;
+		UINT32  mach;
+		UINT32  macl;
+		UINT32  r[16];
+		UINT32  rbnk[2][8];
+		UINT32  sgr;
+		UINT32  ea;
+		UINT32  delay;
+		UINT32  test_irq;
+		UINT32  fpscr;
+		UINT32  fpul;
+		UINT32  dbr;
+		int     icount;
+		UINT32  target;             // target for jmp/jsr/etc so the delay slot can't kill it
+		UINT32  arg0;               // opcode for the interpreter fallback
+		UINT32  compare_pc;         // -drc_compare: instruction being checked, its opcode and delay slot
+		UINT32  compare_op;
+		UINT32  compare_slot;
+		UINT32  compare_nextpc;     // where the native code continues after it
+		UINT32  compare_address;    // arguments of its memory accesses
+		UINT32  compare_data;
+		UINT32  compare_size;
+	};
+
+	internal_sh4_state *m_sh4_state;
 	UINT32  m_cpu_off;
 	UINT32  m_pending_irq;
-	UINT32  m_test_irq;
-	UINT32  m_fpscr;
-	UINT32  m_fpul;
-	UINT32  m_dbr;
 
 	UINT32  m_exception_priority[128];
 	int     m_exception_requesting[128];
@@ -343,7 +370,6 @@ protected:
 	int     m_dma_destination_increment[4];
 	int     m_dma_mode[4];
 
-	int     m_sh4_icount;
 	int     m_is_slave;
 	int     m_cpu_clock;
 	int     m_bus_clock;
@@ -370,6 +396,110 @@ protected:
 
 	UINT64 m_debugger_temp;
 
+	bool m_isdrc;
+	UINT32 m_code_xor;                              /* XOR applied to code fetches */
+
+	drc_cache           m_cache;                    /* pointer to the DRC code cache */
+	drcuml_state *      m_drcuml;                   /* DRC UML generator state */
+	sh4_frontend *      m_drcfe;                    /* pointer to the DRC front-end state */
+	UINT32              m_drcoptions;               /* configurable DRC options */
+
+	/* internal stuff */
+	UINT8               m_cache_dirty;              /* true if we need to flush the cache */
+
+	int                 m_pcfsel;                   /* last pcflush entry set */
+	UINT32              m_pcflushes[16];            /* pcflush entries */
+
+	/* lock-step comparison against the interpreter (-drc_compare) */
+	struct compare_access
+	{
+		UINT32          address;                    /* address as the instruction computed it */
+		UINT32          data;                       /* data read or written */
+		UINT8           size;                       /* access size in bytes */
+		UINT8           write;                      /* true for writes */
+	};
+
+	bool                m_drc_compare;              /* check every native instruction against the interpreter */
+	int                 m_compare_mode;             /* COMPARE_ACCESS_* for the memory accessors */
+	internal_sh4_state  m_compare_state;            /* state before the instruction being compared */
+	int                 m_compare_fpu_sz;           /* FPSCR.SZ copy before the instruction */
+	int                 m_compare_fpu_pr;           /* FPSCR.PR copy before the instruction */
+	std::vector<compare_access> m_compare_log;      /* accesses made by the native code */
+	UINT32              m_compare_replayed;         /* accesses the interpreter has matched so far */
+	bool                m_compare_direct_reads;     /* interpreter may read constants the compiler folded */
+	std::string         m_compare_error;            /* description of the first access mismatch */
+	UINT64              m_compare_count;            /* instructions checked so far */
+
+	/* register mappings */
+	uml::parameter      m_regmap[16];               /* parameter to register mappings for all 16 integer registers */
+
+	uml::code_handle *  m_entry;                    /* entry point */
+	uml::code_handle *  m_read8;                    /* read byte */
+	uml::code_handle *  m_write8;                   /* write byte */
+	uml::code_handle *  m_read16;                   /* read half */
+	uml::code_handle *  m_write16;                  /* write half */
+	uml::code_handle *  m_read32;                   /* read word */
+	uml::code_handle *  m_write32;                  /* write word */
+
+	uml::code_handle *  m_interrupt;                /* interrupt */
+	uml::code_handle *  m_nocode;                   /* nocode */
+	uml::code_handle *  m_out_of_cycles;            /* out of cycles exception handler */
+
+	/* internal compiler state */
+	struct compiler_state
+	{
+		UINT32          cycles;                     /* accumulated cycles */
+		UINT8           checkints;                  /* need to check interrupts before next instruction */
+		UINT8           mode;                       /* FPSCR.SZ/PR mode the block was compiled for */
+		UINT8           redispatch;                 /* FPSCR may have changed, so branch via the live mode */
+		uml::code_label  labelnum;                   /* index for local labels */
+		UINT8           compare;                    /* an interpreter comparison is open for this instruction */
+	};
+
+	inline UINT32 epc(const opcode_desc *desc);
+	inline void alloc_handle(drcuml_state *drcuml, uml::code_handle **handleptr, const char *name);
+	inline void load_fast_iregs(drcuml_block *block);
+	inline void save_fast_iregs(drcuml_block *block);
+
+	void code_flush_cache();
+	void execute_run_drc();
+	void code_compile_block(UINT8 mode, offs_t pc);
+	void static_generate_entry_point();
+	void static_generate_nocode_handler();
+	void static_generate_out_of_cycles();
+	void static_generate_memory_accessor(int size, int iswrite, const char *name, uml::code_handle **handleptr);
+	const char *log_desc_flags_to_string(UINT32 flags);
+	void log_register_list(drcuml_state *drcuml, const char *string, const UINT32 *reglist, const UINT32 *regnostarlist);
+	void log_opcode_desc(drcuml_state *drcuml, const opcode_desc *desclist, int indent);
+	void log_add_disasm_comment(drcuml_block *block, UINT32 pc, UINT32 op);
+	void generate_update_cycles(drcuml_block *block, compiler_state *compiler, uml::parameter param, int allow_exception);
+	void generate_hashjmp(drcuml_block *block, compiler_state *compiler, uml::parameter param);
+	void generate_checksum_block(drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast);
+	void generate_sequence_instruction(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 ovrpc);
+	void generate_delay_slot(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 ovrpc);
+	void generate_interpreter_call(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 ovrpc);
+	void generate_compare_end(drcuml_block *block, compiler_state *compiler, uml::parameter param);
+	int generate_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 ovrpc);
+	int generate_group_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc);
+	int generate_group_2(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc);
+	int generate_group_3(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, UINT32 ovrpc);
+	int generate_group_4(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc);
+	int generate_group_6(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc);
+	int generate_group_8(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc);
+	int generate_group_12(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc);
+	int generate_group_15(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc);
+	int generate_group_15_0x13(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode);
+
+public:
+	void func_printf_probe();
+	void func_execute_one();
+	void func_check_pending_irq();
+	void func_compare_begin();
+	void func_compare_cancel();
+	void func_compare_end();
+	void func_compare_memory();
+
+protected:
 
 	void execute_one_0000(const UINT16 opcode);
 	void execute_one_4000(const UINT16 opcode);
@@ -612,6 +742,8 @@ protected:
 	UINT8 RB(offs_t A);
 	UINT16 RW(offs_t A);
 	UINT32 RL(offs_t A);
+	UINT32 compare_read(offs_t A, int size);
+	void compare_write(offs_t A, int size, UINT32 V);
 	void sh4_change_register_bank(int to);
 	void sh4_swap_fp_registers();
 	void sh4_swap_fp_couples();
@@ -780,6 +912,28 @@ protected:
 };
 
 
+class sh4_frontend : public drc_frontend
+{
+public:
+	sh4_frontend(sh34_base_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence);
+
+protected:
+	virtual bool describe(opcode_desc &desc, const opcode_desc *prev);
+
+private:
+	bool describe_group_0(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
+	bool describe_group_2(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
+	bool describe_group_3(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
+	bool describe_group_4(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
+	bool describe_group_6(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
+	bool describe_group_8(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
+	bool describe_group_12(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
+	bool describe_group_15(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
+
+	sh34_base_device *m_sh4;
+};
+
+
 extern const device_type SH3LE;
 extern const device_type SH3BE;
 extern const device_type SH4LE;
@@ -797,7 +951,4 @@ extern const device_type SH4BE;
 #define SH4DRC_COMPATIBLE_OPTIONS   (SH4DRC_STRICT_VERIFY | SH4DRC_FLUSH_PC | SH4DRC_STRICT_PCREL)
 #define SH4DRC_FASTEST_OPTIONS  (0)
 
-void sh4drc_set_options(device_t *device, UINT32 options);
-void sh4drc_add_pcflush(device_t *device, offs_t address);
-
 #endif /* __SH4_H__ */
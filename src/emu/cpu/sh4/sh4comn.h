@@ -13,108 +13,36 @@
 #ifndef __SH4COMN_H__
 #define __SH4COMN_H__
 
-//#define USE_SH4DRC
-
 /* speed up delay loops, bail out of tight loops */
 #define BUSY_LOOP_HACKS     0
 
 #define VERBOSE 0
 
-#ifdef USE_SH4DRC
-#include "cpu/drcfe.h"
-#include "cpu/drcuml.h"
-#include "cpu/drcumlsh.h"
-
-class sh4_frontend;
-#endif
-
 #define CPU_TYPE_SH3    (2)
 #define CPU_TYPE_SH4    (3)
 
+/* what the memory accessors do while the recompiler is checked against the interpreter */
+#define COMPARE_ACCESS_NONE     (0)     /* access memory */
+#define COMPARE_ACCESS_RECORD   (1)     /* access memory and log the access */
+#define COMPARE_ACCESS_REPLAY   (2)     /* match the access against the log instead */
+
 #define LOG(x)  do { if (VERBOSE) logerror x; } while (0)
 
 #define EXPPRI(pl,po,p,n)   (((4-(pl)) << 24) | ((15-(po)) << 16) | ((p) << 8) | (255-(n)))
 #define NMIPRI()            EXPPRI(3,0,16,SH4_INTC_NMI)
 #define INTPRI(p,n)         EXPPRI(4,2,p,n)
 
-#define FP_RS(r) m_fr[(r)] // binary representation of single precision floating point register r
-#define FP_RFS(r) *( (float  *)(m_fr+(r)) ) // single precision floating point register r
-#define FP_RFD(r) *( (double *)(m_fr+(r)) ) // double precision floating point register r
-#define FP_XS(r) m_xf[(r)] // binary representation of extended single precision floating point register r
-#define FP_XFS(r) *( (float  *)(m_xf+(r)) ) // single precision extended floating point register r
-#define FP_XFD(r) *( (double *)(m_xf+(r)) ) // double precision extended floating point register r
+#define FP_RS(r) m_sh4_state->fr[(r)] // binary representation of single precision floating point register r
+#define FP_RFS(r) *( (float  *)(m_sh4_state->fr+(r)) ) // single precision floating point register r
+#define FP_RFD(r) *( (double *)(m_sh4_state->fr+(r)) ) // double precision floating point register r
+#define FP_XS(r) m_sh4_state->xf[(r)] // binary representation of extended single precision floating point register r
+#define FP_XFS(r) *( (float  *)(m_sh4_state->xf+(r)) ) // single precision extended floating point register r
+#define FP_XFD(r) *( (double *)(m_sh4_state->xf+(r)) ) // double precision extended floating point register r
 #ifdef LSB_FIRST
-#define FP_RS2(r) m_fr[(r) ^ m_fpu_pr]
-#define FP_RFS2(r) *( (float  *)(m_fr+((r) ^ m_fpu_pr)) )
-#define FP_XS2(r) m_xf[(r) ^ m_fpu_pr]
-#define FP_XFS2(r) *( (float  *)(m_xf+((r) ^ m_fpu_pr)) )
-#endif
-
-
-#ifdef USE_SH4DRC
-struct sh4_state
-{
-	int icount;
-
-	int pcfsel;                 // last pcflush entry set
-	int maxpcfsel;              // highest valid pcflush entry
-	UINT32 pcflushes[16];       // pcflush entries
-
-	drc_cache *         cache;              /* pointer to the DRC code cache */
-	drcuml_state *      drcuml;             /* DRC UML generator state */
-	sh4_frontend *      drcfe;              /* pointer to the DRC front-end class */
-	UINT32              drcoptions;         /* configurable DRC options */
-
-	/* internal stuff */
-	UINT8               cache_dirty;        /* true if we need to flush the cache */
-
-	/* parameters for subroutines */
-	UINT64              numcycles;          /* return value from gettotalcycles */
-	UINT32              arg0;               /* print_debug argument 1 */
-	UINT32              arg1;               /* print_debug argument 2 */
-	UINT32              irq;                /* irq we're taking */
-
-	/* register mappings */
-	uml::parameter  regmap[16];                 /* parameter to register mappings for all 16 integer registers */
-
-	uml::code_handle *  entry;                      /* entry point */
-	uml::code_handle *  read8;                  /* read byte */
-	uml::code_handle *  write8;                 /* write byte */
-	uml::code_handle *  read16;                 /* read half */
-	uml::code_handle *  write16;                    /* write half */
-	uml::code_handle *  read32;                 /* read word */
-	uml::code_handle *  write32;                    /* write word */
-
-	uml::code_handle *  interrupt;              /* interrupt */
-	uml::code_handle *  nocode;                 /* nocode */
-	uml::code_handle *  out_of_cycles;              /* out of cycles exception handler */
-
-	UINT32 prefadr;
-	UINT32 target;
-};
-#endif
-
-#ifdef USE_SH4DRC
-class sh4_frontend : public drc_frontend
-{
-public:
-	sh4_frontend(sh4_state &state, UINT32 window_start, UINT32 window_end, UINT32 max_sequence);
-
-protected:
-	virtual bool describe(opcode_desc &desc, const opcode_desc *prev);
-
-private:
-	bool describe_group_0(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
-	bool describe_group_2(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
-	bool describe_group_3(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
-	bool describe_group_4(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
-	bool describe_group_6(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
-	bool describe_group_8(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
-	bool describe_group_12(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
-	bool describe_group_15(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
-
-	sh4_state &m_context;
-};
+#define FP_RS2(r) m_sh4_state->fr[(r) ^ m_fpu_pr]
+#define FP_RFS2(r) *( (float  *)(m_sh4_state->fr+((r) ^ m_fpu_pr)) )
+#define FP_XS2(r) m_sh4_state->xf[(r) ^ m_fpu_pr]
+#define FP_XFS2(r) *( (float  *)(m_sh4_state->xf+((r) ^ m_fpu_pr)) )
 #endif
 
 
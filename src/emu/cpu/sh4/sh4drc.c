@@ -0,0 +1,2956 @@
+// license:BSD-3-Clause
+// copyright-holders:R. Belmont
+/***************************************************************************
+
+    sh4drc.c
+    Universal machine language-based SH-4 emulator.
+
+    Included from sh4.c so that the interpreter's inline memory
+    accessors and opcode handlers can be reused for the instructions
+    that are not worth generating natively.
+
+***************************************************************************/
+
+#include "debugger.h"
+#include "mconfig.h"
+#include "cpu/drcumlsh.h"
+
+extern unsigned DasmSH4(char *buffer, unsigned pc, UINT16 opcode);
+
+using namespace uml;
+
+/***************************************************************************
+    DEBUGGING
+***************************************************************************/
+
+#define SET_EA                      (0) // makes slower but "shows work" in the EA fake register like the interpreter
+
+#if SET_EA
+#define SETEA(x) UML_MOV(block, mem(&m_sh4_state->ea), ireg(x))
+#else
+#define SETEA(x)
+#endif
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* map variables */
+#define MAPVAR_PC                   M0
+#define MAPVAR_CYCLES                   M1
+
+/* exit codes */
+#define EXECUTE_OUT_OF_CYCLES           0
+#define EXECUTE_MISSING_CODE            1
+#define EXECUTE_UNMAPPED_CODE           2
+#define EXECUTE_RESET_CACHE         3
+
+#define PROBE_ADDRESS                   ~0
+
+/* blocks are compiled per FPSCR.PR/FPSCR.SZ combination; the mode is FPSCR >> MODE_SHIFT */
+#define MODE_SHIFT                  19
+#define MODE_PR                     0x01
+#define MODE_SZ                     0x02
+
+
+/***************************************************************************
+    MACROS
+***************************************************************************/
+
+#define R32(reg)        m_regmap[reg]
+#define FR32(reg)       mem(&m_sh4_state->fr[reg])
+#define XF32(reg)       mem(&m_sh4_state->xf[reg])
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    epc - compute the exception PC from a
+    descriptor
+-------------------------------------------------*/
+
+UINT32 sh34_base_device::epc(const opcode_desc *desc)
+{
+	return (desc->flags & OPFLAG_IN_DELAY_SLOT) ? (desc->pc - 1) : desc->pc;
+}
+
+/*-------------------------------------------------
+    alloc_handle - allocate a handle if not
+    already allocated
+-------------------------------------------------*/
+
+void sh34_base_device::alloc_handle(drcuml_state *drcuml, code_handle **handleptr, const char *name)
+{
+	if (*handleptr == NULL)
+		*handleptr = drcuml->handle_alloc(name);
+}
+
+/*-------------------------------------------------
+    load_fast_iregs - load any fast integer
+    registers
+-------------------------------------------------*/
+
+void sh34_base_device::load_fast_iregs(drcuml_block *block)
+{
+	int regnum;
+
+	for (regnum = 0; regnum < ARRAY_LENGTH(m_regmap); regnum++)
+	{
+		if (m_regmap[regnum].is_int_register())
+		{
+			UML_MOV(block, uml::parameter::make_ireg(m_regmap[regnum].ireg()), mem(&m_sh4_state->r[regnum]));
+		}
+	}
+}
+
+
+/*-------------------------------------------------
+    save_fast_iregs - save any fast integer
+    registers
+-------------------------------------------------*/
+
+void sh34_base_device::save_fast_iregs(drcuml_block *block)
+{
+	int regnum;
+
+	for (regnum = 0; regnum < ARRAY_LENGTH(m_regmap); regnum++)
+	{
+		if (m_regmap[regnum].is_int_register())
+		{
+			UML_MOV(block, mem(&m_sh4_state->r[regnum]), uml::parameter::make_ireg(m_regmap[regnum].ireg()));
+		}
+	}
+}
+
+/*-------------------------------------------------
+    cfunc_printf_probe - print the current CPU
+    state and return
+-------------------------------------------------*/
+
+static void cfunc_printf_probe(void *param)
+{
+	((sh34_base_device *)param)->func_printf_probe();
+}
+
+void sh34_base_device::func_printf_probe()
+{
+	UINT32 pc = m_sh4_state->pc;
+
+	printf(" PC=%08X          r0=%08X  r1=%08X  r2=%08X\n",
+		pc,
+		(UINT32)m_sh4_state->r[0],
+		(UINT32)m_sh4_state->r[1],
+		(UINT32)m_sh4_state->r[2]);
+	printf(" r3=%08X  r4=%08X  r5=%08X  r6=%08X\n",
+		(UINT32)m_sh4_state->r[3],
+		(UINT32)m_sh4_state->r[4],
+		(UINT32)m_sh4_state->r[5],
+		(UINT32)m_sh4_state->r[6]);
+	printf(" r7=%08X  r8=%08X  r9=%08X  r10=%08X\n",
+		(UINT32)m_sh4_state->r[7],
+		(UINT32)m_sh4_state->r[8],
+		(UINT32)m_sh4_state->r[9],
+		(UINT32)m_sh4_state->r[10]);
+	printf(" r11=%08X  r12=%08X  r13=%08X  r14=%08X\n",
+		(UINT32)m_sh4_state->r[11],
+		(UINT32)m_sh4_state->r[12],
+		(UINT32)m_sh4_state->r[13],
+		(UINT32)m_sh4_state->r[14]);
+	printf(" r15=%08X  macl=%08X  mach=%08X  gbr=%08X\n",
+		(UINT32)m_sh4_state->r[15],
+		(UINT32)m_sh4_state->macl,
+		(UINT32)m_sh4_state->mach,
+		(UINT32)m_sh4_state->gbr);
+	printf(" sr=%08X  fpscr=%08X  fpul=%08X\n",
+		(UINT32)m_sh4_state->sr,
+		(UINT32)m_sh4_state->fpscr,
+		(UINT32)m_sh4_state->fpul);
+}
+
+/*-------------------------------------------------
+    cfunc_execute_one - run a single instruction
+    through the interpreter
+-------------------------------------------------*/
+
+static void cfunc_execute_one(void *param)
+{
+	((sh34_base_device *)param)->func_execute_one();
+}
+
+void sh34_base_device::func_execute_one()
+{
+	execute_one(m_sh4_state->arg0);
+}
+
+/*-------------------------------------------------
+    cfunc_check_pending_irq - take the highest
+    priority pending exception
+-------------------------------------------------*/
+
+static void cfunc_check_pending_irq(void *param)
+{
+	((sh34_base_device *)param)->func_check_pending_irq();
+}
+
+void sh34_base_device::func_check_pending_irq()
+{
+	sh4_check_pending_irq("sh4drc");
+}
+
+/*-------------------------------------------------
+    cfunc_compare_begin - snapshot the state
+    before a natively generated instruction and
+    start logging its memory accesses
+-------------------------------------------------*/
+
+static void cfunc_compare_begin(void *param)
+{
+	((sh34_base_device *)param)->func_compare_begin();
+}
+
+void sh34_base_device::func_compare_begin()
+{
+	m_compare_state = *m_sh4_state;
+	m_compare_fpu_sz = m_fpu_sz;
+	m_compare_fpu_pr = m_fpu_pr;
+	m_compare_log.clear();
+	m_compare_mode = COMPARE_ACCESS_RECORD;
+}
+
+/*-------------------------------------------------
+    cfunc_compare_cancel - stop logging when the
+    instruction went to the interpreter anyway
+-------------------------------------------------*/
+
+static void cfunc_compare_cancel(void *param)
+{
+	((sh34_base_device *)param)->func_compare_cancel();
+}
+
+void sh34_base_device::func_compare_cancel()
+{
+	m_compare_mode = COMPARE_ACCESS_NONE;
+}
+
+/*-------------------------------------------------
+    cfunc_compare_memory - memory accessor used
+    by the native code while comparing
+-------------------------------------------------*/
+
+static void cfunc_compare_memory(void *param)
+{
+	((sh34_base_device *)param)->func_compare_memory();
+}
+
+void sh34_base_device::func_compare_memory()
+{
+	internal_sh4_state *state = m_sh4_state;
+
+	switch (state->compare_size)
+	{
+		case 1:     state->compare_data = RB(state->compare_address);              break;
+		case 2:     state->compare_data = RW(state->compare_address);              break;
+		case 4:     state->compare_data = RL(state->compare_address);              break;
+		case 0x81:  WB(state->compare_address, state->compare_data);               break;
+		case 0x82:  WW(state->compare_address, state->compare_data);               break;
+		case 0x84:  WL(state->compare_address, state->compare_data);               break;
+	}
+}
+
+/*-------------------------------------------------
+    compare_read/compare_write - log the native
+    code's accesses, then hand the interpreter
+    the same reads and check its writes
+-------------------------------------------------*/
+
+UINT32 sh34_base_device::compare_read(offs_t A, int size)
+{
+	int mode = m_compare_mode;
+	UINT32 data = 0;
+
+	/* the native side really reads, and remembers what it got */
+	if (mode == COMPARE_ACCESS_RECORD)
+	{
+		m_compare_mode = COMPARE_ACCESS_NONE;
+		data = (size == 1) ? RB(A) : (size == 2) ? RW(A) : RL(A);
+		m_compare_mode = mode;
+
+		compare_access access = { A, data, (UINT8)size, FALSE };
+		m_compare_log.push_back(access);
+		return data;
+	}
+
+	/* the interpreter gets the next logged read, which must be the same access */
+	if (m_compare_replayed < m_compare_log.size())
+	{
+		const compare_access &access = m_compare_log[m_compare_replayed];
+		if (!access.write && access.address == A && access.size == size)
+		{
+			m_compare_replayed++;
+			return access.data;
+		}
+	}
+
+	/* PC-relative constants may have been folded at compile time; read them for real */
+	if (m_compare_direct_reads)
+	{
+		m_compare_mode = COMPARE_ACCESS_NONE;
+		data = (size == 1) ? RB(A) : (size == 2) ? RW(A) : RL(A);
+		m_compare_mode = mode;
+		return data;
+	}
+
+	if (m_compare_error.empty())
+		strprintf(m_compare_error, "interpreter read%d %08X as access %d, which the native code did not make\n", size * 8, A, m_compare_replayed);
+	return 0;
+}
+
+void sh34_base_device::compare_write(offs_t A, int size, UINT32 V)
+{
+	int mode = m_compare_mode;
+
+	if (mode == COMPARE_ACCESS_RECORD)
+	{
+		m_compare_mode = COMPARE_ACCESS_NONE;
+		if (size == 1)
+			WB(A, V);
+		else if (size == 2)
+			WW(A, V);
+		else
+			WL(A, V);
+		m_compare_mode = mode;
+
+		compare_access access = { A, V, (UINT8)size, TRUE };
+		m_compare_log.push_back(access);
+		return;
+	}
+
+	/* the interpreter's writes are only checked, the native code has already made them */
+	if (m_compare_replayed < m_compare_log.size())
+	{
+		const compare_access &access = m_compare_log[m_compare_replayed];
+		if (access.write && access.address == A && access.size == size && access.data == V)
+		{
+			m_compare_replayed++;
+			return;
+		}
+	}
+
+	if (m_compare_error.empty())
+		strprintf(m_compare_error, "interpreter wrote%d %08X=%0*X as access %d, which the native code did not make\n", size * 8, A, size * 2, V, m_compare_replayed);
+}
+
+/*-------------------------------------------------
+    cfunc_compare_end - rerun the instruction,
+    and the delay slot of a taken branch, on the
+    interpreter and stop on any difference
+-------------------------------------------------*/
+
+static void cfunc_compare_end(void *param)
+{
+	((sh34_base_device *)param)->func_compare_end();
+}
+
+void sh34_base_device::func_compare_end()
+{
+	internal_sh4_state native = *m_sh4_state;
+	int native_fpu_sz = m_fpu_sz;
+	int native_fpu_pr = m_fpu_pr;
+
+	/* rerun from the saved state, with the native code's reads */
+	*m_sh4_state = m_compare_state;
+	m_fpu_sz = m_compare_fpu_sz;
+	m_fpu_pr = m_compare_fpu_pr;
+	m_compare_mode = COMPARE_ACCESS_REPLAY;
+	m_compare_replayed = 0;
+	m_compare_error.clear();
+	m_compare_direct_reads = !(m_drcoptions & SH4DRC_STRICT_PCREL) &&
+		((native.compare_op >> 12) == 9 || (native.compare_op >> 12) == 13 || (native.compare_slot >> 12) == 9 || (native.compare_slot >> 12) == 13);
+
+	m_sh4_state->delay = 0;
+	m_sh4_state->pc = native.compare_pc + 2;
+	m_sh4_state->ppc = m_sh4_state->pc;
+	execute_one(native.compare_op);
+	if (m_sh4_state->delay)
+	{
+		m_sh4_state->delay = 0;
+		m_sh4_state->ppc = m_sh4_state->pc;
+		execute_one(native.compare_slot);
+	}
+	m_compare_mode = COMPARE_ACCESS_NONE;
+
+	std::string diffs = m_compare_error;
+	if (diffs.empty() && m_compare_replayed != m_compare_log.size())
+	{
+		const compare_access &access = m_compare_log[m_compare_replayed];
+		strprintf(diffs, "native code %s%d %08X=%0*X as access %d, which the interpreter did not make\n",
+			access.write ? "wrote" : "read", access.size * 8, access.address, access.size * 2, access.data, m_compare_replayed);
+	}
+	if (m_sh4_state->pc != native.compare_nextpc)
+		strcatprintf(diffs, "next pc: %08X (interpreter %08X)\n", native.compare_nextpc, m_sh4_state->pc);
+	for (int regnum = 0; regnum < 16; regnum++)
+	{
+		if (native.r[regnum] != m_sh4_state->r[regnum])
+			strcatprintf(diffs, "r%d: %08X (interpreter %08X)\n", regnum, native.r[regnum], m_sh4_state->r[regnum]);
+		if (native.fr[regnum] != m_sh4_state->fr[regnum])
+			strcatprintf(diffs, "fr%d: %08X (interpreter %08X)\n", regnum, native.fr[regnum], m_sh4_state->fr[regnum]);
+		if (native.xf[regnum] != m_sh4_state->xf[regnum])
+			strcatprintf(diffs, "xf%d: %08X (interpreter %08X)\n", regnum, native.xf[regnum], m_sh4_state->xf[regnum]);
+	}
+	if (memcmp(native.rbnk, m_sh4_state->rbnk, sizeof(native.rbnk)) != 0)
+		strcatprintf(diffs, "banked registers differ\n");
+	if (native.sr != m_sh4_state->sr)
+		strcatprintf(diffs, "sr: %08X (interpreter %08X)\n", native.sr, m_sh4_state->sr);
+	if (native.ssr != m_sh4_state->ssr || native.spc != m_sh4_state->spc || native.sgr != m_sh4_state->sgr || native.dbr != m_sh4_state->dbr)
+		strcatprintf(diffs, "ssr/spc/sgr/dbr: %08X/%08X/%08X/%08X (interpreter %08X/%08X/%08X/%08X)\n",
+			native.ssr, native.spc, native.sgr, native.dbr, m_sh4_state->ssr, m_sh4_state->spc, m_sh4_state->sgr, m_sh4_state->dbr);
+	if (native.pr != m_sh4_state->pr)
+		strcatprintf(diffs, "pr: %08X (interpreter %08X)\n", native.pr, m_sh4_state->pr);
+	if (native.gbr != m_sh4_state->gbr || native.vbr != m_sh4_state->vbr)
+		strcatprintf(diffs, "gbr/vbr: %08X/%08X (interpreter %08X/%08X)\n", native.gbr, native.vbr, m_sh4_state->gbr, m_sh4_state->vbr);
+	if (native.mach != m_sh4_state->mach || native.macl != m_sh4_state->macl)
+		strcatprintf(diffs, "mac: %08X%08X (interpreter %08X%08X)\n", native.mach, native.macl, m_sh4_state->mach, m_sh4_state->macl);
+	if (native.fpul != m_sh4_state->fpul)
+		strcatprintf(diffs, "fpul: %08X (interpreter %08X)\n", native.fpul, m_sh4_state->fpul);
+	if (native.fpscr != m_sh4_state->fpscr || native_fpu_sz != m_fpu_sz || native_fpu_pr != m_fpu_pr)
+		strcatprintf(diffs, "fpscr: %08X sz=%d pr=%d (interpreter %08X sz=%d pr=%d)\n", native.fpscr, native_fpu_sz, native_fpu_pr, m_sh4_state->fpscr, m_fpu_sz, m_fpu_pr);
+
+	if (!diffs.empty())
+	{
+		char buffer[100];
+		DasmSH4(buffer, native.compare_pc, native.compare_op);
+
+		/* report before stopping, since the exception may not unwind through the generated code */
+		osd_printf_error("SH4DRC: %08X: %s differs from the interpreter after %" I64FMT "u matching instructions\n%s",
+			native.compare_pc, buffer, m_compare_count, diffs.c_str());
+		fatalerror("SH4DRC: native code differs from the interpreter at %08X\n", native.compare_pc);
+	}
+
+	/* carry on from the native state, whose timing the interpreter doesn't share */
+	*m_sh4_state = native;
+	m_fpu_sz = native_fpu_sz;
+	m_fpu_pr = native_fpu_pr;
+	m_compare_count++;
+}
+
+
+/***************************************************************************
+    CORE EXECUTION
+***************************************************************************/
+
+/*-------------------------------------------------
+    code_flush_cache - flush the cache and
+    regenerate static code
+-------------------------------------------------*/
+
+void sh34_base_device::code_flush_cache()
+{
+	drcuml_state *drcuml = m_drcuml;
+
+	/* empty the transient cache contents */
+	drcuml->reset();
+
+	try
+	{
+		/* generate the entry point and out-of-cycles handlers */
+		static_generate_nocode_handler();
+		static_generate_out_of_cycles();
+		static_generate_entry_point();
+
+		/* add subroutines for memory accesses */
+		static_generate_memory_accessor(1, FALSE, "read8", &m_read8);
+		static_generate_memory_accessor(1, TRUE,  "write8", &m_write8);
+		static_generate_memory_accessor(2, FALSE, "read16", &m_read16);
+		static_generate_memory_accessor(2, TRUE,  "write16", &m_write16);
+		static_generate_memory_accessor(4, FALSE, "read32", &m_read32);
+		static_generate_memory_accessor(4, TRUE,  "write32", &m_write32);
+	}
+	catch (drcuml_block::abort_compilation &)
+	{
+		fatalerror("Unable to generate SH4 static code\n");
+	}
+
+	m_cache_dirty = FALSE;
+}
+
+/* Execute cycles - returns number of cycles actually run */
+void sh34_base_device::execute_run_drc()
+{
+	drcuml_state *drcuml = m_drcuml;
+	int execute_result;
+
+	/* reset the cache if dirty */
+	if (m_cache_dirty)
+		code_flush_cache();
+
+	/* execute */
+	do
+	{
+		/* run as much as we can */
+		execute_result = drcuml->execute(*m_entry);
+
+		/* if we need to recompile, do it */
+		if (execute_result == EXECUTE_MISSING_CODE)
+		{
+			code_compile_block((m_sh4_state->fpscr >> MODE_SHIFT) & (MODE_PR | MODE_SZ), m_sh4_state->pc);
+		}
+		else if (execute_result == EXECUTE_UNMAPPED_CODE)
+		{
+			fatalerror("Attempted to execute unmapped code at PC=%08X\n", m_sh4_state->pc);
+		}
+		else if (execute_result == EXECUTE_RESET_CACHE)
+		{
+			code_flush_cache();
+		}
+	} while (execute_result != EXECUTE_OUT_OF_CYCLES);
+}
+
+/*-------------------------------------------------
+    code_compile_block - compile a block of the
+    given mode at the specified pc
+-------------------------------------------------*/
+
+void sh34_base_device::code_compile_block(UINT8 mode, offs_t pc)
+{
+	drcuml_state *drcuml = m_drcuml;
+	compiler_state compiler = { 0 };
+	const opcode_desc *seqhead, *seqlast;
+	const opcode_desc *desclist;
+	int override = FALSE;
+	drcuml_block *block;
+
+	g_profiler.start(PROFILER_DRC_COMPILE);
+
+	/* get a description of this sequence */
+	desclist = m_drcfe->describe_code(pc);
+	if (drcuml->logging() || drcuml->logging_native())
+		log_opcode_desc(drcuml, desclist, 0);
+
+	bool succeeded = false;
+	while (!succeeded)
+	{
+		try
+		{
+			/* start the block */
+			block = drcuml->begin_block(4096);
+
+			/* every instruction in the block is generated for this FPSCR mode */
+			compiler.mode = mode;
+			compiler.labelnum = 1;
+
+			/* loop until we get through all instruction sequences */
+			for (seqhead = desclist; seqhead != NULL; seqhead = seqlast->next())
+			{
+				const opcode_desc *curdesc;
+				UINT32 nextpc;
+
+				/* add a code log entry */
+				if (drcuml->logging())
+					block->append_comment("-------------------------");                 // comment
+
+				/* determine the last instruction in this sequence */
+				for (seqlast = seqhead; seqlast != NULL; seqlast = seqlast->next())
+					if (seqlast->flags & OPFLAG_END_SEQUENCE)
+						break;
+				assert(seqlast != NULL);
+
+				/* if we don't have a hash for this mode/pc, or if we are overriding all, add one */
+				if (override || !drcuml->hash_exists(mode, seqhead->pc))
+					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
+
+				/* if we already have a hash, and this is the first sequence, assume that we */
+				/* are recompiling due to being out of sync and allow future overrides */
+				else if (seqhead == desclist)
+				{
+					override = TRUE;
+					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
+				}
+
+				/* otherwise, redispatch to that fixed PC and skip the rest of the processing */
+				else
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+					UML_HASHJMP(block, mode, seqhead->pc, *m_nocode);                       // hashjmp <mode>,seqhead->pc,nocode
+					continue;
+				}
+
+				/* pending interrupts are looked at once per sequence, as the interpreter does after each instruction */
+				compiler.checkints = TRUE;
+				compiler.redispatch = FALSE;
+
+				/* validate this code block if we're not pointing into ROM */
+				if (m_program->get_write_ptr(seqhead->physpc & AM) != NULL)
+					generate_checksum_block(block, &compiler, seqhead, seqlast);
+
+				/* label this instruction, if it may be jumped to locally */
+				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+				}
+
+				/* iterate over instructions in the sequence and compile them */
+				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+				{
+					generate_sequence_instruction(block, &compiler, curdesc, 0xffffffff);
+				}
+
+				/* if we need to return to the start, do it */
+				if (seqlast->flags & OPFLAG_RETURN_TO_START)
+				{
+					nextpc = pc;
+				}
+				/* otherwise we just go to the next instruction */
+				else
+				{
+					nextpc = seqlast->pc + (seqlast->skipslots + 1) * 2;
+				}
+
+				/* count off cycles and go there */
+				generate_update_cycles(block, &compiler, nextpc, TRUE);                // <subtract cycles>
+
+				if (seqlast->next() == NULL || seqlast->next()->pc != nextpc)
+				{
+					generate_hashjmp(block, &compiler, nextpc);                         // hashjmp <mode>,nextpc,nocode
+				}
+			}
+
+			/* end the sequence */
+			block->end();
+			g_profiler.stop();
+			succeeded = true;
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			code_flush_cache();
+		}
+	}
+}
+
+/*-------------------------------------------------
+    static_generate_entry_point - generate a
+    static entry point
+-------------------------------------------------*/
+
+void sh34_base_device::static_generate_entry_point()
+{
+	drcuml_state *drcuml = m_drcuml;
+	code_label skip = 1;
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(200);
+
+	/* forward references */
+	alloc_handle(drcuml, &m_nocode, "nocode");
+	alloc_handle(drcuml, &m_entry, "entry");
+	UML_HANDLE(block, *m_entry);                         // handle  entry
+
+	/* take any exception that became pending while we were out */
+	UML_CMP(block, mem(&m_sh4_state->test_irq), 0);     // cmp     test_irq,0
+	UML_JMPc(block, COND_E, skip);                      // je      skip
+	UML_CALLC(block, cfunc_check_pending_irq, this);    // callc   check_pending_irq
+	UML_LABEL(block, skip);                             // skip:
+
+	/* load fast integer registers */
+	load_fast_iregs(block);
+
+	/* generate a hash jump via the current mode and PC */
+	UML_ROLAND(block, I0, mem(&m_sh4_state->fpscr), 32 - MODE_SHIFT, MODE_PR | MODE_SZ);
+																				// roland  i0,fpscr,32-MODE_SHIFT,3
+	UML_HASHJMP(block, I0, mem(&m_sh4_state->pc), *m_nocode);                // hashjmp i0,<pc>,nocode
+
+	block->end();
+}
+
+/*-------------------------------------------------
+    static_generate_nocode_handler - generate an
+    exception handler for "out of code"
+-------------------------------------------------*/
+
+void sh34_base_device::static_generate_nocode_handler()
+{
+	drcuml_state *drcuml = m_drcuml;
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(10);
+
+	/* generate a hash jump via the current mode and PC */
+	alloc_handle(drcuml, &m_nocode, "nocode");
+	UML_HANDLE(block, *m_nocode);                                    // handle  nocode
+	UML_GETEXP(block, I0);                                  // getexp  i0
+	UML_MOV(block, mem(&m_sh4_state->pc), I0);                              // mov     [pc],i0
+	save_fast_iregs(block);
+	UML_EXIT(block, EXECUTE_MISSING_CODE);                          // exit    EXECUTE_MISSING_CODE
+
+	block->end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_out_of_cycles - generate an
+    out of cycles exception handler
+-------------------------------------------------*/
+
+void sh34_base_device::static_generate_out_of_cycles()
+{
+	drcuml_state *drcuml = m_drcuml;
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(10);
+
+	/* generate a hash jump via the current mode and PC */
+	alloc_handle(drcuml, &m_out_of_cycles, "out_of_cycles");
+	UML_HANDLE(block, *m_out_of_cycles);                             // handle  out_of_cycles
+	UML_GETEXP(block, I0);                                  // getexp  i0
+	UML_MOV(block, mem(&m_sh4_state->pc), I0);                              // mov     <pc>,i0
+	save_fast_iregs(block);
+	UML_EXIT(block, EXECUTE_OUT_OF_CYCLES);                         // exit    EXECUTE_OUT_OF_CYCLES
+
+	block->end();
+}
+
+/*------------------------------------------------------------------
+    static_generate_memory_accessor
+------------------------------------------------------------------*/
+
+void sh34_base_device::static_generate_memory_accessor(int size, int iswrite, const char *name, code_handle **handleptr)
+{
+	/* on entry, address is in I0; data for writes is in I1 */
+	/* on exit, read result is in I0 */
+	/* routine trashes I0 */
+	drcuml_state *drcuml = m_drcuml;
+	drcuml_block *block;
+	int label = 1;
+
+	/* begin generating */
+	block = drcuml->begin_block(1024);
+
+	/* add a global entry for this */
+	alloc_handle(drcuml, handleptr, name);
+	UML_HANDLE(block, **handleptr);                         // handle  *handleptr
+
+	/* when comparing with the interpreter, every access goes through its accessors so it can be logged */
+	if (m_drc_compare)
+	{
+		UML_MOV(block, mem(&m_sh4_state->compare_address), I0);                     // mov     [compare_address],i0
+		if (iswrite)
+			UML_MOV(block, mem(&m_sh4_state->compare_data), I1);                    // mov     [compare_data],i1
+		UML_MOV(block, mem(&m_sh4_state->compare_size), size | (iswrite ? 0x80 : 0)); // mov     [compare_size],size
+		UML_CALLC(block, cfunc_compare_memory, this);                            // callc   cfunc_compare_memory
+		if (!iswrite)
+			UML_MOV(block, I0, mem(&m_sh4_state->compare_data));                    // mov     i0,[compare_data]
+		UML_RET(block);                                                         // ret
+		block->end();
+		return;
+	}
+
+	// the on-chip registers at 0xe0000000 and up are used as is, everything else goes through the area mask
+	UML_CMP(block, I0, 0xe0000000);     // cmp r0, #0xe0000000
+	UML_JMPc(block, COND_AE, label);            // bae label
+
+	UML_AND(block, I0, I0, AM);     // and r0, r0, #AM (0x1fffffff)
+
+	UML_LABEL(block, label++);              // label:
+
+#if SH4_USE_FASTRAM_OPTIMIZATION
+	for (int ramnum = 0; ramnum < m_fastram_select; ramnum++)
+	{
+		if (m_fastram[ramnum].base != NULL && (!iswrite || !m_fastram[ramnum].readonly))
+		{
+			void *fastbase = (UINT8 *)m_fastram[ramnum].base - m_fastram[ramnum].start;
+			UINT32 skip = label++;
+			if (m_fastram[ramnum].end != 0xffffffff)
+			{
+				UML_CMP(block, I0, m_fastram[ramnum].end);   // cmp     i0,end
+				UML_JMPc(block, COND_A, skip);                                      // ja      skip
+			}
+			if (m_fastram[ramnum].start != 0x00000000)
+			{
+				UML_CMP(block, I0, m_fastram[ramnum].start);// cmp     i0,fastram_start
+				UML_JMPc(block, COND_B, skip);                                      // jb      skip
+			}
+
+			if (!iswrite)
+			{
+				if (size == 1)
+				{
+					UML_XOR(block, I0, I0, m_byte_xor);
+					UML_LOAD(block, I0, fastbase, I0, SIZE_BYTE, SCALE_x1);             // load    i0,fastbase,i0,byte
+				}
+				else if (size == 2)
+				{
+					UML_XOR(block, I0, I0, m_word_xor);
+					UML_LOAD(block, I0, fastbase, I0, SIZE_WORD, SCALE_x1);         // load    i0,fastbase,i0,word_x1
+				}
+				else if (size == 4)
+				{
+					UML_XOR(block, I0, I0, m_dword_xor);
+					UML_LOAD(block, I0, fastbase, I0, SIZE_DWORD, SCALE_x1);            // load    i0,fastbase,i0,dword_x1
+				}
+				UML_RET(block);                                                     // ret
+			}
+			else
+			{
+				if (size == 1)
+				{
+					UML_XOR(block, I0, I0, m_byte_xor);
+					UML_STORE(block, fastbase, I0, I1, SIZE_BYTE, SCALE_x1);// store   fastbase,i0,i1,byte
+				}
+				else if (size == 2)
+				{
+					UML_XOR(block, I0, I0, m_word_xor);
+					UML_STORE(block, fastbase, I0, I1, SIZE_WORD, SCALE_x1);// store   fastbase,i0,i1,word_x1
+				}
+				else if (size == 4)
+				{
+					UML_XOR(block, I0, I0, m_dword_xor);
+					UML_STORE(block, fastbase, I0, I1, SIZE_DWORD, SCALE_x1);       // store   fastbase,i0,i1,dword_x1
+				}
+				UML_RET(block);                                                     // ret
+			}
+
+			UML_LABEL(block, skip);                                             // skip:
+		}
+	}
+#endif
+
+	if (iswrite)
+	{
+		switch (size)
+		{
+			case 1:
+				UML_WRITE(block, I0, I1, SIZE_BYTE, SPACE_PROGRAM); // write r0, r1, program_byte
+				break;
+
+			case 2:
+				UML_WRITE(block, I0, I1, SIZE_WORD, SPACE_PROGRAM); // write r0, r1, program_word
+				break;
+
+			case 4:
+				UML_WRITE(block, I0, I1, SIZE_DWORD, SPACE_PROGRAM);    // write r0, r1, program_dword
+				break;
+		}
+	}
+	else
+	{
+		switch (size)
+		{
+			case 1:
+				UML_READ(block, I0, I0, SIZE_BYTE, SPACE_PROGRAM);  // read r0, program_byte
+				break;
+
+			case 2:
+				UML_READ(block, I0, I0, SIZE_WORD, SPACE_PROGRAM);  // read r0, program_word
+				break;
+
+			case 4:
+				UML_READ(block, I0, I0, SIZE_DWORD, SPACE_PROGRAM); // read r0, program_dword
+				break;
+		}
+	}
+
+	UML_RET(block);                         // ret
+
+	block->end();
+}
+
+/*-------------------------------------------------
+    log_desc_flags_to_string - generate a string
+    representing the instruction description
+    flags
+-------------------------------------------------*/
+
+const char *sh34_base_device::log_desc_flags_to_string(UINT32 flags)
+{
+	static char tempbuf[30];
+	char *dest = tempbuf;
+
+	/* branches */
+	if (flags & OPFLAG_IS_UNCONDITIONAL_BRANCH)
+		*dest++ = 'U';
+	else if (flags & OPFLAG_IS_CONDITIONAL_BRANCH)
+		*dest++ = 'C';
+	else
+		*dest++ = '.';
+
+	/* intrablock branches */
+	*dest++ = (flags & OPFLAG_INTRABLOCK_BRANCH) ? 'i' : '.';
+
+	/* branch targets */
+	*dest++ = (flags & OPFLAG_IS_BRANCH_TARGET) ? 'B' : '.';
+
+	/* delay slots */
+	*dest++ = (flags & OPFLAG_IN_DELAY_SLOT) ? 'D' : '.';
+
+	/* exceptions */
+	if (flags & OPFLAG_WILL_CAUSE_EXCEPTION)
+		*dest++ = 'E';
+	else if (flags & OPFLAG_CAN_CAUSE_EXCEPTION)
+		*dest++ = 'e';
+	else
+		*dest++ = '.';
+
+	/* read/write */
+	if (flags & OPFLAG_READS_MEMORY)
+		*dest++ = 'R';
+	else if (flags & OPFLAG_WRITES_MEMORY)
+		*dest++ = 'W';
+	else
+		*dest++ = '.';
+
+	/* mode changes */
+	*dest++ = (flags & OPFLAG_CAN_CHANGE_MODES) ? 'M' : '.';
+
+	/* TLB modification */
+	*dest++ = (flags & OPFLAG_MODIFIES_TRANSLATION) ? 'T' : '.';
+
+	/* redispatch */
+	*dest++ = (flags & OPFLAG_REDISPATCH) ? 'R' : '.';
+	*dest = 0;
+	return tempbuf;
+}
+
+
+/*-------------------------------------------------
+    log_register_list - log a list of GPR registers
+-------------------------------------------------*/
+
+void sh34_base_device::log_register_list(drcuml_state *drcuml, const char *string, const UINT32 *reglist, const UINT32 *regnostarlist)
+{
+	static const char *const sysregs[] = { "pr", "macl", "mach", "gbr", "vbr", "sr", "sgr", "fpul", "fpscr", "dbr", "ssr", "spc" };
+	int count = 0;
+	int regnum;
+
+	/* skip if nothing */
+	if (reglist[0] == 0 && reglist[1] == 0 && reglist[2] == 0)
+		return;
+
+	drcuml->log_printf("[%s:", string);
+
+	for (regnum = 0; regnum < 16; regnum++)
+	{
+		if (reglist[0] & REGFLAG_R(regnum))
+		{
+			drcuml->log_printf("%sr%d", (count++ == 0) ? "" : ",", regnum);
+			if (regnostarlist != NULL && !(regnostarlist[0] & REGFLAG_R(regnum)))
+				drcuml->log_printf("*");
+		}
+	}
+
+	for (regnum = 0; regnum < ARRAY_LENGTH(sysregs); regnum++)
+	{
+		if (reglist[1] & (1 << regnum))
+		{
+			drcuml->log_printf("%s%s", (count++ == 0) ? "" : ",", sysregs[regnum]);
+			if (regnostarlist != NULL && !(regnostarlist[1] & (1 << regnum)))
+				drcuml->log_printf("*");
+		}
+	}
+
+	for (regnum = 0; regnum < 16; regnum++)
+	{
+		if (reglist[2] & REGFLAG_FR(regnum))
+		{
+			drcuml->log_printf("%sfr%d", (count++ == 0) ? "" : ",", regnum);
+			if (regnostarlist != NULL && !(regnostarlist[2] & REGFLAG_FR(regnum)))
+				drcuml->log_printf("*");
+		}
+	}
+
+	drcuml->log_printf("] ");
+}
+
+/*-------------------------------------------------
+    log_opcode_desc - log a list of descriptions
+-------------------------------------------------*/
+
+void sh34_base_device::log_opcode_desc(drcuml_state *drcuml, const opcode_desc *desclist, int indent)
+{
+	/* open the file, creating it if necessary */
+	if (indent == 0)
+		drcuml->log_printf("\nDescriptor list @ %08X\n", desclist->pc);
+
+	/* output each descriptor */
+	for ( ; desclist != NULL; desclist = desclist->next())
+	{
+		char buffer[100];
+
+		/* disassemle the current instruction and output it to the log */
+		if (drcuml->logging() || drcuml->logging_native())
+		{
+			if (desclist->flags & OPFLAG_VIRTUAL_NOOP)
+				strcpy(buffer, "<virtual nop>");
+			else
+				DasmSH4(buffer, desclist->pc, desclist->opptr.w[0]);
+		}
+		else
+			strcpy(buffer, "???");
+		drcuml->log_printf("%08X [%08X] t:%08X f:%s: %-30s", desclist->pc, desclist->physpc, desclist->targetpc, log_desc_flags_to_string(desclist->flags), buffer);
+
+		/* output register states */
+		log_register_list(drcuml, "use", desclist->regin, NULL);
+		log_register_list(drcuml, "mod", desclist->regout, desclist->regreq);
+		drcuml->log_printf("\n");
+
+		/* if we have a delay slot, output it recursively */
+		if (desclist->delay.first() != NULL)
+			log_opcode_desc(drcuml, desclist->delay.first(), indent + 1);
+
+		/* at the end of a sequence add a dividing line */
+		if (desclist->flags & OPFLAG_END_SEQUENCE)
+			drcuml->log_printf("-----\n");
+	}
+}
+
+/*-------------------------------------------------
+    log_add_disasm_comment - add a comment
+    including disassembly of an SH4 instruction
+-------------------------------------------------*/
+
+void sh34_base_device::log_add_disasm_comment(drcuml_block *block, UINT32 pc, UINT32 op)
+{
+	if (m_drcuml->logging())
+	{
+		char buffer[100];
+		DasmSH4(buffer, pc, op);
+		block->append_comment("%08X: %s", pc, buffer);                  // comment
+	}
+}
+
+/*-------------------------------------------------
+    generate_update_cycles - generate code to
+    subtract cycles from the icount and generate
+    an exception if out
+-------------------------------------------------*/
+
+void sh34_base_device::generate_update_cycles(drcuml_block *block, compiler_state *compiler, uml::parameter param, int allow_exception)
+{
+	/* the instruction being compared is complete once it gets here */
+	if (compiler->compare)
+		generate_compare_end(block, compiler, param);
+
+	/* check full interrupts if pending */
+	if (compiler->checkints)
+	{
+		code_label skip = compiler->labelnum++;
+
+		compiler->checkints = FALSE;
+
+		/* test_irq is only set when an exception can be accepted, so this is cheap when there is none */
+		UML_CMP(block, mem(&m_sh4_state->test_irq), 0);                     // cmp     test_irq,0
+		UML_JMPc(block, COND_E, skip);                                      // je      skip
+
+		UML_MOV(block, mem(&m_sh4_state->pc), param);                           // mov     pc,nextpc
+		if (compiler->cycles > 0)
+			UML_SUB(block, mem(&m_sh4_state->icount), mem(&m_sh4_state->icount), MAPVAR_CYCLES);  // sub     icount,icount,cycles
+		save_fast_iregs(block);
+		UML_CALLC(block, cfunc_check_pending_irq, this);                     // callc   check_pending_irq
+		load_fast_iregs(block);
+		UML_ROLAND(block, I0, mem(&m_sh4_state->fpscr), 32 - MODE_SHIFT, MODE_PR | MODE_SZ);
+																					// roland  i0,fpscr,32-MODE_SHIFT,3
+		UML_HASHJMP(block, I0, mem(&m_sh4_state->pc), *m_nocode);            // hashjmp i0,pc,nocode
+
+		UML_LABEL(block, skip);                                             // skip:
+	}
+
+	/* account for cycles */
+	if (compiler->cycles > 0)
+	{
+		UML_SUB(block, mem(&m_sh4_state->icount), mem(&m_sh4_state->icount), MAPVAR_CYCLES);    // sub     icount,icount,cycles
+		UML_MAPVAR(block, MAPVAR_CYCLES, 0);                                        // mapvar  cycles,0
+		if (allow_exception)
+			UML_EXHc(block, COND_S, *m_out_of_cycles, param);
+																					// exh     out_of_cycles,nextpc
+	}
+	compiler->cycles = 0;
+}
+
+/*-------------------------------------------------
+    generate_hashjmp - jump to the given PC in
+    the block's mode, or in the live mode if an
+    instruction may have changed FPSCR
+-------------------------------------------------*/
+
+void sh34_base_device::generate_hashjmp(drcuml_block *block, compiler_state *compiler, uml::parameter param)
+{
+	if (compiler->redispatch)
+	{
+		UML_ROLAND(block, I0, mem(&m_sh4_state->fpscr), 32 - MODE_SHIFT, MODE_PR | MODE_SZ);
+																					// roland  i0,fpscr,32-MODE_SHIFT,3
+		UML_HASHJMP(block, I0, param, *m_nocode);                            // hashjmp i0,param,nocode
+	}
+	else
+		UML_HASHJMP(block, compiler->mode, param, *m_nocode);                // hashjmp <mode>,param,nocode
+}
+
+/*-------------------------------------------------
+    generate_checksum_block - generate code to
+    validate a sequence of opcodes
+-------------------------------------------------*/
+
+void sh34_base_device::generate_checksum_block(drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast)
+{
+	const opcode_desc *curdesc;
+	if (m_drcuml->logging())
+		block->append_comment("[Validation for %08X]", seqhead->pc);                // comment
+
+	/* loose verify or single instruction: just compare and fail */
+	if (!(m_drcoptions & SH4DRC_STRICT_VERIFY) || seqhead->next() == NULL)
+	{
+		if (!(seqhead->flags & OPFLAG_VIRTUAL_NOOP))
+		{
+			void *base = m_direct->read_ptr(seqhead->physpc & AM, m_code_xor);
+			UML_LOAD(block, I0, base, 0, SIZE_WORD, SCALE_x2);                          // load    i0,base,word
+			UML_CMP(block, I0, seqhead->opptr.w[0]);                        // cmp     i0,*opptr
+			UML_EXHc(block, COND_NE, *m_nocode, epc(seqhead));       // exne    nocode,seqhead->pc
+		}
+	}
+
+	/* full verification; sum up everything */
+	else
+	{
+		UINT32 sum = 0;
+		void *base = m_direct->read_ptr(seqhead->physpc & AM, m_code_xor);
+		UML_LOAD(block, I0, base, 0, SIZE_WORD, SCALE_x2);                              // load    i0,base,word
+		sum += seqhead->opptr.w[0];
+		for (curdesc = seqhead->next(); curdesc != seqlast->next(); curdesc = curdesc->next())
+			if (!(curdesc->flags & OPFLAG_VIRTUAL_NOOP))
+			{
+				base = m_direct->read_ptr(curdesc->physpc & AM, m_code_xor);
+				UML_LOAD(block, I1, base, 0, SIZE_WORD, SCALE_x2);                      // load    i1,*opptr,word
+				UML_ADD(block, I0, I0, I1);                         // add     i0,i0,i1
+				sum += curdesc->opptr.w[0];
+			}
+		UML_CMP(block, I0, sum);                                            // cmp     i0,sum
+		UML_EXHc(block, COND_NE, *m_nocode, epc(seqhead));           // exne    nocode,seqhead->pc
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_sequence_instruction - generate code
+    for a single instruction in a sequence
+-------------------------------------------------*/
+
+void sh34_base_device::generate_sequence_instruction(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 ovrpc)
+{
+	offs_t expc;
+
+	/* add an entry for the log */
+	if (m_drcuml->logging() && !(desc->flags & OPFLAG_VIRTUAL_NOOP))
+		log_add_disasm_comment(block, desc->pc, desc->opptr.w[0]);
+
+	/* set the PC map variable */
+	expc = (desc->flags & OPFLAG_IN_DELAY_SLOT) ? desc->pc - 1 : desc->pc;
+	UML_MAPVAR(block, MAPVAR_PC, expc);                                             // mapvar  PC,expc
+
+	/* accumulate total cycles */
+	compiler->cycles += desc->cycles;
+
+	/* update the icount map variable */
+	UML_MAPVAR(block, MAPVAR_CYCLES, compiler->cycles);                             // mapvar  CYCLES,compiler->cycles
+
+	/* if we want a probe, add it here */
+	if (desc->pc == PROBE_ADDRESS)
+	{
+		UML_MOV(block, mem(&m_sh4_state->pc), desc->pc);                                // mov     [pc],desc->pc
+		UML_CALLC(block, cfunc_printf_probe, this);                                  // callc   cfunc_printf_probe,sh4
+	}
+
+	/* if we are debugging, call the debugger */
+	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
+	{
+		UML_MOV(block, mem(&m_sh4_state->pc), desc->pc);                                // mov     [pc],desc->pc
+		save_fast_iregs(block);
+		UML_DEBUG(block, desc->pc);                                         // debug   desc->pc
+	}
+	else    // not debug, see what other reasons there are for flushing the PC
+	{
+		if (m_drcoptions & SH4DRC_FLUSH_PC)  // always flush?
+		{
+			UML_MOV(block, mem(&m_sh4_state->pc), desc->pc);        // mov m_sh4_state->pc, desc->pc
+		}
+		else    // check for driver-selected flushes
+		{
+			int pcflush;
+
+			for (pcflush = 0; pcflush < m_pcfsel; pcflush++)
+			{
+				if (desc->pc == m_pcflushes[pcflush])
+				{
+					UML_MOV(block, mem(&m_sh4_state->pc), desc->pc);        // mov m_sh4_state->pc, desc->pc
+				}
+			}
+		}
+	}
+
+
+	/* if we hit an unmapped address, fatal error */
+	if (desc->flags & OPFLAG_COMPILER_UNMAPPED)
+	{
+		UML_MOV(block, mem(&m_sh4_state->pc), desc->pc);                                // mov     [pc],desc->pc
+		save_fast_iregs(block);
+		UML_EXIT(block, EXECUTE_UNMAPPED_CODE);                             // exit    EXECUTE_UNMAPPED_CODE
+	}
+
+	/* if this is an invalid opcode, die */
+	if (desc->flags & OPFLAG_INVALID_OPCODE)
+	{
+		fatalerror("SH4DRC: invalid opcode!\n");
+	}
+
+	/* otherwise, unless this is a virtual no-op, it's a regular instruction */
+	else if (!(desc->flags & OPFLAG_VIRTUAL_NOOP))
+	{
+		/* with -drc_compare, each instruction, or branch and delay slot, is checked as a unit */
+		if (m_drc_compare && !(desc->flags & OPFLAG_IN_DELAY_SLOT))
+		{
+			save_fast_iregs(block);
+			UML_MOV(block, mem(&m_sh4_state->compare_pc), desc->pc);                // mov     [compare_pc],desc->pc
+			UML_MOV(block, mem(&m_sh4_state->compare_op), desc->opptr.w[0]);        // mov     [compare_op],opcode
+			UML_MOV(block, mem(&m_sh4_state->compare_slot), (desc->delay.first() != NULL) ? desc->delay.first()->opptr.w[0] : 0x0009);
+																					// mov     [compare_slot],slot opcode
+			UML_CALLC(block, cfunc_compare_begin, this);                             // callc   cfunc_compare_begin
+
+			compiler->compare = TRUE;
+			if (generate_opcode(block, compiler, desc, ovrpc))
+			{
+				/* anything that didn't leave through generate_update_cycles falls through to the next instruction */
+				if (compiler->compare)
+					generate_compare_end(block, compiler, desc->pc + 2);
+			}
+			else
+			{
+				compiler->compare = FALSE;
+				UML_CALLC(block, cfunc_compare_cancel, this);                        // callc   cfunc_compare_cancel
+				generate_interpreter_call(block, compiler, desc, ovrpc);
+			}
+		}
+
+		/* compile the instruction, falling back to the interpreter for anything not handled natively */
+		else if (!generate_opcode(block, compiler, desc, ovrpc))
+			generate_interpreter_call(block, compiler, desc, ovrpc);
+	}
+}
+
+/*------------------------------------------------------------------
+    generate_compare_end - check the instruction
+    being compared, given where the native code
+    goes next
+------------------------------------------------------------------*/
+
+void sh34_base_device::generate_compare_end(drcuml_block *block, compiler_state *compiler, uml::parameter param)
+{
+	compiler->compare = FALSE;
+	save_fast_iregs(block);
+	UML_MOV(block, mem(&m_sh4_state->compare_nextpc), param);                       // mov     [compare_nextpc],param
+	UML_CALLC(block, cfunc_compare_end, this);                                       // callc   cfunc_compare_end
+	load_fast_iregs(block);
+}
+
+/*------------------------------------------------------------------
+    generate_delay_slot
+------------------------------------------------------------------*/
+
+void sh34_base_device::generate_delay_slot(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 ovrpc)
+{
+	compiler_state compiler_temp = *compiler;
+
+	/* compile the delay slot using temporary compiler state */
+	assert(desc->delay.first() != NULL);
+	generate_sequence_instruction(block, &compiler_temp, desc->delay.first(), ovrpc);              // <next instruction>
+
+	/* update the label, and remember anything the slot needs from the branch */
+	compiler->labelnum = compiler_temp.labelnum;
+	compiler->checkints |= compiler_temp.checkints;
+	compiler->redispatch |= compiler_temp.redispatch;
+}
+
+/*------------------------------------------------------------------
+    generate_interpreter_call - run one
+    instruction through the interpreter
+------------------------------------------------------------------*/
+
+void sh34_base_device::generate_interpreter_call(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 ovrpc)
+{
+	int in_delay_slot = ((desc->flags & OPFLAG_IN_DELAY_SLOT) != 0);
+
+	/* the interpreter expects PC to point past the instruction, or at the branch target in a delay slot */
+	save_fast_iregs(block);
+	if (!in_delay_slot)
+		UML_MOV(block, mem(&m_sh4_state->pc), desc->pc + 2);                        // mov     [pc],desc->pc+2
+	else if (ovrpc != 0xffffffff)
+		UML_MOV(block, mem(&m_sh4_state->pc), ovrpc + 2);                           // mov     [pc],ovrpc+2
+	else
+		UML_MOV(block, mem(&m_sh4_state->pc), mem(&m_sh4_state->target));             // mov     [pc],[target]
+	UML_MOV(block, mem(&m_sh4_state->ppc), mem(&m_sh4_state->pc));                    // mov     [ppc],[pc]
+	UML_MOV(block, mem(&m_sh4_state->arg0), desc->opptr.w[0]);                      // mov     [arg0],opcode
+	UML_CALLC(block, cfunc_execute_one, this);                                       // callc   cfunc_execute_one
+	load_fast_iregs(block);
+
+	/* the interpreter takes its own extra cycles off */
+	compiler->cycles -= desc->cycles - 1;
+	UML_MAPVAR(block, MAPVAR_CYCLES, compiler->cycles);                             // mapvar  CYCLES,compiler->cycles
+
+	/* anything that can move the PC, change FPSCR or unmask an interrupt must leave through the live state */
+	if ((desc->flags & (OPFLAG_CAN_CHANGE_MODES | OPFLAG_WILL_CAUSE_EXCEPTION | OPFLAG_CAN_EXPOSE_EXTERNAL_INT)) &&
+		!(desc->flags & (OPFLAG_IS_CONDITIONAL_BRANCH | OPFLAG_IS_UNCONDITIONAL_BRANCH)))
+	{
+		compiler->checkints = TRUE;
+		compiler->redispatch = TRUE;
+		if (!in_delay_slot)
+		{
+			generate_update_cycles(block, compiler, mem(&m_sh4_state->pc), TRUE);  // <subtract cycles>
+			generate_hashjmp(block, compiler, mem(&m_sh4_state->pc));              // hashjmp <mode>,[pc],nocode
+		}
+	}
+}
+
+/*-------------------------------------------------
+    generate_opcode - generate code for a specific
+    opcode
+-------------------------------------------------*/
+
+int sh34_base_device::generate_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 ovrpc)
+{
+	UINT32 scratch, scratch2;
+	INT32 disp;
+	UINT16 opcode = desc->opptr.w[0];
+	UINT8 opswitch = opcode >> 12;
+	int in_delay_slot = ((desc->flags & OPFLAG_IN_DELAY_SLOT) != 0);
+
+	/* PC-relative loads in a delay slot need the branch target at compile time */
+	UINT32 pcrel = in_delay_slot ? ovrpc + 2 : desc->pc + 2;
+
+	switch (opswitch)
+	{
+		case  0:
+			return generate_group_0(block, compiler, desc, opcode, in_delay_slot, ovrpc);
+
+		case  1:    // MOVLS4
+			scratch = (opcode & 0x0f) * 4;
+			UML_ADD(block, I0, R32(Rn), scratch);   // add r0, Rn, scratch
+			UML_MOV(block, I1, R32(Rm));        // mov r1, Rm
+			SETEA(0);                       // set ea for debug
+			UML_CALLH(block, *m_write32);
+
+			if (!in_delay_slot)
+				generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+			return TRUE;
+
+		case  2:
+			return generate_group_2(block, compiler, desc, opcode, in_delay_slot, ovrpc);
+		case  3:
+			return generate_group_3(block, compiler, desc, opcode, ovrpc);
+		case  4:
+			return generate_group_4(block, compiler, desc, opcode, in_delay_slot, ovrpc);
+
+		case  5:    // MOVLL4
+			scratch = (opcode & 0x0f) * 4;
+			UML_ADD(block, I0, R32(Rm), scratch);       // add r0, Rm, scratch
+			SETEA(0);                       // set ea for debug
+			UML_CALLH(block, *m_read32);             // call read32
+			UML_MOV(block, R32(Rn), I0);            // mov Rn, r0
+
+			if (!in_delay_slot)
+				generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+			return TRUE;
+
+		case  6:
+			return generate_group_6(block, compiler, desc, opcode, in_delay_slot, ovrpc);
+
+		case  7:    // ADDI
+			scratch = opcode & 0xff;
+			scratch2 = (UINT32)(INT32)(INT16)(INT8)scratch;
+			UML_ADD(block, R32(Rn), R32(Rn), scratch2); // add Rn, Rn, scratch2
+			return TRUE;
+
+		case  8:
+			return generate_group_8(block, compiler, desc, opcode, in_delay_slot, ovrpc);
+
+		case  9:    // MOVWI
+			if (in_delay_slot && ovrpc == 0xffffffff)
+				return FALSE;
+			scratch = pcrel + ((opcode & 0xff) * 2) + 2;
+
+			if (m_drcoptions & SH4DRC_STRICT_PCREL)
+			{
+				UML_MOV(block, I0, scratch);            // mov r0, scratch
+				SETEA(0);                       // set ea for debug
+				UML_CALLH(block, *m_read16);             // read16(r0, r1)
+				UML_SEXT(block, R32(Rn), I0, SIZE_WORD);            // sext Rn, r0, WORD
+			}
+			else
+			{
+				scratch2 = (UINT32)(INT32)(INT16) RW(scratch);
+				UML_MOV(block, R32(Rn), scratch2);          // mov Rn, scratch2
+			}
+
+			if (!in_delay_slot)
+				generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+			return TRUE;
+
+		case 10:    // BRA
+			disp = ((INT32)opcode << 20) >> 20;
+			scratch = (desc->pc + 2) + disp * 2 + 2;            // pc+4 + disp*2
+
+			generate_delay_slot(block, compiler, desc, scratch - 2);
+
+			generate_update_cycles(block, compiler, scratch, TRUE);    // <subtract cycles>
+			generate_hashjmp(block, compiler, scratch);              // hashjmp <mode>,scratch
+			return TRUE;
+
+		case 11:    // BSR
+			// the delay slot may clobber PR, so set it first
+			UML_MOV(block, mem(&m_sh4_state->pr), desc->pc + 4); // mov m_pr, desc->pc + 4 (skip the current insn & delay slot)
+
+			disp = ((INT32)opcode << 20) >> 20;
+			scratch = (desc->pc + 2) + disp * 2 + 2;            // pc+4 + disp*2
+
+			generate_delay_slot(block, compiler, desc, scratch - 2);
+
+			generate_update_cycles(block, compiler, scratch, TRUE);    // <subtract cycles>
+			generate_hashjmp(block, compiler, scratch);              // hashjmp <mode>,scratch
+			return TRUE;
+
+		case 12:
+			return generate_group_12(block, compiler, desc, opcode, in_delay_slot, ovrpc);
+
+		case 13:    // MOVLI
+			if (in_delay_slot && ovrpc == 0xffffffff)
+				return FALSE;
+			scratch = ((pcrel + 2) & ~3) + ((opcode & 0xff) * 4);
+
+			if (m_drcoptions & SH4DRC_STRICT_PCREL)
+			{
+				UML_MOV(block, I0, scratch);            // mov r0, scratch
+				UML_CALLH(block, *m_read32);             // read32(r0, r1)
+				UML_MOV(block, R32(Rn), I0);            // mov Rn, r0
+			}
+			else
+			{
+				scratch2 = RL(scratch);
+				UML_MOV(block, R32(Rn), scratch2);          // mov Rn, scratch2
+			}
+
+			if (!in_delay_slot)
+				generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+			return TRUE;
+
+		case 14:    // MOVI
+			scratch = opcode & 0xff;
+			scratch2 = (UINT32)(INT32)(INT16)(INT8)scratch;
+			UML_MOV(block, R32(Rn), scratch2);
+			return TRUE;
+
+		case 15:
+			return generate_group_15(block, compiler, desc, opcode, in_delay_slot, ovrpc);
+	}
+
+	return FALSE;
+}
+
+int sh34_base_device::generate_group_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc)
+{
+	switch (opcode & 0xff)
+	{
+	case 0x09: // NOP();
+		return TRUE;
+
+	case 0x02: // STCSR(Rn);
+		UML_MOV(block, R32(Rn), mem(&m_sh4_state->sr));
+		return TRUE;
+
+	case 0x12: // STCGBR(Rn);
+		UML_MOV(block, R32(Rn), mem(&m_sh4_state->gbr));        // mov Rn, gbr
+		return TRUE;
+
+	case 0x22: // STCVBR(Rn);
+		UML_MOV(block, R32(Rn), mem(&m_sh4_state->vbr));        // mov Rn, vbr
+		return TRUE;
+
+	case 0x32: // STCSSR(Rn);
+		UML_MOV(block, R32(Rn), mem(&m_sh4_state->ssr));        // mov Rn, ssr
+		return TRUE;
+
+	case 0x42: // STCSPC(Rn);
+		UML_MOV(block, R32(Rn), mem(&m_sh4_state->spc));        // mov Rn, spc
+		return TRUE;
+
+	case 0x03: // BSRF(Rn);
+		UML_ADD(block, mem(&m_sh4_state->target), R32(Rn), desc->pc + 4);  // add target, Rn, pc+4
+
+		// the delay slot may clobber PR, so set it first
+		UML_MOV(block, mem(&m_sh4_state->pr), desc->pc + 4); // mov m_pr, desc->pc + 4 (skip the current insn & delay slot)
+
+		generate_delay_slot(block, compiler, desc, 0xffffffff);
+
+		generate_update_cycles(block, compiler, mem(&m_sh4_state->target), TRUE);  // <subtract cycles>
+		generate_hashjmp(block, compiler, mem(&m_sh4_state->target));              // jmp target
+		return TRUE;
+
+	case 0x23: // BRAF(Rn);
+		UML_ADD(block, mem(&m_sh4_state->target), R32(Rn), desc->pc + 4); // add target, Rn, pc+4
+
+		generate_delay_slot(block, compiler, desc, 0xffffffff);
+
+		generate_update_cycles(block, compiler, mem(&m_sh4_state->target), TRUE);  // <subtract cycles>
+		generate_hashjmp(block, compiler, mem(&m_sh4_state->target));              // jmp target
+		return TRUE;
+
+	case 0xc3: // MOVCAL(Rn);
+		UML_MOV(block, I0, R32(Rn));            // mov r0, Rn
+		UML_MOV(block, I1, R32(0));             // mov r1, R0
+		UML_CALLH(block, *m_write32);                // call write32
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x04: case 0x14: case 0x24: case 0x34:
+	case 0x44: case 0x54: case 0x64: case 0x74:
+	case 0x84: case 0x94: case 0xa4: case 0xb4:
+	case 0xc4: case 0xd4: case 0xe4: case 0xf4: // MOVBS0(Rm, Rn);
+		UML_ADD(block, I0, R32(0), R32(Rn));        // add r0, R0, Rn
+		UML_AND(block, I1, R32(Rm), 0x000000ff);    // and r1, Rm, 0xff
+		UML_CALLH(block, *m_write8);             // call write8
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x05: case 0x15: case 0x25: case 0x35:
+	case 0x45: case 0x55: case 0x65: case 0x75:
+	case 0x85: case 0x95: case 0xa5: case 0xb5:
+	case 0xc5: case 0xd5: case 0xe5: case 0xf5: // MOVWS0(Rm, Rn);
+		UML_ADD(block, I0, R32(0), R32(Rn));        // add r0, R0, Rn
+		UML_AND(block, I1, R32(Rm), 0x0000ffff);    // and r1, Rm, 0xffff
+		UML_CALLH(block, *m_write16);                // call write16
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x06: case 0x16: case 0x26: case 0x36:
+	case 0x46: case 0x56: case 0x66: case 0x76:
+	case 0x86: case 0x96: case 0xa6: case 0xb6:
+	case 0xc6: case 0xd6: case 0xe6: case 0xf6: // MOVLS0(Rm, Rn);
+		UML_ADD(block, I0, R32(0), R32(Rn));        // add r0, R0, Rn
+		UML_MOV(block, I1, R32(Rm));            // mov r1, Rm
+		UML_CALLH(block, *m_write32);                // call write32
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x07: case 0x17: case 0x27: case 0x37:
+	case 0x47: case 0x57: case 0x67: case 0x77:
+	case 0x87: case 0x97: case 0xa7: case 0xb7:
+	case 0xc7: case 0xd7: case 0xe7: case 0xf7: // MULL(Rm, Rn);
+		UML_MULU(block, mem(&m_sh4_state->macl), mem(&m_sh4_state->ea), R32(Rn), R32(Rm));  // mulu macl, ea, Rn, Rm
+		return TRUE;
+
+	case 0x08: case 0x88: // CLRT();
+		UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~T);   // and sr, sr, ~T (clear the T bit)
+		return TRUE;
+
+	case 0x18: case 0x98: // SETT();
+		UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), T); // or sr, sr, T
+		return TRUE;
+
+	case 0x48: case 0xc8: // CLRS();
+		UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~S);   // and sr, sr, ~S (clear the S bit)
+		return TRUE;
+
+	case 0x58: case 0xd8: // SETS();
+		UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), S); // or sr, sr, S
+		return TRUE;
+
+	case 0x19: case 0x59: case 0x99: case 0xd9: // DIV0U();
+		UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~(M|Q|T)); // and sr, sr, ~(M|Q|T)
+		return TRUE;
+
+	case 0x28: case 0xa8: // CLRMAC();
+		UML_MOV(block, mem(&m_sh4_state->macl), 0);     // mov macl, #0
+		UML_MOV(block, mem(&m_sh4_state->mach), 0);     // mov mach, #0
+		return TRUE;
+
+	case 0x29: case 0x69: case 0xa9: case 0xe9: // MOVT(Rn);
+		UML_AND(block, R32(Rn), mem(&m_sh4_state->sr), T);      // and Rn, sr, T
+		return TRUE;
+
+	case 0x0a: case 0x8a: // STSMACH(Rn);
+		UML_MOV(block, R32(Rn), mem(&m_sh4_state->mach));       // mov Rn, mach
+		return TRUE;
+
+	case 0x1a: case 0x9a: // STSMACL(Rn);
+		UML_MOV(block, R32(Rn), mem(&m_sh4_state->macl));       // mov Rn, macl
+		return TRUE;
+
+	case 0x2a: case 0xaa: // STSPR(Rn);
+		UML_MOV(block, R32(Rn), mem(&m_sh4_state->pr));         // mov Rn, pr
+		return TRUE;
+
+	case 0x3a: case 0xba: // STCSGR(Rn);
+		UML_MOV(block, R32(Rn), mem(&m_sh4_state->sgr));        // mov Rn, sgr
+		return TRUE;
+
+	case 0x5a: case 0xda: // STSFPUL(Rn);
+		UML_MOV(block, R32(Rn), mem(&m_sh4_state->fpul));       // mov Rn, fpul
+		return TRUE;
+
+	case 0x6a: case 0xea: // STSFPSCR(Rn);
+		UML_AND(block, R32(Rn), mem(&m_sh4_state->fpscr), 0x003fffff);  // and Rn, fpscr, 0x003fffff
+		return TRUE;
+
+	case 0x7a: case 0xfa: // STCDBR(Rn);
+		UML_MOV(block, R32(Rn), mem(&m_sh4_state->dbr));        // mov Rn, dbr
+		return TRUE;
+
+	case 0x0b: case 0x4b: case 0x8b: case 0xcb: // RTS();
+		UML_MOV(block, mem(&m_sh4_state->target), mem(&m_sh4_state->pr));   // mov target, pr (in case of d-slot shenanigans)
+
+		generate_delay_slot(block, compiler, desc, 0xffffffff);
+
+		generate_update_cycles(block, compiler, mem(&m_sh4_state->target), TRUE);  // <subtract cycles>
+		generate_hashjmp(block, compiler, mem(&m_sh4_state->target));
+		return TRUE;
+
+	case 0x2b: case 0x6b: case 0xab: case 0xeb: // RTE();
+		// the register bank switch and exception bookkeeping are left to the interpreter
+		generate_interpreter_call(block, compiler, desc, ovrpc);
+		UML_MOV(block, mem(&m_sh4_state->target), mem(&m_sh4_state->pc));   // mov target, pc (spc)
+		UML_MOV(block, mem(&m_sh4_state->delay), 0);                        // mov delay, #0 (the slot runs here)
+
+		generate_delay_slot(block, compiler, desc, 0xffffffff);
+
+		compiler->checkints = TRUE;
+		generate_update_cycles(block, compiler, mem(&m_sh4_state->target), TRUE);  // <subtract cycles>
+		generate_hashjmp(block, compiler, mem(&m_sh4_state->target));              // and jump to the "resume PC"
+		return TRUE;
+
+	case 0x0c: case 0x1c: case 0x2c: case 0x3c:
+	case 0x4c: case 0x5c: case 0x6c: case 0x7c:
+	case 0x8c: case 0x9c: case 0xac: case 0xbc:
+	case 0xcc: case 0xdc: case 0xec: case 0xfc: // MOVBL0(Rm, Rn);
+		UML_ADD(block, I0, R32(0), R32(Rm));        // add r0, R0, Rm
+		UML_CALLH(block, *m_read8);              // call read8
+		UML_SEXT(block, R32(Rn), I0, SIZE_BYTE);        // sext Rn, r0, BYTE
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x0d: case 0x1d: case 0x2d: case 0x3d:
+	case 0x4d: case 0x5d: case 0x6d: case 0x7d:
+	case 0x8d: case 0x9d: case 0xad: case 0xbd:
+	case 0xcd: case 0xdd: case 0xed: case 0xfd: // MOVWL0(Rm, Rn);
+		UML_ADD(block, I0, R32(0), R32(Rm));        // add r0, R0, Rm
+		UML_CALLH(block, *m_read16);             // call read16
+		UML_SEXT(block, R32(Rn), I0, SIZE_WORD);        // sext Rn, r0, WORD
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x0e: case 0x1e: case 0x2e: case 0x3e:
+	case 0x4e: case 0x5e: case 0x6e: case 0x7e:
+	case 0x8e: case 0x9e: case 0xae: case 0xbe:
+	case 0xce: case 0xde: case 0xee: case 0xfe: // MOVLL0(Rm, Rn);
+		UML_ADD(block, I0, R32(0), R32(Rm));        // add r0, R0, Rm
+		UML_CALLH(block, *m_read32);             // call read32
+		UML_MOV(block, R32(Rn), I0);            // mov Rn, r0
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+	}
+
+	// STCRBANK, PREFM, SLEEP, MAC_L and the NOP encodings go to the interpreter
+	return FALSE;
+}
+
+int sh34_base_device::generate_group_2(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc)
+{
+	switch (opcode & 15)
+	{
+	case  0: // MOVBS(Rm, Rn);
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_AND(block, I1, R32(Rm), 0xff);  // and r1, Rm, 0xff
+		UML_CALLH(block, *m_write8);
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  1: // MOVWS(Rm, Rn);
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_AND(block, I1, R32(Rm), 0xffff);    // and r1, Rm, 0xffff
+		UML_CALLH(block, *m_write16);
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  2: // MOVLS(Rm, Rn);
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_MOV(block, I1, R32(Rm));        // mov r1, Rm
+		UML_CALLH(block, *m_write32);
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  3:
+		return FALSE;
+
+	case  4: // MOVBM(Rm, Rn);
+		UML_AND(block, I1, R32(Rm), 0xff);  // and r1, Rm, 0xff
+		UML_SUB(block, R32(Rn), R32(Rn), 1);    // sub Rn, Rn, 1
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_CALLH(block, *m_write8);         // call write8
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  5: // MOVWM(Rm, Rn);
+		UML_AND(block, I1, R32(Rm), 0xffff);    // and r1, Rm, 0xffff
+		UML_SUB(block, R32(Rn), R32(Rn), 2);    // sub Rn, Rn, 2
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_CALLH(block, *m_write16);            // call write16
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  6: // MOVLM(Rm, Rn);
+		UML_MOV(block, I1, R32(Rm));        // mov r1, Rm
+		UML_SUB(block, R32(Rn), R32(Rn), 4);    // sub Rn, Rn, 4
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_CALLH(block, *m_write32);            // call write32
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 13: // XTRCT(Rm, Rn);
+		UML_SHL(block, I0, R32(Rm), 16);        // shl r0, Rm, #16
+		UML_AND(block, I0, I0, 0xffff0000); // and r0, r0, #0xffff0000
+
+		UML_SHR(block, I1, R32(Rn), 16);        // shr, r1, Rn, #16
+		UML_AND(block, I1, I1, 0xffff);     // and r1, r1, #0x0000ffff
+
+		UML_OR(block, R32(Rn), I0, I1);     // or Rn, r0, r1
+		return TRUE;
+
+	case  7: // DIV0S(Rm, Rn);
+		UML_MOV(block, I0, mem(&m_sh4_state->sr));              // move r0, sr
+		UML_AND(block, I0, I0, ~(Q|M|T));       // and r0, r0, ~(Q|M|T) (clear the Q,M, and T bits)
+
+		UML_TEST(block, R32(Rn), 0x80000000);           // test Rn, #0x80000000
+		UML_JMPc(block, COND_Z, compiler->labelnum);            // jz labelnum
+
+		UML_OR(block, I0, I0, Q);               // or r0, r0, Q
+		UML_LABEL(block, compiler->labelnum++);             // labelnum:
+
+		UML_TEST(block, R32(Rm), 0x80000000);           // test Rm, #0x80000000
+		UML_JMPc(block, COND_Z, compiler->labelnum);            // jz labelnum
+
+		UML_OR(block, I0, I0, M);               // or r0, r0, M
+		UML_LABEL(block, compiler->labelnum++);             // labelnum:
+
+		UML_XOR(block, I1, R32(Rn), R32(Rm));           // xor r1, Rn, Rm
+		UML_TEST(block, I1, 0x80000000);            // test r1, #0x80000000
+		UML_JMPc(block, COND_Z, compiler->labelnum);            // jz labelnum
+
+		UML_OR(block, I0, I0, T);               // or r0, r0, T
+		UML_LABEL(block, compiler->labelnum++);             // labelnum:
+		UML_MOV(block, mem(&m_sh4_state->sr), I0);              // mov sr, r0
+		return TRUE;
+
+	case  8: // TST(Rm, Rn);
+		UML_AND(block, I0, mem(&m_sh4_state->sr), ~T);  // and r0, sr, ~T (clear the T bit)
+		UML_TEST(block, R32(Rm), R32(Rn));      // test Rm, Rn
+		UML_JMPc(block, COND_NZ, compiler->labelnum);   // jnz compiler->labelnum
+
+		UML_OR(block, I0, I0, T);   // or r0, r0, T
+		UML_LABEL(block, compiler->labelnum++);         // desc->pc:
+
+		UML_MOV(block, mem(&m_sh4_state->sr), I0);      // mov m_sh4_state->sr, r0
+		return TRUE;
+
+	case 12: // CMPSTR(Rm, Rn);
+		UML_XOR(block, I0, R32(Rn), R32(Rm));   // xor r0, Rn, Rm       (temp)
+
+		UML_SHR(block, I1, I0, 24); // shr r1, r0, #24  (HH)
+		UML_AND(block, I1, I1, 0xff);   // and r1, r1, #0xff
+
+		UML_SHR(block, I2, I0, 16); // shr r2, r0, #16  (HL)
+		UML_AND(block, I2, I2, 0xff);   // and r2, r2, #0xff
+
+		UML_SHR(block, I3, I0, 8);  // shr r3, r0, #8   (LH)
+		UML_AND(block, I3, I3, 0xff);   // and r3, r3, #0xff
+
+		UML_AND(block, I7, I0, 0xff);   // and r7, r0, #0xff    (LL)
+
+		UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~T);   // and sr, sr, ~T (clear the T bit)
+
+		UML_CMP(block, I1, 0);      // cmp r1, #0
+		UML_JMPc(block, COND_Z, compiler->labelnum);    // jnz labelnum
+		UML_CMP(block, I2, 0);      // cmp r2, #0
+		UML_JMPc(block, COND_Z, compiler->labelnum);    // jnz labelnum
+		UML_CMP(block, I3, 0);      // cmp r3, #0
+		UML_JMPc(block, COND_Z, compiler->labelnum);    // jnz labelnum
+		UML_CMP(block, I7, 0);      // cmp r7, #0
+		UML_JMPc(block, COND_NZ, compiler->labelnum+1); // jnz labelnum
+
+		UML_LABEL(block, compiler->labelnum++);     // labelnum:
+		UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), T); // or sr, sr, T
+
+		UML_LABEL(block, compiler->labelnum++);     // labelnum+1:
+		return TRUE;
+
+	case  9: // AND(Rm, Rn);
+		UML_AND(block, R32(Rn), R32(Rn), R32(Rm));  // and Rn, Rn, Rm
+		return TRUE;
+
+	case 10: // XOR(Rm, Rn);
+		UML_XOR(block, R32(Rn), R32(Rn), R32(Rm));  // xor Rn, Rn, Rm
+		return TRUE;
+
+	case 11: // OR(Rm, Rn);
+		UML_OR(block, R32(Rn), R32(Rn), R32(Rm));   // or Rn, Rn, Rm
+		return TRUE;
+
+	case 14: // MULU(Rm, Rn);
+		UML_AND(block, I0, R32(Rm), 0xffff);                // and r0, Rm, 0xffff
+		UML_AND(block, I1, R32(Rn), 0xffff);                // and r1, Rn, 0xffff
+		UML_MULU(block, mem(&m_sh4_state->macl), mem(&m_sh4_state->ea), I0, I1);    // mulu macl, ea, r0, r1
+		return TRUE;
+
+	case 15: // MULS(Rm, Rn);
+		UML_SEXT(block, I0, R32(Rm), SIZE_WORD);                // sext r0, Rm
+		UML_SEXT(block, I1, R32(Rn), SIZE_WORD);                // sext r1, Rn
+		UML_MULS(block, mem(&m_sh4_state->macl), mem(&m_sh4_state->ea), I0, I1);    // muls macl, ea, r0, r1
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+int sh34_base_device::generate_group_3(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, UINT32 ovrpc)
+{
+	switch (opcode & 15)
+	{
+	case  0: // CMPEQ(Rm, Rn); (equality)
+		UML_CMP(block, R32(Rn), R32(Rm));       // cmp Rn, Rm
+		UML_SETc(block, COND_E, I0);            // set E, r0
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, 1); // rolins sr, r0, 0, 1
+		return TRUE;
+
+	case  2: // CMPHS(Rm, Rn); (unsigned greater than or equal)
+		UML_CMP(block, R32(Rn), R32(Rm));       // cmp Rn, Rm
+		UML_SETc(block, COND_AE, I0);       // set AE, r0
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, 1); // rolins sr, r0, 0, 1
+		return TRUE;
+
+	case  3: // CMPGE(Rm, Rn); (signed greater than or equal)
+		UML_CMP(block, R32(Rn), R32(Rm));       // cmp Rn, Rm
+		UML_SETc(block, COND_GE, I0);       // set GE, r0
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, 1); // rolins sr, r0, 0, 1
+		return TRUE;
+
+	case  6: // CMPHI(Rm, Rn); (unsigned greater than)
+		UML_CMP(block, R32(Rn), R32(Rm));       // cmp Rn, Rm
+		UML_SETc(block, COND_A, I0);            // set A, r0
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, 1); // rolins sr, r0, 0, 1
+		return TRUE;
+
+	case  7: // CMPGT(Rm, Rn); (signed greater than)
+		UML_CMP(block, R32(Rn), R32(Rm));       // cmp Rn, Rm
+		UML_SETc(block, COND_G, I0);            // set G, r0
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, 1); // rolins sr, r0, 0, 1
+		return TRUE;
+
+	case  5: // DMULU(Rm, Rn);
+		UML_MULU(block, mem(&m_sh4_state->macl), mem(&m_sh4_state->mach), R32(Rn), R32(Rm));
+		return TRUE;
+
+	case 13: // DMULS(Rm, Rn);
+		UML_MULS(block, mem(&m_sh4_state->macl), mem(&m_sh4_state->mach), R32(Rn), R32(Rm));
+		return TRUE;
+
+	case  8: // SUB(Rm, Rn);
+		UML_SUB(block, R32(Rn), R32(Rn), R32(Rm));  // sub Rn, Rn, Rm
+		return TRUE;
+
+	case 12: // ADD(Rm, Rn);
+		UML_ADD(block, R32(Rn), R32(Rn), R32(Rm));  // add Rn, Rn, Rm
+		return TRUE;
+
+	case 10: // SUBC(Rm, Rn);
+		UML_CARRY(block, mem(&m_sh4_state->sr), 0); // carry = T (T is bit 0 of SR)
+		UML_SUBB(block, R32(Rn), R32(Rn), R32(Rm)); // addc Rn, Rn, Rm
+		UML_SETc(block, COND_C, I0);                // setc    i0, C
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T); // rolins sr,i0,0,T
+		return TRUE;
+
+	case 14: // ADDC(Rm, Rn);
+		UML_CARRY(block, mem(&m_sh4_state->sr), 0); // carry = T (T is bit 0 of SR)
+		UML_ADDC(block, R32(Rn), R32(Rn), R32(Rm)); // addc Rn, Rn, Rm
+		UML_SETc(block, COND_C, I0);                // setc    i0, C
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T); // rolins sr,i0,0,T
+		return TRUE;
+	}
+
+	// DIV1, ADDV, SUBV and the NOP encodings go to the interpreter
+	return FALSE;
+}
+
+int sh34_base_device::generate_group_4(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc)
+{
+	switch (opcode & 0xff)
+	{
+	case 0x00: case 0x40: case 0x80: case 0xc0: // SHLL(Rn);
+		UML_SHL(block, R32(Rn), R32(Rn), 1);        // shl Rn, Rn, 1
+		UML_SETc(block, COND_C, I0);                    // set i0,C
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T); // rolins [sr],i0,0,T
+		return TRUE;
+
+	case 0x01: case 0x41: case 0x81: case 0xc1: // SHLR(Rn);
+		UML_SHR(block, R32(Rn), R32(Rn), 1);        // shr Rn, Rn, 1
+		UML_SETc(block, COND_C, I0);                    // set i0,C
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T); // rolins [sr],i0,0,T
+		return TRUE;
+
+	case 0x04: case 0x44: case 0x84: case 0xc4: // ROTL(Rn);
+		UML_ROL(block, R32(Rn), R32(Rn), 1);        // rol Rn, Rn, 1
+		UML_SETc(block, COND_C, I0);                    // set i0,C
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T); // rolins [sr],i0,0,T
+		return TRUE;
+
+	case 0x05: case 0x45: case 0x85: case 0xc5: // ROTR(Rn);
+		UML_ROR(block, R32(Rn), R32(Rn), 1);        // ror Rn, Rn, 1
+		UML_SETc(block, COND_C, I0);                    // set i0,C
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T); // rolins [sr],i0,0,T
+		return TRUE;
+
+	case 0x10: case 0x50: case 0x90: case 0xd0: // DT(Rn);
+		UML_AND(block, I0, mem(&m_sh4_state->sr), ~T);  // and r0, sr, ~T (clear the T bit)
+		UML_SUB(block, R32(Rn), R32(Rn), 1);    // sub Rn, Rn, 1
+		UML_JMPc(block, COND_NZ, compiler->labelnum);   // jz compiler->labelnum
+
+		UML_OR(block, I0, I0, T);   // or r0, r0, T
+		UML_LABEL(block, compiler->labelnum++);         // desc->pc:
+
+		UML_MOV(block, mem(&m_sh4_state->sr), I0);      // mov m_sh4_state->sr, r0
+		return TRUE;
+
+	case 0x11: case 0x51: case 0x91: case 0xd1: // CMPPZ(Rn);
+		UML_AND(block, I0, mem(&m_sh4_state->sr), ~T);  // and r0, sr, ~T (clear the T bit)
+
+		UML_CMP(block, R32(Rn), 0);     // cmp Rn, 0
+		UML_JMPc(block, COND_S, compiler->labelnum);    // js compiler->labelnum    (if negative)
+
+		UML_OR(block, I0, I0, T);   // or r0, r0, T
+		UML_LABEL(block, compiler->labelnum++);         // desc->pc:
+
+		UML_MOV(block, mem(&m_sh4_state->sr), I0);      // mov m_sh4_state->sr, r0
+		return TRUE;
+
+	case 0x15: case 0x55: case 0x95: case 0xd5: // CMPPL(Rn);
+		UML_AND(block, I0, mem(&m_sh4_state->sr), ~T);  // and r0, sr, ~T (clear the T bit)
+
+		UML_CMP(block, R32(Rn), 0);     // cmp Rn, 0
+
+		UML_JMPc(block, COND_S, compiler->labelnum);    // js compiler->labelnum    (if negative)
+		UML_JMPc(block, COND_Z, compiler->labelnum);    // jz compiler->labelnum    (if zero)
+
+		UML_OR(block, I0, I0, T);   // or r0, r0, T
+
+		UML_LABEL(block, compiler->labelnum++);         // desc->pc:
+		UML_MOV(block, mem(&m_sh4_state->sr), I0);      // mov m_sh4_state->sr, r0
+		return TRUE;
+
+	case 0x20: case 0x60: case 0xa0: case 0xe0: // SHAL(Rn);
+		UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~T);   // and sr, sr, ~T
+		UML_SHR(block, I0, R32(Rn), 31);        // shr r0, Rn, 31
+		UML_AND(block, I0, I0, T);      // and r0, r0, T
+		UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), I0);    // or sr, sr, r0
+		UML_SHL(block, R32(Rn), R32(Rn), 1);        // shl Rn, Rn, 1
+		return TRUE;
+
+	case 0x21: case 0x61: case 0xa1: case 0xe1: // SHAR(Rn);
+		UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~T);   // and sr, sr, ~T
+		UML_AND(block, I0, R32(Rn), T);     // and r0, Rn, T
+		UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), I0);    // or sr, sr, r0
+		UML_SAR(block, R32(Rn), R32(Rn), 1);        // sar Rn, Rn, 1
+		return TRUE;
+
+	case 0x24: case 0x64: case 0xa4: case 0xe4: // ROTCL(Rn);
+		UML_CARRY(block, mem(&m_sh4_state->sr), 0);         // carry sr,0
+		UML_ROLC(block, R32(Rn), R32(Rn), 1);           // rolc  Rn,Rn,1
+		UML_SETc(block, COND_C, I0);                        // set   i0,C
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T); // rolins sr,i0,0,T
+		return TRUE;
+
+	case 0x25: case 0x65: case 0xa5: case 0xe5: // ROTCR(Rn);
+		UML_CARRY(block, mem(&m_sh4_state->sr), 0);         // carry sr,0
+		UML_RORC(block, R32(Rn), R32(Rn), 1);           // rorc  Rn,Rn,1
+		UML_SETc(block, COND_C, I0);                        // set   i0,C
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T); // rolins sr,i0,0,T
+		return TRUE;
+
+	case 0x08: case 0x48: case 0x88: case 0xc8: // SHLL2(Rn);
+		UML_SHL(block, R32(Rn), R32(Rn), 2);
+		return TRUE;
+
+	case 0x09: case 0x49: case 0x89: case 0xc9: // SHLR2(Rn);
+		UML_SHR(block, R32(Rn), R32(Rn), 2);
+		return TRUE;
+
+	case 0x18: case 0x58: case 0x98: case 0xd8: // SHLL8(Rn);
+		UML_SHL(block, R32(Rn), R32(Rn), 8);
+		return TRUE;
+
+	case 0x19: case 0x59: case 0x99: case 0xd9: // SHLR8(Rn);
+		UML_SHR(block, R32(Rn), R32(Rn), 8);
+		return TRUE;
+
+	case 0x28: case 0x68: case 0xa8: case 0xe8: // SHLL16(Rn);
+		UML_SHL(block, R32(Rn), R32(Rn), 16);
+		return TRUE;
+
+	case 0x29: case 0x69: case 0xa9: case 0xe9: // SHLR16(Rn);
+		UML_SHR(block, R32(Rn), R32(Rn), 16);
+		return TRUE;
+
+	case 0x02: // STSMMACH(Rn);
+	case 0x12: // STSMMACL(Rn);
+	case 0x22: // STSMPR(Rn);
+	case 0x32: // STCMSGR(Rn);
+	case 0x52: // STSMFPUL(Rn);
+	case 0x62: // STSMFPSCR(Rn);
+	case 0xf2: // STCMDBR(Rn);
+	case 0x03: // STCMSR(Rn);
+	case 0x13: // STCMGBR(Rn);
+	case 0x23: // STCMVBR(Rn);
+	case 0x33: // STCMSSR(Rn);
+	case 0x43: // STCMSPC(Rn);
+		UML_SUB(block, R32(Rn), R32(Rn), 4);    // sub Rn, Rn, #4
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		switch (opcode & 0xff)
+		{
+			case 0x02:  UML_MOV(block, I1, mem(&m_sh4_state->mach));    break;  // mov r1, mach
+			case 0x12:  UML_MOV(block, I1, mem(&m_sh4_state->macl));    break;  // mov r1, macl
+			case 0x22:  UML_MOV(block, I1, mem(&m_sh4_state->pr));      break;  // mov r1, pr
+			case 0x32:  UML_MOV(block, I1, mem(&m_sh4_state->sgr));     break;  // mov r1, sgr
+			case 0x52:  UML_MOV(block, I1, mem(&m_sh4_state->fpul));    break;  // mov r1, fpul
+			case 0x62:  UML_AND(block, I1, mem(&m_sh4_state->fpscr), 0x003fffff);   break;  // and r1, fpscr, 0x003fffff
+			case 0xf2:  UML_MOV(block, I1, mem(&m_sh4_state->dbr));     break;  // mov r1, dbr
+			case 0x03:  UML_MOV(block, I1, mem(&m_sh4_state->sr));      break;  // mov r1, sr
+			case 0x13:  UML_MOV(block, I1, mem(&m_sh4_state->gbr));     break;  // mov r1, gbr
+			case 0x23:  UML_MOV(block, I1, mem(&m_sh4_state->vbr));     break;  // mov r1, vbr
+			case 0x33:  UML_MOV(block, I1, mem(&m_sh4_state->ssr));     break;  // mov r1, ssr
+			case 0x43:  UML_MOV(block, I1, mem(&m_sh4_state->spc));     break;  // mov r1, spc
+		}
+		SETEA(0);                   // set ea for debug
+		UML_CALLH(block, *m_write32);            // call write32
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x06: // LDSMMACH(Rn);
+	case 0x16: // LDSMMACL(Rn);
+	case 0x26: // LDSMPR(Rn);
+	case 0x56: // LDSMFPUL(Rn);
+	case 0xf6: // LDCMDBR(Rn);
+	case 0x17: // LDCMGBR(Rn);
+	case 0x27: // LDCMVBR(Rn);
+	case 0x37: // LDCMSSR(Rn);
+	case 0x47: // LDCMSPC(Rn);
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		SETEA(0);
+		UML_CALLH(block, *m_read32);         // call read32
+		UML_ADD(block, R32(Rn), R32(Rn), 4);    // add Rn, #4
+		switch (opcode & 0xff)
+		{
+			case 0x06:  UML_MOV(block, mem(&m_sh4_state->mach), I0);    break;  // mov mach, r0
+			case 0x16:  UML_MOV(block, mem(&m_sh4_state->macl), I0);    break;  // mov macl, r0
+			case 0x26:  UML_MOV(block, mem(&m_sh4_state->pr), I0);      break;  // mov pr, r0
+			case 0x56:  UML_MOV(block, mem(&m_sh4_state->fpul), I0);    break;  // mov fpul, r0
+			case 0xf6:  UML_MOV(block, mem(&m_sh4_state->dbr), I0);     break;  // mov dbr, r0
+			case 0x17:  UML_MOV(block, mem(&m_sh4_state->gbr), I0);     break;  // mov gbr, r0
+			case 0x27:  UML_MOV(block, mem(&m_sh4_state->vbr), I0);     break;  // mov vbr, r0
+			case 0x37:  UML_MOV(block, mem(&m_sh4_state->ssr), I0);     break;  // mov ssr, r0
+			case 0x47:  UML_MOV(block, mem(&m_sh4_state->spc), I0);     break;  // mov spc, r0
+		}
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x0a: // LDSMACH(Rn);
+		UML_MOV(block, mem(&m_sh4_state->mach), R32(Rn));       // mov mach, Rn
+		return TRUE;
+
+	case 0x1a: // LDSMACL(Rn);
+		UML_MOV(block, mem(&m_sh4_state->macl), R32(Rn));       // mov macl, Rn
+		return TRUE;
+
+	case 0x2a: // LDSPR(Rn);
+		UML_MOV(block, mem(&m_sh4_state->pr), R32(Rn));         // mov m_pr, Rn
+		return TRUE;
+
+	case 0x5a: // LDSFPUL(Rn);
+		UML_MOV(block, mem(&m_sh4_state->fpul), R32(Rn));       // mov fpul, Rn
+		return TRUE;
+
+	case 0xfa: // LDCDBR(Rn);
+		UML_MOV(block, mem(&m_sh4_state->dbr), R32(Rn));        // mov dbr, Rn
+		return TRUE;
+
+	case 0x1e: // LDCGBR(Rn);
+		UML_MOV(block, mem(&m_sh4_state->gbr), R32(Rn));    // mov gbr, Rn
+		return TRUE;
+
+	case 0x2e: // LDCVBR(Rn);
+		UML_MOV(block, mem(&m_sh4_state->vbr), R32(Rn));        //  mov vbr, Rn
+		return TRUE;
+
+	case 0x3e: // LDCSSR(Rn);
+		UML_MOV(block, mem(&m_sh4_state->ssr), R32(Rn));        //  mov ssr, Rn
+		return TRUE;
+
+	case 0x4e: // LDCSPC(Rn);
+		UML_MOV(block, mem(&m_sh4_state->spc), R32(Rn));        //  mov spc, Rn
+		return TRUE;
+
+	case 0x0b: case 0x4b: case 0x8b: case 0xcb: // JSR(Rn);
+		UML_MOV(block, mem(&m_sh4_state->target), R32(Rn));     // mov target, Rn
+
+		UML_MOV(block, mem(&m_sh4_state->pr), desc->pc + 4); // mov m_pr, desc->pc + 4 (skip the current insn & delay slot)
+
+		generate_delay_slot(block, compiler, desc, 0xffffffff);
+
+		generate_update_cycles(block, compiler, mem(&m_sh4_state->target), TRUE);  // <subtract cycles>
+		generate_hashjmp(block, compiler, mem(&m_sh4_state->target));              // and do the jump
+		return TRUE;
+
+	case 0x2b: case 0x6b: case 0xab: case 0xeb: // JMP(Rn);
+		UML_MOV(block, mem(&m_sh4_state->target), R32(Rn));     // mov target, Rn
+
+		generate_delay_slot(block, compiler, desc, 0xffffffff);
+
+		generate_update_cycles(block, compiler, mem(&m_sh4_state->target), TRUE);  // <subtract cycles>
+		generate_hashjmp(block, compiler, mem(&m_sh4_state->target));              // jmp (target)
+		return TRUE;
+
+	case 0x1b: case 0x5b: case 0x9b: case 0xdb: // TAS(Rn);
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		SETEA(0);
+		UML_CALLH(block, *m_read8);          // call read8
+
+		UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~T);   // and sr, sr, ~T
+
+		UML_CMP(block, I0, 0);      // cmp r0, #0
+		UML_JMPc(block, COND_NZ, compiler->labelnum);   // jnz labelnum
+
+		UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), T); // or sr, sr, T
+
+		UML_LABEL(block, compiler->labelnum++);     // labelnum:
+
+		UML_OR(block, I1, I0, 0x80);    // or r1, r0, #0x80
+
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_CALLH(block, *m_write8);         // write the value back
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x0c: case 0x1c: case 0x2c: case 0x3c:
+	case 0x4c: case 0x5c: case 0x6c: case 0x7c:
+	case 0x8c: case 0x9c: case 0xac: case 0xbc:
+	case 0xcc: case 0xdc: case 0xec: case 0xfc: // SHAD(Rm, Rn);
+	case 0x0d: case 0x1d: case 0x2d: case 0x3d:
+	case 0x4d: case 0x5d: case 0x6d: case 0x7d:
+	case 0x8d: case 0x9d: case 0xad: case 0xbd:
+	case 0xcd: case 0xdd: case 0xed: case 0xfd: // SHLD(Rm, Rn);
+	{
+		code_label right = compiler->labelnum++;
+		code_label done = compiler->labelnum++;
+		int arith = ((opcode & 1) == 0);
+
+		UML_TEST(block, R32(Rm), 0x80000000);           // test Rm, #0x80000000
+		UML_JMPc(block, COND_NZ, right);                // jnz right
+
+		UML_AND(block, I0, R32(Rm), 0x1f);              // and r0, Rm, #0x1f
+		UML_SHL(block, R32(Rn), R32(Rn), I0);           // shl Rn, Rn, r0
+		UML_JMP(block, done);                           // jmp done
+
+		// a right shift of (~Rm & 0x1f) + 1 in two steps, so that a count of 32 fills with the sign (or zero)
+		UML_LABEL(block, right);                        // right:
+		UML_XOR(block, I0, R32(Rm), 0xffffffff);        // xor r0, Rm, #0xffffffff
+		UML_AND(block, I0, I0, 0x1f);                   // and r0, r0, #0x1f
+		if (arith)
+		{
+			UML_SAR(block, R32(Rn), R32(Rn), I0);       // sar Rn, Rn, r0
+			UML_SAR(block, R32(Rn), R32(Rn), 1);        // sar Rn, Rn, #1
+		}
+		else
+		{
+			UML_SHR(block, R32(Rn), R32(Rn), I0);       // shr Rn, Rn, r0
+			UML_SHR(block, R32(Rn), R32(Rn), 1);        // shr Rn, Rn, #1
+		}
+		UML_LABEL(block, done);                         // done:
+		return TRUE;
+	}
+	}
+
+	// LDCSR/LDCMSR (bank switching), the FPSCR loads (mode changes), the register banks,
+	// MAC_W and the NOP encodings go to the interpreter
+	return FALSE;
+}
+
+int sh34_base_device::generate_group_6(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc)
+{
+	switch (opcode & 15)
+	{
+	case  0: // MOVBL(Rm, Rn);
+		UML_MOV(block, I0, R32(Rm));        // mov r0, Rm
+		SETEA(0);                   // debug: ea = r0
+		UML_CALLH(block, *m_read8);          // call read8
+		UML_SEXT(block, R32(Rn), I0, SIZE_BYTE);    // sext Rn, r0, BYTE
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  1: // MOVWL(Rm, Rn);
+		UML_MOV(block, I0, R32(Rm));        // mov r0, Rm
+		SETEA(0);                   // debug: ea = r0
+		UML_CALLH(block, *m_read16);         // call read16
+		UML_SEXT(block, R32(Rn), I0, SIZE_WORD);    // sext Rn, r0, WORD
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  2: // MOVLL(Rm, Rn);
+		UML_MOV(block, I0, R32(Rm));        // mov r0, Rm
+		SETEA(0);                   // debug: ea = r0
+		UML_CALLH(block, *m_read32);         // call read32
+		UML_MOV(block, R32(Rn), I0);        // mov Rn, r0
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  3: // MOV(Rm, Rn);
+		UML_MOV(block, R32(Rn), R32(Rm));       // mov Rn, Rm
+		return TRUE;
+
+	case  7: // NOT(Rm, Rn);
+		UML_XOR(block, R32(Rn), R32(Rm), 0xffffffff);   // xor Rn, Rm, 0xffffffff
+		return TRUE;
+
+	case  9: // SWAPW(Rm, Rn);
+		UML_ROL(block, R32(Rn), R32(Rm), 16);   // rol Rn, Rm, 16
+		return TRUE;
+
+	case 11: // NEG(Rm, Rn);
+		UML_SUB(block, R32(Rn), 0, R32(Rm));    // sub Rn, 0, Rm
+		return TRUE;
+
+	case 12: // EXTUB(Rm, Rn);
+		UML_AND(block, R32(Rn), R32(Rm), 0x000000ff);   // and Rn, Rm, 0xff
+		return TRUE;
+
+	case 13: // EXTUW(Rm, Rn);
+		UML_AND(block, R32(Rn), R32(Rm), 0x0000ffff);   // and Rn, Rm, 0xffff
+		return TRUE;
+
+	case 14: // EXTSB(Rm, Rn);
+		UML_SEXT(block, R32(Rn), R32(Rm), SIZE_BYTE);       // sext Rn, Rm, BYTE
+		return TRUE;
+
+	case 15: // EXTSW(Rm, Rn);
+		UML_SEXT(block, R32(Rn), R32(Rm), SIZE_WORD);       // sext Rn, Rm, WORD
+		return TRUE;
+
+	case  4: // MOVBP(Rm, Rn);
+		UML_MOV(block, I0, R32(Rm));        // mov r0, Rm
+		UML_CALLH(block, *m_read8);          // call read8
+		UML_SEXT(block, R32(Rn), I0, SIZE_BYTE);        // sext Rn, r0, BYTE
+
+		if (Rm != Rn)
+			UML_ADD(block, R32(Rm), R32(Rm), 1);    // add Rm, Rm, #1
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  5: // MOVWP(Rm, Rn);
+		UML_MOV(block, I0, R32(Rm));        // mov r0, Rm
+		UML_CALLH(block, *m_read16);         // call read16
+		UML_SEXT(block, R32(Rn), I0, SIZE_WORD);        // sext Rn, r0, WORD
+
+		if (Rm != Rn)
+			UML_ADD(block, R32(Rm), R32(Rm), 2);    // add Rm, Rm, #2
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  6: // MOVLP(Rm, Rn);
+		UML_MOV(block, I0, R32(Rm));        // mov r0, Rm
+		UML_CALLH(block, *m_read32);         // call read32
+		UML_MOV(block, R32(Rn), I0);        // mov Rn, r0
+
+		if (Rm != Rn)
+			UML_ADD(block, R32(Rm), R32(Rm), 4);    // add Rm, Rm, #4
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  8: // SWAPB(Rm, Rn);
+		UML_AND(block, I0, R32(Rm), 0xffff0000);    // and r0, Rm, #0xffff0000
+		UML_AND(block, I1, R32(Rm), 0x000000ff);    // and r0, Rm, #0x000000ff
+		UML_AND(block, I2, R32(Rm), 0x0000ff00);    // and r0, Rm, #0x0000ff00
+		UML_SHL(block, I1, I1, 8);      // shl r1, r1, #8
+		UML_SHR(block, I2, I2, 8);      // shr r2, r2, #8
+		UML_OR(block, I0, I0, I1);      // or r0, r0, r1
+		UML_OR(block, R32(Rn), I0, I2);     // or Rn, r0, r2
+		return TRUE;
+
+	case 10: // NEGC(Rm, Rn);
+		UML_MOV(block, I0, mem(&m_sh4_state->sr));      // mov r0, sr (save SR)
+		UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~T);   // and sr, sr, ~T (clear the T bit)
+		UML_CARRY(block, I0, 0);    // carry = T (T is bit 0 of SR)
+		UML_SUBB(block, R32(Rn), 0, R32(Rm));   // subb Rn, #0, Rm
+
+		UML_JMPc(block, COND_NC, compiler->labelnum);   // jnc labelnum
+
+		UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), T); // or sr, sr, T
+
+		UML_LABEL(block, compiler->labelnum++);     // labelnum:
+
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+int sh34_base_device::generate_group_8(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc)
+{
+	INT32 disp;
+	UINT32 udisp;
+	UINT32 target;
+	code_label skip;
+	compiler_state compiler_temp;
+
+	switch ( opcode  & (15<<8) )
+	{
+	case  0 << 8: // MOVBS4(opcode & 0x0f, Rm);
+		udisp = (opcode & 0x0f);
+		UML_ADD(block, I0, R32(Rm), udisp);     // add r0, Rm, udisp
+		UML_AND(block, I1, R32(0), 0xff);       // and r1, R0, 0xff
+		UML_CALLH(block, *m_write8);             // call write8
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  1 << 8: // MOVWS4(opcode & 0x0f, Rm);
+		udisp = (opcode & 0x0f) * 2;
+		UML_ADD(block, I0, R32(Rm), udisp);     // add r0, Rm, udisp
+		UML_AND(block, I1, R32(0), 0xffff);     // and r1, R0, 0xffff
+		UML_CALLH(block, *m_write16);                // call write16
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  4<< 8: // MOVBL4(Rm, opcode & 0x0f);
+		udisp = opcode & 0x0f;
+		UML_ADD(block, I0, R32(Rm), udisp);     // add r0, Rm, udisp
+		SETEA(0);
+		UML_CALLH(block, *m_read8);              // call read8
+		UML_SEXT(block, R32(0), I0, SIZE_BYTE);         // sext R0, r0, BYTE
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  5<< 8: // MOVWL4(Rm, opcode & 0x0f);
+		udisp = (opcode & 0x0f)*2;
+		UML_ADD(block, I0, R32(Rm), udisp);     // add r0, Rm, udisp
+		SETEA(0);
+		UML_CALLH(block, *m_read16);             // call read16
+		UML_SEXT(block, R32(0), I0, SIZE_WORD);         // sext R0, r0, WORD
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  8<< 8: // CMPIM(opcode & 0xff);
+		UML_AND(block, I0, mem(&m_sh4_state->sr), ~T);  // and r0, sr, ~T (clear the T bit)
+
+		UML_SEXT(block, I1, opcode&0xff, SIZE_BYTE);    // sext r1, opcode&0xff, BYTE
+		UML_CMP(block, I1, R32(0));         // cmp r1, R0
+		UML_JMPc(block, COND_NZ, compiler->labelnum);   // jnz compiler->labelnum   (if negative)
+
+		UML_OR(block, I0, I0, T);   // or r0, r0, T
+
+		UML_LABEL(block, compiler->labelnum++);         // labelnum:
+		UML_MOV(block, mem(&m_sh4_state->sr), I0);      // mov m_sh4_state->sr, r0
+		return TRUE;
+
+	case  9<< 8: // BT(opcode & 0xff);
+	case 11<< 8: // BF(opcode & 0xff);
+	case 13<< 8: // BTS(opcode & 0xff);
+	case 15<< 8: // BFS(opcode & 0xff);
+		skip = compiler->labelnum++;
+		UML_TEST(block, mem(&m_sh4_state->sr), T);      // test m_sh4_state->sr, T
+		UML_JMPc(block, (opcode & (2<<8)) ? COND_NZ : COND_Z, skip);    // jz/jnz skip
+
+		disp = ((INT32)opcode << 24) >> 24;
+		target = (desc->pc + 2) + disp * 2 + 2;         // target = destination
+
+		// the taken path uses its own cycle count, so the fall-through doesn't pay for the branch
+		compiler_temp = *compiler;
+		if (opcode & (4<<8))
+		{
+			compiler_temp.cycles += 1;
+			UML_MAPVAR(block, MAPVAR_CYCLES, compiler_temp.cycles);             // mapvar  CYCLES,compiler_temp.cycles
+			generate_delay_slot(block, &compiler_temp, desc, target - 2);       // delay slot only if the branch is taken
+		}
+		else
+		{
+			compiler_temp.cycles += 2;
+			UML_MAPVAR(block, MAPVAR_CYCLES, compiler_temp.cycles);             // mapvar  CYCLES,compiler_temp.cycles
+		}
+
+		generate_update_cycles(block, &compiler_temp, target, TRUE);    // <subtract cycles>
+		generate_hashjmp(block, &compiler_temp, target);                // jmp target
+		compiler->labelnum = compiler_temp.labelnum;
+
+		UML_LABEL(block, skip);                         // skip:
+		UML_MAPVAR(block, MAPVAR_CYCLES, compiler->cycles);                             // mapvar  CYCLES,compiler->cycles
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+int sh34_base_device::generate_group_12(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc)
+{
+	UINT32 scratch;
+
+	switch (opcode & (15<<8))
+	{
+	case  0<<8: // MOVBSG(opcode & 0xff);
+		scratch = (opcode & 0xff);
+		UML_ADD(block, I0, mem(&m_sh4_state->gbr), scratch);    // add r0, gbr, scratch
+		UML_AND(block, I1, R32(0), 0xff);       // and r1, R0, 0xff
+		UML_CALLH(block, *m_write8);             // call write8
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  1<<8: // MOVWSG(opcode & 0xff);
+		scratch = (opcode & 0xff) * 2;
+		UML_ADD(block, I0, mem(&m_sh4_state->gbr), scratch);    // add r0, gbr, scratch
+		UML_AND(block, I1, R32(0), 0xffff);     // and r1, R0, 0xffff
+		UML_CALLH(block, *m_write16);                // call write16
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  2<<8: // MOVLSG(opcode & 0xff);
+		scratch = (opcode & 0xff) * 4;
+		UML_ADD(block, I0, mem(&m_sh4_state->gbr), scratch);    // add r0, gbr, scratch
+		UML_MOV(block, I1, R32(0));         // mov r1, R0
+		UML_CALLH(block, *m_write32);                // call write32
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  3<<8: // TRAPA(opcode & 0xff);
+		// exception entry is left to the interpreter
+		return FALSE;
+
+	case  4<<8: // MOVBLG(opcode & 0xff);
+		scratch = (opcode & 0xff);
+		UML_ADD(block, I0, mem(&m_sh4_state->gbr), scratch);    // add r0, gbr, scratch
+		UML_CALLH(block, *m_read8);              // call read16
+		UML_SEXT(block, R32(0), I0, SIZE_BYTE);         // sext R0, r0, BYTE
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  5<<8: // MOVWLG(opcode & 0xff);
+		scratch = (opcode & 0xff) * 2;
+		UML_ADD(block, I0, mem(&m_sh4_state->gbr), scratch);    // add r0, gbr, scratch
+		UML_CALLH(block, *m_read16);             // call read16
+		UML_SEXT(block, R32(0), I0, SIZE_WORD);         // sext R0, r0, WORD
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  6<<8: // MOVLLG(opcode & 0xff);
+		scratch = (opcode & 0xff) * 4;
+		UML_ADD(block, I0, mem(&m_sh4_state->gbr), scratch);    // add r0, gbr, scratch
+		UML_CALLH(block, *m_read32);             // call read32
+		UML_MOV(block, R32(0), I0);         // mov R0, r0
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  7<<8: // MOVA(opcode & 0xff);
+		if (in_delay_slot && ovrpc == 0xffffffff)
+			return FALSE;
+		scratch = (opcode & 0xff) * 4;
+		scratch += (((in_delay_slot ? ovrpc + 2 : desc->pc + 2) + 2) & ~3);
+
+		UML_MOV(block, R32(0), scratch);            // mov R0, scratch
+		return TRUE;
+
+	case  8<<8: // TSTI(opcode & 0xff);
+		scratch = opcode & 0xff;
+
+		UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~T);   // and sr, sr, ~T (clear the T bit)
+		UML_AND(block, I0, R32(0), scratch);        // and r0, R0, scratch
+		UML_CMP(block, I0, 0);          // cmp r0, #0
+		UML_JMPc(block, COND_NZ, compiler->labelnum);       // jnz labelnum
+
+		UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), T); // or sr, sr, T
+
+		UML_LABEL(block, compiler->labelnum++);         // labelnum:
+		return TRUE;
+
+	case  9<<8: // ANDI(opcode & 0xff);
+		UML_AND(block, R32(0), R32(0), opcode & 0xff);  // and r0, r0, opcode & 0xff
+		return TRUE;
+
+	case 10<<8: // XORI(opcode & 0xff);
+		UML_XOR(block, R32(0), R32(0), opcode & 0xff);  // xor r0, r0, opcode & 0xff
+		return TRUE;
+
+	case 11<<8: // ORI(opcode & 0xff);
+		UML_OR(block, R32(0), R32(0), opcode & 0xff);   // or r0, r0, opcode & 0xff
+		return TRUE;
+
+	case 12<<8: // TSTM(opcode & 0xff);
+		UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~T);   // and sr, sr, ~T (clear the T bit)
+		UML_ADD(block, I0, R32(0), mem(&m_sh4_state->gbr)); // add r0, R0, gbr
+		UML_CALLH(block, *m_read8);              // read8
+
+		UML_AND(block, I0, I0, opcode & 0xff);
+		UML_CMP(block, I0, 0);          // cmp r0, #0
+		UML_JMPc(block, COND_NZ, compiler->labelnum);       // jnz labelnum
+
+		UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), T); // or sr, sr, T
+
+		UML_LABEL(block, compiler->labelnum++);         // labelnum:
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 13<<8: // ANDM(opcode & 0xff);
+		UML_ADD(block, I0, R32(0), mem(&m_sh4_state->gbr)); // add r0, R0, gbr
+		UML_CALLH(block, *m_read8);              // read8
+
+		UML_AND(block, I1, I0, opcode&0xff);    // and r1, r0, #opcode&0xff
+		UML_ADD(block, I0, R32(0), mem(&m_sh4_state->gbr)); // add r0, R0, gbr
+		SETEA(0);
+		UML_CALLH(block, *m_write8);             // write8
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 14<<8: // XORM(opcode & 0xff);
+		UML_ADD(block, I0, R32(0), mem(&m_sh4_state->gbr)); // add r0, R0, gbr
+		UML_CALLH(block, *m_read8);              // read8
+
+		UML_XOR(block, I1, I0, opcode&0xff);    // xor r1, r0, #opcode&0xff
+		UML_ADD(block, I0, R32(0), mem(&m_sh4_state->gbr)); // add r0, R0, gbr
+		SETEA(0);
+		UML_CALLH(block, *m_write8);             // write8
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 15<<8: // ORM(opcode & 0xff);
+		UML_ADD(block, I0, R32(0), mem(&m_sh4_state->gbr)); // add r0, R0, gbr
+		UML_CALLH(block, *m_read8);              // read8
+
+		UML_OR(block, I1, I0, opcode&0xff); // or r1, r0, #opcode&0xff
+		UML_ADD(block, I0, R32(0), mem(&m_sh4_state->gbr)); // add r0, R0, gbr
+		SETEA(0);
+		UML_CALLH(block, *m_write8);             // write8
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+int sh34_base_device::generate_group_15(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc)
+{
+	// blocks are compiled for a single FPSCR.PR/SZ combination, so the precision is known here
+	int pr = ((compiler->mode & MODE_PR) != 0);
+	int sz = ((compiler->mode & MODE_SZ) != 0);
+	UINT32 m = Rm;
+	UINT32 n = Rn;
+	UINT32 *pair;
+	code_label skip;
+
+	switch (opcode & 15)
+	{
+	case  0: // FADD(Rm, Rn);
+		if (pr)
+			UML_FDADD(block, FR32(n & 14), FR32(n & 14), FR32(m & 14));    // fdadd   DRn,DRn,DRm
+		else
+			UML_FSADD(block, FR32(n), FR32(n), FR32(m));                   // fsadd   FRn,FRn,FRm
+		return TRUE;
+
+	case  1: // FSUB(Rm, Rn);
+		if (pr)
+			UML_FDSUB(block, FR32(n & 14), FR32(n & 14), FR32(m & 14));    // fdsub   DRn,DRn,DRm
+		else
+			UML_FSSUB(block, FR32(n), FR32(n), FR32(m));                   // fssub   FRn,FRn,FRm
+		return TRUE;
+
+	case  2: // FMUL(Rm, Rn);
+		if (pr)
+			UML_FDMUL(block, FR32(n & 14), FR32(n & 14), FR32(m & 14));    // fdmul   DRn,DRn,DRm
+		else
+			UML_FSMUL(block, FR32(n), FR32(n), FR32(m));                   // fsmul   FRn,FRn,FRm
+		return TRUE;
+
+	case  3: // FDIV(Rm, Rn);
+		// division by either zero leaves the destination alone
+		skip = compiler->labelnum++;
+		if (pr)
+		{
+			UML_DTEST(block, FR32(m & 14), U64(0x7fffffffffffffff));       // dtest   DRm,0x7fffffffffffffff
+			UML_JMPc(block, COND_Z, skip);                                  // jz      skip
+			UML_FDDIV(block, FR32(n & 14), FR32(n & 14), FR32(m & 14));    // fddiv   DRn,DRn,DRm
+		}
+		else
+		{
+			UML_TEST(block, FR32(m), 0x7fffffff);                          // test    FRm,0x7fffffff
+			UML_JMPc(block, COND_Z, skip);                                  // jz      skip
+			UML_FSDIV(block, FR32(n), FR32(n), FR32(m));                   // fsdiv   FRn,FRn,FRm
+		}
+		UML_LABEL(block, skip);                                             // skip:
+		return TRUE;
+
+	case  4: // FCMP_EQ(Rm, Rn);
+	case  5: // FCMP_GT(Rm, Rn);
+		// unordered compares are false, as they are in C
+		skip = compiler->labelnum++;
+		UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~T);   // and sr, sr, ~T
+		if (pr)
+			UML_FDCMP(block, FR32(n & 14), FR32(m & 14));                  // fdcmp   DRn,DRm
+		else
+			UML_FSCMP(block, FR32(n), FR32(m));                            // fscmp   FRn,FRm
+		UML_JMPc(block, COND_U, skip);                                      // ju      skip
+		UML_JMPc(block, ((opcode & 15) == 4) ? COND_NZ : COND_BE, skip);    // jnz/jbe skip
+		UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), T); // or sr, sr, T
+		UML_LABEL(block, skip);                                             // skip:
+		return TRUE;
+
+	case  6: // FMOVS0FR(Rm, Rn);
+	case  8: // FMOVMRFR(Rm, Rn);
+	case  9: // FMOVMRIFR(Rm, Rn);
+		if (pr)
+			return FALSE;
+		if ((opcode & 15) == 6)
+			UML_ADD(block, I0, R32(0), R32(m));         // add r0, R0, Rm
+		else
+			UML_MOV(block, I0, R32(m));                 // mov r0, Rm
+		SETEA(0);
+		UML_CALLH(block, *m_read32);                     // call read32
+		if (sz)
+		{
+			pair = (n & 1) ? &m_sh4_state->xf[n & 14] : &m_sh4_state->fr[n & 14];
+			UML_MOV(block, mem(&pair[0]), I0);          // mov FRn, r0
+			if ((opcode & 15) == 6)
+				UML_ADD(block, I0, R32(0), R32(m));     // add r0, R0, Rm
+			else
+				UML_MOV(block, I0, R32(m));             // mov r0, Rm
+			UML_ADD(block, I0, I0, 4);                  // add r0, r0, #4
+			UML_CALLH(block, *m_read32);                 // call read32
+			UML_MOV(block, mem(&pair[1]), I0);          // mov FRn+1, r0
+		}
+		else
+			UML_MOV(block, FR32(n), I0);                // mov FRn, r0
+		if ((opcode & 15) == 9)
+			UML_ADD(block, R32(m), R32(m), sz ? 8 : 4); // add Rm, Rm, #size
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  7: // FMOVFRS0(Rm, Rn);
+	case 10: // FMOVFRMR(Rm, Rn);
+	case 11: // FMOVFRMDR(Rm, Rn);
+		if (pr)
+			return FALSE;
+		if ((opcode & 15) == 11)
+			UML_SUB(block, R32(n), R32(n), sz ? 8 : 4); // sub Rn, Rn, #size
+		if ((opcode & 15) == 7)
+			UML_ADD(block, I0, R32(0), R32(n));         // add r0, R0, Rn
+		else
+			UML_MOV(block, I0, R32(n));                 // mov r0, Rn
+		SETEA(0);
+		if (sz)
+		{
+			pair = (m & 1) ? &m_sh4_state->xf[m & 14] : &m_sh4_state->fr[m & 14];
+			UML_MOV(block, I1, mem(&pair[0]));          // mov r1, FRm
+			UML_CALLH(block, *m_write32);                // call write32
+			if ((opcode & 15) == 7)
+				UML_ADD(block, I0, R32(0), R32(n));     // add r0, R0, Rn
+			else
+				UML_MOV(block, I0, R32(n));             // mov r0, Rn
+			UML_ADD(block, I0, I0, 4);                  // add r0, r0, #4
+			UML_MOV(block, I1, mem(&pair[1]));          // mov r1, FRm+1
+			UML_CALLH(block, *m_write32);                // call write32
+		}
+		else
+		{
+			UML_MOV(block, I1, FR32(m));                // mov r1, FRm
+			UML_CALLH(block, *m_write32);                // call write32
+		}
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 12: // FMOVFR(Rm, Rn);
+		if (!sz && !pr)
+			UML_MOV(block, FR32(n), FR32(m));           // mov FRn, FRm
+		else
+		{
+			UINT32 *src = (m & 1) ? &m_sh4_state->xf[m & 14] : &m_sh4_state->fr[m];
+			UINT32 *dst = (n & 1) ? &m_sh4_state->xf[n & 14] : &m_sh4_state->fr[n];
+			UML_DMOV(block, mem(dst), mem(src));        // dmov DRn/XDn, DRm/XDm
+		}
+		return TRUE;
+
+	case 13: // op1111_0x13(opcode);
+		return generate_group_15_0x13(block, compiler, desc, opcode);
+
+	case 14: // FMAC(Rm, Rn);
+		// a no-op in double precision
+		if (!pr)
+		{
+			UML_FSMUL(block, F0, FR32(0), FR32(m));    // fsmul   f0,FR0,FRm
+			UML_FSADD(block, FR32(n), F0, FR32(n));    // fsadd   FRn,f0,FRn
+		}
+		return TRUE;
+	}
+
+	// dbreak goes to the interpreter
+	return FALSE;
+}
+
+int sh34_base_device::generate_group_15_0x13(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode)
+{
+	int pr = ((compiler->mode & MODE_PR) != 0);
+	UINT32 n = Rn;
+	UINT32 m;
+	code_label compute, skip;
+
+	switch ((opcode >> 4) & 0x0f)
+	{
+	case 0x00: // FSTS(Rn);
+		UML_MOV(block, FR32(n), mem(&m_sh4_state->fpul));           // mov FRn, fpul
+		return TRUE;
+
+	case 0x01: // FLDS(Rn);
+		UML_MOV(block, mem(&m_sh4_state->fpul), FR32(n));           // mov fpul, FRn
+		return TRUE;
+
+	case 0x02: // FLOAT(Rn);
+		if (pr)
+		{
+			if (n & 1)
+				return FALSE;
+			UML_FDFRINT(block, FR32(n), mem(&m_sh4_state->fpul), SIZE_DWORD);   // fdfrint DRn,fpul,dword
+		}
+		else
+			UML_FSFRINT(block, FR32(n), mem(&m_sh4_state->fpul), SIZE_DWORD);   // fsfrint FRn,fpul,dword
+		return TRUE;
+
+	case 0x03: // FTRC(Rn);
+		if (pr)
+		{
+			if (n & 1)
+				return FALSE;
+			UML_FDTOINT(block, mem(&m_sh4_state->fpul), FR32(n), SIZE_DWORD, ROUND_TRUNC);  // fdtoint fpul,DRn,dword,trunc
+		}
+		else
+			UML_FSTOINT(block, mem(&m_sh4_state->fpul), FR32(n), SIZE_DWORD, ROUND_TRUNC);  // fstoint fpul,FRn,dword,trunc
+		return TRUE;
+
+	case 0x04: // FNEG(Rn);
+		if (pr)
+		{
+			if (n & 1)
+				return FALSE;
+#ifdef LSB_FIRST
+			UML_XOR(block, FR32(n + 1), FR32(n + 1), 0x80000000);      // xor     DRn(high),0x80000000
+#else
+			UML_XOR(block, FR32(n), FR32(n), 0x80000000);              // xor     DRn(high),0x80000000
+#endif
+		}
+		else
+			UML_XOR(block, FR32(n), FR32(n), 0x80000000);              // xor     FRn,0x80000000
+		return TRUE;
+
+	case 0x05: // FABS(Rn);
+		if (pr)
+		{
+#ifdef LSB_FIRST
+			UML_AND(block, FR32(n | 1), FR32(n | 1), 0x7fffffff);      // and     DRn(high),0x7fffffff
+#else
+			UML_AND(block, FR32(n & 14), FR32(n & 14), 0x7fffffff);    // and     DRn(high),0x7fffffff
+#endif
+		}
+		else
+			UML_AND(block, FR32(n), FR32(n), 0x7fffffff);              // and     FRn,0x7fffffff
+		return TRUE;
+
+	case 0x06: // FSQRT(Rn);
+		// negative values are left alone; the square root is always taken in single precision
+		compute = compiler->labelnum++;
+		skip = compiler->labelnum++;
+		UML_MOV(block, I0, 0);                                          // mov     i0,0
+		if (pr)
+		{
+			n &= 14;
+			UML_FDFRINT(block, F1, I0, SIZE_DWORD);                     // fdfrint f1,i0,dword
+			UML_FDCMP(block, FR32(n), F1);                              // fdcmp   DRn,f1
+		}
+		else
+		{
+			UML_FSFRINT(block, F1, I0, SIZE_DWORD);                     // fsfrint f1,i0,dword
+			UML_FSCMP(block, FR32(n), F1);                              // fscmp   FRn,f1
+		}
+		UML_JMPc(block, COND_U, compute);                               // ju      compute
+		UML_JMPc(block, COND_B, skip);                                  // jb      skip
+		UML_LABEL(block, compute);                                      // compute:
+		if (pr)
+		{
+			UML_FSFRFLT(block, F0, FR32(n), SIZE_QWORD);                // fsfrflt f0,DRn,qword
+			UML_FSSQRT(block, F0, F0);                                  // fssqrt  f0,f0
+			UML_FDFRFLT(block, FR32(n), F0, SIZE_DWORD);                // fdfrflt DRn,f0,dword
+		}
+		else
+			UML_FSSQRT(block, FR32(n), FR32(n));                        // fssqrt  FRn,FRn
+		UML_LABEL(block, skip);                                         // skip:
+		return TRUE;
+
+	case 0x08: // FLDI0(Rn);
+		UML_MOV(block, FR32(n), 0);                                     // mov     FRn,0.0
+		return TRUE;
+
+	case 0x09: // FLDI1(Rn);
+		UML_MOV(block, FR32(n), 0x3f800000);                            // mov     FRn,1.0
+		return TRUE;
+
+	case 0x0a: // FCNVSD(Rn);
+		if (pr)
+			UML_FDFRFLT(block, FR32(n & 14), mem(&m_sh4_state->fpul), SIZE_DWORD);  // fdfrflt DRn,fpul,dword
+		return TRUE;
+
+	case 0x0e: // FIPR(Rn);
+		m = (n & 3) << 2;
+		n &= 12;
+		UML_FSMUL(block, F0, FR32(n + 0), FR32(m + 0));                // fsmul   f0,FVn[0],FVm[0]
+		UML_FSMUL(block, F1, FR32(n + 1), FR32(m + 1));                // fsmul   f1,FVn[1],FVm[1]
+		UML_FSMUL(block, F2, FR32(n + 2), FR32(m + 2));                // fsmul   f2,FVn[2],FVm[2]
+		UML_FSMUL(block, F3, FR32(n + 3), FR32(m + 3));                // fsmul   f3,FVn[3],FVm[3]
+		UML_FSADD(block, F0, F0, F1);                                   // fsadd   f0,f0,f1
+		UML_FSADD(block, F0, F0, F2);                                   // fsadd   f0,f0,f2
+		UML_FSADD(block, FR32(n + 3), F0, F3);                          // fsadd   FVn[3],f0,f3
+		return TRUE;
+
+	case 0x0f: // 0xf13(opcode);
+		if ((opcode & 0x300) == 0x100) // FTRV
+		{
+			static const uml::parameter sums[4] = { F0, F1, F2, F3 };
+			n &= 12;
+
+			// each sum starts from +0, as the interpreter's does
+			UML_MOV(block, I0, 0);                                      // mov     i0,0
+			UML_FSFRINT(block, F5, I0, SIZE_DWORD);                     // fsfrint f5,i0,dword
+			for (int i = 0; i < 4; i++)
+			{
+				UML_FSMOV(block, sums[i], F5);                          // fsmov   sum[i],f5
+				for (int j = 0; j < 4; j++)
+				{
+					UML_FSMUL(block, F4, XF32((j << 2) + i), FR32(n + j));  // fsmul   f4,XMTRX[j][i],FVn[j]
+					UML_FSADD(block, sums[i], sums[i], F4);             // fsadd   sum[i],sum[i],f4
+				}
+			}
+			for (int i = 0; i < 4; i++)
+				UML_FSMOV(block, FR32(n + i), sums[i]);                 // fsmov   FVn[i],sum[i]
+			return TRUE;
+		}
+		// FSCHG, FRCHG and FSCA go to the interpreter
+		return FALSE;
+	}
+
+	// FSRRA, FCNVDS and dbreak go to the interpreter
+	return FALSE;
+}
+
+/***************************************************************************
+    CORE CALLBACKS
+***************************************************************************/
+
+/*-------------------------------------------------
+    sh4drc_set_options - configure DRC options
+-------------------------------------------------*/
+
+void sh34_base_device::sh4drc_set_options(UINT32 options)
+{
+	if (!(mconfig().options().drc() && !mconfig().m_force_no_drc)) return;
+	m_drcoptions = options;
+}
+
+
+/*-------------------------------------------------
+    sh4drc_add_pcflush - add a new address where
+    the PC must be flushed for speedups to work
+-------------------------------------------------*/
+
+void sh34_base_device::sh4drc_add_pcflush(offs_t address)
+{
+	if (!(mconfig().options().drc() && !mconfig().m_force_no_drc)) return;
+
+	if (m_pcfsel < ARRAY_LENGTH(m_pcflushes))
+		m_pcflushes[m_pcfsel++] = address;
+}
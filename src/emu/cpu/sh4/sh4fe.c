@@ -0,0 +1,842 @@
+// license:BSD-3-Clause
+// copyright-holders:R. Belmont
+/***************************************************************************
+
+    sh4fe.c
+
+    Front end for SH-4 recompiler
+
+***************************************************************************/
+
+#include "emu.h"
+#include "sh4.h"
+#include "sh4comn.h"
+#include "cpu/drcfe.h"
+
+
+/***************************************************************************
+    INSTRUCTION PARSERS
+***************************************************************************/
+
+sh4_frontend::sh4_frontend(sh34_base_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence)
+	: drc_frontend(*device, window_start, window_end, max_sequence)
+	, m_sh4(device)
+{
+}
+
+/*-------------------------------------------------
+    describe_instruction - build a description
+    of a single instruction
+-------------------------------------------------*/
+
+bool sh4_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
+{
+	UINT16 opcode;
+
+	/* fetch the opcode */
+	opcode = desc.opptr.w[0] = m_sh4->m_direct->read_word(desc.physpc & AM, m_sh4->m_code_xor);
+
+	/* all instructions are 2 bytes and most are a single cycle */
+	desc.length = 2;
+	desc.cycles = 1;
+
+	switch (opcode>>12)
+	{
+		case  0:
+			return describe_group_0(desc, prev, opcode);
+
+		case  1:    // MOVLS4
+			desc.regin[0] |= REGFLAG_R(Rn) | REGFLAG_R(Rm);
+			desc.flags |= OPFLAG_WRITES_MEMORY;
+			return true;
+
+		case  2:
+			return describe_group_2(desc, prev, opcode);
+
+		case  3:
+			return describe_group_3(desc, prev, opcode);
+
+		case  4:
+			return describe_group_4(desc, prev, opcode);
+
+		case  5:    // MOVLL4
+			desc.regin[0] |= REGFLAG_R(Rm);
+			desc.regout[0] |= REGFLAG_R(Rn);
+			desc.flags |= OPFLAG_READS_MEMORY;
+			return true;
+
+		case  6:
+			return describe_group_6(desc, prev, opcode);
+
+		case  7:    // ADDI
+			desc.regin[0] |= REGFLAG_R(Rn);
+			desc.regout[0] |= REGFLAG_R(Rn);
+			return true;
+
+		case  8:
+			return describe_group_8(desc, prev, opcode);
+
+		case  9:    // MOVWI
+			desc.regout[0] |= REGFLAG_R(Rn);
+			desc.flags |= OPFLAG_READS_MEMORY;
+			return true;
+
+		case 11:    // BSR
+			desc.regout[1] |= REGFLAG_PR;
+			// (intentional fallthrough - BSR is BRA with the addition of PR = the return address)
+		case 10:    // BRA
+			{
+				INT32 disp = ((INT32)opcode << 20) >> 20;
+
+				desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+				desc.targetpc = (desc.pc + 2) + disp * 2 + 2;
+				desc.delayslots = 1;
+				desc.cycles = 2;
+				return true;
+			}
+
+		case 12:
+			return describe_group_12(desc, prev, opcode);
+
+		case 13:    // MOVLI
+			desc.regout[0] |= REGFLAG_R(Rn);
+			desc.flags |= OPFLAG_READS_MEMORY;
+			return true;
+
+		case 14:    // MOVI
+			desc.regout[0] |= REGFLAG_R(Rn);
+			return true;
+
+		case 15:
+			return describe_group_15(desc, prev, opcode);
+	}
+
+	return false;
+}
+
+bool sh4_frontend::describe_group_0(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode)
+{
+	switch (opcode & 0xff)
+	{
+	case 0x02: // STCSR(Rn);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 0x12: // STCGBR(Rn);
+		desc.regin[1] |= REGFLAG_GBR;
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 0x22: // STCVBR(Rn);
+		desc.regin[1] |= REGFLAG_VBR;
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 0x32: // STCSSR(Rn);
+		desc.regin[1] |= REGFLAG_SSR;
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 0x42: // STCSPC(Rn);
+		desc.regin[1] |= REGFLAG_SPC;
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 0x82: case 0x92: case 0xa2: case 0xb2:
+	case 0xc2: case 0xd2: case 0xe2: case 0xf2: // STCRBANK(Rm, Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 0x03: // BSRF(Rn);
+		desc.regout[1] |= REGFLAG_PR;
+		// (intentional fallthrough - BSRF is BRAF with the addition of PR = the return address)
+	case 0x23: // BRAF(Rn);
+		desc.regin[0] |= REGFLAG_R(Rn);
+
+		desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+		desc.targetpc = BRANCH_TARGET_DYNAMIC;
+		desc.delayslots = 1;
+		desc.cycles = 2;
+		return true;
+
+	case 0x83: // PREFM(Rn);
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case 0xc3: // MOVCAL(Rn);
+		desc.regin[0] |= REGFLAG_R(Rn) | REGFLAG_R(0);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case 0x04: case 0x14: case 0x24: case 0x34:
+	case 0x44: case 0x54: case 0x64: case 0x74:
+	case 0x84: case 0x94: case 0xa4: case 0xb4:
+	case 0xc4: case 0xd4: case 0xe4: case 0xf4: // MOVBS0(Rm, Rn);
+	case 0x05: case 0x15: case 0x25: case 0x35:
+	case 0x45: case 0x55: case 0x65: case 0x75:
+	case 0x85: case 0x95: case 0xa5: case 0xb5:
+	case 0xc5: case 0xd5: case 0xe5: case 0xf5: // MOVWS0(Rm, Rn);
+	case 0x06: case 0x16: case 0x26: case 0x36:
+	case 0x46: case 0x56: case 0x66: case 0x76:
+	case 0x86: case 0x96: case 0xa6: case 0xb6:
+	case 0xc6: case 0xd6: case 0xe6: case 0xf6: // MOVLS0(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn) | REGFLAG_R(0);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case 0x07: case 0x17: case 0x27: case 0x37:
+	case 0x47: case 0x57: case 0x67: case 0x77:
+	case 0x87: case 0x97: case 0xa7: case 0xb7:
+	case 0xc7: case 0xd7: case 0xe7: case 0xf7: // MULL(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rn) | REGFLAG_R(Rm);
+		desc.regout[1] |= REGFLAG_MACL;
+		desc.cycles = 2;
+		return true;
+
+	case 0x08: case 0x88: // CLRT();
+	case 0x18: case 0x98: // SETT();
+	case 0x48: case 0xc8: // CLRS();
+	case 0x58: case 0xd8: // SETS();
+	case 0x19: case 0x59: case 0x99: case 0xd9: // DIV0U();
+		desc.regin[1] |= REGFLAG_SR;
+		desc.regout[1] |= REGFLAG_SR;
+		return true;
+
+	case 0x28: case 0xa8: // CLRMAC();
+		desc.regout[1] |= REGFLAG_MACL | REGFLAG_MACH;
+		return true;
+
+	case 0x29: case 0x69: case 0xa9: case 0xe9: // MOVT(Rn);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 0x0a: case 0x8a: // STSMACH(Rn);
+		desc.regin[1] |= REGFLAG_MACH;
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 0x1a: case 0x9a: // STSMACL(Rn);
+		desc.regin[1] |= REGFLAG_MACL;
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 0x2a: case 0xaa: // STSPR(Rn);
+		desc.regin[1] |= REGFLAG_PR;
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 0x3a: case 0xba: // STCSGR(Rn);
+		desc.regin[1] |= REGFLAG_SGR;
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 0x5a: case 0xda: // STSFPUL(Rn);
+		desc.regin[1] |= REGFLAG_FPUL;
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 0x6a: case 0xea: // STSFPSCR(Rn);
+		desc.regin[1] |= REGFLAG_FPSCR;
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 0x7a: case 0xfa: // STCDBR(Rn);
+		desc.regin[1] |= REGFLAG_DBR;
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 0x0b: case 0x4b: case 0x8b: case 0xcb: // RTS();
+		desc.regin[1] |= REGFLAG_PR;
+
+		desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+		desc.targetpc = BRANCH_TARGET_DYNAMIC;
+		desc.delayslots = 1;
+		desc.cycles = 2;
+		return true;
+
+	case 0x1b: case 0x5b: case 0x9b: case 0xdb: // SLEEP();
+		desc.flags |= OPFLAG_CAN_EXPOSE_EXTERNAL_INT | OPFLAG_END_SEQUENCE;
+		desc.cycles = 3;
+		return true;
+
+	case 0x2b: case 0x6b: case 0xab: case 0xeb: // RTE();
+		desc.regin[1] |= REGFLAG_SSR | REGFLAG_SPC;
+		desc.regout[1] |= REGFLAG_SR;
+
+		desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE | OPFLAG_CAN_EXPOSE_EXTERNAL_INT;
+		desc.targetpc = BRANCH_TARGET_DYNAMIC;
+		desc.delayslots = 1;
+		desc.cycles = 2;
+		return true;
+
+	case 0x0c: case 0x1c: case 0x2c: case 0x3c:
+	case 0x4c: case 0x5c: case 0x6c: case 0x7c:
+	case 0x8c: case 0x9c: case 0xac: case 0xbc:
+	case 0xcc: case 0xdc: case 0xec: case 0xfc: // MOVBL0(Rm, Rn);
+	case 0x0d: case 0x1d: case 0x2d: case 0x3d:
+	case 0x4d: case 0x5d: case 0x6d: case 0x7d:
+	case 0x8d: case 0x9d: case 0xad: case 0xbd:
+	case 0xcd: case 0xdd: case 0xed: case 0xfd: // MOVWL0(Rm, Rn);
+	case 0x0e: case 0x1e: case 0x2e: case 0x3e:
+	case 0x4e: case 0x5e: case 0x6e: case 0x7e:
+	case 0x8e: case 0x9e: case 0xae: case 0xbe:
+	case 0xce: case 0xde: case 0xee: case 0xfe: // MOVLL0(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(0);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case 0x0f: case 0x1f: case 0x2f: case 0x3f:
+	case 0x4f: case 0x5f: case 0x6f: case 0x7f:
+	case 0x8f: case 0x9f: case 0xaf: case 0xbf:
+	case 0xcf: case 0xdf: case 0xef: case 0xff: // MAC_L(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regin[1] |= REGFLAG_SR | REGFLAG_MACL | REGFLAG_MACH;
+		desc.regout[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regout[1] |= REGFLAG_MACL | REGFLAG_MACH;
+		desc.flags |= OPFLAG_READS_MEMORY;
+		desc.cycles = 3;
+		return true;
+	}
+
+	// everything else is a NOP or unimplemented in the interpreter
+	return true;
+}
+
+bool sh4_frontend::describe_group_2(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode)
+{
+	switch (opcode & 15)
+	{
+	case  0: // MOVBS(Rm, Rn);
+	case  1: // MOVWS(Rm, Rn);
+	case  2: // MOVLS(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rn) | REGFLAG_R(Rm);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case  4: // MOVBM(Rm, Rn);
+	case  5: // MOVWM(Rm, Rn);
+	case  6: // MOVLM(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rn) | REGFLAG_R(Rm);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case  7: // DIV0S(Rm, Rn);
+	case  8: // TST(Rm, Rn);
+	case 12: // CMPSTR(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rn) | REGFLAG_R(Rm);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.regout[1] |= REGFLAG_SR;
+		return true;
+
+	case  9: // AND(Rm, Rn);
+	case 10: // XOR(Rm, Rn);
+	case 11: // OR(Rm, Rn);
+	case 13: // XTRCT(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rn) | REGFLAG_R(Rm);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 14: // MULU(Rm, Rn);
+	case 15: // MULS(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rn) | REGFLAG_R(Rm);
+		desc.regout[1] |= REGFLAG_MACL;
+		return true;
+	}
+
+	return true;
+}
+
+bool sh4_frontend::describe_group_3(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode)
+{
+	switch (opcode & 15)
+	{
+	case  0: // CMPEQ(Rm, Rn);
+	case  2: // CMPHS(Rm, Rn);
+	case  3: // CMPGE(Rm, Rn);
+	case  6: // CMPHI(Rm, Rn);
+	case  7: // CMPGT(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rn) | REGFLAG_R(Rm);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.regout[1] |= REGFLAG_SR;
+		return true;
+
+	case  4: // DIV1(Rm, Rn);
+	case 10: // SUBC(Rm, Rn);
+	case 11: // SUBV(Rm, Rn);
+	case 14: // ADDC(Rm, Rn);
+	case 15: // ADDV(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rn) | REGFLAG_R(Rm);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.regout[1] |= REGFLAG_SR;
+		return true;
+
+	case  5: // DMULU(Rm, Rn);
+	case 13: // DMULS(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rn) | REGFLAG_R(Rm);
+		desc.regout[1] |= REGFLAG_MACL | REGFLAG_MACH;
+		desc.cycles = 2;
+		return true;
+
+	case  8: // SUB(Rm, Rn);
+	case 12: // ADD(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rn) | REGFLAG_R(Rm);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+	}
+
+	return true;
+}
+
+bool sh4_frontend::describe_group_4(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode)
+{
+	switch (opcode & 0xff)
+	{
+	case 0x00: case 0x40: case 0x80: case 0xc0: // SHLL(Rn);
+	case 0x01: case 0x41: case 0x81: case 0xc1: // SHLR(Rn);
+	case 0x04: case 0x44: case 0x84: case 0xc4: // ROTL(Rn);
+	case 0x05: case 0x45: case 0x85: case 0xc5: // ROTR(Rn);
+	case 0x10: case 0x50: case 0x90: case 0xd0: // DT(Rn);
+	case 0x20: case 0x60: case 0xa0: case 0xe0: // SHAL(Rn);
+	case 0x21: case 0x61: case 0xa1: case 0xe1: // SHAR(Rn);
+	case 0x24: case 0x64: case 0xa4: case 0xe4: // ROTCL(Rn);
+	case 0x25: case 0x65: case 0xa5: case 0xe5: // ROTCR(Rn);
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.regout[1] |= REGFLAG_SR;
+		return true;
+
+	case 0x11: case 0x51: case 0x91: case 0xd1: // CMPPZ(Rn);
+	case 0x15: case 0x55: case 0x95: case 0xd5: // CMPPL(Rn);
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.regout[1] |= REGFLAG_SR;
+		return true;
+
+	case 0x08: case 0x48: case 0x88: case 0xc8: // SHLL2(Rn);
+	case 0x09: case 0x49: case 0x89: case 0xc9: // SHLR2(Rn);
+	case 0x18: case 0x58: case 0x98: case 0xd8: // SHLL8(Rn);
+	case 0x19: case 0x59: case 0x99: case 0xd9: // SHLR8(Rn);
+	case 0x28: case 0x68: case 0xa8: case 0xe8: // SHLL16(Rn);
+	case 0x29: case 0x69: case 0xa9: case 0xe9: // SHLR16(Rn);
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 0x02: // STSMMACH(Rn);
+	case 0x12: // STSMMACL(Rn);
+	case 0x22: // STSMPR(Rn);
+	case 0x32: // STCMSGR(Rn);
+	case 0x52: // STSMFPUL(Rn);
+	case 0x62: // STSMFPSCR(Rn);
+	case 0xf2: // STCMDBR(Rn);
+	case 0x33: // STCMSSR(Rn);
+	case 0x43: // STCMSPC(Rn);
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case 0x03: // STCMSR(Rn);
+	case 0x13: // STCMGBR(Rn);
+	case 0x23: // STCMVBR(Rn);
+	case 0x83: case 0x93: case 0xa3: case 0xb3:
+	case 0xc3: case 0xd3: case 0xe3: case 0xf3: // STCMRBANK(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		desc.cycles = 2;
+		return true;
+
+	case 0x06: // LDSMMACH(Rn);
+	case 0x16: // LDSMMACL(Rn);
+	case 0x26: // LDSMPR(Rn);
+	case 0x56: // LDSMFPUL(Rn);
+	case 0xf6: // LDCMDBR(Rn);
+	case 0x37: // LDCMSSR(Rn);
+	case 0x47: // LDCMSPC(Rn);
+	case 0x87: case 0x97: case 0xa7: case 0xb7:
+	case 0xc7: case 0xd7: case 0xe7: case 0xf7: // LDCMRBANK(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case 0x17: // LDCMGBR(Rn);
+	case 0x27: // LDCMVBR(Rn);
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		desc.cycles = 3;
+		return true;
+
+	case 0x07: // LDCMSR(Rn);
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.regout[1] |= REGFLAG_SR;
+		desc.flags |= OPFLAG_READS_MEMORY | OPFLAG_CAN_EXPOSE_EXTERNAL_INT | OPFLAG_END_SEQUENCE;
+		desc.cycles = 3;
+		return true;
+
+	case 0x66: // LDSMFPSCR(Rn);
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.regout[1] |= REGFLAG_FPSCR;
+		desc.flags |= OPFLAG_READS_MEMORY | OPFLAG_CAN_CHANGE_MODES | OPFLAG_END_SEQUENCE;
+		return true;
+
+	case 0x0a: // LDSMACH(Rn);
+	case 0x1a: // LDSMACL(Rn);
+	case 0x2a: // LDSPR(Rn);
+	case 0x5a: // LDSFPUL(Rn);
+	case 0xfa: // LDCDBR(Rn);
+	case 0x1e: // LDCGBR(Rn);
+	case 0x2e: // LDCVBR(Rn);
+	case 0x3e: // LDCSSR(Rn);
+	case 0x4e: // LDCSPC(Rn);
+	case 0x8e: case 0x9e: case 0xae: case 0xbe:
+	case 0xce: case 0xde: case 0xee: case 0xfe: // LDCRBANK(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 0x6a: // LDSFPSCR(Rn);
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.regout[1] |= REGFLAG_FPSCR;
+		desc.flags |= OPFLAG_CAN_CHANGE_MODES | OPFLAG_END_SEQUENCE;
+		return true;
+
+	case 0x0e: // LDCSR(Rn);
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.regout[1] |= REGFLAG_SR;
+		desc.flags |= OPFLAG_CAN_EXPOSE_EXTERNAL_INT | OPFLAG_END_SEQUENCE;
+		return true;
+
+	case 0x0b: case 0x4b: case 0x8b: case 0xcb: // JSR(Rn);
+		desc.regout[1] |= REGFLAG_PR;
+		// (intentional fallthrough - JSR is JMP with the addition of PR = the return address)
+	case 0x2b: case 0x6b: case 0xab: case 0xeb: // JMP(Rn);
+		desc.regin[0] |= REGFLAG_R(Rn);
+
+		desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+		desc.targetpc = BRANCH_TARGET_DYNAMIC;
+		desc.delayslots = 1;
+		desc.cycles = ((opcode & 0x20) != 0) ? 1 : 2;
+		return true;
+
+	case 0x1b: case 0x5b: case 0x9b: case 0xdb: // TAS(Rn);
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.regout[1] |= REGFLAG_SR;
+		desc.flags |= OPFLAG_READS_MEMORY | OPFLAG_WRITES_MEMORY;
+		desc.cycles = 4;
+		return true;
+
+	case 0x0c: case 0x1c: case 0x2c: case 0x3c:
+	case 0x4c: case 0x5c: case 0x6c: case 0x7c:
+	case 0x8c: case 0x9c: case 0xac: case 0xbc:
+	case 0xcc: case 0xdc: case 0xec: case 0xfc: // SHAD(Rm, Rn);
+	case 0x0d: case 0x1d: case 0x2d: case 0x3d:
+	case 0x4d: case 0x5d: case 0x6d: case 0x7d:
+	case 0x8d: case 0x9d: case 0xad: case 0xbd:
+	case 0xcd: case 0xdd: case 0xed: case 0xfd: // SHLD(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rn) | REGFLAG_R(Rm);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 0x0f: case 0x1f: case 0x2f: case 0x3f:
+	case 0x4f: case 0x5f: case 0x6f: case 0x7f:
+	case 0x8f: case 0x9f: case 0xaf: case 0xbf:
+	case 0xcf: case 0xdf: case 0xef: case 0xff: // MAC_W(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regin[1] |= REGFLAG_SR | REGFLAG_MACL | REGFLAG_MACH;
+		desc.regout[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regout[1] |= REGFLAG_MACL | REGFLAG_MACH;
+		desc.flags |= OPFLAG_READS_MEMORY;
+		desc.cycles = 3;
+		return true;
+	}
+
+	return true;
+}
+
+bool sh4_frontend::describe_group_6(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode)
+{
+	switch (opcode & 15)
+	{
+	case  0: // MOVBL(Rm, Rn);
+	case  1: // MOVWL(Rm, Rn);
+	case  2: // MOVLL(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case  4: // MOVBP(Rm, Rn);
+	case  5: // MOVWP(Rm, Rn);
+	case  6: // MOVLP(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm);
+		desc.regout[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case 10: // NEGC(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.regout[1] |= REGFLAG_SR;
+		return true;
+
+	default: // MOV, NOT, SWAPB, SWAPW, NEG, EXTUB, EXTUW, EXTSB, EXTSW
+		desc.regin[0] |= REGFLAG_R(Rm);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+	}
+}
+
+bool sh4_frontend::describe_group_8(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode)
+{
+	INT32 disp;
+
+	switch (opcode & (15<<8))
+	{
+	case  0 << 8: // MOVBS4(opcode & 0x0f, Rm);
+	case  1 << 8: // MOVWS4(opcode & 0x0f, Rm);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(0);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case  4 << 8: // MOVBL4(Rm, opcode & 0x0f);
+	case  5 << 8: // MOVWL4(Rm, opcode & 0x0f);
+		desc.regin[0] |= REGFLAG_R(Rm);
+		desc.regout[0] |= REGFLAG_R(0);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case  8 << 8: // CMPIM(opcode & 0xff);
+		desc.regin[0] |= REGFLAG_R(0);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.regout[1] |= REGFLAG_SR;
+		return true;
+
+	case  9 << 8: // BT(opcode & 0xff);
+	case 11 << 8: // BF(opcode & 0xff);
+		desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+		desc.regin[1] |= REGFLAG_SR;
+
+		disp = ((INT32)opcode << 24) >> 24;
+		desc.targetpc = (desc.pc + 2) + disp * 2 + 2;
+		return true;
+
+	case 13 << 8: // BTS(opcode & 0xff);
+	case 15 << 8: // BFS(opcode & 0xff);
+		desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+		desc.regin[1] |= REGFLAG_SR;
+
+		disp = ((INT32)opcode << 24) >> 24;
+		desc.targetpc = (desc.pc + 2) + disp * 2 + 2;
+		desc.delayslots = 1;
+		return true;
+	}
+
+	return true;
+}
+
+bool sh4_frontend::describe_group_12(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode)
+{
+	switch (opcode & (15<<8))
+	{
+	case  0<<8: // MOVBSG(opcode & 0xff);
+	case  1<<8: // MOVWSG(opcode & 0xff);
+	case  2<<8: // MOVLSG(opcode & 0xff);
+		desc.regin[0] |= REGFLAG_R(0);
+		desc.regin[1] |= REGFLAG_GBR;
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case  3<<8: // TRAPA(opcode & 0xff);
+		desc.regin[1] |= REGFLAG_VBR;
+		desc.regout[1] |= REGFLAG_SR | REGFLAG_SSR | REGFLAG_SPC | REGFLAG_SGR;
+		desc.flags |= OPFLAG_WILL_CAUSE_EXCEPTION | OPFLAG_END_SEQUENCE;
+		desc.cycles = 8;
+		return true;
+
+	case  4<<8: // MOVBLG(opcode & 0xff);
+	case  5<<8: // MOVWLG(opcode & 0xff);
+	case  6<<8: // MOVLLG(opcode & 0xff);
+		desc.regin[1] |= REGFLAG_GBR;
+		desc.regout[0] |= REGFLAG_R(0);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case  7<<8: // MOVA(opcode & 0xff);
+		desc.regout[0] |= REGFLAG_R(0);
+		return true;
+
+	case  8<<8: // TSTI(opcode & 0xff);
+		desc.regin[0] |= REGFLAG_R(0);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.regout[1] |= REGFLAG_SR;
+		return true;
+
+	case  9<<8: // ANDI(opcode & 0xff);
+	case 10<<8: // XORI(opcode & 0xff);
+		desc.regin[0] |= REGFLAG_R(0);
+		desc.regout[0] |= REGFLAG_R(0);
+		return true;
+
+	case 11<<8: // ORI(opcode & 0xff);
+		desc.regin[0] |= REGFLAG_R(0);
+		desc.regout[0] |= REGFLAG_R(0);
+		desc.cycles = 3;
+		return true;
+
+	case 12<<8: // TSTM(opcode & 0xff);
+		desc.regin[0] |= REGFLAG_R(0);
+		desc.regin[1] |= REGFLAG_SR | REGFLAG_GBR;
+		desc.regout[1] |= REGFLAG_SR;
+		desc.flags |= OPFLAG_READS_MEMORY;
+		desc.cycles = 3;
+		return true;
+
+	case 13<<8: // ANDM(opcode & 0xff);
+	case 14<<8: // XORM(opcode & 0xff);
+		desc.regin[0] |= REGFLAG_R(0);
+		desc.regin[1] |= REGFLAG_GBR;
+		desc.flags |= OPFLAG_READS_MEMORY | OPFLAG_WRITES_MEMORY;
+		desc.cycles = 3;
+		return true;
+
+	case 15<<8: // ORM(opcode & 0xff);
+		desc.regin[0] |= REGFLAG_R(0);
+		desc.regin[1] |= REGFLAG_GBR;
+		desc.flags |= OPFLAG_READS_MEMORY | OPFLAG_WRITES_MEMORY;
+		return true;
+	}
+
+	return true;
+}
+
+bool sh4_frontend::describe_group_15(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode)
+{
+	// floating point registers are tracked in regin[2]/regout[2]; XF accesses aren't tracked
+	switch (opcode & 15)
+	{
+	case  0: // FADD(Rm, Rn);
+	case  1: // FSUB(Rm, Rn);
+	case  2: // FMUL(Rm, Rn);
+	case  3: // FDIV(Rm, Rn);
+	case 14: // FMAC(Rm, Rn);
+		desc.regin[1] |= REGFLAG_FPSCR;
+		desc.regin[2] |= REGFLAG_FR(Rn) | REGFLAG_FR(Rm) | REGFLAG_FR(0);
+		desc.regout[2] |= REGFLAG_FR(Rn);
+		return true;
+
+	case  4: // FCMP_EQ(Rm, Rn);
+	case  5: // FCMP_GT(Rm, Rn);
+		desc.regin[1] |= REGFLAG_FPSCR | REGFLAG_SR;
+		desc.regin[2] |= REGFLAG_FR(Rn) | REGFLAG_FR(Rm);
+		desc.regout[1] |= REGFLAG_SR;
+		return true;
+
+	case  6: // FMOVS0FR(Rm, Rn);
+	case  8: // FMOVMRFR(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(0);
+		desc.regin[1] |= REGFLAG_FPSCR;
+		desc.regout[2] |= REGFLAG_FR(Rn);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case  9: // FMOVMRIFR(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm);
+		desc.regin[1] |= REGFLAG_FPSCR;
+		desc.regout[0] |= REGFLAG_R(Rm);
+		desc.regout[2] |= REGFLAG_FR(Rn);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case  7: // FMOVFRS0(Rm, Rn);
+	case 10: // FMOVFRMR(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rn) | REGFLAG_R(0);
+		desc.regin[1] |= REGFLAG_FPSCR;
+		desc.regin[2] |= REGFLAG_FR(Rm);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case 11: // FMOVFRMDR(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.regin[1] |= REGFLAG_FPSCR;
+		desc.regin[2] |= REGFLAG_FR(Rm);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case 12: // FMOVFR(Rm, Rn);
+		desc.regin[1] |= REGFLAG_FPSCR;
+		desc.regin[2] |= REGFLAG_FR(Rm);
+		desc.regout[2] |= REGFLAG_FR(Rn);
+		return true;
+
+	case 13: // op1111_0x13(opcode);
+		desc.regin[1] |= REGFLAG_FPSCR;
+		switch ((opcode >> 4) & 15)
+		{
+		case 0x00: // FSTS(Rn);
+		case 0x02: // FLOAT(Rn);
+		case 0x0a: // FCNVSD(Rn);
+			desc.regin[1] |= REGFLAG_FPUL;
+			desc.regout[2] |= REGFLAG_FR(Rn);
+			return true;
+
+		case 0x01: // FLDS(Rn);
+		case 0x03: // FTRC(Rn);
+		case 0x0b: // FCNVDS(Rn);
+			desc.regin[2] |= REGFLAG_FR(Rn);
+			desc.regout[1] |= REGFLAG_FPUL;
+			return true;
+
+		case 0x04: // FNEG(Rn);
+		case 0x05: // FABS(Rn);
+		case 0x06: // FSQRT(Rn);
+		case 0x07: // FSRRA(Rn);
+			desc.regin[2] |= REGFLAG_FR(Rn);
+			desc.regout[2] |= REGFLAG_FR(Rn);
+			return true;
+
+		case 0x08: // FLDI0(Rn);
+		case 0x09: // FLDI1(Rn);
+			desc.regout[2] |= REGFLAG_FR(Rn);
+			return true;
+
+		case 0x0e: // FIPR(Rn);
+			desc.regin[2] |= 0xffff;
+			desc.regout[2] |= REGFLAG_FR((Rn & 12) + 3);
+			return true;
+
+		case 0x0f: // 0xf13(opcode);
+			if ((opcode & 0x300) == 0x300)
+			{
+				// FSCHG changes the transfer size, FRCHG swaps the banks
+				desc.regout[1] |= REGFLAG_FPSCR;
+				desc.regout[2] |= 0xffff;
+				desc.flags |= OPFLAG_CAN_CHANGE_MODES | OPFLAG_END_SEQUENCE;
+			}
+			else
+			{
+				// FTRV or FSSCA
+				desc.regin[1] |= REGFLAG_FPUL;
+				desc.regin[2] |= 0xffff;
+				desc.regout[2] |= 0xffff;
+			}
+			return true;
+		}
+		return true;
+	}
+
+	return true;
+}
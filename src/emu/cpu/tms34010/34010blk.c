@@ -0,0 +1,129 @@
+// license:BSD-3-Clause
+// copyright-holders:Alex Pasadyn,Zsolt Vasvari,Aaron Giles
+/***************************************************************************
+
+    34010blk.c
+
+    Whole-word row kernels for the TMS340x0 FILL and PIXBLT replace
+    operations.
+
+    Each kernel must leave memory exactly as the per-pixel loops in
+    34010blk.h would, including the transparency rule that a zero pixel
+    leaves the destination untouched.
+
+***************************************************************************/
+
+#include <string.h>
+#include "34010blk.h"
+
+#if TMS340X0_BLK_SSE2
+#include <emmintrin.h>
+#endif
+
+
+//-------------------------------------------------
+//  tms340x0_zero_pixels - return a mask covering
+//  every pixel of the word that is zero
+//-------------------------------------------------
+
+UINT16 tms340x0_zero_pixels(UINT16 word, int bpp)
+{
+	static const UINT16 lowbits[17] = { 0, 0xffff, 0x5555, 0, 0x1111, 0, 0, 0, 0x0101, 0, 0, 0, 0, 0, 0, 0, 0x0001 };
+	UINT32 nonzero = word;
+
+	// fold each pixel down onto its lowest bit, then spread that bit back over the pixel
+	for (int shift = 1; shift < bpp; shift <<= 1)
+		nonzero |= nonzero >> shift;
+	nonzero = (nonzero & lowbits[bpp]) * ((1 << bpp) - 1);
+	return ~nonzero;
+}
+
+
+//-------------------------------------------------
+//  tms340x0_fill_row - fill whole words with a
+//  replicated colour
+//-------------------------------------------------
+
+void tms340x0_fill_row(UINT16 *dst, UINT32 words, UINT16 color)
+{
+	UINT32 index = 0;
+
+#if TMS340X0_BLK_SSE2
+	__m128i fill = _mm_set1_epi16(color);
+	for ( ; index + 8 <= words; index += 8)
+		_mm_storeu_si128((__m128i *)&dst[index], fill);
+#endif
+
+	for ( ; index < words; index++)
+		dst[index] = color;
+}
+
+
+//-------------------------------------------------
+//  tms340x0_fill_row_trans - fill whole words
+//  with a colour, skipping its zero pixels
+//-------------------------------------------------
+
+void tms340x0_fill_row_trans(UINT16 *dst, UINT32 words, UINT16 color, int bpp)
+{
+	UINT16 keep = tms340x0_zero_pixels(color, bpp);
+	UINT32 index = 0;
+
+	// a fully transparent colour leaves the row alone
+	if (keep == 0xffff)
+		return;
+
+#if TMS340X0_BLK_SSE2
+	__m128i fill = _mm_set1_epi16(color);
+	__m128i mask = _mm_set1_epi16(keep);
+	for ( ; index + 8 <= words; index += 8)
+	{
+		__m128i pixels = _mm_loadu_si128((const __m128i *)&dst[index]);
+		_mm_storeu_si128((__m128i *)&dst[index], _mm_or_si128(_mm_and_si128(pixels, mask), fill));
+	}
+#endif
+
+	for ( ; index < words; index++)
+		dst[index] = (dst[index] & keep) | color;
+}
+
+
+//-------------------------------------------------
+//  tms340x0_copy_row - copy whole words between
+//  non-overlapping rows
+//-------------------------------------------------
+
+void tms340x0_copy_row(UINT16 *dst, const UINT16 *src, UINT32 words)
+{
+	memcpy(dst, src, words * sizeof(dst[0]));
+}
+
+
+//-------------------------------------------------
+//  tms340x0_copy_row_trans - copy the non-zero
+//  pixels of whole words between non-overlapping
+//  rows
+//-------------------------------------------------
+
+void tms340x0_copy_row_trans(UINT16 *dst, const UINT16 *src, UINT32 words, int bpp)
+{
+	UINT32 index = 0;
+
+#if TMS340X0_BLK_SSE2
+	// 8 and 16-bit pixels line up with SSE2 lanes, so they can be compared directly
+	if (bpp == 8 || bpp == 16)
+	{
+		__m128i zero = _mm_setzero_si128();
+		for ( ; index + 8 <= words; index += 8)
+		{
+			__m128i pixels = _mm_loadu_si128((const __m128i *)&src[index]);
+			__m128i keep = (bpp == 8) ? _mm_cmpeq_epi8(pixels, zero) : _mm_cmpeq_epi16(pixels, zero);
+			__m128i old = _mm_loadu_si128((const __m128i *)&dst[index]);
+			_mm_storeu_si128((__m128i *)&dst[index], _mm_or_si128(_mm_and_si128(old, keep), pixels));
+		}
+	}
+#endif
+
+	for ( ; index < words; index++)
+		dst[index] = (dst[index] & tms340x0_zero_pixels(src[index], bpp)) | src[index];
+}
@@ -0,0 +1,195 @@
+// license:BSD-3-Clause
+// copyright-holders:Alex Pasadyn,Zsolt Vasvari,Aaron Giles
+/***************************************************************************
+
+    34010blk.h
+
+    Whole-word row kernels for the TMS340x0 FILL and PIXBLT replace
+    operations, used when a row of the destination can be reached a
+    whole row at a time, along with the per-pixel loops they stand in
+    for.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __34010BLK_H__
+#define __34010BLK_H__
+
+#include "osdcomm.h"
+
+// the SSE2 kernels are only built when the target guarantees SSE2
+#if defined(__SSE2__) || defined(_M_X64)
+#define TMS340X0_BLK_SSE2   (1)
+#else
+#define TMS340X0_BLK_SSE2   (0)
+#endif
+
+
+//**************************************************************************
+//  FUNCTION PROTOTYPES
+//**************************************************************************
+
+// mask of the pixels in a word that are zero, for pixel sizes of 1, 2, 4, 8 or 16 bits
+UINT16 tms340x0_zero_pixels(UINT16 word, int bpp);
+
+// fill whole words with a colour; the transparent form leaves pixels alone
+// wherever the colour has a zero pixel
+void tms340x0_fill_row(UINT16 *dst, UINT32 words, UINT16 color);
+void tms340x0_fill_row_trans(UINT16 *dst, UINT32 words, UINT16 color, int bpp);
+
+// copy whole words from a source row that does not overlap the destination;
+// the transparent form only copies non-zero source pixels
+void tms340x0_copy_row(UINT16 *dst, const UINT16 *src, UINT32 words);
+void tms340x0_copy_row_trans(UINT16 *dst, const UINT16 *src, UINT32 words, int bpp);
+
+
+//**************************************************************************
+//  PER-PIXEL LOOPS
+//**************************************************************************
+
+// these are the loops FILL and PIXBLT run for every raster op; memory is
+// reached through read(wordaddr) and write(wordaddr, data), and the raster
+// op is called as op(dst, mask, pixel) to return the new pixel
+
+// the replace op, which keeps the source pixel
+struct tms340x0_replace_op
+{
+	UINT32 operator()(UINT32 dst, UINT32 mask, UINT32 pixel) const { return pixel; }
+};
+
+
+//-------------------------------------------------
+//  tms340x0_fill_words - fill whole words one
+//  pixel at a time
+//-------------------------------------------------
+
+template<int _BitsPerPixel, int _RequiresSource, int _Transparency, class _Memory, class _PixelOp>
+void tms340x0_fill_words(_Memory &memory, const _PixelOp &op, UINT32 wordaddr, UINT32 words, UINT16 color)
+{
+	for (UINT32 index = 0; index < words; index++)
+	{
+		UINT16 dstword, dstmask, pixel;
+
+		/* fetch the destination word (if necessary) */
+		if (_RequiresSource || _Transparency)
+			dstword = memory.read(wordaddr);
+		else
+			dstword = 0;
+		dstmask = (1 << _BitsPerPixel) - 1;
+
+		/* loop over partials */
+		for (int x = 0; x < 16 / _BitsPerPixel; x++)
+		{
+			/* process the pixel */
+			pixel = color & dstmask;
+			pixel = op(dstword, dstmask, pixel);
+			if (!_Transparency || pixel != 0)
+				dstword = (dstword & ~dstmask) | pixel;
+
+			/* update the destination */
+			dstmask = dstmask << _BitsPerPixel;
+		}
+
+		/* write the result */
+		memory.write(wordaddr++, dstword);
+	}
+}
+
+
+//-------------------------------------------------
+//  tms340x0_pixblt_row - copy one row of pixels
+//  between any bit addresses, returning the
+//  number of reads and writes made
+//-------------------------------------------------
+
+template<int _BitsPerPixel, int _RequiresSource, int _Transparency, class _Memory, class _PixelOp>
+UINT32 tms340x0_pixblt_row(_Memory &memory, const _PixelOp &op, UINT32 saddr, UINT32 daddr, int dx)
+{
+	const UINT32 pixelmask = (1 << _BitsPerPixel) - 1;
+	UINT32 srcwordaddr = saddr >> 4;
+	UINT32 dstwordaddr = daddr >> 4;
+	UINT8 srcbit = saddr & 15;
+	UINT8 dstbit = daddr & 15;
+	UINT32 srcword, dstword = 0;
+	UINT32 readwrites = 0;
+
+	/* fetch the initial source word */
+	srcword = memory.read(srcwordaddr++);
+	readwrites++;
+
+	/* fetch the initial dest word */
+	if (_RequiresSource || _Transparency || (daddr & 0x0f) != 0)
+	{
+		dstword = memory.read(dstwordaddr);
+		readwrites++;
+	}
+
+	/* loop over pixels */
+	for (int x = 0; x < dx; x++)
+	{
+		UINT32 dstmask;
+		UINT32 pixel;
+
+		/* fetch more words if necessary */
+		if (srcbit + _BitsPerPixel > 16)
+		{
+			srcword |= memory.read(srcwordaddr++) << 16;
+			readwrites++;
+		}
+
+		/* extract pixel from source */
+		pixel = (srcword >> srcbit) & pixelmask;
+		srcbit += _BitsPerPixel;
+		if (srcbit > 16)
+		{
+			srcbit -= 16;
+			srcword >>= 16;
+		}
+
+		/* fetch additional destination word if necessary */
+		if (_RequiresSource || _Transparency)
+			if (dstbit + _BitsPerPixel > 16)
+			{
+				dstword |= memory.read(dstwordaddr + 1) << 16;
+				readwrites++;
+			}
+
+		/* apply pixel operations */
+		pixel <<= dstbit;
+		dstmask = pixelmask << dstbit;
+		pixel = op(dstword, dstmask, pixel);
+		if (!_Transparency || pixel != 0)
+			dstword = (dstword & ~dstmask) | pixel;
+
+		/* flush destination words */
+		dstbit += _BitsPerPixel;
+		if (dstbit > 16)
+		{
+			memory.write(dstwordaddr++, dstword);
+			readwrites++;
+			dstbit -= 16;
+			dstword >>= 16;
+		}
+	}
+
+	/* flush any remaining words */
+	if (dstbit > 0)
+	{
+		/* if we're right-partial, read and mask the remaining bits */
+		if (dstbit != 16)
+		{
+			UINT16 origdst = memory.read(dstwordaddr);
+			UINT16 mask = 0xffff << dstbit;
+			dstword = (dstword & ~mask) | (origdst & mask);
+			readwrites++;
+		}
+
+		memory.write(dstwordaddr++, dstword);
+		readwrites++;
+	}
+	return readwrites;
+}
+
+
+#endif /* __34010BLK_H__ */
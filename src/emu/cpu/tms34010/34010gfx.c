@@ -237,6 +237,123 @@ UINT16 tms340x0_device::dummy_shiftreg_r(address_space &space, offs_t offset)
 	return m_shiftreg[0];
 }
 
+/* Whole-word rows for the replace ops, reached either straight through RAM or through the driver's
+   video RAM row callbacks a chunk at a time */
+#define ROW_CHUNK_WORDS     256
+
+/* Direct access to a row of whole words, when it all lives in the block of RAM behind one handler */
+UINT16 *tms340x0_device::direct_row(UINT32 wordaddr, UINT32 words, bool write)
+{
+	offs_t first = wordaddr << 1;
+	offs_t lastbyte = words * 2 - 1;
+	offs_t start, end;
+	UINT8 *base = (UINT8 *)m_program->get_read_ptr(first);
+
+	/* the whole row must fall within the handler range of its first word */
+	if (base == NULL)
+		return NULL;
+	m_program->get_handler_range(ROW_READ, first, start, end);
+	if (lastbyte > end - (first & m_program->bytemask()))
+		return NULL;
+
+	/* and if we're going to write it, it must be writable in place just the same */
+	if (write)
+	{
+		if ((UINT8 *)m_program->get_write_ptr(first) != base)
+			return NULL;
+		m_program->get_handler_range(ROW_WRITE, first, start, end);
+		if (lastbyte > end - (first & m_program->bytemask()))
+			return NULL;
+	}
+	return (UINT16 *)base;
+}
+
+/* Check whether a row of whole words lies within the video RAM the driver handles a row at a time */
+bool tms340x0_device::vram_row(UINT32 wordaddr, UINT32 words)
+{
+	offs_t first = wordaddr << 4;
+
+	/* the callbacks bypass the memory system, so leave watchpoints to the per-word path */
+	if (m_vram_row_read_cb.isnull() || m_vram_row_write_cb.isnull() || (machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
+		return false;
+	return first >= m_vram_row_start && first <= m_vram_row_end && (UINT64)words * 16 <= (UINT64)m_vram_row_end - first + 1;
+}
+
+/* Replace-op FILL of whole words; returns false if the row can't be reached a row at a time */
+bool tms340x0_device::fill_row(UINT32 wordaddr, UINT32 words, UINT16 color, int bpp, bool trans)
+{
+	UINT16 buffer[ROW_CHUNK_WORDS];
+	UINT16 *dst = direct_row(wordaddr, words, true);
+
+	if (dst != NULL)
+	{
+		if (trans)
+			tms340x0_fill_row_trans(dst, words, color, bpp);
+		else
+			tms340x0_fill_row(dst, words, color);
+		return true;
+	}
+	if (!vram_row(wordaddr, words))
+		return false;
+
+	/* every word is written back, as the per-pixel loop does, even where nothing changed */
+	if (!trans)
+		tms340x0_fill_row(buffer, MIN(words, ROW_CHUNK_WORDS), color);
+	for (UINT32 done = 0; done < words; done += ROW_CHUNK_WORDS)
+	{
+		UINT32 chunk = MIN(words - done, ROW_CHUNK_WORDS);
+		offs_t address = (wordaddr + done) << 4;
+
+		if (trans)
+		{
+			m_vram_row_read_cb(*m_program, address, buffer, chunk);
+			tms340x0_fill_row_trans(buffer, chunk, color, bpp);
+		}
+		m_vram_row_write_cb(*m_program, address, buffer, chunk);
+	}
+	return true;
+}
+
+/* Replace-op PIXBLT of whole words; returns false if either row can't be reached a row at a time, or they overlap */
+bool tms340x0_device::copy_row(UINT32 dstwordaddr, UINT32 srcwordaddr, UINT32 words, int bpp, bool trans)
+{
+	UINT16 srcbuffer[ROW_CHUNK_WORDS], dstbuffer[ROW_CHUNK_WORDS];
+	const UINT16 *src = direct_row(srcwordaddr, words, false);
+	UINT16 *dst = direct_row(dstwordaddr, words, true);
+	bool srcvram = (src == NULL && vram_row(srcwordaddr, words));
+	bool dstvram = (dst == NULL && vram_row(dstwordaddr, words));
+
+	if ((src == NULL && !srcvram) || (dst == NULL && !dstvram))
+		return false;
+
+	/* the per-pixel loop reads ahead of its writes, so overlapping rows must take that path */
+	if (src != NULL && dst != NULL && src < dst + words && dst < src + words)
+		return false;
+	if (srcvram && dstvram && srcwordaddr < dstwordaddr + words && dstwordaddr < srcwordaddr + words)
+		return false;
+
+	for (UINT32 done = 0; done < words; done += ROW_CHUNK_WORDS)
+	{
+		UINT32 chunk = MIN(words - done, ROW_CHUNK_WORDS);
+		const UINT16 *srcrow = (src != NULL) ? src + done : srcbuffer;
+		UINT16 *dstrow = (dst != NULL) ? dst + done : dstbuffer;
+
+		if (srcvram)
+			m_vram_row_read_cb(*m_program, (srcwordaddr + done) << 4, srcbuffer, chunk);
+		if (dstvram && trans)
+			m_vram_row_read_cb(*m_program, (dstwordaddr + done) << 4, dstbuffer, chunk);
+
+		if (trans)
+			tms340x0_copy_row_trans(dstrow, srcrow, chunk, bpp);
+		else
+			tms340x0_copy_row(dstrow, srcrow, chunk);
+
+		if (dstvram)
+			m_vram_row_write_cb(*m_program, (dstwordaddr + done) << 4, dstbuffer, chunk);
+	}
+	return true;
+}
+
 
 
 /* Pixel operations */
@@ -634,6 +751,7 @@ const tms340x0_device::pixblt_b_op_func tms340x0_device::s_fill_op_table[] =
 
 /* non-transparent replace ops */
 #define PIXEL_OP(src, mask, pixel)      pixel = pixel
+#define PIXEL_OP_FUNC                   tms340x0_replace_op()
 #define PIXEL_OP_TIMING                 2
 #define PIXEL_OP_REQUIRES_SOURCE        0
 #define TRANSPARENCY                    0
@@ -676,10 +794,12 @@ const tms340x0_device::pixblt_b_op_func tms340x0_device::s_fill_op_table[] =
 #undef TRANSPARENCY
 #undef PIXEL_OP_REQUIRES_SOURCE
 #undef PIXEL_OP_TIMING
+#undef PIXEL_OP_FUNC
 #undef PIXEL_OP
 
 
 #define PIXEL_OP(src, mask, pixel)      pixel = (this->*m_pixel_op)(src, mask, pixel)
+#define PIXEL_OP_FUNC                   gfx_pixel_op(*this)
 #define PIXEL_OP_TIMING                 m_pixel_op_timing
 #define PIXEL_OP_REQUIRES_SOURCE        1
 #define TRANSPARENCY                    0
@@ -722,11 +842,13 @@ const tms340x0_device::pixblt_b_op_func tms340x0_device::s_fill_op_table[] =
 #undef TRANSPARENCY
 #undef PIXEL_OP_REQUIRES_SOURCE
 #undef PIXEL_OP_TIMING
+#undef PIXEL_OP_FUNC
 #undef PIXEL_OP
 
 
 /* transparent replace ops */
 #define PIXEL_OP(src, mask, pixel)      pixel = pixel
+#define PIXEL_OP_FUNC                   tms340x0_replace_op()
 #define PIXEL_OP_REQUIRES_SOURCE        0
 #define PIXEL_OP_TIMING                 4
 #define TRANSPARENCY                    1
@@ -769,10 +891,12 @@ const tms340x0_device::pixblt_b_op_func tms340x0_device::s_fill_op_table[] =
 #undef TRANSPARENCY
 #undef PIXEL_OP_REQUIRES_SOURCE
 #undef PIXEL_OP_TIMING
+#undef PIXEL_OP_FUNC
 #undef PIXEL_OP
 
 
 #define PIXEL_OP(src, mask, pixel)      pixel = (this->*m_pixel_op)(src, mask, pixel)
+#define PIXEL_OP_FUNC                   gfx_pixel_op(*this)
 #define PIXEL_OP_REQUIRES_SOURCE        1
 #define PIXEL_OP_TIMING                 (2+m_pixel_op_timing)
 #define TRANSPARENCY                    1
@@ -815,6 +939,7 @@ const tms340x0_device::pixblt_b_op_func tms340x0_device::s_fill_op_table[] =
 #undef TRANSPARENCY
 #undef PIXEL_OP_REQUIRES_SOURCE
 #undef PIXEL_OP_TIMING
+#undef PIXEL_OP_FUNC
 #undef PIXEL_OP
 
 static const UINT8 pixelsize_lookup[32] =
@@ -950,7 +1075,7 @@ void FUNCTION_NAME(tms340x0_device::pixblt)(int src_is_linear, int dst_is_linear
 	/* if this is the first time through, perform the operation */
 	if (!P_FLAG())
 	{
-		int dx, dy, x, y, /*words,*/ yreverse;
+		int dx, dy, y, /*words,*/ yreverse;
 		word_write_func word_write;
 		word_read_func word_read;
 		UINT32 readwrites = 0;
@@ -1019,88 +1144,22 @@ void FUNCTION_NAME(tms340x0_device::pixblt)(int src_is_linear, int dst_is_linear
 		m_st |= STBIT_P;
 
 		/* loop over rows */
+		gfx_memory memory(*this, word_read, word_write);
 		for (y = 0; y < dy; y++)
 		{
-			UINT32 srcwordaddr = saddr >> 4;
-			UINT32 dstwordaddr = daddr >> 4;
-			UINT8 srcbit = saddr & 15;
-			UINT8 dstbit = daddr & 15;
-			UINT32 srcword, dstword = 0;
-
-			/* fetch the initial source word */
-			srcword = (this->*word_read)(*m_program, srcwordaddr++ << 1);
-			readwrites++;
-
-			/* fetch the initial dest word */
-			if (PIXEL_OP_REQUIRES_SOURCE || TRANSPARENCY || (daddr & 0x0f) != 0)
-			{
-				dstword = (this->*word_read)(*m_program, dstwordaddr << 1);
-				readwrites++;
-			}
+			UINT32 words = dx * BITS_PER_PIXEL / 16;
 
-			/* loop over pixels */
-			for (x = 0; x < dx; x++)
+			/* replace ops on word-aligned rows can be copied a word at a time, if the rows can be reached that way */
+			if (!PIXEL_OP_REQUIRES_SOURCE && (saddr & 15) == 0 && (daddr & 15) == 0 && words > 0 && (dx * BITS_PER_PIXEL) % 16 == 0 &&
+				word_write == &tms340x0_device::memory_w && copy_row(daddr >> 4, saddr >> 4, words, BITS_PER_PIXEL, TRANSPARENCY))
 			{
-				UINT32 dstmask;
-				UINT32 pixel;
-
-				/* fetch more words if necessary */
-				if (srcbit + BITS_PER_PIXEL > 16)
-				{
-					srcword |= (this->*word_read)(*m_program, srcwordaddr++ << 1) << 16;
-					readwrites++;
-				}
-
-				/* extract pixel from source */
-				pixel = (srcword >> srcbit) & PIXEL_MASK;
-				srcbit += BITS_PER_PIXEL;
-				if (srcbit > 16)
-				{
-					srcbit -= 16;
-					srcword >>= 16;
-				}
-
-				/* fetch additional destination word if necessary */
-				if (PIXEL_OP_REQUIRES_SOURCE || TRANSPARENCY)
-					if (dstbit + BITS_PER_PIXEL > 16)
-					{
-						dstword |= (this->*word_read)(*m_program, (dstwordaddr + 1) << 1) << 16;
-						readwrites++;
-					}
-
-				/* apply pixel operations */
-				pixel <<= dstbit;
-				dstmask = PIXEL_MASK << dstbit;
-				PIXEL_OP(dstword, dstmask, pixel);
-				if (!TRANSPARENCY || pixel != 0)
-					dstword = (dstword & ~dstmask) | pixel;
-
-				/* flush destination words */
-				dstbit += BITS_PER_PIXEL;
-				if (dstbit > 16)
-				{
-					(this->*word_write)(*m_program, dstwordaddr++ << 1, dstword);
-					readwrites++;
-					dstbit -= 16;
-					dstword >>= 16;
-				}
+				/* account for the same reads and writes as the per-pixel loop */
+				readwrites += words * (TRANSPARENCY ? 3 : 2);
 			}
 
-			/* flush any remaining words */
-			if (dstbit > 0)
-			{
-				/* if we're right-partial, read and mask the remaining bits */
-				if (dstbit != 16)
-				{
-					UINT16 origdst = (this->*word_read)(*m_program, dstwordaddr << 1);
-					UINT16 mask = 0xffff << dstbit;
-					dstword = (dstword & ~mask) | (origdst & mask);
-					readwrites++;
-				}
-
-				(this->*word_write)(*m_program, dstwordaddr++ << 1, dstword);
-				readwrites++;
-			}
+			/* otherwise, go pixel by pixel */
+			else
+				readwrites += tms340x0_pixblt_row<BITS_PER_PIXEL, PIXEL_OP_REQUIRES_SOURCE, TRANSPARENCY>(memory, PIXEL_OP_FUNC, saddr, daddr, dx);
 
 
 
@@ -1793,7 +1852,7 @@ void FUNCTION_NAME(tms340x0_device::fill)(int dst_is_linear)
 	/* if this is the first time through, perform the operation */
 	if (!P_FLAG())
 	{
-		int dx, dy, x, y, words, left_partials, right_partials, full_words;
+		int dx, dy, x, y, left_partials, right_partials, full_words;
 		word_write_func word_write;
 		word_read_func word_read;
 		UINT32 daddr;
@@ -1858,6 +1917,7 @@ void FUNCTION_NAME(tms340x0_device::fill)(int dst_is_linear)
 		m_st |= STBIT_P;
 
 		/* loop over rows */
+		gfx_memory memory(*this, word_read, word_write);
 		for (y = 0; y < dy; y++)
 		{
 			UINT16 dstword, dstmask, pixel;
@@ -1893,31 +1953,13 @@ void FUNCTION_NAME(tms340x0_device::fill)(int dst_is_linear)
 				(this->*word_write)(*m_program, dwordaddr++ << 1, dstword);
 			}
 
-			/* loop over full words */
-			for (words = 0; words < full_words; words++)
+			/* handle the full words; replace ops can fill them in one go, if the row can be reached that way */
+			if (full_words > 0)
 			{
-				/* fetch the destination word (if necessary) */
-				if (PIXEL_OP_REQUIRES_SOURCE || TRANSPARENCY)
-					dstword = (this->*word_read)(*m_program, dwordaddr << 1);
-				else
-					dstword = 0;
-				dstmask = PIXEL_MASK;
-
-				/* loop over partials */
-				for (x = 0; x < PIXELS_PER_WORD; x++)
-				{
-					/* process the pixel */
-					pixel = COLOR1() & dstmask;
-					PIXEL_OP(dstword, dstmask, pixel);
-					if (!TRANSPARENCY || pixel != 0)
-						dstword = (dstword & ~dstmask) | pixel;
-
-					/* update the destination */
-					dstmask = dstmask << BITS_PER_PIXEL;
-				}
-
-				/* write the result */
-				(this->*word_write)(*m_program, dwordaddr++ << 1, dstword);
+				if (PIXEL_OP_REQUIRES_SOURCE || word_write != &tms340x0_device::memory_w ||
+					!fill_row(dwordaddr, full_words, COLOR1(), BITS_PER_PIXEL, TRANSPARENCY))
+					tms340x0_fill_words<BITS_PER_PIXEL, PIXEL_OP_REQUIRES_SOURCE, TRANSPARENCY>(memory, PIXEL_OP_FUNC, dwordaddr, full_words, COLOR1());
+				dwordaddr += full_words;
 			}
 
 			/* handle the right partial word */
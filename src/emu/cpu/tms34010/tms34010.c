@@ -12,6 +12,7 @@
 #include "emu.h"
 #include "debugger.h"
 #include "tms34010.h"
+#include "34010blk.h"
 
 
 /***************************************************************************
@@ -41,6 +42,8 @@ tms340x0_device::tms340x0_device(const machine_config &mconfig, device_type type
 	, m_pixclock(0)
 	, m_pixperclock(0)
 	, m_output_int_cb(*this)
+	, m_vram_row_start(0)
+	, m_vram_row_end(0)
 {
 }
 
@@ -576,6 +579,8 @@ void tms340x0_device::device_start()
 	m_output_int_cb.resolve();
 	m_to_shiftreg_cb.bind_relative_to(*owner());
 	m_from_shiftreg_cb.bind_relative_to(*owner());
+	m_vram_row_read_cb.bind_relative_to(*owner());
+	m_vram_row_write_cb.bind_relative_to(*owner());
 
 	m_external_host_access = FALSE;
 
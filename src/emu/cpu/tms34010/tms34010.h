@@ -235,6 +235,18 @@ typedef device_delegate<void (address_space &space, offs_t address, UINT16 *shif
 		tms340x0_device::set_from_shiftreg_callback(*device, from_shiftreg_cb_delegate(&_class::_method, #_class "::" #_method, downcast<_class *>(owner)));
 
 
+/* whole-word row access to video RAM that is mapped through handlers; the range and address are in bits,
+   like the address map, and each word must behave exactly like a full 16-bit access through the handlers */
+typedef device_delegate<void (address_space &space, offs_t address, UINT16 *data, UINT32 words)> vram_row_read_cb_delegate;
+typedef device_delegate<void (address_space &space, offs_t address, const UINT16 *data, UINT32 words)> vram_row_write_cb_delegate;
+
+#define TMS340X0_VRAM_ROW_READ_CB_MEMBER(_name) void _name(address_space &space, offs_t address, UINT16 *data, UINT32 words)
+#define TMS340X0_VRAM_ROW_WRITE_CB_MEMBER(_name) void _name(address_space &space, offs_t address, const UINT16 *data, UINT32 words)
+
+#define MCFG_TMS340X0_VRAM_ROW_CB(_start, _end, _class, _read, _write) \
+		tms340x0_device::set_vram_row_callbacks(*device, _start, _end, vram_row_read_cb_delegate(&_class::_read, #_class "::" #_read, downcast<_class *>(owner)), vram_row_write_cb_delegate(&_class::_write, #_class "::" #_write, downcast<_class *>(owner)));
+
+
 class tms340x0_device : public cpu_device,
 						public device_video_interface
 {
@@ -250,6 +262,14 @@ public:
 	template<class _Object> static devcb_base &set_output_int_callback(device_t &device, _Object object) { return downcast<tms340x0_device &>(device).m_output_int_cb.set_callback(object); }
 	static void set_to_shiftreg_callback(device_t &device, to_shiftreg_cb_delegate callback) { downcast<tms340x0_device &>(device).m_to_shiftreg_cb = callback; }
 	static void set_from_shiftreg_callback(device_t &device, from_shiftreg_cb_delegate callback) { downcast<tms340x0_device &>(device).m_from_shiftreg_cb = callback; }
+	static void set_vram_row_callbacks(device_t &device, offs_t start, offs_t end, vram_row_read_cb_delegate read, vram_row_write_cb_delegate write)
+	{
+		tms340x0_device &dev = downcast<tms340x0_device &>(device);
+		dev.m_vram_row_start = start;
+		dev.m_vram_row_end = end;
+		dev.m_vram_row_read_cb = read;
+		dev.m_vram_row_write_cb = write;
+	}
 
 	void get_display_params(tms34010_display_params *params);
 	void tms34010_state_postload();
@@ -300,6 +320,28 @@ protected:
 	typedef void (tms340x0_device::*word_write_func)(address_space &space, offs_t offset,UINT16 data);
 	typedef UINT16 (tms340x0_device::*word_read_func)(address_space &space, offs_t offset);
 
+	// memory and raster op access for the per-pixel loops in 34010blk.h
+	class gfx_memory
+	{
+	public:
+		gfx_memory(tms340x0_device &cpu, word_read_func read, word_write_func write) : m_cpu(cpu), m_read(read), m_write(write) { }
+		UINT16 read(UINT32 wordaddr) { return (m_cpu.*m_read)(*m_cpu.m_program, wordaddr << 1); }
+		void write(UINT32 wordaddr, UINT16 data) { (m_cpu.*m_write)(*m_cpu.m_program, wordaddr << 1, data); }
+	private:
+		tms340x0_device &m_cpu;
+		word_read_func m_read;
+		word_write_func m_write;
+	};
+
+	class gfx_pixel_op
+	{
+	public:
+		gfx_pixel_op(tms340x0_device &cpu) : m_cpu(cpu) { }
+		UINT32 operator()(UINT32 dst, UINT32 mask, UINT32 pixel) const { return (m_cpu.*m_cpu.m_pixel_op)(dst, mask, pixel); }
+	private:
+		tms340x0_device &m_cpu;
+	};
+
 	static const wfield_func s_wfield_functions[32];
 	static const rfield_func s_rfield_functions[64];
 	static const opcode_func s_opcode_table[65536 >> 4];
@@ -346,6 +388,10 @@ protected:
 	devcb_write_line m_output_int_cb; /* output interrupt callback */
 	to_shiftreg_cb_delegate m_to_shiftreg_cb;  /* shift register write */
 	from_shiftreg_cb_delegate m_from_shiftreg_cb; /* shift register read */
+	vram_row_read_cb_delegate m_vram_row_read_cb;   /* video RAM row read */
+	vram_row_write_cb_delegate m_vram_row_write_cb; /* video RAM row write */
+	offs_t m_vram_row_start;                      /* bit range covered by the video RAM row callbacks */
+	offs_t m_vram_row_end;
 
 	struct XY
 	{
@@ -912,6 +958,10 @@ protected:
 	void shiftreg_w(address_space &space, offs_t offset, UINT16 data);
 	UINT16 shiftreg_r(address_space &space, offs_t offset);
 	UINT16 dummy_shiftreg_r(address_space &space, offs_t offset);
+	UINT16 *direct_row(UINT32 wordaddr, UINT32 words, bool write);
+	bool vram_row(UINT32 wordaddr, UINT32 words);
+	bool fill_row(UINT32 wordaddr, UINT32 words, UINT16 color, int bpp, bool trans);
+	bool copy_row(UINT32 dstwordaddr, UINT32 srcwordaddr, UINT32 words, int bpp, bool trans);
 	UINT32 pixel_op00(UINT32 dstpix, UINT32 mask, UINT32 srcpix);
 	UINT32 pixel_op01(UINT32 dstpix, UINT32 mask, UINT32 srcpix);
 	UINT32 pixel_op02(UINT32 dstpix, UINT32 mask, UINT32 srcpix);
@@ -131,8 +131,19 @@ memory_region *device_t::memregion(const char *_tag) const
 	if (this == NULL)
 		return NULL;
 
-	// build a fully-qualified name and look it up
-	return machine().memory().region(subtag(_tag).c_str());
+	// check the names we've already resolved
+	if (*_tag != 0)
+	{
+		memory_region *quick = m_region_map.find(_tag);
+		if (quick != NULL)
+			return quick;
+	}
+
+	// build a fully-qualified name and look it up, remembering what we find
+	memory_region *result = machine().memory().region(subtag(_tag).c_str());
+	if (result != NULL && *_tag != 0)
+		m_region_map.add(_tag, result);
+	return result;
 }
 
 
@@ -147,8 +158,19 @@ memory_share *device_t::memshare(const char *_tag) const
 	if (this == NULL)
 		return NULL;
 
-	// build a fully-qualified name and look it up
-	return machine().memory().shared(subtag(_tag).c_str());
+	// check the names we've already resolved
+	if (*_tag != 0)
+	{
+		memory_share *quick = m_share_map.find(_tag);
+		if (quick != NULL)
+			return quick;
+	}
+
+	// build a fully-qualified name and look it up, remembering what we find
+	memory_share *result = machine().memory().shared(subtag(_tag).c_str());
+	if (result != NULL && *_tag != 0)
+		m_share_map.add(_tag, result);
+	return result;
 }
 
 
@@ -163,8 +185,19 @@ memory_bank *device_t::membank(const char *_tag) const
 	if (this == NULL)
 		return NULL;
 
-	// build a fully-qualified name and look it up
-	return machine().memory().bank(subtag(_tag).c_str());
+	// check the names we've already resolved
+	if (*_tag != 0)
+	{
+		memory_bank *quick = m_bank_map.find(_tag);
+		if (quick != NULL)
+			return quick;
+	}
+
+	// build a fully-qualified name and look it up, remembering what we find
+	memory_bank *result = machine().memory().bank(subtag(_tag).c_str());
+	if (result != NULL && *_tag != 0)
+		m_bank_map.add(_tag, result);
+	return result;
 }
 
 
@@ -179,8 +212,19 @@ ioport_port *device_t::ioport(const char *tag) const
 	if (this == NULL)
 		return NULL;
 
-	// build a fully-qualified name and look it up
-	return machine().ioport().port(subtag(tag).c_str());
+	// check the names we've already resolved
+	if (*tag != 0)
+	{
+		ioport_port *quick = m_port_map.find(tag);
+		if (quick != NULL)
+			return quick;
+	}
+
+	// build a fully-qualified name and look it up, remembering what we find
+	ioport_port *result = machine().ioport().port(subtag(tag).c_str());
+	if (result != NULL && *tag != 0)
+		m_port_map.add(tag, result);
+	return result;
 }
 
 
@@ -705,9 +749,9 @@ device_t *device_t::subdevice_slow(const char *tag) const
 	if (fulltag.length() > 1)
 		for (int start = 1, end = fulltag.find_first_of(':', start); start != 0 && curdevice != NULL; start = end + 1, end = fulltag.find_first_of(':', start))
 		{
-			std::string part(fulltag, start, (end == -1) ? -1 : end - start);
+			int length = (end == -1) ? fulltag.length() - start : end - start;
 			for (curdevice = curdevice->m_subdevice_list.first(); curdevice != NULL; curdevice = curdevice->next())
-				if (part.compare(curdevice->m_basetag)==0)
+				if (fulltag.compare(start, length, curdevice->m_basetag) == 0)
 					break;
 		}
 
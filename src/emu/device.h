@@ -102,6 +102,7 @@ class device_t : public delegate_late_bind
 	friend class machine_config;
 	friend class running_machine;
 	friend class finder_base;
+	friend class memory_manager;
 
 protected:
 	// construction/destruction
@@ -248,6 +249,10 @@ protected:
 	device_t *              m_next;                 // next device by the same owner (of any type/class)
 	simple_list<device_t>   m_subdevice_list;       // list of sub-devices we own
 	mutable tagmap_t<device_t *> m_device_map;      // map of device names looked up and found
+	mutable tagmap_t<memory_region *, 7> m_region_map; // map of region names looked up and found
+	mutable tagmap_t<memory_share *, 7> m_share_map; // map of share names looked up and found
+	mutable tagmap_t<memory_bank *, 7> m_bank_map;  // map of bank names looked up and found
+	mutable tagmap_t<ioport_port *, 7> m_port_map;  // map of port names looked up and found
 
 	// device interfaces
 	device_interface *      m_interface_list;       // head of interface list
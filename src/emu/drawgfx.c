@@ -9,6 +9,7 @@
 
 #include "emu.h"
 #include "drawgfxm.h"
+#include "drawgfxd.h"
 
 
 /***************************************************************************
@@ -26,17 +27,6 @@ bitmap_ind8 drawgfx_dummy_priority_bitmap;
     INLINE FUNCTIONS
 ***************************************************************************/
 
-/*-------------------------------------------------
-    readbit - read a single bit from a base
-    offset
--------------------------------------------------*/
-
-static inline int readbit(const UINT8 *src, unsigned int bitnum)
-{
-	return src[bitnum / 8] & (0x80 >> (bitnum % 8));
-}
-
-
 /*-------------------------------------------------
     normalize_xscroll - normalize an X scroll
     value for a bitmap to be positive and less
@@ -107,7 +97,8 @@ gfx_element::gfx_element()
 		m_layout_is_raw(false),
 		m_layout_planes(0),
 		m_layout_xormask(0),
-		m_layout_charincrement(0)
+		m_layout_charincrement(0),
+		m_decode_mode(GFX_DECODE_GENERIC)
 {
 }
 
@@ -132,7 +123,8 @@ gfx_element::gfx_element(palette_device *palette, UINT8 *base, UINT32 width, UIN
 		m_layout_is_raw(true),
 		m_layout_planes(0),
 		m_layout_xormask(0),
-		m_layout_charincrement(0)
+		m_layout_charincrement(0),
+		m_decode_mode(GFX_DECODE_GENERIC)
 {
 }
 
@@ -157,7 +149,8 @@ gfx_element::gfx_element(palette_device *palette, const gfx_layout &gl, const UI
 		m_layout_is_raw(false),
 		m_layout_planes(0),
 		m_layout_xormask(xormask),
-		m_layout_charincrement(0)
+		m_layout_charincrement(0),
+		m_decode_mode(GFX_DECODE_GENERIC)
 {
 	// set the layout
 	set_layout(gl, srcdata);
@@ -226,6 +219,9 @@ void gfx_element::set_layout(const gfx_layout &gl, const UINT8 *srcdata)
 		m_gfxdata = &m_gfxdata_allocated[0];
 	}
 
+	// pick the fastest way to decode it
+	classify_layout();
+
 	// mark everything dirty
 	m_dirty.resize(m_total_elements);
 	memset(&m_dirty[0], 1, m_total_elements);
@@ -238,6 +234,44 @@ void gfx_element::set_layout(const gfx_layout &gl, const UINT8 *srcdata)
 }
 
 
+//-------------------------------------------------
+//  classify_layout - determine whether the layout
+//  matches one of the common forms that can be
+//  decoded without going bit by bit
+//-------------------------------------------------
+
+void gfx_element::classify_layout()
+{
+	m_decode_mode = GFX_DECODE_GENERIC;
+	if (m_layout_is_raw || m_layout_planes == 0)
+		return;
+
+	gfx_decode_layout layout;
+	decode_layout(layout);
+	m_decode_mode = gfx_decode_classify(layout);
+}
+
+
+//-------------------------------------------------
+//  decode_layout - describe the layout for the
+//  decoders
+//-------------------------------------------------
+
+void gfx_element::decode_layout(gfx_decode_layout &layout) const
+{
+	layout.srcdata = m_srcdata;
+	layout.xormask = m_layout_xormask;
+	layout.charincrement = m_layout_charincrement;
+	layout.planes = m_layout_planes;
+	layout.planeoffset = &m_layout_planeoffset[0];
+	layout.width = m_origwidth;
+	layout.xoffset = &m_layout_xoffset[0];
+	layout.height = m_origheight;
+	layout.yoffset = &m_layout_yoffset[0];
+	layout.line_modulo = m_line_modulo;
+}
+
+
 //-------------------------------------------------
 //  set_raw_layout - set the layout for a gfx_element
 //-------------------------------------------------
@@ -326,30 +360,9 @@ void gfx_element::decode(UINT32 code)
 	// don't decode GFX_RAW
 	if (!m_layout_is_raw)
 	{
-		// zap the data to 0
-		UINT8 *decode_base = m_gfxdata + code * m_char_modulo;
-		memset(decode_base, 0, m_char_modulo);
-
-		// iterate over planes
-		int plane, planebit;
-		for (plane = 0, planebit = 1 << (m_layout_planes - 1);
-				plane < m_layout_planes;
-				plane++, planebit >>= 1)
-		{
-			int planeoffs = code * m_layout_charincrement + m_layout_planeoffset[plane];
-
-			// iterate over rows
-			for (int y = 0; y < m_origheight; y++)
-			{
-				int yoffs = planeoffs + m_layout_yoffset[y];
-				UINT8 *dp = decode_base + y * m_line_modulo;
-
-				// iterate over columns
-				for (int x = 0; x < m_origwidth; x++)
-					if (readbit(m_srcdata, (yoffs + m_layout_xoffset[x]) ^ m_layout_xormask))
-						dp[x] |= planebit;
-			}
-		}
+		gfx_decode_layout layout;
+		decode_layout(layout);
+		gfx_decode(gfx_decode_mode(m_decode_mode), layout, code, m_gfxdata + code * m_char_modulo);
 	}
 
 	// (re)compute pen usage
@@ -374,6 +387,58 @@ void gfx_element::decode(UINT32 code)
 }
 
 
+//-------------------------------------------------
+//  decode_dirty - decode every dirty character
+//  now rather than when it is first drawn,
+//  splitting the work across a queue if given
+//-------------------------------------------------
+
+void gfx_element::decode_dirty(osd_work_queue *queue)
+{
+	// RAM-based sets may not have a source yet
+	if (m_srcdata == NULL)
+		return;
+
+	// without a queue, or with little to do, decode in place
+	const UINT32 codes_per_range = 256;
+	if (queue == NULL || m_total_elements <= codes_per_range)
+	{
+		for (UINT32 code = 0; code < m_total_elements; code++)
+			if (m_dirty[code])
+				decode(code);
+		return;
+	}
+
+	// each code writes only its own pixels, pen usage and dirty flag, so ranges can't collide
+	std::vector<decode_range> ranges;
+	for (UINT32 start = 0; start < m_total_elements; start += codes_per_range)
+	{
+		decode_range range;
+		range.gfx = this;
+		range.start = start;
+		range.end = MIN(start + codes_per_range, m_total_elements);
+		ranges.push_back(range);
+	}
+	osd_work_item_queue_multiple(queue, decode_range_callback, ranges.size(), &ranges[0], sizeof(ranges[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+	while (!osd_work_queue_wait(queue, osd_ticks_per_second())) { }
+}
+
+
+//-------------------------------------------------
+//  decode_range_callback - decode the dirty codes
+//  in a range on a worker thread
+//-------------------------------------------------
+
+void *gfx_element::decode_range_callback(void *param, int threadid)
+{
+	decode_range &range = *reinterpret_cast<decode_range *>(param);
+	for (UINT32 code = range.start; code < range.end; code++)
+		if (range.gfx->m_dirty[code])
+			range.gfx->decode(code);
+	return NULL;
+}
+
+
 
 /***************************************************************************
     DRAWGFX IMPLEMENTATIONS
@@ -144,6 +144,8 @@ enum
     TYPE DEFINITIONS
 ***************************************************************************/
 
+struct gfx_decode_layout;
+
 class gfx_element
 {
 public:
@@ -182,6 +184,7 @@ public:
 	// operations
 	void mark_dirty(UINT32 code) { if (code < elements()) { m_dirty[code] = 1; m_dirtyseq++; } }
 	void mark_all_dirty() { memset(&m_dirty[0], 1, elements()); }
+	void decode_dirty(osd_work_queue *queue = NULL);
 
 	const UINT8 *get_data(UINT32 code)
 	{
@@ -263,8 +266,19 @@ public:
 	void alphastore(bitmap_rgb32 &dest, const rectangle &cliprect,UINT32 code, UINT32 color, int flipx, int flipy, INT32 destx, INT32 desty,int fixedalpha, UINT8 *alphatable);
 	void alphatable(bitmap_rgb32 &dest, const rectangle &cliprect, UINT32 code, UINT32 color, int flipx, int flipy, INT32 destx, INT32 desty, int fixedalpha ,UINT8 *alphatable);
 private:
+	// a range of codes decoded on a work queue
+	struct decode_range
+	{
+		gfx_element *   gfx;
+		UINT32          start;
+		UINT32          end;
+	};
+
 	// internal helpers
 	void decode(UINT32 code);
+	void classify_layout();
+	void decode_layout(gfx_decode_layout &layout) const;
+	static void *decode_range_callback(void *param, int threadid);
 
 	// internal state
 	palette_device  *m_palette;             // palette used for drawing
@@ -300,6 +314,7 @@ private:
 	std::vector<UINT32>  m_layout_planeoffset;// plane offsets
 	std::vector<UINT32>  m_layout_xoffset; // X offsets
 	std::vector<UINT32>  m_layout_yoffset; // Y offsets
+	UINT8           m_decode_mode;          // gfx_decode_mode for the layout
 };
 
 
@@ -0,0 +1,225 @@
+// license:BSD-3-Clause
+// copyright-holders:Nicola Salmoria, Aaron Giles
+/*********************************************************************
+
+    drawgfxd.c
+
+    Decoding of graphics elements from their layout into one byte
+    per pixel.
+
+    The planar and packed decoders must produce exactly what the
+    generic bit-by-bit decoder does for the layouts they accept.
+
+*********************************************************************/
+
+#include <string.h>
+#include "drawgfxd.h"
+
+
+/***************************************************************************
+    GLOBAL VARIABLES
+***************************************************************************/
+
+// expansion of one byte of a bitplane to 8 pixels of 0 or 1, in memory order
+static UINT64 planar_expand[256];
+static bool planar_expand_valid = false;
+
+
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    readbit - read a single bit from a base
+    offset
+-------------------------------------------------*/
+
+static inline int readbit(const UINT8 *src, unsigned int bitnum)
+{
+	return src[bitnum / 8] & (0x80 >> (bitnum % 8));
+}
+
+
+
+/***************************************************************************
+    LAYOUT CLASSIFICATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    gfx_decode_classify - determine whether the
+    layout matches one of the common forms that
+    can be decoded without going bit by bit
+-------------------------------------------------*/
+
+gfx_decode_mode gfx_decode_classify(const gfx_decode_layout &layout)
+{
+	if (layout.planes == 0)
+		return GFX_DECODE_GENERIC;
+
+	// the character and row offsets must keep the alignment the modes below rely on
+	UINT32 alignbits = layout.charincrement;
+	for (int y = 0; y < layout.height; y++)
+		alignbits |= layout.yoffset[y];
+
+	// packed: each pixel is 4 or 8 consecutive bits, aligned to their size, with plane 0 first
+	if (layout.planes == 4 || layout.planes == 8)
+	{
+		bool packed = ((alignbits | layout.planeoffset[0]) % layout.planes) == 0;
+		for (int p = 1; packed && p < layout.planes; p++)
+			packed = (layout.planeoffset[p] == layout.planeoffset[0] + p);
+		for (int x = 0; packed && x < layout.width; x++)
+			packed = (layout.xoffset[x] % layout.planes) == 0;
+		if (packed)
+			return GFX_DECODE_PACKED;
+	}
+
+	// planar: every plane holds byte-aligned runs of 8 consecutive pixels
+	bool planar = (layout.width % 8) == 0 && (alignbits % 8) == 0;
+	for (int p = 0; planar && p < layout.planes; p++)
+		planar = (layout.planeoffset[p] % 8) == 0;
+	for (int x = 0; planar && x < layout.width; x++)
+		planar = (layout.xoffset[x] == layout.xoffset[x & ~7] + (x & 7)) && (layout.xoffset[x & ~7] % 8) == 0;
+	if (!planar)
+		return GFX_DECODE_GENERIC;
+
+	// build the expansion table the first time it is needed
+	if (!planar_expand_valid)
+	{
+		for (int value = 0; value < 256; value++)
+		{
+			UINT8 pixels[8];
+			for (int bit = 0; bit < 8; bit++)
+				pixels[bit] = (value >> (7 - bit)) & 1;
+			memcpy(&planar_expand[value], pixels, sizeof(pixels));
+		}
+		planar_expand_valid = true;
+	}
+	return GFX_DECODE_PLANAR;
+}
+
+
+
+/***************************************************************************
+    DECODERS
+***************************************************************************/
+
+/*-------------------------------------------------
+    gfx_decode - decode one element with the
+    decoder for the given mode, as long as the xor
+    mask doesn't break up the units it reads
+-------------------------------------------------*/
+
+void gfx_decode(gfx_decode_mode mode, const gfx_decode_layout &layout, UINT32 code, UINT8 *dest)
+{
+	if (mode == GFX_DECODE_PACKED && (layout.xormask % layout.planes) == 0)
+		gfx_decode_packed(layout, code, dest);
+	else if (mode == GFX_DECODE_PLANAR && (layout.xormask % 8) == 0)
+		gfx_decode_planar(layout, code, dest);
+	else
+		gfx_decode_generic(layout, code, dest);
+}
+
+
+/*-------------------------------------------------
+    gfx_decode_generic - decode any layout one bit
+    at a time
+-------------------------------------------------*/
+
+void gfx_decode_generic(const gfx_decode_layout &layout, UINT32 code, UINT8 *dest)
+{
+	// zap the data to 0
+	memset(dest, 0, layout.line_modulo * layout.height);
+
+	// iterate over planes
+	int plane, planebit;
+	for (plane = 0, planebit = 1 << (layout.planes - 1);
+			plane < layout.planes;
+			plane++, planebit >>= 1)
+	{
+		int planeoffs = code * layout.charincrement + layout.planeoffset[plane];
+
+		// iterate over rows
+		for (int y = 0; y < layout.height; y++)
+		{
+			int yoffs = planeoffs + layout.yoffset[y];
+			UINT8 *dp = dest + y * layout.line_modulo;
+
+			// iterate over columns
+			for (int x = 0; x < layout.width; x++)
+				if (readbit(layout.srcdata, (yoffs + layout.xoffset[x]) ^ layout.xormask))
+					dp[x] |= planebit;
+		}
+	}
+}
+
+
+/*-------------------------------------------------
+    gfx_decode_planar - decode an element whose
+    planes are stored as whole bytes of 8 pixels
+-------------------------------------------------*/
+
+void gfx_decode_planar(const gfx_decode_layout &layout, UINT32 code, UINT8 *dest)
+{
+	// zap the data to 0
+	memset(dest, 0, layout.line_modulo * layout.height);
+
+	// iterate over planes
+	int plane, planebit;
+	for (plane = 0, planebit = 1 << (layout.planes - 1);
+			plane < layout.planes;
+			plane++, planebit >>= 1)
+	{
+		UINT32 planeoffs = code * layout.charincrement + layout.planeoffset[plane];
+
+		// iterate over rows
+		for (int y = 0; y < layout.height; y++)
+		{
+			UINT32 yoffs = planeoffs + layout.yoffset[y];
+			UINT8 *dp = dest + y * layout.line_modulo;
+
+			// expand each source byte to 8 pixels at once; each pixel byte is 0 or 1
+			// before scaling, so the multiply can't carry between pixels
+			for (int x = 0; x < layout.width; x += 8)
+			{
+				UINT64 pixels;
+				memcpy(&pixels, &dp[x], sizeof(pixels));
+				pixels |= planar_expand[layout.srcdata[((yoffs + layout.xoffset[x]) ^ layout.xormask) / 8]] * planebit;
+				memcpy(&dp[x], &pixels, sizeof(pixels));
+			}
+		}
+	}
+}
+
+
+/*-------------------------------------------------
+    gfx_decode_packed - decode an element that
+    holds 4 or 8 consecutive bits per pixel
+-------------------------------------------------*/
+
+void gfx_decode_packed(const gfx_decode_layout &layout, UINT32 code, UINT8 *dest)
+{
+	UINT32 baseoffs = code * layout.charincrement + layout.planeoffset[0];
+
+	// iterate over rows
+	for (int y = 0; y < layout.height; y++)
+	{
+		UINT32 yoffs = baseoffs + layout.yoffset[y];
+		UINT8 *dp = dest + y * layout.line_modulo;
+
+		// the first bit of each pixel is plane 0, which is the most significant
+		if (layout.planes == 8)
+		{
+			for (int x = 0; x < layout.width; x++)
+				dp[x] = layout.srcdata[((yoffs + layout.xoffset[x]) ^ layout.xormask) / 8];
+		}
+		else
+		{
+			for (int x = 0; x < layout.width; x++)
+			{
+				UINT32 bitnum = (yoffs + layout.xoffset[x]) ^ layout.xormask;
+				dp[x] = (layout.srcdata[bitnum / 8] >> (~bitnum & 4)) & 0x0f;
+			}
+		}
+	}
+}
@@ -0,0 +1,72 @@
+// license:BSD-3-Clause
+// copyright-holders:Nicola Salmoria, Aaron Giles
+/*********************************************************************
+
+    drawgfxd.h
+
+    Decoding of graphics elements from their layout into one byte
+    per pixel.
+
+*********************************************************************/
+
+#pragma once
+
+#ifndef __DRAWGFXD_H__
+#define __DRAWGFXD_H__
+
+#include "osdcomm.h"
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+// how an element is read from the source data
+enum gfx_decode_mode
+{
+	GFX_DECODE_GENERIC,                     // any layout, one bit at a time
+	GFX_DECODE_PLANAR,                      // byte-aligned runs of 8 pixels per plane
+	GFX_DECODE_PACKED                       // 4 or 8 consecutive bits per pixel
+};
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+// everything the decoders need to know about a (non-raw) layout
+struct gfx_decode_layout
+{
+	const UINT8 *   srcdata;                // source data
+	UINT32          xormask;                // xor mask applied to each bit offset
+	UINT32          charincrement;          // per-character increment in source data
+	int             planes;                 // bit planes, each given by planeoffset
+	const UINT32 *  planeoffset;
+	int             width;                  // pixel width, each column given by xoffset
+	const UINT32 *  xoffset;
+	int             height;                 // pixel height, each row given by yoffset
+	const UINT32 *  yoffset;
+	UINT32          line_modulo;            // bytes between each row of the output
+};
+
+
+/***************************************************************************
+    FUNCTION PROTOTYPES
+***************************************************************************/
+
+// pick the fastest decoder for a layout; the xor mask is not considered
+gfx_decode_mode gfx_decode_classify(const gfx_decode_layout &layout);
+
+// decode one element with the decoder for a mode, falling back to the
+// generic decoder if the xor mask would break up the units it reads
+void gfx_decode(gfx_decode_mode mode, const gfx_decode_layout &layout, UINT32 code, UINT8 *dest);
+
+// the individual decoders; the planar and packed ones require a layout
+// of their mode and an xor mask that is a multiple of 8 or of the plane
+// count respectively
+void gfx_decode_generic(const gfx_decode_layout &layout, UINT32 code, UINT8 *dest);
+void gfx_decode_planar(const gfx_decode_layout &layout, UINT32 code, UINT8 *dest);
+void gfx_decode_packed(const gfx_decode_layout &layout, UINT32 code, UINT8 *dest);
+
+
+#endif  /* __DRAWGFXD_H__ */
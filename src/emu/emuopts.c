@@ -61,6 +61,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_RECORD ";rec",                              NULL,        OPTION_STRING,     "record an input file" },
 	{ OPTION_MNGWRITE,                                   NULL,        OPTION_STRING,     "optional filename to write a MNG movie of the current session" },
 	{ OPTION_AVIWRITE,                                   NULL,        OPTION_STRING,     "optional filename to write an AVI movie of the current session" },
+	{ OPTION_AVIHUFFYUV,                                 "0",         OPTION_BOOLEAN,    "write AVI video as HuffYUV (YUY2, lossy for RGB sources) instead of uncompressed RGB" },
 #ifdef MAME_DEBUG
 	{ OPTION_DUMMYWRITE,                                 "0",         OPTION_BOOLEAN,    "indicates if a snapshot should be created if each frame" },
 #endif
@@ -170,14 +171,26 @@ const options_entry emu_options::s_option_entries[] =
 	// misc options
 	{ NULL,                                              NULL,        OPTION_HEADER,     "CORE MISC OPTIONS" },
 	{ OPTION_DRC,                                        "1",         OPTION_BOOLEAN,    "enable DRC cpu core if available" },
+	{ OPTION_DRC_EXPERIMENTAL,                           "0",         OPTION_BOOLEAN,    "also enable DRC cpu cores not yet validated against their interpreters" },
 	{ OPTION_DRC_USE_C,                                  "0",         OPTION_BOOLEAN,    "force DRC use C backend" },
 	{ OPTION_DRC_LOG_UML,                                "0",         OPTION_BOOLEAN,    "write DRC UML disassembly log" },
 	{ OPTION_DRC_LOG_NATIVE,                             "0",         OPTION_BOOLEAN,    "write DRC native disassembly log" },
+	{ OPTION_DRC_PROFILE,                                "0",         OPTION_BOOLEAN,    "count DRC block executions and write a hot block report on exit" },
+	{ OPTION_DRC_COMPARE,                                "0",         OPTION_BOOLEAN,    "check every recompiled instruction against the interpreter, where supported" },
+	{ OPTION_DRC_BACKGROUND,                             "0",         OPTION_BOOLEAN,    "interpret cold code and compile hot code on a separate thread, where supported" },
+	{ OPTION_M68K_THREADED,                              "0",         OPTION_BOOLEAN,    "cache decoded 68000 and 68010 instructions by address" },
+	{ OPTION_M68K_THREADED_COMPARE,                      "0",         OPTION_BOOLEAN,    "check every cached 68000 instruction against table dispatch" },
 	{ OPTION_BIOS,                                       NULL,        OPTION_STRING,     "select the system BIOS to use" },
 	{ OPTION_CHEAT ";c",                                 "0",         OPTION_BOOLEAN,    "enable cheat subsystem" },
 	{ OPTION_SKIP_GAMEINFO,                              "0",         OPTION_BOOLEAN,    "skip displaying the information screen at startup" },
 	{ OPTION_UI_FONT,                                    "default",   OPTION_STRING,     "specify a font to use" },
 	{ OPTION_RAMSIZE ";ram",                             NULL,        OPTION_STRING,     "size of RAM (if supported by driver)" },
+	{ OPTION_HASH_INDEX,                                 "1",         OPTION_BOOLEAN,    "remember ROM hashes so that unchanged files are not hashed again" },
+	{ OPTION_INFO_INDEX,                                 "0",         OPTION_BOOLEAN,    "answer -listxml, -listroms and -listdevices from a prebuilt index" },
+	{ OPTION_ARCHIVE_CACHE,                              "32",        OPTION_INTEGER,    "number of recently used ZIP and 7z archives to keep indexed in memory" },
+	{ OPTION_SOFTLIST_CACHE,                             "1",         OPTION_BOOLEAN,    "keep a binary cache of each software list in the cfg directory" },
+	{ OPTION_PREDECODE_GFX,                              "1",         OPTION_BOOLEAN,    "decode all graphics at startup on worker threads instead of when first drawn" },
+	{ OPTION_STARTUP_REPORT,                             "0",         OPTION_BOOLEAN,    "report how long each phase of startup took" },
 	{ OPTION_CONFIRM_QUIT,                               "0",         OPTION_BOOLEAN,    "display confirm quit screen on exit" },
 	{ OPTION_UI_MOUSE,                                   "0",         OPTION_BOOLEAN,    "display ui mouse cursor" },
 	{ OPTION_AUTOBOOT_COMMAND ";ab",                     NULL,        OPTION_STRING,     "command to execute after machine boot" },
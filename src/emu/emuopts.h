@@ -73,6 +73,7 @@ enum
 #define OPTION_RECORD               "record"
 #define OPTION_MNGWRITE             "mngwrite"
 #define OPTION_AVIWRITE             "aviwrite"
+#define OPTION_AVIHUFFYUV           "avihuffyuv"
 #ifdef MAME_DEBUG
 #define OPTION_DUMMYWRITE           "dummywrite"
 #endif
@@ -165,14 +166,26 @@ enum
 
 // core misc options
 #define OPTION_DRC                  "drc"
+#define OPTION_DRC_EXPERIMENTAL     "drc_experimental"
 #define OPTION_DRC_USE_C            "drc_use_c"
 #define OPTION_DRC_LOG_UML          "drc_log_uml"
 #define OPTION_DRC_LOG_NATIVE       "drc_log_native"
+#define OPTION_DRC_PROFILE          "drc_profile"
+#define OPTION_DRC_COMPARE          "drc_compare"
+#define OPTION_DRC_BACKGROUND       "drc_background"
+#define OPTION_M68K_THREADED        "m68k_threaded"
+#define OPTION_M68K_THREADED_COMPARE "m68k_threaded_compare"
 #define OPTION_BIOS                 "bios"
 #define OPTION_CHEAT                "cheat"
 #define OPTION_SKIP_GAMEINFO        "skip_gameinfo"
 #define OPTION_UI_FONT              "uifont"
 #define OPTION_RAMSIZE              "ramsize"
+#define OPTION_HASH_INDEX           "hashindex"
+#define OPTION_INFO_INDEX           "infoindex"
+#define OPTION_ARCHIVE_CACHE        "archivecache"
+#define OPTION_SOFTLIST_CACHE       "softlistcache"
+#define OPTION_PREDECODE_GFX        "predecodegfx"
+#define OPTION_STARTUP_REPORT       "startupreport"
 
 // core comm options
 #define OPTION_COMM_LOCAL_HOST      "comm_localhost"
@@ -250,6 +263,7 @@ public:
 	const char *record() const { return value(OPTION_RECORD); }
 	const char *mng_write() const { return value(OPTION_MNGWRITE); }
 	const char *avi_write() const { return value(OPTION_AVIWRITE); }
+	bool avi_huffyuv() const { return bool_value(OPTION_AVIHUFFYUV); }
 #ifdef MAME_DEBUG
 	bool dummy_write() const { return bool_value(OPTION_DUMMYWRITE); }
 #endif
@@ -340,14 +354,26 @@ public:
 
 	// core misc options
 	bool drc() const { return bool_value(OPTION_DRC); }
+	bool drc_experimental() const { return bool_value(OPTION_DRC_EXPERIMENTAL); }
 	bool drc_use_c() const { return bool_value(OPTION_DRC_USE_C); }
 	bool drc_log_uml() const { return bool_value(OPTION_DRC_LOG_UML); }
 	bool drc_log_native() const { return bool_value(OPTION_DRC_LOG_NATIVE); }
+	bool drc_profile() const { return bool_value(OPTION_DRC_PROFILE); }
+	bool drc_compare() const { return bool_value(OPTION_DRC_COMPARE); }
+	bool drc_background() const { return bool_value(OPTION_DRC_BACKGROUND); }
+	bool m68k_threaded() const { return bool_value(OPTION_M68K_THREADED); }
+	bool m68k_threaded_compare() const { return bool_value(OPTION_M68K_THREADED_COMPARE); }
 	const char *bios() const { return value(OPTION_BIOS); }
 	bool cheat() const { return bool_value(OPTION_CHEAT); }
 	bool skip_gameinfo() const { return bool_value(OPTION_SKIP_GAMEINFO); }
 	const char *ui_font() const { return value(OPTION_UI_FONT); }
 	const char *ram_size() const { return value(OPTION_RAMSIZE); }
+	bool hash_index() const { return bool_value(OPTION_HASH_INDEX); }
+	bool info_index() const { return bool_value(OPTION_INFO_INDEX); }
+	int archive_cache() const { return int_value(OPTION_ARCHIVE_CACHE); }
+	bool softlist_cache() const { return bool_value(OPTION_SOFTLIST_CACHE); }
+	bool predecode_gfx() const { return bool_value(OPTION_PREDECODE_GFX); }
+	bool startup_report() const { return bool_value(OPTION_STARTUP_REPORT); }
 
 	// core comm options
 	const char *comm_localhost() const { return value(OPTION_COMM_LOCAL_HOST); }
@@ -12,6 +12,7 @@
 #include "unzip.h"
 #include "un7z.h"
 #include "fileio.h"
+#include "hashidx.h"
 
 
 const UINT32 OPEN_FLAG_HAS_CRC  = 0x10000;
@@ -232,6 +233,27 @@ hash_collection &emu_file::hashes(const char *types)
 	if (needed.empty())
 		return m_hashes;
 
+	// if the hash index has everything we need for this exact file, don't read it at all
+	hash_index *index = hash_index::global();
+	std::string indexpath;
+	UINT64 indexsize = 0, indexmodified = 0;
+	if (index != NULL && !hash_index_identity(indexpath, indexsize, indexmodified))
+		index = NULL;
+	if (index != NULL)
+	{
+		hash_collection known;
+		if (index->find(indexpath.c_str(), m_member.c_str(), indexsize, indexmodified, known))
+		{
+			std::string known_types;
+			known.hash_types(known_types);
+			if (strspn(types, known_types.c_str()) == strlen(types))
+			{
+				m_hashes = known;
+				return m_hashes;
+			}
+		}
+	}
+
 	// load the ZIP file if needed
 	if (compressed_file_ready())
 		return m_hashes;
@@ -240,28 +262,65 @@ hash_collection &emu_file::hashes(const char *types)
 
 	// if we have ZIP data, just hash that directly
 	if (!m__7zdata.empty())
-	{
 		m_hashes.compute(&m__7zdata[0], m__7zdata.size(), needed.c_str());
-		return m_hashes;
-	}
+	else if (!m_zipdata.empty())
+		m_hashes.compute(&m_zipdata[0], m_zipdata.size(), needed.c_str());
 
-	if (!m_zipdata.empty())
+	// otherwise, read the data if we can
+	else
 	{
-		m_hashes.compute(&m_zipdata[0], m_zipdata.size(), needed.c_str());
-		return m_hashes;
-	}
+		const UINT8 *filedata = (const UINT8 *)core_fbuffer(m_file);
+		if (filedata == NULL)
+			return m_hashes;
 
-	// read the data if we can
-	const UINT8 *filedata = (const UINT8 *)core_fbuffer(m_file);
-	if (filedata == NULL)
-		return m_hashes;
+		// compute the hash
+		m_hashes.compute(filedata, core_fsize(m_file), needed.c_str());
+	}
 
-	// compute the hash
-	m_hashes.compute(filedata, core_fsize(m_file), needed.c_str());
+	// remember the result for next time
+	if (index != NULL)
+		index->add(indexpath.c_str(), m_member.c_str(), indexsize, indexmodified, m_hashes);
 	return m_hashes;
 }
 
 
+//-------------------------------------------------
+//  hash_index_identity - determine how the open
+//  file is identified in the hash index; returns
+//  false if it can't be indexed
+//-------------------------------------------------
+
+bool emu_file::hash_index_identity(std::string &path, UINT64 &size, UINT64 &modified)
+{
+	// only files read from disk can be indexed
+	if ((m_openflags & OPEN_FLAG_WRITE) != 0)
+		return false;
+	const char *filename = m_archive.empty() ? m_fullpath.c_str() : m_archive.c_str();
+	if (*filename == 0)
+		return false;
+
+	// archive members are identified by the archive's size and time, so changing any member invalidates them all
+	osd_directory_entry *entry = osd_stat(filename);
+	if (entry == NULL)
+		return false;
+	size = entry->size;
+	modified = entry->last_modified;
+	bool result = (entry->type == ENTTYPE_FILE && modified != 0);
+	osd_free(entry);
+
+	// prefer the full path, so that the index doesn't depend on the working directory
+	char *fullpath;
+	if (result && osd_get_full_path(&fullpath, filename) == FILERR_NONE && fullpath != NULL)
+	{
+		path.assign(fullpath);
+		osd_free(fullpath);
+	}
+	else
+		path.assign(filename);
+	return result;
+}
+
+
 //-------------------------------------------------
 //  open - open a file by searching paths
 //-------------------------------------------------
@@ -419,6 +478,36 @@ void emu_file::close()
 	// reset our hashes and path as well
 	m_hashes.reset();
 	m_fullpath.clear();
+	m_archive.clear();
+	m_member.clear();
+}
+
+
+//-------------------------------------------------
+//  close_and_replace - close a freshly written
+//  file and move it over another one in the same
+//  directory, so that nobody ever sees the other
+//  one half written or truncated
+//-------------------------------------------------
+
+file_error emu_file::close_and_replace(const char *name)
+{
+	assert(m_file != NULL && m_archive.empty() && !m_remove_on_close);
+
+	// the target sits in place of our own name at the end of the full path
+	std::string source(m_fullpath);
+	std::string target(source.substr(0, source.length() - m_filename.length()).append(name));
+	close();
+
+	// rename doesn't replace an existing file everywhere, so remove it and try again if
+	// need be; if that fails too (because the file is in use), the old one stays
+	if (rename(source.c_str(), target.c_str()) == 0)
+		return FILERR_NONE;
+	osd_rmfile(target.c_str());
+	if (rename(source.c_str(), target.c_str()) == 0)
+		return FILERR_NONE;
+	osd_rmfile(source.c_str());
+	return FILERR_FAILURE;
 }
 
 
@@ -709,29 +798,24 @@ file_error emu_file::attempt_zipped()
 			continue;
 
 		// see if we can find a file with the right name and (if available) crc
-		const zip_file_header *header;
-		for (header = zip_file_first_file(zip); header != NULL; header = zip_file_next_file(zip))
-			if (zip_filename_match(*header, filename) && (!(m_openflags & OPEN_FLAG_HAS_CRC) || header->crc == m_crc))
-				break;
+		const zip_file_header *header = zip_file_search(zip, m_crc, filename.c_str(), (m_openflags & OPEN_FLAG_HAS_CRC) != 0, true);
 
 		// if that failed, look for a file with the right crc, but the wrong filename
 		if (header == NULL && (m_openflags & OPEN_FLAG_HAS_CRC))
-			for (header = zip_file_first_file(zip); header != NULL; header = zip_file_next_file(zip))
-				if (header->crc == m_crc && !zip_header_is_path(*header))
-					break;
+			header = zip_file_search(zip, m_crc, filename.c_str(), true, false);
 
 		// if that failed, look for a file with the right name; reporting a bad checksum
 		// is more helpful and less confusing than reporting "rom not found"
 		if (header == NULL)
-			for (header = zip_file_first_file(zip); header != NULL; header = zip_file_next_file(zip))
-				if (zip_filename_match(*header, filename))
-					break;
+			header = zip_file_search(zip, m_crc, filename.c_str(), false, true);
 
 		// if we got it, read the data
 		if (header != NULL)
 		{
 			m_zipfile = zip;
 			m_ziplength = header->uncompressed_length;
+			m_archive.assign(zip->filename);
+			m_member.assign(header->filename, header->filename_length);
 
 			// build a hash with just the CRC
 			m_hashes.reset();
@@ -781,29 +865,6 @@ file_error emu_file::load_zipped_file()
 }
 
 
-//-------------------------------------------------
-//  zip_filename_match - compare zip filename
-//  to expected filename, ignoring any directory
-//-------------------------------------------------
-
-bool emu_file::zip_filename_match(const zip_file_header &header, const std::string &filename)
-{
-	const char *zipfile = header.filename + header.filename_length - filename.length();
-	return (zipfile >= header.filename && core_stricmp(filename.c_str(),zipfile) == 0 && (zipfile == header.filename || zipfile[-1] == '/'));
-}
-
-
-//-------------------------------------------------
-//  zip_header_is_path - check whether filename
-//  in header is a path
-//-------------------------------------------------
-
-bool emu_file::zip_header_is_path(const zip_file_header &header)
-{
-	const char *zipfile = header.filename + header.filename_length - 1;
-	return (zipfile >= header.filename && zipfile[0] == '/');
-}
-
 //-------------------------------------------------
 //  attempt__7zped - attempt to open a .7z file
 //-------------------------------------------------
@@ -861,6 +922,8 @@ file_error emu_file::attempt__7zped()
 		{
 			m__7zfile = _7z;
 			m__7zlength = _7z->uncompressed_length;
+			m_archive.assign(_7z->filename);
+			strprintf(m_member, "#%d", fileno);
 
 			// build a hash with just the CRC
 			m_hashes.reset();
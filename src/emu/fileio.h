@@ -117,6 +117,7 @@ public:
 	file_error open_next();
 	file_error open_ram(const void *data, UINT32 length);
 	void close();
+	file_error close_and_replace(const char *name);
 
 	// control
 	file_error compress(int compress);
@@ -143,12 +144,12 @@ private:
 	// internal helpers
 	file_error attempt_zipped();
 	file_error load_zipped_file();
-	bool zip_filename_match(const zip_file_header &header, const std::string &filename);
-	bool zip_header_is_path(const zip_file_header &header);
 
 	file_error attempt__7zped();
 	file_error load__7zped_file();
 
+	bool hash_index_identity(std::string &path, UINT64 &size, UINT64 &modified);
+
 	// internal state
 	std::string     m_filename;                     // original filename provided
 	std::string     m_fullpath;                     // full filename
@@ -158,6 +159,8 @@ private:
 	UINT32          m_crc;                          // file's CRC
 	UINT32          m_openflags;                    // flags we used for the open
 	hash_collection m_hashes;                       // collection of hashes
+	std::string     m_archive;                      // path of the containing archive, if any
+	std::string     m_member;                       // name of the member within the archive
 
 	zip_file *      m_zipfile;                      // ZIP file pointer
 	dynamic_buffer  m_zipdata;                      // ZIP file data
@@ -0,0 +1,36 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    filestamp.c
+
+    Identification of one version of a file on disk.
+
+***************************************************************************/
+
+#include "filestamp.h"
+
+
+//**************************************************************************
+//  FILE STAMP
+//**************************************************************************
+
+//-------------------------------------------------
+//  read - take the stamp of the file at the
+//  given path
+//-------------------------------------------------
+
+bool file_stamp::read(const char *path)
+{
+	m_path.assign(path);
+	m_size = m_modified = 0;
+
+	osd_directory_entry *entry = osd_stat(path);
+	if (entry == NULL)
+		return false;
+	bool result = (entry->type == ENTTYPE_FILE && entry->last_modified != 0);
+	m_size = entry->size;
+	m_modified = entry->last_modified;
+	osd_free(entry);
+	return result;
+}
@@ -0,0 +1,56 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    filestamp.h
+
+    Identification of one version of a file on disk.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __FILESTAMP_H__
+#define __FILESTAMP_H__
+
+#include "osdcore.h"
+#include <string>
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> file_stamp
+
+// the path, size and modification time of a file, recorded alongside data
+// derived from it so that the data can be thrown away once the file changes
+class file_stamp
+{
+public:
+	// construction/destruction
+	file_stamp() : m_size(0), m_modified(0) { }
+	file_stamp(const char *path, UINT64 size, UINT64 modified) : m_path(path), m_size(size), m_modified(modified) { }
+
+	// read the stamp of a file; returns false if it isn't a plain file, or if the
+	// OSD can't tell when it was modified and so can't tell its versions apart
+	bool read(const char *path);
+
+	// getters
+	const char *path() const { return m_path.c_str(); }
+	UINT64 size() const { return m_size; }
+	UINT64 modified() const { return m_modified; }
+
+	// comparison
+	bool operator==(const file_stamp &rhs) const { return m_size == rhs.m_size && m_modified == rhs.m_modified && m_path.compare(rhs.m_path) == 0; }
+	bool operator!=(const file_stamp &rhs) const { return !(*this == rhs); }
+
+private:
+	// internal state
+	std::string         m_path;
+	UINT64              m_size;
+	UINT64              m_modified;
+};
+
+
+#endif  /* __FILESTAMP_H__ */
@@ -0,0 +1,244 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    hashidx.c
+
+    Persistent index of previously computed file hashes.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "emuopts.h"
+#include "hashidx.h"
+
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// name of the index file within the cfg directory
+#define HASH_INDEX_FILENAME         "hashidx.dat"
+
+// first line of the index file; bump the version if the format changes
+#define HASH_INDEX_HEADER           "# hash index v1"
+
+
+
+//**************************************************************************
+//  GLOBAL VARIABLES
+//**************************************************************************
+
+hash_index *hash_index::s_global = NULL;
+
+
+
+//**************************************************************************
+//  HASH INDEX
+//**************************************************************************
+
+//-------------------------------------------------
+//  hash_index - constructor
+//-------------------------------------------------
+
+hash_index::hash_index()
+	: m_lock(osd_lock_alloc()),
+		m_dirty(false)
+{
+}
+
+
+//-------------------------------------------------
+//  ~hash_index - destructor
+//-------------------------------------------------
+
+hash_index::~hash_index()
+{
+	m_map.reset();
+	m_list.reset();
+	osd_lock_free(m_lock);
+}
+
+
+//-------------------------------------------------
+//  open_global - create the shared index and
+//  load whatever was saved last time
+//-------------------------------------------------
+
+void hash_index::open_global(emu_options &options)
+{
+	// only once, and only if enabled
+	if (s_global != NULL || !options.hash_index())
+		return;
+
+	s_global = global_alloc(hash_index);
+	s_global->m_directory.assign(options.cfg_directory());
+
+	// a missing or unreadable index just means we start from scratch
+	emu_file file(s_global->m_directory.c_str(), OPEN_FLAG_READ);
+	if (file.open(HASH_INDEX_FILENAME) == FILERR_NONE)
+		s_global->load(file);
+}
+
+
+//-------------------------------------------------
+//  close_global - save the shared index if
+//  anything was added, then free it
+//-------------------------------------------------
+
+void hash_index::close_global()
+{
+	if (s_global == NULL)
+		return;
+
+	if (s_global->dirty())
+	{
+		emu_file file(s_global->m_directory.c_str(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+		if (file.open(HASH_INDEX_FILENAME) == FILERR_NONE)
+			s_global->save(file);
+	}
+
+	global_free(s_global);
+	s_global = NULL;
+}
+
+
+//-------------------------------------------------
+//  find - look up the hashes for a file; returns
+//  false if it isn't indexed or has changed since
+//-------------------------------------------------
+
+bool hash_index::find(const char *path, const char *member, UINT64 size, UINT64 modified, hash_collection &hashes)
+{
+	std::string key;
+	make_key(key, path, member);
+
+	osd_lock_acquire(m_lock);
+	entry *found = m_map.find(key.c_str());
+	bool result = (found != NULL && found->m_size == size && found->m_modified == modified);
+	if (result)
+		hashes = found->m_hashes;
+	osd_lock_release(m_lock);
+	return result;
+}
+
+
+//-------------------------------------------------
+//  add - record the hashes for a file, replacing
+//  anything previously recorded for it
+//-------------------------------------------------
+
+void hash_index::add(const char *path, const char *member, UINT64 size, UINT64 modified, const hash_collection &hashes)
+{
+	std::string key;
+	make_key(key, path, member);
+
+	osd_lock_acquire(m_lock);
+	entry *existing = m_map.find(key.c_str());
+	if (existing != NULL)
+	{
+		existing->m_size = size;
+		existing->m_modified = modified;
+		existing->m_hashes = hashes;
+	}
+	else
+	{
+		entry &newentry = m_list.append(*global_alloc(entry(key.c_str(), size, modified, hashes)));
+		m_map.add(newentry.m_key.c_str(), &newentry);
+	}
+	m_dirty = true;
+	osd_lock_release(m_lock);
+}
+
+
+//-------------------------------------------------
+//  load - read an index previously written by
+//  save; malformed lines are skipped
+//-------------------------------------------------
+
+void hash_index::load(emu_file &file)
+{
+	char line[4096];
+
+	// ignore files in any other format
+	if (file.gets(line, ARRAY_LENGTH(line)) == NULL || strncmp(line, HASH_INDEX_HEADER, strlen(HASH_INDEX_HEADER)) != 0)
+		return;
+
+	bool truncated = false;
+	while (file.gets(line, ARRAY_LENGTH(line)) != NULL)
+	{
+		// skip the remainder of any line too long to fit
+		char *eol = strchr(line, '\n');
+		bool was_truncated = truncated;
+		truncated = (eol == NULL && !file.eof());
+		if (was_truncated || truncated)
+			continue;
+
+		// strip the line ending
+		if (eol != NULL)
+			*eol = 0;
+		eol = strchr(line, '\r');
+		if (eol != NULL)
+			*eol = 0;
+
+		// split into size, modified time, hashes and key
+		char *fields[3];
+		char *scan = line;
+		int fieldnum;
+		for (fieldnum = 0; fieldnum < ARRAY_LENGTH(fields); fieldnum++)
+		{
+			char *tab = strchr(scan, '\t');
+			if (tab == NULL)
+				break;
+			*tab = 0;
+			fields[fieldnum] = scan;
+			scan = tab + 1;
+		}
+		if (fieldnum != ARRAY_LENGTH(fields) || strchr(scan, '\t') == NULL)
+			continue;
+
+		UINT64 size, modified;
+		hash_collection hashes;
+		if (sscanf(fields[0], "%" I64FMT "u", &size) != 1 || sscanf(fields[1], "%" I64FMT "u", &modified) != 1 || !hashes.from_internal_string(fields[2]))
+			continue;
+
+		// the key is the path and member, still separated by a tab
+		if (m_map.find(scan) == NULL)
+		{
+			entry &newentry = m_list.append(*global_alloc(entry(scan, size, modified, hashes)));
+			m_map.add(newentry.m_key.c_str(), &newentry);
+		}
+	}
+	m_dirty = false;
+}
+
+
+//-------------------------------------------------
+//  save - write out the whole index
+//-------------------------------------------------
+
+void hash_index::save(emu_file &file)
+{
+	osd_lock_acquire(m_lock);
+	file.printf("%s\n", HASH_INDEX_HEADER);
+
+	std::string hashes;
+	for (entry *curentry = m_list.first(); curentry != NULL; curentry = curentry->next())
+		file.printf("%" I64FMT "u\t%" I64FMT "u\t%s\t%s\n", curentry->m_size, curentry->m_modified, curentry->m_hashes.internal_string(hashes), curentry->m_key.c_str());
+
+	m_dirty = false;
+	osd_lock_release(m_lock);
+}
+
+
+//-------------------------------------------------
+//  make_key - build the key for a file and an
+//  optional archive member
+//-------------------------------------------------
+
+const char *hash_index::make_key(std::string &key, const char *path, const char *member)
+{
+	key.assign(path).append("\t").append((member != NULL) ? member : "");
+	return key.c_str();
+}
@@ -0,0 +1,88 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    hashidx.h
+
+    Persistent index of previously computed file hashes.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __HASHIDX_H__
+#define __HASHIDX_H__
+
+#include "hash.h"
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> hash_index
+
+// records the hashes computed for files on disk along with the size and
+// modification time of the file (or the archive containing it), so that
+// unchanged files don't need to be read and hashed again
+class hash_index
+{
+	DISABLE_COPYING(hash_index);
+
+public:
+	// construction/destruction
+	hash_index();
+	~hash_index();
+
+	// the shared index consulted by emu_file, or NULL if disabled
+	static hash_index *global() { return s_global; }
+	static void open_global(emu_options &options);
+	static void close_global();
+
+	// getters
+	bool dirty() const { return m_dirty; }
+	int count() const { return m_list.count(); }
+
+	// lookups
+	bool find(const char *path, const char *member, UINT64 size, UINT64 modified, hash_collection &hashes);
+	void add(const char *path, const char *member, UINT64 size, UINT64 modified, const hash_collection &hashes);
+
+	// persistence
+	void load(emu_file &file);
+	void save(emu_file &file);
+
+private:
+	// a single indexed file
+	class entry
+	{
+		friend class simple_list<entry>;
+
+	public:
+		entry(const char *key, UINT64 size, UINT64 modified, const hash_collection &hashes)
+			: m_next(NULL), m_key(key), m_size(size), m_modified(modified), m_hashes(hashes) { }
+
+		entry *next() const { return m_next; }
+
+		entry *             m_next;
+		std::string         m_key;              // path and member, separated by a tab
+		UINT64              m_size;             // size of the file or archive on disk
+		UINT64              m_modified;         // modification time of the file or archive
+		hash_collection     m_hashes;           // hashes computed for the file
+	};
+
+	// internal helpers
+	static const char *make_key(std::string &key, const char *path, const char *member);
+
+	// internal state
+	osd_lock *                  m_lock;
+	tagmap_t<entry *, 16381>    m_map;
+	simple_list<entry>          m_list;
+	bool                        m_dirty;
+	std::string                 m_directory;        // directory the index is stored in
+
+	// the shared index
+	static hash_index *         s_global;
+};
+
+
+#endif  /* __HASHIDX_H__ */
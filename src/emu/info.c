@@ -191,6 +191,28 @@ void info_xml_creator::output(FILE *out)
 {
 	m_output = out;
 
+	// output the DTD and open the top level tag
+	output_prologue();
+
+	// iterate through the drivers, outputting one at a time
+	while (m_drivlist.next())
+		output_one();
+
+	// output devices (both devices with roms and slot devices)
+	output_devices();
+
+	// close the top level tag
+	output_epilogue();
+}
+
+
+//-------------------------------------------------
+//  output_prologue - print the DTD and open the
+//  top level tag
+//-------------------------------------------------
+
+void info_xml_creator::output_prologue()
+{
 	// output the DTD
 	fprintf(m_output, "<?xml version=\"1.0\"?>\n");
 	std::string dtd(s_dtd_string);
@@ -211,15 +233,15 @@ void info_xml_creator::output(FILE *out)
 		xml_normalize_string(build_version),
 		CONFIG_VERSION
 	);
+}
 
-	// iterate through the drivers, outputting one at a time
-	while (m_drivlist.next())
-		output_one();
 
-	// output devices (both devices with roms and slot devices)
-	output_devices();
+//-------------------------------------------------
+//  output_epilogue - close the top level tag
+//-------------------------------------------------
 
-	// close the top level tag
+void info_xml_creator::output_epilogue()
+{
 	fprintf(m_output, "</%s>\n",emulator_info::get_xml_root());
 }
 
@@ -382,8 +404,6 @@ void info_xml_creator::output_one_device(device_t &device, const char *devtag)
 //  directly to a driver as device or sub-device)
 //-------------------------------------------------
 
-typedef tagmap_t<FPTR> slot_map;
-
 void info_xml_creator::output_devices()
 {
 	m_drivlist.reset();
@@ -396,10 +416,7 @@ void info_xml_creator::output_devices()
 		for (device_t *device = deviter.first(); device != NULL; device = deviter.next())
 		{
 			if (device->owner() != NULL && device->shortname()!= NULL && strlen(device->shortname())!=0)
-			{
-				if (shortnames.add(device->shortname(), 0, FALSE) != TMERR_DUPLICATE)
-					output_one_device(*device, device->tag());
-			}
+				device_found(shortnames, *device, device->tag());
 		}
 
 		// then, run through slot devices
@@ -418,18 +435,14 @@ void info_xml_creator::output_devices()
 					if (!device->configured())
 						device->config_complete();
 
-				if (shortnames.add(dev->shortname(), 0, FALSE) != TMERR_DUPLICATE)
-					output_one_device(*dev, temptag.c_str());
+				device_found(shortnames, *dev, temptag.c_str());
 
 				// also, check for subdevices with ROMs (a few devices are missed otherwise, e.g. MPU401)
 				device_iterator deviter2(*dev);
 				for (device_t *device = deviter2.first(); device != NULL; device = deviter2.next())
 				{
 					if (device->owner() == dev && device->shortname()!= NULL && strlen(device->shortname())!=0)
-					{
-						if (shortnames.add(device->shortname(), 0, FALSE) != TMERR_DUPLICATE)
-							output_one_device(*device, device->tag());
-					}
+						device_found(shortnames, *device, device->tag());
 				}
 
 				const_cast<machine_config &>(m_drivlist.config()).device_remove(&m_drivlist.config().root_device(), temptag.c_str());
@@ -439,6 +452,19 @@ void info_xml_creator::output_devices()
 }
 
 
+//-------------------------------------------------
+//  device_found - print the XML info for a device
+//  found by output_devices, unless a device with
+//  the same short name was already printed
+//-------------------------------------------------
+
+void info_xml_creator::device_found(slot_map &shortnames, device_t &device, const char *devtag)
+{
+	if (shortnames.add(device.shortname(), 0, FALSE) != TMERR_DUPLICATE)
+		output_one_device(device, devtag);
+}
+
+
 //------------------------------------------------
 //  output_device_roms - when a driver uses roms
 //  included in a device set, print a reference
@@ -26,13 +26,30 @@ class info_xml_creator
 public:
 	// construction/destruction
 	info_xml_creator(driver_enumerator &drivlist);
+	virtual ~info_xml_creator() { }
 
 	// output
 	void output(FILE *out);
 
+protected:
+	typedef tagmap_t<FPTR> slot_map;
+
+	// pieces of the full output, for use by derived classes
+	void output_prologue();
+	void output_epilogue();
+	void output_one();
+	void output_one_device(device_t &device, const char *devtag);
+	void output_devices();
+
+	// called by output_devices for each device it may describe
+	virtual void device_found(slot_map &shortnames, device_t &device, const char *devtag);
+
+	// internal state
+	FILE *                  m_output;
+	driver_enumerator &     m_drivlist;
+
 private:
 	// internal helper
-	void output_one();
 	void output_sampleof();
 	void output_bios();
 	void output_rom(device_t &device);
@@ -51,14 +68,9 @@ private:
 	void output_software_list();
 	void output_ramoptions();
 
-	void output_one_device(device_t &device, const char *devtag);
-	void output_devices();
-
 	const char *get_merge_name(const hash_collection &romhashes);
 
 	// internal state
-	FILE *                  m_output;
-	driver_enumerator &     m_drivlist;
 	emu_options             m_lookup_options;
 
 	static const char s_dtd_string[];
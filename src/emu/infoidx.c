@@ -0,0 +1,766 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    infoidx.c
+
+    Prebuilt index of machine information for the command line queries.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "emuopts.h"
+#include "info.h"
+#include "infoidx.h"
+
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// name of the index file within the cfg directory, and of the file it is written to first
+#define INFO_INDEX_FILENAME         "infoidx.dat"
+#define INFO_INDEX_TEMPNAME         "infoidx.dat.tmp"
+
+// bump the version if the format changes
+static const char s_index_magic[8] = { 'M','A','M','E','I','N','F','O' };
+static const UINT32 INFO_INDEX_VERSION = 3;
+
+// size of the chunks used to copy data out of the index
+static const UINT32 INFO_INDEX_COPY_CHUNK = 65536;
+
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> info_index_builder
+
+// runs the XML generator over every driver, capturing the output for each
+// driver and each distinct device description separately
+class info_index_builder : public info_xml_creator
+{
+public:
+	// construction/destruction
+	info_index_builder(info_index &index, driver_enumerator &drivlist);
+	~info_index_builder();
+
+	// generate everything into the given file
+	void build(FILE *blob);
+
+protected:
+	// info_xml_creator overrides
+	virtual void device_found(slot_map &shortnames, device_t &device, const char *devtag);
+
+private:
+	// internal helpers
+	void begin_extent(info_index::extent &ext) { ext.m_offset = ftell(m_output); }
+	void end_extent(info_index::extent &ext) { ext.m_length = UINT32(ftell(m_output) - ext.m_offset); }
+	bool generate_device(device_t &device, const char *devtag, std::string &text);
+	void write_text(info_index::extent &ext, const std::string &text);
+
+	// internal state
+	info_index &        m_index;
+	FILE *              m_scratch;          // device descriptions are generated here first
+	tagmap_t<FPTR>      m_devmap;           // device index + 1 for each distinct description text
+	tagmap_t<FPTR>      m_driver_shortnames;    // short names already referenced by the current driver
+	int                 m_lastdriver;
+};
+
+
+
+//**************************************************************************
+//  INLINE FUNCTIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  put_u32/put_u64/put_string - append values to
+//  a buffer in little-endian order
+//-------------------------------------------------
+
+inline void put_u32(std::vector<UINT8> &buffer, UINT32 value)
+{
+	for (int byte = 0; byte < 4; byte++)
+		buffer.push_back(UINT8(value >> (8 * byte)));
+}
+
+inline void put_u64(std::vector<UINT8> &buffer, UINT64 value)
+{
+	put_u32(buffer, UINT32(value));
+	put_u32(buffer, UINT32(value >> 32));
+}
+
+inline void put_string(std::vector<UINT8> &buffer, const std::string &value)
+{
+	put_u32(buffer, value.length());
+	buffer.insert(buffer.end(), value.begin(), value.end());
+}
+
+inline void put_string(std::vector<UINT8> &buffer, const char *value)
+{
+	if (value == NULL)
+		put_u32(buffer, ~0);
+	else
+		put_string(buffer, std::string(value));
+}
+
+
+//-------------------------------------------------
+//  get_u32/get_u64/get_string - read values
+//  written by the above
+//-------------------------------------------------
+
+inline bool get_u32(emu_file &file, UINT32 &value)
+{
+	UINT8 buffer[4];
+	if (file.read(buffer, sizeof(buffer)) != sizeof(buffer))
+		return false;
+	value = buffer[0] | (buffer[1] << 8) | (buffer[2] << 16) | (buffer[3] << 24);
+	return true;
+}
+
+inline bool get_u64(emu_file &file, UINT64 &value)
+{
+	UINT32 lo, hi;
+	if (!get_u32(file, lo) || !get_u32(file, hi))
+		return false;
+	value = lo | (UINT64(hi) << 32);
+	return true;
+}
+
+inline bool get_string(emu_file &file, std::string &value)
+{
+	UINT32 length;
+	if (!get_u32(file, length) || length > 65536)
+		return false;
+	value.resize(length);
+	return (length == 0 || file.read(&value[0], length) == length);
+}
+
+
+
+//**************************************************************************
+//  INFO INDEX
+//**************************************************************************
+
+//-------------------------------------------------
+//  info_index - constructor
+//-------------------------------------------------
+
+info_index::info_index(emu_options &options)
+	: m_options(options),
+		m_file(options.cfg_directory(), OPEN_FLAG_READ),
+		m_blob(NULL),
+		m_dataoffset(0)
+{
+}
+
+
+//-------------------------------------------------
+//  ~info_index - destructor
+//-------------------------------------------------
+
+info_index::~info_index()
+{
+	if (m_blob != NULL)
+		fclose(m_blob);
+}
+
+
+//-------------------------------------------------
+//  open - load the index for this build, or
+//  generate it if there isn't one yet; returns
+//  false if the index can't be used
+//-------------------------------------------------
+
+bool info_index::open()
+{
+	// slot options on the command line only apply to the system they name, and describing
+	// a single system directly is cheap anyway, so only lists of systems use the index
+	if (!m_options.info_index() || m_options.system() != NULL)
+		return false;
+	build_key(m_key);
+
+	// use the saved index if it was made by this build
+	if (m_file.open(INFO_INDEX_FILENAME) == FILERR_NONE)
+	{
+		if (load(m_file))
+			return true;
+		m_file.close();
+	}
+
+	// otherwise generate it now and save it for next time
+	if (!build())
+		return false;
+	save();
+	return true;
+}
+
+
+//-------------------------------------------------
+//  text - fetch the text of a query for a single
+//  driver
+//-------------------------------------------------
+
+bool info_index::text(section sect, int drivindex, std::string &result)
+{
+	const extent &source = m_drivers[drivindex].m_section[sect];
+	result.resize(source.m_length);
+	return (source.m_length == 0 || read_data(source, &result[0], 0, source.m_length));
+}
+
+
+//-------------------------------------------------
+//  output_xml - stream the XML for the drivers
+//  in the given list, exactly as info_xml_creator
+//  would print it
+//-------------------------------------------------
+
+bool info_index::output_xml(FILE *out, driver_enumerator &drivlist)
+{
+	if (!copy_data(out, m_prologue))
+		return false;
+
+	// first the drivers themselves
+	drivlist.reset();
+	while (drivlist.next())
+		if (!copy_data(out, m_drivers[drivlist.current()].m_section[SECTION_XML]))
+			return false;
+
+	// then the devices they reference, each short name only once
+	tagmap_t<FPTR> shortnames;
+	drivlist.reset();
+	while (drivlist.next())
+	{
+		const driver_entry &driver = m_drivers[drivlist.current()];
+		for (UINT32 refnum = 0; refnum < driver.m_refcount; refnum++)
+		{
+			const device_entry &device = m_devices[m_refs[driver.m_firstref + refnum]];
+			if (shortnames.add(device.m_shortname.c_str(), 0, FALSE) != TMERR_DUPLICATE && !copy_data(out, device.m_xml))
+				return false;
+		}
+	}
+
+	return copy_data(out, m_epilogue);
+}
+
+
+//-------------------------------------------------
+//  format_roms - describe the ROMs used by a
+//  machine, as printed by -listroms
+//-------------------------------------------------
+
+const char *info_index::format_roms(std::string &result, const machine_config &config)
+{
+	std::string tempstr;
+	result.clear();
+
+	// iterate through roms
+	device_iterator deviter(config.root_device());
+	for (device_t *device = deviter.first(); device != NULL; device = deviter.next())
+		for (const rom_entry *region = rom_first_region(*device); region; region = rom_next_region(region))
+			for (const rom_entry *rom = rom_first_file(region); rom; rom = rom_next_file(rom))
+			{
+				// accumulate the total length of all chunks
+				int length = -1;
+				if (ROMREGION_ISROMDATA(region))
+					length = rom_file_size(rom);
+
+				// start with the name
+				const char *name = ROM_GETNAME(rom);
+				strcatprintf(result, "%-20s ", name);
+
+				// output the length next
+				if (length >= 0)
+					strcatprintf(result, "%7d", length);
+				else
+					result.append("       ");
+
+				// output the hash data
+				hash_collection hashes(ROM_GETHASHDATA(rom));
+				if (!hashes.flag(hash_collection::FLAG_NO_DUMP))
+				{
+					if (hashes.flag(hash_collection::FLAG_BAD_DUMP))
+						result.append(" BAD");
+					strcatprintf(result, " %s", hashes.macro_string(tempstr));
+				}
+				else
+					result.append(" NO GOOD DUMP KNOWN");
+
+				// end with a CR
+				result.append("\n");
+			}
+	return result.c_str();
+}
+
+
+//-------------------------------------------------
+//  format_devices - describe the devices in a
+//  machine, as printed by -listdevices
+//-------------------------------------------------
+
+static int compare_devices(const void *i1, const void *i2)
+{
+	device_t *dev1 = *(device_t **)i1;
+	device_t *dev2 = *(device_t **)i2;
+	return strcmp(dev1->tag(), dev2->tag());
+}
+
+const char *info_index::format_devices(std::string &result, const machine_config &config)
+{
+	result.clear();
+
+	// build a list of devices
+	device_iterator iter(config.root_device());
+	std::vector<device_t *> device_list;
+	for (device_t *device = iter.first(); device != NULL; device = iter.next())
+		device_list.push_back(device);
+
+	// sort them by tag
+	qsort(&device_list[0], device_list.size(), sizeof(device_list[0]), compare_devices);
+
+	// dump the results
+	for (unsigned int index = 0; index < device_list.size(); index++)
+	{
+		device_t *device = device_list[index];
+
+		// extract the tag, stripping the leading colon
+		const char *tag = device->tag();
+		if (*tag == ':')
+			tag++;
+
+		// determine the depth
+		int depth = 1;
+		if (*tag == 0)
+		{
+			tag = "<root>";
+			depth = 0;
+		}
+		else
+		{
+			for (const char *c = tag; *c != 0; c++)
+				if (*c == ':')
+				{
+					tag = c + 1;
+					depth++;
+				}
+		}
+		strcatprintf(result, "   %*s%-*s %s", depth * 2, "", 30 - depth * 2, tag, device->name());
+
+		// add more information
+		UINT32 clock = device->clock();
+		if (clock >= 1000000000)
+			strcatprintf(result, " @ %d.%02d GHz\n", clock / 1000000000, (clock / 10000000) % 100);
+		else if (clock >= 1000000)
+			strcatprintf(result, " @ %d.%02d MHz\n", clock / 1000000, (clock / 10000) % 100);
+		else if (clock >= 1000)
+			strcatprintf(result, " @ %d.%02d kHz\n", clock / 1000, (clock / 10) % 100);
+		else if (clock > 0)
+			strcatprintf(result, " @ %d Hz\n", clock);
+		else
+			result.append("\n");
+	}
+	return result.c_str();
+}
+
+
+//-------------------------------------------------
+//  load - read the tables from a saved index,
+//  rejecting it if it came from another build
+//-------------------------------------------------
+
+bool info_index::load(emu_file &file)
+{
+	// check the header and the build
+	char magic[sizeof(s_index_magic)];
+	UINT32 version, drivercount, devicecount, refcount;
+	std::string key;
+	if (file.read(magic, sizeof(magic)) != sizeof(magic) || memcmp(magic, s_index_magic, sizeof(magic)) != 0)
+		return false;
+	if (!get_u32(file, version) || version != INFO_INDEX_VERSION)
+		return false;
+	if (!get_string(file, key) || key.compare(m_key) != 0)
+		return false;
+	if (!get_u32(file, drivercount) || !get_u32(file, devicecount) || !get_u32(file, refcount) || drivercount != driver_list::total())
+		return false;
+	if (!get_u64(file, m_prologue.m_offset) || !get_u32(file, m_prologue.m_length) || !get_u64(file, m_epilogue.m_offset) || !get_u32(file, m_epilogue.m_length))
+		return false;
+
+	// read the drivers, which must match ours one for one
+	m_drivers.resize(drivercount);
+	for (UINT32 drivnum = 0; drivnum < drivercount; drivnum++)
+	{
+		driver_entry &driver = m_drivers[drivnum];
+		if (!get_string(file, driver.m_name) || driver.m_name.compare(driver_list::driver(drivnum).name) != 0)
+			return false;
+		for (int sect = 0; sect < SECTION_COUNT; sect++)
+			if (!get_u64(file, driver.m_section[sect].m_offset) || !get_u32(file, driver.m_section[sect].m_length))
+				return false;
+		if (!get_u32(file, driver.m_firstref) || !get_u32(file, driver.m_refcount) || UINT64(driver.m_firstref) + driver.m_refcount > refcount)
+			return false;
+	}
+
+	// read the devices
+	m_devices.resize(devicecount);
+	for (UINT32 devnum = 0; devnum < devicecount; devnum++)
+	{
+		device_entry &device = m_devices[devnum];
+		if (!get_string(file, device.m_shortname) || !get_u64(file, device.m_xml.m_offset) || !get_u32(file, device.m_xml.m_length))
+			return false;
+	}
+
+	// read the per-driver device references
+	m_refs.resize(refcount);
+	for (UINT32 refnum = 0; refnum < refcount; refnum++)
+		if (!get_u32(file, m_refs[refnum]) || m_refs[refnum] >= devicecount)
+			return false;
+
+	// the data follows directly, and must all be there
+	m_dataoffset = file.tell();
+	UINT64 datalength = file.size() - m_dataoffset;
+	if (!within(m_prologue, datalength) || !within(m_epilogue, datalength))
+		return false;
+	for (UINT32 drivnum = 0; drivnum < drivercount; drivnum++)
+		for (int sect = 0; sect < SECTION_COUNT; sect++)
+			if (!within(m_drivers[drivnum].m_section[sect], datalength))
+				return false;
+	for (UINT32 devnum = 0; devnum < devicecount; devnum++)
+		if (!within(m_devices[devnum].m_xml, datalength))
+			return false;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  build - generate the index for every driver
+//  into a temporary file
+//-------------------------------------------------
+
+bool info_index::build()
+{
+	m_blob = tmpfile();
+	if (m_blob == NULL)
+		return false;
+
+	m_drivers.clear();
+	m_drivers.resize(driver_list::total());
+	m_devices.clear();
+	m_refs.clear();
+
+	driver_enumerator drivlist(m_options);
+	info_index_builder builder(*this, drivlist);
+	builder.build(m_blob);
+	return (ferror(m_blob) == 0);
+}
+
+
+//-------------------------------------------------
+//  save - write out a freshly built index; the
+//  data stays in the temporary file for use by
+//  this session
+//-------------------------------------------------
+
+bool info_index::save()
+{
+	// assemble the tables
+	std::vector<UINT8> tables;
+	tables.insert(tables.end(), s_index_magic, s_index_magic + sizeof(s_index_magic));
+	put_u32(tables, INFO_INDEX_VERSION);
+	put_string(tables, m_key);
+	put_u32(tables, m_drivers.size());
+	put_u32(tables, m_devices.size());
+	put_u32(tables, m_refs.size());
+	put_u64(tables, m_prologue.m_offset);
+	put_u32(tables, m_prologue.m_length);
+	put_u64(tables, m_epilogue.m_offset);
+	put_u32(tables, m_epilogue.m_length);
+	for (int drivnum = 0; drivnum < m_drivers.size(); drivnum++)
+	{
+		const driver_entry &driver = m_drivers[drivnum];
+		put_string(tables, driver.m_name);
+		for (int sect = 0; sect < SECTION_COUNT; sect++)
+		{
+			put_u64(tables, driver.m_section[sect].m_offset);
+			put_u32(tables, driver.m_section[sect].m_length);
+		}
+		put_u32(tables, driver.m_firstref);
+		put_u32(tables, driver.m_refcount);
+	}
+	for (int devnum = 0; devnum < m_devices.size(); devnum++)
+	{
+		put_string(tables, m_devices[devnum].m_shortname);
+		put_u64(tables, m_devices[devnum].m_xml.m_offset);
+		put_u32(tables, m_devices[devnum].m_xml.m_length);
+	}
+	for (int refnum = 0; refnum < m_refs.size(); refnum++)
+		put_u32(tables, m_refs[refnum]);
+
+	// write the tables followed by the data to a new file, and only replace the
+	// old index with it once it is complete
+	emu_file file(m_options.cfg_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(INFO_INDEX_TEMPNAME) != FILERR_NONE)
+		return false;
+	bool success = (file.write(&tables[0], tables.size()) == tables.size());
+
+	dynamic_buffer chunk(INFO_INDEX_COPY_CHUNK);
+	fseek(m_blob, 0, SEEK_SET);
+	for (size_t bytes = fread(&chunk[0], 1, chunk.size(), m_blob); success && bytes > 0; bytes = fread(&chunk[0], 1, chunk.size(), m_blob))
+		success = (file.write(&chunk[0], bytes) == bytes);
+	if (!success || ferror(m_blob) != 0)
+	{
+		file.remove_on_close();
+		return false;
+	}
+	return (file.close_and_replace(INFO_INDEX_FILENAME) == FILERR_NONE);
+}
+
+
+//-------------------------------------------------
+//  build_key - fingerprint this build: the
+//  version, everything in the driver table down
+//  to the ROM definitions, and where the code of
+//  each driver lies relative to the first, which
+//  moves whenever code between them changes
+//-------------------------------------------------
+
+void info_index::build_key(std::string &result)
+{
+	const game_driver &first = driver_list::driver(0);
+	std::vector<UINT8> buffer;
+	sha1_creator sha1;
+	put_string(buffer, build_version);
+	for (int drivnum = 0; drivnum < driver_list::total(); drivnum++)
+	{
+		const game_driver &driver = driver_list::driver(drivnum);
+		put_string(buffer, driver.source_file);
+		put_string(buffer, driver.parent);
+		put_string(buffer, driver.name);
+		put_string(buffer, driver.description);
+		put_string(buffer, driver.year);
+		put_string(buffer, driver.manufacturer);
+		put_string(buffer, driver.compatible_with);
+		put_string(buffer, driver.default_layout);
+		put_u32(buffer, driver.flags);
+		put_u64(buffer, FPTR(driver.machine_config) - FPTR(first.machine_config));
+		put_u64(buffer, (driver.ipt != NULL) ? FPTR(driver.ipt) - FPTR(first.machine_config) : 0);
+		put_u64(buffer, (driver.driver_init != NULL) ? FPTR(driver.driver_init) - FPTR(first.machine_config) : 0);
+		for (const rom_entry *rom = driver.rom; rom != NULL && !ROMENTRY_ISEND(rom); rom++)
+		{
+			put_string(buffer, rom->_name);
+			put_string(buffer, rom->_hashdata);
+			put_u32(buffer, rom->_offset);
+			put_u32(buffer, rom->_length);
+			put_u32(buffer, rom->_flags);
+		}
+		sha1.append(&buffer[0], buffer.size());
+		buffer.clear();
+	}
+	sha1.finish().as_string(result);
+}
+
+
+//-------------------------------------------------
+//  within - check that a block of data lies
+//  within the data of a loaded index
+//-------------------------------------------------
+
+bool info_index::within(const extent &source, UINT64 datalength)
+{
+	return (source.m_offset <= datalength && source.m_length <= datalength - source.m_offset);
+}
+
+
+//-------------------------------------------------
+//  read_data - read part of a block of data from
+//  wherever the index lives
+//-------------------------------------------------
+
+bool info_index::read_data(const extent &source, void *buffer, UINT32 offset, UINT32 length)
+{
+	if (m_blob != NULL)
+	{
+		if (fseek(m_blob, long(source.m_offset + offset), SEEK_SET) != 0)
+			return false;
+		return (fread(buffer, 1, length, m_blob) == length);
+	}
+
+	if (m_file.seek(m_dataoffset + source.m_offset + offset, SEEK_SET) != 0)
+		return false;
+	return (m_file.read(buffer, length) == length);
+}
+
+
+//-------------------------------------------------
+//  copy_data - copy a block of data from the
+//  index to an output file
+//-------------------------------------------------
+
+bool info_index::copy_data(FILE *out, const extent &source)
+{
+	UINT8 chunk[INFO_INDEX_COPY_CHUNK];
+	for (UINT32 offset = 0; offset < source.m_length; offset += INFO_INDEX_COPY_CHUNK)
+	{
+		UINT32 length = MIN(source.m_length - offset, INFO_INDEX_COPY_CHUNK);
+		if (!read_data(source, chunk, offset, length) || fwrite(chunk, 1, length, out) != length)
+			return false;
+	}
+	return true;
+}
+
+
+
+//**************************************************************************
+//  INFO INDEX BUILDER
+//**************************************************************************
+
+//-------------------------------------------------
+//  info_index_builder - constructor
+//-------------------------------------------------
+
+info_index_builder::info_index_builder(info_index &index, driver_enumerator &drivlist)
+	: info_xml_creator(drivlist),
+		m_index(index),
+		m_scratch(NULL),
+		m_lastdriver(-1)
+{
+}
+
+
+//-------------------------------------------------
+//  ~info_index_builder - destructor
+//-------------------------------------------------
+
+info_index_builder::~info_index_builder()
+{
+	if (m_scratch != NULL)
+		fclose(m_scratch);
+}
+
+
+//-------------------------------------------------
+//  build - generate every section for every
+//  driver, followed by the device descriptions
+//-------------------------------------------------
+
+void info_index_builder::build(FILE *blob)
+{
+	m_output = blob;
+
+	// the parts of the XML that surround the drivers
+	begin_extent(m_index.m_prologue);
+	output_prologue();
+	end_extent(m_index.m_prologue);
+	begin_extent(m_index.m_epilogue);
+	output_epilogue();
+	end_extent(m_index.m_epilogue);
+
+	// then each driver in turn
+	std::string text;
+	m_drivlist.reset();
+	while (m_drivlist.next())
+	{
+		info_index::driver_entry &driver = m_index.m_drivers[m_drivlist.current()];
+		driver.m_name.assign(m_drivlist.driver().name);
+
+		begin_extent(driver.m_section[info_index::SECTION_XML]);
+		output_one();
+		end_extent(driver.m_section[info_index::SECTION_XML]);
+
+		info_index::format_roms(text, m_drivlist.config());
+		write_text(driver.m_section[info_index::SECTION_ROMS], text);
+		info_index::format_devices(text, m_drivlist.config());
+		write_text(driver.m_section[info_index::SECTION_DEVICES], text);
+	}
+
+	// finally, the devices; output_devices calls device_found for each
+	output_devices();
+}
+
+
+//-------------------------------------------------
+//  device_found - record that the current driver
+//  references a device, generating its XML if
+//  this is the first time it has been seen
+//-------------------------------------------------
+
+void info_index_builder::device_found(slot_map &shortnames, device_t &device, const char *devtag)
+{
+	// a short name seen earlier for this driver can never be printed again
+	int drivindex = m_drivlist.current();
+	if (drivindex != m_lastdriver)
+	{
+		m_driver_shortnames.reset();
+		m_lastdriver = drivindex;
+	}
+	if (m_driver_shortnames.add(device.shortname(), 0, FALSE) == TMERR_DUPLICATE)
+		return;
+
+	// the description depends on the driver's configuration (clocks, DIP
+	// and configuration defaults, slot defaults, sample sets), so generate
+	// it and share it only with drivers that produced exactly the same text
+	std::string text;
+	if (!generate_device(device, devtag, text))
+		return;
+	FPTR devnum = m_devmap.find(text.c_str());
+	if (devnum == 0)
+	{
+		info_index::device_entry entry;
+		entry.m_shortname.assign(device.shortname());
+		write_text(entry.m_xml, text);
+		m_index.m_devices.push_back(entry);
+		devnum = m_index.m_devices.size();
+		m_devmap.add(text.c_str(), devnum);
+	}
+
+	// and add it to this driver's references
+	info_index::driver_entry &driver = m_index.m_drivers[drivindex];
+	if (driver.m_refcount == 0)
+		driver.m_firstref = m_index.m_refs.size();
+	m_index.m_refs.push_back(devnum - 1);
+	driver.m_refcount++;
+}
+
+
+//-------------------------------------------------
+//  generate_device - generate the XML for a
+//  device into a string, by way of the scratch
+//  file
+//-------------------------------------------------
+
+bool info_index_builder::generate_device(device_t &device, const char *devtag, std::string &text)
+{
+	if (m_scratch == NULL)
+	{
+		m_scratch = tmpfile();
+		if (m_scratch == NULL)
+			return false;
+	}
+
+	// point the output at the scratch file for the duration
+	FILE *output = m_output;
+	m_output = m_scratch;
+	fseek(m_scratch, 0, SEEK_SET);
+	output_one_device(device, devtag);
+	long length = ftell(m_scratch);
+	m_output = output;
+
+	// and read it back
+	text.resize(length);
+	fseek(m_scratch, 0, SEEK_SET);
+	return (length == 0 || fread(&text[0], 1, length, m_scratch) == size_t(length));
+}
+
+
+//-------------------------------------------------
+//  write_text - write the text of a query to the
+//  data
+//-------------------------------------------------
+
+void info_index_builder::write_text(info_index::extent &ext, const std::string &text)
+{
+	begin_extent(ext);
+	fwrite(text.c_str(), 1, text.length(), m_output);
+	end_extent(ext);
+}
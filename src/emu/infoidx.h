@@ -0,0 +1,111 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    infoidx.h
+
+    Prebuilt index of machine information for the command line queries.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __INFOIDX_H__
+#define __INFOIDX_H__
+
+#include "drivenum.h"
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> info_index
+
+// holds the output of -listxml, -listroms and -listdevices for every driver,
+// generated once per build and saved in the cfg directory, so that later
+// queries for any subset of drivers can be answered without constructing
+// a single machine_config; it is only used when enabled with -infoindex
+class info_index
+{
+	DISABLE_COPYING(info_index);
+
+	friend class info_index_builder;
+
+public:
+	// the queries held in the index
+	enum section
+	{
+		SECTION_XML = 0,
+		SECTION_ROMS,
+		SECTION_DEVICES,
+		SECTION_COUNT
+	};
+
+	// construction/destruction
+	info_index(emu_options &options);
+	~info_index();
+
+	// load the index, building and saving it first if it is missing or stale
+	bool open();
+
+	// queries
+	bool text(section sect, int drivindex, std::string &result);
+	bool output_xml(FILE *out, driver_enumerator &drivlist);
+
+	// formatting of the text queries, shared with the direct path
+	static const char *format_roms(std::string &result, const machine_config &config);
+	static const char *format_devices(std::string &result, const machine_config &config);
+
+private:
+	// a block of data within the index
+	struct extent
+	{
+		extent() : m_offset(0), m_length(0) { }
+
+		UINT64              m_offset;           // offset from the start of the data
+		UINT32              m_length;           // length in bytes
+	};
+
+	// everything recorded for a single driver
+	struct driver_entry
+	{
+		driver_entry() : m_firstref(0), m_refcount(0) { }
+
+		std::string         m_name;             // driver name, to catch mismatched builds
+		extent              m_section[SECTION_COUNT];
+		UINT32              m_firstref;         // first entry in m_refs of the devices it describes
+		UINT32              m_refcount;         // number of entries in m_refs
+	};
+
+	// the XML description of a device, shared between drivers
+	struct device_entry
+	{
+		std::string         m_shortname;        // short name, for removing duplicates
+		extent              m_xml;
+	};
+
+	// internal helpers
+	bool load(emu_file &file);
+	bool build();
+	bool save();
+	bool read_data(const extent &source, void *buffer, UINT32 offset, UINT32 length);
+	bool copy_data(FILE *out, const extent &source);
+	static void build_key(std::string &result);
+	static bool within(const extent &source, UINT64 datalength);
+
+	// internal state
+	emu_options &               m_options;
+	std::string                 m_key;              // fingerprint of the build the index must come from
+	emu_file                    m_file;             // the index on disk, when loaded from there
+	FILE *                      m_blob;             // the data, when freshly built
+	UINT64                      m_dataoffset;       // offset of the data within the file
+	extent                      m_prologue;         // DTD and opening tag of the XML
+	extent                      m_epilogue;         // closing tag of the XML
+	std::vector<driver_entry>   m_drivers;
+	std::vector<device_entry>   m_devices;
+	std::vector<UINT32>         m_refs;             // indexes into m_devices, grouped per driver
+};
+
+
+#endif  /* __INFOIDX_H__ */
@@ -80,6 +80,7 @@
 #include "crsshair.h"
 #include "validity.h"
 #include "unzip.h"
+#include "un7z.h"
 #include "debug/debugcon.h"
 #include "debug/debugvw.h"
 
@@ -146,6 +147,7 @@ running_machine::running_machine(const machine_config &_config, machine_manager
 		m_scheduler(*this)
 {
 	memset(&m_base_time, 0, sizeof(m_base_time));
+	memset(m_startup_ticks, 0, sizeof(m_startup_ticks));
 
 	// set the machine on all devices
 	device_iterator iter(root_device());
@@ -252,8 +254,11 @@ void running_machine::start()
 
 	// first load ROMs, then populate memory, and finally initialize CPUs
 	// these operations must proceed in this order
+	osd_ticks_t phase_start = osd_ticks();
 	rom_init(*this);
+	end_startup_phase(STARTUP_ROMS, phase_start);
 	m_memory.initialize();
+	end_startup_phase(STARTUP_MEMORY, phase_start);
 
 	// initialize the watchdog
 	m_watchdog_timer = m_scheduler.timer_alloc(timer_expired_delegate(FUNC(running_machine::watchdog_fired), this));
@@ -286,7 +291,14 @@ void running_machine::start()
 	add_notifier(MACHINE_NOTIFY_RESET, machine_notify_delegate(FUNC(running_machine::reset_all_devices), this));
 	add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(running_machine::stop_all_devices), this));
 	save().register_presave(save_prepost_delegate(FUNC(running_machine::presave_all_devices), this));
+	phase_start = osd_ticks();
 	start_all_devices();
+	end_startup_phase(STARTUP_DEVICES, phase_start);
+
+	// decode graphics up front now that the driver has finished any decryption
+	if (options().predecode_gfx())
+		decode_all_gfx();
+	end_startup_phase(STARTUP_GFX, phase_start);
 	save().register_postload(save_prepost_delegate(FUNC(running_machine::postload_all_devices), this));
 
 	// if we're coming in with a savegame request, process it now
@@ -339,6 +351,7 @@ int running_machine::run(bool firstrun)
 	{
 		// move to the init phase
 		m_current_phase = MACHINE_PHASE_INIT;
+		osd_ticks_t run_start = osd_ticks();
 
 		// if we have a logfile, set up the callback
 		if (options().log())
@@ -353,6 +366,7 @@ int running_machine::run(bool firstrun)
 		start();
 
 		// load the configuration settings and NVRAM
+		osd_ticks_t phase_start = osd_ticks();
 		config_load_settings(*this);
 
 		// disallow save state registrations starting here.
@@ -361,6 +375,7 @@ int running_machine::run(bool firstrun)
 		m_save.allow_registration(false);
 
 		nvram_load();
+		end_startup_phase(STARTUP_SETTINGS, phase_start);
 		sound().ui_mute(false);
 
 		// initialize ui lists
@@ -372,6 +387,10 @@ int running_machine::run(bool firstrun)
 		// perform a soft reset -- this takes us to the running phase
 		soft_reset();
 
+		// report where the startup time went if requested
+		if (options().startup_report())
+			startup_report(osd_ticks() - run_start);
+
 #ifdef MAME_DEBUG
 		g_tagmap_finds = 0;
 		if (strcmp(config().m_gamedrv.name, "___empty") != 0)
@@ -475,6 +494,7 @@ int running_machine::run(bool firstrun)
 	// call all exit callbacks registered
 	call_notifiers(MACHINE_NOTIFY_EXIT);
 	zip_file_cache_clear();
+	_7z_file_cache_clear();
 
 	// close the logfile
 	m_logfile.reset();
@@ -1125,6 +1145,93 @@ void running_machine::start_all_devices()
 }
 
 
+//-------------------------------------------------
+//  decode_all_gfx - decode every graphics set
+//  across the worker threads, rather than one
+//  character at a time as they are first drawn
+//-------------------------------------------------
+
+void running_machine::decode_all_gfx()
+{
+	osd_ticks_t start = osd_ticks();
+	osd_work_queue *queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	UINT64 elements = 0, pixels = 0;
+
+	gfx_interface_iterator iter(root_device());
+	for (device_gfx_interface *gfxintf = iter.first(); gfxintf != NULL; gfxintf = iter.next())
+		for (int index = 0; index < MAX_GFX_ELEMENTS; index++)
+		{
+			gfx_element *gfx = gfxintf->gfx(index);
+			if (gfx != NULL)
+			{
+				gfx->decode_dirty(queue);
+				elements += gfx->elements();
+				pixels += UINT64(gfx->elements()) * gfx->width() * gfx->height();
+			}
+		}
+
+	if (queue != NULL)
+		osd_work_queue_free(queue);
+
+	// report the throughput, as a measure of the decoders
+	double seconds = double(osd_ticks() - start) / double(osd_ticks_per_second());
+	if (elements != 0)
+		osd_printf_verbose("Decoded %d graphics elements (%.1f Mpixels) in %.3f seconds, %.1f Mpixels/s\n",
+				int(elements), double(pixels) / 1e6, seconds, (seconds > 0) ? double(pixels) / 1e6 / seconds : 0.0);
+}
+
+
+//-------------------------------------------------
+//  end_startup_phase - account the time since
+//  start to a phase of startup, and restart the
+//  clock for the next one
+//-------------------------------------------------
+
+void running_machine::end_startup_phase(startup_phase phase, osd_ticks_t &start)
+{
+	osd_ticks_t now = osd_ticks();
+	m_startup_ticks[phase] += now - start;
+	start = now;
+}
+
+
+//-------------------------------------------------
+//  startup_report - print how long each phase of
+//  startup took
+//-------------------------------------------------
+
+void running_machine::startup_report(osd_ticks_t total)
+{
+	static const char *const phase_names[STARTUP_PHASE_COUNT] =
+	{
+		"ROM loading",
+		"memory map population",
+		"device start",
+		"graphics decoding",
+		"settings and NVRAM"
+	};
+
+	// the configuration was built before we existed, so count it separately
+	double msec = 1000.0 / double(osd_ticks_per_second());
+	osd_ticks_t accounted = m_config.build_ticks();
+	device_iterator iter(root_device());
+
+	osd_printf_info("Startup timing for %s:\n", basename());
+	osd_printf_info("  %-26s %9.2f ms  (%d devices)\n", "machine configuration", double(m_config.build_ticks()) * msec, iter.count());
+	for (int phase = 0; phase < STARTUP_PHASE_COUNT; phase++)
+	{
+		osd_printf_info("  %-26s %9.2f ms\n", phase_names[phase], double(m_startup_ticks[phase]) * msec);
+		accounted += m_startup_ticks[phase];
+	}
+	total += m_config.build_ticks();
+	osd_printf_info("  %-26s %9.2f ms\n", "other", double((total > accounted) ? total - accounted : 0) * msec);
+	osd_printf_info("  %-26s %9.2f ms\n", "total", double(total) * msec);
+
+	// registration happens throughout device start, so it is already counted above
+	osd_printf_info("  %-26s %9.2f ms  (%d items, included above)\n", "save state registration", double(m_save.registration_ticks()) * msec, m_save.registration_count());
+}
+
+
 //-------------------------------------------------
 //  reset_all_devices - reset all devices in the
 //  hierarchy
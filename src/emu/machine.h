@@ -273,6 +273,20 @@ private:
 	void stop_all_devices();
 	void presave_all_devices();
 	void postload_all_devices();
+	void decode_all_gfx();
+
+	// startup timing helpers
+	enum startup_phase
+	{
+		STARTUP_ROMS = 0,
+		STARTUP_MEMORY,
+		STARTUP_DEVICES,
+		STARTUP_GFX,
+		STARTUP_SETTINGS,
+		STARTUP_PHASE_COUNT
+	};
+	void end_startup_phase(startup_phase phase, osd_ticks_t &start);
+	void startup_report(osd_ticks_t total);
 
 	TIMER_CALLBACK_MEMBER(autoboot_callback);
 
@@ -310,6 +324,7 @@ private:
 	std::string             m_context;              // context string buffer
 	int                     m_sample_rate;          // the digital audio sample rate
 	auto_pointer<emu_file>  m_logfile;              // pointer to the active log file
+	osd_ticks_t             m_startup_ticks[STARTUP_PHASE_COUNT]; // time spent in each phase of startup
 
 	// load/save management
 	enum saveload_schedule
@@ -28,8 +28,11 @@ machine_config::machine_config(const game_driver &gamedrv, emu_options &options)
 		m_force_no_drc(false),
 		m_default_layout(NULL),
 		m_gamedrv(gamedrv),
-		m_options(options)
+		m_options(options),
+		m_build_ticks(0)
 {
+	osd_ticks_t start = osd_ticks();
+
 	// construct the config
 	(*gamedrv.machine_config)(*this, NULL, NULL);
 
@@ -78,6 +81,8 @@ machine_config::machine_config(const game_driver &gamedrv, emu_options &options)
 	for (device_t *device = iter.first(); device != NULL; device = iter.next())
 		if (!device->configured())
 			device->config_complete();
+
+	m_build_ticks = osd_ticks() - start;
 }
 
 
@@ -54,6 +54,7 @@ public:
 	device_t &root_device() const { assert(m_root_device != NULL); return *m_root_device; }
 	screen_device *first_screen() const;
 	emu_options &options() const { return m_options; }
+	osd_ticks_t build_ticks() const { return m_build_ticks; }
 	inline device_t *device(const char *tag) const { return root_device().subdevice(tag); }
 	template<class _DeviceClass> inline _DeviceClass *device(const char *tag) const { return downcast<_DeviceClass *>(device(tag)); }
 
@@ -78,6 +79,7 @@ private:
 	const game_driver &     m_gamedrv;
 	emu_options &           m_options;
 	auto_pointer<device_t>  m_root_device;
+	osd_ticks_t             m_build_ticks;              // time taken to construct the configuration
 };
 
 
@@ -1556,6 +1556,9 @@ void memory_manager::initialize()
 	// register a callback to reset banks when reloading state
 	machine().save().register_postload(save_prepost_delegate(FUNC(memory_manager::bank_reattach), this));
 
+	// report direct access statistics on the way out
+	machine().add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(memory_manager::exit), this));
+
 	// dump the final memory configuration
 	generate_memdump(machine());
 
@@ -1616,6 +1619,11 @@ osd_printf_verbose("Region '%s' created\n", name);
 
 void memory_manager::region_free(const char *name)
 {
+	// forget any lookups of it the devices have cached
+	device_iterator iter(machine().root_device());
+	for (device_t *device = iter.first(); device != NULL; device = iter.next())
+		device->m_region_map.reset();
+
 	m_regionlist.remove(name);
 }
 
@@ -1638,6 +1646,23 @@ static void generate_memdump(running_machine &machine)
 }
 
 
+//-------------------------------------------------
+//  exit - report how often each space had to
+//  look up a new direct access region
+//-------------------------------------------------
+
+void memory_manager::exit()
+{
+	for (address_space *space = m_spacelist.first(); space != NULL; space = space->next())
+	{
+		const direct_read_data &direct = space->direct();
+		if (direct.misses() != 0)
+			osd_printf_verbose("Direct access for '%s' %s: %" I64FMT "u region misses, %" I64FMT "u served from the region cache\n",
+					space->device().tag(), space->name(), direct.misses(), direct.cache_hits());
+	}
+}
+
+
 //-------------------------------------------------
 //  bank_reattach - reconnect banks after a load
 //-------------------------------------------------
@@ -2170,6 +2195,19 @@ const char *address_space::get_handler_string(read_or_write readorwrite, offs_t
 }
 
 
+//-------------------------------------------------
+//  get_handler_range - return the range of
+//  addresses around a particular offset that are
+//  served by the same handler, without mirrors
+//-------------------------------------------------
+
+void address_space::get_handler_range(read_or_write readorwrite, offs_t byteaddress, offs_t &bytestart, offs_t &byteend)
+{
+	const address_table &table = (readorwrite == ROW_READ) ? static_cast<address_table &>(read()) : static_cast<address_table &>(write());
+	table.derive_range(byteaddress & m_bytemask, bytestart, byteend);
+}
+
+
 //-------------------------------------------------
 //  dump_map - dump the contents of a single
 //  address space
@@ -3658,8 +3696,13 @@ direct_read_data::direct_read_data(address_space &space)
 		m_bytemask(space.bytemask()),
 		m_bytestart(1),
 		m_byteend(0),
-		m_entry(STATIC_UNMAP)
+		m_baseoffset(0),
+		m_entry(STATIC_UNMAP),
+		m_cachenext(0),
+		m_misses(0),
+		m_cache_hits(0)
 {
+	invalidate_cache();
 }
 
 
@@ -3679,6 +3722,8 @@ direct_read_data::~direct_read_data()
 
 bool direct_read_data::set_direct_region(offs_t &byteaddress)
 {
+	m_misses++;
+
 	// allow overrides
 	offs_t overrideaddress = byteaddress;
 	if (!m_directupdate.isnull())
@@ -3690,6 +3735,26 @@ bool direct_read_data::set_direct_region(offs_t &byteaddress)
 		byteaddress = overrideaddress;
 	}
 
+	// otherwise, see if we've recently used a bank region covering this address
+	else
+	{
+		for (int index = 0; index < CACHE_ENTRIES; index++)
+		{
+			const cache_entry &cached = m_cache[index];
+			if (byteaddress >= cached.m_bytestart && byteaddress <= cached.m_byteend)
+			{
+				m_cache_hits++;
+				m_entry = cached.m_entry;
+				m_bytemask = cached.m_bytemask;
+				m_baseoffset = cached.m_baseoffset;
+				m_ptr = *m_space.manager().bank_pointer_addr(m_entry) - m_baseoffset;
+				m_bytestart = cached.m_bytestart;
+				m_byteend = cached.m_byteend;
+				return true;
+			}
+		}
+	}
+
 	// remove the masked bits (we'll put them back later)
 	offs_t maskedbits = overrideaddress & ~m_bytemask;
 
@@ -3710,13 +3775,73 @@ bool direct_read_data::set_direct_region(offs_t &byteaddress)
 	// compute the adjusted base
 	const handler_entry_read &handler = m_space.read().handler_read(m_entry);
 	m_bytemask = handler.bytemask();
-	m_ptr = base - (handler.bytestart() & m_bytemask);
+	m_baseoffset = handler.bytestart() & m_bytemask;
+	m_ptr = base - m_baseoffset;
 	m_bytestart = maskedbits | range->m_bytestart;
 	m_byteend = maskedbits | range->m_byteend;
+
+	// remember the region, unless a custom handler may be redirecting us
+	if (m_directupdate.isnull())
+	{
+		cache_entry &cached = m_cache[m_cachenext];
+		m_cachenext = (m_cachenext + 1) % CACHE_ENTRIES;
+		cached.m_bytestart = m_bytestart;
+		cached.m_byteend = m_byteend;
+		cached.m_bytemask = m_bytemask;
+		cached.m_baseoffset = m_baseoffset;
+		cached.m_entry = m_entry;
+	}
 	return true;
 }
 
 
+//-------------------------------------------------
+//  bank_changed - called when a bank referenced
+//  by our space gets a new base pointer
+//-------------------------------------------------
+
+void direct_read_data::bank_changed(UINT16 entry)
+{
+	// custom update handlers may configure the region themselves, so let them see the change
+	if (!m_directupdate.isnull())
+	{
+		force_update();
+		return;
+	}
+
+	// cached regions pick up the new base when they are next used; repoint the live one now
+	if (m_entry == entry)
+		m_ptr = *m_space.manager().bank_pointer_addr(entry) - m_baseoffset;
+}
+
+
+//-------------------------------------------------
+//  invalidate_cache - forget recently used bank
+//  regions, either all of them or only those
+//  for a given entry
+//-------------------------------------------------
+
+void direct_read_data::invalidate_cache()
+{
+	for (int index = 0; index < CACHE_ENTRIES; index++)
+	{
+		m_cache[index].m_bytestart = 1;
+		m_cache[index].m_byteend = 0;
+		m_cache[index].m_entry = STATIC_UNMAP;
+	}
+}
+
+void direct_read_data::invalidate_cache(UINT16 entry)
+{
+	for (int index = 0; index < CACHE_ENTRIES; index++)
+		if (m_cache[index].m_entry == entry)
+		{
+			m_cache[index].m_bytestart = 1;
+			m_cache[index].m_byteend = 0;
+		}
+}
+
+
 //-------------------------------------------------
 //  find_range - find a byte address in a range
 //-------------------------------------------------
@@ -3754,6 +3879,9 @@ direct_read_data::direct_range *direct_read_data::find_range(offs_t byteaddress,
 
 void direct_read_data::remove_intersecting_ranges(offs_t bytestart, offs_t byteend)
 {
+	// the mapping is changing, so recently used regions can't be trusted
+	invalidate_cache();
+
 	// loop over all entries
 	for (int entry = 0; entry < ARRAY_LENGTH(m_rangelist); entry++)
 	{
@@ -3943,15 +4071,15 @@ void memory_bank::add_reference(address_space &space, read_or_write readorwrite)
 
 
 //-------------------------------------------------
-//  invalidate_references - force updates on all
-//  referencing address spaces
+//  invalidate_references - update direct access
+//  on all referencing address spaces
 //-------------------------------------------------
 
 void memory_bank::invalidate_references()
 {
-	// invalidate all the direct references to any referenced address spaces
+	// repoint the direct references of any referenced address spaces
 	for (bank_reference *ref = m_reflist.first(); ref != NULL; ref = ref->next())
-		ref->space().direct().force_update();
+		ref->space().direct().bank_changed(m_index);
 }
 
 
@@ -168,13 +168,18 @@ public:
 	// getters
 	address_space &space() const { return m_space; }
 	UINT8 *ptr() const { return m_ptr; }
+	UINT64 misses() const { return m_misses; }
+	UINT64 cache_hits() const { return m_cache_hits; }
 
 	// see if an address is within bounds, or attempt to update it if not
 	bool address_is_valid(offs_t byteaddress) { return EXPECTED(byteaddress >= m_bytestart && byteaddress <= m_byteend) || set_direct_region(byteaddress); }
 
 	// force a recomputation on the next read
-	void force_update() { m_byteend = 0; m_bytestart = 1; }
-	void force_update(UINT16 if_match) { if (m_entry == if_match) force_update(); }
+	void force_update() { m_byteend = 0; m_bytestart = 1; invalidate_cache(); }
+	void force_update(UINT16 if_match) { if (m_entry == if_match) { m_byteend = 0; m_bytestart = 1; } invalidate_cache(if_match); }
+
+	// repoint any regions using a bank whose base has changed
+	void bank_changed(UINT16 entry);
 
 	// custom update callbacks and configuration
 	direct_update_delegate set_direct_update(direct_update_delegate function);
@@ -188,10 +193,24 @@ public:
 	UINT64 read_qword(offs_t byteaddress, offs_t directxor = 0);
 
 private:
+	// a cache_entry remembers a recently used bank region so hopping back to it is cheap
+	struct cache_entry
+	{
+		offs_t                  m_bytestart;            // minimum valid byte address
+		offs_t                  m_byteend;              // maximum valid byte address
+		offs_t                  m_bytemask;             // byte address mask
+		offs_t                  m_baseoffset;           // offset of the bank base within the region
+		UINT16                  m_entry;                // bank entry
+	};
+
+	static const int CACHE_ENTRIES = 4;
+
 	// internal helpers
 	bool set_direct_region(offs_t &byteaddress);
 	direct_range *find_range(offs_t byteaddress, UINT16 &entry);
 	void remove_intersecting_ranges(offs_t bytestart, offs_t byteend);
+	void invalidate_cache();
+	void invalidate_cache(UINT16 entry);
 
 	// internal state
 	address_space &             m_space;
@@ -199,7 +218,12 @@ private:
 	offs_t                      m_bytemask;             // byte address mask
 	offs_t                      m_bytestart;            // minimum valid byte address
 	offs_t                      m_byteend;              // maximum valid byte address
+	offs_t                      m_baseoffset;           // offset of the bank base within the live region
 	UINT16                      m_entry;                // live entry
+	cache_entry                 m_cache[CACHE_ENTRIES]; // recently used bank regions
+	int                         m_cachenext;            // next cache entry to replace
+	UINT64                      m_misses;               // number of times the live region did not match
+	UINT64                      m_cache_hits;           // number of misses satisfied from the cache
 	simple_list<direct_range>   m_rangelist[TOTAL_MEMORY_BANKS];  // list of ranges for each entry
 	simple_list<direct_range>   m_freerangelist;        // list of recycled range entries
 	direct_update_delegate      m_directupdate;         // fast direct-access update callback
@@ -307,6 +331,7 @@ public:
 	virtual void accessors(data_accessors &accessors) const = 0;
 	virtual void *get_read_ptr(offs_t byteaddress) = 0;
 	virtual void *get_write_ptr(offs_t byteaddress) = 0;
+	void get_handler_range(read_or_write readorwrite, offs_t byteaddress, offs_t &bytestart, offs_t &byteend);
 
 	// read accessors
 	virtual UINT8 read_byte(offs_t byteaddress) = 0;
@@ -750,6 +775,7 @@ private:
 	memory_region *region(const char *tag) { return m_regionlist.find(tag); }
 	memory_share *shared(const char *tag) { return m_sharelist.find(tag); }
 	void bank_reattach();
+	void exit();
 
 	// internal state
 	running_machine &           m_machine;              // reference to the machine
@@ -11,6 +11,7 @@
 #include "emuopts.h"
 #include "drivenum.h"
 #include "png.h"
+#include "un7z.h"
 #include "chd.h"
 #include "config.h"
 #include "ui/ui.h"
@@ -26,6 +27,9 @@
 
 #define TEMPBUFFER_MAX_SIZE     (1024 * 1024 * 1024)
 
+/* how far ahead of the loader ROM files are opened, read and hashed */
+#define PREFETCH_MAX_BYTES      (256 * 1024 * 1024)
+
 
 
 /***************************************************************************
@@ -55,6 +59,28 @@ private:
 };
 
 
+/* a ROM file opened, read and hashed on a worker thread ahead of the loader */
+struct rom_prefetch
+{
+	running_machine *   machine;            /* machine we're loading for */
+	const char *        regiontag;          /* location tag used to search for the file */
+	const rom_entry *   romp;               /* the ROM being looked for */
+	osd_work_item *     item;               /* work item, or NULL if not queued yet */
+	emu_file *          file;               /* the file, or NULL if it wasn't found */
+	file_error          filerr;             /* result of the last attempt to open it */
+	bool                clone_of_clone;     /* the region tag names an unsupported clone of a clone */
+	std::string         tried_file_names;   /* places we looked */
+};
+
+
+/* a region needing inversion or byte swapping after loading */
+struct region_fixup
+{
+	memory_region *     region;             /* the region */
+	bool                invert;             /* invert the data as well */
+};
+
+
 struct romload_private
 {
 	running_machine &machine() const { assert(m_machine != NULL); return *m_machine; }
@@ -77,6 +103,12 @@ struct romload_private
 
 	std::string     errorstring;        /* error string */
 	std::string     softwarningstring;  /* software warning string */
+
+	osd_work_queue *prefetch_queue;     /* queue for reading ROM files ahead of time */
+	std::vector<rom_prefetch *> prefetch; /* files to read ahead, in loading order */
+	int             prefetch_next;      /* next entry the loader will ask for */
+	int             prefetch_queued;    /* next entry to be queued */
+	UINT64          prefetch_bytes;     /* bytes queued but not yet asked for */
 };
 
 
@@ -85,6 +117,8 @@ struct romload_private
 ***************************************************************************/
 
 static void rom_exit(running_machine &machine);
+static void *prefetch_rom_file(void *param, int threadid);
+static void *region_fixup_callback(void *param, int threadid);
 
 /***************************************************************************
     HELPERS (also used by devimage.c)
@@ -575,14 +609,13 @@ static void display_rom_load_results(romload_private *romdata, bool from_list)
 
 /*-------------------------------------------------
     region_post_process - post-process a region,
-    byte swapping and inverting data as necessary
+    noting whether it needs byte swapping or
+    inverting
 -------------------------------------------------*/
 
-static void region_post_process(romload_private *romdata, const char *rgntag, bool invert)
+static void region_post_process(romload_private *romdata, std::vector<region_fixup> &fixups, const char *rgntag, bool invert)
 {
 	memory_region *region = romdata->machine().root_device().memregion(rgntag);
-	UINT8 *base;
-	int i, j;
 
 	// do nothing if no region
 	if (region == NULL)
@@ -591,10 +624,55 @@ static void region_post_process(romload_private *romdata, const char *rgntag, bo
 	LOG(("+ datawidth=%dbit endian=%s\n", region->bitwidth(),
 			region->endianness() == ENDIANNESS_LITTLE ? "little" : "big"));
 
+	/* queue up the region if it needs inverting or swapping */
+	if (invert || (region->bytewidth() > 1 && region->endianness() != ENDIANNESS_NATIVE))
+	{
+		region_fixup fixup;
+		fixup.region = region;
+		fixup.invert = invert;
+		fixups.push_back(fixup);
+	}
+}
+
+
+/*-------------------------------------------------
+    process_region_fixups - invert and byte swap
+    the regions collected by region_post_process,
+    in parallel where possible
+-------------------------------------------------*/
+
+static void process_region_fixups(romload_private *romdata, std::vector<region_fixup> &fixups)
+{
+	if (fixups.empty())
+		return;
+
+	/* each region is independent of the others */
+	if (romdata->prefetch_queue != NULL && fixups.size() > 1)
+	{
+		osd_work_item_queue_multiple(romdata->prefetch_queue, region_fixup_callback, fixups.size(), &fixups[0], sizeof(fixups[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		while (!osd_work_queue_wait(romdata->prefetch_queue, osd_ticks_per_second())) { }
+	}
+	else
+		for (int fixupnum = 0; fixupnum < fixups.size(); fixupnum++)
+			region_fixup_callback(&fixups[fixupnum], 0);
+}
+
+
+/*-------------------------------------------------
+    region_fixup_callback - invert and byte swap
+    a single region
+-------------------------------------------------*/
+
+static void *region_fixup_callback(void *param, int threadid)
+{
+	region_fixup &fixup = *reinterpret_cast<region_fixup *>(param);
+	memory_region *region = fixup.region;
+	UINT8 *base;
+	int i, j;
+
 	/* if the region is inverted, do that now */
-	if (invert)
+	if (fixup.invert)
 	{
-		LOG(("+ Inverting region\n"));
 		for (i = 0, base = region->base(); i < region->bytes(); i++)
 			*base++ ^= 0xff;
 	}
@@ -602,7 +680,6 @@ static void region_post_process(romload_private *romdata, const char *rgntag, bo
 	/* swap the endianness if we need to */
 	if (region->bytewidth() > 1 && region->endianness() != ENDIANNESS_NATIVE)
 	{
-		LOG(("+ Byte swapping region\n"));
 		int datawidth = region->bytewidth();
 		for (i = 0, base = region->base(); i < region->bytes(); i += datawidth)
 		{
@@ -612,22 +689,28 @@ static void region_post_process(romload_private *romdata, const char *rgntag, bo
 				*base++ = temp[j];
 		}
 	}
+	return NULL;
 }
 
 
 /*-------------------------------------------------
-    open_rom_file - open a ROM file, searching
-    up the parent and loading by checksum
+    locate_rom_file - search for a ROM file up the
+    parent chain and in the locations given by the
+    region tag, loading by checksum where possible;
+    safe to call from any thread
 -------------------------------------------------*/
 
-static int open_rom_file(romload_private *romdata, const char *regiontag, const rom_entry *romp, std::string &tried_file_names, bool from_list)
+static void locate_rom_file(rom_prefetch &prefetch)
 {
-	file_error filerr = FILERR_NOT_FOUND;
-	UINT32 romsize = rom_file_size(romp);
-	tried_file_names = "";
+	running_machine &machine = *prefetch.machine;
+	const char *regiontag = prefetch.regiontag;
+	const rom_entry *romp = prefetch.romp;
+	std::string &tried_file_names = prefetch.tried_file_names;
+	emu_file *&file = prefetch.file;
+	file_error &filerr = prefetch.filerr;
 
-	/* update status display */
-	display_loading_rom_message(romdata, ROM_GETNAME(romp), from_list);
+	filerr = FILERR_NOT_FOUND;
+	tried_file_names = "";
 
 	/* extract CRC to use for searching */
 	UINT32 crc = 0;
@@ -635,16 +718,16 @@ static int open_rom_file(romload_private *romdata, const char *regiontag, const
 
 	/* attempt reading up the chain through the parents. It automatically also
 	 attempts any kind of load by checksum supported by the archives. */
-	romdata->file = NULL;
-	for (int drv = driver_list::find(romdata->machine().system()); romdata->file == NULL && drv != -1; drv = driver_list::clone(drv)) {
+	file = NULL;
+	for (int drv = driver_list::find(machine.system()); file == NULL && drv != -1; drv = driver_list::clone(drv)) {
 		if (tried_file_names.length() != 0)
 			tried_file_names += " ";
 		tried_file_names += driver_list::driver(drv).name;
-		filerr = common_process_file(romdata->machine().options(), driver_list::driver(drv).name, has_crc, crc, romp, &romdata->file);
+		filerr = common_process_file(machine.options(), driver_list::driver(drv).name, has_crc, crc, romp, &file);
 	}
 
 	/* if the region is load by name, load the ROM from there */
-	if (romdata->file == NULL && regiontag != NULL)
+	if (file == NULL && regiontag != NULL)
 	{
 		// check if we are dealing with softwarelists. if so, locationtag
 		// is actually a concatenation of: listname + setname + parentname
@@ -684,8 +767,12 @@ static int open_rom_file(romload_private *romdata, const char *regiontag, const
 			}
 		}
 
+		// leave it to the loader to complain about these
 		if (tag5.find_first_of('%') != -1)
-			fatalerror("We do not support clones of clones!\n");
+		{
+			prefetch.clone_of_clone = true;
+			return;
+		}
 
 		// try to load from the available location(s):
 		// - if we are not using lists, we have regiontag only;
@@ -693,36 +780,226 @@ static int open_rom_file(romload_private *romdata, const char *regiontag, const
 		if (!is_list)
 		{
 			tried_file_names += " " + tag1;
-			filerr = common_process_file(romdata->machine().options(), tag1.c_str(), has_crc, crc, romp, &romdata->file);
+			filerr = common_process_file(machine.options(), tag1.c_str(), has_crc, crc, romp, &file);
 		}
 		else
 		{
 			// try to load from list/setname
-			if ((romdata->file == NULL) && (tag2.c_str() != NULL))
+			if ((file == NULL) && (tag2.c_str() != NULL))
 			{
 				tried_file_names += " " + tag2;
-				filerr = common_process_file(romdata->machine().options(), tag2.c_str(), has_crc, crc, romp, &romdata->file);
+				filerr = common_process_file(machine.options(), tag2.c_str(), has_crc, crc, romp, &file);
 			}
 			// try to load from list/parentname
-			if ((romdata->file == NULL) && has_parent && (tag3.c_str() != NULL))
+			if ((file == NULL) && has_parent && (tag3.c_str() != NULL))
 			{
 				tried_file_names += " " + tag3;
-				filerr = common_process_file(romdata->machine().options(), tag3.c_str(), has_crc, crc, romp, &romdata->file);
+				filerr = common_process_file(machine.options(), tag3.c_str(), has_crc, crc, romp, &file);
 			}
 			// try to load from setname
-			if ((romdata->file == NULL) && (tag4.c_str() != NULL))
+			if ((file == NULL) && (tag4.c_str() != NULL))
 			{
 				tried_file_names += " " + tag4;
-				filerr = common_process_file(romdata->machine().options(), tag4.c_str(), has_crc, crc, romp, &romdata->file);
+				filerr = common_process_file(machine.options(), tag4.c_str(), has_crc, crc, romp, &file);
 			}
 			// try to load from parentname
-			if ((romdata->file == NULL) && has_parent && (tag5.c_str() != NULL))
+			if ((file == NULL) && has_parent && (tag5.c_str() != NULL))
 			{
 				tried_file_names += " " + tag5;
-				filerr = common_process_file(romdata->machine().options(), tag5.c_str(), has_crc, crc, romp, &romdata->file);
+				filerr = common_process_file(machine.options(), tag5.c_str(), has_crc, crc, romp, &file);
 			}
 		}
 	}
+}
+
+
+/*-------------------------------------------------
+    prefetch_rom_file - work item callback that
+    finds a ROM file, then reads and hashes it
+    so the loader only has to copy it into place
+-------------------------------------------------*/
+
+static void *prefetch_rom_file(void *param, int threadid)
+{
+	rom_prefetch &prefetch = *reinterpret_cast<rom_prefetch *>(param);
+	locate_rom_file(prefetch);
+
+	if (prefetch.file != NULL)
+	{
+		// decompressing or buffering the whole file means later reads come from memory
+		core_file *core = *prefetch.file;
+		if (core != NULL)
+			core_fbuffer(core);
+
+		std::string tempstr;
+		prefetch.file->hashes(hash_collection(ROM_GETHASHDATA(prefetch.romp)).hash_types(tempstr));
+	}
+	return NULL;
+}
+
+
+/*-------------------------------------------------
+    alloc_prefetch - allocate the state for
+    finding a single ROM file
+-------------------------------------------------*/
+
+static rom_prefetch *alloc_prefetch(romload_private *romdata, const char *regiontag, const rom_entry *romp)
+{
+	rom_prefetch *prefetch = global_alloc(rom_prefetch);
+	prefetch->machine = &romdata->machine();
+	prefetch->regiontag = regiontag;
+	prefetch->romp = romp;
+	prefetch->item = NULL;
+	prefetch->file = NULL;
+	prefetch->filerr = FILERR_NOT_FOUND;
+	prefetch->clone_of_clone = false;
+	return prefetch;
+}
+
+
+/*-------------------------------------------------
+    add_prefetches - add the ROM files of a region
+    to the list of files to read ahead
+-------------------------------------------------*/
+
+static void add_prefetches(romload_private *romdata, const char *regiontag, const rom_entry *romp, device_t *device)
+{
+	for ( ; !ROMENTRY_ISREGIONEND(romp); romp++)
+		if (ROMENTRY_ISFILE(romp) && (ROM_GETBIOSFLAGS(romp) == 0 || ROM_GETBIOSFLAGS(romp) == device->system_bios()))
+		{
+			romdata->prefetch.push_back(alloc_prefetch(romdata, regiontag, romp));
+		}
+}
+
+
+/*-------------------------------------------------
+    queue_prefetches - queue reading ahead of the
+    loader, up to PREFETCH_MAX_BYTES beyond it
+-------------------------------------------------*/
+
+static void queue_prefetches(romload_private *romdata)
+{
+	if (romdata->prefetch_queue == NULL)
+		return;
+
+	// never bother with anything the loader has already asked for
+	romdata->prefetch_queued = MAX(romdata->prefetch_queued, romdata->prefetch_next);
+	while (romdata->prefetch_queued < romdata->prefetch.size() && romdata->prefetch_bytes < PREFETCH_MAX_BYTES)
+	{
+		rom_prefetch *prefetch = romdata->prefetch[romdata->prefetch_queued++];
+		prefetch->item = osd_work_item_queue(romdata->prefetch_queue, prefetch_rom_file, prefetch, 0);
+		if (prefetch->item != NULL)
+			romdata->prefetch_bytes += rom_file_size(prefetch->romp);
+	}
+}
+
+
+/*-------------------------------------------------
+    take_prefetch - return the read-ahead result
+    for the given ROM, or NULL if it isn't the
+    one expected next
+-------------------------------------------------*/
+
+static rom_prefetch *take_prefetch(romload_private *romdata, const rom_entry *romp)
+{
+	// files are asked for in the same order they were added
+	if (romdata->prefetch_next >= romdata->prefetch.size() || romdata->prefetch[romdata->prefetch_next]->romp != romp)
+		return NULL;
+	rom_prefetch *prefetch = romdata->prefetch[romdata->prefetch_next];
+	romdata->prefetch[romdata->prefetch_next++] = NULL;
+
+	// wait for it if it was queued, otherwise do the work here
+	if (prefetch->item != NULL)
+	{
+		while (!osd_work_item_wait(prefetch->item, osd_ticks_per_second())) { }
+		osd_work_item_release(prefetch->item);
+		prefetch->item = NULL;
+		romdata->prefetch_bytes -= rom_file_size(romp);
+	}
+	else
+		locate_rom_file(*prefetch);
+
+	// keep the workers busy
+	queue_prefetches(romdata);
+	return prefetch;
+}
+
+
+/*-------------------------------------------------
+    begin_prefetch - start reading ahead the files
+    added by add_prefetches
+-------------------------------------------------*/
+
+static void begin_prefetch(romload_private *romdata)
+{
+	romdata->prefetch_next = 0;
+	romdata->prefetch_queued = 0;
+	romdata->prefetch_bytes = 0;
+	if (romdata->prefetch_queue == NULL)
+		romdata->prefetch_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	queue_prefetches(romdata);
+}
+
+
+/*-------------------------------------------------
+    end_prefetch - wait for and discard anything
+    read ahead but not used, and free the queue
+-------------------------------------------------*/
+
+static void end_prefetch(romload_private *romdata)
+{
+	for (int index = 0; index < romdata->prefetch.size(); index++)
+	{
+		rom_prefetch *prefetch = romdata->prefetch[index];
+		if (prefetch == NULL)
+			continue;
+		if (prefetch->item != NULL)
+		{
+			while (!osd_work_item_wait(prefetch->item, osd_ticks_per_second())) { }
+			osd_work_item_release(prefetch->item);
+		}
+		global_free(prefetch->file);
+		global_free(prefetch);
+	}
+	romdata->prefetch.clear();
+
+	if (romdata->prefetch_queue != NULL)
+		osd_work_queue_free(romdata->prefetch_queue);
+	romdata->prefetch_queue = NULL;
+}
+
+
+/*-------------------------------------------------
+    open_rom_file - open a ROM file, searching
+    up the parent and loading by checksum
+-------------------------------------------------*/
+
+static int open_rom_file(romload_private *romdata, const char *regiontag, const rom_entry *romp, std::string &tried_file_names, bool from_list)
+{
+	UINT32 romsize = rom_file_size(romp);
+
+	/* update status display */
+	display_loading_rom_message(romdata, ROM_GETNAME(romp), from_list);
+
+	/* use the file read ahead if there is one, otherwise look for it now */
+	rom_prefetch *prefetch = take_prefetch(romdata, romp);
+	if (prefetch == NULL)
+	{
+		prefetch = alloc_prefetch(romdata, regiontag, romp);
+		locate_rom_file(*prefetch);
+	}
+
+	if (prefetch->clone_of_clone)
+	{
+		global_free(prefetch->file);
+		global_free(prefetch);
+		fatalerror("We do not support clones of clones!\n");
+	}
+
+	romdata->file = prefetch->file;
+	tried_file_names = prefetch->tried_file_names;
+	file_error filerr = prefetch->filerr;
+	global_free(prefetch);
 
 	/* update counters */
 	romdata->romsloaded++;
@@ -1376,6 +1653,11 @@ void load_software_part_region(device_t &device, software_list_device &swlist, c
 		locationtag.erase(locationtag.length() - 1, 1);
 	}
 
+	/* start reading the files ahead of the loader */
+	for (region = start_region; region != NULL; region = rom_next_region(region))
+		if (ROMREGION_ISROMDATA(region))
+			add_prefetches(romdata, locationtag.c_str(), region + 1, &device);
+	begin_prefetch(romdata);
 
 	/* loop until we hit the end */
 	for (region = start_region; region != NULL; region = rom_next_region(region))
@@ -1434,14 +1716,20 @@ void load_software_part_region(device_t &device, software_list_device &swlist, c
 	}
 
 	/* now go back and post-process all the regions */
+	std::vector<region_fixup> fixups;
 	for (region = start_region; region != NULL; region = rom_next_region(region))
 	{
 		regiontag = device.subtag(ROMREGION_GETTAG(region));
-		region_post_process(romdata, regiontag.c_str(), ROMREGION_ISINVERTED(region));
+		region_post_process(romdata, fixups, regiontag.c_str(), ROMREGION_ISINVERTED(region));
 	}
+	process_region_fixups(romdata, fixups);
+	end_prefetch(romdata);
 
 	/* display the results and exit */
 	display_rom_load_results(romdata, TRUE);
+
+	/* the solid blocks of 7z files were only kept around while loading */
+	_7z_file_cache_free_blocks();
 }
 
 
@@ -1453,8 +1741,15 @@ static void process_region_list(romload_private *romdata)
 {
 	std::string regiontag;
 
-	/* loop until we hit the end */
+	/* start reading the files ahead of the loader */
 	device_iterator deviter(romdata->machine().root_device());
+	for (device_t *device = deviter.first(); device != NULL; device = deviter.next())
+		for (const rom_entry *region = rom_first_region(*device); region != NULL; region = rom_next_region(region))
+			if (ROMREGION_ISROMDATA(region))
+				add_prefetches(romdata, device->shortname(), region + 1, device);
+	begin_prefetch(romdata);
+
+	/* loop until we hit the end */
 	for (device_t *device = deviter.first(); device != NULL; device = deviter.next())
 		for (const rom_entry *region = rom_first_region(*device); region != NULL; region = rom_next_region(region))
 		{
@@ -1500,12 +1795,15 @@ static void process_region_list(romload_private *romdata)
 		}
 
 	/* now go back and post-process all the regions */
+	std::vector<region_fixup> fixups;
 	for (device_t *device = deviter.first(); device != NULL; device = deviter.next())
 		for (const rom_entry *region = rom_first_region(*device); region != NULL; region = rom_next_region(region))
 		{
 			regiontag = rom_region_name(*device, region);
-			region_post_process(romdata, regiontag.c_str(), ROMREGION_ISINVERTED(region));
+			region_post_process(romdata, fixups, regiontag.c_str(), ROMREGION_ISINVERTED(region));
 		}
+	process_region_fixups(romdata, fixups);
+	end_prefetch(romdata);
 
 	/* and finally register all per-game parameters */
 	for (device_t *device = deviter.first(); device != NULL; device = deviter.next())
@@ -1564,6 +1862,7 @@ void rom_init(running_machine &machine)
 
 	/* display the results and exit */
 	display_rom_load_results(romdata, FALSE);
+	_7z_file_cache_free_blocks();
 }
 
 
@@ -1573,6 +1872,8 @@ void rom_init(running_machine &machine)
 
 static void rom_exit(running_machine &machine)
 {
+	/* a fatal error can leave files being read ahead */
+	end_prefetch(machine.romload_data);
 }
 
 
@@ -62,7 +62,8 @@ enum
 save_manager::save_manager(running_machine &machine)
 	: m_machine(machine),
 		m_reg_allowed(true),
-		m_illegal_regs(0)
+		m_illegal_regs(0),
+		m_reg_ticks(0)
 {
 }
 
@@ -162,6 +163,7 @@ void save_manager::save_memory(device_t *device, const char *module, const char
 	}
 
 	// create the full name
+	osd_ticks_t start = osd_ticks();
 	std::string totalname;
 	if (tag != NULL)
 		strprintf(totalname, "%s/%s/%X/%s", module, tag, index, name);
@@ -184,6 +186,7 @@ void save_manager::save_memory(device_t *device, const char *module, const char
 
 	// insert us into the list
 	m_entry_list.insert_after(*global_alloc(state_entry(val, totalname.c_str(), device, module, tag ? tag : "", index, valsize, valcount)), insert_after);
+	m_reg_ticks += osd_ticks() - start;
 }
 
 
@@ -97,6 +97,7 @@ public:
 	running_machine &machine() const { return m_machine; }
 	int registration_count() const { return m_entry_list.count(); }
 	bool registration_allowed() const { return m_reg_allowed; }
+	osd_ticks_t registration_ticks() const { return m_reg_ticks; }
 
 	// registration control
 	void allow_registration(bool allowed = true);
@@ -182,6 +183,7 @@ private:
 	running_machine &       m_machine;              // reference to our machine
 	bool                    m_reg_allowed;          // are registrations allowed?
 	int                     m_illegal_regs;         // number of illegal registrations
+	osd_ticks_t             m_reg_ticks;            // total time spent registering items
 
 	simple_list<state_entry> m_entry_list;          // list of reigstered entries
 	simple_list<state_callback> m_presave_list;     // list of pre-save functions
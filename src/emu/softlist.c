@@ -15,10 +15,27 @@
 #include "clifront.h"
 #include "validity.h"
 #include "expat.h"
+#include "filestamp.h"
 
 #include <ctype.h>
 
 
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// directory within the cfg directory holding the binary caches of the lists
+#define SOFTLIST_CACHE_DIRECTORY    "softlist"
+
+// bump the version if the format changes
+static const char s_cache_magic[8] = { 'M','A','M','E','S','W','L','C' };
+static const UINT32 SOFTLIST_CACHE_VERSION = 1;
+
+// length written in place of a NULL string
+static const UINT32 SOFTLIST_CACHE_NULL = 0xffffffff;
+
+
+
 //**************************************************************************
 //  TYPE DEFINITIONS
 //**************************************************************************
@@ -26,6 +43,44 @@
 typedef tagmap_t<software_info *> softlist_map;
 
 
+// ======================> softlist_cache
+
+// converts software items to and from the binary form kept in the cache;
+// strings are written with their terminator so that they can be added to
+// the string pool straight from the buffer
+class softlist_cache
+{
+public:
+	// construction; decoding reads from the given buffer
+	softlist_cache(software_list_device &list, const UINT8 *data, UINT32 length)
+		: m_list(list), m_data(data), m_end(data + length), m_ok(true) { }
+
+	// encoding
+	static void put_u32(dynamic_buffer &buffer, UINT32 value);
+	static void put_u64(dynamic_buffer &buffer, UINT64 value);
+	static void put_string(dynamic_buffer &buffer, const char *value);
+	static void put_features(dynamic_buffer &buffer, const feature_list_item *first);
+	static void put_info(dynamic_buffer &buffer, const software_info &info);
+
+	// decoding
+	bool ok() const { return m_ok; }
+	bool done() const { return m_ok && m_data == m_end; }
+	UINT32 get_u32();
+	UINT64 get_u64();
+	const char *get_string();
+	bool get_string(std::string &value);
+	void get_features(simple_list<feature_list_item> &list);
+	software_info *get_info();
+
+private:
+	// internal state
+	software_list_device &  m_list;
+	const UINT8 *           m_data;
+	const UINT8 *           m_end;
+	bool                    m_ok;
+};
+
+
 // ======================> softlist_parser
 
 class softlist_parser
@@ -279,7 +334,12 @@ software_list_device::software_list_device(const machine_config &mconfig, const
 		m_list_type(SOFTWARE_LIST_ORIGINAL_SYSTEM),
 		m_filter(NULL),
 		m_parsed(false),
-		m_file(mconfig.options().hash_path(), OPEN_FLAG_READ)
+		m_file(mconfig.options().hash_path(), OPEN_FLAG_READ),
+		m_description(NULL),
+		m_cache_checked(false),
+		m_cache_file(mconfig.options().cfg_directory(), OPEN_FLAG_READ),
+		m_cache_view(NULL),
+		m_cache_dataoffset(0)
 {
 }
 
@@ -380,7 +440,10 @@ void software_list_device::release()
 	m_description = NULL;
 	m_errors.clear();
 	m_infolist.reset();
+	m_cache_orphans.reset();
 	m_stringpool.reset();
+	reset_cache();
+	m_cache_checked = false;
 }
 
 
@@ -455,6 +518,29 @@ software_info *software_list_device::find(const char *look_for, software_info *p
 
 	bool iswild = strchr(look_for, '*') != NULL || strchr(look_for, '?');
 
+	// a plain name can be read alone from the cache without loading the rest of the list
+	if (prev == NULL && !iswild && !m_parsed && open_cache())
+	{
+		std::string key(look_for);
+		strmakelower(key);
+		FPTR itemnum = m_cache_map.find(key.c_str());
+		if (itemnum == 0)
+			return NULL;
+		software_info *info = read_cached(itemnum - 1);
+		if (info != NULL)
+		{
+			// bring in its parents as well, whose ROMs anything starting it needs too
+			const char *parent = info->parentname();
+			for (int depth = 0; parent != NULL && *parent != 0 && depth < m_cache_items.size(); depth++)
+			{
+				FPTR parentnum = m_cache_map.find(strmakelower(key.assign(parent)).c_str());
+				software_info *parentinfo = (parentnum != 0) ? read_cached(parentnum - 1) : NULL;
+				parent = (parentinfo != NULL) ? parentinfo->parentname() : NULL;
+			}
+			return info;
+		}
+	}
+
 	// find a match (will cause a parse if needed when calling first_software_info)
 	for (prev = (prev != NULL) ? prev->next() : first_software_info(); prev != NULL; prev = prev->next())
 		if ((iswild && core_strwildcmp(look_for, prev->shortname()) == 0) || core_stricmp(look_for, prev->shortname()) == 0)
@@ -477,12 +563,24 @@ void software_list_device::parse()
 	// reset the errors
 	m_errors.clear();
 
+	// use the binary cache if it is up to date; any items already read from
+	// a cache that turns out to be damaged have been handed out, so they are
+	// set aside until the list is released rather than freed
+	if (load_cache())
+	{
+		m_parsed = true;
+		return;
+	}
+	m_cache_orphans.append_list(m_infolist);
+
 	// attempt to open the file
 	file_error filerr = m_file.open(m_list_name.c_str(), ".xml");
 	if (filerr == FILERR_NONE)
 	{
-		// parse if no error
+		// parse if no error, and cache the result if it was clean
 		softlist_parser parser(*this, m_errors);
+		if (m_errors.empty())
+			save_cache();
 		m_file.close();
 	}
 	else
@@ -493,6 +591,257 @@ void software_list_device::parse()
 }
 
 
+//-------------------------------------------------
+//  open_cache - look for an up to date cache of
+//  the list and read its table of items, leaving
+//  the file open (and mapped, if possible) for
+//  reading the items
+//-------------------------------------------------
+
+bool software_list_device::open_cache()
+{
+	// only look once
+	if (m_cache_checked)
+		return !m_cache_offsets.empty();
+	m_cache_checked = true;
+	if (!mconfig().options().softlist_cache())
+		return false;
+
+	// find the list itself to see what the cache must match
+	file_stamp xml;
+	if (m_file.open(m_list_name.c_str(), ".xml") != FILERR_NONE)
+		return false;
+	bool cacheable = xml.read(m_file.fullpath());
+	m_file.close();
+	if (!cacheable || m_cache_file.open(SOFTLIST_CACHE_DIRECTORY PATH_SEPARATOR, m_list_name.c_str(), ".dat") != FILERR_NONE)
+		return false;
+
+	// check the header and read in the table
+	UINT8 header[sizeof(s_cache_magic) + 8];
+	if (m_cache_file.read(header, sizeof(header)) != sizeof(header) || memcmp(header, s_cache_magic, sizeof(s_cache_magic)) != 0)
+	{
+		reset_cache();
+		return false;
+	}
+	softlist_cache prefix(*this, header + sizeof(s_cache_magic), 8);
+	UINT32 version = prefix.get_u32();
+	UINT32 tablelength = prefix.get_u32();
+	dynamic_buffer table(tablelength);
+	if (version != SOFTLIST_CACHE_VERSION || tablelength == 0 || tablelength > m_cache_file.size() || m_cache_file.read(&table[0], tablelength) != tablelength)
+	{
+		reset_cache();
+		return false;
+	}
+
+	// it must come from this build and this exact file
+	softlist_cache reader(*this, &table[0], tablelength);
+	std::string build, path;
+	if (!reader.get_string(build) || build.compare(build_version) != 0 || !reader.get_string(path))
+	{
+		reset_cache();
+		return false;
+	}
+	UINT64 size = reader.get_u64();
+	UINT64 modified = reader.get_u64();
+	if (file_stamp(path.c_str(), size, modified) != xml)
+	{
+		reset_cache();
+		return false;
+	}
+
+	// then the description and the name and length of each item
+	const char *description = reader.get_string();
+	UINT32 count = reader.get_u32();
+	m_cache_offsets.push_back(0);
+	std::string key;
+	for (UINT32 itemnum = 0; itemnum < count && reader.ok(); itemnum++)
+	{
+		if (!reader.get_string(key))
+			break;
+		m_cache_offsets.push_back(m_cache_offsets.back() + reader.get_u32());
+		m_cache_map.add(strmakelower(key).c_str(), itemnum + 1, false);
+	}
+	if (!reader.done() || m_cache_offsets.size() != count + 1)
+	{
+		reset_cache();
+		return false;
+	}
+
+	m_cache_dataoffset = sizeof(header) + tablelength;
+	if (m_cache_dataoffset + m_cache_offsets.back() > m_cache_file.size())
+	{
+		reset_cache();
+		return false;
+	}
+
+	// items are decoded straight from a view of the file where we can get one
+	m_description = description;
+	core_file *cachefile = m_cache_file;
+	if (cachefile != NULL)
+		m_cache_view = (const UINT8 *)core_fmap(cachefile);
+	m_cache_items.assign(count, NULL);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  load_cache - load the whole list from the
+//  cache, keeping any items already read from it
+//-------------------------------------------------
+
+bool software_list_device::load_cache()
+{
+	if (!open_cache())
+		return false;
+
+	// read all the items at once
+	UINT32 count = m_cache_items.size();
+	dynamic_buffer buffer;
+	const UINT8 *data = cache_data(0, m_cache_offsets[count], buffer);
+	if (count != 0 && data == NULL)
+	{
+		reset_cache();
+		return false;
+	}
+
+	// rebuild the list in order, reusing the items we already have
+	simple_list<software_info> items;
+	for (UINT32 itemnum = 0; itemnum < count; itemnum++)
+	{
+		software_info *info = m_cache_items[itemnum];
+		if (info != NULL)
+			m_infolist.detach(*info);
+		else
+		{
+			softlist_cache reader(*this, &data[m_cache_offsets[itemnum]], m_cache_offsets[itemnum + 1] - m_cache_offsets[itemnum]);
+			info = reader.get_info();
+			if (info == NULL)
+			{
+				m_infolist.append_list(items);
+				reset_cache();
+				return false;
+			}
+		}
+		items.append(*info);
+	}
+	m_infolist.append_list(items);
+
+	// the list is complete, so the cache isn't needed any more
+	reset_cache();
+	return true;
+}
+
+
+//-------------------------------------------------
+//  read_cached - read a single item from the
+//  cache, unless it has been read already
+//-------------------------------------------------
+
+software_info *software_list_device::read_cached(UINT32 itemnum)
+{
+	if (m_cache_items[itemnum] != NULL)
+		return m_cache_items[itemnum];
+
+	UINT64 length = m_cache_offsets[itemnum + 1] - m_cache_offsets[itemnum];
+	dynamic_buffer buffer;
+	const UINT8 *data = cache_data(m_cache_offsets[itemnum], length, buffer);
+	if (data == NULL)
+		return NULL;
+
+	softlist_cache reader(*this, data, length);
+	software_info *info = reader.get_info();
+	if (info == NULL)
+		return NULL;
+	m_cache_items[itemnum] = &m_infolist.append(*info);
+	return info;
+}
+
+
+//-------------------------------------------------
+//  cache_data - return a pointer to part of the
+//  item data, from the view of the cache if
+//  there is one or else read into the buffer
+//-------------------------------------------------
+
+const UINT8 *software_list_device::cache_data(UINT64 offset, UINT64 length, dynamic_buffer &buffer)
+{
+	if (length == 0)
+		return NULL;
+	if (m_cache_view != NULL)
+		return m_cache_view + m_cache_dataoffset + offset;
+
+	buffer.resize(length);
+	if (m_cache_file.seek(m_cache_dataoffset + offset, SEEK_SET) != 0 || m_cache_file.read(&buffer[0], length) != length)
+		return NULL;
+	return &buffer[0];
+}
+
+
+//-------------------------------------------------
+//  save_cache - write a cache of the freshly
+//  parsed list
+//-------------------------------------------------
+
+void software_list_device::save_cache()
+{
+	file_stamp xml;
+	if (!mconfig().options().softlist_cache() || !xml.read(m_file.fullpath()))
+		return;
+
+	// encode the items, then the table describing them
+	dynamic_buffer table, data;
+	softlist_cache::put_string(table, build_version);
+	softlist_cache::put_string(table, xml.path());
+	softlist_cache::put_u64(table, xml.size());
+	softlist_cache::put_u64(table, xml.modified());
+	softlist_cache::put_string(table, m_description);
+	softlist_cache::put_u32(table, m_infolist.count());
+	for (const software_info *info = m_infolist.first(); info != NULL; info = info->next())
+	{
+		UINT32 start = data.size();
+		softlist_cache::put_info(data, *info);
+		softlist_cache::put_string(table, info->shortname());
+		softlist_cache::put_u32(table, data.size() - start);
+	}
+
+	dynamic_buffer header(s_cache_magic, s_cache_magic + sizeof(s_cache_magic));
+	softlist_cache::put_u32(header, SOFTLIST_CACHE_VERSION);
+	softlist_cache::put_u32(header, table.size());
+
+	// a cache that can't be written just means we parse again next time; it is written
+	// to a new file first, since other instances may have the old one mapped and would
+	// crash if it were truncated under them
+	emu_file file(mconfig().options().cfg_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(SOFTLIST_CACHE_DIRECTORY PATH_SEPARATOR, m_list_name.c_str(), ".dat.tmp") != FILERR_NONE)
+		return;
+	if (file.write(&header[0], header.size()) != header.size() || file.write(&table[0], table.size()) != table.size() || (!data.empty() && file.write(&data[0], data.size()) != data.size()))
+	{
+		osd_printf_verbose("Error writing cache of software list %s\n", m_list_name.c_str());
+		file.remove_on_close();
+		return;
+	}
+	std::string cachename(SOFTLIST_CACHE_DIRECTORY PATH_SEPARATOR);
+	if (file.close_and_replace(cachename.append(m_list_name).append(".dat").c_str()) != FILERR_NONE)
+		osd_printf_verbose("Error replacing cache of software list %s\n", m_list_name.c_str());
+}
+
+
+//-------------------------------------------------
+//  reset_cache - forget the cache and any items
+//  read from it
+//-------------------------------------------------
+
+void software_list_device::reset_cache()
+{
+	m_cache_view = NULL;
+	m_cache_file.close();
+	m_cache_dataoffset = 0;
+	m_cache_map.reset();
+	m_cache_offsets.clear();
+	m_cache_items.clear();
+}
+
+
 //-------------------------------------------------
 //  device_validity_check - validate the device
 //  configuration
@@ -1258,3 +1607,235 @@ void softlist_parser::parse_soft_end(const char *tagname)
 				m_current_part->m_featurelist.append(*global_alloc(feature_list_item(item->name(), item->value())));
 	}
 }
+
+
+
+//**************************************************************************
+//  SOFTWARE LIST CACHE
+//**************************************************************************
+
+//-------------------------------------------------
+//  put_u32/put_u64/put_string - append values to
+//  a buffer in little-endian order
+//-------------------------------------------------
+
+void softlist_cache::put_u32(dynamic_buffer &buffer, UINT32 value)
+{
+	for (int byte = 0; byte < 4; byte++)
+		buffer.push_back(UINT8(value >> (8 * byte)));
+}
+
+void softlist_cache::put_u64(dynamic_buffer &buffer, UINT64 value)
+{
+	put_u32(buffer, UINT32(value));
+	put_u32(buffer, UINT32(value >> 32));
+}
+
+void softlist_cache::put_string(dynamic_buffer &buffer, const char *value)
+{
+	if (value == NULL)
+	{
+		put_u32(buffer, SOFTLIST_CACHE_NULL);
+		return;
+	}
+	UINT32 length = strlen(value);
+	put_u32(buffer, length);
+	buffer.insert(buffer.end(), value, value + length + 1);
+}
+
+
+//-------------------------------------------------
+//  put_features - append a list of name/value
+//  pairs
+//-------------------------------------------------
+
+void softlist_cache::put_features(dynamic_buffer &buffer, const feature_list_item *first)
+{
+	UINT32 count = 0;
+	for (const feature_list_item *item = first; item != NULL; item = item->next())
+		count++;
+	put_u32(buffer, count);
+	for (const feature_list_item *item = first; item != NULL; item = item->next())
+	{
+		put_string(buffer, item->name());
+		put_string(buffer, item->value());
+	}
+}
+
+
+//-------------------------------------------------
+//  put_info - append everything about a software
+//  item, exactly as the parser left it
+//-------------------------------------------------
+
+void softlist_cache::put_info(dynamic_buffer &buffer, const software_info &info)
+{
+	put_string(buffer, info.shortname());
+	put_string(buffer, info.parentname());
+	put_string(buffer, info.longname());
+	put_string(buffer, info.year());
+	put_string(buffer, info.publisher());
+	put_u32(buffer, info.supported());
+	put_features(buffer, info.other_info());
+	put_features(buffer, info.shared_info());
+
+	put_u32(buffer, info.num_parts());
+	for (const software_part *part = info.first_part(); part != NULL; part = part->next())
+	{
+		put_string(buffer, part->name());
+		put_string(buffer, part->interface());
+		put_features(buffer, part->featurelist());
+
+		// fill entries keep their value in place of the hash data
+		put_u32(buffer, part->m_romdata.size());
+		for (unsigned int romnum = 0; romnum < part->m_romdata.size(); romnum++)
+		{
+			const rom_entry &entry = part->m_romdata[romnum];
+			put_u32(buffer, entry._flags);
+			put_string(buffer, entry._name);
+			if (ROMENTRY_ISFILL(&entry))
+				put_u32(buffer, UINT32(FPTR(entry._hashdata)));
+			else
+				put_string(buffer, entry._hashdata);
+			put_u32(buffer, entry._offset);
+			put_u32(buffer, entry._length);
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  get_u32/get_u64 - read values written by the
+//  above, flagging an error on overrun
+//-------------------------------------------------
+
+UINT32 softlist_cache::get_u32()
+{
+	if (m_end - m_data < 4)
+	{
+		m_ok = false;
+		return 0;
+	}
+	UINT32 value = m_data[0] | (m_data[1] << 8) | (m_data[2] << 16) | (m_data[3] << 24);
+	m_data += 4;
+	return value;
+}
+
+UINT64 softlist_cache::get_u64()
+{
+	UINT32 lo = get_u32();
+	UINT32 hi = get_u32();
+	return lo | (UINT64(hi) << 32);
+}
+
+
+//-------------------------------------------------
+//  get_string - read a string into the string
+//  pool of the list
+//-------------------------------------------------
+
+const char *softlist_cache::get_string()
+{
+	UINT32 length = get_u32();
+	if (!m_ok || length == SOFTLIST_CACHE_NULL)
+		return NULL;
+	if (UINT32(m_end - m_data) <= length || m_data[length] != 0)
+	{
+		m_ok = false;
+		return NULL;
+	}
+	const char *result = m_list.add_string(reinterpret_cast<const char *>(m_data));
+	m_data += length + 1;
+	return result;
+}
+
+
+//-------------------------------------------------
+//  get_string - read a string that must not be
+//  NULL into a std::string
+//-------------------------------------------------
+
+bool softlist_cache::get_string(std::string &value)
+{
+	UINT32 length = get_u32();
+	if (!m_ok || length == SOFTLIST_CACHE_NULL || UINT32(m_end - m_data) <= length || m_data[length] != 0)
+	{
+		m_ok = false;
+		return false;
+	}
+	value.assign(reinterpret_cast<const char *>(m_data), length);
+	m_data += length + 1;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  get_features - read a list of name/value
+//  pairs
+//-------------------------------------------------
+
+void softlist_cache::get_features(simple_list<feature_list_item> &list)
+{
+	UINT32 count = get_u32();
+	for (UINT32 itemnum = 0; itemnum < count && m_ok; itemnum++)
+	{
+		const char *name = get_string();
+		const char *value = get_string();
+		if (m_ok)
+			list.append(*global_alloc(feature_list_item(name, value)));
+	}
+}
+
+
+//-------------------------------------------------
+//  get_info - read a whole software item; returns
+//  NULL if the data is damaged
+//-------------------------------------------------
+
+software_info *softlist_cache::get_info()
+{
+	const char *shortname = get_string();
+	const char *parentname = get_string();
+	if (shortname == NULL)
+		return NULL;
+
+	software_info *info = global_alloc(software_info(m_list, shortname, parentname, NULL));
+	info->m_longname = get_string();
+	info->m_year = get_string();
+	info->m_publisher = get_string();
+	info->m_supported = get_u32();
+	get_features(info->m_other_info);
+	get_features(info->m_shared_info);
+
+	UINT32 partcount = get_u32();
+	for (UINT32 partnum = 0; partnum < partcount && m_ok; partnum++)
+	{
+		const char *name = get_string();
+		const char *interface = get_string();
+		software_part &part = info->m_partdata.append(*global_alloc(software_part(*info, name, interface)));
+		get_features(part.m_featurelist);
+
+		UINT32 romcount = get_u32();
+		for (UINT32 romnum = 0; romnum < romcount && m_ok; romnum++)
+		{
+			rom_entry entry;
+			entry._flags = get_u32();
+			entry._name = get_string();
+			if (ROMENTRY_ISFILL(&entry))
+				entry._hashdata = (const char *)(FPTR)get_u32();
+			else
+				entry._hashdata = get_string();
+			entry._offset = get_u32();
+			entry._length = get_u32();
+			part.m_romdata.push_back(entry);
+		}
+	}
+
+	// the item must account for all of its data
+	if (!done())
+	{
+		global_free(info);
+		return NULL;
+	}
+	return info;
+}
@@ -101,6 +101,7 @@ private:
 class software_part
 {
 	friend class softlist_parser;
+	friend class softlist_cache;
 	friend class simple_list<software_part>;
 
 public:
@@ -137,6 +138,7 @@ private:
 class software_info
 {
 	friend class softlist_parser;
+	friend class softlist_cache;
 	friend class simple_list<software_info>;
 
 public:
@@ -185,6 +187,7 @@ private:
 class software_list_device : public device_t
 {
 	friend class softlist_parser;
+	friend class softlist_cache;
 
 public:
 	// construction/destruction
@@ -224,6 +227,14 @@ protected:
 	void parse();
 	void internal_validity_check(validity_checker &valid) ATTR_COLD;
 
+	// binary cache helpers
+	bool open_cache();
+	bool load_cache();
+	software_info *read_cached(UINT32 itemnum);
+	const UINT8 *cache_data(UINT64 offset, UINT64 length, dynamic_buffer &buffer);
+	void save_cache();
+	void reset_cache();
+
 	// device-level overrides
 	virtual void device_start();
 	virtual void device_validity_check(validity_checker &valid) const ATTR_COLD;
@@ -240,6 +251,16 @@ protected:
 	std::string                 m_errors;
 	simple_list<software_info>  m_infolist;
 	const_string_pool           m_stringpool;
+
+	// binary cache state
+	bool                        m_cache_checked;    // whether we've looked for the cache yet
+	emu_file                    m_cache_file;       // the cache, left open for reading single items
+	const UINT8 *               m_cache_view;       // the whole cache, if the OSD layer could map it
+	UINT64                      m_cache_dataoffset; // offset of the first item within the cache
+	tagmap_t<FPTR>              m_cache_map;        // item number + 1 for each lowercased short name
+	std::vector<UINT64>         m_cache_offsets;    // offset of each item in the data, plus the end
+	std::vector<software_info *> m_cache_items;     // items already read from the cache
+	simple_list<software_info>  m_cache_orphans;    // items handed out from a cache that later failed to load
 };
 
 
@@ -28,9 +28,14 @@ UINT8 your_ptr64_flag_is_wrong[(int)(5 - sizeof(void *))];
 
 
 //**************************************************************************
-//  TYPE DEFINITIONS
+//  GLOBAL VARIABLES
 //**************************************************************************
 
+// checker validating a driver on the current thread, if any
+static ATTR_THREAD_LOCAL validity_checker *s_thread_checker;
+
+
+
 //**************************************************************************
 //  INLINE FUNCTIONS
 //**************************************************************************
@@ -55,7 +60,7 @@ inline const char *validity_checker::ioport_string_from_index(UINT32 index)
 inline int validity_checker::get_defstr_index(const char *string, bool suppress_error)
 {
 	// check for strings that should be DEF_STR
-	int strindex = m_defstr_map.find(string);
+	int strindex = m_primary->m_defstr_map.find(string);
 	if (!suppress_error && strindex != 0 && string != ioport_string_from_index(strindex))
 		osd_printf_error("Must use DEF_STR( %s )\n", string);
 	return strindex;
@@ -128,8 +133,14 @@ validity_checker::validity_checker(emu_options &options)
 		m_current_driver(NULL),
 		m_current_config(NULL),
 		m_current_device(NULL),
-		m_current_ioport(NULL)
+		m_current_ioport(NULL),
+		m_primary(this),
+		m_current_index(-1),
+		m_shared_mode(SHARED_CHECK_LOCAL),
+		m_shared_lock(osd_lock_alloc())
 {
+	memset(m_thread, 0, sizeof(m_thread));
+
 	// pre-populate the defstr map with all the default strings
 	for (int strnum = 1; strnum < INPUT_STRING_COUNT; strnum++)
 	{
@@ -146,6 +157,11 @@ validity_checker::validity_checker(emu_options &options)
 validity_checker::~validity_checker()
 {
 	validate_end();
+
+	// free the per-thread checkers
+	for (int threadnum = 0; threadnum < ARRAY_LENGTH(m_thread); threadnum++)
+		global_free(m_thread[threadnum]);
+	osd_lock_free(m_shared_lock);
 }
 
 //-------------------------------------------------
@@ -156,6 +172,7 @@ void validity_checker::check_driver(const game_driver &driver)
 {
 	// simply validate the one driver
 	validate_begin();
+	register_driver(driver);
 	validate_one(driver);
 	validate_end();
 }
@@ -173,6 +190,10 @@ void validity_checker::check_shared_source(const game_driver &driver)
 
 	// then iterate over all drivers and check the ones that share the same source file
 	m_drivlist.reset();
+	while (m_drivlist.next())
+		if (strcmp(driver.source_file, m_drivlist.driver().source_file) == 0)
+			register_driver(m_drivlist.driver());
+	m_drivlist.reset();
 	while (m_drivlist.next())
 		if (strcmp(driver.source_file, m_drivlist.driver().source_file) == 0)
 			validate_one(m_drivlist.driver());
@@ -211,10 +232,8 @@ bool validity_checker::check_all()
 		output_via_delegate(OSD_OUTPUT_CHANNEL_ERROR, "\n");
 	}
 
-	// then iterate over all drivers and check them
-	m_drivlist.reset();
-	while (m_drivlist.next())
-		validate_one(m_drivlist.driver());
+	// then check all the drivers
+	validate_all_drivers();
 
 	// cleanup
 	validate_end();
@@ -245,6 +264,8 @@ void validity_checker::validate_begin()
 	m_errors = 0;
 	m_warnings = 0;
 	m_already_checked.reset();
+	m_shared_owners.reset();
+	m_shared_mode = SHARED_CHECK_LOCAL;
 }
 
 
@@ -261,10 +282,26 @@ void validity_checker::validate_end()
 
 
 //-------------------------------------------------
-//  validate_drivers - master validity checker
+//  validate_one - validate a single driver and
+//  output anything found
 //-------------------------------------------------
 
 void validity_checker::validate_one(const game_driver &driver)
+{
+	int start_errors = m_errors;
+	int start_warnings = m_warnings;
+	validate_one_quiet(driver);
+	output_one(driver, m_errors - start_errors, m_warnings - start_warnings, m_error_text, m_warning_text);
+}
+
+
+//-------------------------------------------------
+//  validate_one_quiet - validate a single driver,
+//  leaving the errors and warnings found in
+//  m_error_text and m_warning_text
+//-------------------------------------------------
+
+void validity_checker::validate_one_quiet(const game_driver &driver)
 {
 	// set the current driver
 	m_current_driver = &driver;
@@ -274,8 +311,6 @@ void validity_checker::validate_one(const game_driver &driver)
 	m_region_map.reset();
 
 	// reset error/warning state
-	int start_errors = m_errors;
-	int start_warnings = m_warnings;
 	m_error_text.clear();
 	m_warning_text.clear();
 
@@ -295,29 +330,211 @@ void validity_checker::validate_one(const game_driver &driver)
 	}
 	m_current_config = NULL;
 
-	// if we had warnings or errors, output
-	if (m_errors > start_errors || m_warnings > start_warnings)
+	// reset the driver/device
+	m_current_driver = NULL;
+	m_current_config = NULL;
+	m_current_device = NULL;
+	m_current_ioport = NULL;
+}
+
+
+//-------------------------------------------------
+//  output_one - output the errors and warnings
+//  found for a single driver, if there were any
+//-------------------------------------------------
+
+void validity_checker::output_one(const game_driver &driver, int errors, int warnings, std::string &error_text, std::string &warning_text)
+{
+	if (errors > 0 || warnings > 0)
 	{
 		std::string tempstr;
-		output_via_delegate(OSD_OUTPUT_CHANNEL_ERROR, "Driver %s (file %s): %d errors, %d warnings\n", driver.name, core_filename_extract_base(tempstr, driver.source_file).c_str(), m_errors - start_errors, m_warnings - start_warnings);
-		if (m_errors > start_errors)
+		output_via_delegate(OSD_OUTPUT_CHANNEL_ERROR, "Driver %s (file %s): %d errors, %d warnings\n", driver.name, core_filename_extract_base(tempstr, driver.source_file).c_str(), errors, warnings);
+		if (errors > 0)
 		{
-			strreplace(m_error_text, "\n", "\n   ");
-			output_via_delegate(OSD_OUTPUT_CHANNEL_ERROR, "Errors:\n   %s", m_error_text.c_str());
+			strreplace(error_text, "\n", "\n   ");
+			output_via_delegate(OSD_OUTPUT_CHANNEL_ERROR, "Errors:\n   %s", error_text.c_str());
 		}
-		if (m_warnings > start_warnings)
+		if (warnings > 0)
 		{
-			strreplace(m_warning_text, "\n", "\n   ");
-			output_via_delegate(OSD_OUTPUT_CHANNEL_ERROR, "Warnings:\n   %s", m_warning_text.c_str());
+			strreplace(warning_text, "\n", "\n   ");
+			output_via_delegate(OSD_OUTPUT_CHANNEL_ERROR, "Warnings:\n   %s", warning_text.c_str());
 		}
 		output_via_delegate(OSD_OUTPUT_CHANNEL_ERROR, "\n");
 	}
+}
 
-	// reset the driver/device
-	m_current_driver = NULL;
-	m_current_config = NULL;
-	m_current_device = NULL;
-	m_current_ioport = NULL;
+
+//-------------------------------------------------
+//  register_driver - record a driver's name and
+//  description, so that later drivers using the
+//  same ones are reported as duplicates
+//-------------------------------------------------
+
+void validity_checker::register_driver(const game_driver &driver)
+{
+	m_names_map.add(driver.name, &driver, false);
+	m_descriptions_map.add(driver.description, &driver, false);
+}
+
+
+//-------------------------------------------------
+//  already_checked - return true if a check that
+//  is shared between drivers has already been
+//  done, claiming it for the caller otherwise
+//-------------------------------------------------
+
+bool validity_checker::already_checked(const char *string)
+{
+	validity_checker &primary = *m_primary;
+	switch (primary.m_shared_mode)
+	{
+		// on the first parallel pass, skip the check but note the earliest driver to ask for it
+		case SHARED_CHECK_RECORD:
+		{
+			osd_lock_acquire(primary.m_shared_lock);
+			FPTR owner = primary.m_shared_owners.find(string);
+			if (owner == 0 || owner > m_current_index + 1)
+				primary.m_shared_owners.add(string, m_current_index + 1, true);
+			osd_lock_release(primary.m_shared_lock);
+			return true;
+		}
+
+		// on the second pass, only that driver does it, just as if the drivers were checked in order
+		case SHARED_CHECK_OWNED:
+			if (primary.m_shared_owners.find(string) != m_current_index + 1)
+				return true;
+			break;
+
+		default:
+			break;
+	}
+	return (m_already_checked.add(string, 1, false) == TMERR_DUPLICATE);
+}
+
+
+//-------------------------------------------------
+//  validate_all_drivers - validate every driver
+//  across the work queue, outputting the results
+//  in driver order
+//-------------------------------------------------
+
+void validity_checker::validate_all_drivers()
+{
+	// register all names and descriptions up front, so duplicates are
+	// reported against the same driver whatever order they are checked in
+	std::vector<driver_result> results;
+	m_drivlist.reset();
+	while (m_drivlist.next())
+	{
+		register_driver(m_drivlist.driver());
+
+		driver_result result;
+		result.primary = this;
+		result.driver = m_drivlist.current();
+		result.errors = 0;
+		result.warnings = 0;
+		results.push_back(result);
+	}
+
+	// first pass checks everything except the checks shared between drivers
+	m_shared_owners.reset();
+	m_shared_mode = SHARED_CHECK_RECORD;
+	validate_parallel(results);
+
+	// second pass repeats the drivers that were first to ask for a shared check
+	std::vector<int> position(driver_list::total(), -1);
+	for (int index = 0; index < results.size(); index++)
+		position[results[index].driver] = index;
+	std::vector<bool> owner(results.size(), false);
+	for (int_map::entry_t *entry = m_shared_owners.first(); entry != NULL; entry = m_shared_owners.next(entry))
+		owner[position[entry->object() - 1]] = true;
+
+	std::vector<driver_result> rerun;
+	for (int index = 0; index < results.size(); index++)
+		if (owner[index])
+			rerun.push_back(results[index]);
+	m_shared_mode = SHARED_CHECK_OWNED;
+	validate_parallel(rerun);
+	m_shared_mode = SHARED_CHECK_LOCAL;
+	for (int index = 0; index < rerun.size(); index++)
+		results[position[rerun[index].driver]] = rerun[index];
+
+	// merge everything in order
+	for (int index = 0; index < results.size(); index++)
+	{
+		driver_result &result = results[index];
+		m_errors += result.errors;
+		m_warnings += result.warnings;
+		output_one(driver_list::driver(result.driver), result.errors, result.warnings, result.error_text, result.warning_text);
+	}
+}
+
+
+//-------------------------------------------------
+//  validate_parallel - validate a set of drivers,
+//  spreading them across the work queue
+//-------------------------------------------------
+
+void validity_checker::validate_parallel(std::vector<driver_result> &results)
+{
+	if (results.empty())
+		return;
+
+	// without a queue, just do them in order
+	osd_work_queue *queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	if (queue == NULL)
+	{
+		for (int index = 0; index < results.size(); index++)
+			validate_result(results[index], 0);
+		return;
+	}
+
+	// otherwise, queue them all and help out until they're done
+	osd_work_item_queue_multiple(queue, validate_static, results.size(), &results[0], sizeof(results[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+	while (!osd_work_queue_wait(queue, osd_ticks_per_second())) { }
+	osd_work_queue_free(queue);
+}
+
+
+//-------------------------------------------------
+//  validate_static - work queue callback
+//-------------------------------------------------
+
+void *validity_checker::validate_static(void *param, int threadid)
+{
+	driver_result &result = *reinterpret_cast<driver_result *>(param);
+	result.primary->validate_result(result, threadid);
+	return NULL;
+}
+
+
+//-------------------------------------------------
+//  validate_result - validate a single driver
+//  using the calling thread's checker
+//-------------------------------------------------
+
+void validity_checker::validate_result(driver_result &result, int threadid)
+{
+	// each thread gets its own checker, since they track the current driver and device
+	validity_checker *&checker = m_thread[threadid];
+	if (checker == NULL)
+	{
+		checker = global_alloc(validity_checker(m_drivlist.options()));
+		checker->m_primary = this;
+	}
+
+	// errors and warnings raised on this thread are routed to it by our output_callback
+	s_thread_checker = checker;
+	checker->m_current_index = result.driver;
+	int start_errors = checker->m_errors;
+	int start_warnings = checker->m_warnings;
+	checker->validate_one_quiet(driver_list::driver(result.driver));
+	s_thread_checker = NULL;
+
+	result.errors = checker->m_errors - start_errors;
+	result.warnings = checker->m_warnings - start_warnings;
+	result.error_text.assign(checker->m_error_text);
+	result.warning_text.assign(checker->m_warning_text);
 }
 
 
@@ -532,16 +749,16 @@ void validity_checker::validate_driver()
 {
 	// check for duplicate names
 	std::string tempstr;
-	if (m_names_map.add(m_current_driver->name, m_current_driver, false) == TMERR_DUPLICATE)
+	const game_driver *match = m_primary->m_names_map.find(m_current_driver->name);
+	if (match != NULL && match != m_current_driver)
 	{
-		const game_driver *match = m_names_map.find(m_current_driver->name);
 		osd_printf_error("Driver name is a duplicate of %s(%s)\n", core_filename_extract_base(tempstr, match->source_file).c_str(), match->name);
 	}
 
 	// check for duplicate descriptions
-	if (m_descriptions_map.add(m_current_driver->description, m_current_driver, false) == TMERR_DUPLICATE)
+	match = m_primary->m_descriptions_map.find(m_current_driver->description);
+	if (match != NULL && match != m_current_driver)
 	{
-		const game_driver *match = m_descriptions_map.find(m_current_driver->description);
 		osd_printf_error("Driver description is a duplicate of %s(%s)\n", core_filename_extract_base(tempstr, match->source_file).c_str(), match->name);
 	}
 
@@ -1065,6 +1282,14 @@ void validity_checker::build_output_prefix(std::string &str)
 
 void validity_checker::output_callback(osd_output_channel channel, const char *msg, va_list args)
 {
+	// errors and warnings raised on a worker thread belong to the checker running there
+	validity_checker *checker = s_thread_checker;
+	if (checker != NULL && checker != this && (channel == OSD_OUTPUT_CHANNEL_ERROR || channel == OSD_OUTPUT_CHANNEL_WARNING))
+	{
+		checker->output_callback(channel, msg, args);
+		return;
+	}
+
 	std::string output;
 	switch (channel)
 	{
@@ -50,7 +50,7 @@ public:
 	int region_length(const char *tag) { return m_region_map.find(tag); }
 
 	// generic registry of already-checked stuff
-	bool already_checked(const char *string) { return (m_already_checked.add(string, 1, false) == TMERR_DUPLICATE); }
+	bool already_checked(const char *string);
 
 	// osd_output interface
 
@@ -58,6 +58,25 @@ protected:
 	virtual void output_callback(osd_output_channel channel, const char *msg, va_list args);
 
 private:
+	// results of validating one driver on a worker thread
+	struct driver_result
+	{
+		validity_checker *  primary;            // checker that queued the work
+		int                 driver;             // index of the driver
+		int                 errors;             // number of errors found
+		int                 warnings;           // number of warnings found
+		std::string         error_text;         // text of the errors
+		std::string         warning_text;       // text of the warnings
+	};
+
+	// how already_checked answers while drivers are validated in parallel
+	enum shared_check_mode
+	{
+		SHARED_CHECK_LOCAL,                     // serial: the first caller does the check
+		SHARED_CHECK_RECORD,                    // first pass: skip, noting the first driver to ask
+		SHARED_CHECK_OWNED                      // second pass: only the noted driver does the check
+	};
+
 	// internal helpers
 	const char *ioport_string_from_index(UINT32 index);
 	int get_defstr_index(const char *string, bool suppress_error = false);
@@ -66,6 +85,15 @@ private:
 	void validate_begin();
 	void validate_end();
 	void validate_one(const game_driver &driver);
+	void validate_one_quiet(const game_driver &driver);
+	void output_one(const game_driver &driver, int errors, int warnings, std::string &error_text, std::string &warning_text);
+	void register_driver(const game_driver &driver);
+
+	// parallel validation
+	void validate_all_drivers();
+	void validate_parallel(std::vector<driver_result> &results);
+	static void *validate_static(void *param, int threadid);
+	void validate_result(driver_result &result, int threadid);
 
 	// internal sub-checks
 	void validate_core();
@@ -105,6 +133,13 @@ private:
 	int_map                 m_region_map;
 	tagmap_t<UINT8>         m_already_checked;
 
+	// parallel validation state
+	validity_checker *      m_primary;          // checker holding the shared maps (this one, unless a worker)
+	int                     m_current_index;    // index of the driver being validated by a worker
+	shared_check_mode       m_shared_mode;
+	osd_lock *              m_shared_lock;
+	int_map                 m_shared_owners;    // driver index + 1 of the first driver to ask for each shared check
+	validity_checker *      m_thread[WORK_MAX_THREADS + 1];
 };
 
 #endif
@@ -100,14 +100,23 @@ video_manager::video_manager(running_machine &machine)
 		m_snap_native(true),
 		m_snap_width(0),
 		m_snap_height(0),
+		m_snap_queue(NULL),
 		m_mng_frame_period(attotime::zero),
+		m_mng_queue(NULL),
 		m_mng_next_frame_time(attotime::zero),
 		m_mng_frame(0),
 		m_avi_file(NULL),
 		m_avi_frame_period(attotime::zero),
 		m_avi_next_frame_time(attotime::zero),
 		m_avi_frame(0),
-		m_dummy_recording(false)
+		m_dummy_recording(false),
+		m_movie_queue(NULL),
+		m_movie_next_item(0),
+		m_avi_error(0),
+		m_mng_error(0),
+		m_movie_queued(0),
+		m_movie_stalls(0),
+		m_movie_stall_ticks(0)
 {
 	// request a callback upon exiting
 	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(video_manager::exit), this));
@@ -145,6 +154,14 @@ video_manager::video_manager(running_machine &machine)
 	if (sscanf(machine.options().snap_size(), "%dx%d", &m_snap_width, &m_snap_height) != 2)
 		m_snap_width = m_snap_height = 0;
 
+	// allocate the movie writer queue; frames are written in order on a separate thread,
+	// or here on the emulation thread if the queue can't be had
+	m_movie_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+	if (m_movie_queue == NULL)
+		osd_printf_verbose("Unable to allocate the movie writer queue; movies will be written synchronously\n");
+	for (int itemnum = 0; itemnum < MOVIE_QUEUE_DEPTH; itemnum++)
+		m_movie_item[itemnum].m_manager = this;
+
 	// start recording movie if specified
 	const char *filename = machine.options().mng_write();
 	if (filename[0] != 0)
@@ -317,7 +334,10 @@ void video_manager::save_snapshot(screen_device *screen, emu_file &file)
 	// now do the actual work
 	const rgb_t *palette = (screen !=NULL && screen->palette() != NULL) ? screen->palette()->palette()->entry_list_adjusted() : NULL;
 	int entries = (screen !=NULL && screen->palette() != NULL) ? screen->palette()->entries() : 0;
-	png_error error = png_write_bitmap(file, &pnginfo, m_snap_bitmap, entries, palette);
+	// snapshots are compressed serially if the queue can't be had
+	if (m_snap_queue == NULL)
+		m_snap_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	png_error error = png_write_bitmap(file, &pnginfo, m_snap_bitmap, entries, palette, m_snap_queue);
 	if (error != PNGERR_NONE)
 		osd_printf_error("Error generating PNG for snapshot: png_error = %d\n", error);
 
@@ -377,6 +397,7 @@ void video_manager::begin_recording(const char *name, movie_format format)
 		// reset the state
 		m_avi_frame = 0;
 		m_avi_next_frame_time = machine().time();
+		atomic_exchange32(&m_avi_error, 0);
 
 		// build up information about this new movie
 		avi_movie_info info;
@@ -388,6 +409,13 @@ void video_manager::begin_recording(const char *name, movie_format format)
 		info.video_height = m_snap_bitmap.height();
 		info.video_depth = 24;
 
+		// HuffYUV stores YUY2, which needs an even width
+		if (machine().options().avi_huffyuv() && (info.video_width & 1) == 0)
+		{
+			info.video_format = FORMAT_HFYU;
+			info.video_depth = 16;
+		}
+
 		info.audio_format = 0;
 		info.audio_timescale = machine().sample_rate();
 		info.audio_sampletime = 1;
@@ -435,6 +463,7 @@ void video_manager::begin_recording(const char *name, movie_format format)
 		// reset the state
 		m_mng_frame = 0;
 		m_mng_next_frame_time = machine().time();
+		atomic_exchange32(&m_mng_error, 0);
 
 		// create a new movie file and start recording
 		m_mng_file.reset(global_alloc(emu_file(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS)));
@@ -457,6 +486,10 @@ void video_manager::begin_recording(const char *name, movie_format format)
 
 			// compute the frame time
 			m_mng_frame_period = attotime::from_hz(rate);
+
+			// frames are compressed on their own queue, which only the writer thread uses;
+			// without one, they are compressed serially
+			m_mng_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
 		}
 		else
 		{
@@ -473,13 +506,18 @@ void video_manager::begin_recording(const char *name, movie_format format)
 
 void video_manager::end_recording(movie_format format)
 {
+	bool closed = false;
+
 	if (format == MF_AVI)
 	{
 		// close the file if it exists
 		if (m_avi_file != NULL)
 		{
+			// let the writer finish everything queued so far
+			movie_flush();
 			avi_close(m_avi_file);
 			m_avi_file = NULL;
+			closed = true;
 
 			// reset the state
 			m_avi_frame = 0;
@@ -490,13 +528,32 @@ void video_manager::end_recording(movie_format format)
 		// close the file if it exists
 		if (m_mng_file != NULL)
 		{
+			// let the writer finish everything queued so far
+			movie_flush();
 			mng_capture_stop(*m_mng_file);
 			m_mng_file.reset();
+			if (m_mng_queue != NULL)
+				osd_work_queue_free(m_mng_queue);
+			m_mng_queue = NULL;
+			closed = true;
 
 			// reset the state
 			m_mng_frame = 0;
 		}
 	}
+
+	// once the last movie stops, report how often the writer held us up
+	if (closed && !is_recording())
+	{
+		if (m_movie_stalls != 0)
+			osd_printf_info("Movie recording: emulation waited on a full write queue %d times out of %d (%.2f ms total)\n",
+					m_movie_stalls, m_movie_queued, double(m_movie_stall_ticks) * 1000.0 / double(osd_ticks_per_second()));
+		else
+			osd_printf_verbose("Movie recording: %d items written without waiting on the write queue\n", m_movie_queued);
+		m_movie_queued = 0;
+		m_movie_stalls = 0;
+		m_movie_stall_ticks = 0;
+	}
 }
 
 
@@ -510,14 +567,21 @@ void video_manager::add_sound_to_recording(const INT16 *sound, int numsamples)
 	// only record if we have a file
 	if (m_avi_file != NULL)
 	{
+		// stop if the writer reported an error
+		if (m_avi_error)
+		{
+			end_recording(MF_AVI);
+			return;
+		}
+
 		g_profiler.start(PROFILER_MOVIE_REC);
 
-		// write the next frame
-		avi_error avierr = avi_append_sound_samples(m_avi_file, 0, sound + 0, numsamples, 1);
-		if (avierr == AVIERR_NONE)
-			avierr = avi_append_sound_samples(m_avi_file, 1, sound + 1, numsamples, 1);
-		if (avierr != AVIERR_NONE)
-			end_recording(MF_AVI);
+		// hand a copy of the samples off to the writer
+		movie_work_item &item = movie_acquire_slot();
+		item.m_format = MF_AVI;
+		item.m_is_sound = true;
+		item.m_sound.assign(sound, sound + numsamples * 2);
+		movie_submit_slot(item);
 
 		g_profiler.stop();
 	}
@@ -535,6 +599,15 @@ void video_manager::exit()
 	end_recording(MF_AVI);
 	end_recording(MF_MNG);
 
+	// free the movie writer queue
+	movie_flush();
+	if (m_movie_queue != NULL)
+		osd_work_queue_free(m_movie_queue);
+	m_movie_queue = NULL;
+	if (m_snap_queue != NULL)
+		osd_work_queue_free(m_snap_queue);
+	m_snap_queue = NULL;
+
 	// free the snapshot target
 	machine().render().target_free(m_snap_target);
 	m_snap_bitmap.reset();
@@ -1242,6 +1315,12 @@ void video_manager::record_frame()
 	if (m_mng_file == NULL && m_avi_file == NULL && !m_dummy_recording)
 		return;
 
+	// stop any recording whose writer has reported an error
+	if (m_avi_file != NULL && m_avi_error)
+		end_recording(MF_AVI);
+	if (m_mng_file != NULL && m_mng_error)
+		end_recording(MF_MNG);
+
 	// start the profiler and get the current time
 	g_profiler.start(PROFILER_MOVIE_REC);
 	attotime curtime = machine().time();
@@ -1252,33 +1331,192 @@ void video_manager::record_frame()
 	// handle an AVI recording
 	if (m_avi_file != NULL)
 	{
-		// loop until we hit the right time
+		// count how many frames we owe the movie
+		UINT32 repeat = 0;
 		while (m_avi_next_frame_time <= curtime)
 		{
-			// write the next frame
-			avi_error avierr = avi_append_video_frame(m_avi_file, m_snap_bitmap);
-			if (avierr != AVIERR_NONE)
-			{
-				g_profiler.stop();
-				end_recording(MF_AVI);
-				break;
-			}
-
-			// advance time
 			m_avi_next_frame_time += m_avi_frame_period;
-			m_avi_frame++;
+			repeat++;
+		}
+
+		// hand a copy of the frame off to the writer
+		if (repeat != 0)
+		{
+			movie_work_item &item = movie_acquire_slot();
+			item.m_format = MF_AVI;
+			item.m_is_sound = false;
+			item.m_framenum = m_avi_frame;
+			item.m_repeat = repeat;
+			if (item.m_bitmap.width() != m_snap_bitmap.width() || item.m_bitmap.height() != m_snap_bitmap.height())
+				item.m_bitmap.allocate(m_snap_bitmap.width(), m_snap_bitmap.height());
+			copybitmap(item.m_bitmap, m_snap_bitmap, 0, 0, 0, 0, m_snap_bitmap.cliprect());
+			movie_submit_slot(item);
+			m_avi_frame += repeat;
 		}
 	}
 
 	// handle a MNG recording
 	if (m_mng_file != NULL)
 	{
-		// loop until we hit the right time
+		// count how many frames we owe the movie
+		UINT32 repeat = 0;
 		while (m_mng_next_frame_time <= curtime)
+		{
+			m_mng_next_frame_time += m_mng_frame_period;
+			repeat++;
+		}
+
+		// hand a copy of the frame and palette off to the writer
+		if (repeat != 0)
+		{
+			movie_work_item &item = movie_acquire_slot();
+			item.m_format = MF_MNG;
+			item.m_is_sound = false;
+			item.m_framenum = m_mng_frame;
+			item.m_repeat = repeat;
+			if (item.m_bitmap.width() != m_snap_bitmap.width() || item.m_bitmap.height() != m_snap_bitmap.height())
+				item.m_bitmap.allocate(m_snap_bitmap.width(), m_snap_bitmap.height());
+			copybitmap(item.m_bitmap, m_snap_bitmap, 0, 0, 0, 0, m_snap_bitmap.cliprect());
+			item.m_palette.clear();
+			screen_device *screen = machine().first_screen();
+			if (screen != NULL && screen->palette() != NULL)
+			{
+				const rgb_t *palette = screen->palette()->palette()->entry_list_adjusted();
+				item.m_palette.assign(palette, palette + screen->palette()->entries());
+			}
+			movie_submit_slot(item);
+			m_mng_frame += repeat;
+		}
+	}
+
+	g_profiler.stop();
+}
+
+
+//-------------------------------------------------
+//  movie_acquire_slot - return the next free slot
+//  in the movie writer queue, waiting for the
+//  writer if the queue is full
+//-------------------------------------------------
+
+video_manager::movie_work_item &video_manager::movie_acquire_slot()
+{
+	movie_work_item &item = m_movie_item[m_movie_next_item];
+
+	// if this slot is still in flight, the queue is full; wait for it and track the stall
+	if (item.m_osd != NULL)
+	{
+		if (!osd_work_item_wait(item.m_osd, 0))
+		{
+			osd_ticks_t start = osd_ticks();
+			while (!osd_work_item_wait(item.m_osd, osd_ticks_per_second())) { }
+			m_movie_stall_ticks += osd_ticks() - start;
+			m_movie_stalls++;
+		}
+		osd_work_item_release(item.m_osd);
+		item.m_osd = NULL;
+	}
+	return item;
+}
+
+
+//-------------------------------------------------
+//  movie_submit_slot - queue a filled slot to the
+//  movie writer
+//-------------------------------------------------
+
+void video_manager::movie_submit_slot(movie_work_item &item)
+{
+	assert(&item == &m_movie_item[m_movie_next_item]);
+	item.m_osd = (m_movie_queue != NULL) ? osd_work_item_queue(m_movie_queue, movie_work_static, &item, 0) : NULL;
+
+	// if we couldn't queue it, just do the work here
+	if (item.m_osd == NULL)
+		movie_work(item);
+
+	m_movie_next_item = (m_movie_next_item + 1) % MOVIE_QUEUE_DEPTH;
+	m_movie_queued++;
+}
+
+
+//-------------------------------------------------
+//  movie_flush - wait for the movie writer to
+//  finish everything queued so far
+//-------------------------------------------------
+
+void video_manager::movie_flush()
+{
+	for (int itemnum = 0; itemnum < MOVIE_QUEUE_DEPTH; itemnum++)
+	{
+		movie_work_item &item = m_movie_item[itemnum];
+		if (item.m_osd != NULL)
+		{
+			// a slot can only be reused or released once the writer is done with its frame,
+			// so keep waiting however long the disk takes
+			while (!osd_work_item_wait(item.m_osd, 30 * osd_ticks_per_second()))
+				osd_printf_warning("Movie writer has not finished after 30 seconds; still waiting\n");
+			osd_work_item_release(item.m_osd);
+			item.m_osd = NULL;
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  movie_work - convert, compress and write a
+//  queued slot; runs on the writer thread
+//-------------------------------------------------
+
+void *video_manager::movie_work_static(void *param, int threadid)
+{
+	movie_work_item *item = reinterpret_cast<movie_work_item *>(param);
+	item->m_manager->movie_work(*item);
+	return NULL;
+}
+
+void video_manager::movie_work(movie_work_item &item)
+{
+	// handle an AVI slot
+	if (item.m_format == MF_AVI)
+	{
+		// ignore everything once an error has occurred
+		if (m_avi_error || m_avi_file == NULL)
+			return;
+
+		// sound is appended one channel at a time
+		avi_error avierr = AVIERR_NONE;
+		if (item.m_is_sound)
+		{
+			int numsamples = item.m_sound.size() / 2;
+			avierr = avi_append_sound_samples(m_avi_file, 0, &item.m_sound[0] + 0, numsamples, 1);
+			if (avierr == AVIERR_NONE)
+				avierr = avi_append_sound_samples(m_avi_file, 1, &item.m_sound[0] + 1, numsamples, 1);
+		}
+
+		// video is written once per owed frame
+		else
+		{
+			for (UINT32 framenum = 0; framenum < item.m_repeat && avierr == AVIERR_NONE; framenum++)
+				avierr = avi_append_video_frame(m_avi_file, item.m_bitmap);
+		}
+
+		if (avierr != AVIERR_NONE)
+			atomic_exchange32(&m_avi_error, 1);
+	}
+
+	// handle an MNG slot
+	else if (item.m_format == MF_MNG)
+	{
+		// ignore everything once an error has occurred
+		if (m_mng_error || m_mng_file == NULL)
+			return;
+
+		const rgb_t *palette = item.m_palette.empty() ? NULL : &item.m_palette[0];
+		for (UINT32 framenum = 0; framenum < item.m_repeat; framenum++)
 		{
 			// set up the text fields in the movie info
 			png_info pnginfo = { 0 };
-			if (m_mng_frame == 0)
+			if (item.m_framenum + framenum == 0)
 			{
 				std::string text1 = std::string(emulator_info::get_appname()).append(" ").append(build_version);
 				std::string text2 = std::string(machine().system().manufacturer).append(" ").append(machine().system().description);
@@ -1287,24 +1525,15 @@ void video_manager::record_frame()
 			}
 
 			// write the next frame
-			const rgb_t *palette = (machine().first_screen() !=NULL && machine().first_screen()->palette() != NULL) ? machine().first_screen()->palette()->palette()->entry_list_adjusted() : NULL;
-			int entries = (machine().first_screen() !=NULL && machine().first_screen()->palette() != NULL) ? machine().first_screen()->palette()->entries() : 0;
-			png_error error = mng_capture_frame(*m_mng_file, &pnginfo, m_snap_bitmap, entries, palette);
+			png_error error = mng_capture_frame(*m_mng_file, &pnginfo, item.m_bitmap, item.m_palette.size(), palette, m_mng_queue);
 			png_free(&pnginfo);
 			if (error != PNGERR_NONE)
 			{
-				g_profiler.stop();
-				end_recording(MF_MNG);
+				atomic_exchange32(&m_mng_error, 1);
 				break;
 			}
-
-			// advance time
-			m_mng_next_frame_time += m_mng_frame_period;
-			m_mng_frame++;
 		}
 	}
-
-	g_profiler.stop();
 }
 
 //-------------------------------------------------
@@ -94,6 +94,29 @@ public:
 	void add_sound_to_recording(const INT16 *sound, int numsamples);
 
 private:
+	// a single slot in the movie writer queue
+	struct movie_work_item
+	{
+		movie_work_item()
+			: m_osd(NULL),
+				m_manager(NULL),
+				m_format(MF_AVI),
+				m_is_sound(false),
+				m_framenum(0),
+				m_repeat(0) { }
+
+		osd_work_item *     m_osd;              // OSD work item running on this slot
+		video_manager *     m_manager;          // pointer back to the manager
+		movie_format        m_format;           // format this slot is destined for
+		bool                m_is_sound;         // true if this slot holds sound rather than video
+		UINT32              m_framenum;         // movie frame number of the first frame
+		UINT32              m_repeat;           // number of times to write the frame
+		bitmap_rgb32        m_bitmap;           // private copy of the snapshot bitmap
+		std::vector<rgb_t>  m_palette;          // private copy of the palette (MNG only)
+		std::vector<INT16>  m_sound;            // interleaved stereo samples (AVI only)
+	};
+
+
 	// internal helpers
 	void exit();
 	void screenless_update_callback(void *ptr, int param);
@@ -118,6 +141,13 @@ private:
 	file_error open_next(emu_file &file, const char *extension);
 	void record_frame();
 
+	// movie writer helpers
+	movie_work_item &movie_acquire_slot();
+	void movie_submit_slot(movie_work_item &item);
+	void movie_flush();
+	static void *movie_work_static(void *param, int threadid);
+	void movie_work(movie_work_item &item);
+
 	// internal state
 	running_machine &   m_machine;                  // reference to our machine
 
@@ -164,10 +194,12 @@ private:
 	bool                m_snap_native;              // are we using native per-screen layouts?
 	INT32               m_snap_width;               // width of snapshots (0 == auto)
 	INT32               m_snap_height;              // height of snapshots (0 == auto)
+	osd_work_queue *    m_snap_queue;               // multi-threaded queue for compressing snapshots
 
 	// movie recording - MNG
 	auto_pointer<emu_file> m_mng_file;              // handle to the open movie file
 	attotime            m_mng_frame_period;         // period of a single movie frame
+	osd_work_queue *    m_mng_queue;                // multi-threaded queue the writer compresses frames on
 	attotime            m_mng_next_frame_time;      // time of next frame
 	UINT32              m_mng_frame;                // current movie frame number
 
@@ -180,6 +212,17 @@ private:
 	// movie recording - dummy
 	bool                m_dummy_recording;          // indicates if snapshot should be created of every frame
 
+	// movie recording - asynchronous writer
+	static const int MOVIE_QUEUE_DEPTH = 16;
+	osd_work_queue *    m_movie_queue;              // I/O queue that converts, compresses and writes frames
+	movie_work_item     m_movie_item[MOVIE_QUEUE_DEPTH]; // ring of pending frames and sound
+	UINT32              m_movie_next_item;          // index of the next slot to fill
+	volatile INT32      m_avi_error;                // set by the writer when an AVI write fails
+	volatile INT32      m_mng_error;                // set by the writer when an MNG write fails
+	UINT32              m_movie_queued;             // number of slots queued since recording began
+	UINT32              m_movie_stalls;             // number of times the queue was full
+	osd_ticks_t         m_movie_stall_ticks;        // total time spent waiting on a full queue
+
 	static const UINT8      s_skiptable[FRAMESKIP_LEVELS][FRAMESKIP_LEVELS];
 
 	static const attoseconds_t ATTOSECONDS_PER_SPEED_UPDATE = ATTOSECONDS_PER_SECOND / 4;
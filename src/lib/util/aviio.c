@@ -12,6 +12,11 @@
 #include <assert.h>
 
 #include "aviio.h"
+#include "huffman.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 
 /***************************************************************************
@@ -221,6 +226,14 @@
 
 #define HUFFYUV_PREDICT_DECORR   0x40
 
+/**
+ * @def HUFFYUV_MAX_TABLE_BYTES
+ *
+ * @brief   Maximum size of the three run-length encoded HuffYUV code length tables.
+ */
+
+#define HUFFYUV_MAX_TABLE_BYTES  (3 * 256)
+
 
 
 /***************************************************************************
@@ -293,6 +306,30 @@ struct huffyuv_data
 	huffyuv_table       table[3];               /* array of tables */
 };
 
+/**
+ * @struct  huffyuv_encoder
+ *
+ * @brief   A huffyuv encoder.
+ */
+
+struct huffyuv_encoder
+{
+	/** @brief  The predictor. */
+	UINT8               predictor;              /* predictor */
+	/** @brief  true if the tables have been computed from real data. */
+	bool                tables_valid;           /* have the tables been built from a frame yet? */
+	/** @brief  The table[ 3]. */
+	huffman_encoder<>   table[3];               /* Y, Cb and Cr encoders */
+	/** @brief  The plane[ 3]. */
+	dynamic_buffer      plane[3];               /* Y, Cb and Cr source planes */
+	/** @brief  The residual[ 3]. */
+	dynamic_buffer      residual[3];            /* Y, Cb and Cr prediction residuals */
+	/** @brief  The planestride[ 3]. */
+	UINT32              planestride[3];         /* bytes per row in each plane */
+	/** @brief  The converted bitmap. */
+	bitmap_yuy16        convert;                /* scratch bitmap for RGB input */
+};
+
 /**
  * @struct  avi_stream
  *
@@ -330,6 +367,8 @@ struct avi_stream
 	UINT8               interlace;              /* interlace parameters */
 	/** @brief  The huffyuv. */
 	huffyuv_data *      huffyuv;                /* huffyuv decompression data */
+	/** @brief  The huffyuv encoder. */
+	huffyuv_encoder *   huffyuv_enc;            /* huffyuv compression data */
 
 	/** @brief  The channels. */
 	UINT16              channels;               /* audio channels */
@@ -341,6 +380,8 @@ struct avi_stream
 	/* only used when creating */
 	/** @brief  The saved strh offset. */
 	UINT64              saved_strh_offset;      /* writeoffset of strh chunk */
+	/** @brief  The saved strf offset. */
+	UINT64              saved_strf_offset;      /* writeoffset of strf chunk */
 	/** @brief  The saved indx offset. */
 	UINT64              saved_indx_offset;      /* writeoffset of indx chunk */
 };
@@ -436,7 +477,7 @@ static avi_error chunk_overwrite(avi_file *file, UINT32 type, const void *data,
 static avi_error write_initial_headers(avi_file *file);
 static avi_error write_avih_chunk(avi_file *file, int initial_write);
 static avi_error write_strh_chunk(avi_file *file, avi_stream *stream, int initial_write);
-static avi_error write_strf_chunk(avi_file *file, avi_stream *stream);
+static avi_error write_strf_chunk(avi_file *file, avi_stream *stream, int initial_write);
 static avi_error write_indx_chunk(avi_file *file, avi_stream *stream, int initial_write);
 static avi_error write_idx1_chunk(avi_file *file);
 
@@ -447,6 +488,7 @@ static avi_error soundbuf_flush(avi_file *file, int only_flush_full);
 
 /* RGB helpers */
 static avi_error rgb32_compress_to_rgb(avi_stream *stream, const bitmap_rgb32 &bitmap, UINT8 *data, UINT32 numbytes);
+static void rgb32_convert_to_yuy16(const bitmap_rgb32 &source, bitmap_yuy16 &dest);
 
 /* YUY helpers */
 static avi_error yuv_decompress_to_yuy16(avi_stream *stream, const UINT8 *data, UINT32 numbytes, bitmap_yuy16 &bitmap);
@@ -455,6 +497,10 @@ static avi_error yuy16_compress_to_yuy(avi_stream *stream, const bitmap_yuy16 &b
 /* HuffYUV helpers */
 static avi_error huffyuv_extract_tables(avi_stream *stream, const UINT8 *chunkdata, UINT32 size);
 static avi_error huffyuv_decompress_to_yuy16(avi_stream *stream, const UINT8 *data, UINT32 numbytes, bitmap_yuy16 &bitmap);
+static avi_error huffyuv_create_encoder(avi_stream *stream);
+static UINT32 huffyuv_write_tables(huffyuv_encoder *encoder, UINT8 *dest);
+static avi_error huffyuv_compress_from_yuy16(avi_stream *stream, const bitmap_yuy16 &bitmap, UINT8 *data, UINT32 numbytes, UINT32 *complength);
+static avi_error huffyuv_append_video_frame(avi_file *file, avi_stream *stream, const bitmap_yuy16 &bitmap);
 
 /* debugging */
 static void printf_chunk_recursive(avi_file *file, avi_chunk *chunk, int indent);
@@ -828,6 +874,33 @@ INLINE avi_error expand_tempbuffer(avi_file *file, UINT32 length)
 }
 
 
+/*-------------------------------------------------
+    huffyuv_median - compute the HuffYUV median
+    prediction from the previous, above and
+    above-left values
+-------------------------------------------------*/
+
+/**
+ * @fn  INLINE UINT8 huffyuv_median(UINT8 left, UINT8 top, UINT8 topleft)
+ *
+ * @brief   Huffyuv median.
+ *
+ * @param   left    The previous value.
+ * @param   top     The value above.
+ * @param   topleft The value above and to the left.
+ *
+ * @return  The median of left, top and (left + top - topleft).
+ */
+
+INLINE UINT8 huffyuv_median(UINT8 left, UINT8 top, UINT8 topleft)
+{
+	UINT8 gradient = left + top - topleft;
+	UINT8 lo = MIN(left, top);
+	UINT8 hi = MAX(left, top);
+	return MAX(lo, MIN(hi, gradient));
+}
+
+
 
 /***************************************************************************
     IMPLEMENTATION
@@ -921,12 +994,16 @@ avi_error avi_create(const char *filename, const avi_movie_info *info, avi_file
 	UINT64 length;
 
 	/* validate video info */
-	if ((info->video_format != 0 && info->video_format != FORMAT_UYVY && info->video_format != FORMAT_VYUY && info->video_format != FORMAT_YUY2)  ||
+	if ((info->video_format != 0 && info->video_format != FORMAT_UYVY && info->video_format != FORMAT_VYUY && info->video_format != FORMAT_YUY2 && info->video_format != FORMAT_HFYU)  ||
 		info->video_width == 0 ||
 		info->video_height == 0 ||
 		info->video_depth == 0 || info->video_depth % 8 != 0)
 		return AVIERR_UNSUPPORTED_VIDEO_FORMAT;
 
+	/* HuffYUV output is always 16bpp YUY2 with pixels in pairs */
+	if (info->video_format == FORMAT_HFYU && (info->video_depth != 16 || info->video_width % 2 != 0))
+		return AVIERR_UNSUPPORTED_VIDEO_FORMAT;
+
 	/* validate audio info */
 	if (info->audio_format != 0 ||
 		info->audio_channels > MAX_SOUND_CHANNELS ||
@@ -972,6 +1049,14 @@ avi_error avi_create(const char *filename, const avi_movie_info *info, avi_file
 	stream->height = newfile->info.video_height;
 	stream->depth = newfile->info.video_depth;
 
+	/* HuffYUV needs an encoder before the headers can be written */
+	if (stream->format == FORMAT_HFYU)
+	{
+		avierr = huffyuv_create_encoder(stream);
+		if (avierr != AVIERR_NONE)
+			goto error;
+	}
+
 	/* initialize the audio track */
 	if (newfile->info.audio_channels > 0)
 	{
@@ -1003,7 +1088,10 @@ error:
 	if (newfile != NULL)
 	{
 		if (newfile->stream != NULL)
+		{
+			delete newfile->stream[0].huffyuv_enc;
 			free(newfile->stream);
+		}
 		if (newfile->file != NULL)
 		{
 			osd_close(newfile->file);
@@ -1083,6 +1171,7 @@ avi_error avi_close(avi_file *file)
 					free(huffyuv->table[table].extralookup);
 			free(huffyuv);
 		}
+		delete stream->huffyuv_enc;
 		if (stream->chunk != NULL)
 			free(stream->chunk);
 	}
@@ -1418,6 +1507,10 @@ avi_error avi_append_video_frame(avi_file *file, bitmap_yuy16 &bitmap)
 	if (stream->format != FORMAT_UYVY && stream->format != FORMAT_VYUY && stream->format != FORMAT_YUY2 && stream->format != FORMAT_HFYU)
 		return AVIERR_UNSUPPORTED_VIDEO_FORMAT;
 
+	/* HuffYUV has its own path */
+	if (stream->format == FORMAT_HFYU)
+		return huffyuv_append_video_frame(file, stream, bitmap);
+
 	/* write out any sound data first */
 	avierr = soundbuf_write_chunk(file, stream->chunks);
 	if (avierr != AVIERR_NONE)
@@ -1472,6 +1565,13 @@ avi_error avi_append_video_frame(avi_file *file, bitmap_rgb32 &bitmap)
 	avi_error avierr;
 	UINT32 maxlength;
 
+	/* HuffYUV streams take RGB data by converting it to YUY16 first */
+	if (stream->format == FORMAT_HFYU)
+	{
+		rgb32_convert_to_yuy16(bitmap, stream->huffyuv_enc->convert);
+		return huffyuv_append_video_frame(file, stream, stream->huffyuv_enc->convert);
+	}
+
 	/* validate our ability to handle the data */
 	if (stream->format != 0)
 		return AVIERR_UNSUPPORTED_VIDEO_FORMAT;
@@ -2602,7 +2702,7 @@ static avi_error write_initial_headers(avi_file *file)
 			return avierr;
 
 		/* write the strf chunk */
-		avierr = write_strf_chunk(file, &file->stream[strnum]);
+		avierr = write_strf_chunk(file, &file->stream[strnum], TRUE);
 		if (avierr != AVIERR_NONE)
 			return avierr;
 
@@ -2729,18 +2829,45 @@ static avi_error write_strh_chunk(avi_file *file, avi_stream *stream, int initia
 -------------------------------------------------*/
 
 /**
- * @fn  static avi_error write_strf_chunk(avi_file *file, avi_stream *stream)
+ * @fn  static avi_error write_strf_chunk(avi_file *file, avi_stream *stream, int initial_write)
  *
  * @brief   Writes a strf chunk.
  *
  * @param [in,out]  file    If non-null, the file.
  * @param [in,out]  stream  If non-null, the stream.
+ * @param   initial_write   The initial write.
  *
  * @return  An avi_error.
  */
 
-static avi_error write_strf_chunk(avi_file *file, avi_stream *stream)
+static avi_error write_strf_chunk(avi_file *file, avi_stream *stream, int initial_write)
 {
+	/* HuffYUV video stream; the tables are rewritten once the first frame is known */
+	if (stream->type == STREAMTYPE_VIDS && stream->format == FORMAT_HFYU)
+	{
+		UINT8 buffer[40 + 4 + HUFFYUV_MAX_TABLE_BYTES];
+
+		/* reset the buffer */
+		memset(buffer, 0, sizeof(buffer));
+
+		put_32bits(&buffer[0], sizeof(buffer));         /* biSize */
+		put_32bits(&buffer[4], stream->width);          /* biWidth */
+		put_32bits(&buffer[8], stream->height);         /* biHeight */
+		put_16bits(&buffer[12], 1);                     /* biPlanes */
+		put_16bits(&buffer[14], stream->depth);         /* biBitCount */
+		put_32bits(&buffer[16], stream->format);        /* biCompression */
+		put_32bits(&buffer[20],                         /* biSizeImage */
+					stream->width * stream->height * (stream->depth + 7) / 8);
+		buffer[40] = stream->huffyuv_enc->predictor;    /* predictor */
+		buffer[41] = stream->depth;                     /* bits per pixel */
+		buffer[42] = 0;                                 /* interlacing follows the height */
+		buffer[43] = 0;                                 /* no context modelling */
+		huffyuv_write_tables(stream->huffyuv_enc, &buffer[44]);
+
+		/* write the chunk */
+		return chunk_overwrite(file, CHUNKTYPE_STRF, buffer, sizeof(buffer), &stream->saved_strf_offset, initial_write);
+	}
+
 	/* video stream */
 	if (stream->type == STREAMTYPE_VIDS)
 	{
@@ -3208,6 +3335,54 @@ static avi_error rgb32_compress_to_rgb(avi_stream *stream, const bitmap_rgb32 &b
 }
 
 
+/*-------------------------------------------------
+    rgb32_convert_to_yuy16 - convert an RGB32
+    bitmap to a YUY16 bitmap using BT.601
+    coefficients
+-------------------------------------------------*/
+
+/**
+ * @fn  static void rgb32_convert_to_yuy16(const bitmap_rgb32 &source, bitmap_yuy16 &dest)
+ *
+ * @brief   Rgb 32 convert to yuy 16.
+ *
+ * @param   source          The source bitmap.
+ * @param [in,out]  dest    The destination bitmap; reallocated if the size differs.
+ */
+
+static void rgb32_convert_to_yuy16(const bitmap_rgb32 &source, bitmap_yuy16 &dest)
+{
+	int width = source.width() & ~1;
+	int height = source.height();
+
+	/* make sure the destination matches */
+	if (dest.width() != width || dest.height() != height)
+		dest.allocate(width, height);
+
+	for (int y = 0; y < height; y++)
+	{
+		const UINT32 *src = &source.pix32(y);
+		UINT16 *dst = &dest.pix16(y);
+
+		/* each pair of pixels shares one Cb and one Cr sample */
+		for (int x = 0; x < width; x += 2)
+		{
+			rgb_t pix0 = *src++;
+			rgb_t pix1 = *src++;
+			int r = pix0.r() + pix1.r();
+			int g = pix0.g() + pix1.g();
+			int b = pix0.b() + pix1.b();
+			UINT8 y0 = ((66 * pix0.r() + 129 * pix0.g() + 25 * pix0.b() + 128) >> 8) + 16;
+			UINT8 y1 = ((66 * pix1.r() + 129 * pix1.g() + 25 * pix1.b() + 128) >> 8) + 16;
+			UINT8 cb = ((-38 * r - 74 * g + 112 * b + 256) >> 9) + 128;
+			UINT8 cr = ((112 * r - 94 * g - 18 * b + 256) >> 9) + 128;
+			*dst++ = (y0 << 8) | cb;
+			*dst++ = (y1 << 8) | cr;
+		}
+	}
+}
+
+
 /*-------------------------------------------------
     yuv_decompress_to_yuy16 - decompress a YUV
     encoded frame to a YUY16 bitmap
@@ -3343,18 +3518,31 @@ static avi_error huffyuv_extract_tables(avi_stream *stream, const UINT8 *chunkda
 		goto error;
 	}
 
+	/* tables without long codes have no extra lookups to free */
+	memset(stream->huffyuv, 0, sizeof(*stream->huffyuv));
+
 	/* extract predictor information */
-	if (&chunkdata[40] >= chunkend)
-		return AVIERR_INVALID_DATA;
+	if (&chunkdata[41] >= chunkend)
+	{
+		avierr = AVIERR_INVALID_DATA;
+		goto error;
+	}
 	stream->huffyuv->predictor = chunkdata[40];
 
-	/* make sure it's the left predictor */
-	if ((stream->huffyuv->predictor & ~HUFFYUV_PREDICT_DECORR) != HUFFYUV_PREDICT_LEFT)
-		return AVIERR_UNSUPPORTED_VIDEO_FORMAT;
+	/* make sure it's the left or median predictor */
+	if ((stream->huffyuv->predictor & ~HUFFYUV_PREDICT_DECORR) != HUFFYUV_PREDICT_LEFT &&
+		(stream->huffyuv->predictor & ~HUFFYUV_PREDICT_DECORR) != HUFFYUV_PREDICT_MEDIAN)
+	{
+		avierr = AVIERR_UNSUPPORTED_VIDEO_FORMAT;
+		goto error;
+	}
 
 	/* make sure it's 16bpp YUV data */
 	if (chunkdata[41] != 16)
-		return AVIERR_UNSUPPORTED_VIDEO_FORMAT;
+	{
+		avierr = AVIERR_UNSUPPORTED_VIDEO_FORMAT;
+		goto error;
+	}
 	chunkdata += 44;
 
 	/* loop over tables */
@@ -3456,6 +3644,9 @@ static avi_error huffyuv_extract_tables(avi_stream *stream, const UINT8 *chunkda
 error:
 	if (avierr != AVIERR_NONE && stream->huffyuv != NULL)
 	{
+		for (tabnum = 0; tabnum < ARRAY_LENGTH(stream->huffyuv->table); tabnum++)
+			if (stream->huffyuv->table[tabnum].extralookup != NULL)
+				free(stream->huffyuv->table[tabnum].extralookup);
 		free(stream->huffyuv);
 		stream->huffyuv = NULL;
 	}
@@ -3594,9 +3785,10 @@ static avi_error huffyuv_decompress_to_yuy16(avi_stream *stream, const UINT8 *da
 			x = 2;
 		}
 
-		/* left predict or gradient predict */
+		/* left predict or gradient predict; median also left predicts the first rows */
 		if ((huffyuv->predictor & ~HUFFYUV_PREDICT_DECORR) == HUFFYUV_PREDICT_LEFT ||
-			((huffyuv->predictor & ~HUFFYUV_PREDICT_DECORR) == HUFFYUV_PREDICT_GRADIENT))
+			(huffyuv->predictor & ~HUFFYUV_PREDICT_DECORR) == HUFFYUV_PREDICT_GRADIENT ||
+			((huffyuv->predictor & ~HUFFYUV_PREDICT_DECORR) == HUFFYUV_PREDICT_MEDIAN && y < prevlines))
 		{
 			/* first do left deltas */
 			for ( ; x < stream->width; x += 2)
@@ -3625,57 +3817,50 @@ static avi_error huffyuv_decompress_to_yuy16(avi_stream *stream, const UINT8 *da
 				}
 		}
 
-		/* median predict on rows > 0 */
-		else if ((huffyuv->predictor & ~HUFFYUV_PREDICT_DECORR) == HUFFYUV_PREDICT_MEDIAN && y >= prevlines)
+		/* median predict on the remaining rows */
+		else if ((huffyuv->predictor & ~HUFFYUV_PREDICT_DECORR) == HUFFYUV_PREDICT_MEDIAN)
 		{
+			/* the first four pixels of the first median row are still left predicted */
+			if (y == prevlines)
+			{
+				for ( ; x < 4 && x < stream->width; x += 2)
+				{
+					UINT16 pixel0 = dest[x + 0];
+					UINT16 pixel1 = dest[x + 1];
+
+					lasty += pixel0 >> 8;
+					lastcb += pixel0;
+					dest[x + 0] = (lasty << 8) | lastcb;
+
+					lasty += pixel1 >> 8;
+					lastcr += pixel1;
+					dest[x + 1] = (lasty << 8) | lastcr;
+				}
+
+				/* seed the above-left values from the pixels just before the median region */
+				lastprevy = prevrow[x - 1] >> 8;
+				lastprevcb = prevrow[x - 2] & 0xff;
+				lastprevcr = prevrow[x - 1] & 0xff;
+			}
+
 			for ( ; x < stream->width; x += 2)
 			{
 				UINT16 prevpixel0 = prevrow[x + 0];
 				UINT16 prevpixel1 = prevrow[x + 1];
 				UINT16 pixel0 = dest[x + 0];
 				UINT16 pixel1 = dest[x + 1];
-				UINT8 a, b, c;
-
-				/* compute previous, above, and (prev + above - above-left) */
-				a = lasty;
-				b = prevpixel0 >> 8;
-				c = lastprevy;
-				lastprevy = b;
-				if (a > b) { UINT8 tmp = a; a = b; b = tmp; }
-				if (a > c) { UINT8 tmp = a; a = c; c = tmp; }
-				if (b > c) { UINT8 tmp = b; b = c; c = tmp; }
-				lasty = (pixel0 >> 8) + b;
-
-				/* compute previous, above, and (prev + above - above-left) */
-				a = lastcb;
-				b = prevpixel0 & 0xff;
-				c = lastprevcb;
-				lastprevcb = b;
-				if (a > b) { UINT8 tmp = a; a = b; b = tmp; }
-				if (a > c) { UINT8 tmp = a; a = c; c = tmp; }
-				if (b > c) { UINT8 tmp = b; b = c; c = tmp; }
-				lastcb = (pixel0 & 0xff) + b;
+
+				/* predict each component from the median of previous, above, and (previous + above - above-left) */
+				lasty = (pixel0 >> 8) + huffyuv_median(lasty, prevpixel0 >> 8, lastprevy);
+				lastprevy = prevpixel0 >> 8;
+				lastcb = (pixel0 & 0xff) + huffyuv_median(lastcb, prevpixel0 & 0xff, lastprevcb);
+				lastprevcb = prevpixel0 & 0xff;
 				dest[x + 0] = (lasty << 8) | lastcb;
 
-				/* compute previous, above, and (prev + above - above-left) */
-				a = lasty;
-				b = prevpixel1 >> 8;
-				c = lastprevy;
-				lastprevy = b;
-				if (a > b) { UINT8 tmp = a; a = b; b = tmp; }
-				if (a > c) { UINT8 tmp = a; a = c; c = tmp; }
-				if (b > c) { UINT8 tmp = b; b = c; c = tmp; }
-				lasty = (pixel1 >> 8) + b;
-
-				/* compute previous, above, and (prev + above - above-left) */
-				a = lastcr;
-				b = prevpixel1 & 0xff;
-				c = lastprevcr;
-				lastprevcr = b;
-				if (a > b) { UINT8 tmp = a; a = b; b = tmp; }
-				if (a > c) { UINT8 tmp = a; a = c; c = tmp; }
-				if (b > c) { UINT8 tmp = b; b = c; c = tmp; }
-				lastcr = (pixel1 & 0xff) + b;
+				lasty = (pixel1 >> 8) + huffyuv_median(lasty, prevpixel1 >> 8, lastprevy);
+				lastprevy = prevpixel1 >> 8;
+				lastcr = (pixel1 & 0xff) + huffyuv_median(lastcr, prevpixel1 & 0xff, lastprevcr);
+				lastprevcr = prevpixel1 & 0xff;
 				dest[x + 1] = (lasty << 8) | lastcr;
 			}
 		}
@@ -3684,6 +3869,383 @@ static avi_error huffyuv_decompress_to_yuy16(avi_stream *stream, const UINT8 *da
 	return AVIERR_NONE;
 }
 
+
+/*-------------------------------------------------
+    huffyuv_predict_left - compute left prediction
+    residuals for a run of samples; cur[-1] must
+    hold the previous sample
+-------------------------------------------------*/
+
+/**
+ * @fn  static void huffyuv_predict_left(const UINT8 *cur, UINT8 *residual, int count)
+ *
+ * @brief   Huffyuv predict left.
+ *
+ * @param   cur                 The current samples.
+ * @param [in,out]  residual    The residual output.
+ * @param   count               The number of samples.
+ */
+
+static void huffyuv_predict_left(const UINT8 *cur, UINT8 *residual, int count)
+{
+	int i = 0;
+
+#if defined(__SSE2__)
+	for ( ; i + 16 <= count; i += 16)
+	{
+		__m128i left = _mm_loadu_si128((const __m128i *)&cur[i - 1]);
+		__m128i value = _mm_loadu_si128((const __m128i *)&cur[i]);
+		_mm_storeu_si128((__m128i *)&residual[i], _mm_sub_epi8(value, left));
+	}
+#endif
+
+	for ( ; i < count; i++)
+		residual[i] = cur[i] - cur[i - 1];
+}
+
+
+/*-------------------------------------------------
+    huffyuv_predict_median - compute median
+    prediction residuals for a run of samples;
+    cur[-1] and above[-1] must hold the previous
+    and above-left samples
+-------------------------------------------------*/
+
+/**
+ * @fn  static void huffyuv_predict_median(const UINT8 *cur, const UINT8 *above, UINT8 *residual, int count)
+ *
+ * @brief   Huffyuv predict median.
+ *
+ * @param   cur                 The current samples.
+ * @param   above               The samples from the row above.
+ * @param [in,out]  residual    The residual output.
+ * @param   count               The number of samples.
+ */
+
+static void huffyuv_predict_median(const UINT8 *cur, const UINT8 *above, UINT8 *residual, int count)
+{
+	int i = 0;
+
+#if defined(__SSE2__)
+	/* median(a, b, c) == max(min(a, b), min(max(a, b), c)), all unsigned bytes */
+	for ( ; i + 16 <= count; i += 16)
+	{
+		__m128i left = _mm_loadu_si128((const __m128i *)&cur[i - 1]);
+		__m128i top = _mm_loadu_si128((const __m128i *)&above[i]);
+		__m128i topleft = _mm_loadu_si128((const __m128i *)&above[i - 1]);
+		__m128i gradient = _mm_sub_epi8(_mm_add_epi8(left, top), topleft);
+		__m128i lo = _mm_min_epu8(left, top);
+		__m128i hi = _mm_max_epu8(left, top);
+		__m128i median = _mm_max_epu8(lo, _mm_min_epu8(hi, gradient));
+		__m128i value = _mm_loadu_si128((const __m128i *)&cur[i]);
+		_mm_storeu_si128((__m128i *)&residual[i], _mm_sub_epi8(value, median));
+	}
+#endif
+
+	for ( ; i < count; i++)
+		residual[i] = cur[i] - huffyuv_median(cur[i - 1], above[i], above[i - 1]);
+}
+
+
+/*-------------------------------------------------
+    huffyuv_create_encoder - allocate the HuffYUV
+    encoder for a stream we are creating
+-------------------------------------------------*/
+
+/**
+ * @fn  static avi_error huffyuv_create_encoder(avi_stream *stream)
+ *
+ * @brief   Huffyuv create encoder.
+ *
+ * @param [in,out]  stream  If non-null, the stream.
+ *
+ * @return  An avi_error.
+ */
+
+static avi_error huffyuv_create_encoder(avi_stream *stream)
+{
+	huffyuv_encoder *encoder = new huffyuv_encoder;
+	stream->huffyuv_enc = encoder;
+	encoder->predictor = HUFFYUV_PREDICT_MEDIAN;
+	encoder->tables_valid = false;
+
+	/* each plane row has 16 bytes in front so that [-1] is always addressable */
+	for (int plane = 0; plane < 3; plane++)
+	{
+		UINT32 count = (plane == 0) ? stream->width : stream->width / 2;
+		encoder->planestride[plane] = (16 + count + 15) & ~15;
+		encoder->plane[plane].resize(encoder->planestride[plane] * stream->height + 16);
+		encoder->residual[plane].resize(encoder->planestride[plane] * stream->height + 16);
+	}
+
+	/* until we see real data, use flat 8-bit codes so the header is always valid */
+	for (int tabnum = 0; tabnum < 3; tabnum++)
+	{
+		huffman_encoder<> &table = encoder->table[tabnum];
+		table.histo_reset();
+		for (int value = 0; value < 256; value++)
+			table.histo_one(value);
+		if (table.compute_tree_from_histo() != HUFFERR_NONE)
+			return AVIERR_INVALID_DATA;
+	}
+	return AVIERR_NONE;
+}
+
+
+/*-------------------------------------------------
+    huffyuv_write_tables - write the run-length
+    encoded code lengths in HuffYUV strf format
+-------------------------------------------------*/
+
+/**
+ * @fn  static UINT32 huffyuv_write_tables(huffyuv_encoder *encoder, UINT8 *dest)
+ *
+ * @brief   Huffyuv write tables.
+ *
+ * @param [in,out]  encoder If non-null, the encoder.
+ * @param [in,out]  dest    Destination, at least HUFFYUV_MAX_TABLE_BYTES long.
+ *
+ * @return  The number of bytes written.
+ */
+
+static UINT32 huffyuv_write_tables(huffyuv_encoder *encoder, UINT8 *dest)
+{
+	UINT8 *start = dest;
+
+	for (int tabnum = 0; tabnum < 3; tabnum++)
+	{
+		const huffman_encoder<> &table = encoder->table[tabnum];
+		for (int offset = 0; offset < 256; )
+		{
+			/* count the run of identical lengths */
+			UINT8 length = table.code_length(offset);
+			int count = 1;
+			while (offset + count < 256 && count < 255 && table.code_length(offset + count) == length)
+				count++;
+
+			/* short runs fit in the top 3 bits; longer ones take a whole extra byte */
+			if (count < 8)
+				*dest++ = length | (count << 5);
+			else
+			{
+				*dest++ = length;
+				*dest++ = count;
+			}
+			offset += count;
+		}
+	}
+
+	assert(dest - start <= HUFFYUV_MAX_TABLE_BYTES);
+	return dest - start;
+}
+
+
+/*-------------------------------------------------
+    huffyuv_compress_from_yuy16 - compress a YUY16
+    bitmap to a HuffYUV-encoded frame
+-------------------------------------------------*/
+
+/**
+ * @fn  static avi_error huffyuv_compress_from_yuy16(avi_stream *stream, const bitmap_yuy16 &bitmap, UINT8 *data, UINT32 numbytes, UINT32 *complength)
+ *
+ * @brief   Huffyuv compress from yuy 16.
+ *
+ * @param [in,out]  stream      If non-null, the stream.
+ * @param   bitmap              The bitmap.
+ * @param [in,out]  data        If non-null, the data.
+ * @param   numbytes            The numbytes.
+ * @param [in,out]  complength  Receives the compressed length.
+ *
+ * @return  An avi_error.
+ */
+
+static avi_error huffyuv_compress_from_yuy16(avi_stream *stream, const bitmap_yuy16 &bitmap, UINT8 *data, UINT32 numbytes, UINT32 *complength)
+{
+	huffyuv_encoder *encoder = stream->huffyuv_enc;
+	int prevlines = (stream->height > 288) ? 2 : 1;
+	int width = MIN(stream->width, bitmap.width());
+	int height = MIN(stream->height, bitmap.height());
+	UINT8 *plane[3], *residual[3];
+	int x, y, p;
+
+	/* split the bitmap into Y, Cb and Cr planes */
+	for (y = 0; y < stream->height; y++)
+	{
+		for (p = 0; p < 3; p++)
+		{
+			int count = (p == 0) ? stream->width : stream->width / 2;
+			plane[p] = &encoder->plane[p][y * encoder->planestride[p] + 16];
+
+			/* the byte in front of each row is the last value of the previous row */
+			plane[p][-1] = (y == 0) ? 0 : plane[p][count - 1 - (int)encoder->planestride[p]];
+		}
+
+		const UINT16 *source = (y < height) ? &bitmap.pix16(y) : NULL;
+		for (x = 0; x < stream->width; x += 2)
+		{
+			UINT16 pixel0 = (source != NULL && x < width) ? source[x + 0] : 0;
+			UINT16 pixel1 = (source != NULL && x < width) ? source[x + 1] : 0;
+			plane[0][x + 0] = pixel0 >> 8;
+			plane[0][x + 1] = pixel1 >> 8;
+			plane[1][x / 2] = pixel0;
+			plane[2][x / 2] = pixel1;
+		}
+	}
+
+	/* compute the residuals: left predict the first rows, and median predict the rest */
+	for (y = 0; y < stream->height; y++)
+		for (p = 0; p < 3; p++)
+		{
+			int count = (p == 0) ? stream->width : stream->width / 2;
+			const UINT8 *cur = &encoder->plane[p][y * encoder->planestride[p] + 16];
+			UINT8 *res = &encoder->residual[p][y * encoder->planestride[p] + 16];
+			int start = (y == 0) ? ((p == 0) ? 2 : 1) : 0;
+			int leftend = count;
+
+			/* the first four pixels of the first median row are still left predicted */
+			if (y == prevlines)
+				leftend = MIN(count, (p == 0) ? 4 : 2);
+			else if (y > prevlines)
+				leftend = 0;
+
+			if (leftend > start)
+				huffyuv_predict_left(cur + start, res + start, leftend - start);
+			if (leftend < count)
+				huffyuv_predict_median(cur + leftend, cur + leftend - prevlines * encoder->planestride[p], res + leftend, count - leftend);
+		}
+
+	/* the first frame determines the tables for the whole movie */
+	if (!encoder->tables_valid)
+	{
+		for (p = 0; p < 3; p++)
+		{
+			huffman_encoder<> &table = encoder->table[p];
+			int count = (p == 0) ? stream->width : stream->width / 2;
+
+			/* every value needs a code, since later frames may use values this one doesn't */
+			table.histo_reset();
+			for (x = 0; x < 256; x++)
+				table.histo_one(x);
+			for (y = 0; y < stream->height; y++)
+			{
+				const UINT8 *res = &encoder->residual[p][y * encoder->planestride[p] + 16];
+				for (x = (y == 0) ? ((p == 0) ? 2 : 1) : 0; x < count; x++)
+					table.histo_one(res[x]);
+			}
+			if (table.compute_tree_from_histo() != HUFFERR_NONE)
+				return AVIERR_INVALID_DATA;
+		}
+		encoder->tables_valid = true;
+	}
+
+	/* first DWORD is stored as YUY2 */
+	if (numbytes < 4)
+		return AVIERR_INVALID_BITMAP;
+	data[0] = encoder->plane[0][16 + 0];
+	data[1] = encoder->plane[1][16 + 0];
+	data[2] = encoder->plane[0][16 + 1];
+	data[3] = encoder->plane[2][16 + 0];
+
+	/* encode Y, then the Cb or Cr that goes with it */
+	bitstream_out bitbuf(data + 4, numbytes - 4);
+	for (y = 0; y < stream->height; y++)
+	{
+		for (p = 0; p < 3; p++)
+			residual[p] = &encoder->residual[p][y * encoder->planestride[p] + 16];
+		for (x = (y == 0) ? 2 : 0; x < stream->width; x += 2)
+		{
+			encoder->table[0].encode_one(bitbuf, residual[0][x + 0]);
+			encoder->table[1].encode_one(bitbuf, residual[1][x / 2]);
+			encoder->table[0].encode_one(bitbuf, residual[0][x + 1]);
+			encoder->table[2].encode_one(bitbuf, residual[2][x / 2]);
+		}
+	}
+	UINT32 bytes = bitbuf.flush();
+	if (bitbuf.overflow())
+		return AVIERR_INVALID_BITMAP;
+
+	/* pad out to a whole DWORD */
+	while (bytes % 4 != 0)
+	{
+		if (4 + bytes >= numbytes)
+			return AVIERR_INVALID_BITMAP;
+		data[4 + bytes++] = 0;
+	}
+
+	/* they store little-endian DWORDs, so swap each one */
+	for (UINT32 offs = 4; offs < 4 + bytes; offs += 4)
+	{
+		UINT8 temp = data[offs + 0]; data[offs + 0] = data[offs + 3]; data[offs + 3] = temp;
+		temp = data[offs + 1]; data[offs + 1] = data[offs + 2]; data[offs + 2] = temp;
+	}
+
+	*complength = 4 + bytes;
+	return AVIERR_NONE;
+}
+
+
+/*-------------------------------------------------
+    huffyuv_append_video_frame - compress and
+    append a frame to a HuffYUV stream
+-------------------------------------------------*/
+
+/**
+ * @fn  static avi_error huffyuv_append_video_frame(avi_file *file, avi_stream *stream, const bitmap_yuy16 &bitmap)
+ *
+ * @brief   Huffyuv append video frame.
+ *
+ * @param [in,out]  file    If non-null, the file.
+ * @param [in,out]  stream  If non-null, the stream.
+ * @param   bitmap          The bitmap.
+ *
+ * @return  An avi_error.
+ */
+
+static avi_error huffyuv_append_video_frame(avi_file *file, avi_stream *stream, const bitmap_yuy16 &bitmap)
+{
+	bool tables_valid = stream->huffyuv_enc->tables_valid;
+	avi_error avierr;
+	UINT32 maxlength, complength;
+
+	/* write out any sound data first */
+	avierr = soundbuf_write_chunk(file, stream->chunks);
+	if (avierr != AVIERR_NONE)
+		return avierr;
+
+	/* worst case is 16 bits for each of the two codes per pixel, plus padding */
+	maxlength = 4 * stream->width * stream->height + 8;
+	avierr = expand_tempbuffer(file, maxlength);
+	if (avierr != AVIERR_NONE)
+		return avierr;
+
+	/* now compress the data */
+	avierr = huffyuv_compress_from_yuy16(stream, bitmap, file->tempbuffer, maxlength, &complength);
+	if (avierr != AVIERR_NONE)
+		return avierr;
+
+	/* if this frame built the tables, update the header to match */
+	if (!tables_valid)
+	{
+		avierr = write_strf_chunk(file, stream, FALSE);
+		if (avierr != AVIERR_NONE)
+			return avierr;
+	}
+
+	/* write the data */
+	avierr = chunk_write(file, get_chunkid_for_stream(file, stream), file->tempbuffer, complength);
+	if (avierr != AVIERR_NONE)
+		return avierr;
+
+	/* set the info for this new chunk */
+	avierr = set_stream_chunk_info(stream, stream->chunks, file->writeoffs - complength - 8, complength + 8);
+	if (avierr != AVIERR_NONE)
+		return avierr;
+
+	stream->samples = file->info.video_numsamples = stream->chunks;
+
+	return AVIERR_NONE;
+}
+
 /**
  * @fn  static void u64toa(UINT64 val, char *output)
  *
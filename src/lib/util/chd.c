@@ -189,6 +189,15 @@ inline void chd_file::file_read(UINT64 offset, void *dest, UINT32 length)
 	if (m_file == NULL)
 		throw CHDERR_NOT_OPEN;
 
+	// if the file is mapped, copy straight out of the view
+	if (m_mapped != NULL)
+	{
+		if (offset > m_mappedbytes || length > m_mappedbytes - offset)
+			throw CHDERR_READ_ERROR;
+		memcpy(dest, m_mapped + offset, length);
+		return;
+	}
+
 	// seek and read
 	core_fseek(m_file, offset, SEEK_SET);
 	UINT32 count = core_fread(m_file, dest, length);
@@ -289,10 +298,12 @@ inline UINT8 chd_file::bits_for_value(UINT64 value)
 
 chd_file::chd_file()
 	: m_file(NULL),
-		m_owns_file(false)
+		m_owns_file(false),
+		m_readahead_queue(NULL)
 {
 	// reset state
 	memset(m_decompressor, 0, sizeof(m_decompressor));
+	memset(m_readahead_codecs, 0, sizeof(m_readahead_codecs));
 	close();
 }
 
@@ -795,11 +806,17 @@ chd_error chd_file::open(core_file &file, bool writeable, chd_file *parent)
 
 void chd_file::close()
 {
+	// stop reading ahead
+	read_ahead_end();
+
 	// reset file characteristics
 	if (m_owns_file && m_file != NULL)
 		core_fclose(m_file);
 	m_file = NULL;
 	m_owns_file = false;
+	m_mapped = NULL;
+	m_mappedbytes = 0;
+	m_viewverified.clear();
 	m_allow_reads = false;
 	m_allow_writes = false;
 
@@ -864,6 +881,28 @@ void chd_file::close()
  */
 
 chd_error chd_file::read_hunk(UINT32 hunknum, void *buffer)
+{
+	// sequential readers are served from the read-ahead pipeline, if running
+	if (m_readahead_queue != NULL && buffer != NULL)
+		return read_ahead_hunk(hunknum, buffer);
+	return read_hunk_direct(hunknum, buffer);
+}
+
+/**
+ * @fn  chd_error chd_file::read_hunk_direct(UINT32 hunknum, void *buffer)
+ *
+ * @brief   -------------------------------------------------
+ *            read_hunk_direct - read a single hunk from the CHD file, bypassing any
+ *            read-ahead
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum         The hunknum.
+ * @param [in,out]  buffer  If non-null, the buffer.
+ *
+ * @return  The hunk.
+ */
+
+chd_error chd_file::read_hunk_direct(UINT32 hunknum, void *buffer)
 {
 	// wrap this for clean reporting
 	try
@@ -915,7 +954,7 @@ chd_error chd_file::read_hunk(UINT32 hunknum, void *buffer)
 						return CHDERR_NONE;
 
 					case V34_MAP_ENTRY_TYPE_SELF_HUNK:
-						return read_hunk(blockoffs, dest);
+						return read_hunk_direct(blockoffs, dest);
 
 					case V34_MAP_ENTRY_TYPE_PARENT_HUNK:
 						if (m_parent_missing)
@@ -968,7 +1007,7 @@ chd_error chd_file::read_hunk(UINT32 hunknum, void *buffer)
 						return CHDERR_NONE;
 
 					case COMPRESSION_SELF:
-						return read_hunk(blockoffs, dest);
+						return read_hunk_direct(blockoffs, dest);
 
 					case COMPRESSION_PARENT:
 						if (m_parent_missing)
@@ -989,6 +1028,103 @@ chd_error chd_file::read_hunk(UINT32 hunknum, void *buffer)
 	}
 }
 
+/**
+ * @fn  const void *chd_file::hunk_view(UINT32 hunknum)
+ *
+ * @brief   -------------------------------------------------
+ *            hunk_view - return a pointer to a hunk inside the mapped file, if it is stored
+ *            uncompressed there; the CRC is checked the first time each hunk is viewed
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The hunknum.
+ *
+ * @return  A pointer to the hunk data, or NULL if it has to be read with read_hunk.
+ */
+
+const void *chd_file::hunk_view(UINT32 hunknum)
+{
+	// only read-only, mapped files can hand out views
+	if (m_mapped == NULL || hunknum >= m_hunkcount)
+		return NULL;
+
+	// find where the hunk lives, and how to check it
+	UINT64 blockoffs;
+	UINT32 blockcrc = 0;
+	bool checkcrc16 = false;
+	bool checkcrc32 = false;
+	const UINT8 *rawmap;
+	switch (m_version)
+	{
+		// v3/v4 map entries
+		case 3:
+		case 4:
+			rawmap = &m_rawmap[16 * hunknum];
+			blockoffs = be_read(&rawmap[0], 8);
+			switch (rawmap[15] & V34_MAP_ENTRY_FLAG_TYPE_MASK)
+			{
+				case V34_MAP_ENTRY_TYPE_UNCOMPRESSED:
+					blockcrc = be_read(&rawmap[8], 4);
+					checkcrc32 = !(rawmap[15] & V34_MAP_ENTRY_FLAG_NO_CRC);
+					break;
+
+				case V34_MAP_ENTRY_TYPE_SELF_HUNK:
+					return hunk_view(blockoffs);
+
+				default:
+					return NULL;
+			}
+			break;
+
+		// v5 map entries
+		case 5:
+			rawmap = &m_rawmap[m_mapentrybytes * hunknum];
+			if (!compressed())
+			{
+				// hunks at offset 0 come from the parent, or are zero
+				blockoffs = UINT64(be_read(rawmap, 4)) * UINT64(m_hunkbytes);
+				if (blockoffs == 0)
+					return NULL;
+				break;
+			}
+			blockoffs = be_read(&rawmap[4], 6);
+			switch (rawmap[0])
+			{
+				case COMPRESSION_NONE:
+					blockcrc = be_read(&rawmap[10], 2);
+					checkcrc16 = true;
+					break;
+
+				case COMPRESSION_SELF:
+					return hunk_view(blockoffs);
+
+				default:
+					return NULL;
+			}
+			break;
+
+		default:
+			return NULL;
+	}
+
+	// the hunk must be inside the file, and aligned so that callers can read it as 32-bit words
+	if ((blockoffs & 3) != 0 || blockoffs > m_mappedbytes || m_hunkbytes > m_mappedbytes - blockoffs)
+		return NULL;
+	const UINT8 *view = m_mapped + blockoffs;
+
+	// check the CRC once; on a mismatch, leave it to read_hunk to report the error
+	if (m_viewverified.empty())
+		m_viewverified.resize(m_hunkcount, 0);
+	if (!m_viewverified[hunknum])
+	{
+		if (checkcrc32 && crc32_creator::simple(view, m_hunkbytes) != blockcrc)
+			return NULL;
+		if (checkcrc16 && crc16_creator::simple(view, m_hunkbytes) != blockcrc)
+			return NULL;
+		m_viewverified[hunknum] = 1;
+	}
+	return view;
+}
+
 /**
  * @fn  chd_error chd_file::write_hunk(UINT32 hunknum, const void *buffer)
  *
@@ -1017,6 +1153,10 @@ chd_error chd_file::write_hunk(UINT32 hunknum, const void *buffer)
 		if (m_file == NULL)
 			throw CHDERR_NOT_OPEN;
 
+		// anything read ahead may be about to go stale
+		if (m_readahead_queue != NULL)
+			read_ahead_flush();
+
 		// return an error if out of range
 		if (hunknum >= m_hunkcount)
 			throw CHDERR_HUNK_OUT_OF_RANGE;
@@ -1140,9 +1280,17 @@ chd_error chd_file::read_bytes(UINT64 offset, void *buffer, UINT32 bytes)
 		UINT32 startoffs = (curhunk == first_hunk) ? (offset % m_hunkbytes) : 0;
 		UINT32 endoffs = (curhunk == last_hunk) ? ((offset + bytes - 1) % m_hunkbytes) : (m_hunkbytes - 1);
 
-		// if it's a full block, just read directly from disk unless it's the cached hunk
+		// hunks stored as-is in a mapped file are copied straight out of the view; this is
+		// skipped while reading ahead, so that the pipeline sees every hunk in order
 		chd_error err = CHDERR_NONE;
-		if (startoffs == 0 && endoffs == m_hunkbytes - 1 && curhunk != m_cachehunk)
+		const UINT8 *view = NULL;
+		if (m_readahead_queue == NULL && curhunk != m_cachehunk)
+			view = reinterpret_cast<const UINT8 *>(hunk_view(curhunk));
+		if (view != NULL)
+			memcpy(dest, &view[startoffs], endoffs + 1 - startoffs);
+
+		// if it's a full block, just read directly from disk unless it's the cached hunk
+		else if (startoffs == 0 && endoffs == m_hunkbytes - 1 && curhunk != m_cachehunk)
 			err = read_hunk(curhunk, dest);
 
 		// otherwise, read from the cache
@@ -1220,6 +1368,297 @@ chd_error chd_file::write_bytes(UINT64 offset, const void *buffer, UINT32 bytes)
 	return CHDERR_NONE;
 }
 
+/**
+ * @fn  chd_error chd_file::read_ahead_begin()
+ *
+ * @brief   -------------------------------------------------
+ *            read_ahead_begin - start decompressing hunks ahead of a sequential reader on
+ *            other threads; read_hunk and read_bytes then hand back the results in order
+ *          -------------------------------------------------.
+ *
+ * @return  A chd_error.
+ */
+
+chd_error chd_file::read_ahead_begin()
+{
+	// punt if no file
+	if (m_file == NULL)
+		return CHDERR_NOT_OPEN;
+
+	// nothing to gain for uncompressed files
+	if (!compressed() || m_readahead_queue != NULL)
+		return CHDERR_NONE;
+
+	// allocate the queue and the ring of items
+	m_readahead_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	if (m_readahead_queue == NULL)
+		return CHDERR_OUT_OF_MEMORY;
+	m_readahead_item.resize(READ_AHEAD_HUNKS);
+	for (int itemnum = 0; itemnum < m_readahead_item.size(); itemnum++)
+	{
+		read_ahead_item &item = m_readahead_item[itemnum];
+		item.m_chd = this;
+		item.m_compressed.resize(m_hunkbytes);
+		item.m_data.resize(m_hunkbytes);
+	}
+
+	// nothing is queued until the first read
+	m_readahead_next = m_readahead_end = m_hunkcount;
+	return CHDERR_NONE;
+}
+
+/**
+ * @fn  void chd_file::read_ahead_end()
+ *
+ * @brief   -------------------------------------------------
+ *            read_ahead_end - stop reading ahead and free the resources
+ *          -------------------------------------------------.
+ */
+
+void chd_file::read_ahead_end()
+{
+	// wait for anything outstanding, then free the queue
+	if (m_readahead_queue != NULL)
+	{
+		read_ahead_flush();
+		osd_work_queue_free(m_readahead_queue);
+		m_readahead_queue = NULL;
+	}
+	m_readahead_item.clear();
+
+	// delete the per-thread codecs
+	for (int threadnum = 0; threadnum < ARRAY_LENGTH(m_readahead_codecs); threadnum++)
+		for (int codecnum = 0; codecnum < ARRAY_LENGTH(m_readahead_codecs[0]); codecnum++)
+		{
+			delete m_readahead_codecs[threadnum][codecnum];
+			m_readahead_codecs[threadnum][codecnum] = NULL;
+		}
+}
+
+/**
+ * @fn  chd_error chd_file::read_ahead_hunk(UINT32 hunknum, void *buffer)
+ *
+ * @brief   -------------------------------------------------
+ *            read_ahead_hunk - return a hunk from the read-ahead pipeline, restarting it if
+ *            the reader has jumped elsewhere
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum         The hunknum.
+ * @param [in,out]  buffer  If non-null, the buffer.
+ *
+ * @return  A chd_error.
+ */
+
+chd_error chd_file::read_ahead_hunk(UINT32 hunknum, void *buffer)
+{
+	// return an error if out of range
+	if (hunknum >= m_hunkcount)
+		return CHDERR_HUNK_OUT_OF_RANGE;
+
+	// skipping forward within the ring just discards the hunks in between
+	if (hunknum > m_readahead_next && hunknum < m_readahead_end)
+		for ( ; m_readahead_next < hunknum; m_readahead_next++)
+			read_ahead_wait(m_readahead_item[m_readahead_next % m_readahead_item.size()]);
+
+	// any other non-sequential read restarts the pipeline from here
+	if (hunknum != m_readahead_next)
+	{
+		read_ahead_flush();
+		m_readahead_next = m_readahead_end = hunknum;
+	}
+
+	// keep the ring full
+	while (m_readahead_end < m_hunkcount && m_readahead_end - m_readahead_next < m_readahead_item.size())
+	{
+		read_ahead_queue(m_readahead_item[m_readahead_end % m_readahead_item.size()], m_readahead_end);
+		m_readahead_end++;
+	}
+
+	// wait for our hunk to finish
+	read_ahead_item &item = m_readahead_item[hunknum % m_readahead_item.size()];
+	read_ahead_wait(item);
+	m_readahead_next = hunknum + 1;
+
+	// hunks that aren't decompressed by a codec are read directly
+	if (item.m_codec < 0)
+		return read_hunk_direct(hunknum, buffer);
+	if (item.m_error != CHDERR_NONE)
+		return item.m_error;
+	memcpy(buffer, &item.m_data[0], m_hunkbytes);
+	return CHDERR_NONE;
+}
+
+/**
+ * @fn  void chd_file::read_ahead_queue(read_ahead_item &item, UINT32 hunknum)
+ *
+ * @brief   -------------------------------------------------
+ *            read_ahead_queue - read the compressed data for a hunk and queue it for
+ *            decompression
+ *          -------------------------------------------------.
+ *
+ * @param [in,out]  item    The item.
+ * @param   hunknum         The hunknum.
+ */
+
+void chd_file::read_ahead_queue(read_ahead_item &item, UINT32 hunknum)
+{
+	// reset the item; anything we can't handle is left for read_hunk_direct
+	item.m_hunknum = hunknum;
+	item.m_codec = -1;
+	item.m_error = CHDERR_NONE;
+
+	UINT64 blockoffs = 0;
+	UINT8 *rawmap;
+	switch (m_version)
+	{
+		// v3/v4 map entries
+		case 3:
+		case 4:
+			rawmap = &m_rawmap[16 * hunknum];
+			if ((rawmap[15] & V34_MAP_ENTRY_FLAG_TYPE_MASK) != V34_MAP_ENTRY_TYPE_COMPRESSED)
+				return;
+			blockoffs = be_read(&rawmap[0], 8);
+			item.m_crc = be_read(&rawmap[8], 4);
+			item.m_complen = be_read(&rawmap[12], 2) + (rawmap[14] << 16);
+			item.m_crcbits = (rawmap[15] & V34_MAP_ENTRY_FLAG_NO_CRC) ? 0 : 32;
+			item.m_crccompressed = false;
+			item.m_codec = 0;
+			break;
+
+		// v5 map entries
+		case 5:
+			rawmap = &m_rawmap[m_mapentrybytes * hunknum];
+			if (rawmap[0] > COMPRESSION_TYPE_3)
+				return;
+			item.m_complen = be_read(&rawmap[1], 3);
+			blockoffs = be_read(&rawmap[4], 6);
+			item.m_crc = be_read(&rawmap[10], 2);
+			item.m_crcbits = 16;
+			item.m_codec = rawmap[0];
+			break;
+
+		default:
+			return;
+	}
+
+	// if the codec isn't available, let the direct path report it
+	if (m_decompressor[item.m_codec] == NULL || item.m_complen > item.m_compressed.size())
+	{
+		item.m_codec = -1;
+		return;
+	}
+	item.m_crccompressed = m_decompressor[item.m_codec]->lossy();
+
+	// the file is only touched from this thread; the codecs do the rest
+	try
+	{
+		file_read(blockoffs, &item.m_compressed[0], item.m_complen);
+	}
+	catch (chd_error &err)
+	{
+		item.m_error = err;
+		return;
+	}
+	item.m_osd = osd_work_item_queue(m_readahead_queue, read_ahead_decompress_static, &item, 0);
+	if (item.m_osd == NULL)
+		item.m_codec = -1;
+}
+
+/**
+ * @fn  void chd_file::read_ahead_flush()
+ *
+ * @brief   -------------------------------------------------
+ *            read_ahead_flush - wait for and discard everything in the read-ahead pipeline
+ *          -------------------------------------------------.
+ */
+
+void chd_file::read_ahead_flush()
+{
+	for (int itemnum = 0; itemnum < m_readahead_item.size(); itemnum++)
+		read_ahead_wait(m_readahead_item[itemnum]);
+	m_readahead_next = m_readahead_end = m_hunkcount;
+}
+
+/**
+ * @fn  void chd_file::read_ahead_wait(read_ahead_item &item)
+ *
+ * @brief   -------------------------------------------------
+ *            read_ahead_wait - wait for an item to finish decompressing and release it
+ *          -------------------------------------------------.
+ *
+ * @param [in,out]  item    The item.
+ */
+
+void chd_file::read_ahead_wait(read_ahead_item &item)
+{
+	if (item.m_osd != NULL)
+	{
+		while (!osd_work_item_wait(item.m_osd, osd_ticks_per_second())) ;
+		osd_work_item_release(item.m_osd);
+		item.m_osd = NULL;
+	}
+}
+
+/**
+ * @fn  void *chd_file::read_ahead_decompress_static(void *param, int threadid)
+ *
+ * @brief   -------------------------------------------------
+ *            read_ahead_decompress - decompress a hunk on a worker thread
+ *          -------------------------------------------------.
+ *
+ * @param [in,out]  param   If non-null, the parameter.
+ * @param   threadid        The threadid.
+ *
+ * @return  null if it fails, else a void*.
+ */
+
+void *chd_file::read_ahead_decompress_static(void *param, int threadid)
+{
+	read_ahead_item *item = reinterpret_cast<read_ahead_item *>(param);
+	item->m_chd->read_ahead_decompress(*item, threadid);
+	return NULL;
+}
+
+/**
+ * @fn  void chd_file::read_ahead_decompress(read_ahead_item &item, int threadid)
+ *
+ * @brief   Read ahead decompress.
+ *
+ * @param [in,out]  item    The item.
+ * @param   threadid        The threadid.
+ */
+
+void chd_file::read_ahead_decompress(read_ahead_item &item, int threadid)
+{
+	try
+	{
+		// each thread gets its own codecs, created the first time it needs them
+		chd_decompressor *&codec = m_readahead_codecs[threadid][item.m_codec];
+		if (codec == NULL)
+		{
+			codec = chd_codec_list::new_decompressor(m_compression[item.m_codec], *this);
+			if (codec == NULL)
+				throw CHDERR_UNKNOWN_COMPRESSION;
+		}
+
+		// lossy codecs are checked against the compressed data
+		if (item.m_crccompressed && item.m_crcbits == 16 && crc16_creator::simple(&item.m_compressed[0], item.m_complen) != item.m_crc)
+			throw CHDERR_DECOMPRESSION_ERROR;
+
+		codec->decompress(&item.m_compressed[0], item.m_complen, &item.m_data[0], m_hunkbytes);
+
+		// verify the result
+		if (!item.m_crccompressed && item.m_crcbits == 16 && crc16_creator::simple(&item.m_data[0], m_hunkbytes) != item.m_crc)
+			throw CHDERR_DECOMPRESSION_ERROR;
+		if (!item.m_crccompressed && item.m_crcbits == 32 && crc32_creator::simple(&item.m_data[0], m_hunkbytes) != item.m_crc)
+			throw CHDERR_DECOMPRESSION_ERROR;
+	}
+	catch (chd_error &err)
+	{
+		item.m_error = err;
+	}
+}
+
 /**
  * @fn  chd_error chd_file::read_metadata(chd_metadata_tag searchtag, UINT32 searchindex, std::string &output)
  *
@@ -2383,6 +2822,14 @@ chd_error chd_file::open_common(bool writeable)
 		// reads are always permitted
 		m_allow_reads = true;
 
+		// map read-only files so that reads can be served directly from the view
+		if (!writeable)
+		{
+			m_mapped = reinterpret_cast<const UINT8 *>(core_fmap(m_file));
+			if (m_mapped != NULL)
+				m_mappedbytes = core_fsize(m_file);
+		}
+
 		// read the raw header
 		UINT8 rawheader[MAX_HEADER_SIZE];
 		file_read(0, rawheader, sizeof(rawheader));
@@ -297,6 +297,7 @@ class chd_file
 	static const UINT32 V4_HEADER_SIZE = 108;
 	static const UINT32 V5_HEADER_SIZE = 124;
 	static const UINT32 MAX_HEADER_SIZE = V5_HEADER_SIZE;
+	static const UINT32 READ_AHEAD_HUNKS = 32;
 
 public:
 	// construction/destruction
@@ -347,6 +348,15 @@ public:
 	chd_error read_bytes(UINT64 offset, void *buffer, UINT32 bytes);
 	chd_error write_bytes(UINT64 offset, const void *buffer, UINT32 bytes);
 
+	// zero-copy access to hunks stored uncompressed in a mapped file; NULL if the hunk must be
+	// read with read_hunk, including whenever the OSD can't map files; like every mapped view,
+	// the pointer is only safe while nothing truncates the file (see osd_map)
+	const void *hunk_view(UINT32 hunknum);
+
+	// sequential read-ahead
+	chd_error read_ahead_begin();
+	void read_ahead_end();
+
 	// metadata management
 	chd_error read_metadata(chd_metadata_tag searchtag, UINT32 searchindex, std::string &output);
 	chd_error read_metadata(chd_metadata_tag searchtag, UINT32 searchindex, dynamic_buffer &output);
@@ -371,6 +381,34 @@ private:
 	struct metadata_entry;
 	struct metadata_hash;
 
+	// a single hunk being decompressed ahead of the reader
+	struct read_ahead_item
+	{
+		read_ahead_item()
+			: m_osd(NULL)
+			, m_chd(NULL)
+			, m_hunknum(0)
+			, m_codec(-1)
+			, m_complen(0)
+			, m_crc(0)
+			, m_crcbits(0)
+			, m_crccompressed(false)
+			, m_error(CHDERR_NONE)
+		{ }
+
+		osd_work_item *     m_osd;              // OSD work item decompressing this hunk
+		chd_file *          m_chd;              // pointer back to the file
+		UINT32              m_hunknum;          // number of the hunk
+		int                 m_codec;            // index of the codec, or -1 to read directly
+		UINT32              m_complen;          // compressed data length
+		UINT32              m_crc;              // expected CRC
+		UINT8               m_crcbits;          // 16 or 32 for the type of CRC; 0 for none
+		bool                m_crccompressed;    // CRC covers the compressed data (lossy codecs)
+		chd_error           m_error;            // result of decompression
+		dynamic_buffer      m_compressed;       // compressed data
+		dynamic_buffer      m_data;             // decompressed data
+	};
+
 	// inline helpers
 	UINT64 be_read(const UINT8 *base, int numbytes);
 	void be_write(UINT8 *base, UINT64 value, int numbytes);
@@ -386,6 +424,13 @@ private:
 	void parse_v3_header(UINT8 *rawheader, sha1_t &parentsha1);
 	void parse_v4_header(UINT8 *rawheader, sha1_t &parentsha1);
 	void parse_v5_header(UINT8 *rawheader, sha1_t &parentsha1);
+	chd_error read_hunk_direct(UINT32 hunknum, void *buffer);
+	chd_error read_ahead_hunk(UINT32 hunknum, void *buffer);
+	void read_ahead_queue(read_ahead_item &item, UINT32 hunknum);
+	void read_ahead_wait(read_ahead_item &item);
+	void read_ahead_flush();
+	static void *read_ahead_decompress_static(void *param, int threadid);
+	void read_ahead_decompress(read_ahead_item &item, int threadid);
 	chd_error compress_v5_map();
 	void decompress_v5_map();
 	chd_error create_common();
@@ -403,6 +448,9 @@ private:
 	// file characteristics
 	core_file *             m_file;             // handle to the open core file
 	bool                    m_owns_file;        // flag indicating if this file should be closed on chd_close()
+	const UINT8 *           m_mapped;           // read-only view of the file, if mapped
+	UINT64                  m_mappedbytes;      // size of the mapped view
+	dynamic_buffer          m_viewverified;     // hunks whose CRC has been checked for hunk_view
 	bool                    m_allow_reads;      // permit reads from this CHD?
 	bool                    m_allow_writes;     // permit writes to this CHD?
 
@@ -437,6 +485,13 @@ private:
 	// caching
 	dynamic_buffer          m_cache;            // single-hunk cache for partial reads/writes
 	UINT32                  m_cachehunk;        // which hunk is in the cache?
+
+	// sequential read-ahead
+	osd_work_queue *        m_readahead_queue;  // queue for decompressing on other threads
+	std::vector<read_ahead_item> m_readahead_item; // ring of hunks being read ahead
+	UINT32                  m_readahead_next;   // next hunk the reader is expected to ask for
+	UINT32                  m_readahead_end;    // next hunk to be queued
+	chd_decompressor *      m_readahead_codecs[WORK_MAX_THREADS + 1][4]; // codecs for each thread, including the waiting one
 };
 
 
@@ -70,6 +70,7 @@ struct core_file
 	UINT32          openflags;                  /* flags we were opened with */
 	UINT8           data_allocated;             /* was the data allocated by us? */
 	UINT8 *         data;                       /* file data, if RAM-based */
+	const void *    mapped;                     /* read-only view of the file, if mapped */
 	UINT64          offset;                     /* current file offset */
 	UINT64          length;                     /* total file length */
 	text_file_type  text_type;                  /* text output format */
@@ -214,6 +215,8 @@ void core_fclose(core_file *file)
 		core_fcompress(file, FCOMPRESS_NONE);
 	if (file->file != NULL)
 		osd_close(file->file);
+	if (file->mapped != NULL)
+		osd_unmap(file->mapped, file->length);
 	if (file->data != NULL && file->data_allocated)
 		free(file->data);
 	free(file);
@@ -662,6 +665,15 @@ const void *core_fbuffer(core_file *file)
 	if (file->data != NULL || !file->length)
 		return file->data;
 
+	/* if we can map the file, use the view directly instead of copying it */
+	if (core_fmap(file) != NULL)
+	{
+		file->data = (UINT8 *)file->mapped;
+		osd_close(file->file);
+		file->file = NULL;
+		return file->data;
+	}
+
 	/* allocate some memory */
 	file->data = (UINT8 *)malloc(file->length);
 	if (file->data == NULL)
@@ -684,6 +696,37 @@ const void *core_fbuffer(core_file *file)
 }
 
 
+/*-------------------------------------------------
+    core_fmap - return a pointer to a read-only
+    view of the file data without copying it, or
+    NULL if the file cannot be mapped; unlike
+    core_fbuffer, this does not change how the
+    file is subsequently read
+-------------------------------------------------*/
+
+const void *core_fmap(core_file *file)
+{
+	/* RAM-based files are already in memory */
+	if (file->data != NULL)
+		return file->data;
+
+	/* if we already have a view, just return it */
+	if (file->mapped != NULL)
+		return file->mapped;
+
+	/* only plain, non-empty, read-only files can be mapped */
+	if (file->file == NULL || file->zdata != NULL || !file->length)
+		return NULL;
+	if ((file->openflags & (OPEN_FLAG_WRITE | OPEN_FLAG_CREATE)) != 0)
+		return NULL;
+
+	/* ask the OSD layer; failure here is not an error */
+	if (osd_map(file->file, file->length, &file->mapped) != FILERR_NONE)
+		file->mapped = NULL;
+	return file->mapped;
+}
+
+
 /*-------------------------------------------------
     core_fload - open a file with the specified
     filename, read it into memory, and return a
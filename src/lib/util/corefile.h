@@ -96,9 +96,14 @@ int core_ungetc(int c, core_file *file);
 char *core_fgets(char *s, int n, core_file *file);
 
 /* get a pointer to a buffer that holds the full file data in RAM */
-/* this function may cause the full file data to be read */
+/* this function may cause the full file data to be read, or the file to be mapped as by core_fmap */
 const void *core_fbuffer(core_file *file);
 
+/* get a pointer to a read-only memory-mapped view of the file, or NULL if it can't be mapped */
+/* unlike core_fbuffer, this never copies the file data, so the file must not be truncated */
+/* while the view is in use (see osd_map) */
+const void *core_fmap(core_file *file);
+
 /* open a file with the specified filename, read it into memory, and return a pointer */
 file_error core_fload(const char *filename, void **data, UINT32 *length);
 file_error core_fload(const char *filename, dynamic_buffer &data);
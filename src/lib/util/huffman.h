@@ -105,6 +105,9 @@ public:
 	void histo_one(UINT32 data);
 	void encode_one(bitstream_out &bitbuf, UINT32 data);
 
+	// code length of a single item, valid after computing the tree
+	UINT8 code_length(UINT32 data) const { return m_huffnode_array[data].m_numbits; }
+
 	// expose tree computation and export
 	using huffman_context_base::compute_tree_from_histo;
 	using huffman_context_base::export_tree_rle;
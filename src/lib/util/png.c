@@ -14,8 +14,29 @@
 
 #include <zlib.h>
 #include "png.h"
+#include "eminline.h"
 
 #include <new>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* images are filtered and compressed in blocks of roughly this many bytes */
+#define PNG_WRITE_BLOCK_BYTES   (128 * 1024)
+
+/* images with fewer blocks than this aren't worth handing to worker threads */
+#define PNG_WRITE_MIN_PARALLEL_BLOCKS   4
+
+/* how long to wait on the worker threads before doing the rest ourselves */
+#define PNG_WRITE_TIMEOUT_SECONDS       10
 
 
 /***************************************************************************
@@ -40,6 +61,24 @@ struct png_private
 };
 
 
+struct png_write_block
+{
+	const png_info *    pnginfo;        /* image being written */
+	UINT8 *             filtered;       /* base of the filtered image */
+	UINT32              startrow;       /* first row in this block */
+	UINT32              numrows;        /* number of rows in this block */
+	const UINT8 *       data;           /* data to compress */
+	UINT32              length;         /* length of data to compress */
+	UINT32              dictlength;     /* bytes before data to use as a dictionary */
+	int                 last;           /* is this the last block? */
+	dynamic_buffer      compressed;     /* compressed data */
+	UINT32              complength;     /* length of compressed data */
+	UINT32              adler;          /* adler32 of the uncompressed data */
+	png_error           error;          /* result of compression */
+	volatile INT32      claimed;        /* set by whoever processes the block in the current pass */
+};
+
+
 
 /***************************************************************************
     GLOBAL VARIABLES
@@ -779,87 +818,396 @@ static png_error write_chunk(core_file *fp, const UINT8 *data, UINT32 type, UINT
 
 
 /*-------------------------------------------------
-    write_deflated_chunk - write an in-memory
-    chunk to the given file by deflating it
+    filter_row_cost - estimate how well a filtered
+    row will compress, as the sum of the absolute
+    values of its bytes taken as signed deltas
 -------------------------------------------------*/
 
-static png_error write_deflated_chunk(core_file *fp, UINT8 *data, UINT32 type, UINT32 length)
+static UINT32 filter_row_cost(const UINT8 *row, int rowbytes)
 {
-	UINT64 lengthpos = core_ftell(fp);
-	UINT8 tempbuff[8192];
-	UINT32 zlength = 0;
-	z_stream stream;
-	UINT32 crc;
-	int zerr;
+	UINT32 cost = 0;
+	int x = 0;
 
-	/* stuff the length/type into the buffer */
-	put_32bit(tempbuff + 0, length);
-	put_32bit(tempbuff + 4, type);
-	crc = crc32(0, tempbuff + 4, 4);
+#if defined(__SSE2__)
+	__m128i zero = _mm_setzero_si128();
+	__m128i sum = _mm_setzero_si128();
+	for ( ; x + 16 <= rowbytes; x += 16)
+	{
+		/* |(INT8)v| == min(v, -v) when both are viewed as unsigned */
+		__m128i value = _mm_loadu_si128((const __m128i *)&row[x]);
+		__m128i absval = _mm_min_epu8(value, _mm_sub_epi8(zero, value));
+		sum = _mm_add_epi64(sum, _mm_sad_epu8(absval, zero));
+	}
+	cost = _mm_cvtsi128_si32(sum) + _mm_cvtsi128_si32(_mm_srli_si128(sum, 8));
+#endif
 
-	/* write that data */
-	if (core_fwrite(fp, tempbuff, 8) != 8)
-		return PNGERR_FILE_ERROR;
+	for ( ; x < rowbytes; x++)
+		cost += abs((INT8)row[x]);
+	return cost;
+}
 
-	/* initialize the stream */
-	memset(&stream, 0, sizeof(stream));
-	stream.next_in = data;
-	stream.avail_in = length;
-	zerr = deflateInit(&stream, Z_DEFAULT_COMPRESSION);
-	if (zerr != Z_OK)
-		return PNGERR_COMPRESS_ERROR;
 
-	/* now loop until we run out of data */
-	for ( ; ; )
-	{
-		/* compress this chunk */
-		stream.next_out = tempbuff;
-		stream.avail_out = sizeof(tempbuff);
-		zerr = deflate(&stream, Z_FINISH);
+/*-------------------------------------------------
+    filter_row - apply a filter to a single row
+    of pixels; prev must point to a row of zeroes
+    for the first row of the image
+-------------------------------------------------*/
+
+static void filter_row(int type, const UINT8 *src, const UINT8 *prev, UINT8 *dst, int bpp, int rowbytes)
+{
+	int x;
 
-		/* if there's data to write, do it */
-		if (stream.avail_out < sizeof(tempbuff))
+	/* the first pixel has no left neighbour, so filter it by hand */
+	for (x = 0; x < bpp; x++)
+	{
+		switch (type)
 		{
-			int bytes = sizeof(tempbuff) - stream.avail_out;
-			if (core_fwrite(fp, tempbuff, bytes) != bytes)
+			case PNG_PF_None:
+			case PNG_PF_Sub:        dst[x] = src[x];                    break;
+			case PNG_PF_Up:
+			case PNG_PF_Paeth:      dst[x] = src[x] - prev[x];          break;
+			case PNG_PF_Average:    dst[x] = src[x] - prev[x] / 2;      break;
+		}
+	}
+
+	switch (type)
+	{
+		/* no filter, just copy */
+		case PNG_PF_None:
+			memcpy(&dst[bpp], &src[bpp], rowbytes - bpp);
+			return;
+
+		/* SUB = previous pixel */
+		case PNG_PF_Sub:
+#if defined(__SSE2__)
+			for ( ; x + 16 <= rowbytes; x += 16)
 			{
-				deflateEnd(&stream);
-				return PNGERR_FILE_ERROR;
+				__m128i left = _mm_loadu_si128((const __m128i *)&src[x - bpp]);
+				__m128i value = _mm_loadu_si128((const __m128i *)&src[x]);
+				_mm_storeu_si128((__m128i *)&dst[x], _mm_sub_epi8(value, left));
 			}
-			crc = crc32(crc, tempbuff, bytes);
-			zlength += bytes;
-		}
+#endif
+			for ( ; x < rowbytes; x++)
+				dst[x] = src[x] - src[x - bpp];
+			break;
 
-		/* stop at the end of the stream */
-		if (zerr == Z_STREAM_END)
+		/* UP = pixel above */
+		case PNG_PF_Up:
+#if defined(__SSE2__)
+			for ( ; x + 16 <= rowbytes; x += 16)
+			{
+				__m128i above = _mm_loadu_si128((const __m128i *)&prev[x]);
+				__m128i value = _mm_loadu_si128((const __m128i *)&src[x]);
+				_mm_storeu_si128((__m128i *)&dst[x], _mm_sub_epi8(value, above));
+			}
+#endif
+			for ( ; x < rowbytes; x++)
+				dst[x] = src[x] - prev[x];
 			break;
 
-		/* other errors are fatal */
-		if (zerr != Z_OK)
+		/* AVERAGE = average of pixel above and previous pixel */
+		case PNG_PF_Average:
+#if defined(__SSE2__)
+			for ( ; x + 16 <= rowbytes; x += 16)
+			{
+				/* avg_epu8 rounds up, so take off the odd bit to get the truncated mean */
+				__m128i left = _mm_loadu_si128((const __m128i *)&src[x - bpp]);
+				__m128i above = _mm_loadu_si128((const __m128i *)&prev[x]);
+				__m128i value = _mm_loadu_si128((const __m128i *)&src[x]);
+				__m128i rounding = _mm_and_si128(_mm_xor_si128(left, above), _mm_set1_epi8(1));
+				__m128i average = _mm_sub_epi8(_mm_avg_epu8(left, above), rounding);
+				_mm_storeu_si128((__m128i *)&dst[x], _mm_sub_epi8(value, average));
+			}
+#endif
+			for ( ; x < rowbytes; x++)
+				dst[x] = src[x] - (src[x - bpp] + prev[x]) / 2;
+			break;
+
+		/* PAETH = special filter */
+		case PNG_PF_Paeth:
+#if defined(__SSE2__)
+			for ( ; x + 16 <= rowbytes; x += 16)
+			{
+				__m128i zero = _mm_setzero_si128();
+				__m128i left = _mm_loadu_si128((const __m128i *)&src[x - bpp]);
+				__m128i above = _mm_loadu_si128((const __m128i *)&prev[x]);
+				__m128i aboveleft = _mm_loadu_si128((const __m128i *)&prev[x - bpp]);
+				__m128i value = _mm_loadu_si128((const __m128i *)&src[x]);
+				__m128i prediction[2];
+
+				/* work in 16 bits, eight pixels at a time */
+				for (int half = 0; half < 2; half++)
+				{
+					__m128i a = half ? _mm_unpackhi_epi8(left, zero) : _mm_unpacklo_epi8(left, zero);
+					__m128i b = half ? _mm_unpackhi_epi8(above, zero) : _mm_unpacklo_epi8(above, zero);
+					__m128i c = half ? _mm_unpackhi_epi8(aboveleft, zero) : _mm_unpacklo_epi8(aboveleft, zero);
+
+					/* pa = |b - c|, pb = |a - c|, pc = |a + b - 2c| */
+					__m128i pa = _mm_sub_epi16(b, c);
+					__m128i pb = _mm_sub_epi16(a, c);
+					__m128i pc = _mm_add_epi16(pa, pb);
+					pa = _mm_max_epi16(pa, _mm_sub_epi16(zero, pa));
+					pb = _mm_max_epi16(pb, _mm_sub_epi16(zero, pb));
+					pc = _mm_max_epi16(pc, _mm_sub_epi16(zero, pc));
+
+					/* a wins ties, then b, then c */
+					__m128i not_a = _mm_or_si128(_mm_cmpgt_epi16(pa, pb), _mm_cmpgt_epi16(pa, pc));
+					__m128i use_c = _mm_and_si128(not_a, _mm_cmpgt_epi16(pb, pc));
+					__m128i use_b = _mm_andnot_si128(use_c, not_a);
+					prediction[half] = _mm_or_si128(_mm_andnot_si128(not_a, a),
+										_mm_or_si128(_mm_and_si128(use_b, b), _mm_and_si128(use_c, c)));
+				}
+				_mm_storeu_si128((__m128i *)&dst[x], _mm_sub_epi8(value, _mm_packus_epi16(prediction[0], prediction[1])));
+			}
+#endif
+			for ( ; x < rowbytes; x++)
+			{
+				INT32 pa = src[x - bpp];
+				INT32 pb = prev[x];
+				INT32 pc = prev[x - bpp];
+				INT32 prediction = pa + pb - pc;
+				INT32 da = abs(prediction - pa);
+				INT32 db = abs(prediction - pb);
+				INT32 dc = abs(prediction - pc);
+				if (da <= db && da <= dc)
+					dst[x] = src[x] - pa;
+				else if (db <= dc)
+					dst[x] = src[x] - pb;
+				else
+					dst[x] = src[x] - pc;
+			}
+			break;
+	}
+}
+
+
+/*-------------------------------------------------
+    filter_block - filter a block of rows, picking
+    the filter for each row that minimizes the sum
+    of absolute differences
+-------------------------------------------------*/
+
+static void *filter_block(void *param, int threadid)
+{
+	png_write_block *block = (png_write_block *)param;
+	const png_info *pnginfo = block->pnginfo;
+	int rowbytes = compute_rowbytes(pnginfo);
+	int bpp = compute_bpp(pnginfo);
+
+	/* scratch space for each candidate filter, plus a row of zeroes for the top of the image */
+	dynamic_buffer scratch((PNG_PF_Paeth + 2) * rowbytes, 0);
+	const UINT8 *zerorow = &scratch[(PNG_PF_Paeth + 1) * rowbytes];
+
+	for (UINT32 y = block->startrow; y < block->startrow + block->numrows; y++)
+	{
+		const UINT8 *src = pnginfo->image + y * (rowbytes + 1) + 1;
+		const UINT8 *prev = (y == 0) ? zerorow : src - (rowbytes + 1);
+		UINT8 *dst = block->filtered + y * (rowbytes + 1);
+		UINT32 bestcost = ~0;
+		int besttype = PNG_PF_None;
+
+		/* try each filter and keep the cheapest */
+		for (int type = PNG_PF_None; type <= PNG_PF_Paeth; type++)
 		{
-			deflateEnd(&stream);
-			return PNGERR_COMPRESS_ERROR;
+			filter_row(type, src, prev, &scratch[type * rowbytes], bpp, rowbytes);
+			UINT32 cost = filter_row_cost(&scratch[type * rowbytes], rowbytes);
+			if (cost < bestcost)
+			{
+				bestcost = cost;
+				besttype = type;
+			}
 		}
+
+		dst[0] = besttype;
+		memcpy(&dst[1], &scratch[besttype * rowbytes], rowbytes);
 	}
+	return NULL;
+}
+
 
-	/* clean up deflater(maus) */
-	zerr = deflateEnd(&stream);
+/*-------------------------------------------------
+    deflate_block - deflate a block of data as a
+    raw deflate stream, primed with the data that
+    precedes it and ending on a byte boundary so
+    the blocks can be concatenated
+-------------------------------------------------*/
+
+static void *deflate_block(void *param, int threadid)
+{
+	png_write_block *block = (png_write_block *)param;
+	z_stream stream;
+	int zerr;
+
+	block->error = PNGERR_COMPRESS_ERROR;
+	block->adler = adler32(adler32(0, Z_NULL, 0), block->data, block->length);
+
+	/* initialize a raw stream; the caller wraps the blocks in a single zlib header */
+	memset(&stream, 0, sizeof(stream));
+	zerr = deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
 	if (zerr != Z_OK)
-		return PNGERR_COMPRESS_ERROR;
+		return NULL;
+
+	/* the tail of the previous block serves as our dictionary */
+	if (block->dictlength > 0)
+		deflateSetDictionary(&stream, block->data - block->dictlength, block->dictlength);
+
+	/* allocate enough to compress in one shot, with room for the sync marker */
+	block->compressed.resize(deflateBound(&stream, block->length) + 16);
+	stream.next_in = const_cast<UINT8 *>(block->data);
+	stream.avail_in = block->length;
+	stream.next_out = &block->compressed[0];
+	stream.avail_out = block->compressed.size();
+
+	/* only the last block finishes the stream; the others sync flush to a byte boundary */
+	zerr = deflate(&stream, block->last ? Z_FINISH : Z_SYNC_FLUSH);
+	block->complength = block->compressed.size() - stream.avail_out;
+	if ((block->last && zerr == Z_STREAM_END) || (!block->last && zerr == Z_OK && stream.avail_in == 0 && stream.avail_out != 0))
+		block->error = PNGERR_NONE;
+	deflateEnd(&stream);
+	return NULL;
+}
 
-	/* write the CRC */
-	put_32bit(tempbuff, crc);
-	if (core_fwrite(fp, tempbuff, 4) != 4)
-		return PNGERR_FILE_ERROR;
 
-	/* seek back and update the length */
-	core_fseek(fp, lengthpos, SEEK_SET);
+/*-------------------------------------------------
+    filter_block_work/deflate_block_work - work
+    queue entry points; a block is only processed
+    by whoever claims it first
+-------------------------------------------------*/
+
+static void *filter_block_work(void *param, int threadid)
+{
+	png_write_block *block = (png_write_block *)param;
+	if (atomic_exchange32(&block->claimed, 1) == 0)
+		filter_block(block, threadid);
+	return NULL;
+}
+
+static void *deflate_block_work(void *param, int threadid)
+{
+	png_write_block *block = (png_write_block *)param;
+	if (atomic_exchange32(&block->claimed, 1) == 0)
+		deflate_block(block, threadid);
+	return NULL;
+}
+
+
+/*-------------------------------------------------
+    process_blocks - run a pass over all the
+    blocks, on the queue if there is one
+-------------------------------------------------*/
+
+static void process_blocks(osd_work_queue *queue, osd_work_callback callback, std::vector<png_write_block> &block)
+{
+	for (UINT32 blocknum = 0; blocknum < block.size(); blocknum++)
+		block[blocknum].claimed = 0;
+
+	if (queue != NULL && osd_work_item_queue_multiple(queue, callback, block.size(), &block[0], sizeof(block[0]), WORK_ITEM_FLAG_AUTO_RELEASE) != NULL)
+	{
+		if (osd_work_queue_wait(queue, PNG_WRITE_TIMEOUT_SECONDS * osd_ticks_per_second()))
+			return;
+	}
+
+	/* serial path; after a timeout this picks up whatever the workers haven't started */
+	for (UINT32 blocknum = 0; blocknum < block.size(); blocknum++)
+		(*callback)(&block[blocknum], 0);
+
+	/* anything still queued points at our blocks, so let it drain before they go away */
+	if (queue != NULL)
+		while (!osd_work_queue_wait(queue, osd_ticks_per_second())) { }
+}
+
+
+/*-------------------------------------------------
+    write_deflated_image - filter and deflate an
+    image and write it to the given file as a
+    single chunk; large images are split into row
+    blocks which are processed in parallel
+-------------------------------------------------*/
+
+static png_error write_deflated_image(core_file *fp, png_info *pnginfo, UINT32 type, int filter, osd_work_queue *queue)
+{
+	UINT32 rowbytes = compute_rowbytes(pnginfo);
+	UINT32 rowsperblock = MAX(1, PNG_WRITE_BLOCK_BYTES / (rowbytes + 1));
+	UINT32 numblocks = MAX(1, (pnginfo->height + rowsperblock - 1) / rowsperblock);
+	std::vector<png_write_block> block(numblocks);
+	dynamic_buffer filtered;
+	UINT8 *data = pnginfo->image;
+	UINT8 tempbuff[8];
+	UINT32 zlength, crc, adler;
+
+	/* threads only pay off for large images on machines that can run them in parallel */
+	if (numblocks < PNG_WRITE_MIN_PARALLEL_BLOCKS || osd_get_num_processors() == 1)
+		queue = NULL;
+
+	/* carve up the image */
+	for (UINT32 blocknum = 0; blocknum < numblocks; blocknum++)
+	{
+		png_write_block &cur = block[blocknum];
+		cur.pnginfo = pnginfo;
+		cur.startrow = blocknum * rowsperblock;
+		cur.numrows = MIN(rowsperblock, pnginfo->height - cur.startrow);
+		cur.length = cur.numrows * (rowbytes + 1);
+		cur.dictlength = MIN(cur.startrow * (rowbytes + 1), 32768);
+		cur.last = (blocknum == numblocks - 1);
+		cur.complength = 0;
+		cur.adler = 0;
+		cur.error = PNGERR_NONE;
+	}
+
+	/* filter everything first, since each block's dictionary is the filtered data before it */
+	if (filter && pnginfo->height > 0)
+	{
+		filtered.resize(pnginfo->height * (rowbytes + 1));
+		data = &filtered[0];
+		for (UINT32 blocknum = 0; blocknum < numblocks; blocknum++)
+			block[blocknum].filtered = data;
+		process_blocks(queue, filter_block_work, block);
+	}
+
+	/* then compress the blocks */
+	for (UINT32 blocknum = 0; blocknum < numblocks; blocknum++)
+		block[blocknum].data = data + block[blocknum].startrow * (rowbytes + 1);
+	process_blocks(queue, deflate_block_work, block);
+
+	/* add up the pieces and stitch the checksums together */
+	zlength = 2 + 4;
+	adler = adler32(0, Z_NULL, 0);
+	for (UINT32 blocknum = 0; blocknum < numblocks; blocknum++)
+	{
+		if (block[blocknum].error != PNGERR_NONE)
+			return block[blocknum].error;
+		zlength += block[blocknum].complength;
+		adler = adler32_combine(adler, block[blocknum].adler, block[blocknum].length);
+	}
+
+	/* write the length/type, and a zlib header for default compression with no dictionary */
 	put_32bit(tempbuff + 0, zlength);
-	if (core_fwrite(fp, tempbuff, 4) != 4)
+	put_32bit(tempbuff + 4, type);
+	crc = crc32(0, tempbuff + 4, 4);
+	if (core_fwrite(fp, tempbuff, 8) != 8)
+		return PNGERR_FILE_ERROR;
+	tempbuff[0] = 0x78;
+	tempbuff[1] = 0x9c;
+	crc = crc32(crc, tempbuff, 2);
+	if (core_fwrite(fp, tempbuff, 2) != 2)
+		return PNGERR_FILE_ERROR;
+
+	/* append the compressed blocks in order */
+	for (UINT32 blocknum = 0; blocknum < numblocks; blocknum++)
+	{
+		png_write_block &cur = block[blocknum];
+		if (core_fwrite(fp, &cur.compressed[0], cur.complength) != cur.complength)
+			return PNGERR_FILE_ERROR;
+		crc = crc32(crc, &cur.compressed[0], cur.complength);
+	}
+
+	/* finish with the zlib trailer and the CRC */
+	put_32bit(tempbuff, adler);
+	crc = crc32(crc, tempbuff, 4);
+	put_32bit(tempbuff + 4, crc);
+	if (core_fwrite(fp, tempbuff, 8) != 8)
 		return PNGERR_FILE_ERROR;
 
-	/* return to the end */
-	core_fseek(fp, lengthpos + 8 + zlength + 4, SEEK_SET);
 	return PNGERR_NONE;
 }
 
@@ -1006,7 +1354,7 @@ static png_error convert_bitmap_to_image_rgb(png_info *pnginfo, const bitmap_t &
     chunks to the given file
 -------------------------------------------------*/
 
-static png_error write_png_stream(core_file *fp, png_info *pnginfo, const bitmap_t &bitmap, int palette_length, const rgb_t *palette)
+static png_error write_png_stream(core_file *fp, png_info *pnginfo, const bitmap_t &bitmap, int palette_length, const rgb_t *palette, osd_work_queue *queue)
 {
 	UINT8 tempbuff[16];
 	png_text *text;
@@ -1020,8 +1368,6 @@ static png_error write_png_stream(core_file *fp, png_info *pnginfo, const bitmap
 	if (error != PNGERR_NONE)
 		goto handle_error;
 
-	/* if we wanted to get clever and do filtering, we would do it here */
-
 	/* write the IHDR chunk */
 	put_32bit(tempbuff + 0, pnginfo->width);
 	put_32bit(tempbuff + 4, pnginfo->height);
@@ -1040,8 +1386,8 @@ static png_error write_png_stream(core_file *fp, png_info *pnginfo, const bitmap
 	if (error != PNGERR_NONE)
 		goto handle_error;
 
-	/* write a single IDAT chunk */
-	error = write_deflated_chunk(fp, pnginfo->image, PNG_CN_IDAT, pnginfo->height * (compute_rowbytes(pnginfo) + 1));
+	/* write a single IDAT chunk; palettized images compress best unfiltered */
+	error = write_deflated_image(fp, pnginfo, PNG_CN_IDAT, pnginfo->color_type != 3, queue);
 	if (error != PNGERR_NONE)
 		goto handle_error;
 
@@ -1061,7 +1407,7 @@ handle_error:
 }
 
 
-png_error png_write_bitmap(core_file *fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette)
+png_error png_write_bitmap(core_file *fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette, osd_work_queue *queue)
 {
 	png_info pnginfo;
 	png_error error;
@@ -1082,7 +1428,7 @@ png_error png_write_bitmap(core_file *fp, png_info *info, bitmap_t &bitmap, int
 	}
 
 	/* write the rest of the PNG data */
-	error = write_png_stream(fp, info, bitmap, palette_length, palette);
+	error = write_png_stream(fp, info, bitmap, palette_length, palette, queue);
 	if (info == &pnginfo)
 		png_free(&pnginfo);
 	return error;
@@ -1131,7 +1477,7 @@ png_error mng_capture_start(core_file *fp, bitmap_t &bitmap, double rate)
 }
 
 /**
- * @fn  png_error mng_capture_frame(core_file *fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette)
+ * @fn  png_error mng_capture_frame(core_file *fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette, osd_work_queue *queue)
  *
  * @brief   Mng capture frame.
  *
@@ -1140,13 +1486,14 @@ png_error mng_capture_start(core_file *fp, bitmap_t &bitmap, double rate)
  * @param [in,out]  bitmap  The bitmap.
  * @param   palette_length  Length of the palette.
  * @param   palette         The palette.
+ * @param [in,out]  queue   If non-null, a multi-threaded queue to compress the frame on.
  *
  * @return  A png_error.
  */
 
-png_error mng_capture_frame(core_file *fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette)
+png_error mng_capture_frame(core_file *fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette, osd_work_queue *queue)
 {
-	return write_png_stream(fp, info, bitmap, palette_length, palette);
+	return write_png_stream(fp, info, bitmap, palette_length, palette, queue);
 }
 
 /**
@@ -124,10 +124,13 @@ png_error png_read_bitmap(core_file *fp, bitmap_argb32 &bitmap);
 png_error png_expand_buffer_8bit(png_info *p);
 
 png_error png_add_text(png_info *pnginfo, const char *keyword, const char *text);
-png_error png_write_bitmap(core_file *fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette);
+
+/* the writers filter and deflate large images in parallel on the given multi-threaded queue,
+   which must not be used by another thread at the same time */
+png_error png_write_bitmap(core_file *fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette, osd_work_queue *queue = NULL);
 
 png_error mng_capture_start(core_file *fp, bitmap_t &bitmap, double rate);
-png_error mng_capture_frame(core_file *fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette);
+png_error mng_capture_frame(core_file *fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette, osd_work_queue *queue = NULL);
 png_error mng_capture_stop(core_file *fp);
 
 #endif  /* __PNG_H__ */
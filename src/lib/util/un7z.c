@@ -11,6 +11,7 @@
 // this is based on unzip.c, with modifications needed to use the 7zip library
 
 #include "osdcore.h"
+#include "eminline.h"
 #include "un7z.h"
 
 #include <ctype.h>
@@ -158,15 +159,31 @@ void FileOutStream_CreateVTable(CFileOutStream *p)
     CONSTANTS
 ***************************************************************************/
 
-/* number of open files to cache */
-#define _7Z_CACHE_SIZE  8
+/* number of open files to cache, by default and at most */
+#define _7Z_CACHE_SIZE      32
+#define _7Z_CACHE_MAX_SIZE  256
+
+/* decompressed solid blocks beyond the most recent one are only kept
+   while the blocks of a file add up to no more than this */
+#define _7Z_BLOCK_CACHE_MAX_BYTES   (64 * 1024 * 1024)
+
+/* the blocks held by all the files in the cache together are kept to no
+   more than this, dropping those of the least recently used files first */
+#define _7Z_CACHE_MAX_BLOCK_BYTES   (128 * 1024 * 1024)
 
 
 /***************************************************************************
     GLOBAL VARIABLES
 ***************************************************************************/
 
-static _7z_file *_7z_cache[_7Z_CACHE_SIZE];
+/* the cache, most recently used first */
+static _7z_file *_7z_cache[_7Z_CACHE_MAX_SIZE];
+
+/* number of entries of the cache in use */
+static int _7z_cache_size = _7Z_CACHE_SIZE;
+
+/* lock protecting the cache, so archives can be opened from several threads */
+static osd_lock *volatile _7z_cache_lock;
 
 /***************************************************************************
     FUNCTION PROTOTYPES
@@ -174,6 +191,13 @@ static _7z_file *_7z_cache[_7Z_CACHE_SIZE];
 
 /* cache management */
 static void free__7z_file(_7z_file *_7z);
+static void _7z_cache_acquire(void);
+static void free_blocks(_7z_file *_7z, int first);
+static void trim_cache_blocks(void);
+
+/* lookup tables */
+static _7z_error build_index(_7z_file *_7z);
+static int CLIB_DECL index_compare(const void *item1, const void *item2);
 
 
 /***************************************************************************
@@ -188,40 +212,65 @@ int _7z_search_crc_match(_7z_file *new_7z, UINT32 search_crc, const char* search
 {
 	UInt16 *temp = NULL;
 	size_t tempSize = 0;
+	const _7z_index_entry *table;
+	_7z_index_entry target;
+	UINT32 lo, hi;
+
+	// build the lookup tables on first use
+	if (new_7z->index_by_name == NULL && build_index(new_7z) != _7ZERR_NONE)
+		return -1;
+	if (!matchcrc && !matchname)
+		return -1;
+
+	// find the first file with a matching key
+	table = matchname ? new_7z->index_by_name : new_7z->index_by_crc;
+	target.key = search_crc;
+	if (matchname)
+	{
+		target.key = 2166136261U;
+		for (int j = 0; j < search_filename_length; j++)
+			target.key = (target.key ^ (UINT8)search_filename[j]) * 16777619U;
+	}
+	target.entry = 0;
+	lo = 0;
+	hi = new_7z->index_count;
+	while (lo < hi)
+	{
+		UINT32 mid = lo + (hi - lo) / 2;
+		if (index_compare(&table[mid], &target) < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
 
-	for (int i = 0; i < new_7z->db.db.NumFiles; i++)
+	// files with equal keys are in archive order, so the first to match is the right one
+	for ( ; lo < new_7z->index_count && table[lo].key == target.key; lo++)
 	{
+		int i = table[lo].entry;
 		const CSzFileItem *f = new_7z->db.db.Files + i;
-		size_t len;
-
-		len = SzArEx_GetFileNameUtf16(&new_7z->db, i, NULL);
-
-		// if it's a directory entry we don't care about it..
-		if (f->IsDir)
-			continue;
+		UINT64 size = f->Size;
+		UINT32 crc = f->Crc;
 
-		if (len > tempSize)
+		if (matchname)
 		{
-			SZipFree(NULL, temp);
-			tempSize = len;
-			temp = (UInt16 *)SZipAlloc(NULL, tempSize * sizeof(temp[0]));
-			if (temp == 0)
+			size_t len = SzArEx_GetFileNameUtf16(&new_7z->db, i, NULL);
+			if (len != search_filename_length+1)
+				continue;
+
+			if (len > tempSize)
 			{
-				return -1; // memory error
+				SZipFree(NULL, temp);
+				tempSize = len;
+				temp = (UInt16 *)SZipAlloc(NULL, tempSize * sizeof(temp[0]));
+				if (temp == 0)
+				{
+					return -1; // memory error
+				}
 			}
-		}
-
-		bool crcmatch = false;
-		bool namematch = false;
-
-		UINT64 size = f->Size;
-		UINT32 crc = f->Crc;
 
-		/* Check for a name match */
-		SzArEx_GetFileNameUtf16(&new_7z->db, i, temp);
+			/* Check for a name match */
+			SzArEx_GetFileNameUtf16(&new_7z->db, i, temp);
 
-		if (len == search_filename_length+1)
-		{
 			int j;
 			for (j=0;j<search_filename_length;j++)
 			{
@@ -233,41 +282,19 @@ int _7z_search_crc_match(_7z_file *new_7z, UINT32 search_crc, const char* search
 
 				if (sn != zn) break;
 			}
-			if (j==search_filename_length) namematch = true;
+			if (j != search_filename_length)
+				continue;
+			if (matchcrc && crc != search_crc)
+				continue;
 		}
 
-
-		/* Check for a CRC match */
-		if (crc==search_crc) crcmatch = true;
-
-		bool found = false;
-
-		if (matchcrc && matchname)
-		{
-			if (crcmatch && namematch)
-				found = true;
-		}
-		else if (matchcrc)
-		{
-			if (crcmatch)
-				found = true;
-		}
-		else if (matchname)
-		{
-			if (namematch)
-				found = true;
-		}
-
-		if (found)
-		{
 		//  printf("found %S %d %08x %08x %08x %s %d\n", temp, len, crc, search_crc, size, search_filename, search_filename_length);
-			new_7z->curr_file_idx = i;
-			new_7z->uncompressed_length = size;
-			new_7z->crc = crc;
+		new_7z->curr_file_idx = i;
+		new_7z->uncompressed_length = size;
+		new_7z->crc = crc;
 
-			SZipFree(NULL, temp);
-			return i;
-		}
+		SZipFree(NULL, temp);
+		return i;
 	}
 
 	SZipFree(NULL, temp);
@@ -291,7 +318,8 @@ _7z_error _7z_file_open(const char *filename, _7z_file **_7z)
 	*_7z = NULL;
 
 	/* see if we are in the cache, and reopen if so */
-	for (cachenum = 0; cachenum < ARRAY_LENGTH(_7z_cache); cachenum++)
+	_7z_cache_acquire();
+	for (cachenum = 0; cachenum < _7z_cache_size; cachenum++)
 	{
 		_7z_file *cached = _7z_cache[cachenum];
 
@@ -300,9 +328,11 @@ _7z_error _7z_file_open(const char *filename, _7z_file **_7z)
 		{
 			*_7z = cached;
 			_7z_cache[cachenum] = NULL;
+			osd_lock_release(_7z_cache_lock);
 			return _7ZERR_NONE;
 		}
 	}
+	osd_lock_release(_7z_cache_lock);
 
 	/* allocate memory for the _7z_file structure */
 	new_7z = (_7z_file *)malloc(sizeof(*new_7z));
@@ -349,9 +379,7 @@ _7z_error _7z_file_open(const char *filename, _7z_file **_7z)
 		goto error;
 	}
 
-	new_7z->blockIndex = 0xFFFFFFFF; /* it can have any value before first call (if outBuffer = 0) */
-	new_7z->outBuffer = 0; /* it must be 0 before first call for each new archive. */
-	new_7z->outBufferSize = 0;  /* it can have any value before first call (if outBuffer = 0) */
+	/* blocks must have a NULL buffer before first use; the memset took care of that */
 
 	/* make a copy of the filename for caching purposes */
 	string = (char *)malloc(strlen(filename) + 1);
@@ -386,18 +414,29 @@ void _7z_file_close(_7z_file *_7z)
 	_7z->archiveStream.file._7z_osdfile = NULL;
 
 	/* find the first NULL entry in the cache */
-	for (cachenum = 0; cachenum < ARRAY_LENGTH(_7z_cache); cachenum++)
+	_7z_cache_acquire();
+	for (cachenum = 0; cachenum < _7z_cache_size; cachenum++)
 		if (_7z_cache[cachenum] == NULL)
 			break;
 
 	/* if no room left in the cache, free the bottommost entry */
-	if (cachenum == ARRAY_LENGTH(_7z_cache))
+	if (cachenum == _7z_cache_size)
+	{
+		if (cachenum == 0)
+		{
+			free__7z_file(_7z);
+			osd_lock_release(_7z_cache_lock);
+			return;
+		}
 		free__7z_file(_7z_cache[--cachenum]);
+	}
 
 	/* move everyone else down and place us at the top */
 	if (cachenum != 0)
 		memmove(&_7z_cache[1], &_7z_cache[0], cachenum * sizeof(_7z_cache[0]));
 	_7z_cache[0] = _7z;
+	trim_cache_blocks();
+	osd_lock_release(_7z_cache_lock);
 }
 
 
@@ -411,18 +450,61 @@ void _7z_file_cache_clear(void)
 	int cachenum;
 
 	/* clear call cache entries */
-	for (cachenum = 0; cachenum < ARRAY_LENGTH(_7z_cache); cachenum++)
+	_7z_cache_acquire();
+	for (cachenum = 0; cachenum < _7z_cache_size; cachenum++)
 		if (_7z_cache[cachenum] != NULL)
 		{
 			free__7z_file(_7z_cache[cachenum]);
 			_7z_cache[cachenum] = NULL;
 		}
+	osd_lock_release(_7z_cache_lock);
+}
+
+
+/*-------------------------------------------------
+    _7z_file_cache_set_size - set how many
+    recently used _7Z files are kept in the cache
+-------------------------------------------------*/
+
+void _7z_file_cache_set_size(int entries)
+{
+	int cachenum;
+
+	_7z_cache_acquire();
+	_7z_cache_size = MAX(0, MIN(entries, _7Z_CACHE_MAX_SIZE));
+	for (cachenum = _7z_cache_size; cachenum < _7Z_CACHE_MAX_SIZE; cachenum++)
+		if (_7z_cache[cachenum] != NULL)
+		{
+			free__7z_file(_7z_cache[cachenum]);
+			_7z_cache[cachenum] = NULL;
+		}
+	osd_lock_release(_7z_cache_lock);
+}
+
+
+/*-------------------------------------------------
+    _7z_file_cache_free_blocks - free the
+    decompressed solid blocks held by cached _7Z
+    files, keeping their directories
+-------------------------------------------------*/
+
+void _7z_file_cache_free_blocks(void)
+{
+	int cachenum;
+
+	_7z_cache_acquire();
+	for (cachenum = 0; cachenum < _7z_cache_size; cachenum++)
+		if (_7z_cache[cachenum] != NULL)
+			free_blocks(_7z_cache[cachenum], 0);
+	osd_lock_release(_7z_cache_lock);
 }
 
 
 /*-------------------------------------------------
     _7z_file_decompress - decompress a file
-    from a _7Z into the target buffer
+    from a _7Z into the target buffer; the solid
+    block containing it is kept, so the other
+    files in the block don't decompress it again
 -------------------------------------------------*/
 
 _7z_error _7z_file_decompress(_7z_file *new_7z, void *buffer, UINT32 length)
@@ -443,15 +525,44 @@ _7z_error _7z_file_decompress(_7z_file *new_7z, void *buffer, UINT32 length)
 	size_t offset = 0;
 	size_t outSizeProcessed = 0;
 
+	/* use the block already holding the file, or else the least recently used one */
+	UInt32 folder = new_7z->db.FileIndexToFolderIndexMap[index];
+	if (folder == (UInt32)-1)
+		return _7ZERR_NONE;
+	int blocknum;
+	for (blocknum = 0; blocknum < _7Z_BLOCK_CACHE_SIZE - 1; blocknum++)
+		if (new_7z->block[blocknum].buffer == NULL || new_7z->block[blocknum].index == folder)
+			break;
+
+	/* move it to the front */
+	_7z_block block = new_7z->block[blocknum];
+	if (blocknum != 0)
+		memmove(&new_7z->block[1], &new_7z->block[0], blocknum * sizeof(new_7z->block[0]));
+	new_7z->block[0] = block;
+
 	res = SzArEx_Extract(&new_7z->db, &new_7z->lookStream.s, index,
-		&new_7z->blockIndex, &new_7z->outBuffer, &new_7z->outBufferSize,
+		&new_7z->block[0].index, &new_7z->block[0].buffer, &new_7z->block[0].size,
 		&offset, &outSizeProcessed,
 		&new_7z->allocImp, &new_7z->allocTempImp);
 
+	/* a block that failed to decode can't be trusted later */
 	if (res != SZ_OK)
+	{
+		free_blocks(new_7z, 0);
 		return _7ZERR_FILE_ERROR;
+	}
 
-	memcpy(buffer, new_7z->outBuffer + offset, length);
+	memcpy(buffer, new_7z->block[0].buffer + offset, length);
+
+	/* drop older blocks once they take up too much memory */
+	size_t total = new_7z->block[0].size;
+	for (blocknum = 1; blocknum < _7Z_BLOCK_CACHE_SIZE; blocknum++)
+	{
+		total += new_7z->block[blocknum].size;
+		if (new_7z->block[blocknum].buffer == NULL || total > _7Z_BLOCK_CACHE_MAX_BYTES)
+			break;
+	}
+	free_blocks(new_7z, blocknum);
 
 	return _7ZERR_NONE;
 }
@@ -485,10 +596,166 @@ static void free__7z_file(_7z_file *_7z)
 			free((void *)_7z->filename);
 
 
-		if (_7z->outBuffer) IAlloc_Free(&_7z->allocImp, _7z->outBuffer);
+		free_blocks(_7z, 0);
 		if (_7z->inited) SzArEx_Free(&_7z->db, &_7z->allocImp);
+		if (_7z->index_by_name != NULL)
+			free(_7z->index_by_name);
+		if (_7z->index_by_crc != NULL)
+			free(_7z->index_by_crc);
 
 
 		free(_7z);
 	}
 }
+
+
+/*-------------------------------------------------
+    free_blocks - free the decompressed solid
+    blocks of a _7z_file from the given one on
+-------------------------------------------------*/
+
+static void free_blocks(_7z_file *_7z, int first)
+{
+	for (int blocknum = first; blocknum < _7Z_BLOCK_CACHE_SIZE; blocknum++)
+	{
+		if (_7z->block[blocknum].buffer != NULL)
+			IAlloc_Free(&_7z->allocImp, _7z->block[blocknum].buffer);
+		_7z->block[blocknum].buffer = NULL;
+		_7z->block[blocknum].size = 0;
+	}
+}
+
+
+/*-------------------------------------------------
+    trim_cache_blocks - free the blocks of the
+    least recently used files in the cache until
+    the rest fit within the limit; the cache lock
+    must be held
+-------------------------------------------------*/
+
+static void trim_cache_blocks(void)
+{
+	size_t total = 0;
+	for (int cachenum = 0; cachenum < _7z_cache_size; cachenum++)
+	{
+		_7z_file *cached = _7z_cache[cachenum];
+		if (cached == NULL)
+			continue;
+
+		int blocknum;
+		for (blocknum = 0; blocknum < _7Z_BLOCK_CACHE_SIZE; blocknum++)
+		{
+			total += cached->block[blocknum].size;
+			if (total > _7Z_CACHE_MAX_BLOCK_BYTES)
+				break;
+		}
+		free_blocks(cached, blocknum);
+	}
+}
+
+
+/*-------------------------------------------------
+    _7z_cache_acquire - acquire the cache lock,
+    allocating it on first use
+-------------------------------------------------*/
+
+static void _7z_cache_acquire(void)
+{
+	if (_7z_cache_lock == NULL)
+	{
+		osd_lock *lock = osd_lock_alloc();
+		if (compare_exchange_ptr((void * volatile *)&_7z_cache_lock, NULL, lock) != NULL)
+			osd_lock_free(lock);
+	}
+	osd_lock_acquire(_7z_cache_lock);
+}
+
+
+
+/***************************************************************************
+    LOOKUP TABLES
+***************************************************************************/
+
+/*-------------------------------------------------
+    build_index - build the tables of files sorted
+    by filename hash and by CRC used by
+    _7z_search_crc_match; directories are left out
+-------------------------------------------------*/
+
+static _7z_error build_index(_7z_file *_7z)
+{
+	UInt16 *temp = NULL;
+	size_t tempSize = 0;
+	UINT32 count = 0;
+
+	_7z->index_by_name = (_7z_index_entry *)malloc((_7z->db.db.NumFiles + 1) * sizeof(_7z->index_by_name[0]));
+	_7z->index_by_crc = (_7z_index_entry *)malloc((_7z->db.db.NumFiles + 1) * sizeof(_7z->index_by_crc[0]));
+	if (_7z->index_by_name == NULL || _7z->index_by_crc == NULL)
+		goto error;
+
+	for (UINT32 i = 0; i < _7z->db.db.NumFiles; i++)
+	{
+		const CSzFileItem *f = _7z->db.db.Files + i;
+		if (f->IsDir)
+			continue;
+
+		// hash the name the way _7z_search_crc_match compares it
+		size_t len = SzArEx_GetFileNameUtf16(&_7z->db, i, NULL);
+		if (len > tempSize)
+		{
+			SZipFree(NULL, temp);
+			tempSize = len;
+			temp = (UInt16 *)SZipAlloc(NULL, tempSize * sizeof(temp[0]));
+			if (temp == NULL)
+				goto error;
+		}
+		SzArEx_GetFileNameUtf16(&_7z->db, i, temp);
+
+		UINT32 hash = 2166136261U;
+		for (size_t j = 0; j + 1 < len; j++)
+		{
+			UINT16 zn = temp[j];
+			if ((zn>=0x41) && (zn<=0x5a)) zn+=0x20;
+			hash = (hash ^ zn) * 16777619U;
+		}
+
+		_7z->index_by_name[count].key = hash;
+		_7z->index_by_name[count].entry = i;
+		_7z->index_by_crc[count].key = f->Crc;
+		_7z->index_by_crc[count].entry = i;
+		count++;
+	}
+	SZipFree(NULL, temp);
+	_7z->index_count = count;
+
+	// sort by key, keeping files with equal keys in archive order
+	qsort(_7z->index_by_name, count, sizeof(_7z->index_by_name[0]), index_compare);
+	qsort(_7z->index_by_crc, count, sizeof(_7z->index_by_crc[0]), index_compare);
+	return _7ZERR_NONE;
+
+error:
+	SZipFree(NULL, temp);
+	free(_7z->index_by_name);
+	free(_7z->index_by_crc);
+	_7z->index_by_name = NULL;
+	_7z->index_by_crc = NULL;
+	return _7ZERR_OUT_OF_MEMORY;
+}
+
+
+/*-------------------------------------------------
+    index_compare - compare lookup table entries
+    by key, then by archive order
+-------------------------------------------------*/
+
+static int CLIB_DECL index_compare(const void *item1, const void *item2)
+{
+	const _7z_index_entry *entry1 = (const _7z_index_entry *)item1;
+	const _7z_index_entry *entry2 = (const _7z_index_entry *)item2;
+
+	if (entry1->key != entry2->key)
+		return (entry1->key < entry2->key) ? -1 : 1;
+	if (entry1->entry != entry2->entry)
+		return (entry1->entry < entry2->entry) ? -1 : 1;
+	return 0;
+}
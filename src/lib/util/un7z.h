@@ -69,6 +69,10 @@ void FileOutStream_CreateVTable(CFileOutStream *p);
 ***************************************************************************/
 
 
+/* number of decompressed solid blocks kept for each open _7Z file */
+#define _7Z_BLOCK_CACHE_SIZE    4
+
+
 /* Error types */
 enum _7z_error
 {
@@ -89,6 +93,23 @@ enum _7z_error
     TYPE DEFINITIONS
 ***************************************************************************/
 
+/* a decompressed solid block of a _7Z file */
+struct _7z_block
+{
+	UInt32          index;                  /* folder the block belongs to */
+	Byte *          buffer;                 /* decompressed data, or NULL if unused */
+	size_t          size;                   /* size of the buffer */
+};
+
+
+/* an entry in one of the lookup tables of a _7Z file */
+struct _7z_index_entry
+{
+	UINT32          key;                    /* hash of the filename, or CRC */
+	UINT32          entry;                  /* index of the file in the archive */
+};
+
+
 /* describes an open _7Z file */
 struct  _7z_file
 {
@@ -106,10 +127,13 @@ struct  _7z_file
 	ISzAlloc allocTempImp;
 	bool inited;
 
-	// cached stuff for solid blocks
-	UInt32 blockIndex;// = 0xFFFFFFFF; /* it can have any value before first call (if outBuffer = 0) */
-	Byte *outBuffer;// = 0; /* it must be 0 before first call for each new archive. */
-	size_t outBufferSize;// = 0;  /* it can have any value before first call (if outBuffer = 0) */
+	// cached stuff for solid blocks, most recently used first
+	_7z_block block[_7Z_BLOCK_CACHE_SIZE];
+
+	// lookup tables, built on the first search
+	UINT32 index_count;                     /* number of files in the lookup tables */
+	_7z_index_entry *index_by_name;         /* files sorted by hash of their filename */
+	_7z_index_entry *index_by_crc;          /* files sorted by CRC */
 };
 
 
@@ -130,6 +154,12 @@ void _7z_file_close(_7z_file *_7z);
 /* clear out all open _7Z files from the cache */
 void _7z_file_cache_clear(void);
 
+/* set the number of recently used _7Z files kept in the cache */
+void _7z_file_cache_set_size(int entries);
+
+/* free the decompressed solid blocks held by the _7Z files in the cache */
+void _7z_file_cache_free_blocks(void);
+
 
 /* ----- contained file access ----- */
 
@@ -9,7 +9,9 @@
 ***************************************************************************/
 
 #include "osdcore.h"
+#include "eminline.h"
 #include "unzip.h"
+#include "corestr.h"
 
 #include <ctype.h>
 #include <stdlib.h>
@@ -21,8 +23,9 @@
     CONSTANTS
 ***************************************************************************/
 
-/* number of open files to cache */
-#define ZIP_CACHE_SIZE  8
+/* number of open files to cache, by default and at most */
+#define ZIP_CACHE_SIZE      32
+#define ZIP_CACHE_MAX_SIZE  256
 
 /* offsets in end of central directory structure */
 #define ZIPESIG         0x00
@@ -134,8 +137,14 @@ INLINE UINT32 read_dword(UINT8 *buf)
     GLOBAL VARIABLES
 ***************************************************************************/
 
-/** @brief  The zip cache[ zip cache size]. */
-static zip_file *zip_cache[ZIP_CACHE_SIZE];
+/** @brief  The zip cache, most recently used first. */
+static zip_file *zip_cache[ZIP_CACHE_MAX_SIZE];
+
+/** @brief  Number of entries of the zip cache in use. */
+static int zip_cache_size = ZIP_CACHE_SIZE;
+
+/** @brief  Lock protecting the zip cache, so archives can be opened from several threads. */
+static osd_lock *volatile zip_cache_lock;
 
 
 
@@ -145,9 +154,13 @@ static zip_file *zip_cache[ZIP_CACHE_SIZE];
 
 /* cache management */
 static void free_zip_file(zip_file *zip);
+static void zip_cache_acquire(void);
 
 /* ZIP file parsing */
 static zip_error read_ecd(zip_file *zip);
+static zip_error build_index(zip_file *zip);
+static UINT32 filename_hash(const char *filename);
+static int CLIB_DECL index_compare(const void *item1, const void *item2);
 static zip_error get_compressed_data_offset(zip_file *zip, UINT64 *offset);
 
 /* decompression interfaces */
@@ -188,7 +201,8 @@ zip_error zip_file_open(const char *filename, zip_file **zip)
 	*zip = NULL;
 
 	/* see if we are in the cache, and reopen if so */
-	for (cachenum = 0; cachenum < ARRAY_LENGTH(zip_cache); cachenum++)
+	zip_cache_acquire();
+	for (cachenum = 0; cachenum < zip_cache_size; cachenum++)
 	{
 		zip_file *cached = zip_cache[cachenum];
 
@@ -197,9 +211,11 @@ zip_error zip_file_open(const char *filename, zip_file **zip)
 		{
 			*zip = cached;
 			zip_cache[cachenum] = NULL;
+			osd_lock_release(zip_cache_lock);
 			return ZIPERR_NONE;
 		}
 	}
+	osd_lock_release(zip_cache_lock);
 
 	/* allocate memory for the zip_file structure */
 	newzip = (zip_file *)malloc(sizeof(*newzip));
@@ -284,18 +300,28 @@ void zip_file_close(zip_file *zip)
 	zip->file = NULL;
 
 	/* find the first NULL entry in the cache */
-	for (cachenum = 0; cachenum < ARRAY_LENGTH(zip_cache); cachenum++)
+	zip_cache_acquire();
+	for (cachenum = 0; cachenum < zip_cache_size; cachenum++)
 		if (zip_cache[cachenum] == NULL)
 			break;
 
 	/* if no room left in the cache, free the bottommost entry */
-	if (cachenum == ARRAY_LENGTH(zip_cache))
+	if (cachenum == zip_cache_size)
+	{
+		if (cachenum == 0)
+		{
+			free_zip_file(zip);
+			osd_lock_release(zip_cache_lock);
+			return;
+		}
 		free_zip_file(zip_cache[--cachenum]);
+	}
 
 	/* move everyone else down and place us at the top */
 	if (cachenum != 0)
 		memmove(&zip_cache[1], &zip_cache[0], cachenum * sizeof(zip_cache[0]));
 	zip_cache[0] = zip;
+	osd_lock_release(zip_cache_lock);
 }
 
 
@@ -315,12 +341,43 @@ void zip_file_cache_clear(void)
 	int cachenum;
 
 	/* clear call cache entries */
-	for (cachenum = 0; cachenum < ARRAY_LENGTH(zip_cache); cachenum++)
+	zip_cache_acquire();
+	for (cachenum = 0; cachenum < zip_cache_size; cachenum++)
+		if (zip_cache[cachenum] != NULL)
+		{
+			free_zip_file(zip_cache[cachenum]);
+			zip_cache[cachenum] = NULL;
+		}
+	osd_lock_release(zip_cache_lock);
+}
+
+
+/*-------------------------------------------------
+    zip_file_cache_set_size - set how many
+    recently used ZIP files are kept in the cache
+-------------------------------------------------*/
+
+/**
+ * @fn  void zip_file_cache_set_size(int entries)
+ *
+ * @brief   Set the number of ZIP files kept in the cache, freeing any beyond the new size.
+ *
+ * @param   entries The number of entries, clamped to the supported range.
+ */
+
+void zip_file_cache_set_size(int entries)
+{
+	int cachenum;
+
+	zip_cache_acquire();
+	zip_cache_size = MAX(0, MIN(entries, ZIP_CACHE_MAX_SIZE));
+	for (cachenum = zip_cache_size; cachenum < ZIP_CACHE_MAX_SIZE; cachenum++)
 		if (zip_cache[cachenum] != NULL)
 		{
 			free_zip_file(zip_cache[cachenum]);
 			zip_cache[cachenum] = NULL;
 		}
+	osd_lock_release(zip_cache_lock);
 }
 
 
@@ -419,6 +476,83 @@ const zip_file_header *zip_file_next_file(zip_file *zip)
 }
 
 
+/*-------------------------------------------------
+    zip_file_search - find a file by CRC, name or
+    both, making it the current file; names match
+    ignoring case and any leading directory
+-------------------------------------------------*/
+
+/**
+ * @fn  const zip_file_header *zip_file_search(zip_file *zip, UINT32 search_crc, const char *search_filename, bool matchcrc, bool matchname)
+ *
+ * @brief   Find the first file in the ZIP matching the given CRC and/or name, using lookup
+ *          tables built from the central directory the first time the ZIP is searched.
+ *          Directory entries are never returned by a search on CRC alone.
+ *
+ * @param [in,out]  zip     If non-null, the zip.
+ * @param   search_crc      The CRC to look for.
+ * @param   search_filename The filename to look for.
+ * @param   matchcrc        true to require a CRC match.
+ * @param   matchname       true to require a name match.
+ *
+ * @return  null if no file matches, else a zip_file_header*.
+ */
+
+const zip_file_header *zip_file_search(zip_file *zip, UINT32 search_crc, const char *search_filename, bool matchcrc, bool matchname)
+{
+	const zip_index_entry *table;
+	zip_index_entry target;
+	size_t namelength = strlen(search_filename);
+	UINT32 lo, hi;
+
+	/* build the lookup tables on first use */
+	if (zip->index_offset == NULL && build_index(zip) != ZIPERR_NONE)
+		return NULL;
+	if (!matchcrc && !matchname)
+		return NULL;
+
+	/* find the first entry with a matching key */
+	table = matchname ? zip->index_by_name : zip->index_by_crc;
+	target.key = matchname ? filename_hash(search_filename) : search_crc;
+	target.entry = 0;
+	lo = 0;
+	hi = zip->index_count;
+	while (lo < hi)
+	{
+		UINT32 mid = lo + (hi - lo) / 2;
+		if (index_compare(&table[mid], &target) < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	/* entries with equal keys are in directory order, so the first to match is the right one */
+	for ( ; lo < zip->index_count && table[lo].key == target.key; lo++)
+	{
+		const zip_file_header *header;
+		const char *tail;
+
+		zip->cd_pos = zip->index_offset[table[lo].entry];
+		header = zip_file_next_file(zip);
+		if (header == NULL)
+			break;
+
+		if (matchname)
+		{
+			tail = header->filename + header->filename_length - namelength;
+			if (tail < header->filename || core_stricmp(search_filename, tail) != 0 || (tail != header->filename && tail[-1] != '/'))
+				continue;
+			if (matchcrc && header->crc != search_crc)
+				continue;
+		}
+		else if (header->filename_length > 0 && header->filename[header->filename_length - 1] == '/')
+			continue;
+		return header;
+	}
+	return NULL;
+}
+
+
 /*-------------------------------------------------
     zip_file_decompress - decompress a file
     from a ZIP into the target buffer
@@ -503,16 +637,156 @@ static void free_zip_file(zip_file *zip)
 			free(zip->ecd.raw);
 		if (zip->cd != NULL)
 			free(zip->cd);
+		if (zip->index_offset != NULL)
+			free(zip->index_offset);
+		if (zip->index_by_name != NULL)
+			free(zip->index_by_name);
+		if (zip->index_by_crc != NULL)
+			free(zip->index_by_crc);
 		free(zip);
 	}
 }
 
 
+/*-------------------------------------------------
+    zip_cache_acquire - acquire the cache lock,
+    allocating it on first use
+-------------------------------------------------*/
+
+/**
+ * @fn  static void zip_cache_acquire(void)
+ *
+ * @brief   Acquire the zip cache lock, allocating it on first use.
+ */
+
+static void zip_cache_acquire(void)
+{
+	if (zip_cache_lock == NULL)
+	{
+		osd_lock *lock = osd_lock_alloc();
+		if (compare_exchange_ptr((void * volatile *)&zip_cache_lock, NULL, lock) != NULL)
+			osd_lock_free(lock);
+	}
+	osd_lock_acquire(zip_cache_lock);
+}
+
+
 
 /***************************************************************************
     ZIP FILE PARSING
 ***************************************************************************/
 
+/*-------------------------------------------------
+    build_index - build the lookup tables used
+    by zip_file_search
+-------------------------------------------------*/
+
+/**
+ * @fn  static zip_error build_index(zip_file *zip)
+ *
+ * @brief   Record the offset of each central directory entry, and build tables of the entries
+ *          sorted by filename hash and by CRC.
+ *
+ * @param [in,out]  zip If non-null, the zip.
+ *
+ * @return  A zip_error.
+ */
+
+static zip_error build_index(zip_file *zip)
+{
+	const zip_file_header *header;
+	UINT32 maxentries = zip->ecd.cd_size / ZIPCFN + 1;
+	UINT32 count = 0;
+
+	/* every entry takes at least ZIPCFN bytes, which bounds the number of entries */
+	zip->index_offset = (UINT32 *)malloc(maxentries * sizeof(zip->index_offset[0]));
+	zip->index_by_name = (zip_index_entry *)malloc(maxentries * sizeof(zip->index_by_name[0]));
+	zip->index_by_crc = (zip_index_entry *)malloc(maxentries * sizeof(zip->index_by_crc[0]));
+	if (zip->index_offset == NULL || zip->index_by_name == NULL || zip->index_by_crc == NULL)
+	{
+		free(zip->index_offset);
+		free(zip->index_by_name);
+		free(zip->index_by_crc);
+		zip->index_offset = NULL;
+		zip->index_by_name = NULL;
+		zip->index_by_crc = NULL;
+		return ZIPERR_OUT_OF_MEMORY;
+	}
+
+	/* walk the directory, stopping where zip_file_next_file would */
+	for (header = zip_file_first_file(zip); header != NULL && count < maxentries; header = zip_file_next_file(zip))
+	{
+		zip->index_offset[count] = zip->cd_pos - header->rawlength;
+		zip->index_by_name[count].key = filename_hash(header->filename);
+		zip->index_by_name[count].entry = count;
+		zip->index_by_crc[count].key = header->crc;
+		zip->index_by_crc[count].entry = count;
+		count++;
+	}
+	zip->index_count = count;
+
+	/* sort by key, keeping entries with equal keys in directory order */
+	qsort(zip->index_by_name, count, sizeof(zip->index_by_name[0]), index_compare);
+	qsort(zip->index_by_crc, count, sizeof(zip->index_by_crc[0]), index_compare);
+	return ZIPERR_NONE;
+}
+
+
+/*-------------------------------------------------
+    filename_hash - hash the final component of
+    a filename, ignoring case
+-------------------------------------------------*/
+
+/**
+ * @fn  static UINT32 filename_hash(const char *filename)
+ *
+ * @brief   Hash the part of a filename after the last '/', ignoring case.
+ *
+ * @param   filename    Filename of the file.
+ *
+ * @return  The hash.
+ */
+
+static UINT32 filename_hash(const char *filename)
+{
+	const char *base = strrchr(filename, '/');
+	UINT32 hash = 2166136261U;
+
+	for (base = (base != NULL) ? base + 1 : filename; *base != 0; base++)
+		hash = (hash ^ (UINT8)tolower((UINT8)*base)) * 16777619U;
+	return hash;
+}
+
+
+/*-------------------------------------------------
+    index_compare - compare lookup table entries
+    by key, then by directory order
+-------------------------------------------------*/
+
+/**
+ * @fn  static int CLIB_DECL index_compare(const void *item1, const void *item2)
+ *
+ * @brief   qsort comparison for lookup table entries.
+ *
+ * @param   item1   The first item.
+ * @param   item2   The second item.
+ *
+ * @return  Negative, zero or positive as item1 sorts before, with or after item2.
+ */
+
+static int CLIB_DECL index_compare(const void *item1, const void *item2)
+{
+	const zip_index_entry *entry1 = (const zip_index_entry *)item1;
+	const zip_index_entry *entry2 = (const zip_index_entry *)item2;
+
+	if (entry1->key != entry2->key)
+		return (entry1->key < entry2->key) ? -1 : 1;
+	if (entry1->entry != entry2->entry)
+		return (entry1->entry < entry2->entry) ? -1 : 1;
+	return 0;
+}
+
+
 /*-------------------------------------------------
     read_ecd - read the ECD data
 -------------------------------------------------*/
@@ -88,6 +88,14 @@ struct zip_ecd
 };
 
 
+/* an entry in one of the lookup tables of a ZIP file */
+struct zip_index_entry
+{
+	UINT32          key;                    /* hash of the filename, or CRC */
+	UINT32          entry;                  /* number of the entry in the central directory */
+};
+
+
 /* describes an open ZIP file */
 struct zip_file
 {
@@ -101,6 +109,12 @@ struct zip_file
 	UINT32          cd_pos;                 /* position in central directory */
 	zip_file_header header;                 /* current file header */
 
+	UINT32          index_count;            /* number of entries in the lookup tables */
+	UINT32 *        index_offset;           /* offset of each entry in the central directory */
+	zip_index_entry *index_by_name;         /* entries sorted by hash of their filename */
+	zip_index_entry *index_by_crc;          /* entries sorted by CRC */
+
+
 	UINT8           buffer[ZIP_DECOMPRESS_BUFSIZE]; /* buffer for decompression */
 };
 
@@ -122,6 +136,9 @@ void zip_file_close(zip_file *zip);
 /* clear out all open ZIP files from the cache */
 void zip_file_cache_clear(void);
 
+/* set the number of recently used ZIP files kept in the cache */
+void zip_file_cache_set_size(int entries);
+
 
 /* ----- contained file access ----- */
 
@@ -131,6 +148,9 @@ const zip_file_header *zip_file_first_file(zip_file *zip);
 /* find the next file in the ZIP */
 const zip_file_header *zip_file_next_file(zip_file *zip);
 
+/* find a file by crc, filename (ignoring case and any leading directory) or both */
+const zip_file_header *zip_file_search(zip_file *zip, UINT32 search_crc, const char *search_filename, bool matchcrc, bool matchname);
+
 /* decompress the most recently found file in the ZIP */
 zip_error zip_file_decompress(zip_file *zip, void *buffer, UINT32 length);
 
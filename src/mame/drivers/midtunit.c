@@ -596,6 +596,7 @@ static MACHINE_CONFIG_START( tunit_core, midtunit_state )
 	MCFG_TMS340X0_SCANLINE_IND16_CB(midtunit_state, scanline_update)       /* scanline updater (indexed16) */
 	MCFG_TMS340X0_TO_SHIFTREG_CB(midtunit_state, to_shiftreg)           /* write to shiftreg function */
 	MCFG_TMS340X0_FROM_SHIFTREG_CB(midtunit_state, from_shiftreg)          /* read from shiftreg function */
+	MCFG_TMS340X0_VRAM_ROW_CB(0x00000000, 0x003fffff, midtunit_state, vram_row_r, vram_row_w) /* whole-word video RAM rows */
 
 	MCFG_MACHINE_RESET_OVERRIDE(midtunit_state,midtunit)
 	MCFG_NVRAM_ADD_0FILL("nvram")
@@ -1079,6 +1079,7 @@ static MACHINE_CONFIG_START( zunit, midyunit_state )
 	MCFG_TMS340X0_SCANLINE_IND16_CB(midyunit_state, scanline_update)       /* scanline updater (indexed16) */
 	MCFG_TMS340X0_TO_SHIFTREG_CB(midyunit_state, to_shiftreg)           /* write to shiftreg function */
 	MCFG_TMS340X0_FROM_SHIFTREG_CB(midyunit_state, from_shiftreg)          /* read from shiftreg function */
+	MCFG_TMS340X0_VRAM_ROW_CB(0x00000000, 0x001fffff, midyunit_state, vram_row_r, vram_row_w) /* whole-word video RAM rows */
 
 	MCFG_MACHINE_RESET_OVERRIDE(midyunit_state,midyunit)
 	MCFG_NVRAM_ADD_0FILL("nvram")
@@ -1121,6 +1122,7 @@ static MACHINE_CONFIG_START( yunit_core, midyunit_state )
 	MCFG_TMS340X0_SCANLINE_IND16_CB(midyunit_state, scanline_update)       /* scanline updater (indexed16) */
 	MCFG_TMS340X0_TO_SHIFTREG_CB(midyunit_state, to_shiftreg)           /* write to shiftreg function */
 	MCFG_TMS340X0_FROM_SHIFTREG_CB(midyunit_state, from_shiftreg)          /* read from shiftreg function */
+	MCFG_TMS340X0_VRAM_ROW_CB(0x00000000, 0x001fffff, midyunit_state, vram_row_r, vram_row_w) /* whole-word video RAM rows */
 
 	MCFG_MACHINE_RESET_OVERRIDE(midyunit_state,midyunit)
 	MCFG_NVRAM_ADD_0FILL("nvram")
@@ -74,6 +74,10 @@ public:
 
 	TMS340X0_TO_SHIFTREG_CB_MEMBER(to_shiftreg);
 	TMS340X0_FROM_SHIFTREG_CB_MEMBER(from_shiftreg);
+	TMS340X0_VRAM_ROW_READ_CB_MEMBER(vram_row_r);
+	TMS340X0_VRAM_ROW_WRITE_CB_MEMBER(vram_row_w);
+	TMS340X0_VRAM_ROW_READ_CB_MEMBER(vram_data_row_r);
+	TMS340X0_VRAM_ROW_WRITE_CB_MEMBER(vram_data_row_w);
 	TMS340X0_SCANLINE_IND16_CB_MEMBER(scanline_update);
 
 	DECLARE_DRIVER_INIT(mktunit);
@@ -238,6 +238,41 @@ TMS340X0_FROM_SHIFTREG_CB_MEMBER(midtunit_state::from_shiftreg)
 
 
 
+/*************************************
+ *
+ *  Video RAM row read/write
+ *
+ *************************************/
+
+TMS340X0_VRAM_ROW_READ_CB_MEMBER(midtunit_state::vram_row_r)
+{
+	for (UINT32 i = 0; i < words; i++)
+		data[i] = midtunit_vram_r(space, (address >> 4) + i, 0xffff);
+}
+
+
+TMS340X0_VRAM_ROW_WRITE_CB_MEMBER(midtunit_state::vram_row_w)
+{
+	for (UINT32 i = 0; i < words; i++)
+		midtunit_vram_w(space, (address >> 4) + i, data[i], 0xffff);
+}
+
+
+TMS340X0_VRAM_ROW_READ_CB_MEMBER(midtunit_state::vram_data_row_r)
+{
+	for (UINT32 i = 0; i < words; i++)
+		data[i] = midtunit_vram_data_r(space, (address >> 4) + i, 0xffff);
+}
+
+
+TMS340X0_VRAM_ROW_WRITE_CB_MEMBER(midtunit_state::vram_data_row_w)
+{
+	for (UINT32 i = 0; i < words; i++)
+		midtunit_vram_data_w(space, (address >> 4) + i, data[i], 0xffff);
+}
+
+
+
 /*************************************
  *
  *  Control register
@@ -186,6 +186,27 @@ TMS340X0_FROM_SHIFTREG_CB_MEMBER(midyunit_state::from_shiftreg)
 
 
 
+/*************************************
+ *
+ *  Video RAM row read/write
+ *
+ *************************************/
+
+TMS340X0_VRAM_ROW_READ_CB_MEMBER(midyunit_state::vram_row_r)
+{
+	for (UINT32 i = 0; i < words; i++)
+		data[i] = midyunit_vram_r(space, (address >> 4) + i, 0xffff);
+}
+
+
+TMS340X0_VRAM_ROW_WRITE_CB_MEMBER(midyunit_state::vram_row_w)
+{
+	for (UINT32 i = 0; i < words; i++)
+		midyunit_vram_w(space, (address >> 4) + i, data[i], 0xffff);
+}
+
+
+
 /*************************************
  *
  *  Y/Z-unit control register
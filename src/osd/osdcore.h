@@ -183,6 +183,56 @@ file_error osd_write(osd_file *file, const void *buffer, UINT64 offset, UINT32 l
 file_error osd_truncate(osd_file *file, UINT64 offset);
 
 
+/*-----------------------------------------------------------------------------
+    osd_map: map a read-only view of an entire open file into memory
+
+    Parameters:
+
+        file - handle to a file previously opened via osd_open
+
+        length - the size of the file, as returned by osd_open
+
+        base - pointer to a const void * to receive the address of the
+            view
+
+    Return value:
+
+        a file_error describing any error that occurred while mapping the
+        file, or FILERR_NONE if no error occurred
+
+    Notes:
+
+        Mapping is optional; callers must be prepared to fall back to
+        osd_read if this returns an error. The view remains valid after
+        the file is closed, until it is released with osd_unmap.
+
+        The view is not a copy. If another process truncates the file
+        while it is mapped, touching the pages past the new end raises
+        SIGBUS on POSIX systems (Windows refuses to truncate a mapped
+        file instead). Only map files that are not expected to shrink,
+        such as ROMs and read-only CHDs, and never files this process
+        or a cooperating one may rewrite in place.
+-----------------------------------------------------------------------------*/
+file_error osd_map(osd_file *file, UINT64 length, const void **base);
+
+
+/*-----------------------------------------------------------------------------
+    osd_unmap: release a view created by osd_map
+
+    Parameters:
+
+        base - the address of the view, as returned by osd_map
+
+        length - the length that was passed to osd_map
+
+    Return value:
+
+        a file_error describing any error that occurred while unmapping
+        the file, or FILERR_NONE if no error occurred
+-----------------------------------------------------------------------------*/
+file_error osd_unmap(const void *base, UINT64 length);
+
+
 /*-----------------------------------------------------------------------------
     osd_rmfile: deletes a file
 
@@ -286,6 +336,7 @@ struct osd_directory_entry
 	const char *        name;           /* name of the entry */
 	osd_dir_entry_type  type;           /* type of the entry */
 	UINT64              size;           /* size of the entry */
+	UINT64              last_modified;  /* OSD-specific modification time, or 0 if unknown */
 };
 
 
@@ -716,6 +767,17 @@ void *osd_work_item_result(osd_work_item *item);
 void osd_work_item_release(osd_work_item *item);
 
 
+/*-----------------------------------------------------------------------------
+    osd_get_num_processors: return the number of processors available
+
+    Return value:
+
+        the number of processors work queues can spread items across; this
+        is 1 if work items are always run on the calling thread
+-----------------------------------------------------------------------------*/
+int osd_get_num_processors(void);
+
+
 
 /***************************************************************************
     MISCELLANEOUS INTERFACES
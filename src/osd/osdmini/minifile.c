@@ -9,6 +9,10 @@
 #include "osdcore.h"
 #include <stdlib.h>
 #include <unistd.h>
+#include <sys/stat.h>
+#ifdef _POSIX_MAPPED_FILES
+#include <sys/mman.h>
+#endif
 
 
 //============================================================
@@ -121,6 +125,46 @@ file_error osd_truncate(osd_file *file, UINT64 offset)
 }
 
 
+//============================================================
+//  osd_map
+//============================================================
+
+file_error osd_map(osd_file *file, UINT64 length, const void **base)
+{
+#ifdef _POSIX_MAPPED_FILES
+	// map the descriptor under the FILE, as long as the whole file fits in our address space
+	if (length == 0 || length != (size_t)length)
+		return FILERR_FAILURE;
+
+	void *result = mmap(NULL, length, PROT_READ, MAP_SHARED, fileno((FILE *)file), 0);
+	if (result == MAP_FAILED)
+		return FILERR_FAILURE;
+
+	*base = result;
+	return FILERR_NONE;
+#else
+	// mapping is not supported; callers fall back to osd_read
+	return FILERR_FAILURE;
+#endif
+}
+
+
+//============================================================
+//  osd_unmap
+//============================================================
+
+file_error osd_unmap(const void *base, UINT64 length)
+{
+#ifdef _POSIX_MAPPED_FILES
+	if (munmap(const_cast<void *>(base), length) != 0)
+		return FILERR_FAILURE;
+	return FILERR_NONE;
+#else
+	return FILERR_FAILURE;
+#endif
+}
+
+
 //============================================================
 //  osd_rmfile
 //============================================================
@@ -170,6 +214,7 @@ osd_directory_entry *osd_stat(const char *path)
 	result->name = (char *)(result + 1);
 	result->type = ENTTYPE_NONE;
 	result->size = 0;
+	result->last_modified = 0;
 
 	FILE *f = fopen(path, "rb");
 	if (f != NULL)
@@ -178,6 +223,10 @@ osd_directory_entry *osd_stat(const char *path)
 		result->type = ENTTYPE_FILE;
 		result->size = ftell(f);
 		fclose(f);
+
+		struct stat st;
+		if (stat(path, &st) == 0)
+			result->last_modified = (UINT64)st.st_mtime;
 	}
 	return result;
 }
@@ -40,6 +40,17 @@ void osd_free(void *ptr)
 }
 
 
+//============================================================
+//  osd_get_num_processors
+//============================================================
+
+int osd_get_num_processors(void)
+{
+	// work items always run on the calling thread
+	return 1;
+}
+
+
 //============================================================
 //  osd_alloc_executable
 //============================================================
@@ -33,6 +33,9 @@
 #endif
 
 #include <sys/stat.h>
+#ifndef SDLMAME_OS2
+#include <sys/mman.h>
+#endif
 #include <fcntl.h>
 #include <unistd.h>
 #include <stdio.h>
@@ -385,6 +388,45 @@ file_error osd_truncate(osd_file *file, UINT64 offset)
 }
 
 
+//============================================================
+//  osd_map
+//============================================================
+
+file_error osd_map(osd_file *file, UINT64 length, const void **base)
+{
+#ifdef SDLMAME_OS2
+	return FILERR_FAILURE;
+#else
+	// only regular files can be mapped, and only if the whole file fits in our address space
+	if (!file || file->type != SDLFILE_FILE || length == 0 || length != (size_t)length)
+		return FILERR_FAILURE;
+
+	void *result = mmap(NULL, length, PROT_READ, MAP_SHARED, file->handle, 0);
+	if (result == MAP_FAILED)
+		return error_to_file_error(errno);
+
+	*base = result;
+	return FILERR_NONE;
+#endif
+}
+
+
+//============================================================
+//  osd_unmap
+//============================================================
+
+file_error osd_unmap(const void *base, UINT64 length)
+{
+#ifdef SDLMAME_OS2
+	return FILERR_FAILURE;
+#else
+	if (munmap(const_cast<void *>(base), length) != 0)
+		return error_to_file_error(errno);
+	return FILERR_NONE;
+#endif
+}
+
+
 //============================================================
 //  osd_close
 //============================================================
@@ -530,6 +572,7 @@ osd_directory_entry *osd_stat(const char *path)
 	result->name = ((char *) result) + sizeof(*result);
 	result->type = S_ISDIR(st.st_mode) ? ENTTYPE_DIR : ENTTYPE_FILE;
 	result->size = (UINT64)st.st_size;
+	result->last_modified = (UINT64)st.st_mtime;
 
 	return result;
 }
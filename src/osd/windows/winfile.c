@@ -276,6 +276,45 @@ file_error osd_truncate(osd_file *file, UINT64 offset)
 }
 
 
+//============================================================
+//  osd_map
+//============================================================
+
+file_error osd_map(osd_file *file, UINT64 length, const void **base)
+{
+	// only regular files can be mapped, and only if the whole file fits in our address space
+	if (!file || !file->handle || file->type != WINFILE_FILE || length == 0 || length != (SIZE_T)length)
+		return FILERR_FAILURE;
+
+	// create a read-only mapping object covering the whole file
+	HANDLE mapping = CreateFileMapping(file->handle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping == NULL)
+		return win_error_to_mame_file_error(GetLastError());
+
+	// map a view of it; the view keeps the mapping alive once the handle is closed
+	void *result = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, (SIZE_T)length);
+	DWORD error = GetLastError();
+	CloseHandle(mapping);
+	if (result == NULL)
+		return win_error_to_mame_file_error(error);
+
+	*base = result;
+	return FILERR_NONE;
+}
+
+
+//============================================================
+//  osd_unmap
+//============================================================
+
+file_error osd_unmap(const void *base, UINT64 length)
+{
+	if (!UnmapViewOfFile(base))
+		return win_error_to_mame_file_error(GetLastError());
+	return FILERR_NONE;
+}
+
+
 //============================================================
 //  osd_close
 //============================================================
@@ -484,6 +523,7 @@ osd_directory_entry *osd_stat(const char *path)
 	result->name = ((char *) result) + sizeof(*result);
 	result->type = win_attributes_to_entry_type(find_data.dwFileAttributes);
 	result->size = find_data.nFileSizeLow | ((UINT64) find_data.nFileSizeHigh << 32);
+	result->last_modified = find_data.ftLastWriteTime.dwLowDateTime | ((UINT64) find_data.ftLastWriteTime.dwHighDateTime << 32);
 
 done:
 	if (t_path != NULL)
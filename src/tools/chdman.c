@@ -1492,6 +1492,9 @@ static void do_verify(parameters_t &params)
 	chd_file input_chd;
 	parse_input_chd_parameters(params, input_chd, input_parent_chd);
 
+	// the input is read front to back, so decompress ahead of it on all cores
+	input_chd.read_ahead_begin();
+
 	// only makes sense for compressed CHDs with valid SHA1's
 	if (!input_chd.compressed())
 		report_error(0, "No verification to be done; CHD is uncompressed");
@@ -2081,6 +2084,9 @@ static void do_copy(parameters_t &params)
 	chd_file input_chd;
 	parse_input_chd_parameters(params, input_chd, input_parent_chd);
 
+	// the input is read front to back, so decompress ahead of it on all cores
+	input_chd.read_ahead_begin();
+
 	// parse out input start/end
 	UINT64 input_start;
 	UINT64 input_end;
@@ -2217,6 +2223,9 @@ static void do_extract_raw(parameters_t &params)
 	chd_file input_chd;
 	parse_input_chd_parameters(params, input_chd, input_parent_chd);
 
+	// the input is read front to back, so decompress ahead of it on all cores
+	input_chd.read_ahead_begin();
+
 	// parse out input start/end
 	UINT64 input_start;
 	UINT64 input_end;
@@ -2296,6 +2305,9 @@ static void do_extract_cd(parameters_t &params)
 	chd_file input_chd;
 	parse_input_chd_parameters(params, input_chd, input_parent_chd);
 
+	// the input is read front to back, so decompress ahead of it on all cores
+	input_chd.read_ahead_begin();
+
 	// further process input file
 	cdrom_file *cdrom = cdrom_open(&input_chd);
 	if (cdrom == NULL)
@@ -0,0 +1,191 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+
+#include "gtest/gtest.h"
+#include "cpu/rsp/rspvmac.h"
+
+namespace
+{
+	// operand values that exercise the overflow, rounding and clamping paths
+	const UINT16 edge_values[] = { 0x0000, 0x0001, 0x7fff, 0x8000, 0x8001, 0xffff, 0x4000, 0xc000 };
+
+	class rsp_vmac_random
+	{
+	public:
+		rsp_vmac_random() : m_state(0x2545f491) { }
+
+		UINT32 next()
+		{
+			m_state ^= m_state << 13;
+			m_state ^= m_state >> 17;
+			m_state ^= m_state << 5;
+			return m_state;
+		}
+
+		UINT16 operand()
+		{
+			UINT32 r = next();
+			return ((r & 3) == 0) ? edge_values[(r >> 2) & 7] : UINT16(r >> 16);
+		}
+
+		UINT64 accumulator()
+		{
+			UINT64 q = (UINT64(next()) << 32) | next();
+
+			// keep a good share of accumulators close to the clamping boundaries
+			switch (next() & 3)
+			{
+				case 0: q &= U64(0x00000000ffffffff); break;
+				case 1: q |= U64(0xffffffff00000000); break;
+				default: break;
+			}
+			return q;
+		}
+
+	private:
+		UINT32 m_state;
+	};
+
+	void check_op(rsp_vmac_func scalar, rsp_vmac_func simd, const char *name)
+	{
+		rsp_vmac_random rand;
+
+		for (int iter = 0; iter < 100000; iter++)
+		{
+			UINT16 vs[8], vt[8];
+			UINT64 acc_scalar[8], acc_simd[8];
+			for (int i = 0; i < 8; i++)
+			{
+				vs[i] = rand.operand();
+				vt[i] = rand.operand();
+				acc_scalar[i] = acc_simd[i] = rand.accumulator();
+			}
+
+			UINT16 vd_scalar[8], vd_simd[8];
+			(*scalar)(vd_scalar, vs, vt, acc_scalar);
+			(*simd)(vd_simd, vs, vt, acc_simd);
+
+			for (int i = 0; i < 8; i++)
+			{
+				ASSERT_EQ(vd_scalar[i], vd_simd[i]) << name << " result, element " << i << ", vs=" << vs[i] << " vt=" << vt[i];
+				ASSERT_EQ(acc_scalar[i], acc_simd[i]) << name << " accumulator, element " << i << ", vs=" << vs[i] << " vt=" << vt[i];
+			}
+		}
+	}
+}
+
+TEST(rspvmac,scalar_vmulf_overflow)
+{
+	UINT16 vs[8], vt[8], vd[8];
+	UINT64 acc[8];
+	for (int i = 0; i < 8; i++)
+	{
+		vs[i] = vt[i] = 0x8000;
+		acc[i] = 0;
+	}
+
+	rsp_vmac_scalar.vmulf(vd, vs, vt, acc);
+	EXPECT_EQ(0x7fff, vd[0]);
+	EXPECT_EQ(U64(0x0000800080000000), acc[0]);
+
+	rsp_vmac_scalar.vmulu(vd, vs, vt, acc);
+	EXPECT_EQ(0xffff, vd[0]);
+	EXPECT_EQ(U64(0x0000800080000000), acc[0]);
+}
+
+TEST(rspvmac,scalar_vmadh_saturates)
+{
+	UINT16 vs[8], vt[8], vd[8];
+	UINT64 acc[8];
+	for (int i = 0; i < 8; i++)
+	{
+		vs[i] = 0x7fff;
+		vt[i] = 0x7fff;
+		acc[i] = 0;
+	}
+
+	rsp_vmac_scalar.vmadh(vd, vs, vt, acc);
+	EXPECT_EQ(0x7fff, vd[0]);
+
+	for (int i = 0; i < 8; i++)
+		vt[i] = 0x8001;
+	rsp_vmac_scalar.vmadh(vd, vs, vt, acc);
+	rsp_vmac_scalar.vmadh(vd, vs, vt, acc);
+	EXPECT_EQ(0x8000, vd[0]);
+}
+
+#if RSP_VMAC_X86
+
+namespace
+{
+	// every kernel of a set against the scalar reference, if the host can run it
+	void check_ops(const rsp_vmac_ops &simd, bool supported)
+	{
+		if (!supported)
+		{
+			printf("%s not supported by this host, skipped\n", simd.name);
+			return;
+		}
+		check_op(rsp_vmac_scalar.vmulf, simd.vmulf, "vmulf");
+		check_op(rsp_vmac_scalar.vmulu, simd.vmulu, "vmulu");
+		check_op(rsp_vmac_scalar.vmudl, simd.vmudl, "vmudl");
+		check_op(rsp_vmac_scalar.vmudm, simd.vmudm, "vmudm");
+		check_op(rsp_vmac_scalar.vmudn, simd.vmudn, "vmudn");
+		check_op(rsp_vmac_scalar.vmudh, simd.vmudh, "vmudh");
+		check_op(rsp_vmac_scalar.vmacf, simd.vmacf, "vmacf");
+		check_op(rsp_vmac_scalar.vmacu, simd.vmacu, "vmacu");
+		check_op(rsp_vmac_scalar.vmadl, simd.vmadl, "vmadl");
+		check_op(rsp_vmac_scalar.vmadm, simd.vmadm, "vmadm");
+		check_op(rsp_vmac_scalar.vmadn, simd.vmadn, "vmadn");
+		check_op(rsp_vmac_scalar.vmadh, simd.vmadh, "vmadh");
+	}
+
+	// the destination register is allowed to be the first source
+	void check_in_place(const rsp_vmac_ops &simd, bool supported)
+	{
+		if (!supported)
+			return;
+
+		rsp_vmac_random rand;
+		UINT16 vs_scalar[8], vs_simd[8], vt[8];
+		UINT64 acc_scalar[8], acc_simd[8];
+		for (int i = 0; i < 8; i++)
+		{
+			vs_scalar[i] = vs_simd[i] = rand.operand();
+			vt[i] = rand.operand();
+			acc_scalar[i] = acc_simd[i] = rand.accumulator();
+		}
+
+		rsp_vmac_scalar.vmacf(vs_scalar, vs_scalar, vt, acc_scalar);
+		simd.vmacf(vs_simd, vs_simd, vt, acc_simd);
+		for (int i = 0; i < 8; i++)
+		{
+			EXPECT_EQ(vs_scalar[i], vs_simd[i]) << simd.name;
+			EXPECT_EQ(acc_scalar[i], acc_simd[i]) << simd.name;
+		}
+	}
+}
+
+TEST(rspvmac,select)
+{
+	if (rsp_vmac_sse41_supported())
+		EXPECT_EQ(&rsp_vmac_sse41, &rsp_vmac_select());
+	else if (rsp_vmac_sse2_supported())
+		EXPECT_EQ(&rsp_vmac_sse2, &rsp_vmac_select());
+	else
+		EXPECT_EQ(&rsp_vmac_scalar, &rsp_vmac_select());
+}
+
+TEST(rspvmac,sse2_matches_scalar) { check_ops(rsp_vmac_sse2, rsp_vmac_sse2_supported()); }
+TEST(rspvmac,sse41_matches_scalar) { check_ops(rsp_vmac_sse41, rsp_vmac_sse41_supported()); }
+TEST(rspvmac,sse2_in_place) { check_in_place(rsp_vmac_sse2, rsp_vmac_sse2_supported()); }
+TEST(rspvmac,sse41_in_place) { check_in_place(rsp_vmac_sse41, rsp_vmac_sse41_supported()); }
+
+#else
+
+TEST(rspvmac,select)
+{
+	EXPECT_EQ(&rsp_vmac_scalar, &rsp_vmac_select());
+}
+
+#endif
@@ -0,0 +1,131 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+
+#include "gtest/gtest.h"
+#include "cpu/tms34010/34010blk.h"
+
+namespace
+{
+	class blk_random
+	{
+	public:
+		blk_random() : m_state(0x6b8b4567) { }
+
+		UINT32 next()
+		{
+			m_state ^= m_state << 13;
+			m_state ^= m_state >> 17;
+			m_state ^= m_state << 5;
+			return m_state;
+		}
+
+		// words with plenty of zero pixels, so transparency gets exercised
+		UINT16 word(int bpp)
+		{
+			UINT16 result = next() >> 16;
+			return result & ~tms340x0_zero_pixels(UINT16(next() >> 8), bpp);
+		}
+
+	private:
+		UINT32 m_state;
+	};
+
+	// word-addressed memory for the per-pixel loops
+	class blk_memory
+	{
+	public:
+		blk_memory(UINT16 *base) : m_base(base) { }
+		UINT16 read(UINT32 wordaddr) { return m_base[wordaddr]; }
+		void write(UINT32 wordaddr, UINT16 data) { m_base[wordaddr] = data; }
+
+	private:
+		UINT16 *m_base;
+	};
+
+	// fill rows with the kernels and with the FILL per-pixel loop
+	template<int _BitsPerPixel>
+	void check_fill(blk_random &rand)
+	{
+		const int bpp = _BitsPerPixel;
+		for (UINT32 words = 0; words < 40; words++)
+			for (int iter = 0; iter < 20; iter++)
+			{
+				UINT16 color = rand.word(bpp);
+				UINT16 row[42], expected[42];
+				for (UINT32 i = 0; i < words + 2; i++)
+					row[i] = expected[i] = rand.word(bpp);
+				blk_memory memory(expected);
+
+				// start one word in so that the kernels see unaligned rows
+				tms340x0_fill_row_trans(&row[1], words, color, bpp);
+				tms340x0_fill_words<_BitsPerPixel, 0, 1>(memory, tms340x0_replace_op(), 1, words, color);
+				for (UINT32 i = 0; i < words + 2; i++)
+					ASSERT_EQ(expected[i], row[i]) << "trans bpp=" << bpp << " words=" << words << " index=" << i;
+
+				tms340x0_fill_row(&row[1], words, color);
+				tms340x0_fill_words<_BitsPerPixel, 0, 0>(memory, tms340x0_replace_op(), 1, words, color);
+				for (UINT32 i = 0; i < words + 2; i++)
+					ASSERT_EQ(expected[i], row[i]) << "opaque bpp=" << bpp << " words=" << words << " index=" << i;
+			}
+	}
+
+	// copy rows with the kernels and with the PIXBLT per-pixel loop, which
+	// must also make the reads and writes that get charged for a copied row
+	template<int _BitsPerPixel>
+	void check_copy(blk_random &rand)
+	{
+		const int bpp = _BitsPerPixel;
+		const UINT32 srcbase = 48;
+		for (UINT32 words = 1; words < 40; words++)
+			for (int iter = 0; iter < 20; iter++)
+			{
+				UINT16 row[88], expected[88];
+				for (UINT32 i = 0; i < 88; i++)
+					row[i] = expected[i] = rand.word(bpp);
+				blk_memory memory(expected);
+				int dx = words * 16 / bpp;
+
+				tms340x0_copy_row_trans(&row[1], &row[srcbase], words, bpp);
+				UINT32 readwrites = tms340x0_pixblt_row<_BitsPerPixel, 0, 1>(memory, tms340x0_replace_op(), srcbase << 4, 1 << 4, dx);
+				ASSERT_EQ(words * 3, readwrites) << "trans bpp=" << bpp << " words=" << words;
+				for (UINT32 i = 0; i < 88; i++)
+					ASSERT_EQ(expected[i], row[i]) << "trans bpp=" << bpp << " words=" << words << " index=" << i;
+
+				tms340x0_copy_row(&row[1], &row[srcbase], words);
+				readwrites = tms340x0_pixblt_row<_BitsPerPixel, 0, 0>(memory, tms340x0_replace_op(), srcbase << 4, 1 << 4, dx);
+				ASSERT_EQ(words * 2, readwrites) << "opaque bpp=" << bpp << " words=" << words;
+				for (UINT32 i = 0; i < 88; i++)
+					ASSERT_EQ(expected[i], row[i]) << "opaque bpp=" << bpp << " words=" << words << " index=" << i;
+			}
+	}
+}
+
+TEST(tms340x0blk,zero_pixels)
+{
+	EXPECT_EQ(0xffff, tms340x0_zero_pixels(0x0000, 8));
+	EXPECT_EQ(0xff00, tms340x0_zero_pixels(0x0080, 8));
+	EXPECT_EQ(0x0f0f, tms340x0_zero_pixels(0x1020, 4));
+	EXPECT_EQ(0x0000, tms340x0_zero_pixels(0x8000, 16));
+	EXPECT_EQ(0x3333, tms340x0_zero_pixels(0x4848, 2));
+	EXPECT_EQ(0x5555, tms340x0_zero_pixels(0xaaaa, 1));
+}
+
+TEST(tms340x0blk,fill_matches_pixel_loop)
+{
+	blk_random rand;
+	check_fill<1>(rand);
+	check_fill<2>(rand);
+	check_fill<4>(rand);
+	check_fill<8>(rand);
+	check_fill<16>(rand);
+}
+
+TEST(tms340x0blk,copy_matches_pixel_loop)
+{
+	blk_random rand;
+	check_copy<1>(rand);
+	check_copy<2>(rand);
+	check_copy<4>(rand);
+	check_copy<8>(rand);
+	check_copy<16>(rand);
+}
@@ -0,0 +1,230 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+
+#include "gtest/gtest.h"
+#include "osdcore.h"
+#include "drawgfxd.h"
+#include <vector>
+
+namespace
+{
+	class gfx_random
+	{
+	public:
+		gfx_random() : m_state(0x1b873593) { }
+
+		UINT32 next()
+		{
+			m_state ^= m_state << 13;
+			m_state ^= m_state >> 17;
+			m_state ^= m_state << 5;
+			return m_state;
+		}
+
+		// a value in [0, range)
+		UINT32 below(UINT32 range) { return next() % range; }
+
+	private:
+		UINT32 m_state;
+	};
+
+	// a layout along with the offsets it points to and some source data
+	class test_layout
+	{
+	public:
+		test_layout() { memset(&m_layout, 0, sizeof(m_layout)); }
+
+		// byte-aligned runs of 8 pixels in every plane
+		void make_planar(gfx_random &rand)
+		{
+			int planes = 1 + rand.below(8);
+			int width = 8 * (1 + rand.below(4));
+			int height = 1 + rand.below(32);
+			resize(planes, width, height);
+			for (int p = 0; p < planes; p++)
+				m_planeoffset[p] = 8 * rand.below(64);
+			for (int x = 0; x < width; x += 8)
+			{
+				UINT32 base = 8 * rand.below(64);
+				for (int bit = 0; bit < 8; bit++)
+					m_xoffset[x + bit] = base + bit;
+			}
+			for (int y = 0; y < height; y++)
+				m_yoffset[y] = 8 * rand.below(256);
+			finish(rand, 8 * (1 + rand.below(256)), 8 * rand.below(8));
+		}
+
+		// 4 or 8 consecutive bits per pixel, plane 0 first
+		void make_packed(gfx_random &rand)
+		{
+			int planes = (rand.next() & 1) ? 8 : 4;
+			int width = 1 + rand.below(32);
+			int height = 1 + rand.below(32);
+			resize(planes, width, height);
+			m_planeoffset[0] = planes * rand.below(64);
+			for (int p = 1; p < planes; p++)
+				m_planeoffset[p] = m_planeoffset[0] + p;
+			for (int x = 0; x < width; x++)
+				m_xoffset[x] = planes * rand.below(256);
+			for (int y = 0; y < height; y++)
+				m_yoffset[y] = planes * rand.below(256);
+			finish(rand, planes * (1 + rand.below(512)), planes * rand.below(8));
+		}
+
+		// anything at all
+		void make_random(gfx_random &rand)
+		{
+			int planes = 1 + rand.below(8);
+			int width = 1 + rand.below(32);
+			int height = 1 + rand.below(32);
+			resize(planes, width, height);
+			for (int p = 0; p < planes; p++)
+				m_planeoffset[p] = rand.below(512);
+			for (int x = 0; x < width; x++)
+				m_xoffset[x] = rand.below(2048);
+			for (int y = 0; y < height; y++)
+				m_yoffset[y] = rand.below(2048);
+			finish(rand, 1 + rand.below(4096), rand.below(64));
+		}
+
+		const gfx_decode_layout &layout() const { return m_layout; }
+		int elements() const { return s_elements; }
+		UINT32 pixels() const { return m_layout.width * m_layout.height; }
+
+	private:
+		static const int s_elements = 8;
+
+		void resize(int planes, int width, int height)
+		{
+			m_planeoffset.resize(planes);
+			m_xoffset.resize(width);
+			m_yoffset.resize(height);
+			m_layout.planes = planes;
+			m_layout.width = width;
+			m_layout.height = height;
+			m_layout.line_modulo = width;
+		}
+
+		void finish(gfx_random &rand, UINT32 charincrement, UINT32 xormask)
+		{
+			// the largest offset any element reads, allowing for the xor mask
+			UINT32 maxbit = 0;
+			for (int p = 0; p < m_layout.planes; p++)
+				for (int y = 0; y < m_layout.height; y++)
+					for (int x = 0; x < m_layout.width; x++)
+						maxbit = MAX(maxbit, m_planeoffset[p] + m_yoffset[y] + m_xoffset[x]);
+			maxbit += (s_elements - 1) * charincrement;
+			m_source.resize((maxbit | xormask) / 8 + 1);
+			for (size_t i = 0; i < m_source.size(); i++)
+				m_source[i] = rand.next() >> 24;
+
+			m_layout.srcdata = &m_source[0];
+			m_layout.xormask = xormask;
+			m_layout.charincrement = charincrement;
+			m_layout.planeoffset = &m_planeoffset[0];
+			m_layout.xoffset = &m_xoffset[0];
+			m_layout.yoffset = &m_yoffset[0];
+		}
+
+		gfx_decode_layout       m_layout;
+		std::vector<UINT32>     m_planeoffset;
+		std::vector<UINT32>     m_xoffset;
+		std::vector<UINT32>     m_yoffset;
+		std::vector<UINT8>      m_source;
+	};
+
+	// decode every element with the given mode and with the generic decoder
+	void check_decode(const test_layout &test, gfx_decode_mode mode, int iter)
+	{
+		const gfx_decode_layout &layout = test.layout();
+		std::vector<UINT8> expected(test.pixels(), 0x55), actual(test.pixels(), 0xaa);
+		for (int code = 0; code < test.elements(); code++)
+		{
+			gfx_decode_generic(layout, code, &expected[0]);
+			gfx_decode(mode, layout, code, &actual[0]);
+			for (UINT32 i = 0; i < test.pixels(); i++)
+				ASSERT_EQ(expected[i], actual[i]) << "iter=" << iter << " mode=" << mode << " planes=" << layout.planes
+						<< " size=" << layout.width << "x" << layout.height << " code=" << code << " pixel=" << i;
+		}
+	}
+}
+
+TEST(drawgfxd,planar_matches_generic)
+{
+	gfx_random rand;
+	for (int iter = 0; iter < 500; iter++)
+	{
+		test_layout test;
+		test.make_planar(rand);
+		ASSERT_EQ(GFX_DECODE_PLANAR, gfx_decode_classify(test.layout())) << "iter=" << iter;
+		check_decode(test, GFX_DECODE_PLANAR, iter);
+	}
+}
+
+TEST(drawgfxd,packed_matches_generic)
+{
+	gfx_random rand;
+	for (int iter = 0; iter < 500; iter++)
+	{
+		test_layout test;
+		test.make_packed(rand);
+		ASSERT_EQ(GFX_DECODE_PACKED, gfx_decode_classify(test.layout())) << "iter=" << iter;
+		check_decode(test, GFX_DECODE_PACKED, iter);
+	}
+}
+
+TEST(drawgfxd,random_layouts_match_generic)
+{
+	gfx_random rand;
+	for (int iter = 0; iter < 2000; iter++)
+	{
+		test_layout test;
+		test.make_random(rand);
+		check_decode(test, gfx_decode_classify(test.layout()), iter);
+	}
+}
+
+TEST(drawgfxd,DISABLED_decode_benchmark)
+{
+	const int elements = 8192;
+	static const UINT32 planar4[] = { 0, 8, 16, 24 };
+	static const UINT32 packed4[] = { 0, 1, 2, 3 };
+	std::vector<UINT32> xoffset(16), yoffset(16), packedx(16), packedy(16);
+	for (int i = 0; i < 16; i++)
+	{
+		xoffset[i] = (i / 8) * 32 * 16 + (i % 8);
+		yoffset[i] = i * 32;
+		packedx[i] = i * 4;
+		packedy[i] = i * 64;
+	}
+
+	// 16x16 4bpp in the two most common arrangements
+	std::vector<UINT8> source(elements * 128), dest(256);
+	for (size_t i = 0; i < source.size(); i++)
+		source[i] = i * 0x9e3779b1 >> 24;
+	gfx_decode_layout layouts[2] =
+	{
+		{ &source[0], 0, 1024, 4, planar4, 16, &xoffset[0], 16, &yoffset[0], 16 },
+		{ &source[0], 0, 1024, 4, packed4, 16, &packedx[0], 16, &packedy[0], 16 }
+	};
+	static const char *const names[2] = { "planar", "packed" };
+
+	for (int which = 0; which < 2; which++)
+	{
+		gfx_decode_mode mode = gfx_decode_classify(layouts[which]);
+		EXPECT_NE(GFX_DECODE_GENERIC, mode);
+
+		osd_ticks_t start = osd_ticks();
+		for (int code = 0; code < elements; code++)
+			gfx_decode_generic(layouts[which], code, &dest[0]);
+		double generic = (double)(osd_ticks() - start) / osd_ticks_per_second();
+
+		start = osd_ticks();
+		for (int code = 0; code < elements; code++)
+			gfx_decode(mode, layouts[which], code, &dest[0]);
+		double fast = (double)(osd_ticks() - start) / osd_ticks_per_second();
+
+		double mpixels = elements * 256.0 / 1000000.0;
+		printf("%s 16x16 4bpp: %.1f Mpixels/s generic, %.1f Mpixels/s fast\n", names[which], mpixels / generic, mpixels / fast);
+	}
+}
@@ -0,0 +1,84 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+
+#include <stdio.h>
+#include <utime.h>
+#include "gtest/gtest.h"
+#include "filestamp.h"
+
+namespace
+{
+	const char *test_filename = "filestamp_test.xml";
+	const time_t test_time = 1400000000;
+
+	// write a file of the given size and set its modification time
+	void write_test_file(size_t size, time_t modified)
+	{
+		FILE *f = fopen(test_filename, "wb");
+		ASSERT_TRUE(f != NULL);
+		for (size_t i = 0; i < size; i++)
+			fputc('a' + i % 26, f);
+		fclose(f);
+
+		struct utimbuf times;
+		times.actime = modified;
+		times.modtime = modified;
+		ASSERT_EQ(0, utime(test_filename, &times));
+	}
+}
+
+TEST(filestamp,unchanged_file_matches)
+{
+	write_test_file(100, test_time);
+	file_stamp original, again;
+	ASSERT_TRUE(original.read(test_filename));
+	EXPECT_EQ(100U, original.size());
+	ASSERT_TRUE(again.read(test_filename));
+	EXPECT_TRUE(again == original);
+
+	// a stamp rebuilt from its parts, as the softlist cache reads it back, matches too
+	EXPECT_TRUE(file_stamp(original.path(), original.size(), original.modified()) == original);
+	remove(test_filename);
+}
+
+TEST(filestamp,changed_size_does_not_match)
+{
+	write_test_file(100, test_time);
+	file_stamp original, changed;
+	ASSERT_TRUE(original.read(test_filename));
+
+	write_test_file(101, test_time);
+	ASSERT_TRUE(changed.read(test_filename));
+	EXPECT_EQ(original.modified(), changed.modified());
+	EXPECT_TRUE(changed != original);
+	remove(test_filename);
+}
+
+TEST(filestamp,changed_time_does_not_match)
+{
+	write_test_file(100, test_time);
+	file_stamp original, changed;
+	ASSERT_TRUE(original.read(test_filename));
+
+	write_test_file(100, test_time + 60);
+	ASSERT_TRUE(changed.read(test_filename));
+	EXPECT_EQ(original.size(), changed.size());
+	EXPECT_TRUE(changed != original);
+	remove(test_filename);
+}
+
+TEST(filestamp,other_path_does_not_match)
+{
+	write_test_file(100, test_time);
+	file_stamp original;
+	ASSERT_TRUE(original.read(test_filename));
+	EXPECT_TRUE(file_stamp("other.xml", original.size(), original.modified()) != original);
+	remove(test_filename);
+}
+
+TEST(filestamp,missing_file_cannot_be_stamped)
+{
+	remove(test_filename);
+	file_stamp missing;
+	EXPECT_FALSE(missing.read(test_filename));
+}
@@ -0,0 +1,140 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+
+#include <stdio.h>
+#include "gtest/gtest.h"
+#include "aviio.h"
+
+static void fill_test_frame(bitmap_yuy16 &bitmap, int frame)
+{
+	for (int y = 0; y < bitmap.height(); y++)
+		for (int x = 0; x < bitmap.width(); x++)
+		{
+			UINT8 luma = (x * 3 + y * 5 + frame * 7) ^ (x * y);
+			UINT8 chroma = (x & 1) ? (y * 2 + frame) : (x + frame * 3);
+			bitmap.pix16(y, x) = (luma << 8) | chroma;
+		}
+}
+
+// random colours, the same for both pixels of each pair so that chroma averaging loses nothing
+static void fill_test_frame(bitmap_rgb32 &bitmap, int frame)
+{
+	UINT32 state = 0x9e3779b9 * (frame + 1);
+	for (int y = 0; y < bitmap.height(); y++)
+		for (int x = 0; x < bitmap.width(); x += 2)
+		{
+			state = state * 1664525 + 1013904223;
+			bitmap.pix32(y, x) = bitmap.pix32(y, x + 1) = rgb_t(state >> 24, state >> 16, state >> 8);
+		}
+}
+
+// BT.601 studio-range YCbCr back to RGB
+static rgb_t yuy_to_rgb(int y, int cb, int cr)
+{
+	int c = 298 * (y - 16);
+	int d = cb - 128;
+	int e = cr - 128;
+	return rgb_t(rgb_t::clamp((c + 409 * e + 128) >> 8), rgb_t::clamp((c - 100 * d - 208 * e + 128) >> 8), rgb_t::clamp((c + 516 * d + 128) >> 8));
+}
+
+static void fill_info(avi_movie_info &info, int width, int height)
+{
+	memset(&info, 0, sizeof(info));
+	info.video_format = FORMAT_HFYU;
+	info.video_timescale = 60;
+	info.video_sampletime = 1;
+	info.video_width = width;
+	info.video_height = height;
+	info.video_depth = 16;
+	info.audio_samplebits = 16;
+	info.audio_samplerate = 48000;
+	info.audio_timescale = 48000;
+	info.audio_sampletime = 1;
+}
+
+static void huffyuv_round_trip(int width, int height)
+{
+	const char *filename = "aviio_test.avi";
+	avi_movie_info info;
+	fill_info(info, width, height);
+
+	// write a few frames
+	avi_file *file;
+	ASSERT_EQ(AVIERR_NONE, avi_create(filename, &info, &file));
+	bitmap_yuy16 source(width, height);
+	for (int frame = 0; frame < 3; frame++)
+	{
+		fill_test_frame(source, frame);
+		ASSERT_EQ(AVIERR_NONE, avi_append_video_frame(file, source));
+	}
+	ASSERT_EQ(AVIERR_NONE, avi_close(file));
+
+	// read them back and make sure they are identical
+	ASSERT_EQ(AVIERR_NONE, avi_open(filename, &file));
+	EXPECT_EQ(FORMAT_HFYU, avi_get_movie_info(file)->video_format);
+	EXPECT_EQ(3U, avi_get_movie_info(file)->video_numsamples);
+	bitmap_yuy16 dest(width, height);
+	for (int frame = 0; frame < 3; frame++)
+	{
+		fill_test_frame(source, frame);
+		ASSERT_EQ(AVIERR_NONE, avi_read_video_frame(file, frame, dest));
+		for (int y = 0; y < height; y++)
+			ASSERT_EQ(0, memcmp(&source.pix16(y), &dest.pix16(y), width * 2)) << "frame " << frame << " row " << y;
+	}
+	avi_close(file);
+	remove(filename);
+}
+
+TEST(aviio,huffyuv_round_trip)
+{
+	huffyuv_round_trip(64, 48);
+}
+
+TEST(aviio,huffyuv_round_trip_interlaced)
+{
+	huffyuv_round_trip(322, 300);
+}
+
+TEST(aviio,huffyuv_rgb_round_trip)
+{
+	const char *filename = "aviio_test_rgb.avi";
+	const int width = 66, height = 40;
+	avi_movie_info info;
+	fill_info(info, width, height);
+
+	// RGB frames are converted to YUY2 on the way in
+	avi_file *file;
+	ASSERT_EQ(AVIERR_NONE, avi_create(filename, &info, &file));
+	bitmap_rgb32 source(width, height);
+	for (int frame = 0; frame < 3; frame++)
+	{
+		fill_test_frame(source, frame);
+		ASSERT_EQ(AVIERR_NONE, avi_append_video_frame(file, source));
+	}
+	ASSERT_EQ(AVIERR_NONE, avi_close(file));
+
+	// the conversion is lossy, so allow for rounding in both directions
+	ASSERT_EQ(AVIERR_NONE, avi_open(filename, &file));
+	EXPECT_EQ(FORMAT_HFYU, avi_get_movie_info(file)->video_format);
+	bitmap_yuy16 dest(width, height);
+	for (int frame = 0; frame < 3; frame++)
+	{
+		fill_test_frame(source, frame);
+		ASSERT_EQ(AVIERR_NONE, avi_read_video_frame(file, frame, dest));
+		for (int y = 0; y < height; y++)
+			for (int x = 0; x < width; x += 2)
+			{
+				UINT16 yuy0 = dest.pix16(y, x), yuy1 = dest.pix16(y, x + 1);
+				for (int pixel = 0; pixel < 2; pixel++)
+				{
+					rgb_t expected = source.pix32(y, x + pixel);
+					rgb_t actual = yuy_to_rgb((pixel ? yuy1 : yuy0) >> 8, yuy0 & 0xff, yuy1 & 0xff);
+					EXPECT_NEAR(expected.r(), actual.r(), 3) << "frame " << frame << " x " << x + pixel << " y " << y;
+					EXPECT_NEAR(expected.g(), actual.g(), 3) << "frame " << frame << " x " << x + pixel << " y " << y;
+					EXPECT_NEAR(expected.b(), actual.b(), 3) << "frame " << frame << " x " << x + pixel << " y " << y;
+				}
+			}
+	}
+	avi_close(file);
+	remove(filename);
+}
@@ -0,0 +1,129 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+
+#include <stdio.h>
+#include "gtest/gtest.h"
+#include "chd.h"
+
+namespace
+{
+	const UINT32 test_hunk_bytes = 4096;
+	const UINT32 test_hunks = 24;
+
+	// every third hunk is noise that won't compress, the next is a compressible
+	// pattern, and the one after repeats the noise so the compressor can refer back
+	void fill_test_hunk(UINT32 hunknum, UINT8 *dest)
+	{
+		UINT32 source = (hunknum % 3 == 2) ? hunknum - 2 : hunknum;
+		UINT32 state = 0x2545f491 * (source + 1);
+		for (UINT32 i = 0; i < test_hunk_bytes; i++)
+		{
+			state = state * 1664525 + 1013904223;
+			dest[i] = (source % 3 == 0) ? (state >> 24) : UINT8(i / 64 + source);
+		}
+	}
+
+	class test_compressor : public chd_file_compressor
+	{
+	protected:
+		virtual UINT32 read_data(void *dest, UINT64 offset, UINT32 length)
+		{
+			UINT8 *bytes = reinterpret_cast<UINT8 *>(dest);
+			for (UINT32 done = 0; done < length; done += test_hunk_bytes)
+				fill_test_hunk((offset + done) / test_hunk_bytes, bytes + done);
+			return length;
+		}
+	};
+
+	// check every hunk through hunk_view and read_hunk, and spans of bytes that cross
+	// hunk boundaries through read_bytes, returning the number of hunks viewed in place
+	UINT32 check_hunks(chd_file &chd, UINT32 missing)
+	{
+		std::vector<UINT8> expected(test_hunk_bytes * test_hunks), actual(test_hunk_bytes);
+		for (UINT32 hunknum = 0; hunknum < test_hunks; hunknum++)
+			if (hunknum != missing)
+				fill_test_hunk(hunknum, &expected[hunknum * test_hunk_bytes]);
+
+		UINT32 viewed = 0;
+		for (UINT32 hunknum = 0; hunknum < test_hunks; hunknum++)
+		{
+			const UINT8 *view = reinterpret_cast<const UINT8 *>(chd.hunk_view(hunknum));
+			if (view != NULL)
+			{
+				EXPECT_EQ(0, memcmp(view, &expected[hunknum * test_hunk_bytes], test_hunk_bytes)) << "hunk_view " << hunknum;
+				viewed++;
+			}
+			EXPECT_EQ(CHDERR_NONE, chd.read_hunk(hunknum, &actual[0])) << "read_hunk " << hunknum;
+			EXPECT_EQ(0, memcmp(&actual[0], &expected[hunknum * test_hunk_bytes], test_hunk_bytes)) << "read_hunk " << hunknum;
+		}
+
+		actual.resize(3 * test_hunk_bytes);
+		for (UINT32 offset = 100; offset + actual.size() <= expected.size(); offset += test_hunk_bytes + 777)
+		{
+			EXPECT_EQ(CHDERR_NONE, chd.read_bytes(offset, &actual[0], actual.size())) << "read_bytes " << offset;
+			EXPECT_EQ(0, memcmp(&actual[0], &expected[offset], actual.size())) << "read_bytes " << offset;
+		}
+		return viewed;
+	}
+}
+
+TEST(chd,uncompressed_hunk_view)
+{
+	const char *filename = "chd_test_raw.chd";
+	const UINT32 missing = 5;
+	chd_codec_type compression[4] = { CHD_CODEC_NONE, CHD_CODEC_NONE, CHD_CODEC_NONE, CHD_CODEC_NONE };
+
+	// write all but one hunk, which is left to read back as zeroes
+	{
+		chd_file chd;
+		ASSERT_EQ(CHDERR_NONE, chd.create(filename, UINT64(test_hunk_bytes) * test_hunks, test_hunk_bytes, 512, compression));
+		std::vector<UINT8> hunk(test_hunk_bytes);
+		for (UINT32 hunknum = 0; hunknum < test_hunks; hunknum++)
+			if (hunknum != missing)
+			{
+				fill_test_hunk(hunknum, &hunk[0]);
+				ASSERT_EQ(CHDERR_NONE, chd.write_hunk(hunknum, &hunk[0]));
+			}
+	}
+
+	// opened read-only, every written hunk can be viewed in the mapping
+	chd_file chd;
+	ASSERT_EQ(CHDERR_NONE, chd.open(filename));
+	EXPECT_EQ(test_hunks - 1, check_hunks(chd, missing));
+	EXPECT_TRUE(chd.hunk_view(missing) == NULL);
+	chd.close();
+
+	// opened for writing, nothing is mapped and everything goes through read_hunk
+	ASSERT_EQ(CHDERR_NONE, chd.open(filename, true));
+	EXPECT_EQ(0U, check_hunks(chd, missing));
+	chd.close();
+	remove(filename);
+}
+
+TEST(chd,compressed_hunk_view)
+{
+	const char *filename = "chd_test_zlib.chd";
+	chd_codec_type compression[4] = { CHD_CODEC_ZLIB, CHD_CODEC_NONE, CHD_CODEC_NONE, CHD_CODEC_NONE };
+
+	{
+		test_compressor chd;
+		ASSERT_EQ(CHDERR_NONE, chd.create(filename, UINT64(test_hunk_bytes) * test_hunks, test_hunk_bytes, 512, compression));
+		chd.compress_begin();
+		double progress, ratio;
+		chd_error err;
+		while ((err = chd.compress_continue(progress, ratio)) == CHDERR_COMPRESSING || err == CHDERR_WALKING_PARENT) { }
+		ASSERT_EQ(CHDERR_NONE, err);
+	}
+
+	// the noise is stored as is, directly or by reference, and can be viewed where it happens
+	// to be 4-byte aligned after the compressed hunks before it; the patterns never can
+	chd_file chd;
+	ASSERT_EQ(CHDERR_NONE, chd.open(filename));
+	UINT32 viewed = check_hunks(chd, test_hunks);
+	EXPECT_LT(0U, viewed);
+	EXPECT_GE(2 * test_hunks / 3, viewed);
+	for (UINT32 hunknum = 1; hunknum < test_hunks; hunknum += 3)
+		EXPECT_TRUE(chd.hunk_view(hunknum) == NULL) << "hunk " << hunknum;
+	chd.close();
+	remove(filename);
+}
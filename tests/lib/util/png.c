@@ -0,0 +1,114 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+
+#include <stdio.h>
+#include <zlib.h>
+#include "gtest/gtest.h"
+#include "png.h"
+
+static void fill_test_bitmap(bitmap_rgb32 &bitmap)
+{
+	// smooth gradients with some noise, roughly like a game screen
+	for (int y = 0; y < bitmap.height(); y++)
+		for (int x = 0; x < bitmap.width(); x++)
+		{
+			UINT8 noise = ((x * 7919) ^ (y * 104729)) & 0x0f;
+			bitmap.pix32(y, x) = rgb_t(x + noise, y * 2, (x ^ y) & 0xf0);
+		}
+}
+
+static UINT64 write_test_png(const char *filename, bitmap_rgb32 &bitmap, osd_work_queue *queue = NULL)
+{
+	core_file *file;
+	if (core_fopen(filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE, &file) != FILERR_NONE)
+		return 0;
+	png_error error = png_write_bitmap(file, NULL, bitmap, 0, NULL, queue);
+	UINT64 size = core_fsize(file);
+	core_fclose(file);
+	return (error == PNGERR_NONE) ? size : 0;
+}
+
+static void check_round_trip(osd_work_queue *queue)
+{
+	// big enough to be split into several blocks
+	const char *filename = "png_test.png";
+	bitmap_rgb32 source(640, 480);
+	fill_test_bitmap(source);
+	ASSERT_NE(0U, write_test_png(filename, source, queue));
+
+	core_file *file;
+	bitmap_argb32 dest;
+	ASSERT_EQ(FILERR_NONE, core_fopen(filename, OPEN_FLAG_READ, &file));
+	ASSERT_EQ(PNGERR_NONE, png_read_bitmap(file, dest));
+	core_fclose(file);
+	remove(filename);
+
+	ASSERT_EQ(source.width(), dest.width());
+	ASSERT_EQ(source.height(), dest.height());
+	for (int y = 0; y < source.height(); y++)
+		for (int x = 0; x < source.width(); x++)
+			ASSERT_EQ(source.pix32(y, x) & 0xffffff, dest.pix32(y, x) & 0xffffff) << "x=" << x << " y=" << y;
+}
+
+TEST(png,write_round_trip)
+{
+	check_round_trip(NULL);
+}
+
+TEST(png,write_round_trip_queue)
+{
+	osd_work_queue *queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	ASSERT_TRUE(queue != NULL);
+	check_round_trip(queue);
+	check_round_trip(queue);
+	osd_work_queue_free(queue);
+}
+
+// run with --gtest_also_run_disabled_tests
+TEST(png,DISABLED_write_benchmark)
+{
+	const char *filename = "png_bench.png";
+	const int iterations = 10;
+	bitmap_rgb32 source(1920, 1080);
+	fill_test_bitmap(source);
+
+	// the old path: an unfiltered image deflated as a single stream
+	UINT32 rawlength = source.height() * (source.width() * 3 + 1);
+	dynamic_buffer raw(rawlength, 0), compressed(compressBound(rawlength));
+	for (int y = 0; y < source.height(); y++)
+		for (int x = 0; x < source.width(); x++)
+		{
+			rgb_t pixel = source.pix32(y, x);
+			UINT8 *dst = &raw[y * (source.width() * 3 + 1) + 1 + x * 3];
+			dst[0] = pixel.r();
+			dst[1] = pixel.g();
+			dst[2] = pixel.b();
+		}
+	uLongf complength = 0;
+	osd_ticks_t start = osd_ticks();
+	for (int i = 0; i < iterations; i++)
+	{
+		complength = compressed.size();
+		ASSERT_EQ(Z_OK, compress2(&compressed[0], &complength, &raw[0], rawlength, Z_DEFAULT_COMPRESSION));
+	}
+	double single = (double)(osd_ticks() - start) / osd_ticks_per_second() / iterations;
+
+	// the current path, including conversion, without and with a queue
+	UINT64 size = 0;
+	start = osd_ticks();
+	for (int i = 0; i < iterations; i++)
+		size = write_test_png(filename, source);
+	double serial = (double)(osd_ticks() - start) / osd_ticks_per_second() / iterations;
+
+	osd_work_queue *queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	start = osd_ticks();
+	for (int i = 0; i < iterations; i++)
+		size = write_test_png(filename, source, queue);
+	double parallel = (double)(osd_ticks() - start) / osd_ticks_per_second() / iterations;
+	osd_work_queue_free(queue);
+	remove(filename);
+
+	printf("single stream: %.2f ms, %u bytes\n", single * 1000.0, (UINT32)complength);
+	printf("png_write_bitmap: %.2f ms serial, %.2f ms on a queue with %d processors, %u bytes\n", serial * 1000.0, parallel * 1000.0, osd_get_num_processors(), (UINT32)size);
+	EXPECT_NE(0U, size);
+}
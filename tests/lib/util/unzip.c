@@ -0,0 +1,157 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <zlib.h>
+#include "gtest/gtest.h"
+#include "unzip.h"
+
+static void put_word(std::vector<UINT8> &data, UINT16 value)
+{
+	data.push_back(value);
+	data.push_back(value >> 8);
+}
+
+static void put_dword(std::vector<UINT8> &data, UINT32 value)
+{
+	put_word(data, value);
+	put_word(data, value >> 16);
+}
+
+// write a ZIP with the given members stored uncompressed
+static bool write_test_zip(const char *filename, const char *const *names, const char *const *contents, int count)
+{
+	std::vector<UINT8> data, directory;
+	for (int index = 0; index < count; index++)
+	{
+		UINT32 length = strlen(contents[index]);
+		UINT32 crc = crc32(0, (const Bytef *)contents[index], length);
+		UINT16 namelength = strlen(names[index]);
+		UINT32 offset = data.size();
+
+		// local header and data
+		put_dword(data, 0x04034b50);
+		put_word(data, 10); put_word(data, 0); put_word(data, 0);
+		put_word(data, 0); put_word(data, 0);
+		put_dword(data, crc); put_dword(data, length); put_dword(data, length);
+		put_word(data, namelength); put_word(data, 0);
+		data.insert(data.end(), names[index], names[index] + namelength);
+		data.insert(data.end(), contents[index], contents[index] + length);
+
+		// central directory entry
+		put_dword(directory, 0x02014b50);
+		put_word(directory, 10); put_word(directory, 10); put_word(directory, 0); put_word(directory, 0);
+		put_word(directory, 0); put_word(directory, 0);
+		put_dword(directory, crc); put_dword(directory, length); put_dword(directory, length);
+		put_word(directory, namelength); put_word(directory, 0); put_word(directory, 0);
+		put_word(directory, 0); put_word(directory, 0); put_dword(directory, 0);
+		put_dword(directory, offset);
+		directory.insert(directory.end(), names[index], names[index] + namelength);
+	}
+
+	// end of central directory
+	UINT32 cdoffset = data.size();
+	data.insert(data.end(), directory.begin(), directory.end());
+	put_dword(data, 0x06054b50);
+	put_word(data, 0); put_word(data, 0);
+	put_word(data, count); put_word(data, count);
+	put_dword(data, directory.size()); put_dword(data, cdoffset);
+	put_word(data, 0);
+
+	FILE *file = fopen(filename, "wb");
+	if (file == NULL)
+		return false;
+	bool success = (fwrite(&data[0], 1, data.size(), file) == data.size());
+	fclose(file);
+	return success;
+}
+
+static std::string read_current(zip_file *zip, const zip_file_header *header)
+{
+	std::string result(header->uncompressed_length, 0);
+	if (header->uncompressed_length > 0 && zip_file_decompress(zip, &result[0], result.length()) != ZIPERR_NONE)
+		return "<error>";
+	return result;
+}
+
+TEST(unzip,search)
+{
+	static const char *const names[] = { "first.bin", "dir/", "dir/second.bin", "other/SECOND.BIN", "third.bin", "copy.bin" };
+	static const char *const contents[] = { "one", "", "two", "two, again", "three", "one" };
+	const char *filename = "unzip_test.zip";
+	ASSERT_TRUE(write_test_zip(filename, names, contents, ARRAY_LENGTH(names)));
+
+	zip_file *zip;
+	ASSERT_EQ(ZIPERR_NONE, zip_file_open(filename, &zip));
+	UINT32 crc_one = crc32(0, (const Bytef *)"one", 3);
+	UINT32 crc_two = crc32(0, (const Bytef *)"two", 3);
+
+	// names match ignoring case and any leading directory, first in the directory wins
+	const zip_file_header *header = zip_file_search(zip, 0, "second.bin", false, true);
+	ASSERT_TRUE(header != NULL);
+	EXPECT_STREQ("dir/second.bin", header->filename);
+	EXPECT_EQ("two", read_current(zip, header));
+	header = zip_file_search(zip, 0, "other/second.bin", false, true);
+	ASSERT_TRUE(header != NULL);
+	EXPECT_STREQ("other/SECOND.BIN", header->filename);
+	EXPECT_EQ("two, again", read_current(zip, header));
+
+	// a partial final component doesn't match
+	EXPECT_TRUE(zip_file_search(zip, 0, "econd.bin", false, true) == NULL);
+	EXPECT_TRUE(zip_file_search(zip, 0, "r/second.bin", false, true) == NULL);
+
+	// name and CRC together
+	header = zip_file_search(zip, crc_two, "second.bin", true, true);
+	ASSERT_TRUE(header != NULL);
+	EXPECT_STREQ("dir/second.bin", header->filename);
+	EXPECT_TRUE(zip_file_search(zip, crc_one, "second.bin", true, true) == NULL);
+
+	// CRC alone finds the first file with it, but never a directory
+	header = zip_file_search(zip, crc_one, "missing.bin", true, false);
+	ASSERT_TRUE(header != NULL);
+	EXPECT_STREQ("first.bin", header->filename);
+	EXPECT_EQ("one", read_current(zip, header));
+	EXPECT_TRUE(zip_file_search(zip, 0, "", true, false) == NULL);
+
+	// searching doesn't disturb iteration from the start
+	int count = 0;
+	for (header = zip_file_first_file(zip); header != NULL; header = zip_file_next_file(zip))
+		EXPECT_STREQ(names[count++], header->filename);
+	EXPECT_EQ(ARRAY_LENGTH(names), count);
+
+	// reopening from the cache keeps working
+	zip_file_close(zip);
+	ASSERT_EQ(ZIPERR_NONE, zip_file_open(filename, &zip));
+	header = zip_file_search(zip, 0, "THIRD.BIN", false, true);
+	ASSERT_TRUE(header != NULL);
+	EXPECT_EQ("three", read_current(zip, header));
+	zip_file_close(zip);
+
+	zip_file_cache_clear();
+	remove(filename);
+}
+
+TEST(unzip,cache_size)
+{
+	static const char *const names[] = { "a.bin" };
+	static const char *const contents[] = { "a" };
+	const char *filename = "unzip_cache.zip";
+	ASSERT_TRUE(write_test_zip(filename, names, contents, 1));
+
+	// with no cache the file is freed on close, and must still reopen cleanly
+	zip_file_cache_set_size(0);
+	zip_file *zip;
+	ASSERT_EQ(ZIPERR_NONE, zip_file_open(filename, &zip));
+	zip_file_close(zip);
+	ASSERT_EQ(ZIPERR_NONE, zip_file_open(filename, &zip));
+	const zip_file_header *header = zip_file_search(zip, 0, "a.bin", false, true);
+	ASSERT_TRUE(header != NULL);
+	EXPECT_EQ("a", read_current(zip, header));
+	zip_file_close(zip);
+
+	zip_file_cache_set_size(32);
+	zip_file_cache_clear();
+	remove(filename);
+}